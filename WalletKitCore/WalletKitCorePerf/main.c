@@ -10,11 +10,13 @@
 //
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include "support/BROSCompat.h"
 #include "support/BRBIP39WordsEn.h"
 #include "ethereum/BREthereum.h"
-#include "test.h"  // runSyncTest
+#include "test.h"  // runSyncTest, BRRunPerfTests*
 
 extern BREthereumClient
 runEWM_createClient (void);
@@ -55,7 +57,10 @@ runSyncMany (BREthereumNetwork newtork,
 
         clients[i] = runEWM_createClient();
 
-        ewm = ewmCreate (ethNetworkMainnet, account, timestamp, mode, clients[i], storagePath, 0, 6);
+        // In a P2P sync mode, all accounts share the first account's LES node pool.
+        ewm = ewmCreate (ethNetworkMainnet, account, timestamp, mode,
+                         (0 == i ? NULL : ewmGetLES (ewms[0])),
+                         clients[i], storagePath, 0, 6);
         ewms[i] = ewm;
 
         char *address = ewmGetAccountPrimaryAddress(ewm);
@@ -84,6 +89,42 @@ runSyncMany (BREthereumNetwork newtork,
 int main(int argc, const char * argv[]) {
     BRCryptoSyncMode mode = CRYPTO_SYNC_MODE_API_WITH_P2P_SEND;
 
+    if (argc > 1 && 0 == strcmp (argv[1], "txParse")) {
+        BRRunPerfTestsTxParse (argc > 2 ? (size_t) atoi (argv[2]) : 100, 10000);
+        return 0;
+    }
+
+    if (argc > 1 && 0 == strcmp (argv[1], "rlp")) {
+        runPerfTestsCoderPayloads (argc > 2 ? atoi (argv[2]) : 100);
+        return 0;
+    }
+
+    // pow [repeat [cacheDirectory]] - Ethash light verification of mainnet headers
+    if (argc > 1 && 0 == strcmp (argv[1], "pow")) {
+        runPerfTestsProofOfWork (argc > 2 ? atoi (argv[2]) : 100, argc > 3 ? argv[3] : NULL);
+        return 0;
+    }
+
+    // bcsSync - Ethereum BCS sync over synthetic account histories with a simulated node
+    if (argc > 1 && 0 == strcmp (argv[1], "bcsSync")) {
+        runPerfTestsBCSSync ();
+        return 0;
+    }
+
+    // sync [blocks [walletTx [addresses]]] - against an in-process peer, see BRRunPerfTestsSync()
+    if (argc > 1 && 0 == strcmp (argv[1], "sync")) {
+        return BRRunPerfTestsSync (argc > 2 ? (uint32_t) atoi (argv[2]) : 10000,
+                                   argc > 3 ? (size_t) atoi (argv[3]) : 1000,
+                                   argc > 4 ? (size_t) atoi (argv[4]) : 100) ? 0 : 1;
+    }
+
+    // accounts [count [threads]] - create and serialize accounts one at a time and as a batch
+    if (argc > 1 && 0 == strcmp (argv[1], "accounts")) {
+        runCryptoPerfTestsAccountBatch (argc > 2 ? (size_t) atoi (argv[2]) : 100,
+                                        argc > 3 ? (size_t) atoi (argv[3]) : 0);
+        return 0;
+    }
+
     const char *paperKey = (argc > 1 ? argv[1] : "0xa9de3dbd7d561e67527bc1ecb025c59d53b9f7ef");
     BREthereumAccount account = ethAccountCreate (paperKey);
     BREthereumTimestamp timestamp = 1539330275; // ETHEREUM_TIMESTAMP_UNKNOWN;
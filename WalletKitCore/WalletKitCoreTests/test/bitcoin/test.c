@@ -43,6 +43,7 @@
 #include "bitcoin/BRBIP38Key.h"
 #include "bitcoin/BRPeer.h"
 #include "bitcoin/BRPeerManager.h"
+#include "bitcoin/BRPeerManagerPrivate.h"
 #include "bitcoin/BRChainParams.h"
 #include "bitcoin/BRPaymentProtocol.h"
 #include "bitcoin/BRTransaction.h"
@@ -519,6 +520,18 @@ int BRHashTests()
                     "\x14\x7c\x4e\x72\xb9\x80\x77\x85\xaf\xee\x48\xbb", *(UInt256 *)md))
         r = 0, fprintf(stderr, "\n***FAILED*** %s: BRSHA256() test 6", __func__);
 
+    BRSHA256Context sha256; // streamed in uneven pieces across the internal buffer boundary
+    s = "Free online SHA256 Calculator, type text here... 1234567890123456789012345678901234567890";
+    BRSHA256Init(&sha256);
+    BRSHA256Update(&sha256, s, 3);
+    BRSHA256Update(&sha256, &s[3], 0);
+    BRSHA256Update(&sha256, &s[3], 62);
+    BRSHA256Update(&sha256, &s[65], strlen(s) - 65);
+    BRSHA256Final(&sha256, md);
+    BRSHA256(&md[32], s, strlen(s));
+    if (! UInt256Eq(*(UInt256 *)md, *(UInt256 *)&md[32]))
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRSHA256Update() test 1", __func__);
+
     // test sha512
     
     s = "Free online SHA512 Calculator, type text here...";
@@ -664,6 +677,22 @@ int BRHashTests()
                     "\x82\x27\x3b\x7b\xfa\xd8\x04\x5d\x85\xa4\x70", *(UInt256 *)md))
         r = 0, fprintf(stderr, "***FAILED*** %s: Keccak-256() test 1\n", __func__);
 
+    // test keccak-512
+    
+    s = "";
+    BRKeccak512(md, s, strlen(s));
+    if (! UInt512Eq(*(UInt512 *)"\x0e\xab\x42\xde\x4c\x3c\xeb\x92\x35\xfc\x91\xac\xff\xe7\x46\xb2\x9c\x29\xa8\xc3\x66"
+                    "\xb7\xc6\x0e\x4e\x67\xc4\x66\xf3\x6a\x43\x04\xc0\x0f\xa9\xca\xf9\xd8\x79\x76\xba\x46"
+                    "\x9b\xcb\xe0\x67\x13\xb4\x35\xf0\x91\xef\x27\x69\xfb\x16\x0c\xda\xb3\x3d\x36\x70\x68\x0e", *(UInt512 *)md))
+        r = 0, fprintf(stderr, "***FAILED*** %s: Keccak-512() test 1\n", __func__);
+
+    s = "abc";
+    BRKeccak512(md, s, strlen(s));
+    if (! UInt512Eq(*(UInt512 *)"\x18\x58\x7d\xc2\xea\x10\x6b\x9a\x15\x63\xe3\x2b\x33\x12\x42\x1c\xa1\x64\xc7\xf1\xf0"
+                    "\x7b\xc9\x22\xa9\xc8\x3d\x77\xce\xa3\xa1\xe5\xd0\xc6\x99\x10\x73\x90\x25\x37\x2d\xc1"
+                    "\x4a\xc9\x64\x26\x29\x37\x95\x40\xc1\x7e\x2a\x65\xb1\x9d\x77\xaa\x51\x1a\x9d\x00\xbb\x96", *(UInt512 *)md))
+        r = 0, fprintf(stderr, "***FAILED*** %s: Keccak-512() test 2\n", __func__);
+
     // test murmurHash3-x86_32
     
     if (BRMurmur3_32("", 0, 0) != 0)
@@ -752,6 +781,28 @@ int BRMacTests()
                "\xb1\xa3\x4d\x4a\x6b\x4b\x63\x6e\x07\x0a\x38\xbc\xe7\x37", mac, 64) != 0)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRHMAC() sha512 test 2\n", __func__);
     
+    // test pbkdf2
+
+    uint8_t dk[80];
+
+    BRPBKDF2(dk, 32, BRSHA256, 256/8, "password", 8, "salt", 4, 4096);
+    if (memcmp("\xc5\xe4\x78\xd5\x92\x88\xc8\x41\xaa\x53\x0d\xb6\x84\x5c\x4c\x8d\x96\x28\x93\xa0\x01\xce\x4e\x11\xa4"
+               "\x96\x38\x73\xaa\x98\x13\x4a", dk, 32) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRPBKDF2() sha256 test 1\n", __func__);
+
+    BRPBKDF2(dk, 64, BRSHA512, 512/8, "password", 8, "salt", 4, 2);
+    if (memcmp("\xe1\xd9\xc1\x6a\xa6\x81\x70\x8a\x45\xf5\xc7\xc4\xe2\x15\xce\xb6\x6e\x01\x1a\x2e\x9f\x00\x40\x71\x3f"
+               "\x18\xae\xfd\xb8\x66\xd5\x3c\xf7\x6c\xab\x28\x68\xa3\x9b\x9f\x78\x40\xed\xce\x4f\xef\x5a\x82\xbe\x67"
+               "\x33\x5c\x77\xa6\x06\x8e\x04\x11\x27\x54\xf2\x7c\xcf\x4e", dk, 64) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRPBKDF2() sha512 test 1\n", __func__);
+
+    BRPBKDF2(dk, 80, BRSHA512, 512/8, "passwordPASSWORDpassword", 24, "saltSALTsaltSALTsaltSALTsaltSALTsalt", 36, 4096);
+    if (memcmp("\x8c\x05\x11\xf4\xc6\xe5\x97\xc6\xac\x63\x15\xd8\xf0\x36\x2e\x22\x5f\x3c\x50\x14\x95\xba\x23\xb8\x68"
+               "\xc0\x05\x17\x4d\xc4\xee\x71\x11\x5b\x59\xf9\xe6\x0c\xd9\x53\x2f\xa3\x3e\x0f\x75\xae\xfe\x30\x22\x5c"
+               "\x58\x3a\x18\x6c\xd8\x2b\xd4\xda\xea\x97\x24\xa3\xd3\xb8\x04\xf7\x5b\xdd\x41\x49\x4f\xa3\x24\xca\xb2"
+               "\x4b\xcc\x68\x0f\xb3", dk, 80) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRPBKDF2() sha512 test 2\n", __func__);
+
     // test poly1305
 
     const char key1[] = "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
@@ -1706,6 +1757,20 @@ int BRBIP38KeyTests()
 
     printf("privKey:%s\n", privKey);
 
+    // non EC multiplied, as a batch, with one incorrect passphrase
+    const char *bip38Keys[] = { "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg",
+                                "6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq",
+                                "6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo" },
+    *passphrases[] = { "TestingOneTwoThree", "Satoshi", "Satoshi" };
+    BRKey keys[3];
+    int results[3];
+
+    if (BRKeySetBIP38Keys(keys, results, bip38Keys, passphrases, 3, BRMainNetParams->addrParams, 2) != 2 ||
+        ! results[0] || ! results[1] || results[2] ||
+        ! BRKeyPrivKey(&keys[1], privKey, sizeof(privKey), BRMainNetParams->addrParams) ||
+        strncmp(privKey, "5HtasZ6ofTHP6HCwTqTkLDuLQisYPah7aUnSKfC7h4hMUVw2gi5", sizeof(privKey)) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38Keys() test 1\n", __func__);
+
     // EC multiplied, uncompressed, no lot/sequence number
     if (! BRKeySetBIP38Key(&key, "6PfQu77ygVyJLZjfvMLyhLMQbYnu5uguoJJ4kMCLqWwPEdfpwANVS76gTX", "TestingOneTwoThree", BRMainNetParams->addrParams) ||
         ! BRKeyPrivKey(&key, privKey, sizeof(privKey), BRMainNetParams->addrParams) ||
@@ -2327,7 +2392,111 @@ int BRTransactionTests()
     
     if (len0 != sizeof(buf0) - 1 || memcmp(buf0, buf1, len0) != 0)
         r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionSerialize() test 4", __func__);
-    
+
+    tx = BRTransactionParse((uint8_t *)buf0, sizeof(buf0) - 1);
+    BRTransaction *ctx = BRTransactionParseCompact((uint8_t *)buf0, sizeof(buf0) - 1);
+    if (! ctx || ! BRTransactionEqual(tx, ctx) || ! UInt256Eq(tx->wtxHash, ctx->wtxHash) ||
+        ctx->inputs[0].witLen != tx->inputs[0].witLen ||
+        memcmp(ctx->inputs[0].witness, tx->inputs[0].witness, tx->inputs[0].witLen) != 0)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 1", __func__);
+    BRTransactionFree(tx);
+    if (! ctx) return r;
+
+    uint8_t buf10[BRTransactionSerialize(ctx, NULL, 0)];
+    size_t len10 = BRTransactionSerialize(ctx, buf10, sizeof(buf10));
+
+    if (len10 != sizeof(buf0) - 1 || memcmp(buf0, buf10, len10) != 0)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 2", __func__);
+
+    tx = BRTransactionCopy(ctx); // copy, then modify the copy of a compact tx
+    if (! BRTransactionEqual(tx, ctx))
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 3", __func__);
+    BRTransactionFree(ctx);
+
+    BRTxInputSetWitness(&tx->inputs[0], NULL, 0);
+    BRTxOutputSetScript(&tx->outputs[0], script, scriptLen);
+    BRTransactionAddInput(tx, inHash, 0, 1, script, scriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(tx, 1000000, script, scriptLen);
+    if (tx->inCount != 2 || tx->outCount != 3 || tx->outputs[0].scriptLen != scriptLen)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 4", __func__);
+    BRTransactionFree(tx);
+
+    tx = BRTransactionParseCompact(buf, len); // unsigned
+    if (! tx || tx->inCount != 1 || tx->outCount != 2 || tx->inputs[0].amount != 1 || BRTransactionIsSigned(tx))
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 5", __func__);
+    if (tx) BRTransactionFree(tx);
+
+    if (NULL != BRTransactionParseCompact((uint8_t *)buf0, sizeof(buf0) - 2))
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() test 6", __func__);
+
+    BRTransactionView view;
+    BRTxViewIterator iter = BR_TX_VIEW_ITERATOR_INIT;
+    BRTxInputView inView;
+    BRTxOutputView outView;
+    UInt160 pkh1, pkh2;
+    size_t n;
+
+    tx = BRTransactionParse((uint8_t *)buf0, sizeof(buf0) - 1);
+    if (! BRTransactionViewInit(&view, (uint8_t *)buf0, sizeof(buf0) - 1) || view.len != sizeof(buf0) - 1 ||
+        ! UInt256Eq(view.txHash, tx->txHash) || ! UInt256Eq(view.wtxHash, tx->wtxHash) ||
+        view.inCount != tx->inCount || view.outCount != tx->outCount || view.lockTime != tx->lockTime)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewInit() test 1", __func__);
+
+    for (n = 0; BRTransactionViewNextInput(&view, &iter, &inView); n++) {
+        if (n >= tx->inCount || ! UInt256Eq(inView.txHash, tx->inputs[n].txHash) ||
+            inView.index != tx->inputs[n].index || inView.witLen != tx->inputs[n].witLen ||
+            memcmp(inView.witness, tx->inputs[n].witness, inView.witLen) != 0 ||
+            BRTxInputViewPKH(&inView, pkh1.u8) != BRWitnessPKH(pkh2.u8, tx->inputs[n].witness, tx->inputs[n].witLen) ||
+            ! UInt160Eq(pkh1, pkh2))
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewNextInput() test %zu", __func__, n + 1);
+    }
+
+    for (n = 0, iter = BR_TX_VIEW_ITERATOR_INIT; BRTransactionViewNextOutput(&view, &iter, &outView); n++) {
+        if (n >= tx->outCount || outView.amount != tx->outputs[n].amount ||
+            outView.scriptLen != tx->outputs[n].scriptLen ||
+            memcmp(outView.script, tx->outputs[n].script, outView.scriptLen) != 0)
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewNextOutput() test %zu", __func__, n + 1);
+    }
+
+    BRTransactionFree(tx);
+    tx = BRTransactionParse(buf4, len4);
+    ctx = NULL;
+    if (! BRTransactionViewInit(&view, buf4, len4) || ! UInt256Eq(view.txHash, tx->txHash) ||
+        NULL == (ctx = BRTransactionViewCreateTransaction(&view)) || ! BRTransactionEqual(tx, ctx) ||
+        ctx->inputs[0].sigLen != tx->inputs[0].sigLen)
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewInit() test 2", __func__);
+    if (ctx) BRTransactionFree(ctx);
+    BRTransactionFree(tx);
+
+    if (BRTransactionViewInit(&view, (uint8_t *)buf0, sizeof(buf0) - 2))
+        r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewInit() test 3", __func__);
+
+    // a 0xff varint script length of ffffffffffffffff must be rejected, not wrapped back into range of buf
+    const char hugeIn[] = "\x01\x00\x00\x00\x01\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11"
+    "\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+    "\xff\xff\xff\xff\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+    hugeOut[] = "\x01\x00\x00\x00\x01\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11"
+    "\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x00\x00\x00\x00\x00\xff\xff\xff\xff\x01\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x00\x00\x00\x00\x00\x00",
+    hugeWit[] = "\x01\x00\x00\x00\x00\x01\x01\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11"
+    "\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x11\x00\x00\x00\x00\x00\xff\xff\xff\xff\x01\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x01\xff\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x00\x00\x00\x00\x00\x00";
+    const char *huge[] = { hugeIn, hugeOut, hugeWit };
+    size_t hugeLen[] = { sizeof(hugeIn) - 1, sizeof(hugeOut) - 1, sizeof(hugeWit) - 1 };
+
+    for (n = 0; n < 3; n++) {
+        if (BRTransactionViewInit(&view, (const uint8_t *)huge[n], hugeLen[n]))
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionViewInit() huge script test %zu", __func__, n + 1);
+
+        if (NULL != (tx = BRTransactionParseCompact((const uint8_t *)huge[n], hugeLen[n])))
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParseCompact() huge script test %zu", __func__, n + 1),
+            BRTransactionFree(tx);
+
+        if (NULL != (tx = BRTransactionParse((const uint8_t *)huge[n], hugeLen[n])))
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRTransactionParse() huge script test %zu", __func__, n + 1),
+            BRTransactionFree(tx);
+    }
+
     BRTransaction *src = BRTransactionNew();
     BRTransactionAddInput(src, inHash, 0, 1, script, scriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
     BRTransactionAddInput(src, inHash, 0, 1, script, scriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
@@ -2356,6 +2525,71 @@ int BRTransactionTests()
     return r;
 }
 
+// number of heap blocks held by tx - all but the first are (re)allocated piecemeal as a tx is parsed or built
+static size_t BRTransactionBlockCount(const BRTransaction *tx)
+{
+    size_t count = 1;
+
+    if (array_capacity(tx->inputs) == SIZE_MAX) return count; // BRTransactionParseCompact()
+
+    count += 2;
+    for (size_t i = 0; i < tx->inCount; i++)
+        count += (NULL != tx->inputs[i].script) + (NULL != tx->inputs[i].signature) + (NULL != tx->inputs[i].witness);
+    for (size_t i = 0; i < tx->outCount; i++)
+        count += (NULL != tx->outputs[i].script);
+    return count;
+}
+
+static double BRRunPerfTestsTxParseOne(BRTransaction *(*parse)(const uint8_t *, size_t),
+                                       const uint8_t *buf, size_t len, size_t repeat, size_t *blockCount)
+{
+    struct timespec start, stop;
+    BRTransaction *tx = parse(buf, len);
+
+    *blockCount = BRTransactionBlockCount(tx);
+    BRTransactionFree(tx);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < repeat; i++) BRTransactionFree(parse(buf, len));
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    return (double) repeat / ((double) (stop.tv_sec - start.tv_sec) + 1e-9 * (double) (stop.tv_nsec - start.tv_nsec));
+}
+
+// Compares BRTransactionParse() with BRTransactionParseCompact() on a signed legacy and a signed segwit tx, each with
+// inCount inputs and two outputs, reporting heap blocks per tx and parse+free throughput.
+extern void BRRunPerfTestsTxParse(size_t inCount, size_t repeat)
+{
+    uint8_t sig[107], wit[107], script[25] = "\x76\xa9\x14" "01234567890123456789" "\x88\xac";
+    UInt256 inHash = UINT256_ZERO;
+
+    memset(sig, 0x30, sizeof(sig));
+    memset(wit, 0x30, sizeof(wit)); wit[0] = 72; wit[73] = 33; // <sig> <pubKey>
+
+    for (int segwit = 0; segwit <= 1; segwit++) {
+        BRTransaction *tx = BRTransactionNew();
+
+        for (size_t i = 0; i < inCount; i++) {
+            inHash.u32[0] = (uint32_t) i + 1;
+            BRTransactionAddInput(tx, inHash, (uint32_t) i, 0, NULL, 0, sig, (segwit ? 0 : sizeof(sig)),
+                                  (segwit ? wit : NULL), (segwit ? sizeof(wit) : 0), TXIN_SEQUENCE);
+        }
+
+        BRTransactionAddOutput(tx, 1000000, script, sizeof(script));
+        BRTransactionAddOutput(tx, 2000000, script, sizeof(script));
+
+        uint8_t buf[BRTransactionSerialize(tx, NULL, 0)];
+        size_t len = BRTransactionSerialize(tx, buf, sizeof(buf)), blocks, compactBlocks;
+        double rate = BRRunPerfTestsTxParseOne(BRTransactionParse, buf, len, repeat, &blocks);
+        double compactRate = BRRunPerfTestsTxParseOne(BRTransactionParseCompact, buf, len, repeat, &compactBlocks);
+
+        printf("%s tx, %zu inputs, %zu bytes:\n", (segwit ? "segwit" : "legacy"), inCount, len);
+        printf("    BRTransactionParse:        %6zu allocs/tx, %10.0f tx/s\n", blocks, rate);
+        printf("    BRTransactionParseCompact: %6zu allocs/tx, %10.0f tx/s\n", compactBlocks, compactRate);
+        BRTransactionFree(tx);
+    }
+}
+
 static void walletBalanceChanged(void *info, uint64_t balance)
 {
     printf("balance changed %"PRIu64"\n", balance);
@@ -2546,7 +2780,77 @@ int BRWalletTests()
 
     BRTransactionFree(tx);
     BRWalletFree(w);
-    
+
+    w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    BRWalletForeignTxStats stats;
+    UInt256 firstHash = UINT256_ZERO;
+
+    for (uint32_t i = 0; i < 3000; i++) { // unconfirmed non-wallet tx are kept up to a limit
+        UInt256 h = UINT256_ZERO;
+
+        h.u32[0] = i + 1;
+        tx = BRTransactionNew();
+        BRTransactionAddInput(tx, h, 0, 0, NULL, 0, (uint8_t *)"\x01\x02", 2, NULL, 0, TXIN_SEQUENCE);
+        BRTransactionAddOutput(tx, 1000, inScript, inScriptLen);
+
+        uint8_t buf[BRTransactionSerialize(tx, NULL, 0)];
+        size_t len = BRTransactionSerialize(tx, buf, sizeof(buf));
+
+        BRTransactionFree(tx);
+        tx = BRTransactionParse(buf, len);
+        if (i == 0) firstHash = tx->txHash;
+        if (BRWalletRegisterTransaction(w, tx))
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 1\n", __func__);
+    }
+
+    stats = BRWalletGetForeignTxStats(w);
+    if (stats.count + stats.evicted != 3000 || stats.evicted == 0 || stats.size == 0 ||
+        BRWalletTransactionForHash(w, firstHash) != NULL || BRWalletTransactionForHash(w, tx->txHash) != tx)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletGetForeignTxStats() test\n", __func__);
+
+    tx = BRTransactionNew(); // a wallet tx spending the same outpoint as a non-wallet tx is a double spend
+    BRTransactionAddInput(tx, inHash, 0, 1, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(tx, 1000, inScript, inScriptLen);
+    BRTransactionSign(tx, 0, &k, 1);
+    BRWalletRegisterTransaction(w, tx);
+    firstHash = tx->txHash;
+    tx = BRTransactionNew();
+    BRTransactionAddInput(tx, inHash, 0, 1, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(tx, 1000, outScript, outScriptLen);
+    BRTransactionSign(tx, 0, &k, 1);
+    if (! BRWalletRegisterTransaction(w, tx) || BRWalletTransactionIsValid(w, tx) || BRWalletBalance(w) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransaction() test 2\n", __func__);
+
+    BRTransaction *spendTx = tx;
+
+    for (uint32_t i = 0; i < 6000; i++) { // the double spend must outlive the count, size and age limits
+        UInt256 h = UINT256_ZERO;
+
+        h.u32[0] = i + 3001;
+        tx = BRTransactionNew();
+        BRTransactionAddInput(tx, h, 0, 0, NULL, 0, (uint8_t *)"\x01\x02", 2, NULL, 0, TXIN_SEQUENCE);
+        BRTransactionAddOutput(tx, 1000, inScript, inScriptLen);
+
+        uint8_t buf[BRTransactionSerialize(tx, NULL, 0)];
+        size_t len = BRTransactionSerialize(tx, buf, sizeof(buf));
+
+        BRTransactionFree(tx);
+        tx = BRTransactionParse(buf, len);
+        BRWalletRegisterTransaction(w, tx);
+        if (i == 2999) BRWalletUpdateTransactions(w, &firstHash, 1, 1000, 1); // the double spend confirms
+    }
+
+    stats = BRWalletGetForeignTxStats(w);
+    if (stats.pinned != 1 || BRWalletTransactionForHash(w, firstHash) == NULL ||
+        BRWalletTransactionIsValid(w, spendTx) || BRWalletBalance(w) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletGetForeignTxStats() test 2\n", __func__);
+
+    BRWalletRemoveTransaction(w, spendTx->txHash); // once the wallet tx is gone, the double spend can be evicted
+    stats = BRWalletGetForeignTxStats(w);
+    if (stats.pinned != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletGetForeignTxStats() test 3\n", __func__);
+    BRWalletFree(w);
+
     amt = BRBitcoinAmount(50000, 50000);
     if (amt != SATOSHIS) r = 0, fprintf(stderr, "***FAILED*** %s: BRBitcoinAmount() test 1\n", __func__);
 
@@ -2680,7 +2984,7 @@ int BRMerkleBlockTests()
                     UInt256Reverse(uint256("00000000000080b66c911bd5ba14a74260057311eaeb1982802f7010f1a9f090"))))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockParse() test\n", __func__);
 
-    if (! BRMerkleBlockIsValid(b, (uint32_t)time(NULL)))
+    if (! BRMerkleBlockIsValid(b, (uint32_t)time(NULL), BRMainNetParams->maxProofOfWork))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockParse() test\n", __func__);
     
     if (BRMerkleBlockSerialize(b, block2, sizeof(block2)) != sizeof(block2) ||
@@ -3179,6 +3483,69 @@ int BRPeerTests()
     return r;
 }
 
+int BRTxPeersTests()
+{
+    int r = 1;
+    BRTxPeers txPeers;
+    BRPeer peers[TX_PEER_SLOTS + 2];
+    UInt256 hashes[TX_PEER_SLOTS + 2];
+    size_t i;
+    
+    for (i = 0; i < TX_PEER_SLOTS + 2; i++) {
+        peers[i] = BR_PEER_NONE;
+        peers[i].address.u16[5] = 0xffff;
+        peers[i].address.u32[3] = htonl(0x0a000000 + (uint32_t)i + 1); // 10.0.0.x
+        peers[i].port = 8333;
+        hashes[i] = UINT256_ZERO;
+        hashes[i].u32[0] = (uint32_t)i + 1;
+    }
+    
+    BRTxPeersInit(&txPeers);
+    
+    for (i = 0; i < TX_PEER_SLOTS; i++) {
+        if (BRTxPeersAddPeer(&txPeers, BRTxPeerRelays, hashes[i], &peers[i]) != 1)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersAddPeer() test 1\n", __func__);
+    }
+    
+    // all slots belong to connected peers, so the next peer must not take over another peer's slot
+    if (BRTxPeersAddPeer(&txPeers, BRTxPeerRelays, hashes[0], &peers[TX_PEER_SLOTS]) != 1)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersAddPeer() test 2\n", __func__);
+    
+    if (BRTxPeersHasPeer(&txPeers, BRTxPeerRelays, hashes[0], &peers[TX_PEER_SLOTS]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersHasPeer() test 2\n", __func__);
+    
+    if (! BRTxPeersHasPeer(&txPeers, BRTxPeerRelays, hashes[0], &peers[0]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersHasPeer() test 3\n", __func__);
+    
+    // a disconnected peer's slot is reclaimed, along with its bookkeeping
+    BRTxPeersPeerDisconnected(&txPeers, &peers[5]);
+    
+    if (BRTxPeersAddPeer(&txPeers, BRTxPeerRelays, hashes[0], &peers[TX_PEER_SLOTS]) != 2)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersAddPeer() test 3\n", __func__);
+    
+    if (BRTxPeersCount(&txPeers, BRTxPeerRelays, hashes[5]) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersCount() test 1\n", __func__);
+    
+    if (BRTxPeersHasPeer(&txPeers, BRTxPeerRelays, hashes[5], &peers[TX_PEER_SLOTS]) ||
+        ! BRTxPeersHasPeer(&txPeers, BRTxPeerRelays, hashes[0], &peers[0]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersHasPeer() test 4\n", __func__);
+    
+    // a peer that reconnects keeps its slot
+    BRTxPeersPeerDisconnected(&txPeers, &peers[6]);
+    
+    if (BRTxPeersAddPeer(&txPeers, BRTxPeerRequests, hashes[6], &peers[6]) != 1)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersAddPeer() test 4\n", __func__);
+    
+    if (BRTxPeersAddPeer(&txPeers, BRTxPeerRelays, hashes[TX_PEER_SLOTS + 1], &peers[TX_PEER_SLOTS + 1]) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersAddPeer() test 5\n", __func__);
+    
+    if (! BRTxPeersHasPeer(&txPeers, BRTxPeerRelays, hashes[6], &peers[6]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRTxPeersHasPeer() test 5\n", __func__);
+    
+    BRTxPeersFree(&txPeers);
+    return r;
+}
+
 int BRRunTests()
 {
     int fail = 0;
@@ -3231,6 +3598,8 @@ int BRRunTests()
     printf("%s\n", (BRBloomFilterTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRMerkleBlockTests...               ");
     printf("%s\n", (BRMerkleBlockTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRTxPeersTests...                   ");
+    printf("%s\n", (BRTxPeersTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRPaymentProtocolTests...           ");
     printf("%s\n", (BRPaymentProtocolTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRPaymentProtocolEncryptionTests... ");
@@ -3300,7 +3669,7 @@ static void testSyncSaveBlocks (void *c, int replace, BRMerkleBlock *blocks[], s
                 block->version == 0x7fffe000 ||
                 0);
          */
-        assert (BRMerkleBlockIsValid(block, unixTime));
+        assert (BRMerkleBlockIsValid(block, unixTime, BRMainNetParams->maxProofOfWork));
     }
 }
 
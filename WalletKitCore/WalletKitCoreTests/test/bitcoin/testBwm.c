@@ -19,10 +19,14 @@
 
 #include "support/BRArray.h"
 #include "support/BRBIP39Mnemonic.h"
+#include "support/BRBIP32Sequence.h"
+#include "support/BRAddress.h"
+#include "support/BRKey.h"
 #include "bitcoin/BRPeerManager.h"
 #include "bitcoin/BRTransaction.h"
 #include "bitcoin/BRWallet.h"
 #include "bitcoin/BRWalletManager.h"
+#include "bitcoin/BRSyncManager.h"
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -1500,6 +1504,192 @@ static int BRPeerEqual (const BRPeer *p1, const BRPeer *p2) {
             p1->flags == p2->flags);
 }
 
+///
+/// API Sync Scan
+///
+#define SCAN_TEST_LAST_USED_EXTERNAL    (159)
+#define SCAN_TEST_LAST_USED_INTERNAL    (40)
+#define SCAN_TEST_AMOUNT                (1000)
+
+typedef struct {
+    int rid;
+    BRArrayOf(char *) addresses;
+} BRSyncManagerScanTestRequest;
+
+typedef struct BRSyncManagerScanTesterRecord {
+    BRArrayOf(BRSyncManagerScanTestRequest) requests;
+    size_t startedCount;
+    size_t stoppedCount;
+} *BRSyncManagerScanTester;
+
+static void
+_testScanGetBlockNumberCallback (BRSyncManagerClientContext context,
+                                 BRSyncManager manager,
+                                 int rid) {
+}
+
+static void
+_testScanGetTransactionsCallback (BRSyncManagerClientContext context,
+                                  BRSyncManager manager,
+                                  OwnershipKept const char **addresses,
+                                  size_t addressCount,
+                                  uint64_t begBlockNumber,
+                                  uint64_t endBlockNumber,
+                                  int rid) {
+    BRSyncManagerScanTester tester = (BRSyncManagerScanTester) context;
+    BRSyncManagerScanTestRequest request = { rid, NULL };
+
+    // Answered later; the manager must not be called back from within a callback
+    array_new (request.addresses, addressCount);
+    for (size_t index = 0; index < addressCount; index++)
+        array_add (request.addresses, strdup (addresses[index]));
+    array_add (tester->requests, request);
+}
+
+static void
+_testScanSubmitTransactionCallback (BRSyncManagerClientContext context,
+                                    BRSyncManager manager,
+                                    OwnershipKept uint8_t *transaction,
+                                    size_t transactionLength,
+                                    UInt256 transactionHash,
+                                    int rid) {
+}
+
+static void
+_testScanEventCallback (void *context,
+                        BRSyncManager manager,
+                        OwnershipKept BRSyncManagerEvent event) {
+    BRSyncManagerScanTester tester = (BRSyncManagerScanTester) context;
+
+    if (SYNC_MANAGER_SYNC_STARTED == event.type) tester->startedCount++;
+    if (SYNC_MANAGER_SYNC_STOPPED == event.type) tester->stoppedCount++;
+}
+
+static BRAddress
+_testScanAddress (BRMasterPubKey mpk,
+                  BRAddressParams params,
+                  uint32_t chain,
+                  uint32_t index) {
+    BRKey key;
+    BRAddress address = BR_ADDRESS_NONE;
+    uint8_t pubKey[BRBIP32PubKey (NULL, 0, mpk, chain, index)];
+    size_t pubKeyLen = BRBIP32PubKey (pubKey, sizeof (pubKey), mpk, chain, index);
+
+    BRKeySetPubKey (&key, pubKey, pubKeyLen);
+    UInt160 hash = BRKeyHash160 (&key);
+    BRAddressFromHash160 (address.s, sizeof (address.s), params, &hash);
+    return address;
+}
+
+// Announce, for `rid`, a transaction paying `address` if it is one of the `usedCount` used addresses
+static void
+_testScanAnnounceIfUsed (BRSyncManager manager,
+                         BRAddressParams params,
+                         int rid,
+                         const char *address,
+                         BRAddress *usedAddresses,
+                         size_t usedCount) {
+    for (size_t index = 0; index < usedCount; index++) {
+        if (0 != strcmp (address, usedAddresses[index].s)) continue;
+
+        // The same transaction each time the address is requested
+        UInt256 inHash = UINT256_ZERO;
+        inHash.u32[0] = (uint32_t) index + 1;
+
+        uint8_t script[BRAddressScriptPubKey (NULL, 0, params, address)];
+        size_t scriptLen = BRAddressScriptPubKey (script, sizeof (script), params, address);
+
+        BRTransaction *tx = BRTransactionNew ();
+        BRTransactionAddInput (tx, inHash, 0, 0, NULL, 0, (uint8_t *) "\x01\x02", 2, NULL, 0, TXIN_SEQUENCE);
+        BRTransactionAddOutput (tx, SCAN_TEST_AMOUNT, script, scriptLen);
+
+        uint8_t txBytes[BRTransactionSerialize (tx, NULL, 0)];
+        size_t txBytesLen = BRTransactionSerialize (tx, txBytes, sizeof (txBytes));
+        BRTransactionFree (tx);
+
+        BRSyncManagerAnnounceGetTransactionsItem (manager, rid, txBytes, txBytesLen, 1500000000, 500000, 0);
+        return;
+    }
+}
+
+// A full API scan of a wallet with used addresses well past its initial (extended gap limit)
+// addresses: the lookahead windows find them in a few rounds of requests and, once complete, the
+// wallet keeps only the gap limit of unused addresses past the last used ones - or its initial
+// addresses, if more.
+static int
+BRRunTestSyncManagerScan (void) {
+    UInt512 seed;
+    BRBIP39DeriveKey (seed.u8, "a random seed", NULL);
+
+    BRMasterPubKey mpk = BRBIP32MasterPubKey (&seed, sizeof (seed));
+    BRAddressParams params = BRMainNetParams->addrParams;
+    BRWallet *wallet = BRWalletNew (params, NULL, 0, mpk);
+
+    size_t usedCount = (SCAN_TEST_LAST_USED_EXTERNAL + 1) + (SCAN_TEST_LAST_USED_INTERNAL + 1);
+    BRAddress usedAddresses[usedCount];
+    for (uint32_t index = 0; index <= SCAN_TEST_LAST_USED_EXTERNAL; index++)
+        usedAddresses[index] = _testScanAddress (mpk, params, SEQUENCE_EXTERNAL_CHAIN, index);
+    for (uint32_t index = 0; index <= SCAN_TEST_LAST_USED_INTERNAL; index++)
+        usedAddresses[SCAN_TEST_LAST_USED_EXTERNAL + 1 + index] = _testScanAddress (mpk, params, SEQUENCE_INTERNAL_CHAIN, index);
+
+    struct BRSyncManagerScanTesterRecord tester = { NULL, 0, 0 };
+    array_new (tester.requests, 10);
+
+    BRSyncManagerClientCallbacks callbacks = {
+        _testScanGetBlockNumberCallback,
+        _testScanGetTransactionsCallback,
+        _testScanSubmitTransactionCallback
+    };
+
+    BRSyncManager manager = BRSyncManagerNewForMode (CRYPTO_SYNC_MODE_API_ONLY,
+                                                     &tester, _testScanEventCallback,
+                                                     &tester, callbacks,
+                                                     BRMainNetParams, wallet,
+                                                     0, 600000, 6, 1,
+                                                     NULL, 0,
+                                                     NULL, 0);
+    BRSyncManagerConnect (manager);
+
+    size_t rounds = 0;
+    while (array_count (tester.requests) > 0) {
+        BRArrayOf(BRSyncManagerScanTestRequest) requests = tester.requests;
+        array_new (tester.requests, 10);
+        rounds++;
+
+        for (size_t rindex = 0; rindex < array_count (requests); rindex++) {
+            for (size_t aindex = 0; aindex < array_count (requests[rindex].addresses); aindex++) {
+                _testScanAnnounceIfUsed (manager, params, requests[rindex].rid,
+                                         requests[rindex].addresses[aindex],
+                                         usedAddresses, usedCount);
+                free (requests[rindex].addresses[aindex]);
+            }
+            array_free (requests[rindex].addresses);
+
+            BRSyncManagerAnnounceGetTransactionsDone (manager, requests[rindex].rid, 1);
+        }
+        array_free (requests);
+    }
+
+    int success = (1 == tester.startedCount && 1 == tester.stoppedCount);
+
+    // Every used address was found ...
+    success &= (usedCount * SCAN_TEST_AMOUNT == BRWalletBalance (wallet));
+
+    // ... in fewer rounds than one per gap limit past the initial addresses ...
+    success &= (rounds < 1 + (SCAN_TEST_LAST_USED_EXTERNAL + 1 - SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED) / SEQUENCE_GAP_LIMIT_EXTERNAL);
+
+    // ... and the unused lookahead addresses past the gap limit are gone from the wallet
+    success &= (SCAN_TEST_LAST_USED_EXTERNAL + 1 + SEQUENCE_GAP_LIMIT_EXTERNAL == BRWalletChainLength (wallet, SEQUENCE_EXTERNAL_CHAIN));
+    success &= (SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED == BRWalletChainLength (wallet, SEQUENCE_INTERNAL_CHAIN));
+
+    BRSyncManagerDisconnect (manager);
+    BRSyncManagerFree (manager);
+    array_free (tester.requests);
+    BRWalletFree (wallet);
+
+    return success;
+}
+
 extern int BRRunTestsBWM (const char *paperKey,
                           const char *storagePath,
                           int isBTC,
@@ -1507,6 +1697,7 @@ extern int BRRunTestsBWM (const char *paperKey,
     int success = 1;
 
     success &= BRRunTestWalletManagerFileService (storagePath);
+    success &= BRRunTestSyncManagerScan ();
 
     return success;
 }
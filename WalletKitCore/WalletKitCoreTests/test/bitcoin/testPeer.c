@@ -0,0 +1,757 @@
+//
+//  testPeer.c
+//
+//  Copyright (c) 2020 breadwallet LLC
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+//  A deterministic, in-process stand-in for a bitcoin full node. It serves a synthetic header chain, bloom filtered
+//  merkleblocks and the matching transactions over loopback TCP using the wire format BRPeer speaks, so that an end to
+//  end BRPeerManager sync can be measured without network access.
+//
+
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include "support/BRArray.h"
+#include "support/BRAddress.h"
+#include "support/BRBIP39Mnemonic.h"
+#include "support/BRBIP32Sequence.h"
+#include "support/BRCrypto.h"
+#include "support/BRInt.h"
+#include "support/BRKey.h"
+#include "support/BRSet.h"
+#include "bitcoin/BRBloomFilter.h"
+#include "bitcoin/BRChainParams.h"
+#include "bitcoin/BRMerkleBlock.h"
+#include "bitcoin/BRPeer.h"
+#include "bitcoin/BRPeerManager.h"
+#include "bitcoin/BRTransaction.h"
+#include "bitcoin/BRWallet.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define FAKE_PEER_MAGIC_NUMBER    0xdab5bffa // regtest
+#define FAKE_PEER_POW_LIMIT       0x207fffff // regtest proof-of-work limit, about two hashes per block
+#define FAKE_PEER_BLOCK_INTERVAL  (10*60)
+#define FAKE_PEER_FILLER_TX       7          // tx per block that never match a filter, in addition to wallet tx
+#define FAKE_PEER_HEADER_LENGTH   24
+#define FAKE_PEER_MAX_MSG_LENGTH  0x02000000
+#define FAKE_PEER_MAX_BLOCK_INV   500
+#define FAKE_PEER_MAX_HEADERS     2000
+#define FAKE_PEER_VERSION         70013
+#define FAKE_PEER_USER_AGENT      "/fakepeer:0.1/"
+
+#define INV_TX                    1
+#define INV_BLOCK                 2
+#define INV_FILTERED_BLOCK        3
+#define INV_WITNESS_FLAG          0x40000000
+
+typedef struct {
+    BRMerkleBlock *block; // header only, totalTx is the number of tx in the block
+    size_t txIdx;         // first wallet tx in the block, an index into BRFakePeer.txs
+    size_t txCount;       // wallet tx in the block, following FAKE_PEER_FILLER_TX filler tx
+} BRFakePeerBlock;
+
+typedef struct {
+    BRFakePeerBlock *chain;   // BRArray indexed by height, chain[0] is the genesis block
+    BRSet *blocks;            // chain blocks by hash
+    BRTransaction **txs;      // BRArray of wallet tx in block order, the last one is left unconfirmed in the mempool
+    BRSet *txSet;             // txs by hash
+    BRBloomFilter *filter;    // filter loaded by the connected client, if any
+    int listenSocket;
+    int socket;               // the connected client, or -1
+    uint16_t port;
+    volatile int stop;
+    pthread_t thread;
+    pthread_mutex_t lock;
+} BRFakePeer;
+
+inline static int _BRFakePeerCeilLog2(size_t x)
+{
+    int r = (x & (x - 1)) ? 1 : 0;
+
+    while ((x >>= 1) != 0) r++;
+    return r;
+}
+
+// filler tx hashes are not the hash of any tx, but they are distinct and never zero
+inline static UInt256 _BRFakePeerFillerHash(uint32_t height, uint32_t i)
+{
+    UInt256 hash = UINT256_ZERO;
+
+    hash.u32[0] = height;
+    hash.u32[1] = i;
+    hash.u32[7] = 0xffffffff;
+    return hash;
+}
+
+// writes the tx hashes of block at height to leaves, which must hold FAKE_PEER_FILLER_TX + txCount hashes
+static size_t _BRFakePeerBlockLeaves(const BRFakePeer *fp, uint32_t height, UInt256 *leaves)
+{
+    const BRFakePeerBlock *b = &fp->chain[height];
+    size_t count = 0;
+
+    for (uint32_t i = 0; i < FAKE_PEER_FILLER_TX; i++) leaves[count++] = _BRFakePeerFillerHash(height, i);
+    for (size_t i = 0; i < b->txCount; i++) leaves[count++] = fp->txs[b->txIdx + i]->txHash;
+    return count;
+}
+
+inline static size_t _BRFakePeerTreeWidth(size_t count, int height)
+{
+    return (count + ((size_t)1 << height) - 1) >> height;
+}
+
+static UInt256 _BRFakePeerMerkleNode(const UInt256 leaves[], size_t count, int height, size_t pos)
+{
+    UInt256 hashes[2];
+
+    if (height == 0) return leaves[pos];
+    hashes[0] = _BRFakePeerMerkleNode(leaves, count, height - 1, pos*2);
+    hashes[1] = (pos*2 + 1 < _BRFakePeerTreeWidth(count, height - 1)) ?
+                _BRFakePeerMerkleNode(leaves, count, height - 1, pos*2 + 1) : hashes[0];
+    BRSHA256_2(&hashes[0], hashes, sizeof(hashes));
+    return hashes[0];
+}
+
+// BIP37 partial merkle branch encoder, the inverse of _BRMerkleBlockRootR()/_BRMerkleBlockTxHashesR()
+static void _BRFakePeerMerkleBranch(const UInt256 leaves[], const uint8_t matched[], size_t count, int height,
+                                    size_t pos, UInt256 **hashes, uint8_t **flags, size_t *flagIdx)
+{
+    size_t i, end = (pos + 1) << height;
+    int parentOfMatch = 0;
+
+    for (i = pos << height; ! parentOfMatch && i < end && i < count; i++) parentOfMatch = matched[i];
+    if (*flagIdx/8 >= array_count(*flags)) array_add(*flags, 0);
+    if (parentOfMatch) (*flags)[*flagIdx/8] |= (uint8_t)(1 << (*flagIdx % 8));
+    (*flagIdx)++;
+
+    if (height == 0 || ! parentOfMatch) {
+        array_add(*hashes, _BRFakePeerMerkleNode(leaves, count, height, pos));
+    }
+    else {
+        _BRFakePeerMerkleBranch(leaves, matched, count, height - 1, pos*2, hashes, flags, flagIdx);
+
+        if (pos*2 + 1 < _BRFakePeerTreeWidth(count, height - 1)) {
+            _BRFakePeerMerkleBranch(leaves, matched, count, height - 1, pos*2 + 1, hashes, flags, flagIdx);
+        }
+    }
+}
+
+// BIP37 filter matching, inserting the outpoints of matched outputs as a BLOOM_UPDATE_ALL node would
+static int _BRFakePeerTxMatchesFilter(BRBloomFilter *filter, const BRTransaction *tx)
+{
+    uint8_t o[sizeof(UInt256) + sizeof(uint32_t)];
+    const uint8_t *data;
+    size_t i, j, count, dataLen;
+    int r = BRBloomFilterContainsData(filter, tx->txHash.u8, sizeof(UInt256));
+
+    for (i = 0; i < tx->outCount; i++) {
+        const BRTxOutput *output = &tx->outputs[i];
+        const uint8_t *elems[BRScriptElements(NULL, 0, output->script, output->scriptLen)];
+
+        count = BRScriptElements(elems, sizeof(elems)/sizeof(*elems), output->script, output->scriptLen);
+
+        for (j = 0; j < count; j++) {
+            data = BRScriptData(elems[j], &dataLen);
+            if (! data || dataLen == 0 || ! BRBloomFilterContainsData(filter, data, dataLen)) continue;
+            UInt256Set(o, tx->txHash);
+            UInt32SetLE(&o[sizeof(UInt256)], (uint32_t)i);
+            BRBloomFilterInsertData(filter, o, sizeof(o));
+            r = 1;
+            break;
+        }
+    }
+
+    for (i = 0; ! r && i < tx->inCount; i++) {
+        UInt256Set(o, tx->inputs[i].txHash);
+        UInt32SetLE(&o[sizeof(UInt256)], tx->inputs[i].index);
+        r = BRBloomFilterContainsData(filter, o, sizeof(o));
+    }
+
+    return r;
+}
+
+// mines a block on top of prev, which is NULL for the genesis block, returns NULL if no nonce is found
+static BRMerkleBlock *_BRFakePeerMineBlock(const BRMerkleBlock *prev, UInt256 merkleRoot, uint32_t timestamp,
+                                           uint32_t totalTx, uint32_t now)
+{
+    BRMerkleBlock *block = BRMerkleBlockNew();
+    uint8_t buf[80];
+    int valid = 0;
+
+    block->version = 0x20000000;
+    block->prevBlock = (prev) ? prev->blockHash : UINT256_ZERO;
+    block->merkleRoot = merkleRoot;
+    block->timestamp = timestamp;
+    block->target = FAKE_PEER_POW_LIMIT;
+    block->height = (prev) ? prev->height + 1 : 0;
+
+    // with totalTx == 0 the merkle root isn't checked, so this only checks the proof-of-work
+    for (uint32_t nonce = 0; ! valid && nonce < 256; nonce++) {
+        block->nonce = nonce;
+        BRMerkleBlockSerialize(block, buf, sizeof(buf));
+        BRSHA256_2(&block->blockHash, buf, sizeof(buf));
+        valid = BRMerkleBlockIsValid(block, now, FAKE_PEER_POW_LIMIT);
+    }
+
+    if (! valid) BRMerkleBlockFree(block), block = NULL;
+    else block->totalTx = totalTx;
+    return block;
+}
+
+static void _BRFakePeerFree(BRFakePeer *fp)
+{
+    for (size_t i = 0; i < array_count(fp->chain); i++) BRMerkleBlockFree(fp->chain[i].block);
+    for (size_t i = 0; i < array_count(fp->txs); i++) BRTransactionFree(fp->txs[i]);
+    if (fp->filter) BRBloomFilterFree(fp->filter);
+    if (fp->blocks) BRSetFree(fp->blocks);
+    if (fp->txSet) BRSetFree(fp->txSet);
+    array_free(fp->chain);
+    array_free(fp->txs);
+    pthread_mutex_destroy(&fp->lock);
+    free(fp);
+}
+
+// creates a chain of blockCount blocks after genesis, ending now, with txCount signed tx paying addrs spread evenly
+// over it plus one more tx in the mempool, returns NULL if a block can't be mined
+static BRFakePeer *_BRFakePeerNew(uint32_t blockCount, size_t txCount, const BRAddress addrs[], size_t addrsCount,
+                                  BRAddressParams addrParams)
+{
+    BRFakePeer *fp = calloc(1, sizeof(*fp));
+    uint32_t now = (uint32_t)time(NULL), genesisTime = now - (blockCount + 1)*FAKE_PEER_BLOCK_INTERVAL;
+    UInt256 secret = uint256("0000000000000000000000000000000000000000000000000000000000000001"), inHash;
+    BRAddress fundingAddr;
+    BRKey key;
+
+    assert(fp != NULL);
+    assert(addrsCount > 0);
+    fp->listenSocket = fp->socket = -1;
+    pthread_mutex_init(&fp->lock, NULL);
+    array_new(fp->chain, blockCount + 1);
+    array_new(fp->txs, txCount + 1);
+    fp->blocks = BRSetNew(BRMerkleBlockHash, BRMerkleBlockEq, blockCount + 1);
+    fp->txSet = BRSetNew(BRTransactionHash, BRTransactionEq, txCount + 1);
+
+    BRKeySetSecret(&key, &secret, 1);
+    BRKeyAddress(&key, fundingAddr.s, sizeof(fundingAddr), addrParams);
+
+    uint8_t inScript[BRAddressScriptPubKey(NULL, 0, addrParams, fundingAddr.s)];
+    size_t inScriptLen = BRAddressScriptPubKey(inScript, sizeof(inScript), addrParams, fundingAddr.s);
+
+    for (size_t i = 0; i <= txCount; i++) {
+        const char *addr = addrs[i % addrsCount].s;
+        uint8_t outScript[BRAddressScriptPubKey(NULL, 0, addrParams, addr)];
+        size_t outScriptLen = BRAddressScriptPubKey(outScript, sizeof(outScript), addrParams, addr);
+        BRTransaction *tx = BRTransactionNew();
+
+        BRSHA256(&inHash, &i, sizeof(i));
+        BRTransactionAddInput(tx, inHash, 0, 100000 + i, inScript, inScriptLen, NULL, 0, NULL, 0, TXIN_SEQUENCE);
+        BRTransactionAddOutput(tx, 10000 + i, outScript, outScriptLen);
+        BRTransactionSign(tx, 0, &key, 1);
+        array_add(fp->txs, tx);
+        BRSetAdd(fp->txSet, tx);
+    }
+
+    BRKeyClean(&key);
+
+    for (uint32_t height = 0, txIdx = 0; height <= blockCount; height++) {
+        BRFakePeerBlock b = { NULL, txIdx, 0 };
+
+        // tx i is confirmed at height 1 + i*blockCount/txCount
+        while (height > 0 && txIdx < txCount && 1 + (uint64_t)txIdx*blockCount/txCount == height) b.txCount++, txIdx++;
+        array_add(fp->chain, b);
+
+        UInt256 leaves[FAKE_PEER_FILLER_TX + b.txCount];
+        size_t leavesCount = _BRFakePeerBlockLeaves(fp, height, leaves);
+        UInt256 merkleRoot = _BRFakePeerMerkleNode(leaves, leavesCount, _BRFakePeerCeilLog2(leavesCount), 0);
+
+        fp->chain[height].block = _BRFakePeerMineBlock((height > 0) ? fp->chain[height - 1].block : NULL, merkleRoot,
+                                                       genesisTime + height*FAKE_PEER_BLOCK_INTERVAL,
+                                                       (uint32_t)leavesCount, now);
+
+        if (! fp->chain[height].block) {
+            array_set_count(fp->chain, height);
+            _BRFakePeerFree(fp);
+            return NULL;
+        }
+
+        BRSetAdd(fp->blocks, fp->chain[height].block);
+    }
+
+    return fp;
+}
+
+static int _BRFakePeerSend(BRFakePeer *fp, const char *type, const uint8_t *msg, size_t msgLen)
+{
+    uint8_t header[FAKE_PEER_HEADER_LENGTH], hash[32];
+    ssize_t n = 0;
+    size_t off = 0;
+
+    memset(header, 0, sizeof(header));
+    UInt32SetLE(&header[0], FAKE_PEER_MAGIC_NUMBER);
+    strncpy((char *)&header[4], type, 12);
+    UInt32SetLE(&header[16], (uint32_t)msgLen);
+    BRSHA256_2(hash, msg, msgLen);
+    memcpy(&header[20], hash, sizeof(uint32_t));
+
+    while (n >= 0 && off < sizeof(header)) {
+        n = send(fp->socket, &header[off], sizeof(header) - off, MSG_NOSIGNAL);
+        if (n > 0) off += n;
+    }
+
+    for (off = 0; n >= 0 && off < msgLen;) {
+        n = send(fp->socket, &msg[off], msgLen - off, MSG_NOSIGNAL);
+        if (n > 0) off += n;
+    }
+
+    return (n >= 0);
+}
+
+static int _BRFakePeerRead(BRFakePeer *fp, uint8_t *buf, size_t len)
+{
+    ssize_t n = 1;
+
+    for (size_t off = 0; n > 0 && off < len; off += n) n = read(fp->socket, &buf[off], len - off);
+    return (n > 0 || len == 0);
+}
+
+static int _BRFakePeerSendVersion(BRFakePeer *fp)
+{
+    size_t off = 0, userAgentLen = strlen(FAKE_PEER_USER_AGENT);
+    uint8_t msg[80 + BRVarIntSize(userAgentLen) + userAgentLen + 5];
+    uint64_t services = SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM;
+
+    memset(msg, 0, sizeof(msg));
+    UInt32SetLE(&msg[off], FAKE_PEER_VERSION);
+    off += sizeof(uint32_t);
+    UInt64SetLE(&msg[off], services);
+    off += sizeof(uint64_t);
+    UInt64SetLE(&msg[off], (uint64_t)time(NULL));
+    off += sizeof(uint64_t);
+    off += sizeof(uint64_t) + sizeof(UInt128) + sizeof(uint16_t); // receiving node, unused by BRPeer
+    UInt64SetLE(&msg[off], services);
+    off += sizeof(uint64_t) + sizeof(UInt128) + sizeof(uint16_t); // sending node address
+    UInt64SetLE(&msg[off], 0x0123456789abcdef); // nonce
+    off += sizeof(uint64_t);
+    off += BRVarIntSet(&msg[off], sizeof(msg) - off, userAgentLen);
+    memcpy(&msg[off], FAKE_PEER_USER_AGENT, userAgentLen);
+    off += userAgentLen;
+    UInt32SetLE(&msg[off], (uint32_t)(array_count(fp->chain) - 1)); // last block
+    off += sizeof(uint32_t);
+    msg[off++] = 0; // relay
+    return _BRFakePeerSend(fp, MSG_VERSION, msg, off) && _BRFakePeerSend(fp, MSG_VERACK, NULL, 0);
+}
+
+// returns the height following the first locator found in the chain, or 1 if none are
+static uint32_t _BRFakePeerLocate(const BRFakePeer *fp, const uint8_t *msg, size_t msgLen)
+{
+    size_t off = sizeof(uint32_t), len = 0, count = (size_t)BRVarInt(&msg[off], msgLen - off, &len);
+    BRMerkleBlock *block = NULL;
+
+    off += len;
+
+    for (size_t i = 0; ! block && i < count && off + sizeof(UInt256) <= msgLen; i++, off += sizeof(UInt256)) {
+        UInt256 hash = UInt256Get(&msg[off]);
+
+        block = BRSetGet(fp->blocks, &hash);
+    }
+
+    return (block) ? block->height + 1 : 1;
+}
+
+static int _BRFakePeerSendHeaders(BRFakePeer *fp, const uint8_t *msg, size_t msgLen)
+{
+    uint32_t height = _BRFakePeerLocate(fp, msg, msgLen);
+    size_t count = (height < array_count(fp->chain)) ? array_count(fp->chain) - height : 0, off = 0;
+
+    if (count > FAKE_PEER_MAX_HEADERS) count = FAKE_PEER_MAX_HEADERS;
+
+    uint8_t *buf = malloc(BRVarIntSize(count) + 81*count);
+    int r;
+
+    assert(buf != NULL);
+    off += BRVarIntSet(buf, BRVarIntSize(count), count);
+
+    for (size_t i = 0; i < count; i++) {
+        BRMerkleBlock header = *fp->chain[height + i].block;
+
+        header.totalTx = 0;
+        off += BRMerkleBlockSerialize(&header, &buf[off], 80);
+        buf[off++] = 0; // tx count
+    }
+
+    r = _BRFakePeerSend(fp, MSG_HEADERS, buf, off);
+    free(buf);
+    return r;
+}
+
+static int _BRFakePeerSendBlockInv(BRFakePeer *fp, const uint8_t *msg, size_t msgLen)
+{
+    uint32_t height = _BRFakePeerLocate(fp, msg, msgLen);
+    size_t count = (height < array_count(fp->chain)) ? array_count(fp->chain) - height : 0, off = 0;
+
+    if (count > FAKE_PEER_MAX_BLOCK_INV) count = FAKE_PEER_MAX_BLOCK_INV;
+    if (count == 0) return 1;
+
+    uint8_t buf[BRVarIntSize(count) + 36*count];
+
+    off += BRVarIntSet(buf, sizeof(buf), count);
+
+    for (size_t i = 0; i < count; i++, off += 36) {
+        UInt32SetLE(&buf[off], INV_BLOCK);
+        UInt256Set(&buf[off + sizeof(uint32_t)], fp->chain[height + i].block->blockHash);
+    }
+
+    return _BRFakePeerSend(fp, MSG_INV, buf, off);
+}
+
+static int _BRFakePeerSendTx(BRFakePeer *fp, const BRTransaction *tx)
+{
+    uint8_t buf[BRTransactionSerialize(tx, NULL, 0)];
+    size_t len = BRTransactionSerialize(tx, buf, sizeof(buf));
+
+    return _BRFakePeerSend(fp, MSG_TX, buf, len);
+}
+
+// sends a merkleblock followed by the matched tx, as a full node does for getdata inv_filtered_block
+static int _BRFakePeerSendMerkleBlock(BRFakePeer *fp, const BRMerkleBlock *block)
+{
+    const BRFakePeerBlock *b = &fp->chain[block->height];
+    UInt256 leaves[FAKE_PEER_FILLER_TX + b->txCount], *hashes;
+    size_t count = _BRFakePeerBlockLeaves(fp, block->height, leaves), flagIdx = 0;
+    uint8_t matched[count], *flags;
+    int r = 1;
+
+    memset(matched, 0, sizeof(matched));
+
+    for (size_t i = 0; fp->filter && i < b->txCount; i++) {
+        matched[FAKE_PEER_FILLER_TX + i] = (uint8_t)_BRFakePeerTxMatchesFilter(fp->filter, fp->txs[b->txIdx + i]);
+    }
+
+    array_new(hashes, 16);
+    array_new(flags, 4);
+    _BRFakePeerMerkleBranch(leaves, matched, count, _BRFakePeerCeilLog2(count), 0, &hashes, &flags, &flagIdx);
+
+    BRMerkleBlock merkleBlock = *block;
+
+    merkleBlock.hashes = hashes;
+    merkleBlock.hashesCount = array_count(hashes);
+    merkleBlock.flags = flags;
+    merkleBlock.flagsLen = array_count(flags);
+
+    uint8_t buf[BRMerkleBlockSerialize(&merkleBlock, NULL, 0)];
+
+    r = _BRFakePeerSend(fp, MSG_MERKLEBLOCK, buf, BRMerkleBlockSerialize(&merkleBlock, buf, sizeof(buf)));
+    array_free(hashes);
+    array_free(flags);
+
+    for (size_t i = 0; r && i < b->txCount; i++) {
+        if (matched[FAKE_PEER_FILLER_TX + i]) r = _BRFakePeerSendTx(fp, fp->txs[b->txIdx + i]);
+    }
+
+    return r;
+}
+
+static int _BRFakePeerAcceptGetdata(BRFakePeer *fp, const uint8_t *msg, size_t msgLen)
+{
+    size_t off = 0, count = (size_t)BRVarInt(msg, msgLen, &off), notFoundCount = 0;
+    uint8_t *notFound;
+    int r = (off > 0 && off + 36*count <= msgLen);
+
+    array_new(notFound, 36);
+
+    for (size_t i = 0; r && i < count; i++, off += 36) {
+        uint32_t type = UInt32GetLE(&msg[off]) & ~INV_WITNESS_FLAG;
+        UInt256 hash = UInt256Get(&msg[off + sizeof(uint32_t)]);
+        BRMerkleBlock *block = (type == INV_FILTERED_BLOCK) ? BRSetGet(fp->blocks, &hash) : NULL;
+        BRTransaction *tx = (type == INV_TX) ? BRSetGet(fp->txSet, &hash) : NULL;
+
+        if (block) r = _BRFakePeerSendMerkleBlock(fp, block);
+        else if (tx) r = _BRFakePeerSendTx(fp, tx);
+        else {
+            array_add_array(notFound, &msg[off], 36);
+            notFoundCount++;
+        }
+    }
+
+    if (r && notFoundCount > 0) {
+        uint8_t buf[BRVarIntSize(notFoundCount) + array_count(notFound)];
+        size_t len = BRVarIntSet(buf, sizeof(buf), notFoundCount);
+
+        memcpy(&buf[len], notFound, array_count(notFound));
+        r = _BRFakePeerSend(fp, MSG_NOTFOUND, buf, sizeof(buf));
+    }
+
+    array_free(notFound);
+    return r;
+}
+
+// the last tx is the only one in the mempool
+static int _BRFakePeerAcceptMempool(BRFakePeer *fp)
+{
+    BRTransaction *tx = fp->txs[array_count(fp->txs) - 1];
+    uint8_t buf[BRVarIntSize(1) + 36];
+    size_t off = BRVarIntSet(buf, sizeof(buf), 1);
+
+    if (! fp->filter || ! _BRFakePeerTxMatchesFilter(fp->filter, tx)) off = BRVarIntSet(buf, sizeof(buf), 0);
+    else {
+        UInt32SetLE(&buf[off], INV_TX);
+        UInt256Set(&buf[off + sizeof(uint32_t)], tx->txHash);
+        off += 36;
+    }
+
+    return _BRFakePeerSend(fp, MSG_INV, buf, off);
+}
+
+static int _BRFakePeerAcceptMessage(BRFakePeer *fp, const char *type, const uint8_t *msg, size_t msgLen)
+{
+    int r = 1;
+
+    if (0 == strncmp(MSG_VERSION, type, 12)) r = _BRFakePeerSendVersion(fp);
+    else if (0 == strncmp(MSG_FILTERLOAD, type, 12)) {
+        if (fp->filter) BRBloomFilterFree(fp->filter);
+        fp->filter = BRBloomFilterParse(msg, msgLen);
+        r = (fp->filter != NULL);
+    }
+    else if (0 == strncmp(MSG_GETHEADERS, type, 12)) r = _BRFakePeerSendHeaders(fp, msg, msgLen);
+    else if (0 == strncmp(MSG_GETBLOCKS, type, 12)) r = _BRFakePeerSendBlockInv(fp, msg, msgLen);
+    else if (0 == strncmp(MSG_GETDATA, type, 12)) r = _BRFakePeerAcceptGetdata(fp, msg, msgLen);
+    else if (0 == strncmp(MSG_MEMPOOL, type, 12)) r = _BRFakePeerAcceptMempool(fp);
+    else if (0 == strncmp(MSG_PING, type, 12)) r = _BRFakePeerSend(fp, MSG_PONG, msg, msgLen);
+    else if (0 == strncmp(MSG_GETADDR, type, 12)) r = _BRFakePeerSend(fp, MSG_ADDR, (const uint8_t *)"", 1);
+
+    return r;
+}
+
+// serves one client at a time until the connection is closed
+static void _BRFakePeerServe(BRFakePeer *fp)
+{
+    uint8_t header[FAKE_PEER_HEADER_LENGTH], *payload = NULL;
+    size_t payloadLen = 0;
+    int r = 1;
+
+    while (r && ! fp->stop && _BRFakePeerRead(fp, header, sizeof(header))) {
+        uint32_t msgLen = UInt32GetLE(&header[16]);
+        char type[13];
+
+        memcpy(type, &header[4], 12);
+        type[12] = '\0';
+        r = (UInt32GetLE(header) == FAKE_PEER_MAGIC_NUMBER && msgLen <= FAKE_PEER_MAX_MSG_LENGTH);
+        if (r && msgLen > payloadLen) payload = realloc(payload, (payloadLen = msgLen));
+        if (r) r = _BRFakePeerRead(fp, payload, msgLen);
+        if (r) r = _BRFakePeerAcceptMessage(fp, type, payload, msgLen);
+    }
+
+    free(payload);
+}
+
+static void *_BRFakePeerThreadRoutine(void *arg)
+{
+    BRFakePeer *fp = arg;
+    struct pollfd pfd = { fp->listenSocket, POLLIN, 0 };
+
+    while (! fp->stop) {
+        if (poll(&pfd, 1, 100) <= 0 || ! (pfd.revents & POLLIN)) continue;
+
+        int sock = accept(fp->listenSocket, NULL, NULL);
+
+        if (sock < 0) continue;
+        pthread_mutex_lock(&fp->lock);
+        fp->socket = sock;
+        pthread_mutex_unlock(&fp->lock);
+
+        _BRFakePeerServe(fp);
+
+        pthread_mutex_lock(&fp->lock);
+        close(fp->socket);
+        fp->socket = -1;
+        if (fp->filter) BRBloomFilterFree(fp->filter);
+        fp->filter = NULL;
+        pthread_mutex_unlock(&fp->lock);
+    }
+
+    return NULL;
+}
+
+// listens on an ephemeral loopback port
+static int _BRFakePeerStart(BRFakePeer *fp)
+{
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof(addr);
+    int on = 1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    fp->listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (fp->listenSocket < 0) return 0;
+    setsockopt(fp->listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fp->listenSocket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    if (bind(fp->listenSocket, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fp->listenSocket, 4) < 0 ||
+        getsockname(fp->listenSocket, (struct sockaddr *)&addr, &addrLen) < 0 ||
+        pthread_create(&fp->thread, NULL, _BRFakePeerThreadRoutine, fp) != 0) {
+        close(fp->listenSocket);
+        fp->listenSocket = -1;
+        return 0;
+    }
+
+    fp->port = ntohs(addr.sin_port);
+    return 1;
+}
+
+static void _BRFakePeerStop(BRFakePeer *fp)
+{
+    fp->stop = 1;
+    pthread_mutex_lock(&fp->lock);
+    if (fp->socket >= 0) shutdown(fp->socket, SHUT_RDWR);
+    pthread_mutex_unlock(&fp->lock);
+    pthread_join(fp->thread, NULL);
+    close(fp->listenSocket);
+    fp->listenSocket = -1;
+}
+
+//
+// Sync Benchmark
+//
+// every block is mined at the proof-of-work limit, there are no difficulty adjustments
+static int _BRFakePeerVerifyDifficulty(const BRMerkleBlock *block, const BRSet *blockSet)
+{
+    return block->target == FAKE_PEER_POW_LIMIT;
+}
+
+typedef struct {
+    int done, error;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BRPerfSyncContext;
+
+static void _BRPerfSyncStopped(void *info, int error)
+{
+    BRPerfSyncContext *context = info;
+
+    pthread_mutex_lock(&context->lock);
+    context->done = 1;
+    context->error = error;
+    pthread_cond_signal(&context->cond);
+    pthread_mutex_unlock(&context->lock);
+}
+
+inline static double _BRPerfSeconds(struct timeval tv)
+{
+    return (double)tv.tv_sec + 1e-6*(double)tv.tv_usec;
+}
+
+// Syncs a wallet with addrsCount receive addresses from genesis over a blockCount block chain holding txCount wallet tx,
+// all served by a BRFakePeer, and reports wall time, blocks/s, CPU time and peak RSS of the process (server included).
+// The chain is mined at the regtest proof-of-work limit, which the sync's chain params allow. Returns 0 if the sync
+// can't be run or doesn't complete.
+extern int BRRunPerfTestsSync(uint32_t blockCount, size_t txCount, size_t addrsCount)
+{
+    const char *phrase = "a random seed";
+    static const char * const dnsSeeds[] = { NULL };
+    UInt512 seed;
+    BRPerfSyncContext context = { 0, 0 };
+    struct timespec start, stop;
+    struct rusage usageStart, usageStop;
+    BRCheckPoint checkpoint;
+    BRFakePeer *fp;
+    int r = 1;
+
+    if (addrsCount == 0) addrsCount = 1;
+    BRBIP39DeriveKey(&seed, phrase, NULL);
+
+    BRMasterPubKey mpk = BRBIP32MasterPubKey(&seed, sizeof(seed));
+    BRWallet *wallet = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    BRAddress *addrs = calloc(addrsCount, sizeof(*addrs));
+
+    assert(addrs != NULL);
+    addrsCount = BRWalletUnusedAddrs(wallet, addrs, (uint32_t)addrsCount, SEQUENCE_EXTERNAL_CHAIN);
+    fp = _BRFakePeerNew(blockCount, txCount, addrs, addrsCount, BRMainNetParams->addrParams);
+    free(addrs);
+
+    if (! fp) {
+        fprintf(stderr, "***FAILED*** %s: can't mine the chain\n", __func__);
+        BRWalletFree(wallet);
+        return 0;
+    }
+
+    if (! _BRFakePeerStart(fp)) {
+        fprintf(stderr, "***FAILED*** %s: can't listen on loopback: %s\n", __func__, strerror(errno));
+        _BRFakePeerFree(fp);
+        BRWalletFree(wallet);
+        return 0;
+    }
+
+    checkpoint = (BRCheckPoint) { 0, UInt256Reverse(fp->chain[0].block->blockHash), fp->chain[0].block->timestamp,
+                                  fp->chain[0].block->target };
+
+    BRChainParams params = { dnsSeeds, fp->port, FAKE_PEER_MAGIC_NUMBER, 0, _BRFakePeerVerifyDifficulty,
+                             FAKE_PEER_POW_LIMIT, &checkpoint, 1, BRMainNetParams->addrParams, BITCOIN_FORKID };
+    BRPeerManager *manager = BRPeerManagerNew(&params, wallet, checkpoint.timestamp, NULL, 0, NULL, 0);
+    UInt128 loopback = { .u8 = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 127, 0, 0, 1 } };
+
+    pthread_mutex_init(&context.lock, NULL);
+    pthread_cond_init(&context.cond, NULL);
+    BRPeerManagerSetCallbacks(manager, &context, NULL, _BRPerfSyncStopped, NULL, NULL, NULL, NULL, NULL);
+    BRPeerManagerSetFixedPeer(manager, loopback, fp->port);
+
+    getrusage(RUSAGE_SELF, &usageStart);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    BRPeerManagerConnect(manager);
+
+    pthread_mutex_lock(&context.lock);
+    while (! context.done) pthread_cond_wait(&context.cond, &context.lock);
+    pthread_mutex_unlock(&context.lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    getrusage(RUSAGE_SELF, &usageStop);
+
+    double seconds = (double)(stop.tv_sec - start.tv_sec) + 1e-9*(double)(stop.tv_nsec - start.tv_nsec);
+    double cpu = _BRPerfSeconds(usageStop.ru_utime) - _BRPerfSeconds(usageStart.ru_utime) +
+                 _BRPerfSeconds(usageStop.ru_stime) - _BRPerfSeconds(usageStart.ru_stime);
+#if defined(__APPLE__)
+    long peakRSS = usageStop.ru_maxrss/1024; // bytes on darwin
+#else
+    long peakRSS = usageStop.ru_maxrss;      // kilobytes elsewhere
+#endif
+    uint32_t height = BRPeerManagerLastBlockHeight(manager);
+    size_t walletTxCount = BRWalletTransactions(wallet, NULL, 0);
+
+    printf("sync %"PRIu32" blocks, %zu wallet tx, %zu addresses:\n", blockCount, txCount, addrsCount);
+    printf("    time: %8.3fs, %10.0f blocks/s, cpu: %8.3fs, peak rss: %ld KB\n", seconds, blockCount/seconds, cpu,
+           peakRSS);
+
+    if (context.error != 0 || height != blockCount || walletTxCount != txCount + 1) {
+        fprintf(stderr, "***FAILED*** %s: sync error: %d, height: %"PRIu32", wallet tx: %zu\n", __func__,
+                context.error, height, walletTxCount);
+        r = 0;
+    }
+
+    BRPeerManagerDisconnect(manager);
+    BRPeerManagerFree(manager);
+    _BRFakePeerStop(fp);
+    _BRFakePeerFree(fp);
+    BRWalletFree(wallet);
+    pthread_cond_destroy(&context.cond);
+    pthread_mutex_destroy(&context.lock);
+    return r;
+}
@@ -14,16 +14,20 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 
+#include "BRCryptoAccount.h"
 #include "BRCryptoAmount.h"
 #include "BRCryptoWallet.h"
 #include "crypto/BRCryptoNetworkP.h"
 #include "crypto/BRCryptoTransferP.h"
+#include "crypto/BRCryptoWalletP.h"
 #include "crypto/BRCryptoWalletManagerP.h"
 
 #include "support/BRBIP32Sequence.h"
 #include "support/BRBIP39Mnemonic.h"
+#include "support/BRBIP39WordsEn.h"
 #include "bitcoin/BRChainParams.h"
 #include "bitcoin/BRWallet.h"
 
@@ -295,10 +299,139 @@ transferTestsAddress (void) {
     BRWalletFree(wid);
 }
 
+#define TRANSFER_TESTS_WALLET_LOAD_COUNT      (100000)
+
+static double
+transferTestsSecondsSince (struct timespec start) {
+    struct timespec stop;
+    clock_gettime (CLOCK_MONOTONIC, &stop);
+    return (double) (stop.tv_sec - start.tv_sec) + 1e-9 * (double) (stop.tv_nsec - start.tv_nsec);
+}
+
+// Load a wallet with many transfers, as a sync would: find each transfer and, if not found, add
+// it.  Then remove every other transfer and confirm the remaining are found, in order, and are
+// available by snapshot, page and version.
+static void
+transferTestsWalletLoad (void) {
+    BRCryptoCurrency btc =
+    cryptoCurrencyCreate ("BitcoinUIDS",
+                          "Bitcoin",
+                          "BTC",
+                          "native",
+                          NULL);
+
+    BRCryptoUnit sat =
+    cryptoUnitCreateAsBase (btc,
+                            "SatoshiUIDS",
+                            "Satoshi",
+                            "SAT");
+
+    BRMasterPubKey mpk = transferTestsGetMPK();
+    BRWallet *wid = BRWalletNew (BRTestNetParams->addrParams, NULL, 0, mpk);
+    BRWalletSetCallbacks (wid, NULL, NULL, NULL, NULL, NULL);
+
+    BRCryptoTransferTest *test = &transferTests[0];
+    size_t   testRawSize;
+    uint8_t *testRawBytes = hexDecodeCreate(&testRawSize, test->rawChars, strlen (test->rawChars));
+    BRTransaction *tid = BRTransactionParse (testRawBytes, testRawSize);
+    free (testRawBytes);
+
+    size_t count = TRANSFER_TESTS_WALLET_LOAD_COUNT;
+    BRTransaction   **tids      = calloc (count, sizeof (BRTransaction *));
+    BRCryptoTransfer *transfers = calloc (count, sizeof (BRCryptoTransfer));
+    for (size_t index = 0; index < count; index++) {
+        tids[index]      = BRTransactionCopy (tid);
+        transfers[index] = cryptoTransferCreateAsBTC (sat, sat, wid, tids[index], CRYPTO_TRUE);
+    }
+
+    BRCryptoWallet wallet = cryptoWalletCreateAsBTC (sat, sat, NULL, wid);
+    struct timespec start;
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (size_t index = 0; index < count; index++) {
+        BRCryptoTransfer found = cryptoWalletFindTransferAsBTC (wallet, tids[index]);
+        assert (NULL == found);
+        cryptoWalletAddTransfer (wallet, transfers[index]);
+    }
+    printf ("    Wallet Load: %zu transfers in %.3f s\n", count, transferTestsSecondsSince (start));
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (size_t index = 0; index < count; index++) {
+        BRCryptoTransfer found = cryptoWalletFindTransferAsBTC (wallet, tids[index]);
+        assert (found == transfers[index]);
+        cryptoTransferGive (found);
+    }
+    printf ("    Wallet Find: %zu transfers in %.3f s\n", count, transferTestsSecondsSince (start));
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (size_t index = 0; index < count; index += 2)
+        cryptoWalletRemTransfer (wallet, transfers[index]);
+    printf ("    Wallet Rem : %zu transfers in %.3f s\n", count / 2, transferTestsSecondsSince (start));
+
+    size_t walletTransfersCount;
+    BRCryptoTransfer *walletTransfers = cryptoWalletGetTransfers (wallet, &walletTransfersCount);
+    assert (count / 2 == walletTransfersCount);
+    for (size_t index = 0; index < walletTransfersCount; index++) {
+        assert (walletTransfers[index] == transfers[2 * index + 1]);
+        assert (CRYPTO_TRUE  == cryptoWalletHasTransfer (wallet, transfers[2 * index + 1]));
+        assert (CRYPTO_FALSE == cryptoWalletHasTransfer (wallet, transfers[2 * index]));
+        cryptoTransferGive (walletTransfers[index]);
+    }
+    free (walletTransfers);
+
+    // A snapshot is shared until the transfers change; a page is a slice of the snapshot
+    uint64_t version = cryptoWalletGetTransfersVersion (wallet);
+    BRCryptoWalletTransfers snapshot = cryptoWalletGetTransfersSnapshot (wallet);
+    BRCryptoWalletTransfers snapshotAgain = cryptoWalletGetTransfersSnapshot (wallet);
+    assert (snapshot == snapshotAgain);
+    assert (version == cryptoWalletTransfersGetVersion (snapshot));
+    assert (count / 2 == cryptoWalletTransfersGetCount (snapshot));
+    cryptoWalletTransfersGive (snapshotAgain);
+
+    size_t pageCount;
+    BRCryptoTransfer *page = cryptoWalletGetTransfersPaged (wallet, 100, 50, &pageCount);
+    assert (50 == pageCount);
+    for (size_t index = 0; index < pageCount; index++) {
+        assert (page[index] == cryptoWalletTransfersGetAt (snapshot, 100 + index));
+        cryptoTransferGive (page[index]);
+    }
+    free (page);
+
+    BRCryptoBoolean hasRemoved;
+    size_t changedCount;
+    BRCryptoTransfer *changed = cryptoWalletGetTransfersChangedSince (wallet, version, &hasRemoved, &changedCount);
+    assert (NULL == changed && 0 == changedCount && CRYPTO_FALSE == hasRemoved);
+
+    cryptoWalletUpdTransfer (wallet, transfers[1]);
+    changed = cryptoWalletGetTransfersChangedSince (wallet, version, &hasRemoved, &changedCount);
+    assert (1 == changedCount && transfers[1] == changed[0] && CRYPTO_FALSE == hasRemoved);
+    cryptoTransferGive (changed[0]);
+    free (changed);
+
+    snapshotAgain = cryptoWalletGetTransfersSnapshot (wallet);
+    assert (snapshot != snapshotAgain);
+    cryptoWalletTransfersGive (snapshotAgain);
+    cryptoWalletTransfersGive (snapshot);
+
+    cryptoWalletGive (wallet);
+    for (size_t index = 0; index < count; index++) {
+        cryptoTransferGive (transfers[index]);
+        BRTransactionFree (tids[index]);
+    }
+    free (transfers);
+    free (tids);
+    BRTransactionFree (tid);
+
+    BRWalletFree (wid);
+    cryptoUnitGive (sat);
+    cryptoCurrencyGive (btc);
+}
+
 static void
 runCryptoTransferTests (void) {
     transferTestsBalance();
     transferTestsAddress();
+    transferTestsWalletLoad();
 }
 
 ///
@@ -410,6 +543,95 @@ _CWMNopEstimateTransactionFeeCallback (BRCryptoClientContext context,
 
 }
 
+// BRCryptoCWMClient Request Recording
+
+typedef struct {
+    pthread_mutex_t lock;
+    BRArrayOf(BRCryptoClientCallbackState) blockNumberRequests;     // in order of request
+    BRArrayOf(BRCryptoClientCallbackState) transactionsRequests;    // in order of request
+} CWMClientRecordingState;
+
+static void
+CWMClientRecordingStateNew (CWMClientRecordingState *state) {
+    pthread_mutex_init (&state->lock, NULL);
+    array_new (state->blockNumberRequests, 10);
+    array_new (state->transactionsRequests, 10);
+}
+
+static void
+CWMClientRecordingStateFree (CWMClientRecordingState *state) {
+    array_free (state->transactionsRequests);
+    array_free (state->blockNumberRequests);
+    pthread_mutex_destroy (&state->lock);
+}
+
+static size_t
+CWMClientRecordingGetBlockNumberCount (CWMClientRecordingState *state) {
+    pthread_mutex_lock (&state->lock);
+    size_t count = array_count (state->blockNumberRequests);
+    pthread_mutex_unlock (&state->lock);
+    return count;
+}
+
+static BRCryptoClientCallbackState
+CWMClientRecordingGetBlockNumberRequest (CWMClientRecordingState *state,
+                                         size_t index) {
+    pthread_mutex_lock (&state->lock);
+    BRCryptoClientCallbackState callbackState = state->blockNumberRequests[index];
+    pthread_mutex_unlock (&state->lock);
+    return callbackState;
+}
+
+static size_t
+CWMClientRecordingGetTransactionsCount (CWMClientRecordingState *state) {
+    pthread_mutex_lock (&state->lock);
+    size_t count = array_count (state->transactionsRequests);
+    pthread_mutex_unlock (&state->lock);
+    return count;
+}
+
+static BRCryptoClientCallbackState
+CWMClientRecordingGetTransactionsRequest (CWMClientRecordingState *state,
+                                          size_t index) {
+    pthread_mutex_lock (&state->lock);
+    BRCryptoClientCallbackState callbackState = state->transactionsRequests[index];
+    pthread_mutex_unlock (&state->lock);
+    return callbackState;
+}
+
+static void
+_CWMClientRecordingGetBlockNumberCallback (BRCryptoClientContext context,
+                                           OwnershipGiven BRCryptoWalletManager manager,
+                                           OwnershipGiven BRCryptoClientCallbackState callbackState) {
+    CWMClientRecordingState *state = (CWMClientRecordingState*) context;
+
+    // The test answers, as the client would, with the recorded callbackState
+    pthread_mutex_lock (&state->lock);
+    array_add (state->blockNumberRequests, callbackState);
+    pthread_mutex_unlock (&state->lock);
+
+    cryptoWalletManagerGive (manager);
+}
+
+static void
+_CWMClientRecordingGetTransactionsCallback (BRCryptoClientContext context,
+                                            OwnershipGiven BRCryptoWalletManager manager,
+                                            OwnershipGiven BRCryptoClientCallbackState callbackState,
+                                            OwnershipKept const char **addresses,
+                                            size_t addressCount,
+                                            OwnershipKept const char *currency,
+                                            uint64_t begBlockNumber,
+                                            uint64_t endBlockNumber) {
+    CWMClientRecordingState *state = (CWMClientRecordingState*) context;
+
+    // The test answers, as the client would, with the recorded callbackState
+    pthread_mutex_lock (&state->lock);
+    array_add (state->transactionsRequests, callbackState);
+    pthread_mutex_unlock (&state->lock);
+
+    cryptoWalletManagerGive (manager);
+}
+
 // BRCryptoCWMListener Event Wrapper
 
 typedef enum {
@@ -521,6 +743,42 @@ CWMEventForWalletType(BRCryptoWalletEventType type) {
     };
 }
 
+static CWMEvent
+CWMEventForWalletBalanceUpdated(BRCryptoAmount amount) {
+    return (CWMEvent) {
+        SYNC_EVENT_WALLET_TYPE,
+        {
+            .w = {
+                NULL,
+                NULL,
+                (BRCryptoWalletEvent) {
+                    CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                    {
+                        .balanceUpdated = { amount }
+                    }
+                }
+            }
+        }
+    };
+}
+
+static CWMEvent
+CWMEventForTransferType(BRCryptoTransferEventType type) {
+    return (CWMEvent) {
+        SYNC_EVENT_TXN_TYPE,
+        {
+            .t = {
+                NULL,
+                NULL,
+                NULL,
+                (BRCryptoTransferEvent) {
+                    type
+                }
+            }
+        }
+    };
+}
+
 static int
 CWMEventEqual (CWMEvent *e1, CWMEvent *e2) {
     int success = 1;
@@ -712,6 +970,90 @@ _CWMEventRecordingTransferCallback (BRCryptoCWMListenerContext context,
     pthread_mutex_unlock (&state->lock);
 }
 
+// BRCryptoCWMBatchedListener Event Recording
+
+typedef struct {
+    CWMEventRecordingState state;   // the events of every batch, in order of delivery
+    BRArrayOf(size_t) batches;      // the number of events in each batch, guarded by state.lock
+} CWMBatchRecordingState;
+
+static void
+CWMBatchRecordingStateNew (CWMBatchRecordingState *state) {
+    CWMEventRecordingStateNewDefault (&state->state);
+    array_new (state->batches, 10);
+}
+
+static void
+CWMBatchRecordingStateFree (CWMBatchRecordingState *state) {
+    array_free (state->batches);
+    CWMEventRecordingStateFree (&state->state);
+}
+
+static size_t
+CWMBatchRecordingGetBatchCount (CWMBatchRecordingState *state) {
+    pthread_mutex_lock (&state->state.lock);
+    size_t count = array_count (state->batches);
+    pthread_mutex_unlock (&state->state.lock);
+    return count;
+}
+
+static int
+CWMBatchRecordingVerifyBatches (CWMBatchRecordingState *state,
+                                size_t *expected,
+                                size_t expectedCount) {
+    pthread_mutex_lock (&state->state.lock);
+    int success = (expectedCount == array_count (state->batches));
+    for (size_t index = 0; success && index < expectedCount; index++)
+        success = (expected[index] == state->batches[index]);
+
+    if (!success) {
+        printf("%s: failed due to mismatched batches (expected %zu, received %zu:",
+               __func__,
+               expectedCount,
+               array_count (state->batches));
+        for (size_t index = 0; index < array_count (state->batches); index++)
+            printf(" %zu", state->batches[index]);
+        printf(")\n");
+    }
+    pthread_mutex_unlock (&state->state.lock);
+    return success;
+}
+
+// TODO(fix): As the BRCryptoCWMListener callbacks, this leaks the ref counted event fields
+
+static void
+_CWMBatchRecordingEventsCallback (BRCryptoCWMListenerContext context,
+                                  BRCryptoCWMListenerEvent *events,
+                                  size_t eventsCount) {
+    CWMBatchRecordingState *state = (CWMBatchRecordingState*) context;
+
+    pthread_mutex_lock (&state->state.lock);
+    array_add (state->batches, eventsCount);
+    pthread_mutex_unlock (&state->state.lock);
+
+    for (size_t index = 0; index < eventsCount; index++) {
+        BRCryptoCWMListenerEvent *event = &events[index];
+        switch (event->type) {
+            case CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER:
+                _CWMEventRecordingManagerCallback (&state->state, event->manager, event->u.manager);
+                break;
+            case CRYPTO_CWM_LISTENER_EVENT_WALLET:
+                _CWMEventRecordingWalletCallback (&state->state, event->manager, event->wallet, event->u.wallet);
+                break;
+            case CRYPTO_CWM_LISTENER_EVENT_TRANSFER:
+                _CWMEventRecordingTransferCallback (&state->state, event->manager, event->wallet, event->transfer, event->u.transfer);
+                break;
+        }
+
+        // The batched manager is only released once every event has been delivered; give back
+        // the references so that the manager can be released when the test is done with it.
+        cryptoWalletManagerGive (event->manager);
+        if (NULL != event->wallet)   cryptoWalletGive   (event->wallet);
+        if (NULL != event->transfer) cryptoTransferGive (event->transfer);
+    }
+    free (events);
+}
+
 #pragma clang diagnostic push
 #pragma GCC diagnostic push
 #pragma clang diagnostic ignored "-Wunused-function"
@@ -1505,6 +1847,683 @@ runCryptoWalletManagerLifecycleWithSetModeTest (BRCryptoAccount account,
     return success;
 }
 
+///
+/// Mark: Batched Listener Tests
+///
+
+static BRCryptoWalletManager
+BRCryptoWalletManagerSetupForBatchedTest (CWMBatchRecordingState *state,
+                                          size_t eventsLimit,
+                                          uint64_t latencyInMilliseconds,
+                                          BRCryptoAccount account,
+                                          BRCryptoNetwork network,
+                                          BRCryptoSyncMode mode,
+                                          BRCryptoAddressScheme scheme,
+                                          const char *storagePath)
+{
+    BRCryptoCWMBatchedListener listener = (BRCryptoCWMBatchedListener) {
+        state,
+        _CWMBatchRecordingEventsCallback,
+        eventsLimit,
+        latencyInMilliseconds
+    };
+
+    BRCryptoClient client = (BRCryptoClient) {
+        state,
+        _CWMNopGetBlockNumberCallback,
+        _CWMNopGetTransactionsCallback,
+        _CWMNopGetTransfersCallback,
+        _CWMNopSubmitTransactionCallback,
+        _CWMNopEstimateTransactionFeeCallback
+    };
+
+    return cryptoWalletManagerCreateBatched (listener, client, account, network, mode, scheme, storagePath);
+}
+
+// Announce events through the manager's listener, as the manager itself does
+static void
+CWMBatchedTestAnnounceBlockHeight (BRCryptoWalletManager manager,
+                                   uint64_t blockHeight) {
+    manager->listener.walletManagerEventCallback (manager->listener.context,
+                                                  cryptoWalletManagerTake (manager),
+                                                  (BRCryptoWalletManagerEvent) {
+                                                      CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED,
+                                                      { .blockHeight = { blockHeight }}
+                                                  });
+}
+
+static void
+CWMBatchedTestAnnounceSyncContinues (BRCryptoWalletManager manager,
+                                     BRCryptoSyncPercentComplete percentComplete) {
+    manager->listener.walletManagerEventCallback (manager->listener.context,
+                                                  cryptoWalletManagerTake (manager),
+                                                  (BRCryptoWalletManagerEvent) {
+                                                      CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES,
+                                                      { .syncContinues = { NO_CRYPTO_SYNC_TIMESTAMP, percentComplete }}
+                                                  });
+}
+
+static void
+CWMBatchedTestAnnounceBalance (BRCryptoWalletManager manager,
+                               BRCryptoWallet wallet,
+                               OwnershipGiven BRCryptoAmount amount) {
+    manager->listener.walletEventCallback (manager->listener.context,
+                                           cryptoWalletManagerTake (manager),
+                                           cryptoWalletTake (wallet),
+                                           (BRCryptoWalletEvent) {
+                                               CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                               { .balanceUpdated = { amount }}
+                                           });
+}
+
+static void
+CWMBatchedTestAnnounceTransfer (BRCryptoWalletManager manager,
+                                BRCryptoWallet wallet,
+                                BRCryptoTransfer transfer,
+                                BRCryptoTransferEventType type) {
+    manager->listener.transferEventCallback (manager->listener.context,
+                                             cryptoWalletManagerTake (manager),
+                                             cryptoWalletTake (wallet),
+                                             cryptoTransferTake (transfer),
+                                             (BRCryptoTransferEvent) {
+                                                 type
+                                             });
+}
+
+static int
+runCryptoWalletManagerBatchedListenerTest (BRCryptoAccount account,
+                                           BRCryptoNetwork network,
+                                           BRCryptoSyncMode mode,
+                                           BRCryptoAddressScheme scheme,
+                                           const char *storagePath) {
+    int success = 1;
+
+    // HACK: Managers set the height; we need to be able to restore it between tests
+    BRCryptoBlockChainHeight originalNetworkHeight = cryptoNetworkGetHeight (network);
+
+    printf("Testing BRCryptoWalletManager batched events for mode=\"%s\", network=\"%s (%s)\" and path=\"%s\"...\n",
+           cryptoSyncModeString (mode),
+           cryptoNetworkGetName (network),
+           cryptoNetworkIsMainnet (network) ? "mainnet" : "testnet",
+           storagePath);
+
+    printf("Testing BRCryptoWalletManager batched connect, disconnect...\n");
+    {
+        // Test setup; with a one minute latency, only the disconnect delivers a batch
+        CWMBatchRecordingState state = {0};
+        CWMBatchRecordingStateNew (&state);
+
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForBatchedTest (&state, 1000, 60 * 1000, account, network, mode, scheme, storagePath);
+        BRCryptoWallet wallet = cryptoWalletManagerGetWallet (manager);
+
+        // connect, disconnect
+        cryptoWalletManagerConnect (manager, NULL);
+        sleep(1);
+        success = (0 == CWMBatchRecordingGetBatchCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch delivered before its deadline\n", __func__, __LINE__);
+            return success;
+        }
+
+        cryptoWalletManagerDisconnect (manager);
+        sleep(1);
+        success = (1 == CWMBatchRecordingGetBatchCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch not delivered on disconnect\n", __func__, __LINE__);
+            return success;
+        }
+        cryptoWalletManagerStop (manager);
+
+        // Verification; the events are those of an unbatched manager, in the same order
+        success = CWMEventRecordingVerifyEventSequence(&state.state,
+                                                       CRYPTO_TRUE,
+                                                       (CWMEvent []) {
+                                                           // cryptoWalletManagerCreateBatched()
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_CREATED),
+                                                           CWMEventForWalletType                (CRYPTO_WALLET_EVENT_CREATED),
+                                                           CWMEventForWalletManagerWalletType   (CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                                                                     wallet),
+                                                            // cryptoWalletManagerConnect()
+                                                           CWMEventForWalletManagerStateType    (CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CREATED),
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CONNECTED)),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED),
+                                                           CWMEventForWalletManagerStateType    (CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CONNECTED),
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_SYNCING)),
+                                                            // cryptoWalletManagerDisconnect()
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED),
+                                                           CWMEventForWalletManagerStateType    (CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_SYNCING),
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CONNECTED)),
+                                                           CWMEventForWalletManagerStateType    (CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                                                                                                     cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CONNECTED),
+                                                                                                     cryptoWalletManagerStateDisconnectedInit (cryptoWalletManagerDisconnectReasonUnknown())),
+                                                       },
+                                                       9,
+                                                       (CWMEvent []) {
+                                                           CWMEventForWalletManagerType (CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES),
+                                                           CWMEventForWalletManagerType (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                       },
+                                                       2);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: BRRunTestWalletManagerSyncTestVerifyEventSequence failed\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Test teardown
+        cryptoNetworkSetHeight (network, originalNetworkHeight);
+        cryptoWalletGive (wallet);
+        cryptoWalletManagerGive (manager);
+        CWMBatchRecordingStateFree (&state);
+    }
+
+    printf("Testing BRCryptoWalletManager batched deadline, limit, coalescing and stop...\n");
+    {
+        // Test setup; batches of up to 8 events with a two second latency
+        CWMBatchRecordingState state = {0};
+        CWMBatchRecordingStateNew (&state);
+
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForBatchedTest (&state, 8, 2 * 1000, account, network, mode, scheme, storagePath);
+        BRCryptoWallet wallet = cryptoWalletManagerGetWallet (manager);
+        BRCryptoUnit   unit   = cryptoWalletGetUnit (wallet);
+
+        // a transfer for TRANSFER events
+        BRWallet *wid = BRWalletNew (BRTestNetParams->addrParams, NULL, 0, transferTestsGetMPK());
+        BRWalletSetCallbacks (wid, NULL, NULL, NULL, NULL, NULL);
+
+        size_t   testRawSize;
+        uint8_t *testRawBytes = hexDecodeCreate(&testRawSize, transferTests[0].rawChars, strlen (transferTests[0].rawChars));
+        BRTransaction *tid = BRTransactionParse (testRawBytes, testRawSize);
+        BRWalletRegisterTransaction (wid, tid); // ownership given
+        BRCryptoTransfer transfer = cryptoTransferCreateAsBTC (unit, unit, wid, tid, CRYPTO_TRUE);
+        free (testRawBytes);
+
+        // the creation events are delivered at the deadline...
+        sleep(3);
+        success = CWMBatchRecordingVerifyBatches (&state, (size_t []) { 3 }, 1);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch not delivered at its deadline\n", __func__, __LINE__);
+            return success;
+        }
+
+        // ... a full batch is delivered at once ...
+        for (uint64_t blockHeight = 1; blockHeight <= 8; blockHeight++)
+            CWMBatchedTestAnnounceBlockHeight (manager, blockHeight);
+        sleep(1);
+        success = CWMBatchRecordingVerifyBatches (&state, (size_t []) { 3, 8 }, 2);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch not delivered at its limit\n", __func__, __LINE__);
+            return success;
+        }
+
+        // ... a wallet's BALANCE_UPDATED and the SYNC_CONTINUES are coalesced; the coalesced
+        // events still count towards the limit, so this batch of 6 waits for its deadline ...
+        CWMBatchedTestAnnounceTransfer      (manager, wallet, transfer, CRYPTO_TRANSFER_EVENT_CREATED);
+        CWMBatchedTestAnnounceBalance       (manager, wallet, cryptoAmountCreateInteger (1, unit));
+        CWMBatchedTestAnnounceTransfer      (manager, wallet, transfer, CRYPTO_TRANSFER_EVENT_CHANGED);
+        CWMBatchedTestAnnounceBalance       (manager, wallet, cryptoAmountCreateInteger (2, unit));
+        CWMBatchedTestAnnounceSyncContinues (manager, 50);
+        CWMBatchedTestAnnounceSyncContinues (manager, 75);
+        sleep(1);
+        success = CWMBatchRecordingVerifyBatches (&state, (size_t []) { 3, 8 }, 2);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch delivered before its deadline\n", __func__, __LINE__);
+            return success;
+        }
+        sleep(2);
+        success = CWMBatchRecordingVerifyBatches (&state, (size_t []) { 3, 8, 4 }, 3);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: coalesced batch not delivered at its deadline\n", __func__, __LINE__);
+            return success;
+        }
+
+        // ... and stopping the manager delivers the pending batch at once.
+        CWMBatchedTestAnnounceBlockHeight (manager, 9);
+        cryptoWalletManagerStop (manager);
+        sleep(1);
+        success = CWMBatchRecordingVerifyBatches (&state, (size_t []) { 3, 8, 4, 1 }, 4);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: batch not delivered on stop\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Verification; only the latest BALANCE_UPDATED is delivered, after both TRANSFER events
+        BRCryptoAmount balance = cryptoAmountCreateInteger (2, unit);
+        success = CWMEventRecordingVerifyEventSequence(&state.state,
+                                                       CRYPTO_TRUE,
+                                                       (CWMEvent []) {
+                                                           // cryptoWalletManagerCreateBatched()
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_CREATED),
+                                                           CWMEventForWalletType                (CRYPTO_WALLET_EVENT_CREATED),
+                                                           CWMEventForWalletManagerWalletType   (CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                                                                     wallet),
+                                                           // limit
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                           // coalescing
+                                                           CWMEventForTransferType              (CRYPTO_TRANSFER_EVENT_CREATED),
+                                                           CWMEventForTransferType              (CRYPTO_TRANSFER_EVENT_CHANGED),
+                                                           CWMEventForWalletBalanceUpdated      (balance),
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES),
+                                                           // cryptoWalletManagerStop()
+                                                           CWMEventForWalletManagerType         (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED),
+                                                       },
+                                                       16,
+                                                       NULL,
+                                                       0);
+        cryptoAmountGive (balance);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: BRRunTestWalletManagerSyncTestVerifyEventSequence failed\n", __func__, __LINE__);
+            return success;
+        }
+
+        // the delivered SYNC_CONTINUES is the latest
+        pthread_mutex_lock (&state.state.lock);
+        success = (75 == state.state.events[14]->u.m.event.u.syncContinues.percentComplete);
+        pthread_mutex_unlock (&state.state.lock);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: SYNC_CONTINUES not the latest\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Test teardown
+        cryptoTransferGive (transfer);
+        BRWalletFree (wid);
+        cryptoNetworkSetHeight (network, originalNetworkHeight);
+        cryptoUnitGive (unit);
+        cryptoWalletGive (wallet);
+        cryptoWalletManagerGive (manager);
+        CWMBatchRecordingStateFree (&state);
+    }
+
+    return success;
+}
+
+///
+/// Mark: Client Request Tests
+///
+
+#define CWM_CLIENT_BLOCK_NUMBER_THREADS     (8)
+
+static BRCryptoWalletManager
+BRCryptoWalletManagerSetupForClientRequestTest (CWMEventRecordingState *events,
+                                                CWMClientRecordingState *state,
+                                                BRCryptoAccount account,
+                                                BRCryptoNetwork network,
+                                                BRCryptoSyncMode mode,
+                                                BRCryptoAddressScheme scheme,
+                                                const char *storagePath)
+{
+    BRCryptoCWMListener listener = (BRCryptoCWMListener) {
+        events,
+        _CWMEventRecordingManagerCallback,
+        _CWMEventRecordingWalletCallback,
+        _CWMEventRecordingTransferCallback,
+    };
+
+    BRCryptoClient client = (BRCryptoClient) {
+        state,
+        _CWMClientRecordingGetBlockNumberCallback,
+        _CWMClientRecordingGetTransactionsCallback,
+        _CWMNopGetTransfersCallback,
+        _CWMNopSubmitTransactionCallback,
+        _CWMNopEstimateTransactionFeeCallback
+    };
+
+    return cryptoWalletManagerCreate (listener, client, account, network, mode, scheme, storagePath);
+}
+
+// The NOP clients of the earlier tests never answer; forget their requests so that this test
+// starts with no request in flight, no cached block number and no backoff.
+static void
+CWMClientRequestsResetNetwork (BRCryptoNetwork network) {
+    pthread_mutex_lock (&network->lock);
+    network->blockNumberRequests.leader = NULL;
+    network->blockNumberRequests.blockNumberTimestamp = 0;
+    array_clear (network->clientRequests.inFlight);
+    network->clientRequests.failures = 0;
+    network->clientRequests.backoffUntil = 0;
+    pthread_mutex_unlock (&network->lock);
+}
+
+// Request the block number as BTC does, through the BRWalletManagerClient of `manager`
+static void
+CWMClientRequestBlockNumber (BRCryptoWalletManager manager) {
+    BRWalletManagerClient client = cryptoWalletManagerClientCreateBTCClient (manager);
+    client.funcGetBlockNumber (client.context, manager->u.btc, 0);
+}
+
+static void *
+_CWMClientRequestBlockNumberThread (void *context) {
+    CWMClientRequestBlockNumber ((BRCryptoWalletManager) context);
+    return NULL;
+}
+
+static int
+runCryptoWalletManagerBlockNumberRequestTest (BRCryptoAccount account,
+                                              BRCryptoNetwork network,
+                                              BRCryptoSyncMode mode,
+                                              BRCryptoAddressScheme scheme,
+                                              const char *storagePath) {
+    int success = 1;
+
+    // HACK: Managers set the height; we need to be able to restore it between tests
+    BRCryptoBlockChainHeight originalNetworkHeight = cryptoNetworkGetHeight (network);
+
+    printf("Testing BRCryptoWalletManager block number requests for mode=\"%s\", network=\"%s (%s)\" and path=\"%s\"...\n",
+           cryptoSyncModeString (mode),
+           cryptoNetworkGetName (network),
+           cryptoNetworkIsMainnet (network) ? "mainnet" : "testnet",
+           storagePath);
+
+    printf("Testing BRCryptoWalletManager concurrent block number requests, coalesced...\n");
+    {
+        // Test setup
+        CWMEventRecordingState events = {0};
+        CWMEventRecordingStateNewDefault (&events);
+
+        CWMClientRecordingState state = {0};
+        CWMClientRecordingStateNew (&state);
+
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForClientRequestTest (&events, &state, account, network, mode, scheme, storagePath);
+        CWMClientRequestsResetNetwork (network);
+
+        // Concurrent requests
+        pthread_t threads[CWM_CLIENT_BLOCK_NUMBER_THREADS];
+        for (size_t index = 0; index < CWM_CLIENT_BLOCK_NUMBER_THREADS; index++)
+            pthread_create (&threads[index], NULL, _CWMClientRequestBlockNumberThread, manager);
+        for (size_t index = 0; index < CWM_CLIENT_BLOCK_NUMBER_THREADS; index++)
+            pthread_join (threads[index], NULL);
+
+        // Verification: one client request; the others wait on it
+        success = (1 == CWMClientRecordingGetBlockNumberCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: %zu client requests\n", __func__, __LINE__, CWMClientRecordingGetBlockNumberCount (&state));
+            return success;
+        }
+
+        pthread_mutex_lock (&network->lock);
+        success = (CWM_CLIENT_BLOCK_NUMBER_THREADS - 1 == array_count (network->blockNumberRequests.waiters));
+        pthread_mutex_unlock (&network->lock);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: waiters not coalesced\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Answer; the waiters are answered with it
+        cwmAnnounceGetBlockNumberSuccess (manager, CWMClientRecordingGetBlockNumberRequest (&state, 0), originalNetworkHeight);
+
+        pthread_mutex_lock (&network->lock);
+        success = (NULL == network->blockNumberRequests.leader &&
+                   0 == array_count (network->blockNumberRequests.waiters) &&
+                   0 == array_count (network->clientRequests.inFlight) &&
+                   originalNetworkHeight == network->blockNumberRequests.blockNumber);
+        pthread_mutex_unlock (&network->lock);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: waiters not answered\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Test teardown
+        cryptoNetworkSetHeight (network, originalNetworkHeight);
+        cryptoWalletManagerGive (manager);
+        CWMClientRecordingStateFree (&state);
+        CWMEventRecordingStateFree (&events);
+    }
+
+    printf("Testing BRCryptoWalletManager block number requests, cached...\n");
+    {
+        // Test setup
+        CWMEventRecordingState events = {0};
+        CWMEventRecordingStateNewDefault (&events);
+
+        CWMClientRecordingState state = {0};
+        CWMClientRecordingStateNew (&state);
+
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForClientRequestTest (&events, &state, account, network, mode, scheme, storagePath);
+        CWMClientRequestsResetNetwork (network);
+
+        CWMClientRequestBlockNumber (manager);
+        cwmAnnounceGetBlockNumberSuccess (manager, CWMClientRecordingGetBlockNumberRequest (&state, 0), originalNetworkHeight);
+
+        // Verification: a recent result is served without a client request...
+        CWMClientRequestBlockNumber (manager);
+        CWMClientRequestBlockNumber (manager);
+        success = (1 == CWMClientRecordingGetBlockNumberCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: cached result not served\n", __func__, __LINE__);
+            return success;
+        }
+
+        // ... until it expires
+        pthread_mutex_lock (&network->lock);
+        network->blockNumberRequests.blockNumberTimestamp -= CWM_CLIENT_BLOCK_NUMBER_CACHE_SECONDS;
+        pthread_mutex_unlock (&network->lock);
+
+        CWMClientRequestBlockNumber (manager);
+        success = (2 == CWMClientRecordingGetBlockNumberCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: expired result served\n", __func__, __LINE__);
+            return success;
+        }
+
+        cwmAnnounceGetBlockNumberSuccess (manager, CWMClientRecordingGetBlockNumberRequest (&state, 1), originalNetworkHeight);
+
+        CWMClientRequestBlockNumber (manager);
+        success = (2 == CWMClientRecordingGetBlockNumberCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: refreshed result not served\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Test teardown
+        cryptoNetworkSetHeight (network, originalNetworkHeight);
+        cryptoWalletManagerGive (manager);
+        CWMClientRecordingStateFree (&state);
+        CWMEventRecordingStateFree (&events);
+    }
+
+    return success;
+}
+
+#define CWM_CLIENT_REQUEST_LIMIT            (2)
+#define CWM_CLIENT_REQUEST_COUNT            (4)
+
+// Schedule a 'get transactions' as the BTC sync does, through the BRWalletManagerClient of `manager`
+static void
+CWMClientRequestTransactions (BRCryptoWalletManager manager) {
+    const char *addresses[] = { "1BoatSLRHtKNngkdXEeobR76b53LETtpyT" };
+
+    BRWalletManagerClient client = cryptoWalletManagerClientCreateBTCClient (manager);
+    client.funcGetTransactions (client.context, manager->u.btc, addresses, 1, 0, 100, 0);
+}
+
+// Any 'get block number' request dispatches the pending requests; with a recent result cached,
+// it makes no client request of its own.
+static void
+CWMClientRequestDispatch (BRCryptoWalletManager manager) {
+    BRCryptoNetwork network = manager->network;
+
+    pthread_mutex_lock (&network->lock);
+    network->blockNumberRequests.blockNumberTimestamp = time (NULL);
+    pthread_mutex_unlock (&network->lock);
+
+    CWMClientRequestBlockNumber (manager);
+}
+
+static void
+CWMClientRequestExpireBackoff (BRCryptoNetwork network) {
+    pthread_mutex_lock (&network->lock);
+    network->clientRequests.backoffUntil = 0;
+    pthread_mutex_unlock (&network->lock);
+}
+
+static int
+CWMClientRequestVerifyCounts (BRCryptoNetwork network,
+                              size_t inFlightCount,
+                              size_t pendingCount,
+                              unsigned int failures) {
+    pthread_mutex_lock (&network->lock);
+    int success = (inFlightCount == array_count (network->clientRequests.inFlight) &&
+                   pendingCount  == array_count (network->clientRequests.pending)  &&
+                   failures      == network->clientRequests.failures);
+    if (!success)
+        printf("%s: failed due to mismatched counts (expected %zu/%zu/%u, received %zu/%zu/%u)\n",
+               __func__,
+               inFlightCount, pendingCount, failures,
+               array_count (network->clientRequests.inFlight),
+               array_count (network->clientRequests.pending),
+               network->clientRequests.failures);
+    pthread_mutex_unlock (&network->lock);
+    return success;
+}
+
+static int
+runCryptoWalletManagerClientRequestScheduleTest (BRCryptoAccount account,
+                                                 BRCryptoNetwork network,
+                                                 BRCryptoSyncMode mode,
+                                                 BRCryptoAddressScheme scheme,
+                                                 const char *storagePath) {
+    int success = 1;
+
+    // HACK: Managers set the height; we need to be able to restore it between tests
+    BRCryptoBlockChainHeight originalNetworkHeight = cryptoNetworkGetHeight (network);
+
+    printf("Testing BRCryptoWalletManager scheduled requests for mode=\"%s\", network=\"%s (%s)\" and path=\"%s\"...\n",
+           cryptoSyncModeString (mode),
+           cryptoNetworkGetName (network),
+           cryptoNetworkIsMainnet (network) ? "mainnet" : "testnet",
+           storagePath);
+
+    printf("Testing BRCryptoWalletManager scheduled requests, limited, backed off and retried...\n");
+    {
+        // Test setup
+        CWMEventRecordingState events = {0};
+        CWMEventRecordingStateNewDefault (&events);
+
+        CWMClientRecordingState state = {0};
+        CWMClientRecordingStateNew (&state);
+
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForClientRequestTest (&events, &state, account, network, mode, scheme, storagePath);
+        CWMClientRequestsResetNetwork (network);
+        cryptoNetworkSetClientRequestLimit (network, CWM_CLIENT_REQUEST_LIMIT);
+
+        // Cache a block number, so that CWMClientRequestDispatch() makes no client request
+        CWMClientRequestBlockNumber (manager);
+        cwmAnnounceGetBlockNumberSuccess (manager, CWMClientRecordingGetBlockNumberRequest (&state, 0), originalNetworkHeight);
+
+        // Saturate the slots; the rest wait
+        for (size_t index = 0; index < CWM_CLIENT_REQUEST_COUNT; index++)
+            CWMClientRequestTransactions (manager);
+
+        success = (CWM_CLIENT_REQUEST_LIMIT == CWMClientRecordingGetTransactionsCount (&state) &&
+                   CWMClientRequestVerifyCounts (network, CWM_CLIENT_REQUEST_LIMIT, CWM_CLIENT_REQUEST_COUNT - CWM_CLIENT_REQUEST_LIMIT, 0));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: slots not limited\n", __func__, __LINE__);
+            return success;
+        }
+
+        // A success frees a slot for the next request
+        BRCryptoClientCallbackState succeeded = CWMClientRecordingGetTransactionsRequest (&state, 0);
+        BRCryptoClientCallbackState failed    = CWMClientRecordingGetTransactionsRequest (&state, 1);
+
+        cwmAnnounceGetTransactionsComplete (manager, succeeded, CRYPTO_TRUE);
+
+        success = (3 == CWMClientRecordingGetTransactionsCount (&state) &&
+                   CWMClientRequestVerifyCounts (network, 2, 1, 0));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: slot not reused\n", __func__, __LINE__);
+            return success;
+        }
+
+        // A failure is retried, ahead of the other pending requests, after each backoff...
+        for (unsigned int failures = 1; failures <= CWM_CLIENT_REQUEST_RETRIES + 1; failures++) {
+            size_t requestCount = CWMClientRecordingGetTransactionsCount (&state);
+
+            time_t failedTimestamp = time (NULL);
+            cwmAnnounceGetTransactionsComplete (manager, failed, CRYPTO_FALSE);
+
+            // ... but not once out of retries
+            int retried = (failures <= CWM_CLIENT_REQUEST_RETRIES);
+
+            time_t backoff = CWM_CLIENT_REQUEST_BACKOFF_SECONDS << (failures - 1);
+            if (backoff > CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS) backoff = CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS;
+
+            pthread_mutex_lock (&network->lock);
+            time_t backoffUntil = network->clientRequests.backoffUntil;
+            pthread_mutex_unlock (&network->lock);
+
+            success = (CWMClientRequestVerifyCounts (network, 1, (retried ? 2 : 1), failures) &&
+                       backoffUntil >= failedTimestamp + backoff / 2 &&
+                       backoffUntil <= time (NULL) + backoff);
+            if (!success) {
+                fprintf(stderr, "***FAILED*** %s:%d: failure %u not backed off\n", __func__, __LINE__, failures);
+                return success;
+            }
+
+            // Nothing is made during the backoff, even with a free slot
+            CWMClientRequestDispatch (manager);
+            success = (requestCount == CWMClientRecordingGetTransactionsCount (&state));
+            if (!success) {
+                fprintf(stderr, "***FAILED*** %s:%d: request made during backoff\n", __func__, __LINE__);
+                return success;
+            }
+
+            // After the backoff, the failed request is made again or, if not retried, the next one
+            CWMClientRequestExpireBackoff (network);
+            CWMClientRequestDispatch (manager);
+
+            success = (requestCount + 1 == CWMClientRecordingGetTransactionsCount (&state) &&
+                       CWMClientRequestVerifyCounts (network, 2, (retried ? 1 : 0), failures));
+            if (success && retried)
+                success = (failed == CWMClientRecordingGetTransactionsRequest (&state, requestCount));
+            if (!success) {
+                fprintf(stderr, "***FAILED*** %s:%d: failure %u not retried\n", __func__, __LINE__, failures);
+                return success;
+            }
+        }
+
+        // The queue drains; a success clears the backoff
+        size_t requestCount = CWMClientRecordingGetTransactionsCount (&state);
+        success = (CWM_CLIENT_REQUEST_COUNT + CWM_CLIENT_REQUEST_RETRIES == requestCount);
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: %zu client requests\n", __func__, __LINE__, requestCount);
+            return success;
+        }
+
+        cwmAnnounceGetTransactionsComplete (manager, CWMClientRecordingGetTransactionsRequest (&state, 2), CRYPTO_TRUE);
+        cwmAnnounceGetTransactionsComplete (manager, CWMClientRecordingGetTransactionsRequest (&state, requestCount - 1), CRYPTO_TRUE);
+
+        pthread_mutex_lock (&network->lock);
+        time_t backoffUntil = network->clientRequests.backoffUntil;
+        pthread_mutex_unlock (&network->lock);
+
+        success = (CWMClientRequestVerifyCounts (network, 0, 0, 0) &&
+                   0 == backoffUntil &&
+                   requestCount == CWMClientRecordingGetTransactionsCount (&state));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: queue not drained\n", __func__, __LINE__);
+            return success;
+        }
+
+        // Test teardown
+        cryptoNetworkSetClientRequestLimit (network, 0);
+        cryptoNetworkSetHeight (network, originalNetworkHeight);
+        cryptoWalletManagerGive (manager);
+        CWMClientRecordingStateFree (&state);
+        CWMEventRecordingStateFree (&events);
+    }
+
+    return success;
+}
+
 ///
 /// Mark: Entrypoints
 ///
@@ -1590,6 +2609,40 @@ runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
         }
     }
 
+    if (isBtc) {
+        success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerBatchedListenerTest (account,
+                                                                               network,
+                                                                               CRYPTO_SYNC_MODE_API_ONLY,
+                                                                               scheme,
+                                                                               storagePath));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: failed\n", __func__, __LINE__);
+            return success;
+        }
+    }
+
+    if (isBtc) {
+        success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerBlockNumberRequestTest (account,
+                                                                                  network,
+                                                                                  CRYPTO_SYNC_MODE_API_ONLY,
+                                                                                  scheme,
+                                                                                  storagePath));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: failed\n", __func__, __LINE__);
+            return success;
+        }
+
+        success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerClientRequestScheduleTest (account,
+                                                                                     network,
+                                                                                     CRYPTO_SYNC_MODE_API_ONLY,
+                                                                                     scheme,
+                                                                                     storagePath));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: failed\n", __func__, __LINE__);
+            return success;
+        }
+    }
+
     if (isEth) {
         success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerLifecycleWithSetModeTest (account,
                                                                                     network,
@@ -1617,9 +2670,96 @@ runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
     return success;
 }
 
+///
+/// Mark: BRCryptoAccount Tests
+///
+
+static double
+cryptoAccountTestsElapsed (struct timespec beg) {
+    struct timespec end;
+    clock_gettime (CLOCK_MONOTONIC, &end);
+    return (double) (end.tv_sec - beg.tv_sec) + 1e-9 * (double) (end.tv_nsec - beg.tv_nsec);
+}
+
+/**
+ * Create `count` accounts from random paper keys, one at a time and then as a batch on
+ * `threadCount` threads; check that the serializations match and report accounts/s for each.
+ */
+static void
+runCryptoAccountBatchTest (size_t count, size_t threadCount, int report) {
+    char    **paperKeys  = calloc (count, sizeof (char *));
+    uint64_t *timestamps = calloc (count, sizeof (uint64_t));
+    size_t   *bytesCounts = calloc (count, sizeof (size_t));
+
+    for (size_t index = 0; index < count; index++) {
+        paperKeys[index]  = cryptoAccountGeneratePaperKey (BRBIP39WordsEn);
+        timestamps[index] = 1514764800 + index;
+    }
+
+    // One at a time
+    struct timespec beg;
+    clock_gettime (CLOCK_MONOTONIC, &beg);
+
+    uint8_t **serializations = calloc (count, sizeof (uint8_t *));
+    size_t   *serializationCounts = calloc (count, sizeof (size_t));
+    for (size_t index = 0; index < count; index++) {
+        BRCryptoAccount account = cryptoAccountCreate (paperKeys[index], timestamps[index], "batch");
+        serializations[index] = cryptoAccountSerialize (account, &serializationCounts[index]);
+        cryptoAccountGive (account);
+    }
+    double sequentialSeconds = cryptoAccountTestsElapsed (beg);
+
+    // As a batch
+    clock_gettime (CLOCK_MONOTONIC, &beg);
+    uint8_t **batch = cryptoAccountSerializeBatch ((const char **) paperKeys, timestamps, count, threadCount, bytesCounts);
+    double batchSeconds = cryptoAccountTestsElapsed (beg);
+
+    for (size_t index = 0; index < count; index++) {
+        assert (serializationCounts[index] == bytesCounts[index]);
+        assert (0 == memcmp (serializations[index], batch[index], bytesCounts[index]));
+
+        BRCryptoAccount account = cryptoAccountCreateFromSerialization (batch[index], bytesCounts[index], "batch");
+        assert (NULL != account);
+        assert (timestamps[index] == cryptoAccountGetTimestamp (account));
+        assert (CRYPTO_TRUE == cryptoAccountValidateSerialization (account, batch[index], bytesCounts[index]));
+        cryptoAccountGive (account);
+
+        free (batch[index]);
+        free (serializations[index]);
+        free (paperKeys[index]);
+    }
+
+    if (report)
+        printf ("Account Create: %zu accounts: %.1f accounts/s sequential, %.1f accounts/s batch (%zu threads)\n",
+                count,
+                count / sequentialSeconds,
+                count / batchSeconds,
+                threadCount);
+
+    free (batch);
+    free (serializations);
+    free (serializationCounts);
+    free (bytesCounts);
+    free (timestamps);
+    free (paperKeys);
+}
+
+static void
+runCryptoAccountTests (void) {
+    runCryptoAccountBatchTest (5, 2, 0);
+    runCryptoAccountBatchTest (1, 0, 0);
+    runCryptoAccountBatchTest (0, 0, 0);
+}
+
+extern void
+runCryptoPerfTestsAccountBatch (size_t count, size_t threadCount) {
+    runCryptoAccountBatchTest (count, threadCount, 1);
+}
+
 extern void
 runCryptoTests (void) {
     runCryptoAmountTests ();
     runCryptoTransferTests();
+    runCryptoAccountTests ();
     return;
 }
@@ -9,9 +9,15 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
+#include <time.h>
 #include <assert.h>
+#include <pthread.h>
+#include "support/BRCrypto.h"
 #include "ethereum/blockchain/BREthereumBlockChain.h"
+#include "ethereum/bcs/BREthereumBCSPrivate.h"
 
 //
 // Bloom Test
@@ -39,9 +45,9 @@ runBloomTests (void) {
 
 }
 
-#define BLOCK_HEADER_0_RLP "f9020ca00000000000000000000000000000000000000000000000000000000000000000a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a0d7f8974fb5ac78d9ac099b9ad5018bedc2ce0a72dad1827a1709da30580f0544a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000850400000000008213880000a011bbe8db4e347b4e8c937c1c8370e4b5ed33adb3db69cbdb7a38e1e50b1b82faa0000000000000000000000000000000000000000000000000000000000000000042"
-#define BLOCK_HEADER_1_RLP "f90211a0d4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d493479405a56e2d52c817161883f50c441c3228cfe54d9fa0d67e4d450343046425ae4271474353857ab860dbc0a1dde64b41b5cd3a532bf3a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b90100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008503ff80000001821388008455ba422499476574682f76312e302e302f6c696e75782f676f312e342e32a0969b900de27b6ac6a67742365dd65f55a0526c41fd18e1b16f1a1215c2e66f5988539bd4979fef1ec4"
-#define BLOCK_HEADER_2_RLP "f90218a088e96d4537bea4d9c05d12549907b32561d3bf31f45aae734cdc119f13406cb6a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d4934794dd2f1e6e498202e86d8f5442af596580a4f03c2ca04943d941637411107494da9ec8bc04359d731bfd08b72b4d0edcbd4cd2ecb341a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b90100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008503ff00100002821388008455ba4241a0476574682f76312e302e302d30636463373634372f6c696e75782f676f312e34a02f0790c5aa31ab94195e1f6443d645af5b75c46c04fbf9911711198a0ce8fdda88b853fa261a86aa9e"
+#define BLOCK_HEADER_0_RLP "f90214a00000000000000000000000000000000000000000000000000000000000000000a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a0d7f8974fb5ac78d9ac099b9ad5018bedc2ce0a72dad1827a1709da30580f0544a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000850400000000808213888080a011bbe8db4e347b4e8c937c1c8370e4b5ed33adb3db69cbdb7a38e1e50b1b82faa00000000000000000000000000000000000000000000000000000000000000000880000000000000042"
+#define BLOCK_HEADER_1_RLP "f90211a0d4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d493479405a56e2d52c817161883f50c441c3228cfe54d9fa0d67e4d450343046425ae4271474353857ab860dbc0a1dde64b41b5cd3a532bf3a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b90100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008503ff80000001821388808455ba422499476574682f76312e302e302f6c696e75782f676f312e342e32a0969b900de27b6ac6a67742365dd65f55a0526c41fd18e1b16f1a1215c2e66f5988539bd4979fef1ec4"
+#define BLOCK_HEADER_2_RLP "f90218a088e96d4537bea4d9c05d12549907b32561d3bf31f45aae734cdc119f13406cb6a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d4934794dd2f1e6e498202e86d8f5442af596580a4f03c2ca04943d941637411107494da9ec8bc04359d731bfd08b72b4d0edcbd4cd2ecb341a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b90100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008503ff00100002821388808455ba4241a0476574682f76312e302e302d30636463373634372f6c696e75782f676f312e34a02f0790c5aa31ab94195e1f6443d645af5b75c46c04fbf9911711198a0ce8fdda88b853fa261a86aa9e"
 
 #define BLOCK_HEADER_4000000_RLP "f90218a09b3c1d182975fdaa5797879cbc45d6b00a84fb3b13980a107645b2491bcca899a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347941e9939daaad6924ad004c2560e90804164900341a0c191817e387e5405867535fb7f97991346e5f95c9dd040fb21503762ee22f5f8a0e3957fe2e24a0699872fe045ea7d1af2da0ea331fe782c802902b1a0e80560a8a0cd98e056d619b4047ff1ec598e61fd42edb3b48e6748bac41e164e1671d02623b90100408000002040080200010150010000022800000010030000001225000021010840000010000000020080400800000001000000000020040000004000000001000020000000000000c000048c802010080000000000230080000180004000000020088038420800000200104204000800124000204800404000002910021080622020820180000080c00000080401980001008000028a000080400000001081004040000020002000120008100004240100140c03000080200200804000000000010000024004000000024000008000400000000400000001201000080100210100000002010000100000002400000204400800200800020003000020000000818703e5151f3eae1c833d090083666c4883437928845962979f97706f6f6c2e65746866616e732e6f726720284d4e313529a081277f51ee22c1022b848064b1c5af001e3ba06d808a1ef3fd52aad07279e0f088f285952002120e7f"
 #define BLOCK_HEADER_4000001_RLP "f9020ea0b8a3f7f5cfc1748f91a684f20fe89031202cbadcd15078c49b85ec2a57f43853a01dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d4934794ea674fdde714fd979de3edf0f56aa9716b898ec8a07b01440ffe0282749577cf99f6c90aa39e496af23bbdc64ab57a3f0d1bf8a467a0ab330290ef6907c3e411691347a3ba6933482354e48dc46738f2226aab0d848ca03db9076bd070e771806d05df3bfe7d83aae07fc94e35310ea304509f57fb27acb90100000000000000000000000000000000000000000004000000000000000000000000000000000000000000000000800000280000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000400000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000020000000000000000000080000000000000000000000000000000000000000000000000000041000000000000000000000000000004000000000000000000000008703e5d1c1e295f1833d090183666c488305282e84596297a38d65746865726d696e652d657536a04db91248cc4af54907e32cc5c160eeb7d5813cce11c87bbc85a0dc6db2b65419885d345a1001da875e"
@@ -91,8 +97,13 @@ extern void
 runBlockHeaderTests (void) {
     // validate a block with its parent.
     BREthereumBlockHeader header_0 = testGetBlockHeader(BLOCK_HEADER_0_RLP); // networkGetGenesisBlockHeader (ethereumMainnet);
-#if 0
     BREthereumBlockHeader header_1 = testGetBlockHeader(BLOCK_HEADER_1_RLP);
+
+    // The genesis header hashes to the mainnet genesis hash, which block 1 names as its parent.
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (blockHeaderGetHash (header_0),
+                                                    ethHashCreate ("0xd4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3"))));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (blockHeaderGetHash (header_0), blockHeaderGetParentHash (header_1))));
+#if 0
     BREthereumBlockHeader header_2 = testGetBlockHeader(BLOCK_HEADER_2_RLP);
 
     // Pre-HOMESTEAD_FORK_BLOCK_NUMBER
@@ -133,6 +144,181 @@ runBlockHeaderTests (void) {
 
 }
 
+//
+// Bloom Filter Set Test
+//
+#define BLOOM_SET_FILTERS_COUNT      (130)   // Spans three bitmap words
+#define BLOOM_SET_BLOOMS_COUNT        (70)
+
+static const char *bloomSetHeaderRlps[] = {
+    BLOCK_HEADER_4000000_RLP,
+    BLOCK_HEADER_4000001_RLP,
+    BLOCK_HEADER_6000000_RLP,
+    BLOCK_HEADER_6000001_RLP,
+    BLOCK_HEADER_6500000_RLP,
+    BLOCK_HEADER_6500001_RLP
+};
+
+extern void
+runBloomFilterSetTests (void) {
+    printf ("==== Bloom Filter Set\n");
+
+    // Address and topic filters for many 'tracked' addresses
+    BREthereumBloomFilter filters[BLOOM_SET_FILTERS_COUNT];
+    for (size_t index = 0; index < BLOOM_SET_FILTERS_COUNT; index++) {
+        BREthereumAddress address;
+        uint8_t hash[32];
+        BRKeccak256 (hash, &index, sizeof (index));
+        memcpy (address.bytes, hash, sizeof (address.bytes));
+        filters[index] = (0 == index % 2
+                          ? bloomFilterCreateAddress (address)
+                          : logTopicGetBloomFilterAddress (address));
+    }
+    BREthereumBloomFilterSet set = bloomFilterSetCreate (filters, BLOOM_SET_FILTERS_COUNT);
+    assert (BLOOM_SET_FILTERS_COUNT == bloomFilterSetGetCount (set));
+
+    // Real header blooms, empty blooms and blooms holding a few of the tracked filters
+    size_t headersCount = sizeof (bloomSetHeaderRlps) / sizeof (char*);
+    BREthereumBlockHeader headers[headersCount];
+    BREthereumBloomFilter blooms[BLOOM_SET_BLOOMS_COUNT];
+    for (size_t index = 0; index < BLOOM_SET_BLOOMS_COUNT; index++) {
+        blooms[index] = bloomFilterCreateEmpty ();
+        if (index < headersCount) {
+            headers[index] = testGetBlockHeader (bloomSetHeaderRlps[index]);
+            blooms[index]  = blockHeaderGetLogsBloom (headers[index]);
+        }
+        else if (0 == index % 3)
+            blooms[index] = bloomFilterOr (filters[index % BLOOM_SET_FILTERS_COUNT],
+                                           filters[(7 * index) % BLOOM_SET_FILTERS_COUNT]);
+    }
+    blooms[BLOOM_SET_BLOOMS_COUNT - 1] = filters[BLOOM_SET_FILTERS_COUNT - 1];
+
+    // Every bloom against the set, compared with one bloomFilterMatch() at a time
+    uint64_t matches[BLOOM_FILTER_SET_MATCHES_WORDS(BLOOM_SET_BLOOMS_COUNT)];
+    uint64_t eachMatches[BLOOM_FILTER_SET_MATCHES_WORDS(BLOOM_SET_FILTERS_COUNT)];
+    size_t matchesCount = bloomFilterSetMatch (set, blooms, BLOOM_SET_BLOOMS_COUNT, matches);
+
+    size_t expectedCount = 0;
+    for (size_t index = 0; index < BLOOM_SET_BLOOMS_COUNT; index++) {
+        int expected = 0;
+        for (size_t filter = 0; filter < BLOOM_SET_FILTERS_COUNT; filter++)
+            expected |= ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterMatch (blooms[index], filters[filter]));
+        expectedCount += expected;
+
+        assert (expected == BLOOM_FILTER_SET_MATCHES_TEST (matches, index));
+        assert (expected == ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterSetMatchAny (set, &blooms[index])));
+
+        // Each tracked filter against this bloom
+        size_t eachCount = bloomFilterSetMatchEach (set, &blooms[index], eachMatches);
+        for (size_t filter = 0; filter < BLOOM_SET_FILTERS_COUNT; filter++) {
+            int expectedEach = ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterMatch (blooms[index], filters[filter]));
+            assert (expectedEach == BLOOM_FILTER_SET_MATCHES_TEST (eachMatches, filter));
+            eachCount -= expectedEach;
+        }
+        assert (0 == eachCount);
+    }
+    assert (expectedCount == matchesCount);
+    assert (expectedCount > headersCount);
+
+    // Headers, directly
+    uint64_t headerMatches[BLOOM_FILTER_SET_MATCHES_WORDS(headersCount)];
+    blockHeadersMatch (headers, headersCount, set, headerMatches);
+    for (size_t index = 0; index < headersCount; index++)
+        assert (BLOOM_FILTER_SET_MATCHES_TEST (headerMatches, index) ==
+                BLOOM_FILTER_SET_MATCHES_TEST (matches, index));
+
+    // An empty set matches nothing; an empty filter matches everything
+    BREthereumBloomFilter empty = bloomFilterCreateEmpty ();
+    BREthereumBloomFilterSet setEmpty = bloomFilterSetCreate (NULL, 0);
+    assert (0 == bloomFilterSetMatch (setEmpty, blooms, BLOOM_SET_BLOOMS_COUNT, matches));
+    bloomFilterSetRelease (setEmpty);
+
+    setEmpty = bloomFilterSetCreate (&empty, 1);
+    assert (BLOOM_SET_BLOOMS_COUNT == bloomFilterSetMatch (setEmpty, blooms, BLOOM_SET_BLOOMS_COUNT, matches));
+    bloomFilterSetRelease (setEmpty);
+
+    for (size_t index = 0; index < headersCount; index++)
+        blockHeaderRelease (headers[index]);
+    bloomFilterSetRelease (set);
+}
+
+//
+// Proof of Work Test
+//
+static int
+testProofOfWorkVerify (BREthereumProofOfWork pow, BREthereumBlockHeader header) {
+    UInt256 n;
+    BREthereumHash m;
+    proofOfWorkCompute (pow, header, &n, &m);
+
+    int overflow = 0;
+    uint256Mul_Overflow (n, blockHeaderGetDifficulty (header), &overflow);
+    return ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (m, blockHeaderGetMixHash (header))) && 0 == overflow;
+}
+
+typedef struct {
+    BREthereumProofOfWork pow;
+    BREthereumBlockHeader header;
+    int valid;
+} TestProofOfWorkThreadContext;
+
+static void *
+testProofOfWorkThread (TestProofOfWorkThreadContext *context) {
+    context->valid = 1;
+    for (size_t count = 0; count < 4; count++)
+        context->valid &= testProofOfWorkVerify (context->pow, context->header);
+    return NULL;
+}
+
+extern void
+runProofOfWorkTests (void) {
+    BREthereumProofOfWork pow = proofOfWorkCreate (NULL);
+
+    // Both in epoch 0
+    BREthereumBlockHeader header_1 = testGetBlockHeader(BLOCK_HEADER_1_RLP);
+    BREthereumBlockHeader header_2 = testGetBlockHeader(BLOCK_HEADER_2_RLP);
+
+    assert (testProofOfWorkVerify (pow, header_1));
+    assert (testProofOfWorkVerify (pow, header_2));
+
+    // Change the nonce's last nibble; the sealed mixHash is no longer reproduced.
+    char *rlp = strdup (BLOCK_HEADER_1_RLP);
+    size_t rlpLength = strlen (rlp);
+    rlp[rlpLength - 1] = ('4' == rlp[rlpLength - 1] ? '5' : '4');
+    BREthereumBlockHeader header_1_bogus = testGetBlockHeader(rlp);
+    free (rlp);
+
+    assert (blockHeaderGetNonce (header_1) != blockHeaderGetNonce (header_1_bogus));
+    assert (!testProofOfWorkVerify (pow, header_1_bogus));
+
+    // A second verifier shares the epoch caches; verify through both concurrently.
+    BREthereumProofOfWork powOther = proofOfWorkCreate (NULL);
+
+    TestProofOfWorkThreadContext contexts[] = {
+        { pow,      header_1 },
+        { powOther, header_2 },
+        { pow,      header_2 },
+        { powOther, header_1 }
+    };
+    size_t contextsCount = sizeof (contexts) / sizeof (TestProofOfWorkThreadContext);
+
+    pthread_t threads[contextsCount];
+    for (size_t index = 0; index < contextsCount; index++)
+        pthread_create (&threads[index], NULL, (void* (*) (void*)) testProofOfWorkThread, &contexts[index]);
+    for (size_t index = 0; index < contextsCount; index++) {
+        pthread_join (threads[index], NULL);
+        assert (contexts[index].valid);
+    }
+
+    proofOfWorkRelease (powOther);
+    assert (testProofOfWorkVerify (pow, header_1));
+
+    blockHeaderRelease (header_1_bogus);
+    blockHeaderRelease (header_2);
+    blockHeaderRelease (header_1);
+    proofOfWorkRelease (pow);
+}
+
 //
 // block Test
 //
@@ -477,10 +663,520 @@ runBlockTests (void) {
     runBlockTransactionTest ();
 }
 
+//
+// RLP Coder Performance - LES sized payloads
+//
+#define PERF_HEADERS_COUNT              (192)   // LES 'GetBlockHeaders' maximum
+#define PERF_RECEIPTS_BLOCKS_COUNT       (32)
+#define PERF_RECEIPTS_PER_BLOCK_COUNT   (150)
+
+static const char *perfHeaderRlps[] = {
+    BLOCK_HEADER_0_RLP,
+    BLOCK_HEADER_1_RLP,
+    BLOCK_HEADER_2_RLP,
+    BLOCK_HEADER_4000000_RLP,
+    BLOCK_HEADER_4000001_RLP,
+    BLOCK_HEADER_6000000_RLP,
+    BLOCK_HEADER_6000001_RLP,
+    BLOCK_HEADER_6500000_RLP,
+    BLOCK_HEADER_6500001_RLP
+};
+
+static BRRlpData
+perfCreateHeadersPayload (BRRlpCoder coder) {
+    size_t rlpsCount = sizeof (perfHeaderRlps) / sizeof (char*);
+    BRRlpItem items [PERF_HEADERS_COUNT];
+
+    for (size_t index = 0; index < PERF_HEADERS_COUNT; index++) {
+        const char *rlp = perfHeaderRlps[index % rlpsCount];
+        BRRlpData data;
+        data.bytes = hexDecodeCreate (&data.bytesCount, rlp, strlen (rlp));
+        items[index] = rlpDataGetItem (coder, data);
+        rlpDataRelease (data);
+    }
+
+    BRRlpItem item = rlpEncodeListItems (coder, items, PERF_HEADERS_COUNT);
+    BRRlpData data = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+    return data;
+}
+
+// Per block, alternate plain transfers (no logs) with token transfers (two logs).
+static BRRlpData
+perfCreateReceiptsPayload (BRRlpCoder coder) {
+    BRRlpData logData;
+    logData.bytes = hexDecodeCreate (&logData.bytesCount, LOG_1_RLP, strlen (LOG_1_RLP));
+
+    uint8_t bloom[256];
+    memset (bloom, 0, sizeof (bloom));
+    bloom[17] = 0x10; bloom[201] = 0x04;
+
+    BRRlpItem blocks [PERF_RECEIPTS_BLOCKS_COUNT];
+    for (size_t block = 0; block < PERF_RECEIPTS_BLOCKS_COUNT; block++) {
+        BRRlpItem receipts [PERF_RECEIPTS_PER_BLOCK_COUNT];
+        uint64_t gasUsed = 0;
+
+        for (size_t index = 0; index < PERF_RECEIPTS_PER_BLOCK_COUNT; index++) {
+            size_t logsCount = (index % 2 ? 2 : 0);
+            BRRlpItem logs [2];
+            for (size_t log = 0; log < logsCount; log++)
+                logs[log] = rlpDataGetItem (coder, logData);
+
+            gasUsed += (index % 2 ? 52000 : 21000);
+            receipts[index] = rlpEncodeList (coder, 4,
+                                             rlpEncodeUInt64 (coder, 1, 0),
+                                             rlpEncodeUInt64 (coder, gasUsed, 0),
+                                             rlpEncodeBytes  (coder, bloom, sizeof (bloom)),
+                                             rlpEncodeListItems (coder, logs, logsCount));
+        }
+        blocks[block] = rlpEncodeListItems (coder, receipts, PERF_RECEIPTS_PER_BLOCK_COUNT);
+    }
+
+    BRRlpItem item = rlpEncodeListItems (coder, blocks, PERF_RECEIPTS_BLOCKS_COUNT);
+    BRRlpData data = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+    rlpDataRelease (logData);
+    return data;
+}
+
+static void
+perfDecodeHeaders (BRRlpCoder coder, BRRlpData data) {
+    BRRlpItem item = rlpDataGetItem (coder, data);
+
+    size_t itemsCount;
+    const BRRlpItem *items = rlpDecodeList (coder, item, &itemsCount);
+    assert (PERF_HEADERS_COUNT == itemsCount);
+
+    for (size_t index = 0; index < itemsCount; index++)
+        blockHeaderRelease (blockHeaderRlpDecode (items[index], RLP_TYPE_NETWORK, coder));
+
+    rlpItemRelease (coder, item);
+}
+
+static void
+perfDecodeReceipts (BRRlpCoder coder, BRRlpData data) {
+    BRRlpItem item = rlpDataGetItem (coder, data);
+
+    size_t itemsCount;
+    const BRRlpItem *items = rlpDecodeList (coder, item, &itemsCount);
+    assert (PERF_RECEIPTS_BLOCKS_COUNT == itemsCount);
+
+    for (size_t index = 0; index < itemsCount; index++) {
+        BRArrayOf(BREthereumTransactionReceipt) receipts = transactionReceiptDecodeList (items[index], coder);
+        assert (PERF_RECEIPTS_PER_BLOCK_COUNT == array_count (receipts));
+        transactionReceiptsRelease (receipts);
+    }
+
+    rlpItemRelease (coder, item);
+}
+
+static void
+perfRunDecode (const char *name, BRRlpData data, int confined, int repeat,
+               void (*decode) (BRRlpCoder coder, BRRlpData data)) {
+    BRRlpCoder coder = (confined ? rlpCoderCreateThreadConfined() : rlpCoderCreate());
+    struct timespec start, stop;
+
+    // Once, to size the coder
+    decode (coder, data);
+
+    size_t itemsCount, bytesCount;
+    rlpCoderGetStats (coder, &itemsCount, &bytesCount);
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (int index = 0; index < repeat; index++)
+        decode (coder, data);
+    clock_gettime (CLOCK_MONOTONIC, &stop);
+
+    double seconds = (double) (stop.tv_sec - start.tv_sec) + 1e-9 * (double) (stop.tv_nsec - start.tv_nsec);
+    printf ("    %-9s %-8s: %7zu bytes, %6zu items, %7zu coder bytes, %8.1f payloads/s, %7.1f MB/s\n",
+            name, (confined ? "confined" : "locked"), data.bytesCount, itemsCount, bytesCount,
+            repeat / seconds, (repeat * data.bytesCount) / (1e6 * seconds));
+
+    rlpCoderReclaim (coder);
+    rlpCoderGetStats (coder, &itemsCount, &bytesCount);
+    assert (0 == itemsCount && 0 == bytesCount);
+
+    rlpCoderRelease (coder);
+}
+
+// Decode a LES BlockHeaders and a LES Receipts sized payload, built from the real header and log
+// encodings above, reporting the coder's memory and the decode throughput.
+extern void
+runPerfTestsCoderPayloads (int repeat) {
+    printf ("==== RLP Coder Payloads\n");
+    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpData headers  = perfCreateHeadersPayload (coder);
+    BRRlpData receipts = perfCreateReceiptsPayload (coder);
+    rlpCoderRelease (coder);
+
+    for (int confined = 0; confined <= 1; confined++) {
+        perfRunDecode ("Headers",  headers,  confined, repeat, perfDecodeHeaders);
+        perfRunDecode ("Receipts", receipts, confined, repeat, perfDecodeReceipts);
+    }
+
+    rlpDataRelease (headers);
+    rlpDataRelease (receipts);
+}
+
+//
+// Proof of Work Performance - light verification of mainnet headers
+//
+static const char *perfPowHeaderRlps[] = {
+    BLOCK_HEADER_1_RLP,         // epoch 0
+    BLOCK_HEADER_2_RLP,
+    BLOCK_HEADER_4000000_RLP,   // epoch 133
+    BLOCK_HEADER_4000001_RLP,
+    BLOCK_HEADER_6000000_RLP,   // epoch 200
+    BLOCK_HEADER_6000001_RLP,
+    BLOCK_HEADER_6500000_RLP,   // epoch 216
+    BLOCK_HEADER_6500001_RLP
+};
+#define PERF_POW_HEADERS_PER_EPOCH   (2)
+
+static double
+perfSecondsSince (struct timespec start) {
+    struct timespec stop;
+    clock_gettime (CLOCK_MONOTONIC, &stop);
+    return (double) (stop.tv_sec - start.tv_sec) + 1e-9 * (double) (stop.tv_nsec - start.tv_nsec);
+}
+
+// Verify each epoch's pair of headers `repeat` times, reporting the time to get the epoch's
+// cache (generated, or mapped if persisted under `path` by an earlier run) and the verification
+// throughput once it is in hand.
+extern void
+runPerfTestsProofOfWork (int repeat, const char *path) {
+    printf ("==== Proof of Work%s%s\n", (NULL == path ? "" : ", caches in "), (NULL == path ? "" : path));
+    BREthereumProofOfWork pow = proofOfWorkCreate (path);
+
+    size_t headersCount = sizeof (perfPowHeaderRlps) / sizeof (char*);
+    for (size_t base = 0; base < headersCount; base += PERF_POW_HEADERS_PER_EPOCH) {
+        BREthereumBlockHeader headers[PERF_POW_HEADERS_PER_EPOCH];
+        for (size_t index = 0; index < PERF_POW_HEADERS_PER_EPOCH; index++)
+            headers[index] = testGetBlockHeader (perfPowHeaderRlps[base + index]);
+
+        struct timespec start;
+        clock_gettime (CLOCK_MONOTONIC, &start);
+        int valid = testProofOfWorkVerify (pow, headers[0]);
+        double cacheSeconds = perfSecondsSince (start);
+        assert (valid);
+
+        clock_gettime (CLOCK_MONOTONIC, &start);
+        for (int count = 0; count < repeat; count++)
+            for (size_t index = 0; index < PERF_POW_HEADERS_PER_EPOCH; index++)
+                valid &= testProofOfWorkVerify (pow, headers[index]);
+        double seconds = perfSecondsSince (start);
+        assert (valid);
+
+        printf ("    Epoch %3" PRIu64 ": %6.2f s first verification, %8.1f verifications/s\n",
+                blockHeaderGetNumber (headers[0]) / 30000, cacheSeconds,
+                (repeat * PERF_POW_HEADERS_PER_EPOCH) / seconds);
+
+        for (size_t index = 0; index < PERF_POW_HEADERS_PER_EPOCH; index++)
+            blockHeaderRelease (headers[index]);
+    }
+
+    proofOfWorkRelease (pow);
+}
+
+//
+// BCS Sync
+//
+// Sync over a synthetic account history with a simulated node.  Each request costs a round trip
+// plus the node's per-item service time; the node serves one request at a time, so concurrent
+// requests overlap their round trips but not the node's work.
+#define PERF_SYNC_ROUND_TRIP          (0.200)   // seconds
+#define PERF_SYNC_HEADER_SERVICE      (0.0005)  // seconds per header
+#define PERF_SYNC_ACCOUNT_SERVICE     (0.005)   // seconds per account state (w/ proof)
+
+#define PERF_SYNC_TAIL                (5000000)
+#define PERF_SYNC_HEAD                (9000000)
+
+typedef struct {
+    double time;
+    BREthereumBCSSyncRange range;
+    BREthereumProvisionResult result;
+} PerfSyncResponse;
+
+typedef struct {
+    BRArrayOf(uint64_t) changes;        // ascending block numbers at which the account changed
+
+    double now;
+    double busyUntil;
+    BRArrayOf(PerfSyncResponse) responses;
+
+    size_t headerRequests;
+    size_t headerCount;
+    size_t accountRequests;
+    size_t accountCount;
+    size_t requestsMaximum;
+
+    size_t reportedCount;
+    uint64_t reportedLast;
+    size_t changesFound;
+} PerfSync;
+
+static uint64_t
+perfSyncRandom (uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+static int
+perfSyncCompareNumbers (const void *n1, const void *n2) {
+    uint64_t v1 = *(const uint64_t *) n1;
+    uint64_t v2 = *(const uint64_t *) n2;
+    return v1 < v2 ? -1 : (v1 > v2 ? 1 : 0);
+}
+
+// Create `count` changes in (PERF_SYNC_TAIL, PERF_SYNC_HEAD] - uniformly if `clusters` is zero,
+// otherwise in `clusters` bursts each spanning `span` blocks.
+static BRArrayOf(uint64_t)
+perfSyncCreateChanges (size_t count, size_t clusters, uint64_t span, uint64_t seed) {
+    BRArrayOf(uint64_t) changes;
+    array_new (changes, count);
+
+    uint64_t total = PERF_SYNC_HEAD - PERF_SYNC_TAIL;
+    uint64_t centers[clusters + 1];
+    for (size_t index = 0; index < clusters; index++)
+        centers[index] = PERF_SYNC_TAIL + 1 + perfSyncRandom (&seed) % (total - span);
+
+    for (size_t index = 0; index < count; index++)
+        array_add (changes, (0 == clusters
+                             ? PERF_SYNC_TAIL + 1 + perfSyncRandom (&seed) % total
+                             : centers[index % clusters] + perfSyncRandom (&seed) % span));
+
+    qsort (changes, array_count(changes), sizeof (uint64_t), perfSyncCompareNumbers);
+
+    // Remove duplicates
+    size_t unique = 0;
+    for (size_t index = 0; index < array_count(changes); index++)
+        if (0 == unique || changes[unique - 1] != changes[index])
+            changes[unique++] = changes[index];
+    array_set_count (changes, unique);
+
+    return changes;
+}
+
+static BREthereumBoolean
+perfSyncIsChange (PerfSync *perf, uint64_t number) {
+    return AS_ETHEREUM_BOOLEAN (NULL != bsearch (&number, perf->changes, array_count(perf->changes),
+                                                 sizeof (uint64_t), perfSyncCompareNumbers));
+}
+
+// The account nonce at `number` is the number of changes at or before `number`
+static uint64_t
+perfSyncNonce (PerfSync *perf, uint64_t number) {
+    size_t lower = 0, upper = array_count(perf->changes);
+    while (lower < upper) {
+        size_t middle = (lower + upper) / 2;
+        if (perf->changes[middle] <= number) lower = middle + 1;
+        else upper = middle;
+    }
+    return lower;
+}
+
+static BREthereumHash
+perfSyncHash (uint64_t number) {
+    BREthereumHash hash = EMPTY_HASH_INIT;
+    for (size_t index = 0; index < sizeof (uint64_t); index++)
+        hash.bytes[index] = (uint8_t) (number >> (8 * (sizeof (uint64_t) - 1 - index)));
+    return hash;
+}
+
+static uint64_t
+perfSyncHashNumber (BREthereumHash hash) {
+    uint64_t number = 0;
+    for (size_t index = 0; index < sizeof (uint64_t); index++)
+        number = (number << 8) | hash.bytes[index];
+    return number;
+}
+
+static void
+perfSyncRespond (PerfSync *perf,
+                 BREthereumBCSSyncRange range,
+                 BREthereumProvision provision,
+                 size_t itemCount,
+                 double itemService) {
+    double start = perf->now + PERF_SYNC_ROUND_TRIP / 2;
+    if (start < perf->busyUntil) start = perf->busyUntil;
+    perf->busyUntil = start + itemCount * itemService;
+
+    PerfSyncResponse response = {
+        perf->busyUntil + PERF_SYNC_ROUND_TRIP / 2,
+        range,
+        { PROVISION_IDENTIFIER_UNDEFINED, provision.type, PROVISION_SUCCESS, provision }
+    };
+    array_add (perf->responses, response);
+
+    if (array_count (perf->responses) > perf->requestsMaximum)
+        perf->requestsMaximum = array_count (perf->responses);
+}
+
+static void
+perfSyncProvideBlockHeaders (PerfSync *perf,
+                             BREthereumBCSSyncRange range,
+                             BREthereumNodeReference node,
+                             uint64_t start,
+                             uint32_t limit,
+                             uint64_t skip) {
+    BRArrayOf(BREthereumBlockHeader) headers;
+    array_new (headers, limit);
+    for (uint32_t index = 0; index < limit; index++) {
+        uint64_t number = start + index * (skip + 1);
+        BREthereumBlockCheckpoint checkpoint = { number, perfSyncHash (number), { NULL }, 0 };
+        array_add (headers, blockCheckpointCreatePartialBlockHeader (&checkpoint));
+    }
+
+    BREthereumProvision provision = { PROVISION_IDENTIFIER_UNDEFINED, PROVISION_BLOCK_HEADERS };
+    provision.u.headers = (BREthereumProvisionHeaders) { start, skip, limit, ETHEREUM_BOOLEAN_FALSE, headers };
+
+    perf->headerRequests += 1;
+    perf->headerCount    += limit;
+    perfSyncRespond (perf, range, provision, limit, PERF_SYNC_HEADER_SERVICE);
+}
+
+static void
+perfSyncProvideAccountStates (PerfSync *perf,
+                              BREthereumBCSSyncRange range,
+                              BREthereumNodeReference node,
+                              BREthereumAddress address,
+                              OwnershipGiven BRArrayOf(BREthereumHash) hashes) {
+    size_t count = array_count (hashes);
+
+    BRArrayOf(BREthereumAccountState) accounts;
+    array_new (accounts, count);
+    for (size_t index = 0; index < count; index++)
+        array_add (accounts, accountStateCreate (perfSyncNonce (perf, perfSyncHashNumber (hashes[index])),
+                                                 ethEtherCreateZero(),
+                                                 ethHashCreateEmpty(),
+                                                 ethHashCreateEmpty()));
+
+    BREthereumProvision provision = { PROVISION_IDENTIFIER_UNDEFINED, PROVISION_ACCOUNTS };
+    provision.u.accounts = (BREthereumProvisionAccounts) { address, hashes, accounts };
+
+    perf->accountRequests += 1;
+    perf->accountCount    += count;
+    perfSyncRespond (perf, range, provision, count, PERF_SYNC_ACCOUNT_SERVICE);
+}
+
+static void
+perfSyncReportBlocks (PerfSync *perf,
+                      BREthereumBCSSync sync,
+                      BREthereumNodeReference node,
+                      OwnershipGiven BRArrayOf(BREthereumBCSSyncResult) results) {
+    for (size_t index = 0; index < array_count (results); index++) {
+        uint64_t number = blockHeaderGetNumber (results[index].header);
+
+        // Reported in block order; adjacent ranges share their boundary header.
+        assert (0 == perf->reportedCount || number >= perf->reportedLast);
+        if ((0 == perf->reportedCount || number > perf->reportedLast) &&
+            ETHEREUM_BOOLEAN_IS_TRUE (perfSyncIsChange (perf, number)))
+            perf->changesFound += 1;
+
+        perf->reportedCount += 1;
+        perf->reportedLast   = number;
+        blockHeaderRelease (results[index].header);
+    }
+    array_free (results);
+}
+
+static void
+perfSyncReportProgress (PerfSync *perf,
+                        BREthereumBCSSync sync,
+                        BREthereumNodeReference node,
+                        uint64_t blockNumberBeg,
+                        uint64_t blockNumberNow,
+                        uint64_t blockNumberEnd) {
+}
+
+static void
+perfSyncRun (const char *name, BRArrayOf(uint64_t) changes, size_t dispatchLimit) {
+    PerfSync perf;
+    memset (&perf, 0, sizeof (PerfSync));
+    perf.changes = changes;
+    array_new (perf.responses, 10);
+
+    BREthereumBCSSync sync = bcsSyncCreate ((BREthereumBCSSyncContext) &perf,
+                                            (BREthereumBCSSyncReportBlocks) perfSyncReportBlocks,
+                                            (BREthereumBCSSyncReportProgress) perfSyncReportProgress,
+                                            EMPTY_ADDRESS_INIT,
+                                            NULL,
+                                            NULL);
+    bcsSyncSetProvider (sync, (BREthereumBCSSyncProvider) {
+        (BREthereumBCSSyncProviderContext) &perf,
+        (BREthereumBCSSyncProvideBlockHeaders) perfSyncProvideBlockHeaders,
+        (BREthereumBCSSyncProvideAccountStates) perfSyncProvideAccountStates
+    });
+    bcsSyncSetDispatchLimit (sync, dispatchLimit);
+
+    struct timespec start;
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    bcsSyncStart (sync, (BREthereumNodeReference) &perf, PERF_SYNC_TAIL, PERF_SYNC_HEAD);
+
+    // Handle the responses in the order they complete.
+    while (array_count (perf.responses) > 0) {
+        size_t next = 0;
+        for (size_t index = 1; index < array_count (perf.responses); index++)
+            if (perf.responses[index].time < perf.responses[next].time) next = index;
+
+        PerfSyncResponse response = perf.responses[next];
+        array_rm (perf.responses, next);
+
+        perf.now = response.time;
+        bcsSyncHandleProvision (response.range, NULL, (BREthereumNodeReference) &perf, response.result);
+    }
+    double seconds = perfSecondsSince (start);
+
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (bcsSyncIsActive (sync)));
+    assert (array_count (changes) == perf.changesFound);
+    assert (PERF_SYNC_HEAD == perf.reportedLast);
+
+    printf ("    %-9s %5zu changes, limit %zu: %5zu header requests (%7zu headers), %5zu account requests (%7zu accounts), %2zu concurrent, %7.1f s simulated, %6.3f s\n",
+            name, array_count (changes), dispatchLimit,
+            perf.headerRequests, perf.headerCount,
+            perf.accountRequests, perf.accountCount,
+            perf.requestsMaximum, perf.now, seconds);
+
+    bcsSyncRelease (sync);
+    array_free (perf.responses);
+}
+
+// Sync PERF_SYNC_HEAD - PERF_SYNC_TAIL blocks for account histories of increasing density,
+// both one range at a time and with the default concurrent dispatch.
+extern void
+runPerfTestsBCSSync (void) {
+    printf ("==== BCS Sync: {%d, %d}\n", PERF_SYNC_TAIL, PERF_SYNC_HEAD);
+
+    struct {
+        const char *name;
+        size_t count;
+        size_t clusters;
+        uint64_t span;
+    } histories[] = {
+        { "sparse",      10,  0,    0 },
+        { "medium",     200,  0,    0 },
+        { "dense",     2000,  0,    0 },
+        { "clustered",  500,  5, 2000 }
+    };
+
+    for (size_t index = 0; index < sizeof (histories) / sizeof (histories[0]); index++) {
+        BRArrayOf(uint64_t) changes = perfSyncCreateChanges (histories[index].count,
+                                                             histories[index].clusters,
+                                                             histories[index].span,
+                                                             1 + index);
+        perfSyncRun (histories[index].name, changes, 1);
+        perfSyncRun (histories[index].name, changes, SYNC_DISPATCH_LIMIT);
+        array_free (changes);
+    }
+}
+
 extern void
 runBcTests (void) {
 //    runBloomTests();
     runBlockHeaderTests ();
+    runBloomFilterSetTests ();
+    runProofOfWorkTests ();
     runBlockTests();
     runLogTests();
     runAccountStateTests();
@@ -871,6 +871,250 @@ runEWM_PUBLIC_KEY_test (BREthereumNetwork network,
     ewmDestroy(ewm2);
 }
 
+//
+// Transfer Index
+//
+static BREthereumTransaction
+testTransferIndexTransaction (BREthereumAddress source,
+                              BREthereumAddress target,
+                              uint8_t hashByte,
+                              uint64_t nonce,
+                              uint64_t blockNumber) {
+    BREthereumTransaction transaction = transactionCreate (source, target,
+                                                           ethEtherCreateNumber (1, WEI),
+                                                           ethGasPriceCreate (ethEtherCreateNumber (GAS_PRICE_5_GWEI, WEI)),
+                                                           ethGasCreate (GAS_LIMIT_DEFAULT),
+                                                           NULL,
+                                                           nonce);
+    BREthereumHash hash = EMPTY_HASH_INIT;
+    hash.bytes[0] = hashByte;
+    transactionSetHash (transaction, hash);
+    transactionSetStatus (transaction,
+                          transactionStatusCreateIncluded (EMPTY_HASH_INIT, blockNumber, 0, 0, ethGasCreate (GAS_LIMIT_DEFAULT)));
+    return transaction;
+}
+
+static void
+runEWM_TRANSFER_INDEX_test (const char *paperKey) {
+    printf ("====   TRANSFER INDEX\n");
+
+    BREthereumAccount account = ethAccountCreate (paperKey);
+    BREthereumWallet  wallet  = walletCreate (account, ethNetworkMainnet);
+    BREthereumAddress other   = ethAddressCreate (TEST_TRANS3_TARGET_ADDRESS);
+
+    // Received transfers, inserted out of block order; the last two share a {source, nonce}
+    uint64_t blockNumbers[] = { 30, 10, 20, 20 };
+    uint64_t nonces[]       = {  3,  1,  2,  2 };
+    BREthereumTransfer received[4];
+    for (size_t index = 0; index < 4; index++) {
+        received[index] = transferCreateWithTransaction
+        (testTransferIndexTransaction (other, walletGetAddress (wallet), (uint8_t) (1 + index),
+                                       nonces[index], blockNumbers[index]));
+        walletHandleTransfer (wallet, received[index]);
+    }
+
+    // Sorted by block; equal transfers in the order they were added.
+    assert (received[1] == walletGetTransferByIndex (wallet, 0));
+    assert (received[2] == walletGetTransferByIndex (wallet, 1));
+    assert (received[3] == walletGetTransferByIndex (wallet, 2));
+    assert (received[0] == walletGetTransferByIndex (wallet, 3));
+
+    for (size_t index = 0; index < 4; index++)
+        assert (received[index] == walletGetTransferByIdentifier (wallet, transferGetIdentifier (received[index])));
+
+    // A shared nonce finds the transfer first in the ordering; then the other once it is gone.
+    assert (received[2] == walletGetTransferByNonce (wallet, other, 2));
+    walletUnhandleTransfer (wallet, received[2]);
+    assert (received[3] == walletGetTransferByNonce (wallet, other, 2));
+    assert (NULL == walletGetTransferByIdentifier (wallet, transferGetIdentifier (received[2])));
+    transferRelease (received[2]);
+
+    // An originated transfer has no keys until signed
+    BREthereumTransfer sent = walletCreateTransfer (wallet, other, ethAmountCreateEther (ethEtherCreateNumber (1, WEI)));
+    assert (NULL == walletGetTransferByOriginatingHash (wallet, transferGetOriginatingTransactionHash (sent)));
+    assert (sent == walletGetTransferByIndex (wallet, 3));
+
+    walletSignTransfer (wallet, sent, paperKey);
+    BREthereumHash sentHash = transferGetOriginatingTransactionHash (sent);
+    assert (sent == walletGetTransferByOriginatingHash (wallet, sentHash));
+    assert (sent == walletGetTransferByNonce (wallet, walletGetAddress (wallet), transferGetNonce (sent)));
+    assert (NULL == walletGetTransferByIdentifier (wallet, sentHash));
+
+    // Once included, the transaction basis gives the identifier and moves the transfer
+    BREthereumTransaction included = transactionCopy (transferGetOriginatingTransaction (sent));
+    transactionSetStatus (included,
+                          transactionStatusCreateIncluded (EMPTY_HASH_INIT, 15, 0, 0, ethGasCreate (GAS_LIMIT_DEFAULT)));
+    walletSetTransferBasisForTransaction (wallet, sent, included);
+
+    assert (sent == walletGetTransferByIndex (wallet, 1));
+    assert (sent == walletGetTransferByIdentifier (wallet, sentHash));
+    assert (sent == walletGetTransferByOriginatingHash (wallet, sentHash));
+    assert (received[3] == walletGetTransferByIndex (wallet, 2));
+    assert (received[3] == walletGetTransferByIdentifier (wallet, transferGetIdentifier (received[3])));
+
+    // A token transfer: the log basis, once included, gives an identifier distinct from the
+    // originating transaction's hash; both find the transfer.
+    BREthereumToken token = tokenLookupTestX (getTokenBRDAddress (ethNetworkMainnet));
+    BREthereumWallet tokenWallet = walletCreateHoldingToken (account, ethNetworkMainnet, token);
+
+    BREthereumTransfer tokenSent = walletCreateTransfer (tokenWallet, other,
+                                                         ethAmountCreateToken (ethTokenQuantityCreate (token, uint256Create (1))));
+    walletSignTransfer (tokenWallet, tokenSent, paperKey);
+    BREthereumHash tokenSentHash = transferGetOriginatingTransactionHash (tokenSent);
+    assert (tokenSent == walletGetTransferByOriginatingHash (tokenWallet, tokenSentHash));
+
+    BREthereumLog log = logCreate (ethTokenGetAddressRaw (token), 0, NULL, (BRRlpData) { 0, NULL });
+    logInitializeIdentifier (log, tokenSentHash, 0);
+    logSetStatus (log, transactionStatusCreateIncluded (EMPTY_HASH_INIT, 15, 0, 0, ethGasCreate (GAS_LIMIT_DEFAULT)));
+    walletSetTransferBasisForLog (tokenWallet, tokenSent, log);
+
+    BREthereumHash tokenIdentifier = transferGetIdentifier (tokenSent);
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (ethHashEqual (tokenIdentifier, tokenSentHash)));
+    assert (tokenSent == walletGetTransferByIdentifier (tokenWallet, tokenIdentifier));
+    assert (tokenSent == walletGetTransferByOriginatingHash (tokenWallet, tokenSentHash));
+    assert (NULL == walletGetTransferByIdentifier (tokenWallet, tokenSentHash));
+
+    walletRelease (tokenWallet);
+    walletRelease (wallet);
+    ethAccountRelease (account);
+}
+
+//
+// Announce Batch
+//
+typedef struct AnnounceBatchTestContextRecord {
+    pthread_cond_t  cond;
+    pthread_mutex_t lock;
+    int balanceEventCount;
+} *AnnounceBatchTestContext;
+
+static void
+clientEventWalletAnnounceBatch (BREthereumClientContext context,
+                                BREthereumEWM ewm,
+                                BREthereumWallet wid,
+                                BREthereumWalletEvent event) {
+    AnnounceBatchTestContext batchContext = (AnnounceBatchTestContext) context;
+    if (WALLET_EVENT_BALANCE_UPDATED == event.type) {
+        pthread_mutex_lock (&batchContext->lock);
+        batchContext->balanceEventCount += 1;
+        pthread_cond_signal (&batchContext->cond);
+        pthread_mutex_unlock (&batchContext->lock);
+    }
+}
+
+// Wait up to `seconds` for at least `count` balance events; return the count of events.
+static int
+waitForBalanceEventCount (AnnounceBatchTestContext context,
+                          int count,
+                          time_t seconds) {
+    struct timespec deadline;
+    clock_gettime (CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += seconds;
+
+    pthread_mutex_lock (&context->lock);
+    while (context->balanceEventCount < count &&
+           0 == pthread_cond_timedwait (&context->cond, &context->lock, &deadline))
+        ;
+    int result = context->balanceEventCount;
+    pthread_mutex_unlock (&context->lock);
+    return result;
+}
+
+#define ANNOUNCE_BATCH_COUNT        (3)
+
+static void
+runEWM_ANNOUNCE_BATCH_test (const char *paperKey,
+                            const char *storagePath) {
+    printf ("====   ANNOUNCE BATCH\n");
+
+    struct AnnounceBatchTestContextRecord context = {
+        PTHREAD_COND_INITIALIZER,
+        PTHREAD_MUTEX_INITIALIZER,
+        0
+    };
+
+    BREthereumClient batchClient = client;
+    batchClient.context = &context;
+    batchClient.funcWalletEvent = clientEventWalletAnnounceBatch;
+
+    ewmWipe (ethNetworkMainnet, storagePath);
+
+    BREthereumEWM ewm = ewmCreateWithPaperKey (ethNetworkMainnet, paperKey, ETHEREUM_TIMESTAMP_UNKNOWN,
+                                               CRYPTO_SYNC_MODE_API_ONLY,
+                                               batchClient,
+                                               storagePath,
+                                               0,
+                                               6);
+    BREthereumWallet wallet = ewmGetWallet (ewm);
+    assert (0 == ewmWalletGetTransferCount (ewm, wallet));
+
+    BREthereumAddress address = walletGetAddress (wallet);
+    BREthereumAddress other   = ethAddressCreate (TEST_TRANS3_TARGET_ADDRESS);
+
+    // A page of received transactions, announced at once.
+    BREthereumEWMClientAnnounceTransactionBundle bundles[ANNOUNCE_BATCH_COUNT];
+    for (size_t index = 0; index < ANNOUNCE_BATCH_COUNT; index++) {
+        BREthereumHash hash = EMPTY_HASH_INIT;
+        hash.bytes[0] = (uint8_t) (1 + index);
+
+        bundles[index] = (BREthereumEWMClientAnnounceTransactionBundle) {
+            hash,
+            other,
+            address,
+            EMPTY_ADDRESS_INIT,
+            uint256Create (1000 * (1 + index)),
+            GAS_LIMIT_DEFAULT,
+            uint256Create (GAS_PRICE_5_GWEI),
+            NULL,
+            index,
+            GAS_LIMIT_DEFAULT,
+            1000 + index,
+            EMPTY_HASH_INIT,
+            10,
+            0,
+            1516477482 + index,
+            ETHEREUM_BOOLEAN_FALSE
+        };
+    }
+
+    ewmStart (ewm);
+    assert (SUCCESS == ewmAnnounceTransactions (ewm, 0, bundles, ANNOUNCE_BATCH_COUNT));
+
+    // All the transfers are handled, and the balance updated and saved, once.  Allow time for
+    // any (erroneous) further balance events.
+    assert (1 == waitForBalanceEventCount (&context, 1, 5));
+    assert (ANNOUNCE_BATCH_COUNT == ewmWalletGetTransferCount (ewm, wallet));
+    assert (1 == waitForBalanceEventCount (&context, 2, 1));
+
+    BREthereumAmount balance = ewmWalletGetBalance (ewm, wallet);
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethEtherIsEQ (ethAmountGetEther (balance),
+                                                    ethEtherCreateNumber (6000, WEI))));
+    ewmDestroy (ewm);
+
+    // The batch was saved; the wallet, with its balance, and the transfers are restored.  The
+    // restored transactions are signalled and thus handled once started.
+    ewm = ewmCreateWithPaperKey (ethNetworkMainnet, paperKey, ETHEREUM_TIMESTAMP_UNKNOWN,
+                                 CRYPTO_SYNC_MODE_API_ONLY,
+                                 batchClient,
+                                 storagePath,
+                                 0,
+                                 6);
+    wallet  = ewmGetWallet (ewm);
+    balance = ewmWalletGetBalance (ewm, wallet);
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (ethEtherIsEQ (ethAmountGetEther (balance),
+                                                    ethEtherCreateNumber (6000, WEI))));
+
+    ewmStart (ewm);
+    for (int tries = 0; tries < 50 && ANNOUNCE_BATCH_COUNT != ewmWalletGetTransferCount (ewm, wallet); tries++)
+        usleep (100 * 1000);
+    assert (ANNOUNCE_BATCH_COUNT == ewmWalletGetTransferCount (ewm, wallet));
+    ewmDestroy (ewm);
+
+    ewmWipe (ethNetworkMainnet, storagePath);
+    pthread_cond_destroy (&context.cond);
+    pthread_mutex_destroy (&context.lock);
+}
+
 extern void
 runSyncTest (BREthereumNetwork network,
              BREthereumAccount account,
@@ -888,7 +1132,7 @@ runSyncTest (BREthereumNetwork network,
     
     alarmClockCreateIfNecessary (1);
 
-    ewm = ewmCreate (ethNetworkMainnet, account, accountTimestamp, mode, client, storagePath, 0, 6);
+    ewm = ewmCreate (ethNetworkMainnet, account, accountTimestamp, mode, NULL, client, storagePath, 0, 6);
 
     
     char *address = ewmGetAccountPrimaryAddress(ewm);
@@ -922,4 +1166,6 @@ runEWMTests (const char *paperKey,
 //    runEWM_CONNECT_test(paperKey, storagePath);
     runEWM_TOKEN_test (paperKey, storagePath);
     runEWM_PUBLIC_KEY_test (ethNetworkMainnet, paperKey, storagePath);
+    runEWM_TRANSFER_INDEX_test (paperKey);
+    runEWM_ANNOUNCE_BATCH_test (paperKey, storagePath);
 }
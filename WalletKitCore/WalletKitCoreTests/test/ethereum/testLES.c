@@ -1076,6 +1076,52 @@ void _GetBlockHeaders_0_1 (BREthereumLESProvisionContext context,
     _signalTestComplete();
 }
 
+//
+// Request Latency - the time from `lesProvide*()` to the provision result.  Each request is made
+// only once the prior one completes; thus LES is idle, waiting on node sockets, when the request
+// is queued.  Before LES had a wakeup descriptor, each such request waited for the pselect()
+// timeout (up to 250ms) before it was even sent.
+//
+#define LES_LATENCY_REQUEST_COUNT   (20)
+
+static void
+_RequestLatency_Callback (BREthereumLESProvisionContext context,
+                          BREthereumLES les,
+                          BREthereumNodeReference node,
+                          BREthereumProvisionResult result) {
+    assert (PROVISION_BLOCK_HEADERS == result.type);
+    assert (PROVISION_SUCCESS == result.status);
+    _signalTestComplete();
+}
+
+static void
+run_RequestLatency_Tests (BREthereumLES les) {
+    struct timespec start, stop;
+    double seconds = 0.0, secondsMax = 0.0;
+
+    for (size_t index = 0; index < LES_LATENCY_REQUEST_COUNT; index++) {
+        _initTest(1);
+
+        clock_gettime (CLOCK_MONOTONIC, &start);
+        lesProvideBlockHeaders (les, NODE_REFERENCE_ANY,
+                                NULL,
+                                _RequestLatency_Callback,
+                                _blockHeaderTestData[BLOCK_4732522_IDX].blockNum + index,
+                                1, 0, ETHEREUM_BOOLEAN_FALSE);
+        _waitForTests();
+        clock_gettime (CLOCK_MONOTONIC, &stop);
+
+        double requestSeconds = (double) (stop.tv_sec - start.tv_sec) + 1e-9 * (double) (stop.tv_nsec - start.tv_nsec);
+        seconds += requestSeconds;
+        if (requestSeconds > secondsMax) secondsMax = requestSeconds;
+    }
+
+    eth_log(TST_LOG_TOPIC, "RequestLatency: %d requests, mean %.1f ms, max %.1f ms",
+            LES_LATENCY_REQUEST_COUNT,
+            1e3 * seconds / LES_LATENCY_REQUEST_COUNT,
+            1e3 * secondsMax);
+}
+
 #if 0
 static void
 run_GetSomeHeaders (BREthereumLES les) {
@@ -1156,6 +1202,93 @@ run_GetSomeBlocks (BREthereumLES les) {
 }
 #endif
 
+//
+// Multiple Clients
+//
+typedef struct {
+    int saveNodesCount;
+    int provisionCount;
+} LESClientTestState;
+
+static void
+_clientSaveNodesCallback (BREthereumLESCallbackContext context,
+                          BRArrayOf(BREthereumNodeConfig) nodes) {
+    ((LESClientTestState *) context)->saveNodesCount += 1;
+    array_free (nodes);
+}
+
+static void
+_clientProvisionCallback (BREthereumLESProvisionContext context,
+                          BREthereumLES les,
+                          BREthereumNodeReference node,
+                          BREthereumProvisionResult result) {
+    ((LESClientTestState *) context)->provisionCount += 1;
+}
+
+static void
+run_MultipleClients_Tests (BREthereumHash headHash,
+                           uint64_t headNumber,
+                           UInt256 headTD,
+                           BREthereumHash genesisHash) {
+    printf ("     Multiple Clients\n");
+
+    LESClientTestState clientA = { 0, 0 };
+    LESClientTestState clientB = { 0, 0 };
+
+    // No client from lesCreate(); both clients share the one LES, each holding a reference.
+    BREthereumLES les = lesCreate (ethNetworkMainnet,
+                                   NULL, NULL, NULL, NULL,
+                                   headHash, headNumber, headTD, genesisHash,
+                                   NULL,
+                                   ETHEREUM_BOOLEAN_FALSE,
+                                   ETHEREUM_BOOLEAN_TRUE);
+    lesTake (les);
+
+    lesAddClient (les, &clientA, _announceCallback, _statusCallback, _clientSaveNodesCallback, NULL);
+    lesAddClient (les, &clientB, _announceCallback, _statusCallback, _clientSaveNodesCallback, NULL);
+
+    lesStartClient (les, &clientA);
+    lesStartClient (les, &clientB);
+    sleep (1);
+
+    // Stopping one client leaves LES running; only that client saves nodes.
+    lesStopClient (les, &clientA);
+    assert (1 == clientA.saveNodesCount && 0 == clientB.saveNodesCount);
+
+    // Stopping the last client stops LES; the client stopped earlier doesn't save again.
+    lesStopClient (les, &clientB);
+    assert (1 == clientA.saveNodesCount && 1 == clientB.saveNodesCount);
+
+    // Stopping a stopped client does nothing.
+    lesStopClient (les, &clientA);
+    assert (1 == clientA.saveNodesCount);
+
+    // Removing a client drops its pending provisions; they are never provided, even once LES
+    // runs again for the other client.
+    lesProvideBlockHeaders (les, NODE_REFERENCE_ANY, &clientA, _clientProvisionCallback,
+                            1, 1, 0, ETHEREUM_BOOLEAN_FALSE);
+    lesRemClient (les, &clientA);
+
+    lesStartClient (les, &clientB);
+    sleep (2);
+    assert (0 == clientA.provisionCount);
+
+    // Removing a started client stops it, and LES, saving its nodes.
+    lesRemClient (les, &clientB);
+    assert (1 == clientA.saveNodesCount && 2 == clientB.saveNodesCount);
+
+    // The first release leaves LES usable; a client can be added and started.
+    lesRelease (les);
+    lesAddClient (les, &clientA, _announceCallback, _statusCallback, _clientSaveNodesCallback, NULL);
+    lesStartClient (les, &clientA);
+    lesStopClient (les, &clientA);
+    assert (2 == clientA.saveNodesCount && 2 == clientB.saveNodesCount);
+
+    // The last release stops and frees LES; the removed clients aren't invoked.
+    lesRelease (les);
+    assert (2 == clientA.saveNodesCount && 2 == clientB.saveNodesCount);
+}
+
 extern void
 runLESTests (const char *paperKey) {
     
@@ -1167,6 +1300,9 @@ runLESTests (const char *paperKey) {
     UInt256 headTD = uint256Create (0x400000000);
     
     BREthereumHash genesisHash = ethHashCreate(headHashStr);
+
+    // Run Tests on LES clients; they share a LES of their own.
+    run_MultipleClients_Tests (headHash, headNumber, headTD, genesisHash);
     
     // Create an LES context
     BREthereumLES les = lesCreate (ethNetworkMainnet,
@@ -1194,6 +1330,7 @@ runLESTests (const char *paperKey) {
     // Disable until CORE-164
     // run_GetAccountState_Tests(les);
     run_GetTxStatus_Tests(les);
+    run_RequestLatency_Tests(les);
 
     //    run_GetProofsV2_Tests(les); //NOTE: The callback function won't be called.
 
@@ -1210,6 +1347,98 @@ runLESTests (const char *paperKey) {
     printf ("Done\n");
 }
 
+//
+// Provision Split/Merge
+//
+static BRArrayOf(BREthereumBlockHeader)
+_provisionTestHeaders (BREthereumBlockHeader header, size_t count) {
+    BRArrayOf(BREthereumBlockHeader) headers;
+    array_new (headers, count);
+    for (size_t index = 0; index < count; index++)
+        array_add (headers, blockHeaderCopy (header));
+    return headers;
+}
+
+static BRArrayOf(BRArrayOf(BREthereumTransactionReceipt))
+_provisionTestReceipts (size_t count) {
+    BRArrayOf(BRArrayOf(BREthereumTransactionReceipt)) receipts;
+    array_new (receipts, count);
+    for (size_t index = 0; index < count; index++) {
+        BRArrayOf(BREthereumTransactionReceipt) blockReceipts;
+        array_new (blockReceipts, 1);
+        array_add (receipts, blockReceipts);
+    }
+    return receipts;
+}
+
+static void
+run_ProvisionSplit_Tests (void) {
+    printf ("     Provision Split/Merge\n");
+
+    // Headers: the parts continue where the prior part ended, respecting `skip`
+    BREthereumProvision headers = {
+        PROVISION_IDENTIFIER_UNDEFINED,
+        PROVISION_BLOCK_HEADERS,
+        { .headers = { 1000, 1, 400, ETHEREUM_BOOLEAN_FALSE, NULL }}
+    };
+    assert (400 == provisionGetCount (&headers));
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (provisionIsSplittable (&headers)));
+
+    size_t headersSizes[] = { 192, 192, 16 };
+    BRArrayOf(BREthereumProvision) parts = provisionSplit (&headers, 3, headersSizes);
+    assert (3 == array_count (parts));
+    assert (1000 == parts[0].u.headers.start && 192 == parts[0].u.headers.limit);
+    assert (1384 == parts[1].u.headers.start && 192 == parts[1].u.headers.limit);
+    assert (1768 == parts[2].u.headers.start &&  16 == parts[2].u.headers.limit);
+
+    // A short part ends the merged headers; the later part is dropped.
+    BREthereumBlockHeader genesis = networkGetGenesisBlockHeader (ethNetworkMainnet);
+    parts[0].u.headers.headers = _provisionTestHeaders (genesis, 192);
+    parts[1].u.headers.headers = _provisionTestHeaders (genesis, 100);
+    parts[2].u.headers.headers = _provisionTestHeaders (genesis, 16);
+
+    provisionMerge (&headers, parts);
+    assert (292 == array_count (headers.u.headers.headers));
+    provisionRelease (&headers, ETHEREUM_BOOLEAN_TRUE);
+    blockHeaderRelease (genesis);
+
+    // A reverse request can't be split.
+    headers.u.headers.reverse = ETHEREUM_BOOLEAN_TRUE;
+    assert (ETHEREUM_BOOLEAN_IS_FALSE (provisionIsSplittable (&headers)));
+
+    // Receipts: the parts hold slices of the hashes; the merged receipts keep their order.
+    BRArrayOf(BREthereumHash) hashes;
+    array_new (hashes, 70);
+    for (size_t index = 0; index < 70; index++) {
+        BREthereumHash hash;
+        memset (hash.bytes, (int) index, sizeof (hash.bytes));
+        array_add (hashes, hash);
+    }
+
+    BREthereumProvision receipts = {
+        PROVISION_IDENTIFIER_UNDEFINED,
+        PROVISION_TRANSACTION_RECEIPTS,
+        { .receipts = { hashes, NULL }}
+    };
+    assert (70 == provisionGetCount (&receipts));
+
+    size_t receiptsSizes[] = { 32, 38 };
+    parts = provisionSplit (&receipts, 2, receiptsSizes);
+    assert (32 == array_count (parts[0].u.receipts.hashes));
+    assert (38 == array_count (parts[1].u.receipts.hashes));
+    assert (parts[0].u.receipts.hashes != hashes);
+    assert (0 == memcmp (&parts[1].u.receipts.hashes[0], &hashes[32], sizeof (BREthereumHash)));
+    assert (0 == memcmp (&parts[1].u.receipts.hashes[37], &hashes[69], sizeof (BREthereumHash)));
+
+    parts[0].u.receipts.receipts = _provisionTestReceipts (32);
+    parts[1].u.receipts.receipts = _provisionTestReceipts (38);
+
+    provisionMerge (&receipts, parts);
+    assert (70 == array_count (receipts.u.receipts.receipts));
+    provisionRelease (&receipts, ETHEREUM_BOOLEAN_TRUE);
+}
+
 extern void
 runNodeTests (void) {
+    run_ProvisionSplit_Tests ();
 }
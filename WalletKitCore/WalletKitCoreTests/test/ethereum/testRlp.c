@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include "support/BRCrypto.h"
 #include "ethereum/util/BRUtil.h"
 #include "ethereum/rlp/BRRlp.h"
 
@@ -175,8 +176,226 @@ void runRlpDecodeTest () {
     rlpCoderRelease(coder);
 }
 
+void runRlpArenaTest () {
+    printf ("         Arena\n");
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
+    size_t itemsCount, bytesCount, c;
+
+    // A nested list: [ [ 'cat', 'dog' ], <large string>, 1024 ]
+    uint8_t large[5000];
+    memset (large, 'a', sizeof (large));
+
+    BRRlpItem item = rlpEncodeList (coder, 3,
+                                    rlpEncodeList2 (coder,
+                                                    rlpEncodeString (coder, "cat"),
+                                                    rlpEncodeString (coder, "dog")),
+                                    rlpEncodeBytes (coder, large, sizeof (large)),
+                                    rlpEncodeUInt64 (coder, 1024, 0));
+    BRRlpData data = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+
+    item = rlpDataGetItem (coder, data);
+    const BRRlpItem *items = rlpDecodeList (coder, item, &c);
+    assert (3 == c);
+
+    // Sub-items share the decoded bytes
+    BRRlpData itemData = rlpItemGetDataSharedDontRelease (coder, item);
+    BRRlpData subData  = rlpItemGetDataSharedDontRelease (coder, items[0]);
+    assert (subData.bytes > itemData.bytes && subData.bytes < itemData.bytes + itemData.bytesCount);
+
+    const BRRlpItem *subItems = rlpDecodeList (coder, items[0], &c);
+    assert (2 == c);
+    char *liDog = rlpDecodeString (coder, subItems[1]);
+    assert (0 == strcmp (liDog, "dog"));
+    free (liDog);
+
+    BRRlpData largeData = rlpDecodeBytesSharedDontRelease (coder, items[1]);
+    assert (sizeof (large) == largeData.bytesCount && 0 == memcmp (large, largeData.bytes, sizeof (large)));
+    assert (1024 == rlpDecodeUInt64 (coder, items[2], 0));
+
+    // Items are retained until reclaimed; an outstanding item prevents reclaiming them
+    rlpCoderReclaim (coder);
+    rlpCoderGetStats (coder, &itemsCount, &bytesCount);
+    assert (0 != itemsCount && 0 != bytesCount);
+
+    rlpItemRelease (coder, item);
+    rlpCoderReclaim (coder);
+    rlpCoderGetStats (coder, &itemsCount, &bytesCount);
+    assert (0 == itemsCount && 0 == bytesCount);
+
+    rlpDataRelease (data);
+    rlpCoderRelease (coder);
+}
+
+void runRlpEncodeWriteTest () {
+    printf ("         Encode Write\n");
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
+
+    // A nested list, with a long list, as for a transaction or a block header
+    uint8_t large[300];
+    memset (large, 0x5a, sizeof (large));
+
+    BRRlpItem item = rlpEncodeList (coder, 3,
+                                    rlpEncodeUInt64 (coder, 1024, 0),
+                                    rlpEncodeList2 (coder,
+                                                    rlpEncodeString (coder, "cat"),
+                                                    rlpEncodeBytes (coder, large, sizeof (large))),
+                                    rlpEncodeListItems (coder, NULL, 0));
+
+    size_t prefixCount;
+    size_t bytesCount = rlpItemGetDataBytesCount (coder, item, &prefixCount);
+    assert (3 + 3 + (3 + 4 + 3 + 300) + 1 == bytesCount);
+    assert (3 == prefixCount);
+
+    // Fill and hash before, and after, the item has its own bytes.
+    uint8_t bytes[bytesCount];
+    rlpItemFillData (coder, item, bytes);
+    assert (0xf9 == bytes[0] && 0xc0 == bytes[bytesCount - 1]);
+
+    uint8_t hash[32];
+    BRKeccak256 (hash, bytes, bytesCount);
+    UInt256 itemHash = rlpItemGetKeccak256 (coder, item);
+    assert (0 == memcmp (hash, itemHash.u8, 32));
+
+    BRRlpData data = rlpItemGetDataSharedDontRelease (coder, item);
+    assert (bytesCount == data.bytesCount && 0 == memcmp (bytes, data.bytes, bytesCount));
+
+    itemHash = rlpItemGetKeccak256 (coder, item);
+    assert (0 == memcmp (hash, itemHash.u8, 32));
+
+    // Sub-items now share the written bytes
+    size_t c;
+    const BRRlpItem *items = rlpDecodeList (coder, item, &c);
+    assert (3 == c);
+    BRRlpData subData = rlpItemGetDataSharedDontRelease (coder, items[1]);
+    assert (subData.bytes == &data.bytes[prefixCount + 3]);
+
+    const BRRlpItem *subItems = rlpDecodeList (coder, items[1], &c);
+    assert (2 == c);
+    char *liCat = rlpDecodeString (coder, subItems[0]);
+    assert (0 == strcmp (liCat, "cat"));
+    free (liCat);
+
+    rlpItemRelease (coder, item);
+    rlpCoderRelease (coder);
+}
+
+void runRlpViewTest () {
+    printf ("         View\n");
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
+    size_t c;
+
+    // A nested list: [ [ 'cat', 'dog' ], <long string>, 1024 ]
+    uint8_t large[300];
+    memset (large, 0x5a, sizeof (large));
+
+    BRRlpItem item = rlpEncodeList (coder, 3,
+                                    rlpEncodeList2 (coder,
+                                                    rlpEncodeString (coder, "cat"),
+                                                    rlpEncodeString (coder, "dog")),
+                                    rlpEncodeBytes (coder, large, sizeof (large)),
+                                    rlpEncodeUInt64 (coder, 1024, 0));
+    BRRlpData data = rlpItemGetData (coder, item);
+    UInt256 itemHash = rlpItemGetKeccak256 (coder, item);
+    rlpItemRelease (coder, item);
+
+    BRRlpView view = rlpViewCreate (data);
+    assert (rlpViewIsValid (view) && rlpViewIsList (view));
+    assert (data.bytesCount == view.bytesCount && 3 == view.prefixCount);
+    assert (3 == rlpViewGetListCount (view));
+
+    UInt256 viewHash = rlpViewGetKeccak256 (view);
+    assert (0 == memcmp (itemHash.u8, viewHash.u8, 32));
+
+    // Sub-items reference `data` directly
+    BRRlpView views[3];
+    assert (3 == rlpViewDecodeList (view, views, 3));
+    assert (views[0].bytes == &data.bytes[3]);
+
+    BRRlpData largeData = rlpViewDecodeBytes (views[1]);
+    assert (sizeof (large) == largeData.bytesCount && 0 == memcmp (large, largeData.bytes, sizeof (large)));
+    assert (largeData.bytes > data.bytes && largeData.bytes < data.bytes + data.bytesCount);
+    int failed = 0;
+    assert (1024 == rlpViewDecodeUInt64 (views[2], 0, &failed));
+    assert (1024 == rlpViewDecodeUInt256 (views[2], 0, &failed).u64[0]);
+    assert (!failed);
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (views[0]);
+    BRRlpView subView;
+    for (c = 0; rlpViewCursorNext (&cursor, &subView); c++) {
+        BRRlpData subData = rlpViewDecodeBytes (subView);
+        assert (3 == subData.bytesCount && 0 == memcmp (subData.bytes, (0 == c ? "cat" : "dog"), 3));
+    }
+    assert (2 == c && !cursor.failed);
+
+    // A string is not a list
+    cursor = rlpViewGetCursor (views[1]);
+    assert (cursor.failed && !rlpViewCursorNext (&cursor, &subView));
+    assert (0 == rlpViewDecodeList (views[1], views, 3));
+
+    // Views of an item and of the item's data agree; the item's sub-items are never needed.
+    item = rlpDataGetItem (coder, data);
+    BRRlpView itemView = rlpItemGetView (coder, item);
+    assert (view.bytesCount == itemView.bytesCount && 0 == memcmp (view.bytes, itemView.bytes, view.bytesCount));
+    rlpItemRelease (coder, item);
+
+    // Truncated and malformed encodings
+    BRRlpData truncated = { data.bytesCount - 1, data.bytes };
+    assert (!rlpViewIsValid (rlpViewCreate (truncated)));
+
+    uint8_t shortList[] = { 0xc3, 0x82, 0x01 };             // list payload exceeds the bytes
+    assert (!rlpViewIsValid (rlpViewCreate ((BRRlpData) { sizeof (shortList), shortList })));
+
+    uint8_t badList[] = { 0xc2, 0x83, 0x01 };               // sub-item exceeds the list
+    BRRlpView badView = rlpViewCreate ((BRRlpData) { sizeof (badList), badList });
+    assert (rlpViewIsValid (badView));
+    cursor = rlpViewGetCursor (badView);
+    assert (!rlpViewCursorNext (&cursor, &subView) && cursor.failed);
+    assert (0 == rlpViewDecodeList (badView, views, 3));
+
+    uint8_t hugeLength[] = { 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 };
+    BRRlpView hugeView = rlpViewCreate ((BRRlpData) { sizeof (hugeLength), hugeLength });
+    assert (!rlpViewIsValid (hugeView));
+    assert (0 == rlpViewDecodeBytes (hugeView).bytesCount && 0 == rlpViewDecodeUInt64 (hugeView, 0, NULL));
+
+    // Numbers: the empty string is zero; more bytes than the number, a list or an invalid view fails.
+    uint8_t emptyString[] = { 0x80 };
+    BRRlpView emptyView = rlpViewCreate ((BRRlpData) { sizeof (emptyString), emptyString });
+    assert (0 == rlpViewDecodeUInt64 (emptyView, 1, &failed) && !failed);
+    assert (0 == rlpViewDecodeUInt64 (emptyView, 0, &failed) && !failed);
+
+    uint8_t number[34];
+    memset (number, 0x01, sizeof (number));
+
+    number[0] = 0x80 + 8;                                   // 8 bytes fit a uint64_t
+    assert (0x0101010101010101 == rlpViewDecodeUInt64 (rlpViewCreate ((BRRlpData) { 9, number }), 1, &failed));
+    assert (!failed);
+
+    number[0] = 0x80 + 32;                                  // 32 bytes fit a UInt256
+    assert (0x0101010101010101 == rlpViewDecodeUInt256 (rlpViewCreate ((BRRlpData) { 33, number }), 1, &failed).u64[3]);
+    assert (!failed);
+
+    number[0] = 0x80 + 9;                                   // 9 bytes don't fit a uint64_t
+    assert (0 == rlpViewDecodeUInt64 (rlpViewCreate ((BRRlpData) { 10, number }), 1, &failed) && failed);
+
+    failed = 0;
+    number[0] = 0x80 + 33;                                  // 33 bytes don't fit a UInt256
+    assert (UInt256IsZero (rlpViewDecodeUInt256 (rlpViewCreate ((BRRlpData) { 34, number }), 1, &failed)) && failed);
+
+    failed = 0;
+    assert (0 == rlpViewDecodeUInt64 (view, 1, &failed) && failed);
+    failed = 0;
+    assert (0 == rlpViewDecodeUInt64 (hugeView, 1, &failed) && failed);
+
+    rlpDataRelease (data);
+    rlpCoderRelease (coder);
+}
+
 void runRlpTests (void) {
     printf ("==== RLP\n");
     runRlpEncodeTest ();
     runRlpDecodeTest ();
+    runRlpArenaTest ();
+    runRlpEncodeWriteTest ();
+    runRlpViewTest ();
 }
@@ -68,6 +68,15 @@ runTests (int reallySend);
 extern void
 runPerfTestsCoder (int repeat, int many);
 
+extern void
+runPerfTestsCoderPayloads (int repeat);
+
+extern void
+runPerfTestsProofOfWork (int repeat, const char *path);
+
+extern void
+runPerfTestsBCSSync (void);
+
 // Bitcoin
 extern int BRRunSupTests (void);
 
@@ -96,9 +105,16 @@ extern int BRRunTestsBWM (const char *paperKey,
 
 extern void BRRandInit (void);
 
+extern void BRRunPerfTestsTxParse (size_t inCount, size_t repeat);
+
+// testPeer.c
+extern int BRRunPerfTestsSync (uint32_t blockCount, size_t txCount, size_t addrsCount);
+
 // testCrypto.c
 extern void runCryptoTests (void);
 
+extern void runCryptoPerfTestsAccountBatch (size_t count, size_t threadCount);
+
 extern BRCryptoBoolean
 runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
                                      BRCryptoNetwork network,
@@ -228,6 +228,55 @@ static int runSupFileServiceMultiTests (void) {
     return fileServiceTestDone(path, success);
 }
 
+static int runSupFileServiceBatchTests (void) {
+    printf ("==== SUP:FileServiceBatch\n");
+
+    struct stat dirStat;
+
+    BRFileService fs1, fs2;
+    char *path = "private";
+    char *currency = "btc", *network = "mainnet";
+    char *type1 = "foo";
+
+    if (0 == stat  (path, &dirStat)) _rmdir (path);
+    if (0 != mkdir (path, 0700)) return 0;
+
+    fs1 = fileServiceSetup (path, currency, network, type1);
+    fs2 = fileServiceSetup (path, currency, network, type1);
+    if (NULL == fs1 || NULL == fs2) return fileServiceTestDone(path, 0);
+
+    int success = 1;
+
+    // A batch that succeeds
+    success &= fileServiceBeginBatch (fs1);
+    success &= fileServiceReplace (fs1, type1, NULL, 0);
+    success &= fileServiceEndBatch (fs1);
+
+    // `fs2` holds the DB's write lock in its batch; `fs1` can't replace and, within its nested
+    // batches, rolls them back.  Each end of the rolled-back batches reports the failure.
+    success &= fileServiceBeginBatch (fs2);
+    success &= fileServiceReplace (fs2, type1, NULL, 0);
+
+    success &= fileServiceBeginBatch (fs1);
+    success &= fileServiceBeginBatch (fs1);
+    success &= !fileServiceReplace (fs1, type1, NULL, 0);
+    success &= !fileServiceEndBatch (fs1);
+    success &= !fileServiceEndBatch (fs1);
+    success &= !fileServiceEndBatch (fs1);     // missed batch
+
+    success &= fileServiceEndBatch (fs2);
+
+    // With the lock released, and no DB transaction left open by `fs1`, both proceed.
+    success &= fileServiceReplace (fs1, type1, NULL, 0);
+    success &= fileServiceBeginBatch (fs2);
+    success &= fileServiceReplace (fs2, type1, NULL, 0);
+    success &= fileServiceEndBatch (fs2);
+
+    fileServiceRelease(fs1);
+    fileServiceRelease(fs2);
+    return fileServiceTestDone(path, success);
+}
+
 /// MARK: - Assert Tests
 
 #define DEFAULT_WORKERS     (5)
@@ -526,6 +575,7 @@ int BRRunSupTests (void) {
 
     success &= runSupFileServiceTests();
     success &= runSupFileServiceMultiTests ();
+    success &= runSupFileServiceBatchTests ();
     success &= runSupAssertTests();
 
     return success;
@@ -85,6 +85,30 @@ extern "C" {
     extern BRCryptoAccount
     cryptoAccountCreateFromSerialization (const uint8_t *bytes, size_t bytesCount, const char *uids);
 
+    /**
+     * Create an Account from each of `count` paper keys and return its serialization, as if with
+     * `cryptoAccountCreate()` and then `cryptoAccountSerialize()`.  The accounts are created
+     * concurrently, on `threadCount` threads.  As for `cryptoAccountCreate()` there is no check on
+     * the paper keys.
+     *
+     * @param paperKeys the paper keys
+     * @param timestamps the paper keys' creation timestamps
+     * @param count the number of paper keys
+     * @param threadCount the number of threads; if 0, the number of processors
+     * @param bytesCounts filled with the serialized bytes count of each account; must have `count`
+     *    entries
+     *
+     * @return An array of `count` serializations, each suitable for use by
+     * `cryptoAccountCreateFromSerialization()`, in the order of `paperKeys`.  The returned array and
+     * each serialization are owned by the caller and must be freed.
+     */
+    extern uint8_t **
+    cryptoAccountSerializeBatch (const char *paperKeys[],
+                                 const uint64_t timestamps[],
+                                 size_t count,
+                                 size_t threadCount,
+                                 size_t bytesCounts[]);
+
     /*
      * Serialize an account.
      *
@@ -157,6 +157,30 @@ extern "C" {
     extern uint32_t
     cryptoNetworkGetConfirmationsUntilFinal (BRCryptoNetwork network);
 
+    /**
+     * Returns the maximum number of client requests in flight at once, over all the wallet
+     * managers on `network`.  Zero is unlimited.
+     *
+     * @param network the network
+     *
+     * @return the client request limit
+     */
+    extern size_t
+    cryptoNetworkGetClientRequestLimit (BRCryptoNetwork network);
+
+    /**
+     * Set the maximum number of client requests in flight at once, over all the wallet managers
+     * on `network`.  Requests made for a sync wait for a free slot; requests made for the user,
+     * to submit a transfer or to estimate a fee, never wait but do occupy a slot.  A new limit
+     * applies as requests are next made or answered.
+     *
+     * @param network the network
+     * @param limit the client request limit; zero is unlimited
+     */
+    extern void
+    cryptoNetworkSetClientRequestLimit (BRCryptoNetwork network,
+                                        size_t limit);
+
     /**
      * Returns the number of network currencies.  This is the index exclusive limit to be used
      * in `cryptoNetworkGetCurrencyAt()`.
@@ -156,6 +156,90 @@ extern "C" {
     cryptoWalletGetTransfers (BRCryptoWallet wallet,
                               size_t *count);
 
+    /**
+     * Returns a newly allocated array of up to `limit` of the wallet's transfers, starting at
+     * `offset`, in `cryptoTransferCompare()` order, newest first.  This is a page of the wallet's
+     * transfers snapshot; see `cryptoWalletGetTransfersSnapshot()`.
+     *
+     * The caller is responsible for deallocating the returned array using free().
+     *
+     * @param wallet the wallet
+     * @param offset the index, newest first, of the first transfer returned
+     * @param limit the maximum number of transfers returned
+     * @param count the number of transfers returned
+     *
+     * @return An array of transfers w/ an incremented reference count (aka 'taken')
+     *         or NULL if there are no transfers at `offset`.
+     */
+    extern BRCryptoTransfer *
+    cryptoWalletGetTransfersPaged (BRCryptoWallet wallet,
+                                   size_t offset,
+                                   size_t limit,
+                                   size_t *count);
+
+    /**
+     * An immutable snapshot of a wallet's transfers, in `cryptoTransferCompare()` order, newest
+     * first.  The snapshot holds a reference to each transfer; a transfer from
+     * `cryptoWalletTransfersGetAt()` is not 'taken' and is valid while the snapshot is held.
+     */
+    typedef struct BRCryptoWalletTransfersRecord *BRCryptoWalletTransfers;
+
+    /**
+     * Returns a snapshot of the wallet's transfers.  The wallet retains its most recent snapshot
+     * and, until the wallet's transfers change, returns it again - sharing it among callers.
+     *
+     * @param wallet the wallet
+     *
+     * @return the snapshot, taken.
+     */
+    extern BRCryptoWalletTransfers
+    cryptoWalletGetTransfersSnapshot (BRCryptoWallet wallet);
+
+    /**
+     * Returns the version of the wallet's transfers at which `snapshot` was taken.
+     */
+    extern uint64_t
+    cryptoWalletTransfersGetVersion (BRCryptoWalletTransfers snapshot);
+
+    extern size_t
+    cryptoWalletTransfersGetCount (BRCryptoWalletTransfers snapshot);
+
+    extern BRCryptoTransfer
+    cryptoWalletTransfersGetAt (BRCryptoWalletTransfers snapshot,
+                                size_t index);
+
+    DECLARE_CRYPTO_GIVE_TAKE (BRCryptoWalletTransfers, cryptoWalletTransfers);
+
+    /**
+     * Returns the version of the wallet's transfers.  The version increases whenever a transfer
+     * is added, changed (such as in its state) or removed.
+     */
+    extern uint64_t
+    cryptoWalletGetTransfersVersion (BRCryptoWallet wallet);
+
+    /**
+     * Returns a newly allocated array of the wallet's transfers that were added or changed after
+     * `version`, in the order added to the wallet.  Removed transfers are not returned; instead
+     * `hasRemoved` is set if any transfer was removed after `version` - in which case, a full
+     * refresh is needed.  Pair with `cryptoWalletGetTransfersVersion()`, called beforehand, for
+     * the next `version`.
+     *
+     * The caller is responsible for deallocating the returned array using free().
+     *
+     * @param wallet the wallet
+     * @param version the version of a prior refresh
+     * @param hasRemoved set to CRYPTO_TRUE if a transfer was removed after `version`
+     * @param count the number of transfers returned
+     *
+     * @return An array of transfers w/ an incremented reference count (aka 'taken')
+     *         or NULL if no transfers changed.
+     */
+    extern BRCryptoTransfer *
+    cryptoWalletGetTransfersChangedSince (BRCryptoWallet wallet,
+                                          uint64_t version,
+                                          BRCryptoBoolean *hasRemoved,
+                                          size_t *count);
+
     /**
      * Returns a 'new' adddress from `wallet` according to the provided `addressScheme`.  For BTC
      * this is a segwit or a bech32 address.  Note that the returned address is not associated with
@@ -162,6 +162,55 @@ extern "C" {
         BRCryptoCWMListenerTransferEvent transferEventCallback;
     } BRCryptoCWMListener;
 
+    /// MARK: Batched Listener
+
+    typedef enum {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER,
+        CRYPTO_CWM_LISTENER_EVENT_WALLET,
+        CRYPTO_CWM_LISTENER_EVENT_TRANSFER,
+    } BRCryptoCWMListenerEventType;
+
+    /**
+     * One of the events otherwise delivered by a BRCryptoCWMListener callback.  The `wallet` is
+     * NULL for a WALLET_MANAGER event; the `transfer` is NULL but for a TRANSFER event.
+     */
+    typedef struct {
+        BRCryptoCWMListenerEventType type;
+        BRCryptoWalletManager manager;
+        BRCryptoWallet wallet;
+        BRCryptoTransfer transfer;
+        union {
+            BRCryptoWalletManagerEvent manager;
+            BRCryptoWalletEvent wallet;
+            BRCryptoTransferEvent transfer;
+        } u;
+    } BRCryptoCWMListenerEvent;
+
+    /// Handler must 'give', for each event: manager, wallet, transfer and u.*, as for the
+    /// corresponding BRCryptoCWMListener callback.  Handler must free() `events`.
+    typedef void (*BRCryptoCWMListenerEvents) (BRCryptoCWMListenerContext context,
+                                               OwnershipGiven BRCryptoCWMListenerEvent *events,
+                                               size_t eventsCount);
+
+    /**
+     * A Listener that receives events in batches, in the order they occurred.  A batch is
+     * delivered once it holds at least `eventsLimit` events or once its first event is
+     * `latencyInMilliseconds` old, whichever is first.  A batch is also delivered at once when
+     * the Wallet Manager disconnects, is deleted or is stopped.
+     *
+     * Within a batch, a wallet's BALANCE_UPDATED events and the manager's SYNC_CONTINUES events
+     * are coalesced: only the most recent is delivered, in the position it occurred.  Thus the
+     * delivered BALANCE_UPDATED follows every TRANSFER event, and every wallet TRANSFER_* event,
+     * that preceded it in the batch; but, unlike with a BRCryptoCWMListener, a TRANSFER event is
+     * not necessarily followed by the BALANCE_UPDATED that it caused - only by the latest one.
+     */
+    typedef struct {
+        BRCryptoCWMListenerContext context;
+        BRCryptoCWMListenerEvents eventsCallback;
+        size_t eventsLimit;
+        uint64_t latencyInMilliseconds;
+    } BRCryptoCWMBatchedListener;
+
     /// MARK: Wallet Manager
 
     /// Can return NULL
@@ -174,6 +223,19 @@ extern "C" {
                                BRCryptoAddressScheme scheme,
                                const char *path);
 
+    /**
+     * Create a Wallet Manager, as `cryptoWalletManagerCreate()`, with events delivered in batches
+     * to `listener`.  Events are delivered on a thread of the Wallet Manager's own.
+     */
+    extern BRCryptoWalletManager
+    cryptoWalletManagerCreateBatched (BRCryptoCWMBatchedListener listener,
+                                      BRCryptoClient client,
+                                      BRCryptoAccount account,
+                                      BRCryptoNetwork network,
+                                      BRCryptoSyncMode mode,
+                                      BRCryptoAddressScheme scheme,
+                                      const char *path);
+
     extern BRCryptoNetwork
     cryptoWalletManagerGetNetwork (BRCryptoWalletManager cwm);
 
@@ -185,6 +185,7 @@ static const BRChainParams BRBCashParamsRecord = {
     0xe8f3e1e3,          // magicNumber
     SERVICES_NODE_BCASH, // services
     BRBCashVerifyDifficulty,
+    BLOCK_MAX_PROOF_OF_WORK,
     BRBCashCheckpoints,
     sizeof(BRBCashCheckpoints)/sizeof(*BRBCashCheckpoints),
     { BITCOIN_PUBKEY_PREFIX, BITCOIN_SCRIPT_PREFIX, BITCOIN_PRIVKEY_PREFIX, NULL },
@@ -198,6 +199,7 @@ static const BRChainParams BRBCashTestNetParamsRecord = {
     0xf4f3e5f4,          // magicNumber
     SERVICES_NODE_BCASH, // services
     BRBCashTestNetVerifyDifficulty,
+    BLOCK_MAX_PROOF_OF_WORK,
     BRBCashTestNetCheckpoints,
     sizeof(BRBCashTestNetCheckpoints)/sizeof(*BRBCashTestNetCheckpoints),
     { BITCOIN_PUBKEY_PREFIX_TEST, BITCOIN_SCRIPT_PREFIX_TEST, BITCOIN_PRIVKEY_PREFIX_TEST, NULL },
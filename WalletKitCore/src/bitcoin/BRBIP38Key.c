@@ -30,6 +30,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #define BIP38_NOEC_PREFIX      0x0142
 #define BIP38_EC_PREFIX        0x0143
@@ -47,13 +49,14 @@
 // BIP38 is a method for encrypting private keys with a passphrase
 // https://github.com/bitcoin/bips/blob/master/bip-0038.mediawiki
 
-static UInt256 _BRBIP38DerivePassfactor(uint8_t flag, const uint8_t *entropy, const char *passphrase)
+static UInt256 _BRBIP38DerivePassfactor(uint8_t flag, const uint8_t *entropy, const char *passphrase,
+                                        unsigned scryptThreads)
 {
     size_t len = strlen(passphrase);
     UInt256 prefactor, passfactor;
     
-    BRScrypt(&prefactor, sizeof(prefactor), passphrase, len, entropy, (flag & BIP38_LOTSEQUENCE_FLAG) ? 4 : 8,
-             BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P);
+    BRScryptParallel(&prefactor, sizeof(prefactor), passphrase, len, entropy, (flag & BIP38_LOTSEQUENCE_FLAG) ? 4 : 8,
+                     BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P, scryptThreads);
     
     if (flag & BIP38_LOTSEQUENCE_FLAG) { // passfactor = SHA256(SHA256(prefactor + entropy))
         uint8_t d[sizeof(prefactor) + sizeof(uint64_t)];
@@ -104,9 +107,9 @@ int BRBIP38KeyIsValid(const char *bip38Key)
     else return 0; // invalid prefix
 }
 
-// decrypts a BIP38 key using the given passphrase and returns false if passphrase is incorrect
-// passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
-int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params)
+// decrypts a BIP38 key, running the scrypt lanes on up to scryptThreads threads
+static int _BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params,
+                             unsigned scryptThreads)
 {
     int r = 1;
     uint8_t data[39];
@@ -129,8 +132,8 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
         // data = prefix + flag + addresshash + encrypted1 + encrypted2
         UInt128 encrypted1 = UInt128Get(&data[7]), encrypted2 = UInt128Get(&data[23]);
 
-        BRScrypt(&derived, sizeof(derived), passphrase, pwLen, addresshash, sizeof(uint32_t),
-                 BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P);
+        BRScryptParallel(&derived, sizeof(derived), passphrase, pwLen, addresshash, sizeof(uint32_t),
+                         BIP38_SCRYPT_N, BIP38_SCRYPT_R, BIP38_SCRYPT_P, scryptThreads);
         derived1 = *(UInt256 *)&derived, derived2 = *(UInt256 *)&derived.u8[sizeof(UInt256)];
         var_clean(&derived);
         
@@ -148,7 +151,7 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
         // data = prefix + flag + addresshash + entropy + encrypted1[0...7] + encrypted2
         const uint8_t *entropy = &data[7];
         UInt128 encrypted1 = UINT128_ZERO, encrypted2 = UInt128Get(&data[23]);
-        UInt256 passfactor = _BRBIP38DerivePassfactor(flag, entropy, passphrase), factorb;
+        UInt256 passfactor = _BRBIP38DerivePassfactor(flag, entropy, passphrase, scryptThreads), factorb;
         BRECPoint passpoint;
         uint64_t seedb[3];
         
@@ -186,6 +189,95 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
     return r;
 }
 
+// decrypts a BIP38 key using the given passphrase and returns false if passphrase is incorrect
+// passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
+int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params)
+{
+    return _BRKeySetBIP38Key(key, bip38Key, passphrase, params, 1);
+}
+
+typedef struct {
+    BRKey *keys;
+    int *results;
+    const char **bip38Keys;
+    const char **passphrases;
+    size_t count;
+    BRAddressParams params;
+    unsigned scryptThreads;
+    pthread_mutex_t lock;
+    size_t next; // index of the next key to decrypt, guarded by lock
+} BRBIP38KeyBatch;
+
+static void *_BRBIP38KeyBatchThread(void *info)
+{
+    BRBIP38KeyBatch *batch = info;
+    size_t i;
+    
+    while (1) {
+        pthread_mutex_lock(&batch->lock);
+        i = batch->next;
+        if (i < batch->count) batch->next++;
+        pthread_mutex_unlock(&batch->lock);
+        if (i >= batch->count) break;
+        
+        batch->results[i] = _BRKeySetBIP38Key(&batch->keys[i], batch->bip38Keys[i], batch->passphrases[i],
+                                              batch->params, batch->scryptThreads);
+    }
+    
+    return NULL;
+}
+
+// decrypts count BIP38 keys, as with BRKeySetBIP38Key(), spread over up to threadCount threads, or one per processor
+// if threadCount is 0; results[i] is set to 1 if keys[i] was decrypted, or 0 if its passphrase is incorrect
+// each thread uses one 16MB scrypt buffer, so memory is bounded by threadCount regardless of count
+// returns the number of keys decrypted
+size_t BRKeySetBIP38Keys(BRKey keys[], int results[], const char *bip38Keys[], const char *passphrases[], size_t count,
+                         BRAddressParams params, unsigned threadCount)
+{
+    BRBIP38KeyBatch batch = { keys, results, bip38Keys, passphrases, count, params, 1, PTHREAD_MUTEX_INITIALIZER, 0 };
+    size_t i, decrypted = 0;
+    
+    assert(keys != NULL || count == 0);
+    assert(results != NULL || count == 0);
+    assert(bip38Keys != NULL || count == 0);
+    assert(passphrases != NULL || count == 0);
+    
+    if (threadCount == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = (processors > 0) ? (unsigned)processors : 1;
+    }
+    
+    // one key per thread, and when there are fewer keys than threads, the spare threads run scrypt lanes; either way
+    // each thread holds a single scrypt buffer, so memory is bounded by threadCount, not count
+    size_t workerCount = (count < threadCount) ? count : threadCount;
+    pthread_t threads[workerCount + 1];
+    int started[workerCount + 1];
+    pthread_attr_t attr;
+    
+    if (workerCount > 0) batch.scryptThreads = threadCount/(unsigned)workerCount;
+    for (i = 0; i < workerCount; i++) started[i] = 0;
+    
+    if (workerCount > 1 && pthread_attr_init(&attr) == 0) {
+        if (pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE) == 0) {
+            for (i = 1; i < workerCount; i++) {
+                started[i] = (pthread_create(&threads[i], &attr, _BRBIP38KeyBatchThread, &batch) == 0);
+            }
+        }
+        
+        pthread_attr_destroy(&attr);
+    }
+    
+    _BRBIP38KeyBatchThread(&batch); // the calling thread takes keys too, and finishes any left by failed threads
+    
+    for (i = 1; i < workerCount; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+    }
+    
+    pthread_mutex_destroy(&batch.lock);
+    for (i = 0; i < count; i++) if (results[i]) decrypted++;
+    return decrypted;
+}
+
 // generates an "intermediate code" for an EC multiply mode key
 // salt should be 64bits of random data
 // passphrase must be unicode NFC normalized
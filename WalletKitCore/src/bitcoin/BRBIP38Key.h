@@ -40,6 +40,13 @@ int BRBIP38KeyIsValid(const char *bip38Key);
 // passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
 int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params);
 
+// decrypts count BIP38 keys, as with BRKeySetBIP38Key(), spread over up to threadCount threads, or one per processor
+// if threadCount is 0; results[i] is set to 1 if keys[i] was decrypted, or 0 if its passphrase is incorrect
+// each thread uses one 16MB scrypt buffer, so memory is bounded by threadCount regardless of count
+// returns the number of keys decrypted
+size_t BRKeySetBIP38Keys(BRKey keys[], int results[], const char *bip38Keys[], const char *passphrases[], size_t count,
+                         BRAddressParams params, unsigned threadCount);
+
 // generates an "intermediate code" for an EC multiply mode key
 // salt should be 64bits of random data
 // passphrase must be unicode NFC normalized
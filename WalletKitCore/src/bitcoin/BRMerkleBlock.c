@@ -32,7 +32,6 @@
 #include <string.h>
 #include <assert.h>
 
-#define MAX_PROOF_OF_WORK 0x1d00ffff    // highest value for difficulty target (higher values are less difficult)
 #define TARGET_TIMESPAN   (14*24*60*60) // the targeted timespan between difficulty target adjustments
 
 inline static int _ceil_log2(int x)
@@ -273,7 +272,8 @@ static UInt256 _BRMerkleBlockRootR(const BRMerkleBlock *block, size_t *hashIdx,
 // true if merkle tree and timestamp are valid, and proof-of-work matches the stated difficulty target
 // NOTE: this only checks if the block difficulty matches the difficulty target in the header, it does not check if the
 // target is correct for the block's height in the chain - use BRMerkleBlockVerifyDifficulty() for that
-int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime)
+// maxProofOfWork is the chain's highest difficulty target, see BRChainParams
+int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime, uint32_t maxProofOfWork)
 {
     assert(block != NULL);
     
@@ -291,10 +291,15 @@ int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime)
     if (block->timestamp > currentTime + BLOCK_MAX_TIME_DRIFT) r = 0;
     
     // check if proof-of-work target is out of range
-    if (target == 0 || (block->target & 0x00800000) || block->target > MAX_PROOF_OF_WORK) r = 0;
+    if (target == 0 || (block->target & 0x00800000) || block->target > maxProofOfWork) r = 0;
     
-    if (size > 3) UInt32SetLE(&t.u8[size - 3], target);
-    else UInt32SetLE(t.u8, target >> (3 - size)*8);
+    // the 23 bit target is t.u8[size - 3] through t.u8[size - 1], bytes are set individually so that an out of range
+    // size can't write past the end of t
+    if (size > sizeof(t)) r = 0;
+
+    for (uint32_t i = 0; r && i < 3; i++) {
+        if (size + i >= 3) t.u8[size + i - 3] = (uint8_t)(target >> i*8);
+    }
     
     for (int i = sizeof(t) - 1; r && i >= 0; i--) { // check proof-of-work
         if (block->blockHash.u8[i] < t.u8[i]) break;
@@ -329,7 +334,7 @@ int BRMerkleBlockContainsTxHash(const BRMerkleBlock *block, UInt256 txHash)
 // multiplied by the time between the last transition block's timestamp and this one (in seconds), divided by the
 // targeted time between transitions (14*24*60*60 seconds). If the new difficulty is more than 4x or less than 1/4 of
 // the previous difficulty, the change is limited to either 4x or 1/4. There is also a minimum difficulty value
-// intuitively named MAX_PROOF_OF_WORK... since larger values are less difficult.
+// intuitively named BLOCK_MAX_PROOF_OF_WORK... since larger values are less difficult.
 int BRMerkleBlockVerifyDifficulty(const BRMerkleBlock *block, const BRMerkleBlock *previous, uint32_t transitionTime)
 {
     int size, r = 1;
@@ -361,7 +366,7 @@ int BRMerkleBlockVerifyDifficulty(const BRMerkleBlock *block, const BRMerkleBloc
         while (size < 1 || target > 0x007fffff) target >>= 8, size++; // normalize target for "compact" format
         target |= size << 24;
     
-        if (target > MAX_PROOF_OF_WORK) target = MAX_PROOF_OF_WORK; // limit to MAX_PROOF_OF_WORK
+        if (target > BLOCK_MAX_PROOF_OF_WORK) target = BLOCK_MAX_PROOF_OF_WORK; // limit to BLOCK_MAX_PROOF_OF_WORK
         if (block->target != target) r = 0;
     }
     else if (r && block->target != previous->target) r = 0;
@@ -36,6 +36,7 @@ extern "C" {
 #define BLOCK_DIFFICULTY_INTERVAL 2016 // number of blocks between difficulty target adjustments
 #define BLOCK_UNKNOWN_HEIGHT      INT32_MAX
 #define BLOCK_MAX_TIME_DRIFT      (2*60*60) // the furthest in the future a block is allowed to be timestamped
+#define BLOCK_MAX_PROOF_OF_WORK   0x1d00ffff // highest value for difficulty target (higher values are less difficult)
 
 typedef struct {
     UInt256 blockHash;
@@ -80,7 +81,8 @@ void BRMerkleBlockSetTxHashes(BRMerkleBlock *block, const UInt256 hashes[], size
 // true if merkle tree and timestamp are valid, and proof-of-work matches the stated difficulty target
 // NOTE: this only checks if the block difficulty matches the difficulty target in the header, it does not check if the
 // target is correct for the block's height in the chain - use BRMerkleBlockVerifyDifficulty() for that
-int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime);
+// maxProofOfWork is the chain's highest difficulty target, see BRChainParams
+int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime, uint32_t maxProofOfWork);
 
 // true if the given tx hash is known to be included in the block
 int BRMerkleBlockContainsTxHash(const BRMerkleBlock *block, UInt256 txHash);
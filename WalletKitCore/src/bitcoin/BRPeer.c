@@ -98,6 +98,7 @@ typedef enum {
 typedef struct {
     BRPeer peer; // superstruct on top of BRPeer
     uint32_t magicNumber;
+    uint32_t maxProofOfWork;
     char host[INET6_ADDRSTRLEN];
     BRPeerStatus status;
     int waitingForNetwork;
@@ -118,6 +119,7 @@ typedef struct {
     void (*disconnected)(void *info, int error);
     void (*relayedPeers)(void *info, const BRPeer peers[], size_t peersCount);
     void (*relayedTx)(void *info, BRTransaction *tx);
+    void (*relayedTxView)(void *info, const BRTransactionView *view);
     void (*hasTx)(void *info, UInt256 txHash);
     void (*rejectedTx)(void *info, UInt256 txHash, uint8_t code);
     void (*relayedBlock)(void *info, BRMerkleBlock *block);
@@ -415,27 +417,27 @@ static int _BRPeerAcceptInvMessage(BRPeer *peer, const uint8_t *msg, size_t msgL
 static int _BRPeerAcceptTxMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen)
 {
     BRPeerContext *ctx = (BRPeerContext *)peer;
-    BRTransaction *tx = BRTransactionParse(msg, msgLen);
+    BRTransactionView view;
     UInt256 txHash;
     int r = 1;
 
-    if (! tx) {
+    if (! BRTransactionViewInit(&view, msg, msgLen)) {
         peer_log(peer, "malformed tx message with length: %zu", msgLen);
         r = 0;
     }
     else if (! ctx->sentFilter && ! ctx->sentGetdata) {
         peer_log(peer, "got tx message before loading filter");
-        BRTransactionFree(tx);
         r = 0;
     }
     else {
-        txHash = tx->txHash;
+        txHash = view.txHash;
         peer_log(peer, "got tx: %s", u256hex(txHash));
 
-        if (ctx->relayedTx) {
-            ctx->relayedTx(ctx->info, tx);
+        // the tx is only parsed if the receiver wants it, a view callback can skip parsing of irrelevant tx
+        if (ctx->relayedTxView) {
+            ctx->relayedTxView(ctx->info, &view);
         }
-        else BRTransactionFree(tx);
+        else if (ctx->relayedTx) ctx->relayedTx(ctx->info, BRTransactionViewCreateTransaction(&view));
 
         if (ctx->currentBlock) { // we're collecting tx messages for a merkleblock
             for (size_t i = array_count(ctx->currentBlockTxHashes); i > 0; i--) {
@@ -502,7 +504,7 @@ static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t
                     peer_log(peer, "malformed headers message with length: %zu", msgLen);
                     r = 0;
                 }
-                else if (! BRMerkleBlockIsValid(block, (uint32_t)now)) {
+                else if (! BRMerkleBlockIsValid(block, (uint32_t)now, ctx->maxProofOfWork)) {
                     peer_log(peer, "invalid block header: %s", u256hex(block->blockHash));
                     BRMerkleBlockFree(block);
                     r = 0;
@@ -722,7 +724,7 @@ static int _BRPeerAcceptMerkleblockMessage(BRPeer *peer, const uint8_t *msg, siz
         peer_log(peer, "malformed merkleblock message with length: %zu", msgLen);
         r = 0;
     }
-    else if (! BRMerkleBlockIsValid(block, (uint32_t)time(NULL))) {
+    else if (! BRMerkleBlockIsValid(block, (uint32_t)time(NULL), ctx->maxProofOfWork)) {
         peer_log(peer, "invalid merkleblock: %s", u256hex(block->blockHash));
         BRMerkleBlockFree(block);
         block = NULL;
@@ -1126,6 +1128,7 @@ BRPeer *BRPeerNew(uint32_t magicNumber)
     
     assert(ctx != NULL);
     ctx->magicNumber = magicNumber;
+    ctx->maxProofOfWork = BLOCK_MAX_PROOF_OF_WORK;
     array_new(ctx->useragent, 40);
     array_new(ctx->knownBlockHashes, 10);
     array_new(ctx->currentBlockTxHashes, 10);
@@ -1194,12 +1197,25 @@ void BRPeerSetCallbacks(BRPeer *peer, void *info,
     ctx->threadCleanup = (threadCleanup) ? threadCleanup : _dummyThreadCleanup;
 }
 
+// void relayedTxView(void *, const BRTransactionView *) - called instead of relayedTx when a "tx" message is received
+// from peer, with a view of the message that is only valid during the call, so relevance can be checked before parsing
+void BRPeerSetRelayedTxViewCallback(BRPeer *peer, void (*relayedTxView)(void *info, const BRTransactionView *view))
+{
+    ((BRPeerContext *)peer)->relayedTxView = relayedTxView;
+}
+
 // set earliestKeyTime to wallet creation time in order to speed up initial sync
 void BRPeerSetEarliestKeyTime(BRPeer *peer, uint32_t earliestKeyTime)
 {
     ((BRPeerContext *)peer)->earliestKeyTime = earliestKeyTime;
 }
 
+// set maxProofOfWork to the chain's highest difficulty target, BLOCK_MAX_PROOF_OF_WORK by default
+void BRPeerSetMaxProofOfWork(BRPeer *peer, uint32_t maxProofOfWork)
+{
+    ((BRPeerContext *)peer)->maxProofOfWork = maxProofOfWork;
+}
+
 // call this when local block height changes (helps detect tarpit nodes)
 void BRPeerSetCurrentBlockHeight(BRPeer *peer, uint32_t currentBlockHeight)
 {
@@ -138,9 +138,16 @@ void BRPeerSetCallbacks(BRPeer *peer, void *info,
                         int (*networkIsReachable)(void *info),
                         void (*threadCleanup)(void *info));
 
+// void relayedTxView(void *, const BRTransactionView *) - called instead of relayedTx when a "tx" message is received
+// from peer, with a view of the message that is only valid during the call, so relevance can be checked before parsing
+void BRPeerSetRelayedTxViewCallback(BRPeer *peer, void (*relayedTxView)(void *info, const BRTransactionView *view));
+
 // set earliestKeyTime to wallet creation time in order to speed up initial sync
 void BRPeerSetEarliestKeyTime(BRPeer *peer, uint32_t earliestKeyTime);
 
+// set maxProofOfWork to the chain's highest difficulty target, BLOCK_MAX_PROOF_OF_WORK by default
+void BRPeerSetMaxProofOfWork(BRPeer *peer, uint32_t maxProofOfWork);
+
 // call this when local best block height changes (helps detect tarpit nodes)
 void BRPeerSetCurrentBlockHeight(BRPeer *peer, uint32_t currentBlockHeight);
 
@@ -23,6 +23,7 @@
 //  THE SOFTWARE.
 
 #include "BRPeerManager.h"
+#include "BRPeerManagerPrivate.h"
 #include "BRBloomFilter.h"
 #include "support/BRSet.h"
 #include "support/BRArray.h"
@@ -64,73 +65,197 @@ typedef struct {
     void (*callback)(void *info, int error);
 } BRPublishedTx;
 
-typedef struct {
-    UInt256 txHash;
-    BRPeer *peers;
-} BRTxPeerList;
+inline static size_t _BRTxPeerBitCount(uint64_t bits)
+{
+    size_t count = 0;
+    
+    for (; bits; bits &= bits - 1) count++;
+    return count;
+}
+
+// returns the slot assigned to peer, or TX_PEER_SLOTS if it has none
+static size_t _BRTxPeersSlot(const BRTxPeers *txPeers, const BRPeer *peer)
+{
+    for (size_t i = 0; i < TX_PEER_SLOTS; i++) {
+        if ((txPeers->slotsUsed & (1ULL << i)) != 0 && BRPeerEq(&txPeers->slots[i], peer)) return i;
+    }
+    
+    return TX_PEER_SLOTS;
+}
 
-// true if peer is contained in the list of peers associated with txHash
-static int _BRTxPeerListHasPeer(const BRTxPeerList *list, UInt256 txHash, const BRPeer *peer)
+// clears the bits for the given slots in all entries, and releases the slots
+static void _BRTxPeersReleaseSlots(BRTxPeers *txPeers, uint64_t slots)
 {
-    for (size_t i = array_count(list); i > 0; i--) {
-        if (! UInt256Eq(list[i - 1].txHash, txHash)) continue;
+    FOR_SET(BRTxPeerEntry *, entry, txPeers->entries) {
+        entry->peers[BRTxPeerRelays] &= ~slots;
+        entry->peers[BRTxPeerRequests] &= ~slots;
+    }
+    
+    txPeers->slotsUsed &= ~slots;
+    txPeers->slotsDisconnected &= ~slots;
+}
 
-        for (size_t j = array_count(list[i - 1].peers); j > 0; j--) {
-            if (BRPeerEq(&list[i - 1].peers[j - 1], peer)) return 1;
+// returns the slot assigned to peer, assigning one if needed, or TX_PEER_SLOTS if all slots belong to connected peers
+static size_t _BRTxPeersAddSlot(BRTxPeers *txPeers, const BRPeer *peer)
+{
+    size_t i = _BRTxPeersSlot(txPeers, peer);
+    uint64_t used = 0;
+    
+    if (i < TX_PEER_SLOTS) {
+        txPeers->slotsDisconnected &= ~(1ULL << i); // peer has reconnected
+        return i;
+    }
+    
+    if (txPeers->slotsUsed == UINT64_MAX) { // release slots of peers no longer referenced by any entry
+        FOR_SET(BRTxPeerEntry *, entry, txPeers->entries) {
+            used |= entry->peers[BRTxPeerRelays] | entry->peers[BRTxPeerRequests];
         }
         
-        break;
+        txPeers->slotsUsed = used;
+        txPeers->slotsDisconnected &= used;
     }
     
-    return 0;
+    if (txPeers->slotsUsed == UINT64_MAX && txPeers->slotsDisconnected != 0) { // reclaim a disconnected peer's slot
+        _BRTxPeersReleaseSlots(txPeers, txPeers->slotsDisconnected & (~txPeers->slotsDisconnected + 1));
+    }
+    
+    if (txPeers->slotsUsed == UINT64_MAX) return TX_PEER_SLOTS; // every slot belongs to a connected peer
+    
+    for (i = 0; (txPeers->slotsUsed & (1ULL << i)) != 0; i++);
+    txPeers->slots[i] = *peer;
+    txPeers->slotsUsed |= (1ULL << i);
+    return i;
 }
 
-// number of peers associated with txHash
-static size_t _BRTxPeerListCount(const BRTxPeerList *list, UInt256 txHash)
+// expires entries that have no peers, or that haven't been updated in TX_PEER_ENTRY_MAX_AGE, unless they're published
+static void _BRTxPeersSweep(BRTxPeers *txPeers, time_t now)
 {
-    for (size_t i = array_count(list); i > 0; i--) {
-        if (UInt256Eq(list[i - 1].txHash, txHash)) return array_count(list[i - 1].peers);
+    BRTxPeerEntry **expired;
+    
+    array_new(expired, 100);
+    
+    FOR_SET(BRTxPeerEntry *, entry, txPeers->entries) {
+        if (entry->published > 0) continue;
+        if ((entry->peers[BRTxPeerRelays] | entry->peers[BRTxPeerRequests]) != 0 &&
+            entry->timestamp + TX_PEER_ENTRY_MAX_AGE >= now) continue;
+        array_add(expired, entry);
     }
     
-    return 0;
+    for (size_t i = 0; i < array_count(expired); i++) {
+        BRSetRemove(txPeers->entries, expired[i]);
+        free(expired[i]);
+    }
+    
+    array_free(expired);
+    txPeers->sweepTime = now;
 }
 
-// adds peer to the list of peers associated with txHash and returns the new total number of peers
-static size_t _BRTxPeerListAddPeer(BRTxPeerList **list, UInt256 txHash, const BRPeer *peer)
+// returns the entry for txHash, or NULL if there is none
+inline static BRTxPeerEntry *_BRTxPeersGet(const BRTxPeers *txPeers, UInt256 txHash)
 {
-    for (size_t i = array_count(*list); i > 0; i--) {
-        if (! UInt256Eq((*list)[i - 1].txHash, txHash)) continue;
-        
-        for (size_t j = array_count((*list)[i - 1].peers); j > 0; j--) {
-            if (BRPeerEq(&(*list)[i - 1].peers[j - 1], peer)) return array_count((*list)[i - 1].peers);
-        }
-        
-        array_add((*list)[i - 1].peers, *peer);
-        return array_count((*list)[i - 1].peers);
+    return BRSetGet(txPeers->entries, &txHash);
+}
+
+// returns the entry for txHash, adding one if needed
+static BRTxPeerEntry *_BRTxPeersAdd(BRTxPeers *txPeers, UInt256 txHash)
+{
+    BRTxPeerEntry *entry = BRSetGet(txPeers->entries, &txHash);
+    time_t now = time(NULL);
+    
+    if (! entry) {
+        if (txPeers->sweepTime + TX_PEER_SWEEP_INTERVAL < now) _BRTxPeersSweep(txPeers, now);
+        entry = calloc(1, sizeof(*entry));
+        assert(entry != NULL);
+        entry->txHash = txHash;
+        entry->timestamp = now;
+        BRSetAdd(txPeers->entries, entry);
     }
+    
+    return entry;
+}
 
-    array_add(*list, ((const BRTxPeerList) { txHash, NULL }));
-    array_new((*list)[array_count(*list) - 1].peers, PEER_MAX_CONNECTIONS);
-    array_add((*list)[array_count(*list) - 1].peers, *peer);
-    return 1;
+// true if peer is contained in the set of peers of the given kind associated with txHash
+int BRTxPeersHasPeer(const BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer)
+{
+    BRTxPeerEntry *entry = _BRTxPeersGet(txPeers, txHash);
+    size_t i = (entry) ? _BRTxPeersSlot(txPeers, peer) : TX_PEER_SLOTS;
+    
+    return (i < TX_PEER_SLOTS && (entry->peers[kind] & (1ULL << i)) != 0);
 }
 
-// removes peer from the list of peers associated with txHash, returns true if peer was found
-static int _BRTxPeerListRemovePeer(BRTxPeerList *list, UInt256 txHash, const BRPeer *peer)
+// number of peers of the given kind associated with txHash
+size_t BRTxPeersCount(const BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash)
 {
-    for (size_t i = array_count(list); i > 0; i--) {
-        if (! UInt256Eq(list[i - 1].txHash, txHash)) continue;
-        
-        for (size_t j = array_count(list[i - 1].peers); j > 0; j--) {
-            if (! BRPeerEq(&list[i - 1].peers[j - 1], peer)) continue;
-            array_rm(list[i - 1].peers, j - 1);
-            return 1;
-        }
-        
-        break;
+    BRTxPeerEntry *entry = _BRTxPeersGet(txPeers, txHash);
+    
+    return (entry) ? _BRTxPeerBitCount(entry->peers[kind]) : 0;
+}
+
+// adds peer to the set of peers of the given kind associated with txHash and returns the new total number of peers
+// if all slots belong to connected peers, peer is not added
+size_t BRTxPeersAddPeer(BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer)
+{
+    size_t i = _BRTxPeersAddSlot(txPeers, peer);
+    BRTxPeerEntry *entry = _BRTxPeersAdd(txPeers, txHash);
+    
+    if (i < TX_PEER_SLOTS) entry->peers[kind] |= (1ULL << i);
+    entry->timestamp = time(NULL);
+    return _BRTxPeerBitCount(entry->peers[kind]);
+}
+
+// removes peer from the set of peers of the given kind associated with txHash, returns true if peer was found
+int BRTxPeersRemovePeer(BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer)
+{
+    BRTxPeerEntry *entry = _BRTxPeersGet(txPeers, txHash);
+    size_t i = (entry) ? _BRTxPeersSlot(txPeers, peer) : TX_PEER_SLOTS;
+    int r = (i < TX_PEER_SLOTS && (entry->peers[kind] & (1ULL << i)) != 0);
+    
+    if (r) entry->peers[kind] &= ~(1ULL << i);
+    return r;
+}
+
+// removes peer from the sets of peers of the given kind for all tx
+void BRTxPeersRemovePeerAll(BRTxPeers *txPeers, BRTxPeerKind kind, const BRPeer *peer)
+{
+    size_t i = _BRTxPeersSlot(txPeers, peer);
+    
+    if (i == TX_PEER_SLOTS) return;
+    
+    FOR_SET(BRTxPeerEntry *, entry, txPeers->entries) {
+        entry->peers[kind] &= ~(1ULL << i);
     }
+}
+
+// marks the slot of a disconnected peer as reclaimable, its bits are kept until the slot is needed for another peer
+void BRTxPeersPeerDisconnected(BRTxPeers *txPeers, const BRPeer *peer)
+{
+    size_t i = _BRTxPeersSlot(txPeers, peer);
     
-    return 0;
+    if (i < TX_PEER_SLOTS) txPeers->slotsDisconnected |= (1ULL << i);
+}
+
+// hash and equality for BRTxPeerEntry items, which start with their txHash
+inline static size_t _BRTxPeerEntryHash(const void *entry)
+{
+    return (size_t)((const BRTxPeerEntry *)entry)->txHash.u32[0];
+}
+
+inline static int _BRTxPeerEntryEq(const void *entry, const void *otherEntry)
+{
+    return UInt256Eq(((const BRTxPeerEntry *)entry)->txHash, ((const BRTxPeerEntry *)otherEntry)->txHash);
+}
+
+void BRTxPeersInit(BRTxPeers *txPeers)
+{
+    txPeers->entries = BRSetNew(_BRTxPeerEntryHash, _BRTxPeerEntryEq, 100);
+    txPeers->slotsUsed = 0;
+    txPeers->slotsDisconnected = 0;
+    txPeers->sweepTime = time(NULL);
+}
+
+void BRTxPeersFree(BRTxPeers *txPeers)
+{
+    BRSetFreeAll(txPeers->entries, free);
 }
 
 // comparator for sorting peers by timestamp, most recent first
@@ -177,9 +302,10 @@ struct BRPeerManagerStruct {
     double fpRate, averageTxPerBlock;
     BRSet *blocks, *orphans, *checkpoints;
     BRMerkleBlock *lastBlock, *lastOrphan;
-    BRTxPeerList *txRelays, *txRequests;
+    BRTxPeers txPeers;
     BRPublishedTx *publishedTx;
     UInt256 *publishedTxHashes;
+    size_t publishedCallbackCount; // number of publishedTx with a pending callback
     void *info;
     void (*syncStarted)(void *info);
     void (*syncStopped)(void *info, int error);
@@ -205,16 +331,32 @@ static void _BRPeerManagerPeerMisbehavin(BRPeerManager *manager, BRPeer *peer)
     BRPeerDisconnect(peer);
 }
 
+// returns the index in publishedTx of the tx with txHash, or SIZE_MAX if it isn't published
+static size_t _BRPeerManagerPublishedTxIndex(BRPeerManager *manager, UInt256 txHash)
+{
+    BRTxPeerEntry *entry = _BRTxPeersGet(&manager->txPeers, txHash);
+
+    return (entry && entry->published > 0) ? entry->published - 1 : SIZE_MAX;
+}
+
+// clears the callback of the published tx at index i and returns the published tx as it was before
+static BRPublishedTx _BRPeerManagerTakePublishedTx(BRPeerManager *manager, size_t i)
+{
+    BRPublishedTx pubTx = manager->publishedTx[i];
+
+    if (pubTx.callback != NULL) manager->publishedCallbackCount--;
+    manager->publishedTx[i].callback = NULL;
+    manager->publishedTx[i].info = NULL;
+    return pubTx;
+}
+
 static void _BRPeerManagerSyncStopped(BRPeerManager *manager)
 {
     manager->syncStartHeight = 0;
 
     if (manager->downloadPeer) {
         // don't cancel timeout if there's a pending tx publish callback
-        for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
-            if (manager->publishedTx[i - 1].callback != NULL) return;
-        }
-    
+        if (manager->publishedCallbackCount > 0) return;
         BRPeerScheduleDisconnect(manager->downloadPeer, -1); // cancel sync timeout
     }
 }
@@ -224,12 +366,11 @@ static void _BRPeerManagerAddTxToPublishList(BRPeerManager *manager, BRTransacti
                                              void (*callback)(void *, int))
 {
     if (tx && tx->blockHeight == TX_UNCONFIRMED) {
-        for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
-            if (BRTransactionEq(manager->publishedTx[i - 1].tx, tx)) return;
-        }
-        
+        if (_BRPeerManagerPublishedTxIndex(manager, tx->txHash) != SIZE_MAX) return;
+        _BRTxPeersAdd(&manager->txPeers, tx->txHash)->published = array_count(manager->publishedTx) + 1;
         array_add(manager->publishedTx, ((const BRPublishedTx) { tx, info, callback }));
         array_add(manager->publishedTxHashes, tx->txHash);
+        if (callback != NULL) manager->publishedCallbackCount++;
 
         for (size_t i = 0; i < tx->inCount; i++) {
             _BRPeerManagerAddTxToPublishList(manager, BRWalletTransactionForHash(manager->wallet, tx->inputs[i].txHash),
@@ -446,7 +587,7 @@ static void _requestUnrelayedTxGetdataDone(void *info, int success)
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     int isPublishing;
-    size_t count = 0;
+    size_t j, count = 0;
 
     free(info);
     pthread_mutex_lock(&manager->lock);
@@ -471,20 +612,17 @@ static void _requestUnrelayedTxGetdataDone(void *info, int success)
 
         for (size_t i = txCount; i > 0; i--) {
             hash = tx[i - 1]->txHash;
-            isPublishing = 0;
-            
-            for (size_t j = array_count(manager->publishedTx); ! isPublishing && j > 0; j--) {
-                if (BRTransactionEq(manager->publishedTx[j - 1].tx, tx[i - 1]) &&
-                    manager->publishedTx[j - 1].callback != NULL) isPublishing = 1;
-            }
+            j = _BRPeerManagerPublishedTxIndex(manager, hash);
+            isPublishing = (j != SIZE_MAX && manager->publishedTx[j].callback != NULL);
             
-            if (! isPublishing && _BRTxPeerListCount(manager->txRelays, hash) == 0 &&
-                _BRTxPeerListCount(manager->txRequests, hash) == 0) {
+            if (! isPublishing && BRTxPeersCount(&manager->txPeers, BRTxPeerRelays, hash) == 0 &&
+                BRTxPeersCount(&manager->txPeers, BRTxPeerRequests, hash) == 0) {
                 peer_log(peer, "removing tx unconfirmed at: %d, txHash: %s", manager->lastBlock->height, u256hex(hash));
                 assert(tx[i - 1]->blockHeight == TX_UNCONFIRMED);
                 BRWalletRemoveTransaction(manager->wallet, hash);
             }
-            else if (! isPublishing && _BRTxPeerListCount(manager->txRelays, hash) < manager->maxConnectCount) {
+            else if (! isPublishing &&
+                     BRTxPeersCount(&manager->txPeers, BRTxPeerRelays, hash) < manager->maxConnectCount) {
                 // set timestamp 0 to mark as unverified
                 BRWalletUpdateTransactions(manager->wallet, &hash, 1, TX_UNCONFIRMED, 0);
             }
@@ -504,10 +642,10 @@ static void _BRPeerManagerRequestUnrelayedTx(BRPeerManager *manager, BRPeer *pee
     txCount = BRWalletTxUnconfirmedBefore(manager->wallet, tx, txCount, TX_UNCONFIRMED);
     
     for (size_t i = 0; i < txCount; i++) {
-        if (! _BRTxPeerListHasPeer(manager->txRelays, tx[i]->txHash, peer) &&
-            ! _BRTxPeerListHasPeer(manager->txRequests, tx[i]->txHash, peer)) {
+        if (! BRTxPeersHasPeer(&manager->txPeers, BRTxPeerRelays, tx[i]->txHash, peer) &&
+            ! BRTxPeersHasPeer(&manager->txPeers, BRTxPeerRequests, tx[i]->txHash, peer)) {
             txHashes[hashCount++] = tx[i]->txHash;
-            _BRTxPeerListAddPeer(&manager->txRequests, tx[i]->txHash, peer);
+            BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRequests, tx[i]->txHash, peer);
         }
     }
 
@@ -527,11 +665,7 @@ static void _BRPeerManagerRequestUnrelayedTx(BRPeerManager *manager, BRPeer *pee
 
 static void _BRPeerManagerPublishPendingTx(BRPeerManager *manager, BRPeer *peer)
 {
-    for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
-        if (manager->publishedTx[i - 1].callback == NULL) continue;
-        BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // schedule publish timeout
-        break;
-    }
+    if (manager->publishedCallbackCount > 0) BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // publish timeout
     
     BRPeerSendInv(peer, manager->publishedTxHashes, array_count(manager->publishedTxHashes));
 }
@@ -800,7 +934,6 @@ static void _peerDisconnected(void *info, int error)
 {
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
-    BRTxPeerList *peerList;
     int willSave = 0, willReconnect = 0, txError = 0;
     size_t txCount = 0;
     
@@ -825,13 +958,8 @@ static void _peerDisconnected(void *info, int error)
                                    array_count(manager->connectedPeers) == 1)) txError = ETIMEDOUT;
     }
     
-    for (size_t i = array_count(manager->txRelays); i > 0; i--) {
-        peerList = &manager->txRelays[i - 1];
-
-        for (size_t j = array_count(peerList->peers); j > 0; j--) {
-            if (BRPeerEq(&peerList->peers[j - 1], peer)) array_rm(peerList->peers, j - 1);
-        }
-    }
+    BRTxPeersRemovePeerAll(&manager->txPeers, BRTxPeerRelays, peer);
+    BRTxPeersPeerDisconnected(&manager->txPeers, peer);
 
     if (peer == manager->downloadPeer) { // download peer disconnected
         manager->isConnected = 0;
@@ -854,9 +982,7 @@ static void _peerDisconnected(void *info, int error)
         for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
             if (manager->publishedTx[i - 1].callback == NULL) continue;
             peer_log(peer, "transaction canceled: %s", strerror(txError));
-            pubTx[txCount++] = manager->publishedTx[i - 1];
-            manager->publishedTx[i - 1].callback = NULL;
-            manager->publishedTx[i - 1].info = NULL;
+            pubTx[txCount++] = _BRPeerManagerTakePublishedTx(manager, i - 1);
         }
     }
     
@@ -909,40 +1035,47 @@ static void _peerRelayedPeers(void *info, const BRPeer peers[], size_t peersCoun
         manager->savePeers) manager->savePeers(manager->info, 1, save, peersCount);
 }
 
-static void _peerRelayedTx(void *info, BRTransaction *tx)
+// handles a tx relayed by peer, given either as a parsed tx or as a view of the serialized tx that is only parsed if
+// the wallet is interested in it
+static void _BRPeerManagerRelayedTx(BRPeerCallbackInfo *info, BRTransaction *tx, const BRTransactionView *view)
 {
-    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
-    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
-    void *txInfo = NULL;
-    void (*txCallback)(void *, int) = NULL;
+    BRPeer *peer = info->peer;
+    BRPeerManager *manager = info->manager;
+    UInt256 txHash = (tx) ? tx->txHash : view->txHash;
+    BRPublishedTx pubTx = { NULL, NULL, NULL };
     int isWalletTx = 0, hasPendingCallbacks = 0;
-    size_t relayCount = 0;
+    size_t i, relayCount = 0;
     
     pthread_mutex_lock(&manager->lock);
-    peer_log(peer, "relayed tx: %s", u256hex(tx->txHash));
+    peer_log(peer, "relayed tx: %s", u256hex(txHash));
+    i = _BRPeerManagerPublishedTxIndex(manager, txHash);
     
-    for (size_t i = array_count(manager->publishedTx); i > 0; i--) { // see if tx is in list of published tx
-        if (UInt256Eq(manager->publishedTxHashes[i - 1], tx->txHash)) {
-            txInfo = manager->publishedTx[i - 1].info;
-            txCallback = manager->publishedTx[i - 1].callback;
-            manager->publishedTx[i - 1].info = NULL;
-            manager->publishedTx[i - 1].callback = NULL;
-            relayCount = _BRTxPeerListAddPeer(&manager->txRelays, tx->txHash, peer);
-        }
-        else if (manager->publishedTx[i - 1].callback != NULL) hasPendingCallbacks = 1;
+    if (i != SIZE_MAX) { // tx is in list of published tx
+        pubTx = _BRPeerManagerTakePublishedTx(manager, i);
+        relayCount = BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRelays, txHash, peer);
     }
+    
+    hasPendingCallbacks = (manager->publishedCallbackCount > 0);
 
     // cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
     if (! hasPendingCallbacks && (manager->syncStartHeight == 0 || peer != manager->downloadPeer)) {
         BRPeerScheduleDisconnect(peer, -1); // cancel publish tx timeout
     }
 
-    if (manager->syncStartHeight == 0 || BRWalletContainsTransaction(manager->wallet, tx)) {
+    if (manager->syncStartHeight == 0 || ((tx) ? BRWalletContainsTransaction(manager->wallet, tx) :
+                                          BRWalletContainsTransactionView(manager->wallet, view))) {
+        if (! tx) tx = BRTransactionViewCreateTransaction(view);
         isWalletTx = BRWalletRegisterTransaction(manager->wallet, tx);
-        if (isWalletTx) tx = BRWalletTransactionForHash(manager->wallet, tx->txHash);
+
+        if (isWalletTx) { // a tx relayed again is a duplicate of the one the wallet already owns
+            BRTransaction *walletTx = BRWalletTransactionForHash(manager->wallet, tx->txHash);
+
+            if (walletTx != tx) BRTransactionFree(tx);
+            tx = walletTx;
+        }
     }
     else {
-        BRTransactionFree(tx);
+        if (tx) BRTransactionFree(tx);
         tx = NULL;
     }
     
@@ -958,9 +1091,11 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
 
         // keep track of how many peers have or relay a tx, this indicates how likely the tx is to confirm
         // (we only need to track this after syncing is complete)
-        if (manager->syncStartHeight == 0) relayCount = _BRTxPeerListAddPeer(&manager->txRelays, tx->txHash, peer);
+        if (manager->syncStartHeight == 0) {
+            relayCount = BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRelays, tx->txHash, peer);
+        }
         
-        _BRTxPeerListRemovePeer(manager->txRequests, tx->txHash, peer);
+        BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRequests, tx->txHash, peer);
         
         if (manager->bloomFilter != NULL) { // check if bloom filter is already being updated
             BRAddress addrs[SEQUENCE_GAP_LIMIT_EXTERNAL + SEQUENCE_GAP_LIMIT_INTERNAL];
@@ -988,7 +1123,17 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
     }
     
     pthread_mutex_unlock(&manager->lock);
-    if (txCallback) txCallback(txInfo, 0);
+    if (pubTx.callback) pubTx.callback(pubTx.info, 0);
+}
+
+static void _peerRelayedTx(void *info, BRTransaction *tx)
+{
+    _BRPeerManagerRelayedTx(info, tx, NULL);
+}
+
+static void _peerRelayedTxView(void *info, const BRTransactionView *view)
+{
+    _BRPeerManagerRelayedTx(info, NULL, view);
 }
 
 static void _peerHasTx(void *info, UInt256 txHash)
@@ -998,23 +1143,21 @@ static void _peerHasTx(void *info, UInt256 txHash)
     BRTransaction *tx;
     BRPublishedTx pubTx = { NULL, NULL, NULL };
     int isWalletTx = 0, hasPendingCallbacks = 0;
-    size_t relayCount = 0;
+    size_t i, relayCount = 0;
     
     pthread_mutex_lock(&manager->lock);
     tx = BRWalletTransactionForHash(manager->wallet, txHash);
     peer_log(peer, "has tx: %s", u256hex(txHash));
+    i = _BRPeerManagerPublishedTxIndex(manager, txHash);
 
-    for (size_t i = array_count(manager->publishedTx); i > 0; i--) { // see if tx is in list of published tx
-        if (UInt256Eq(manager->publishedTxHashes[i - 1], txHash)) {
-            pubTx = manager->publishedTx[i - 1];
-            if (! tx) tx = pubTx.tx;
-            manager->publishedTx[i - 1].callback = NULL;
-            manager->publishedTx[i - 1].info = NULL;
-            relayCount = _BRTxPeerListAddPeer(&manager->txRelays, txHash, peer);
-        }
-        else if (manager->publishedTx[i - 1].callback != NULL) hasPendingCallbacks = 1;
+    if (i != SIZE_MAX) { // tx is in list of published tx
+        pubTx = _BRPeerManagerTakePublishedTx(manager, i);
+        if (! tx) tx = pubTx.tx;
+        relayCount = BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRelays, txHash, peer);
     }
     
+    hasPendingCallbacks = (manager->publishedCallbackCount > 0);
+    
     // cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
     if (! hasPendingCallbacks && (manager->syncStartHeight == 0 || peer != manager->downloadPeer)) {
         BRPeerScheduleDisconnect(peer, -1); // cancel publish tx timeout
@@ -1031,14 +1174,16 @@ static void _peerHasTx(void *info, UInt256 txHash)
         
         // keep track of how many peers have or relay a tx, this indicates how likely the tx is to confirm
         // (we only need to track this after syncing is complete)
-        if (manager->syncStartHeight == 0) relayCount = _BRTxPeerListAddPeer(&manager->txRelays, txHash, peer);
+        if (manager->syncStartHeight == 0) {
+            relayCount = BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRelays, txHash, peer);
+        }
 
         // set timestamp when tx is verified
         if (relayCount >= manager->maxConnectCount && tx && tx->blockHeight == TX_UNCONFIRMED && tx->timestamp == 0) {
             BRWalletUpdateTransactions(manager->wallet, &txHash, 1, TX_UNCONFIRMED, (uint32_t)time(NULL));
         }
 
-        _BRTxPeerListRemovePeer(manager->txRequests, txHash, peer);
+        BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRequests, txHash, peer);
     }
     
     pthread_mutex_unlock(&manager->lock);
@@ -1054,10 +1199,11 @@ static void _peerRejectedTx(void *info, UInt256 txHash, uint8_t code)
     pthread_mutex_lock(&manager->lock);
     peer_log(peer, "rejected tx: %s", u256hex(txHash));
     tx = BRWalletTransactionForHash(manager->wallet, txHash);
-    _BRTxPeerListRemovePeer(manager->txRequests, txHash, peer);
+    BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRequests, txHash, peer);
 
     if (tx) {
-        if (_BRTxPeerListRemovePeer(manager->txRelays, txHash, peer) && tx->blockHeight == TX_UNCONFIRMED) {
+        if (BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRelays, txHash, peer) &&
+            tx->blockHeight == TX_UNCONFIRMED) {
             // set timestamp 0 to mark tx as unverified
             BRWalletUpdateTransactions(manager->wallet, &txHash, 1, TX_UNCONFIRMED, 0);
         }
@@ -1424,8 +1570,8 @@ static void _peerDataNotfound(void *info, const UInt256 txHashes[], size_t txCou
     pthread_mutex_lock(&manager->lock);
 
     for (size_t i = 0; i < txCount; i++) {
-        _BRTxPeerListRemovePeer(manager->txRelays, txHashes[i], peer);
-        _BRTxPeerListRemovePeer(manager->txRequests, txHashes[i], peer);
+        BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRelays, txHashes[i], peer);
+        BRTxPeersRemovePeer(&manager->txPeers, BRTxPeerRequests, txHashes[i], peer);
     }
 
     pthread_mutex_unlock(&manager->lock);
@@ -1460,24 +1606,19 @@ static BRTransaction *_peerRequestedTx(void *info, UInt256 txHash)
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     BRPublishedTx pubTx = { NULL, NULL, NULL };
     int hasPendingCallbacks = 0, error = 0;
+    size_t i;
 
     pthread_mutex_lock(&manager->lock);
-
-    for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
-        if (UInt256Eq(manager->publishedTxHashes[i - 1], txHash)) {
-            pubTx = manager->publishedTx[i - 1];
-            manager->publishedTx[i - 1].callback = NULL;
-            manager->publishedTx[i - 1].info = NULL;
-        }
-        else if (manager->publishedTx[i - 1].callback != NULL) hasPendingCallbacks = 1;
-    }
+    i = _BRPeerManagerPublishedTxIndex(manager, txHash);
+    if (i != SIZE_MAX) pubTx = _BRPeerManagerTakePublishedTx(manager, i);
+    hasPendingCallbacks = (manager->publishedCallbackCount > 0);
 
     // cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
     if (! hasPendingCallbacks && (manager->syncStartHeight == 0 || peer != manager->downloadPeer)) {
         BRPeerScheduleDisconnect(peer, -1); // cancel publish tx timeout
     }
 
-    _BRTxPeerListAddPeer(&manager->txRelays, txHash, peer);
+    BRTxPeersAddPeer(&manager->txPeers, BRTxPeerRelays, txHash, peer);
     if (pubTx.tx) BRWalletRegisterTransaction(manager->wallet, pubTx.tx);
     if (pubTx.tx && ! BRWalletTransactionIsValid(manager->wallet, pubTx.tx)) error = EINVAL;
     pthread_mutex_unlock(&manager->lock);
@@ -1568,8 +1709,7 @@ BRPeerManager *BRPeerManagerNew(const BRChainParams *params, BRWallet *wallet, u
 
     _peer_log("BPM: initialized with %u last block height", manager->lastBlock->height);
 
-    array_new(manager->txRelays, 10);
-    array_new(manager->txRequests, 10);
+    BRTxPeersInit(&manager->txPeers);
     array_new(manager->publishedTx, 10);
     array_new(manager->publishedTxHashes, 10);
     pthread_mutex_init(&manager->lock, NULL);
@@ -1699,12 +1839,14 @@ void BRPeerManagerConnect(BRPeerManager *manager)
                 info->manager = manager;
                 info->peer = BRPeerNew(manager->params->magicNumber);
                 *info->peer = peers[i];
+                BRPeerSetMaxProofOfWork(info->peer, manager->params->maxProofOfWork);
                 array_rm(peers, i);
                 array_add(manager->connectedPeers, info->peer);
                 manager->peerThreadCount++;
                 BRPeerSetCallbacks(info->peer, info, _peerConnected, _peerDisconnected, _peerRelayedPeers,
                                    _peerRelayedTx, _peerHasTx, _peerRejectedTx, _peerRelayedBlock, _peerDataNotfound,
                                    _peerSetFeePerKb, _peerRequestedTx, _peerNetworkIsReachable, _peerThreadCleanup);
+                BRPeerSetRelayedTxViewCallback(info->peer, _peerRelayedTxView);
                 BRPeerSetEarliestKeyTime(info->peer, manager->earliestKeyTime);
                 BRPeerConnect(info->peer);
 
@@ -2049,12 +2191,7 @@ size_t BRPeerManagerRelayCount(BRPeerManager *manager, UInt256 txHash)
     assert(! UInt256IsZero(txHash));
     pthread_mutex_lock(&manager->lock);
     
-    for (size_t i = array_count(manager->txRelays); i > 0; i--) {
-        if (! UInt256Eq(manager->txRelays[i - 1].txHash, txHash)) continue;
-        count = array_count(manager->txRelays[i - 1].peers);
-        break;
-    }
-    
+    count = BRTxPeersCount(&manager->txPeers, BRTxPeerRelays, txHash);
     pthread_mutex_unlock(&manager->lock);
     return count;
 }
@@ -2078,10 +2215,7 @@ void BRPeerManagerFree(BRPeerManager *manager)
     BRSetApply(manager->orphans, NULL, _setApplyFreeBlock);
     BRSetFree(manager->orphans);
     BRSetFree(manager->checkpoints);
-    for (size_t i = array_count(manager->txRelays); i > 0; i--) array_free(manager->txRelays[i - 1].peers);
-    array_free(manager->txRelays);
-    for (size_t i = array_count(manager->txRequests); i > 0; i--) array_free(manager->txRequests[i - 1].peers);
-    array_free(manager->txRequests);
+    BRTxPeersFree(&manager->txPeers);
 
     for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
         tx = manager->publishedTx[i - 1].tx;
@@ -0,0 +1,91 @@
+//
+//  BRPeerManagerPrivate.h
+//
+//  Copyright (c) 2015 breadwallet LLC.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRPeerManagerPrivate_h
+#define BRPeerManagerPrivate_h
+
+#include "BRPeer.h"
+#include "support/BRSet.h"
+#include "support/BRInt.h"
+#include <stddef.h>
+#include <inttypes.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// index of the peers that have relayed, or been asked for, each tx the peer manager knows about
+
+#define TX_PEER_SLOTS              64 // max number of distinct peers tracked at once, one bit each in BRTxPeerEntry
+#define TX_PEER_ENTRY_MAX_AGE      (24*60*60) // entries of tx not relayed or requested for this long are expired
+#define TX_PEER_SWEEP_INTERVAL     (60*60)
+
+typedef enum {
+    BRTxPeerRelays = 0, // peers that have relayed a tx
+    BRTxPeerRequests = 1 // peers a tx has been requested from
+} BRTxPeerKind;
+
+typedef struct {
+    UInt256 txHash;
+    uint64_t peers[2]; // bitsets of BRTxPeers slots, indexed by BRTxPeerKind
+    size_t published; // one more than the index of the tx in publishedTx, or 0 if it isn't published
+    time_t timestamp; // last time a peer was added, for expiry
+} BRTxPeerEntry;
+
+typedef struct {
+    BRSet *entries; // BRTxPeerEntry items indexed by txHash
+    BRPeer slots[TX_PEER_SLOTS];
+    uint64_t slotsUsed;
+    uint64_t slotsDisconnected; // slots of disconnected peers, which may be reclaimed when all slots are in use
+    time_t sweepTime;
+} BRTxPeers;
+
+void BRTxPeersInit(BRTxPeers *txPeers);
+
+// adds peer to the set of peers of the given kind associated with txHash and returns the new total number of peers
+// if all slots belong to connected peers, peer is not added
+size_t BRTxPeersAddPeer(BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer);
+
+// true if peer is contained in the set of peers of the given kind associated with txHash
+int BRTxPeersHasPeer(const BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer);
+
+// number of peers of the given kind associated with txHash
+size_t BRTxPeersCount(const BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash);
+
+// removes peer from the set of peers of the given kind associated with txHash, returns true if peer was found
+int BRTxPeersRemovePeer(BRTxPeers *txPeers, BRTxPeerKind kind, UInt256 txHash, const BRPeer *peer);
+
+// removes peer from the sets of peers of the given kind for all tx
+void BRTxPeersRemovePeerAll(BRTxPeers *txPeers, BRTxPeerKind kind, const BRPeer *peer);
+
+// marks the slot of a disconnected peer as reclaimable, its bits are kept until the slot is needed for another peer
+void BRTxPeersPeerDisconnected(BRTxPeers *txPeers, const BRPeer *peer);
+
+void BRTxPeersFree(BRTxPeers *txPeers);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BRPeerManagerPrivate_h
@@ -85,16 +85,49 @@ struct BRSyncManagerStruct {
 
 /// MARK: - Sync Manager Decls & Defs
 
-struct BRClientSyncManagerScanStateRecord {
+/**
+ * A window of a scan: addresses requested of the client together, in one request.  The windows
+ * are in the order that their addresses were derived; the first holds all the wallet's addresses
+ * when the scan starts.  Later windows may be speculative - beyond the gap limit, as known so far.
+ */
+typedef struct {
     int requestId;
-    BRAddress lastExternalAddress;
-    BRAddress lastInternalAddress;
-    BRSetOf(BRAddress *) knownAddresses;
+    uint8_t isComplete;
+} BRClientSyncManagerScanWindow;
+
+/**
+ * An address requested in a scan and the index of its window.  The address must be first; the
+ * set of these is hashed and compared with BRAddressHash() and BRAddressEq().
+ */
+typedef struct {
+    BRAddress address;
+    size_t window;
+} BRClientSyncManagerScanAddress;
+
+struct BRClientSyncManagerScanStateRecord {
+    BRArrayOf(BRClientSyncManagerScanWindow) windows;
+    BRSetOf(BRClientSyncManagerScanAddress *) knownAddresses;
+    size_t externalChainLength;     // the wallet's chain lengths when the scan starts
+    size_t internalChainLength;
     uint64_t begBlockNumber;
     uint64_t endBlockNumber;
     uint8_t isFullScan;
 };
 
+typedef enum {
+    SCAN_STATUS_INCOMPLETE,     // a window that the gap limit needs is in flight
+    SCAN_STATUS_EXTEND,         // the gap limit needs addresses not yet requested
+    SCAN_STATUS_COMPLETE        // the windows that the gap limit needs are complete
+} BRClientSyncManagerScanStatus;
+
+/**
+ * A window's request of the client, made outside of the manager's lock.
+ */
+typedef struct {
+    int rid;
+    BRArrayOf(char *) addresses;
+} BRClientSyncManagerScanRequest;
+
 typedef struct BRClientSyncManagerScanStateRecord *BRClientSyncManagerScanState;
 
 struct BRClientSyncManagerStruct {
@@ -180,6 +213,10 @@ struct BRClientSyncManagerStruct {
 
 typedef struct BRClientSyncManagerStruct * BRClientSyncManager;
 
+// When using a BRD sync, request the addresses of up to N windows beyond the gap limit, as known
+// so far, at once.  Thus a deep wallet is discovered in about 1/(N+1) of the round trips.
+#define BWM_BRD_SYNC_LOOKAHEAD_WINDOWS          3
+
 // When using a BRD sync, offset the start block by N days of Bitcoin blocks; the value of N is
 // assumed to be 'the maximum number of days that the blockchain DB could be behind'
 #define BWM_MINUTES_PER_BLOCK                   10              // assumed, bitcoin
@@ -271,16 +308,21 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager);
 static int
 BRClientSyncManagerGenerateRid (BRClientSyncManager manager);
 
+static BRArrayOf(BRClientSyncManagerScanRequest)
+BRClientSyncManagerScanExtend (BRClientSyncManager manager);
+
+static void
+BRClientSyncManagerScanRequestsRelease (BRArrayOf(BRClientSyncManagerScanRequest) requests);
+
 static void
 BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
                                   BRWallet *wallet,
-                                  int isBTC,
                                   uint64_t syncedBlockHeight,
-                                  uint64_t networkBlockHeight,
-                                  int rid);
+                                  uint64_t networkBlockHeight);
 
 static void
-BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState);
+BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState,
+                                  BRWallet *wallet);
 
 static int
 BRClientSyncManagerScanStateIsInProgress(BRClientSyncManagerScanState scanState);
@@ -289,7 +331,8 @@ static uint8_t
 BRClientSyncManagerScanStateIsFullScan (BRClientSyncManagerScanState scanState);
 
 static int
-BRClientSyncManagerScanStateGetRequestId(BRClientSyncManagerScanState scanState);
+BRClientSyncManagerScanStateFindWindow (BRClientSyncManagerScanState scanState,
+                                        int rid);
 
 static uint64_t
 BRClientSyncManagerScanStateGetStartBlockNumber(BRClientSyncManagerScanState scanState);
@@ -301,12 +344,16 @@ static uint64_t
 BRClientSyncManagerScanStateGetSyncedBlockNumber(BRClientSyncManagerScanState scanState);
 
 static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState);
+BRClientSyncManagerScanStateAddWindow (BRClientSyncManagerScanState scanState,
+                                       BRWallet *wallet,
+                                       int isBTC,
+                                       uint32_t gapMultiple,
+                                       int rid);
 
-static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (BRClientSyncManagerScanState scanState,
-                                                       BRWallet *wallet,
-                                                       int isBTC);
+static BRClientSyncManagerScanStatus
+BRClientSyncManagerScanStateCompleteWindow (BRClientSyncManagerScanState scanState,
+                                            BRWallet *wallet,
+                                            int window);
 
 /// MARK: - Peer Sync Manager Decls & Defs
 
@@ -459,15 +506,11 @@ _getWalletAddresses (BRWallet *wallet,
                      size_t *addressCount,
                      int isBTC);
 
-static void
-_fillWalletAddressSet(BRSetOf(BRAddress *) addresses,
-                      BRWallet *wallet,
-                      int isBTC);
-
 static BRArrayOf(BRAddress *)
-_updateWalletAddressSet(BRSetOf(BRAddress *) addresses,
+_updateWalletAddressSet(BRSetOf(BRClientSyncManagerScanAddress *) addresses,
                         BRWallet *wallet,
-                        int isBTC);
+                        int isBTC,
+                        size_t window);
 
 static uint32_t
 _calculateSyncDepthHeight(BRCryptoSyncDepth depth,
@@ -863,7 +906,7 @@ BRClientSyncManagerNew(BRSyncManagerEventContext eventContext,
 
     // the calloc will have taken care of this, but, better safe than sorry in case future dev
     // doesn't take that into account
-    BRClientSyncManagerScanStateWipe (&manager->scanState);
+    BRClientSyncManagerScanStateWipe (&manager->scanState, NULL);
 
     return manager;
 }
@@ -880,7 +923,7 @@ BRSyncManagerAsClientSyncManager(BRSyncManager manager) {
 static void
 BRClientSyncManagerFree(BRClientSyncManager manager) {
     if (0 == pthread_mutex_lock (&manager->lock)) {
-        BRClientSyncManagerScanStateWipe (&manager->scanState);
+        BRClientSyncManagerScanStateWipe (&manager->scanState, manager->wallet);
         pthread_mutex_unlock (&manager->lock);
     }
 
@@ -973,7 +1016,7 @@ BRClientSyncManagerDisconnect(BRClientSyncManager manager) {
             manager->isConnected = 0;
             needConnectionEvent = 1;
             needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
-            BRClientSyncManagerScanStateWipe (&manager->scanState);
+            BRClientSyncManagerScanStateWipe (&manager->scanState, manager->wallet);
         }
 
         // Send event while holding the state lock so that event
@@ -1020,7 +1063,7 @@ BRClientSyncManagerScanToDepth(BRClientSyncManager manager,
             // and then wipe the current scan state so that a new one will be
             // triggered.
             needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
-            BRClientSyncManagerScanStateWipe (&manager->scanState);
+            BRClientSyncManagerScanStateWipe (&manager->scanState, manager->wallet);
 
             // Reset the height that we've synced to (don't go behind and the initBlockHeight
             // and don't go past the current sync height so that we don't we miss transactions)
@@ -1199,7 +1242,7 @@ BRClientSyncManagerAnnounceGetTransactionsItem (BRClientSyncManager manager,
     if (needRegistration) {
         if (0 == pthread_mutex_lock (&manager->lock)) {
             // confirm completion is for in-progress sync
-            needRegistration &= (rid == BRClientSyncManagerScanStateGetRequestId (&manager->scanState) && manager->isConnected);
+            needRegistration &= (-1 != BRClientSyncManagerScanStateFindWindow (&manager->scanState, rid) && manager->isConnected);
             pthread_mutex_unlock (&manager->lock);
         } else {
             assert (0);
@@ -1288,52 +1331,51 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
                                                 int success) {
     uint8_t needSyncEvent        = 0;
     uint8_t needDiscEvent        = 0;
-    uint8_t needClientCall       = 0;
     uint64_t begBlockNumber      = 0;
     uint64_t endBlockNumber      = 0;
-    size_t addressCount          = 0;
-    BRArrayOf(char *) addresses  = NULL;
+    BRArrayOf(BRClientSyncManagerScanRequest) requests = NULL;
     BRSyncManagerEvent syncEvent = {0};
     BRSyncManagerEvent discEvent = {0};
 
     if (0 == pthread_mutex_lock (&manager->lock)) {
         // confirm completion is for in-progress sync
-        if (rid == BRClientSyncManagerScanStateGetRequestId (&manager->scanState) &&
-            manager->isConnected) {
+        int window = BRClientSyncManagerScanStateFindWindow (&manager->scanState, rid);
+        if (-1 != window && manager->isConnected) {
             // check for a successful completion
             if (success) {
-
-                // check if the first unused addresses have changed since last completion
-                addresses = BRClientSyncManagerConvertAddressToString
-                (manager,
-                 BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (&manager->scanState,
-                                                                        manager->wallet,
-                                                                        BRChainParamsIsBitcoin (manager->chainParams)));
-
-                addressCount = NULL != addresses ? array_count(addresses) : 0;
-                if (0 != addressCount) {
-                    // ... we've discovered a new address (i.e. there were transactions announce)
-
-                    // store sync data for callback outside of lock
-                    begBlockNumber = BRClientSyncManagerScanStateGetStartBlockNumber (&manager->scanState);
-                    endBlockNumber = BRClientSyncManagerScanStateGetEndBlockNumber (&manager->scanState);
-
-                    // store control flow flags
-                    needClientCall = 1;
-
-                } else {
-                    // .. we haven't discovered any new addresses and we just finished the range
-
-                    // store synced block height
-                    manager->syncedBlockHeight = BRClientSyncManagerScanStateGetSyncedBlockNumber (&manager->scanState);;
-
-                    // store control flow flags
-                    needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
-                    syncEvent = (BRSyncManagerEvent) {SYNC_MANAGER_SYNC_STOPPED, { .syncStopped = { cryptoSyncStoppedReasonComplete() } }};
-
-                    // reset sync state
-                    BRClientSyncManagerScanStateWipe (&manager->scanState);
-
+                switch (BRClientSyncManagerScanStateCompleteWindow (&manager->scanState,
+                                                                    manager->wallet,
+                                                                    window)) {
+                    case SCAN_STATUS_INCOMPLETE:
+                        // ... an earlier window is still in flight; its transactions might move
+                        // the gap limit.  Wait for it.
+                        break;
+
+                    case SCAN_STATUS_EXTEND:
+                        // ... we've discovered new addresses (i.e. there were transactions announced)
+                        // beyond those requested so far; requery the same range for them and for
+                        // the windows beyond them.
+                        requests = BRClientSyncManagerScanExtend (manager);
+
+                        // store sync data for callback outside of lock
+                        begBlockNumber = BRClientSyncManagerScanStateGetStartBlockNumber (&manager->scanState);
+                        endBlockNumber = BRClientSyncManagerScanStateGetEndBlockNumber (&manager->scanState);
+                        break;
+
+                    case SCAN_STATUS_COMPLETE:
+                        // .. we haven't discovered any new addresses and we just finished the range
+
+                        // store synced block height
+                        manager->syncedBlockHeight = BRClientSyncManagerScanStateGetSyncedBlockNumber (&manager->scanState);;
+
+                        // store control flow flags
+                        needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
+                        syncEvent = (BRSyncManagerEvent) {SYNC_MANAGER_SYNC_STOPPED, { .syncStopped = { cryptoSyncStoppedReasonComplete() } }};
+
+                        // reset sync state; any window still in flight is beyond the gap limit
+                        // and is cancelled - its transactions are ignored.
+                        BRClientSyncManagerScanStateWipe (&manager->scanState, manager->wallet);
+                        break;
                 }
             } else {
                 // transition to the disconnected state
@@ -1347,7 +1389,7 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
                 discEvent = (BRSyncManagerEvent) {SYNC_MANAGER_DISCONNECTED, { .disconnected = { cryptoWalletManagerDisconnectReasonUnknown() } }};
 
                 // reset sync state on failure
-                BRClientSyncManagerScanStateWipe (&manager->scanState);
+                BRClientSyncManagerScanStateWipe (&manager->scanState, manager->wallet);
             }
         }
 
@@ -1371,36 +1413,29 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
         assert (0);
     }
 
-    if (needClientCall) {
-        // Callback to 'client' to get all transactions (for all wallet addresses) between
+    if (NULL != requests) {
+        // Callback to 'client' to get all transactions (for each window's addresses) between
         // a {beg,end}BlockNumber.  The client will gather the transactions and then call
         // bwmAnnounceTransaction()  (for each one or with all of them).
-        manager->clientCallbacks.funcGetTransactions (manager->clientContext,
-                                                      BRClientSyncManagerAsSyncManager (manager),
-                                                      (const char **) addresses,
-                                                      addressCount,
-                                                      begBlockNumber,
-                                                      endBlockNumber,
-                                                      rid);
-    }
-
-    if (NULL != addresses) {
-        for (size_t index = 0; index < addressCount; index++) {
-            free (addresses[index]);
-        }
-        array_free (addresses);
+        for (size_t index = 0; index < array_count (requests); index++)
+            manager->clientCallbacks.funcGetTransactions (manager->clientContext,
+                                                          BRClientSyncManagerAsSyncManager (manager),
+                                                          (const char **) requests[index].addresses,
+                                                          array_count (requests[index].addresses),
+                                                          begBlockNumber,
+                                                          endBlockNumber,
+                                                          requests[index].rid);
+
+        BRClientSyncManagerScanRequestsRelease (requests);
     }
 }
 
 static void
 BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
-    int rid                      = 0;
     uint8_t needSyncEvent        = 0;
-    uint8_t needClientCall       = 0;
     uint64_t begBlockNumber      = 0;
     uint64_t endBlockNumber      = 0;
-    size_t addressCount          = 0;
-    BRArrayOf(char *) addresses  = NULL;
+    BRArrayOf(BRClientSyncManagerScanRequest) requests = NULL;
 
     if (0 == pthread_mutex_lock (&manager->lock)) {
         // check if we are connect and the prior sync has completed.
@@ -1409,27 +1444,20 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
 
             BRClientSyncManagerScanStateInit (&manager->scanState,
                                               manager->wallet,
-                                              BRChainParamsIsBitcoin (manager->chainParams),
                                               manager->syncedBlockHeight,
-                                              manager->networkBlockHeight,
-                                              BRClientSyncManagerGenerateRid (manager));
-
-            // get the addresses to query the BDB with
-            addresses = BRClientSyncManagerConvertAddressToString
-            (manager, BRClientSyncManagerScanStateGetAddresses (&manager->scanState));
+                                              manager->networkBlockHeight);
 
-            assert (NULL != addresses);
-            addressCount = array_count (addresses);
-            assert (0 != addressCount);
+            // get the windows of addresses to query the BDB with; the first holds all the
+            // wallet's addresses.
+            requests = BRClientSyncManagerScanExtend (manager);
+            assert (0 != array_count (requests));
 
             // store sync data for callback outside of lock
-            rid = BRClientSyncManagerScanStateGetRequestId (&manager->scanState);
             begBlockNumber = BRClientSyncManagerScanStateGetStartBlockNumber (&manager->scanState);
             endBlockNumber = BRClientSyncManagerScanStateGetEndBlockNumber (&manager->scanState);
 
             // store control flow flags
             needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
-            needClientCall = 1;
         }
 
         // Send event while holding the state lock so that event
@@ -1448,30 +1476,27 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
         assert (0);
     }
 
-    if (needClientCall) {
+    if (NULL != requests) {
         // We'll force the 'client' to return all transactions w/o regard to the `endBlockNumber`
         // Doing this ensures that the initial 'full-sync' returns everything.  Thus there is no
         // need to wait for a future 'tick tock' to get the recent and pending transactions'.  For
         // BTC the future 'tick tock' is minutes away; which is a burden on Users as they wait.
         endBlockNumber = BLOCK_HEIGHT_UNBOUND;
 
-        // Callback to 'client' to get all transactions (for all wallet addresses) between
+        // Callback to 'client' to get all transactions (for each window's addresses) between
         // a {beg,end}BlockNumber.  The client will gather the transactions and then call
-        // bwmAnnounceTransaction()  (for each one or with all of them).
-        manager->clientCallbacks.funcGetTransactions (manager->clientContext,
-                                                      BRClientSyncManagerAsSyncManager (manager),
-                                                      (const char **) addresses,
-                                                      addressCount,
-                                                      begBlockNumber,
-                                                      endBlockNumber,
-                                                      rid);
-    }
-
-    if (NULL != addresses) {
-        for (size_t index = 0; index < addressCount; index++) {
-            free (addresses[index]);
-        }
-        array_free (addresses);
+        // bwmAnnounceTransaction()  (for each one or with all of them).  The windows are
+        // requested concurrently.
+        for (size_t index = 0; index < array_count (requests); index++)
+            manager->clientCallbacks.funcGetTransactions (manager->clientContext,
+                                                          BRClientSyncManagerAsSyncManager (manager),
+                                                          (const char **) requests[index].addresses,
+                                                          array_count (requests[index].addresses),
+                                                          begBlockNumber,
+                                                          endBlockNumber,
+                                                          requests[index].rid);
+
+        BRClientSyncManagerScanRequestsRelease (requests);
     }
 }
 
@@ -1501,13 +1526,49 @@ BRClientSyncManagerGenerateRid (BRClientSyncManager manager) {
     return ++manager->requestIdGenerator;
 }
 
+/**
+ * Add the windows of the scan that are not yet requested: the addresses up to the gap limit, as
+ * known so far, and then up to BWM_BRD_SYNC_LOOKAHEAD_WINDOWS more gap limits beyond.  Return
+ * the requests to make, outside the lock, for the windows.  Must hold the manager's lock.
+ */
+static BRArrayOf(BRClientSyncManagerScanRequest)
+BRClientSyncManagerScanExtend (BRClientSyncManager manager) {
+    BRArrayOf(BRClientSyncManagerScanRequest) requests;
+    array_new (requests, 1 + BWM_BRD_SYNC_LOOKAHEAD_WINDOWS);
+
+    for (uint32_t gapMultiple = 1; gapMultiple <= 1 + BWM_BRD_SYNC_LOOKAHEAD_WINDOWS; gapMultiple++) {
+        int rid = BRClientSyncManagerGenerateRid (manager);
+
+        BRArrayOf(char *) addresses = BRClientSyncManagerConvertAddressToString
+        (manager,
+         BRClientSyncManagerScanStateAddWindow (&manager->scanState,
+                                                manager->wallet,
+                                                BRChainParamsIsBitcoin (manager->chainParams),
+                                                gapMultiple,
+                                                rid));
+
+        if (NULL != addresses)
+            array_add (requests, ((BRClientSyncManagerScanRequest) { rid, addresses }));
+    }
+
+    return requests;
+}
+
+static void
+BRClientSyncManagerScanRequestsRelease (BRArrayOf(BRClientSyncManagerScanRequest) requests) {
+    for (size_t index = 0; index < array_count (requests); index++) {
+        for (size_t aindex = 0; aindex < array_count (requests[index].addresses); aindex++)
+            free (requests[index].addresses[aindex]);
+        array_free (requests[index].addresses);
+    }
+    array_free (requests);
+}
+
 static void
 BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
                                   BRWallet *wallet,
-                                  int isBTC,
                                   uint64_t syncedBlockHeight,
-                                  uint64_t networkBlockHeight,
-                                  int rid) {
+                                  uint64_t networkBlockHeight) {
     // update the `endBlockNumber` to the current block height;
     // since this is exclusive on the end height, we need to increment by
     // one to make sure we get the last block
@@ -1522,37 +1583,47 @@ BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
     // check that we don't have an overflow
     assert (scanState->endBlockNumber > scanState->begBlockNumber);
 
-    // generate addresses
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
-
-    // save the last known external and internal addresses
-    BRWalletUnusedAddrs(wallet, &scanState->lastExternalAddress, 1, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs(wallet, &scanState->lastInternalAddress, 1, SEQUENCE_INTERNAL_CHAIN);
-
-    // save the current requestId
-    scanState->requestId = rid;
-
     // mark as sync or not
     scanState->isFullScan = ((scanState->endBlockNumber - scanState->begBlockNumber) > BWM_BRD_SYNC_START_BLOCK_OFFSET);
 
-    // build the set of initial wallet addresses
+    // no windows yet; see BRClientSyncManagerScanExtend()
+    assert (NULL == scanState->windows);
+    array_new (scanState->windows, 1 + BWM_BRD_SYNC_LOOKAHEAD_WINDOWS);
+
     assert (NULL == scanState->knownAddresses);
     scanState->knownAddresses = BRSetNew (BRAddressHash, BRAddressEq, SEQUENCE_GAP_LIMIT_INTERNAL + SEQUENCE_GAP_LIMIT_EXTERNAL);
-    _fillWalletAddressSet (scanState->knownAddresses, wallet, isBTC);
+
+    // the lookahead windows derive addresses past these; see BRClientSyncManagerScanStateWipe()
+    scanState->externalChainLength = BRWalletChainLength (wallet, SEQUENCE_EXTERNAL_CHAIN);
+    scanState->internalChainLength = BRWalletChainLength (wallet, SEQUENCE_INTERNAL_CHAIN);
 }
 
+/**
+ * Wipe the scan state.  If a scan was in progress, then remove from `wallet` the addresses that
+ * its lookahead windows derived beyond the gap limit and that turned out to be unused; otherwise
+ * every later scan would request them.  The wallet's chains are not trimmed below their length
+ * when the scan started.  The `wallet` is NULL if it is not to be touched.
+ */
 static void
-BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState) {
+BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState,
+                                  BRWallet *wallet) {
+    if (NULL != wallet && NULL != scanState->windows) {
+        BRWalletTrimUnusedAddrs (wallet, scanState->externalChainLength, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
+        BRWalletTrimUnusedAddrs (wallet, scanState->internalChainLength, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
+    }
+
     if (NULL != scanState->knownAddresses) {
         BRSetFreeAll (scanState->knownAddresses, free);
     }
+    if (NULL != scanState->windows) {
+        array_free (scanState->windows);
+    }
     memset (scanState, 0, sizeof(*scanState));
 }
 
 static int
 BRClientSyncManagerScanStateIsInProgress(BRClientSyncManagerScanState scanState) {
-    return 0 != scanState->requestId;
+    return NULL != scanState->windows;
 }
 
 static uint8_t
@@ -1560,9 +1631,20 @@ BRClientSyncManagerScanStateIsFullScan (BRClientSyncManagerScanState scanState)
     return scanState->isFullScan;
 }
 
+/**
+ * Return the index of the window requested with `rid`, or -1 if none.  A window is found only
+ * while its scan is in progress.
+ */
 static int
-BRClientSyncManagerScanStateGetRequestId(BRClientSyncManagerScanState scanState) {
-    return scanState->requestId;
+BRClientSyncManagerScanStateFindWindow (BRClientSyncManagerScanState scanState,
+                                        int rid) {
+    if (NULL == scanState->windows) return -1;
+
+    for (size_t index = 0; index < array_count (scanState->windows); index++)
+        if (rid == scanState->windows[index].requestId)
+            return (int) index;
+
+    return -1;
 }
 
 static uint64_t
@@ -1582,55 +1664,73 @@ BRClientSyncManagerScanStateGetSyncedBlockNumber(BRClientSyncManagerScanState sc
     return scanState->endBlockNumber - 1;
 }
 
+/**
+ * Derive the wallet's addresses up to `gapMultiple` gap limits past the last used addresses and
+ * add those not yet requested as a new window requested with `rid`.  Return the window's
+ * addresses; if none, then no window is added.
+ */
 static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState) {
-    size_t addressCount = BRSetCount(scanState->knownAddresses);
-
-    BRArrayOf(BRAddress *) addresses;
-    array_new (addresses, addressCount);
-    array_set_count (addresses, addressCount);
-
-    size_t index = 0;
-    FOR_SET (BRAddress *, knownAddress, scanState->knownAddresses) {
-        addresses[index] = malloc (sizeof(BRAddress));
-        *addresses[index] = *knownAddress;
-        index++;
+BRClientSyncManagerScanStateAddWindow (BRClientSyncManagerScanState scanState,
+                                       BRWallet *wallet,
+                                       int isBTC,
+                                       uint32_t gapMultiple,
+                                       int rid) {
+    // generate addresses
+    BRWalletUnusedAddrs (wallet, NULL, gapMultiple * SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletUnusedAddrs (wallet, NULL, gapMultiple * SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
+
+    // get the list of newly derived addresses
+    BRArrayOf(BRAddress *) newAddresses = _updateWalletAddressSet (scanState->knownAddresses,
+                                                                   wallet,
+                                                                   isBTC,
+                                                                   array_count (scanState->windows));
+
+    if (0 == array_count (newAddresses)) {
+        array_free (newAddresses);
+        return NULL;
     }
 
-    return addresses;
+    array_add (scanState->windows, ((BRClientSyncManagerScanWindow) { rid, 0 }));
+    return newAddresses;
 }
 
-static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (BRClientSyncManagerScanState scanState,
-                                                       BRWallet *wallet,
-                                                       int isBTC) {
-    BRArrayOf(BRAddress *) newAddresses = NULL;
-
-    // generate addresses
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
-
-    // get the first unused address
-    BRAddress externalAddress = BR_ADDRESS_NONE;
-    BRAddress internalAddress = BR_ADDRESS_NONE;
-    BRWalletUnusedAddrs (wallet, &externalAddress, 1, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs (wallet, &internalAddress, 1, SEQUENCE_INTERNAL_CHAIN);
-
-    // check if the first unused addresses have changed since last completion
-    if (!BRAddressEq (&externalAddress, &scanState->lastExternalAddress) ||
-        !BRAddressEq (&internalAddress, &scanState->lastInternalAddress)) {
-        // ... we've discovered a new address (i.e. there were transactions announce)
-        // so we need to requery the same range including the newly derived addresses
-
-        // store the first unused addresses for comparison in the next complete call
-        scanState->lastExternalAddress = externalAddress;
-        scanState->lastInternalAddress = internalAddress;
-
-        // get the list of newly discovered addresses
-        newAddresses = _updateWalletAddressSet (scanState->knownAddresses, wallet, isBTC);
+/**
+ * Mark `window` as complete and then determine if the scan is complete.  That requires every
+ * address up to the gap limit (the first unused addresses) to have been requested in a window
+ * and every window up to the last of those to be complete - the windows are in order of
+ * derivation, so any earlier window holds addresses before the gap limit.
+ */
+static BRClientSyncManagerScanStatus
+BRClientSyncManagerScanStateCompleteWindow (BRClientSyncManagerScanState scanState,
+                                            BRWallet *wallet,
+                                            int window) {
+    scanState->windows[window].isComplete = 1;
+
+    // get the first unused addresses, as of the transactions announced so far.  For BTC, the
+    // LEGACY addresses are always in the window of their SEGWIT address.
+    BRAddress externalAddresses[SEQUENCE_GAP_LIMIT_EXTERNAL];
+    BRAddress internalAddresses[SEQUENCE_GAP_LIMIT_INTERNAL];
+
+    size_t externalCount = BRWalletUnusedAddrs (wallet, externalAddresses, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
+    size_t internalCount = BRWalletUnusedAddrs (wallet, internalAddresses, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
+
+    size_t lastWindow = 0;
+    for (size_t index = 0; index < externalCount + internalCount; index++) {
+        BRAddress *address = (index < externalCount
+                              ? &externalAddresses[index]
+                              : &internalAddresses[index - externalCount]);
+
+        BRClientSyncManagerScanAddress *known = BRSetGet (scanState->knownAddresses, address);
+        if (NULL == known) return SCAN_STATUS_EXTEND;
+
+        lastWindow = MAX (lastWindow, known->window);
     }
 
-    return newAddresses;
+    for (size_t index = 0; index <= lastWindow; index++)
+        if (!scanState->windows[index].isComplete)
+            return SCAN_STATUS_INCOMPLETE;
+
+    return SCAN_STATUS_COMPLETE;
 }
 
 /// MARK: - Peer Sync Manager Implementation
@@ -2149,24 +2249,8 @@ _getWalletAddresses (BRWallet *wallet,size_t *addressCount, int isBTC) {
    return addrs;
 }
 
-static void
-_fillWalletAddressSet(BRSetOf(BRAddress *) addresses, BRWallet *wallet, int isBTC) {
-    size_t addressCount = 0;
-    BRAddress *addressArray = _getWalletAddresses (wallet, &addressCount, isBTC);
-
-    for (size_t index = 0; index < addressCount; index++) {
-        if (!BRSetContains (addresses, &addressArray[index])) {
-            BRAddress *address = malloc (sizeof(BRAddress));
-            *address = addressArray[index];
-            BRSetAdd (addresses, address);
-        }
-    }
-
-    free (addressArray);
-}
-
 static BRArrayOf(BRAddress *)
-_updateWalletAddressSet(BRSetOf(BRAddress *) addresses, BRWallet *wallet, int isBTC) {
+_updateWalletAddressSet(BRSetOf(BRClientSyncManagerScanAddress *) addresses, BRWallet *wallet, int isBTC, size_t window) {
     size_t addressCount = 0;
     BRAddress *addressArray = _getWalletAddresses (wallet, &addressCount, isBTC);
 
@@ -2175,13 +2259,14 @@ _updateWalletAddressSet(BRSetOf(BRAddress *) addresses, BRWallet *wallet, int is
 
     for (size_t index = 0; index < addressCount; index++) {
         if (!BRSetContains (addresses, &addressArray[index])) {
-            // one copy remains owned by the address set
-            BRAddress *address = malloc (sizeof(BRAddress));
-            *address = addressArray[index];
-            BRSetAdd (addresses, address);
+            // one copy remains owned by the address set, with its window
+            BRClientSyncManagerScanAddress *known = malloc (sizeof(BRClientSyncManagerScanAddress));
+            known->address = addressArray[index];
+            known->window  = window;
+            BRSetAdd (addresses, known);
 
             // one copy owned by the returned array
-            address = malloc (sizeof(BRAddress));
+            BRAddress *address = malloc (sizeof(BRAddress));
             *address = addressArray[index];
             array_add (newAddresses, address);
         }
@@ -36,6 +36,103 @@
 #define SIGHASH_ANYONECANPAY 0x80 // let other people add inputs, I don't care where the rest of the bitcoins come from
 #define SIGHASH_FORKID       0x40 // use BIP143 digest method (for b-cash/b-gold signatures)
 
+// A tx returned by BRTransactionParseCompact() lives in a single allocation: the BRTransaction struct, followed by the
+// inputs and outputs arrays, followed by every script, signature and witness. Arrays inside that block are marked with
+// an impossible capacity so that they are never realloc'd or freed on their own; the whole block is released by the
+// final free(tx) in BRTransactionFree(). Any field replaced after parsing is heap allocated as usual.
+#define TX_COMPACT_CAPACITY  SIZE_MAX
+
+#define _tx_array_is_compact(array) (array_capacity(array) == TX_COMPACT_CAPACITY)
+
+// shared by all compact txs for zero length scripts, signatures and witnesses - never written to
+static size_t _BRTxCompactEmpty[2] = { TX_COMPACT_CAPACITY, 0 };
+
+// frees a script, signature, witness, inputs or outputs array unless it is part of a compact tx
+static void _BRTxArrayFree(void *array)
+{
+    if (array && ! _tx_array_is_compact(array)) array_free(array);
+}
+
+#define _tx_align(size) (((size) + sizeof(size_t) - 1)/sizeof(size_t)*sizeof(size_t))
+
+// a + b, or SIZE_MAX if that would wrap
+static size_t _BRTxSizeAdd(size_t a, size_t b)
+{
+    return (a > SIZE_MAX - b) ? SIZE_MAX : a + b;
+}
+
+// number of bytes needed to hold a compact array of count items, keeping the next array size_t aligned, or SIZE_MAX if
+// that can't be represented - never wraps, so an impossible count fails to allocate rather than under-allocating
+static size_t _BRTxCompactArraySize(size_t count, size_t itemSize)
+{
+    if (itemSize > 0 && count > (SIZE_MAX - sizeof(size_t)*3)/itemSize) return SIZE_MAX;
+    return sizeof(size_t)*2 + _tx_align(count*itemSize);
+}
+
+// number of bytes needed to hold a compact byte array, zero length arrays use _BRTxCompactEmpty
+static size_t _BRTxCompactDataSize(size_t len)
+{
+    return (len > 0) ? _BRTxCompactArraySize(len, sizeof(uint8_t)) : 0;
+}
+
+// lays out a compact array of count items at *cursor and advances *cursor past it
+static void *_BRTxCompactArrayNew(uint8_t **cursor, size_t count, size_t itemSize)
+{
+    size_t *header = (size_t *)*cursor;
+
+    header[0] = TX_COMPACT_CAPACITY;
+    header[1] = count;
+    *cursor += _BRTxCompactArraySize(count, itemSize);
+    return &header[2];
+}
+
+// returns a heap array holding the items of compact array, with room for one more, that must be freed with array_free()
+// the items of a compact array were laid out in memory, so count*itemSize can't wrap
+static void *_BRTxArrayUncompact(const void *array, size_t itemSize)
+{
+    size_t count = array_count(array), *header;
+
+    assert(count < (SIZE_MAX - sizeof(size_t)*2)/itemSize);
+    header = calloc(1, sizeof(size_t)*2 + (count + 1)*itemSize);
+    assert(header != NULL);
+    header[0] = count + 1;
+    header[1] = count;
+    memcpy(&header[2], array, count*itemSize);
+    return &header[2];
+}
+
+// returns the number of bytes taken by the count witness items starting at buf[off], or SIZE_MAX if they don't all fit
+// in bufLen - every length is compared against what is left of buf, so a huge varint can't wrap the total into range
+static size_t _BRTxWitnessLen(const uint8_t *buf, size_t bufLen, size_t off, size_t count)
+{
+    size_t j, len = 0, itemLen, sLen = 0;
+
+    if (off > bufLen) return SIZE_MAX;
+
+    for (j = 0; j < count; j++) {
+        if (sLen >= bufLen - off) return SIZE_MAX;
+        itemLen = (size_t)BRVarInt(&buf[off + sLen], bufLen - (off + sLen), &len);
+        if (len > bufLen - (off + sLen)) return SIZE_MAX;
+        sLen += len;
+        if (itemLen > bufLen - (off + sLen)) return SIZE_MAX;
+        sLen += itemLen;
+    }
+
+    return sLen;
+}
+
+// copies len bytes from data into a compact byte array at *cursor and advances *cursor past it
+static uint8_t *_BRTxCompactData(uint8_t **cursor, const uint8_t *data, size_t len)
+{
+    uint8_t *array;
+
+    if (! data) return NULL;
+    if (len == 0) return (uint8_t *)&_BRTxCompactEmpty[2];
+    array = _BRTxCompactArrayNew(cursor, len, sizeof(uint8_t));
+    memcpy(array, data, len);
+    return array;
+}
+
 size_t BRTxInputAddress(const BRTxInput *input, char *address, size_t addrLen, BRAddressParams params)
 {
     size_t r = BRAddressFromScriptPubKey(address, addrLen, params, input->script, input->scriptLen);
@@ -49,7 +146,7 @@ void BRTxInputSetAddress(BRTxInput *input, BRAddressParams params, const char *a
 {
     assert(input != NULL);
     assert(address == NULL || BRAddressIsValid(params, address));
-    if (input->script) array_free(input->script);
+    _BRTxArrayFree(input->script);
     input->script = NULL;
     input->scriptLen = 0;
 
@@ -65,7 +162,7 @@ void BRTxInputSetScript(BRTxInput *input, const uint8_t *script, size_t scriptLe
 {
     assert(input != NULL);
     assert(script != NULL || scriptLen == 0);
-    if (input->script) array_free(input->script);
+    _BRTxArrayFree(input->script);
     input->script = NULL;
     input->scriptLen = 0;
     
@@ -80,7 +177,7 @@ void BRTxInputSetSignature(BRTxInput *input, const uint8_t *signature, size_t si
 {
     assert(input != NULL);
     assert(signature != NULL || sigLen == 0);
-    if (input->signature) array_free(input->signature);
+    _BRTxArrayFree(input->signature);
     input->signature = NULL;
     input->sigLen = 0;
     
@@ -95,7 +192,7 @@ void BRTxInputSetWitness(BRTxInput *input, const uint8_t *witness, size_t witLen
 {
     assert(input != NULL);
     assert(witness != NULL || witLen == 0);
-    if (input->witness) array_free(input->witness);
+    _BRTxArrayFree(input->witness);
     input->witness = NULL;
     input->witLen = 0;
     
@@ -139,7 +236,7 @@ void BRTxOutputSetAddress(BRTxOutput *output, BRAddressParams params, const char
 {
     assert(output != NULL);
     assert(address == NULL || BRAddressIsValid(params, address));
-    if (output->script) array_free(output->script);
+    _BRTxArrayFree(output->script);
     output->script = NULL;
     output->scriptLen = 0;
 
@@ -154,7 +251,7 @@ void BRTxOutputSetAddress(BRTxOutput *output, BRAddressParams params, const char
 void BRTxOutputSetScript(BRTxOutput *output, const uint8_t *script, size_t scriptLen)
 {
     assert(output != NULL);
-    if (output->script) array_free(output->script);
+    _BRTxArrayFree(output->script);
     output->script = NULL;
     output->scriptLen = 0;
 
@@ -365,14 +462,81 @@ BRTransaction *BRTransactionNew(void)
     return tx;
 }
 
+// returns a newly allocated compact transaction with room for inCount inputs, outCount outputs and dataLen bytes of
+// compact scripts, signatures and witnesses, *cursor is set to the start of that space
+// returns NULL if that size can't be represented
+static BRTransaction *_BRTransactionCompactNew(size_t inCount, size_t outCount, size_t dataLen, uint8_t **cursor)
+{
+    size_t size = _BRTxSizeAdd(_BRTxSizeAdd(_tx_align(sizeof(BRTransaction)),
+                                            _BRTxCompactArraySize(inCount, sizeof(BRTxInput))),
+                               _BRTxSizeAdd(_BRTxCompactArraySize(outCount, sizeof(BRTxOutput)), dataLen));
+    BRTransaction *tx = (size < SIZE_MAX) ? calloc(1, size) : NULL;
+
+    if (size == SIZE_MAX) return NULL;
+    assert(tx != NULL);
+    *cursor = (uint8_t *)tx + _tx_align(sizeof(*tx));
+    tx->version = TX_VERSION;
+    tx->inputs = _BRTxCompactArrayNew(cursor, inCount, sizeof(BRTxInput));
+    tx->inCount = inCount;
+    tx->outputs = _BRTxCompactArrayNew(cursor, outCount, sizeof(BRTxOutput));
+    tx->outCount = outCount;
+    tx->lockTime = TX_LOCKTIME;
+    tx->blockHeight = TX_UNCONFIRMED;
+    return tx;
+}
+
+// returns a deep copy of tx laid out in a single allocation
+static BRTransaction *_BRTransactionCompactCopy(const BRTransaction *tx)
+{
+    size_t i, dataLen = 0;
+    uint8_t *cursor;
+    BRTransaction *cpy;
+    BRTxInput *inputs;
+    BRTxOutput *outputs;
+
+    for (i = 0; i < tx->inCount; i++) {
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(tx->inputs[i].scriptLen));
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(tx->inputs[i].sigLen));
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(tx->inputs[i].witLen));
+    }
+
+    for (i = 0; i < tx->outCount; i++) {
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(tx->outputs[i].scriptLen));
+    }
+
+    cpy = _BRTransactionCompactNew(tx->inCount, tx->outCount, dataLen, &cursor);
+    assert(cpy != NULL); // tx is already in memory, so its compact size is representable
+    inputs = cpy->inputs;
+    outputs = cpy->outputs;
+    *cpy = *tx;
+    cpy->inputs = inputs;
+    cpy->outputs = outputs;
+
+    for (i = 0; i < tx->inCount; i++) {
+        inputs[i] = tx->inputs[i];
+        inputs[i].script = _BRTxCompactData(&cursor, tx->inputs[i].script, tx->inputs[i].scriptLen);
+        inputs[i].signature = _BRTxCompactData(&cursor, tx->inputs[i].signature, tx->inputs[i].sigLen);
+        inputs[i].witness = _BRTxCompactData(&cursor, tx->inputs[i].witness, tx->inputs[i].witLen);
+    }
+
+    for (i = 0; i < tx->outCount; i++) {
+        outputs[i] = tx->outputs[i];
+        outputs[i].script = _BRTxCompactData(&cursor, tx->outputs[i].script, tx->outputs[i].scriptLen);
+    }
+
+    return cpy;
+}
+
 // returns a deep copy of tx and that must be freed by calling BRTransactionFree()
 BRTransaction *BRTransactionCopy(const BRTransaction *tx)
 {
+    assert(tx != NULL);
+    if (_tx_array_is_compact(tx->inputs)) return _BRTransactionCompactCopy(tx);
+
     BRTransaction *cpy = BRTransactionNew();
     BRTxInput *inputs = cpy->inputs;
     BRTxOutput *outputs = cpy->outputs;
     
-    assert(tx != NULL);
     *cpy = *tx;
     cpy->inputs = inputs;
     cpy->outputs = outputs;
@@ -392,6 +556,26 @@ BRTransaction *BRTransactionCopy(const BRTransaction *tx)
     return cpy;
 }
 
+// sets txHash and wtxHash of a signed tx from the len bytes of buf it was serialized to, witness data (if any) starts
+// at witnessOff, or witnessOff is 0
+static void _BRTransactionHashes(UInt256 *txHash, UInt256 *wtxHash, const uint8_t *buf, size_t len, size_t witnessOff)
+{
+    BRSHA256Context ctx;
+    UInt256 md;
+
+    BRSHA256_2(wtxHash, buf, len);
+
+    if (witnessOff > 0) { // txHash skips the segwit marker and flag, and the witness data, streamed from buf in place
+        BRSHA256Init(&ctx);
+        BRSHA256Update(&ctx, buf, sizeof(uint32_t));
+        BRSHA256Update(&ctx, &buf[sizeof(uint32_t) + 2], witnessOff - (sizeof(uint32_t) + 2));
+        BRSHA256Update(&ctx, &buf[len - sizeof(uint32_t)], sizeof(uint32_t));
+        BRSHA256Final(&ctx, &md);
+        BRSHA256(txHash, &md, sizeof(md));
+    }
+    else *txHash = *wtxHash;
+}
+
 // buf must contain a serialized tx
 // retruns a transaction that must be freed by calling BRTransactionFree()
 BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
@@ -400,8 +584,7 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
     if (! buf) return NULL;
     
     int isSigned = 1, witnessFlag = 0;
-    uint8_t *sBuf;
-    size_t i, j, off = 0, witnessOff = 0, sLen = 0, len = 0, count;
+    size_t i, off = 0, witnessOff = 0, sLen = 0, len = 0, count;
     BRTransaction *tx = BRTransactionNew();
     BRTxInput *input;
     BRTxOutput *output;
@@ -417,6 +600,8 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         off += len;
     }
 
+    // every input takes at least 41 bytes, so a larger count can't be satisfied by buf
+    if (off > bufLen || tx->inCount > (bufLen - off)/(sizeof(UInt256) + sizeof(uint32_t)*2 + 1)) tx->inCount = 0;
     array_set_count(tx->inputs, tx->inCount);
     
     for (i = 0; off <= bufLen && i < tx->inCount; i++) {
@@ -427,14 +612,16 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         off += sizeof(uint32_t);
         sLen = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
         off += len;
+        if (off > bufLen || sLen > bufLen - off) off = bufLen + 1; // script runs past the end of buf
+        if (off > bufLen) break; // tx is rejected below
         
-        if (off + sLen <= bufLen && BRScriptPubKeyIsValid(&buf[off], sLen)) {
+        if (BRScriptPubKeyIsValid(&buf[off], sLen)) {
             BRTxInputSetScript(input, &buf[off], sLen);
-            input->amount = (off + sLen + sizeof(uint64_t) <= bufLen) ? UInt64GetLE(&buf[off + sLen]) : 0;
+            input->amount = (sLen + sizeof(uint64_t) <= bufLen - off) ? UInt64GetLE(&buf[off + sLen]) : 0;
             off += sizeof(uint64_t);
             isSigned = 0;
         }
-        else if (off + sLen <= bufLen) BRTxInputSetSignature(input, &buf[off], sLen);
+        else BRTxInputSetSignature(input, &buf[off], sLen);
         
         off += sLen;
         if (! witnessFlag) BRTxInputSetWitness(input, &buf[off], 0); // set witness to empty byte array
@@ -444,6 +631,8 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
     
     tx->outCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
     off += len;
+    // every output takes at least 9 bytes, so a larger count can't be satisfied by buf
+    if (off > bufLen || tx->outCount > (bufLen - off)/(sizeof(uint64_t) + 1)) tx->outCount = 0, off = bufLen + 1;
     array_set_count(tx->outputs, tx->outCount);
     
     for (i = 0; off <= bufLen && i < tx->outCount; i++) {
@@ -452,22 +641,17 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         off += sizeof(uint64_t);
         sLen = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
         off += len;
-        if (off + sLen <= bufLen) BRTxOutputSetScript(output, &buf[off], sLen);
-        off += sLen;
+        if (off > bufLen || sLen > bufLen - off) off = bufLen + 1; // script runs past the end of buf
+        else BRTxOutputSetScript(output, &buf[off], sLen), off += sLen;
     }
     
     for (i = 0, witnessOff = off; witnessFlag && off <= bufLen && i < tx->inCount; i++) {
         input = &tx->inputs[i];
         count = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
         off += len;
-        
-        for (j = 0, sLen = 0; j < count; j++) {
-            sLen += (size_t)BRVarInt(&buf[off + sLen], (off + sLen <= bufLen ? bufLen - (off + sLen) : 0), &len);
-            sLen += len;
-        }
-        
-        if (off + sLen <= bufLen) BRTxInputSetWitness(input, &buf[off], sLen);
-        off += sLen;
+        sLen = _BRTxWitnessLen(buf, bufLen, off, count);
+        if (sLen == SIZE_MAX) off = bufLen + 1; // witness runs past the end of buf
+        else BRTxInputSetWitness(input, &buf[off], sLen), off += sLen;
     }
     
     tx->lockTime = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
@@ -477,23 +661,240 @@ BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen)
         BRTransactionFree(tx);
         tx = NULL;
     }
-    else if (isSigned && witnessFlag) {
-        BRSHA256_2(&tx->wtxHash, buf, off);
-        sBuf = malloc((witnessOff - 2) + sizeof(uint32_t));
-        UInt32SetLE(sBuf, tx->version);
-        memcpy(&sBuf[sizeof(uint32_t)], &buf[sizeof(uint32_t) + 2], witnessOff - (sizeof(uint32_t) + 2));
-        UInt32SetLE(&sBuf[witnessOff - 2], tx->lockTime);
-        BRSHA256_2(&tx->txHash, sBuf, (witnessOff - 2) + sizeof(uint32_t));
-        free(sBuf);
+    else if (isSigned) _BRTransactionHashes(&tx->txHash, &tx->wtxHash, buf, off, (witnessFlag) ? witnessOff : 0);
+    
+    return tx;
+}
+
+// buf must contain a serialized tx
+// returns true and fills in view if buf contains a complete tx, with txHash and wtxHash streamed over buf in place
+int BRTransactionViewInit(BRTransactionView *view, const uint8_t *buf, size_t bufLen)
+{
+    assert(view != NULL);
+    assert(buf != NULL || bufLen == 0);
+    memset(view, 0, sizeof(*view));
+    if (! buf) return 0;
+
+    int witnessFlag = 0;
+    size_t i, off = 0, sLen = 0, len = 0, count;
+
+    view->buf = buf;
+    view->isSigned = 1;
+    view->version = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
+    off += sizeof(uint32_t);
+    view->inCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+    off += len;
+    if (view->inCount == 0 && off + 1 <= bufLen) witnessFlag = buf[off++];
+
+    if (witnessFlag) {
+        view->inCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+        off += len;
+    }
+
+    // lengths are always compared against what is left of buf, so a huge varint can't wrap off back into range
+    for (i = 0, view->inOff = off; off <= bufLen && i < view->inCount; i++) {
+        off += sizeof(UInt256) + sizeof(uint32_t);
+        sLen = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+        off += len;
+        if (off > bufLen || sLen > bufLen - off) return 0; // script runs past the end of buf
+
+        if (BRScriptPubKeyIsValid(&buf[off], sLen)) {
+            off += sizeof(uint64_t);
+            view->isSigned = 0;
+        }
+
+        off += sLen + sizeof(uint32_t);
     }
-    else if (isSigned) {
-        BRSHA256_2(&tx->txHash, buf, off);
-        tx->wtxHash = tx->txHash;
+
+    view->outCount = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+    off += len;
+
+    for (i = 0, view->outOff = off; off <= bufLen && i < view->outCount; i++) {
+        off += sizeof(uint64_t);
+        sLen = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+        off += len;
+        if (off > bufLen || sLen > bufLen - off) return 0; // script runs past the end of buf
+        off += sLen;
     }
-    
+
+    if (witnessFlag) view->witnessOff = off;
+
+    for (i = 0; witnessFlag && off <= bufLen && i < view->inCount; i++) {
+        count = (size_t)BRVarInt(&buf[off], (off <= bufLen ? bufLen - off : 0), &len);
+        off += len;
+        sLen = _BRTxWitnessLen(buf, bufLen, off, count);
+        if (sLen == SIZE_MAX) return 0; // witness runs past the end of buf
+        off += sLen;
+    }
+
+    view->lockTime = (off + sizeof(uint32_t) <= bufLen) ? UInt32GetLE(&buf[off]) : 0;
+    off += sizeof(uint32_t);
+    if (view->inCount == 0 || off > bufLen) return 0;
+    view->len = off;
+    if (view->isSigned) _BRTransactionHashes(&view->txHash, &view->wtxHash, buf, off, view->witnessOff);
+    return 1;
+}
+
+// returns true and sets input to the next input of view, or false when all inputs have been visited
+int BRTransactionViewNextInput(const BRTransactionView *view, BRTxViewIterator *iter, BRTxInputView *input)
+{
+    assert(view != NULL);
+    assert(iter != NULL);
+    assert(input != NULL);
+    if (iter->index >= view->inCount) return 0;
+
+    const uint8_t *buf = view->buf;
+    size_t j, sLen, len, count;
+
+    // every field read below was bounds checked by BRTransactionViewInit()
+    if (iter->index == 0) iter->off = view->inOff, iter->witnessOff = view->witnessOff;
+    input->txHash = UInt256Get(&buf[iter->off]);
+    iter->off += sizeof(UInt256);
+    input->index = UInt32GetLE(&buf[iter->off]);
+    iter->off += sizeof(uint32_t);
+    sLen = (size_t)BRVarInt(&buf[iter->off], view->len - iter->off, &len);
+    iter->off += len;
+
+    if (! view->isSigned && BRScriptPubKeyIsValid(&buf[iter->off], sLen)) {
+        input->script = &buf[iter->off];
+        input->scriptLen = sLen;
+        input->amount = UInt64GetLE(&buf[iter->off + sLen]);
+        input->signature = NULL;
+        input->sigLen = 0;
+        iter->off += sizeof(uint64_t);
+    }
+    else {
+        input->script = NULL;
+        input->scriptLen = 0;
+        input->amount = 0;
+        input->signature = &buf[iter->off];
+        input->sigLen = sLen;
+    }
+
+    iter->off += sLen;
+    input->sequence = UInt32GetLE(&buf[iter->off]);
+    iter->off += sizeof(uint32_t);
+    input->witness = NULL;
+    input->witLen = 0;
+
+    if (iter->witnessOff > 0) {
+        count = (size_t)BRVarInt(&buf[iter->witnessOff], view->len - iter->witnessOff, &len);
+        iter->witnessOff += len;
+
+        for (j = 0, sLen = 0; j < count; j++) {
+            sLen += (size_t)BRVarInt(&buf[iter->witnessOff + sLen], view->len - (iter->witnessOff + sLen), &len);
+            sLen += len;
+        }
+
+        input->witness = &buf[iter->witnessOff];
+        input->witLen = sLen;
+        iter->witnessOff += sLen;
+    }
+
+    iter->index++;
+    return 1;
+}
+
+// returns true and sets output to the next output of view, or false when all outputs have been visited
+int BRTransactionViewNextOutput(const BRTransactionView *view, BRTxViewIterator *iter, BRTxOutputView *output)
+{
+    assert(view != NULL);
+    assert(iter != NULL);
+    assert(output != NULL);
+    if (iter->index >= view->outCount) return 0;
+
+    const uint8_t *buf = view->buf;
+    size_t sLen, len;
+
+    // every field read below was bounds checked by BRTransactionViewInit()
+    if (iter->index == 0) iter->off = view->outOff;
+    output->amount = UInt64GetLE(&buf[iter->off]);
+    iter->off += sizeof(uint64_t);
+    sLen = (size_t)BRVarInt(&buf[iter->off], view->len - iter->off, &len);
+    iter->off += len;
+    output->script = &buf[iter->off];
+    output->scriptLen = sLen;
+    iter->off += sLen;
+    iter->index++;
+    return 1;
+}
+
+// writes the 20 byte pubkey hash spent by input to md20, taken from its witness, or its signature script if it has no
+// witness - returns the number of bytes written, or 0 if input doesn't spend a pubkey hash
+size_t BRTxInputViewPKH(const BRTxInputView *input, uint8_t *md20)
+{
+    assert(input != NULL);
+    return (input->witLen > 0) ? BRWitnessPKH(md20, input->witness, input->witLen) :
+           BRSignaturePKH(md20, input->signature, input->sigLen);
+}
+
+// returns a transaction with the contents of view, same as BRTransactionParseCompact(view->buf, view->len)
+BRTransaction *BRTransactionViewCreateTransaction(const BRTransactionView *view)
+{
+    assert(view != NULL);
+
+    BRTxViewIterator iter = BR_TX_VIEW_ITERATOR_INIT;
+    BRTxInputView in;
+    BRTxOutputView out;
+    uint8_t *cursor;
+    size_t i, dataLen = 0;
+    BRTransaction *tx;
+    BRTxInput *input;
+    BRTxOutput *output;
+
+    while (BRTransactionViewNextInput(view, &iter, &in)) {
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(in.scriptLen));
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(in.sigLen));
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(in.witLen));
+    }
+
+    iter = BR_TX_VIEW_ITERATOR_INIT;
+    while (BRTransactionViewNextOutput(view, &iter, &out)) {
+        dataLen = _BRTxSizeAdd(dataLen, _BRTxCompactDataSize(out.scriptLen));
+    }
+
+    tx = _BRTransactionCompactNew(view->inCount, view->outCount, dataLen, &cursor);
+    if (! tx) return NULL;
+    tx->txHash = view->txHash;
+    tx->wtxHash = view->wtxHash;
+    tx->version = view->version;
+    tx->lockTime = view->lockTime;
+
+    for (i = 0, iter = BR_TX_VIEW_ITERATOR_INIT; BRTransactionViewNextInput(view, &iter, &in); i++) {
+        input = &tx->inputs[i];
+        input->txHash = in.txHash;
+        input->index = in.index;
+        input->amount = in.amount;
+        input->script = _BRTxCompactData(&cursor, in.script, in.scriptLen);
+        input->scriptLen = in.scriptLen;
+        input->signature = _BRTxCompactData(&cursor, in.signature, in.sigLen);
+        input->sigLen = in.sigLen;
+        // witness is always set, to an empty byte array if the tx has no witness data
+        input->witness = _BRTxCompactData(&cursor, (in.witness) ? in.witness : view->buf, in.witLen);
+        input->witLen = in.witLen;
+        input->sequence = in.sequence;
+    }
+
+    for (i = 0, iter = BR_TX_VIEW_ITERATOR_INIT; BRTransactionViewNextOutput(view, &iter, &out); i++) {
+        output = &tx->outputs[i];
+        output->amount = out.amount;
+        output->script = _BRTxCompactData(&cursor, out.script, out.scriptLen);
+        output->scriptLen = out.scriptLen;
+    }
+
     return tx;
 }
 
+// buf must contain a serialized tx
+// returns a transaction laid out in a single allocation that must be freed by calling BRTransactionFree()
+BRTransaction *BRTransactionParseCompact(const uint8_t *buf, size_t bufLen)
+{
+    BRTransactionView view;
+
+    assert(buf != NULL || bufLen == 0);
+    return (BRTransactionViewInit(&view, buf, bufLen)) ? BRTransactionViewCreateTransaction(&view) : NULL;
+}
+
 // returns number of bytes written to buf, or total bufLen needed if buf is NULL
 // (tx->blockHeight and tx->timestamp are not serialized)
 size_t BRTransactionSerialize(const BRTransaction *tx, uint8_t *buf, size_t bufLen)
@@ -519,6 +920,11 @@ void BRTransactionAddInput(BRTransaction *tx, UInt256 txHash, uint32_t index, ui
         if (script) BRTxInputSetScript(&input, script, scriptLen);
         if (signature) BRTxInputSetSignature(&input, signature, sigLen);
         if (witness) BRTxInputSetWitness(&input, witness, witLen);
+
+        if (_tx_array_is_compact(tx->inputs)) { // move the inputs of a compact tx out of its block before growing them
+            tx->inputs = _BRTxArrayUncompact(tx->inputs, sizeof(BRTxInput));
+        }
+
         array_add(tx->inputs, input);
         tx->inCount = array_count(tx->inputs);
     }
@@ -534,6 +940,11 @@ void BRTransactionAddOutput(BRTransaction *tx, uint64_t amount, const uint8_t *s
     
     if (tx) {
         BRTxOutputSetScript(&output, script, scriptLen);
+
+        if (_tx_array_is_compact(tx->outputs)) { // move the outputs of a compact tx out of its block before growing them
+            tx->outputs = _BRTxArrayUncompact(tx->outputs, sizeof(BRTxOutput));
+        }
+
         array_add(tx->outputs, output);
         tx->outCount = array_count(tx->outputs);
     }
@@ -706,7 +1117,7 @@ int BRTransactionSign(BRTransaction *tx, int forkId, BRKey keys[], size_t keysCo
     if (tx && BRTransactionIsSigned(tx)) {
         uint8_t data[BRTransactionSerialize(tx, NULL, 0)];
         size_t len = BRTransactionSerialize(tx, data, sizeof(data));
-        BRTransaction *t = BRTransactionParse(data, len);
+        BRTransaction *t = BRTransactionParseCompact(data, len);
         
         if (t) tx->txHash = t->txHash, tx->wtxHash = t->wtxHash;
         if (t) BRTransactionFree(t);
@@ -741,8 +1152,8 @@ void BRTransactionFree(BRTransaction *tx)
             BRTxOutputSetScript(&tx->outputs[i], NULL, 0);
         }
 
-        array_free(tx->outputs);
-        array_free(tx->inputs);
-        free(tx);
+        _BRTxArrayFree(tx->outputs);
+        _BRTxArrayFree(tx->inputs);
+        free(tx); // for a compact tx, this also frees its inputs, outputs, scripts, signatures and witnesses
     }
 }
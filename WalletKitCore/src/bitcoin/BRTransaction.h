@@ -97,12 +97,18 @@ typedef struct {
 BRTransaction *BRTransactionNew(void);
 
 // returns a deep copy of tx and that must be freed by calling BRTransactionFree()
+// (the copy of a transaction from BRTransactionParseCompact() is also laid out in a single allocation)
 BRTransaction *BRTransactionCopy(const BRTransaction *tx);
 
 // buf must contain a serialized tx
 // retruns a transaction that must be freed by calling BRTransactionFree()
 BRTransaction *BRTransactionParse(const uint8_t *buf, size_t bufLen);
 
+// buf must contain a serialized tx
+// returns a transaction laid out in a single allocation, along with all of its inputs, outputs, scripts, signatures and
+// witnesses, that must be freed by calling BRTransactionFree() - the result may be modified like any other transaction
+BRTransaction *BRTransactionParseCompact(const uint8_t *buf, size_t bufLen);
+
 // returns number of bytes written to buf, or total bufLen needed if buf is NULL
 // (tx->blockHeight and tx->timestamp are not serialized)
 size_t BRTransactionSerialize(const BRTransaction *tx, uint8_t *buf, size_t bufLen);
@@ -153,6 +159,70 @@ inline static int BRTransactionEq(const void *tx, const void *otherTx)
 // frees memory allocated for tx
 void BRTransactionFree(BRTransaction *tx);
 
+// a read-only view of a serialized tx, walked in place without allocating - valid only while the buffer it was created
+// from is unchanged
+typedef struct {
+    const uint8_t *buf;
+    size_t len; // number of bytes of buf holding the tx
+    UInt256 txHash; // zero unless isSigned
+    UInt256 wtxHash; // zero unless isSigned
+    uint32_t version;
+    size_t inCount;
+    size_t outCount;
+    uint32_t lockTime;
+    int isSigned; // true if no input carries a scriptPubKey and amount, as in an unsigned serialized tx
+    size_t inOff; // offset of the first input
+    size_t outOff; // offset of the first output
+    size_t witnessOff; // offset of the first input witness, or 0 if the tx has no witness data
+} BRTransactionView;
+
+// an input of a BRTransactionView, pointers refer to the view's buffer
+typedef struct {
+    UInt256 txHash;
+    uint32_t index;
+    uint64_t amount;
+    const uint8_t *script;
+    size_t scriptLen;
+    const uint8_t *signature;
+    size_t sigLen;
+    const uint8_t *witness;
+    size_t witLen;
+    uint32_t sequence;
+} BRTxInputView;
+
+// an output of a BRTransactionView, script refers to the view's buffer
+typedef struct {
+    uint64_t amount;
+    const uint8_t *script;
+    size_t scriptLen;
+} BRTxOutputView;
+
+// iteration state for BRTransactionViewNextInput()/BRTransactionViewNextOutput(), start from BR_TX_VIEW_ITERATOR_INIT
+typedef struct {
+    size_t index;
+    size_t off;
+    size_t witnessOff;
+} BRTxViewIterator;
+
+#define BR_TX_VIEW_ITERATOR_INIT ((const BRTxViewIterator) { 0, 0, 0 })
+
+// buf must contain a serialized tx
+// returns true and fills in view if buf contains a complete tx, with txHash and wtxHash streamed over buf in place
+int BRTransactionViewInit(BRTransactionView *view, const uint8_t *buf, size_t bufLen);
+
+// returns true and sets input to the next input of view, or false when all inputs have been visited
+int BRTransactionViewNextInput(const BRTransactionView *view, BRTxViewIterator *iter, BRTxInputView *input);
+
+// returns true and sets output to the next output of view, or false when all outputs have been visited
+int BRTransactionViewNextOutput(const BRTransactionView *view, BRTxViewIterator *iter, BRTxOutputView *output);
+
+// writes the 20 byte pubkey hash spent by input to md20, taken from its witness, or its signature script if it has no
+// witness - returns the number of bytes written, or 0 if input doesn't spend a pubkey hash
+size_t BRTxInputViewPKH(const BRTxInputView *input, uint8_t *md20);
+
+// returns a transaction with the contents of view, same as BRTransactionParseCompact(view->buf, view->len)
+BRTransaction *BRTransactionViewCreateTransaction(const BRTransactionView *view);
+
 #ifdef __cplusplus
 }
 #endif
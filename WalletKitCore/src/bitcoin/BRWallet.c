@@ -66,6 +66,165 @@ inline static size_t _txChainIndex(const BRTransaction *tx, const UInt160 *chain
     return -1;
 }
 
+#define FOREIGN_TX_MAX_COUNT 2000            // max number of non-wallet unconfirmed tx kept for double spend checks
+#define FOREIGN_TX_MAX_SIZE  (4*1024*1024)   // max total serialized size of non-wallet unconfirmed tx kept
+#define FOREIGN_TX_MAX_AGE   (3*24*60*60)    // non-wallet unconfirmed tx are dropped when not seen for this long
+
+typedef struct BRForeignTxStruct BRForeignTx;
+
+// a non-wallet unconfirmed tx, linked in most recently seen order unless it's pinned
+struct BRForeignTxStruct {
+    UInt256 txHash; // must be first, entries are indexed by txHash
+    BRTransaction *tx;
+    size_t size;
+    time_t timestamp;
+    int pinned; // double spends a wallet tx, so it's unlinked and never evicted
+    BRForeignTx *newer, *older;
+};
+
+typedef struct {
+    BRSet *entries; // BRForeignTx items indexed by txHash
+    BRSet *outpoints; // inputs of the kept tx, indexed by the outpoint they spend, first tx seen wins
+    BRForeignTx *newest, *oldest;
+    size_t size, pinnedCount, pinnedSize, evicted;
+} BRForeignTxCache;
+
+inline static size_t _BRForeignTxHash(const void *entry)
+{
+    return (size_t)((const BRForeignTx *)entry)->txHash.u32[0];
+}
+
+inline static int _BRForeignTxEq(const void *entry, const void *otherEntry)
+{
+    return UInt256Eq(((const BRForeignTx *)entry)->txHash, ((const BRForeignTx *)otherEntry)->txHash);
+}
+
+static void _BRForeignTxCacheInit(BRForeignTxCache *cache)
+{
+    cache->entries = BRSetNew(_BRForeignTxHash, _BRForeignTxEq, 100);
+    cache->outpoints = BRSetNew(BRUTXOHash, BRUTXOEq, 100);
+    cache->newest = cache->oldest = NULL;
+    cache->size = cache->pinnedCount = cache->pinnedSize = cache->evicted = 0;
+}
+
+static void _BRForeignTxCacheUnlink(BRForeignTxCache *cache, BRForeignTx *entry)
+{
+    if (entry->newer) entry->newer->older = entry->older;
+    else cache->newest = entry->older;
+    if (entry->older) entry->older->newer = entry->newer;
+    else cache->oldest = entry->newer;
+    entry->newer = entry->older = NULL;
+}
+
+static void _BRForeignTxCacheLink(BRForeignTxCache *cache, BRForeignTx *entry)
+{
+    entry->older = cache->newest;
+    if (cache->newest) cache->newest->newer = entry;
+    cache->newest = entry;
+    if (! cache->oldest) cache->oldest = entry;
+}
+
+// adds tx to the cache as the most recently seen, tx must not already be in it
+static void _BRForeignTxCacheAdd(BRForeignTxCache *cache, BRTransaction *tx, time_t now)
+{
+    BRForeignTx *entry = calloc(1, sizeof(*entry));
+
+    assert(entry != NULL);
+    entry->txHash = tx->txHash;
+    entry->tx = tx;
+    entry->size = BRTransactionSize(tx);
+    entry->timestamp = now;
+    BRSetAdd(cache->entries, entry);
+    _BRForeignTxCacheLink(cache, entry);
+    cache->size += entry->size;
+    
+    for (size_t i = 0; i < tx->inCount; i++) { // an earlier tx for the same outpoint may be pinned, so it's kept
+        if (! BRSetContains(cache->outpoints, &tx->inputs[i])) BRSetAdd(cache->outpoints, &tx->inputs[i]);
+    }
+}
+
+// marks the cached tx with txHash, if any, as the most recently seen
+static void _BRForeignTxCacheTouch(BRForeignTxCache *cache, UInt256 txHash, time_t now)
+{
+    BRForeignTx *entry = BRSetGet(cache->entries, &txHash);
+
+    if (entry && ! entry->pinned) {
+        _BRForeignTxCacheUnlink(cache, entry);
+        _BRForeignTxCacheLink(cache, entry);
+        entry->timestamp = now;
+    }
+}
+
+// true if input belongs to the tx kept for the outpoint it spends, which is what double spend checks will find
+static int _BRForeignTxCacheSpends(const BRForeignTxCache *cache, const BRTxInput *input)
+{
+    return (BRSetGet(cache->outpoints, input) == input);
+}
+
+// removes the cached tx with txHash from the least recently seen order, so it's never evicted
+static void _BRForeignTxCachePin(BRForeignTxCache *cache, UInt256 txHash)
+{
+    BRForeignTx *entry = BRSetGet(cache->entries, &txHash);
+    
+    if (entry && ! entry->pinned) {
+        _BRForeignTxCacheUnlink(cache, entry);
+        entry->pinned = 1;
+        cache->pinnedCount++;
+        cache->pinnedSize += entry->size;
+    }
+}
+
+// returns a pinned entry to the cache as the most recently seen
+static void _BRForeignTxCacheUnpin(BRForeignTxCache *cache, BRForeignTx *entry, time_t now)
+{
+    if (entry->pinned) {
+        entry->pinned = 0;
+        cache->pinnedCount--;
+        cache->pinnedSize -= entry->size;
+        _BRForeignTxCacheLink(cache, entry);
+        entry->timestamp = now;
+    }
+}
+
+// removes the tx with txHash from the cache and returns it, or NULL if it wasn't cached
+static BRTransaction *_BRForeignTxCacheRemove(BRForeignTxCache *cache, UInt256 txHash)
+{
+    BRForeignTx *entry = BRSetRemove(cache->entries, &txHash);
+    BRTransaction *tx = (entry) ? entry->tx : NULL;
+
+    for (size_t i = 0; tx && i < tx->inCount; i++) { // an earlier tx may be the one kept for an outpoint
+        if (_BRForeignTxCacheSpends(cache, &tx->inputs[i])) BRSetRemove(cache->outpoints, &tx->inputs[i]);
+    }
+
+    if (entry) {
+        if (entry->pinned) cache->pinnedCount--, cache->pinnedSize -= entry->size;
+        else _BRForeignTxCacheUnlink(cache, entry);
+        cache->size -= entry->size;
+        free(entry);
+    }
+
+    return tx;
+}
+
+// returns the least recently seen tx if the cache is over its count or size limits, or the tx is too old, else NULL
+// pinned tx don't count towards the limits
+static BRTransaction *_BRForeignTxCacheExpired(const BRForeignTxCache *cache, time_t now)
+{
+    const BRForeignTx *entry = cache->oldest;
+
+    if (entry && (BRSetCount(cache->entries) - cache->pinnedCount > FOREIGN_TX_MAX_COUNT ||
+                  cache->size - cache->pinnedSize > FOREIGN_TX_MAX_SIZE ||
+                  entry->timestamp + FOREIGN_TX_MAX_AGE < now)) return entry->tx;
+    return NULL;
+}
+
+// frees the cache entries, the cached tx are left to the caller
+static void _BRForeignTxCacheFree(BRForeignTxCache *cache)
+{
+    BRSetFreeAll(cache->entries, free);
+    BRSetFree(cache->outpoints);
+}
+
 struct BRWalletStruct {
     uint64_t balance, totalSent, totalReceived, feePerKb, *balanceHist;
     uint32_t blockHeight;
@@ -75,6 +234,7 @@ struct BRWalletStruct {
     BRAddressParams addrParams;
     UInt160 *internalChain, *externalChain;
     BRSet *allTx, *invalidTx, *pendingTx, *spentOutputs, *usedPKH, *allPKH;
+    BRForeignTxCache foreignTx; // unconfirmed non-wallet tx, also in allTx
     void *callbackInfo;
     void (*balanceChanged)(void *info, uint64_t balance);
     void (*txAdded)(void *info, BRTransaction *tx);
@@ -161,6 +321,42 @@ static int _BRWalletContainsTx(BRWallet *wallet, const BRTransaction *tx)
     return r;
 }
 
+// true if non-wallet tx is the one kept for an outpoint that is also spent by an unconfirmed wallet tx, valid or not,
+// meaning the wallet tx is invalid because of it
+static int _BRWalletTxConflicts(BRWallet *wallet, const BRTransaction *tx)
+{
+    const BRTransaction *t;
+    
+    for (size_t i = 0; i < tx->inCount; i++) {
+        if (! _BRForeignTxCacheSpends(&wallet->foreignTx, &tx->inputs[i])) continue;
+        
+        for (size_t j = array_count(wallet->transactions); j > 0; j--) { // unconfirmed tx are sorted last
+            t = wallet->transactions[j - 1];
+            if (t->blockHeight != TX_UNCONFIRMED) break;
+            
+            for (size_t k = 0; k < t->inCount; k++) {
+                if (BRUTXOEq(&t->inputs[k], &tx->inputs[i])) return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+// returns pinned non-wallet tx that no longer double spend any wallet tx to the cache, so they can be evicted again
+static void _BRWalletUnpinForeignTx(BRWallet *wallet)
+{
+    time_t now = time(NULL);
+    
+    if (wallet->foreignTx.pinnedCount == 0) return;
+    
+    FOR_SET(BRForeignTx *, entry, wallet->foreignTx.entries) {
+        if (entry->pinned && ! _BRWalletTxConflicts(wallet, entry->tx)) {
+            _BRForeignTxCacheUnpin(&wallet->foreignTx, entry, now);
+        }
+    }
+}
+
 static void _BRWalletUpdateBalance(BRWallet *wallet)
 {
     int isInvalid, isPending;
@@ -186,6 +382,7 @@ static void _BRWalletUpdateBalance(BRWallet *wallet)
         if (tx->blockHeight == TX_UNCONFIRMED) {
             for (j = 0, isInvalid = 0; ! isInvalid && j < tx->inCount; j++) {
                 if (BRSetContains(wallet->spentOutputs, &tx->inputs[j]) ||
+                    BRSetContains(wallet->foreignTx.outpoints, &tx->inputs[j]) || // double spent by non-wallet tx
                     BRSetContains(wallet->invalidTx, &tx->inputs[j].txHash)) isInvalid = 1;
             }
         
@@ -281,6 +478,7 @@ BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[],
     wallet->spentOutputs = BRSetNew(BRUTXOHash, BRUTXOEq, txCount + 100);
     wallet->usedPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
     wallet->allPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
+    _BRForeignTxCacheInit(&wallet->foreignTx);
     pthread_mutex_init(&wallet->lock, NULL);
 
     for (size_t i = 0; transactions && i < txCount; i++) {
@@ -396,6 +594,47 @@ size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimi
     return j;
 }
 
+// returns the number of addresses generated so far in the chain, used or not
+size_t BRWalletChainLength(BRWallet *wallet, uint32_t internal)
+{
+    size_t count = 0;
+    
+    assert(wallet != NULL);
+    pthread_mutex_lock(&wallet->lock);
+    if (internal == SEQUENCE_EXTERNAL_CHAIN) count = array_count(wallet->externalChain);
+    if (internal == SEQUENCE_INTERNAL_CHAIN) count = array_count(wallet->internalChain);
+    pthread_mutex_unlock(&wallet->lock);
+    return count;
+}
+
+// removes the addresses at the end of the chain past its first <chainLength> addresses, keeping every used address
+// and the first <gapLimit> unused addresses after the last used one, such as those generated ahead by a
+// BRWalletUnusedAddrs() call with a larger gapLimit after the chain had <chainLength> addresses
+// returns the number of addresses removed
+size_t BRWalletTrimUnusedAddrs(BRWallet *wallet, size_t chainLength, uint32_t gapLimit, uint32_t internal)
+{
+    UInt160 *chain = NULL;
+    size_t i, j, count;
+    
+    assert(wallet != NULL);
+    pthread_mutex_lock(&wallet->lock);
+    if (internal == SEQUENCE_EXTERNAL_CHAIN) chain = wallet->externalChain;
+    if (internal == SEQUENCE_INTERNAL_CHAIN) chain = wallet->internalChain;
+    assert(chain != NULL);
+    i = count = array_count(chain);
+    while (i > 0 && ! BRSetContains(wallet->usedPKH, &chain[i - 1])) i--;
+    i = (i + gapLimit < count) ? i + gapLimit : count;
+    if (i < chainLength) i = (chainLength < count) ? chainLength : count;
+    
+    for (j = i; j < count; j++) {
+        BRSetRemove(wallet->allPKH, &chain[j]);
+    }
+    
+    array_set_count(chain, i);
+    pthread_mutex_unlock(&wallet->lock);
+    return count - i;
+}
+
 // current wallet balance, not including transactions known to be invalid
 uint64_t BRWalletBalance(BRWallet *wallet)
 {
@@ -781,10 +1020,45 @@ int BRWalletContainsTransaction(BRWallet *wallet, const BRTransaction *tx)
     return r;
 }
 
+// true if the serialized transaction in view is associated with the wallet (even if it hasn't been registered), checked
+// without parsing it into a BRTransaction
+int BRWalletContainsTransactionView(BRWallet *wallet, const BRTransactionView *view)
+{
+    int r = 0;
+    BRTxViewIterator iter;
+    BRTxInputView input;
+    BRTxOutputView output;
+    const uint8_t *pkh;
+    UInt160 hash;
+    
+    assert(wallet != NULL);
+    assert(view != NULL);
+    pthread_mutex_lock(&wallet->lock);
+    
+    for (iter = BR_TX_VIEW_ITERATOR_INIT; ! r && BRTransactionViewNextOutput(view, &iter, &output);) {
+        pkh = BRScriptPKH(output.script, output.scriptLen);
+        if (pkh && BRSetContains(wallet->allPKH, pkh)) r = 1;
+    }
+    
+    for (iter = BR_TX_VIEW_ITERATOR_INIT; ! r && BRTransactionViewNextInput(view, &iter, &input);) {
+        BRTransaction *t = BRSetGet(wallet->allTx, &input.txHash);
+        uint32_t n = input.index;
+        
+        pkh = (t && n < t->outCount) ? BRScriptPKH(t->outputs[n].script, t->outputs[n].scriptLen) : NULL;
+        if (pkh && BRSetContains(wallet->allPKH, pkh)) r = 1;
+        if (! r && BRTxInputViewPKH(&input, hash.u8) > 0 && BRSetContains(wallet->allPKH, &hash)) r = 1;
+    }
+    
+    pthread_mutex_unlock(&wallet->lock);
+    return r;
+}
+
 // adds a transaction to the wallet, or returns false if it isn't associated with the wallet
 int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
 {
-    int wasAdded = 0, r = 1;
+    int wasAdded = 0, needsUpdate = 0, r = 1;
+    time_t now = time(NULL);
+    BRTransaction *t;
     
     assert(wallet != NULL);
     assert(tx != NULL && BRTransactionIsSigned(tx));
@@ -803,12 +1077,36 @@ int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
                 wasAdded = 1;
             }
             else { // keep track of unconfirmed non-wallet tx for invalid tx checks and child-pays-for-parent fees
-                   // BUG: limit total non-wallet unconfirmed tx to avoid memory exhaustion attack
-                if (tx->blockHeight == TX_UNCONFIRMED) BRSetAdd(wallet->allTx, tx);
+                if (tx->blockHeight == TX_UNCONFIRMED) {
+                    BRSetAdd(wallet->allTx, tx);
+                    _BRForeignTxCacheAdd(&wallet->foreignTx, tx, now);
+                    
+                    if (_BRWalletTxConflicts(wallet, tx)) { // double spends are kept as long as the wallet tx is
+                        _BRForeignTxCachePin(&wallet->foreignTx, tx->txHash);
+                        needsUpdate = 1;
+                    }
+                    
+                    // the least recently seen non-wallet tx are dropped to bound memory use
+                    while ((t = _BRForeignTxCacheExpired(&wallet->foreignTx, now)) != NULL && t != tx) {
+                        if (_BRWalletTxConflicts(wallet, t)) { // the wallet tx it double spends was registered later
+                            _BRForeignTxCachePin(&wallet->foreignTx, t->txHash);
+                            continue;
+                        }
+                        
+                        _BRForeignTxCacheRemove(&wallet->foreignTx, t->txHash);
+                        BRSetRemove(wallet->allTx, t);
+                        BRTransactionFree(t);
+                        wallet->foreignTx.evicted++;
+                    }
+                }
+                
                 r = 0;
                 // BUG: XXX memory leak if tx is not added to wallet->allTx, and we can't just free it
             }
         }
+        else _BRForeignTxCacheTouch(&wallet->foreignTx, tx->txHash, now);
+        
+        if (needsUpdate) _BRWalletUpdateBalance(wallet); // wallet tx double spent by non-wallet tx may have changed
     
         pthread_mutex_unlock(&wallet->lock);
     }
@@ -869,6 +1167,7 @@ void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
             }
             
             _BRWalletUpdateBalance(wallet);
+            _BRWalletUnpinForeignTx(wallet);
             pthread_mutex_unlock(&wallet->lock);
             
             // if this is for a transaction we sent, and it wasn't already known to be invalid, notify user
@@ -918,6 +1217,21 @@ BRTransaction *BRWalletTransactionCopyForHash(BRWallet *wallet, UInt256 txHash)
     return tx;
 }
 
+// returns counts for the unconfirmed non-wallet transactions kept for double spend checks
+BRWalletForeignTxStats BRWalletGetForeignTxStats(BRWallet *wallet)
+{
+    BRWalletForeignTxStats stats;
+
+    assert(wallet != NULL);
+    pthread_mutex_lock(&wallet->lock);
+    stats.count = BRSetCount(wallet->foreignTx.entries);
+    stats.size = wallet->foreignTx.size;
+    stats.pinned = wallet->foreignTx.pinnedCount;
+    stats.evicted = wallet->foreignTx.evicted;
+    pthread_mutex_unlock(&wallet->lock);
+    return stats;
+}
+
 // true if no previous wallet transaction spends any of the given transaction's inputs, and no inputs are invalid
 int BRWalletTransactionIsValid(BRWallet *wallet, const BRTransaction *tx)
 {
@@ -935,7 +1249,8 @@ int BRWalletTransactionIsValid(BRWallet *wallet, const BRTransaction *tx)
 
         if (! BRSetContains(wallet->allTx, tx)) {
             for (size_t i = 0; r && i < tx->inCount; i++) {
-                if (BRSetContains(wallet->spentOutputs, &tx->inputs[i])) r = 0;
+                if (BRSetContains(wallet->spentOutputs, &tx->inputs[i]) ||
+                    BRSetContains(wallet->foreignTx.outpoints, &tx->inputs[i])) r = 0;
             }
         }
         else if (BRSetContains(wallet->invalidTx, tx)) r = 0;
@@ -1060,7 +1375,7 @@ void BRWalletUpdateTransactions(BRWallet *wallet, const UInt256 txHashes[], size
 {
     BRTransaction *tx;
     UInt256 hashes[txCount];
-    int needsUpdate = 0;
+    int needsUpdate = 0, needsUnpin = 0;
     size_t i, j, k;
     
     assert(wallet != NULL);
@@ -1084,14 +1399,22 @@ void BRWalletUpdateTransactions(BRWallet *wallet, const UInt256 txHashes[], size
             
             hashes[j++] = txHashes[i];
             if (BRSetContains(wallet->pendingTx, tx) || BRSetContains(wallet->invalidTx, tx)) needsUpdate = 1;
+            if (blockHeight != TX_UNCONFIRMED) needsUnpin = 1;
+        }
+        else if (blockHeight != TX_UNCONFIRMED && BRSetContains(wallet->foreignTx.entries, &tx->txHash) &&
+                 _BRWalletTxConflicts(wallet, tx)) { // a confirmed double spend of a wallet tx is kept
+            _BRForeignTxCachePin(&wallet->foreignTx, tx->txHash);
+            needsUpdate = 1;
         }
-        else if (blockHeight != TX_UNCONFIRMED) { // remove and free confirmed non-wallet tx
+        else if (blockHeight != TX_UNCONFIRMED) { // remove and free other confirmed non-wallet tx
+            _BRForeignTxCacheRemove(&wallet->foreignTx, tx->txHash);
             BRSetRemove(wallet->allTx, tx);
             BRTransactionFree(tx);
         }
     }
     
     if (needsUpdate) _BRWalletUpdateBalance(wallet);
+    if (needsUnpin) _BRWalletUnpinForeignTx(wallet);
     pthread_mutex_unlock(&wallet->lock);
     if (j > 0 && wallet->txUpdated) wallet->txUpdated(wallet->callbackInfo, hashes, j, blockHeight, timestamp);
 }
@@ -1329,6 +1652,7 @@ void BRWalletFree(BRWallet *wallet)
     BRSetFree(wallet->usedPKH);
     BRSetFree(wallet->invalidTx);
     BRSetFree(wallet->pendingTx);
+    _BRForeignTxCacheFree(&wallet->foreignTx);
     BRSetApply(wallet->allTx, NULL, _setApplyFreeTx);
     BRSetFree(wallet->allTx);
     BRSetFree(wallet->spentOutputs);
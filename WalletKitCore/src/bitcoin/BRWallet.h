@@ -83,6 +83,15 @@ void BRWalletSetCallbacks(BRWallet *wallet, void *info,
 // returns the number addresses written to addrs
 size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimit, uint32_t internal);
 
+// returns the number of addresses generated so far in the chain, used or not
+size_t BRWalletChainLength(BRWallet *wallet, uint32_t internal);
+
+// removes the addresses at the end of the chain past its first <chainLength> addresses, keeping every used address
+// and the first <gapLimit> unused addresses after the last used one, such as those generated ahead by a
+// BRWalletUnusedAddrs() call with a larger gapLimit after the chain had <chainLength> addresses
+// returns the number of addresses removed
+size_t BRWalletTrimUnusedAddrs(BRWallet *wallet, size_t chainLength, uint32_t gapLimit, uint32_t internal);
+
 BRAddressParams BRWalletGetAddressParams (BRWallet *wallet);
 
 // returns the first unused external address (bech32 pay-to-witness-pubkey-hash)
@@ -162,6 +171,10 @@ int BRWalletSignTransaction(BRWallet *wallet, BRTransaction *tx, uint8_t forkId,
 // true if the given transaction is associated with the wallet (even if it hasn't been registered)
 int BRWalletContainsTransaction(BRWallet *wallet, const BRTransaction *tx);
 
+// true if the serialized transaction in view is associated with the wallet (even if it hasn't been registered), checked
+// without parsing it into a BRTransaction
+int BRWalletContainsTransactionView(BRWallet *wallet, const BRTransactionView *view);
+
 // adds a transaction to the wallet, or returns false if it isn't associated with the wallet
 int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx);
 
@@ -174,6 +187,16 @@ BRTransaction *BRWalletTransactionForHash(BRWallet *wallet, UInt256 txHash);
 // returns a copy of the transaction with the given hash if it's been registered in the wallet
 BRTransaction *BRWalletTransactionCopyForHash(BRWallet *wallet, UInt256 txHash);
 
+typedef struct {
+    size_t count; // number of unconfirmed non-wallet transactions kept
+    size_t size; // their total serialized size in bytes
+    size_t pinned; // number of those kept regardless of the limits because they double spend a wallet tx
+    size_t evicted; // number dropped to stay within the count, size and age limits, since the wallet was created
+} BRWalletForeignTxStats;
+
+// returns counts for the unconfirmed non-wallet transactions kept for double spend checks
+BRWalletForeignTxStats BRWalletGetForeignTxStats(BRWallet *wallet);
+
 // true if no previous wallet transaction spends any of the given transaction's inputs, and no inputs are invalid
 int BRWalletTransactionIsValid(BRWallet *wallet, const BRTransaction *tx);
 
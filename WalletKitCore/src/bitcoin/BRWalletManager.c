@@ -655,7 +655,7 @@ fileServiceTypeTransactionV1Reader (BRFileServiceContext context,
     size_t txBlockHeightSize = sizeof (uint32_t);
     if (bytesCount < (txTimestampSize + txBlockHeightSize)) return NULL;
 
-    BRTransaction *transaction = BRTransactionParse (bytes, bytesCount - txTimestampSize - txBlockHeightSize);
+    BRTransaction *transaction = BRTransactionParseCompact (bytes, bytesCount - txTimestampSize - txBlockHeightSize);
     if (NULL == transaction) return NULL;
 
     transaction->blockHeight = UInt32GetLE (&bytes[bytesCount - txTimestampSize - txBlockHeightSize]);
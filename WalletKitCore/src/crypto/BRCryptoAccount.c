@@ -8,6 +8,7 @@
 //  See the LICENSE file at the project root for license information.
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
+#include <unistd.h>      // sysconf()
 #include "support/BROSCompat.h"
 #include "BRCryptoAccountP.h"
 #include "BRCryptoNetworkP.h"
@@ -115,6 +116,93 @@ cryptoAccountCreate (const char *phrase, uint64_t timestamp, const char *uids) {
     return cryptoAccountCreateFromSeedInternal (cryptoAccountDeriveSeedInternal(phrase), timestamp, uids);
 }
 
+/// MARK: - Batch Serialization
+
+#define ACCOUNT_BATCH_PTHREAD_STACK_SIZE (512 * 1024)
+
+typedef struct {
+    const char **phrases;
+    const uint64_t *timestamps;
+    size_t count;
+
+    uint8_t **serializations;
+    size_t *bytesCounts;
+
+    pthread_mutex_t lock;
+    size_t next;            // The index of the next account to create; guarded by `lock`
+} BRCryptoAccountBatch;
+
+static void *
+cryptoAccountBatchThread (BRCryptoAccountBatch *batch) {
+    while (1) {
+        pthread_mutex_lock (&batch->lock);
+        size_t index = batch->next;
+        if (index < batch->count) batch->next += 1;
+        pthread_mutex_unlock (&batch->lock);
+
+        if (index >= batch->count) break;
+
+        UInt512 seed = cryptoAccountDeriveSeedInternal (batch->phrases[index]);
+        BRCryptoAccount account = cryptoAccountCreateFromSeedInternal (seed, batch->timestamps[index], "");
+        mem_clean (&seed, sizeof (seed));
+
+        batch->serializations[index] = cryptoAccountSerialize (account, &batch->bytesCounts[index]);
+        cryptoAccountGive (account);
+    }
+    return NULL;
+}
+
+extern uint8_t **
+cryptoAccountSerializeBatch (const char *phrases[],
+                             const uint64_t timestamps[],
+                             size_t count,
+                             size_t threadCount,
+                             size_t bytesCounts[]) {
+    cryptoAccountInstall();
+
+    if (0 == threadCount) {
+        long cores = sysconf (_SC_NPROCESSORS_ONLN);
+        threadCount = (cores > 0 ? (size_t) cores : 1);
+    }
+    if (threadCount > count) threadCount = (count > 0 ? count : 1);
+
+    BRCryptoAccountBatch batch = {
+        phrases,
+        timestamps,
+        count,
+        calloc (count, sizeof (uint8_t *)),
+        bytesCounts,
+        PTHREAD_MUTEX_INITIALIZER,
+        0
+    };
+
+    // Every account is created and serialized by one thread, start to finish; the threads take
+    // the next account as they finish.  With hundreds of accounts there is no benefit to splitting
+    // the seed derivation from the per-chain derivations - each thread is always busy.
+    pthread_t threads[threadCount];
+    size_t threadsStarted = 0;
+
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+    pthread_attr_setstacksize (&attr, ACCOUNT_BATCH_PTHREAD_STACK_SIZE);
+
+    // This thread does its share, after any others start
+    for (size_t index = 1; index < threadCount; index++)
+        if (0 == pthread_create (&threads[threadsStarted], &attr, (ThreadRoutine) cryptoAccountBatchThread, &batch))
+            threadsStarted++;
+
+    pthread_attr_destroy (&attr);
+
+    cryptoAccountBatchThread (&batch);
+
+    for (size_t index = 0; index < threadsStarted; index++)
+        pthread_join (threads[index], NULL);
+
+    pthread_mutex_destroy (&batch.lock);
+    return batch.serializations;
+}
+
 /**
  * Deserialize into an Account.  The serialization format is:
  *  <checksum16><size32><version>
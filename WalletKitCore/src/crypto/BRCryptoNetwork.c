@@ -118,6 +118,7 @@ cryptoNetworkFeeAsGEN( BRCryptoNetworkFee networkFee) {
 #define CRYPTO_NETWORK_DEFAULT_CURRENCY_ASSOCIATIONS        (2)
 #define CRYPTO_NETWORK_DEFAULT_FEES                         (3)
 #define CRYPTO_NETWORK_DEFAULT_NETWORKS                     (5)
+#define CRYPTO_NETWORK_DEFAULT_CLIENT_REQUEST_LIMIT         (4)
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoNetwork, cryptoNetwork)
 
@@ -137,6 +138,17 @@ cryptoNetworkCreate (const char *uids,
 
     network->addressSchemes = NULL;
     network->syncModes = NULL;
+    network->les = NULL;
+    network->lesUsers = 0;
+
+    network->blockNumberRequests.leader = NULL;
+    array_new (network->blockNumberRequests.waiters, 1);
+
+    network->clientRequests.limit = CRYPTO_NETWORK_DEFAULT_CLIENT_REQUEST_LIMIT;
+    array_new (network->clientRequests.inFlight, CRYPTO_NETWORK_DEFAULT_CLIENT_REQUEST_LIMIT);
+    array_new (network->clientRequests.pending, 1);
+    network->clientRequests.failures = 0;
+    network->clientRequests.backoffUntil = 0;
 
     network->ref = CRYPTO_REF_ASSIGN(cryptoNetworkRelease);
 
@@ -216,12 +228,24 @@ cryptoNetworkRelease (BRCryptoNetwork network) {
 
     if (network->addressSchemes) array_free (network->addressSchemes);
     if (network->syncModes)      array_free (network->syncModes);
+
+    // Every waiter holds a wallet manager, which holds this network; thus, no waiters.
+    assert (0 == array_count (network->blockNumberRequests.waiters));
+    array_free (network->blockNumberRequests.waiters);
+
+    // Likewise, every pending request holds a wallet manager.  A request in flight that was
+    // never answered is abandoned; it is not ours to release.
+    assert (0 == array_count (network->clientRequests.pending));
+    array_free (network->clientRequests.pending);
+    array_free (network->clientRequests.inFlight);
         
     // TBD
     switch (network->type){
         case BLOCK_CHAIN_TYPE_BTC:
             break;
         case BLOCK_CHAIN_TYPE_ETH:
+            // Every user of the shared LES is a wallet manager, which holds this network
+            assert (0 == network->lesUsers && NULL == network->les);
             break;
         case BLOCK_CHAIN_TYPE_GEN:
             genNetworkRelease (network->u.gen);
@@ -281,6 +305,22 @@ cryptoNetworkSetHeight (BRCryptoNetwork network,
     network->height = height;
 }
 
+extern size_t
+cryptoNetworkGetClientRequestLimit (BRCryptoNetwork network) {
+    pthread_mutex_lock (&network->lock);
+    size_t limit = network->clientRequests.limit;
+    pthread_mutex_unlock (&network->lock);
+    return limit;
+}
+
+extern void
+cryptoNetworkSetClientRequestLimit (BRCryptoNetwork network,
+                                    size_t limit) {
+    pthread_mutex_lock (&network->lock);
+    network->clientRequests.limit = limit;
+    pthread_mutex_unlock (&network->lock);
+}
+
 extern uint32_t
 cryptoNetworkGetConfirmationsUntilFinal (BRCryptoNetwork network) {
     return network->confirmationsUntilFinal;
@@ -635,6 +675,44 @@ cryptoNetworkAsGEN (BRCryptoNetwork network) {
     return network->u.gen;
 }
 
+private_extern BREthereumLES
+cryptoNetworkJoinSharedLES (BRCryptoNetwork network) {
+    assert (BLOCK_CHAIN_TYPE_ETH == network->type);
+    pthread_mutex_lock (&network->lock);
+    network->lesUsers += 1;
+    BREthereumLES les = network->les;
+    pthread_mutex_unlock (&network->lock);
+    return les;
+}
+
+private_extern void
+cryptoNetworkLeaveSharedLES (BRCryptoNetwork network) {
+    assert (BLOCK_CHAIN_TYPE_ETH == network->type);
+    BREthereumLES les = NULL;
+
+    pthread_mutex_lock (&network->lock);
+    assert (network->lesUsers > 0);
+    network->lesUsers -= 1;
+    if (0 == network->lesUsers) {
+        les = network->les;
+        network->les = NULL;
+    }
+    pthread_mutex_unlock (&network->lock);
+
+    // On the last reference, lesRelease() stops LES; don't hold `lock`.
+    if (NULL != les) lesRelease (les);
+}
+
+private_extern void
+cryptoNetworkSetSharedLES (BRCryptoNetwork network,
+                           BREthereumLES les) {
+    assert (BLOCK_CHAIN_TYPE_ETH == network->type);
+    pthread_mutex_lock (&network->lock);
+    if (NULL == network->les && NULL != les)
+        network->les = lesTake (les);
+    pthread_mutex_unlock (&network->lock);
+}
+
 private_extern BRCryptoBlockChainType
 cryptoNetworkGetBlockChainType (BRCryptoNetwork network) {
     return network->type;
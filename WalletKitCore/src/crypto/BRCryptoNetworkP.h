@@ -12,9 +12,11 @@
 #define BRCryptoNetworkP_h
 
 #include <pthread.h>
+#include <time.h>
 
 #include "BRCryptoBaseP.h"
 #include "BRCryptoNetwork.h"
+#include "BRCryptoWalletManagerClient.h"
 
 #include "bitcoin/BRChainParams.h"
 #include "bcash/BRBCashParams.h"
@@ -57,6 +59,38 @@ typedef struct {
     BRArrayOf(BRCryptoUnit) units;
 } BRCryptoCurrencyAssociation;
 
+/// MARK: - Network Client Requests
+
+/// The time after which an in-flight request is presumed lost; the next request is made anew.
+#define CWM_CLIENT_REQUEST_TIMEOUT_SECONDS          (60)
+
+/// The backoff after the first consecutive background failure; it doubles with each one after.
+#define CWM_CLIENT_REQUEST_BACKOFF_SECONDS          (2)
+
+/// The longest backoff.
+#define CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS    (64)
+
+/// The number of times a failed background request is made again before its failure is announced.
+#define CWM_CLIENT_REQUEST_RETRIES                  (3)
+
+/// The time a 'get block number' result is reused for other requests on the same network.
+#define CWM_CLIENT_BLOCK_NUMBER_CACHE_SECONDS       (5)
+
+/**
+ * A wallet manager's 'get block number' client request, waiting on the identical request that is
+ * in flight for another wallet manager on the same network.
+ */
+typedef struct {
+    BRCryptoWalletManager manager;
+    BRCryptoClientCallbackState callbackState;
+} BRCryptoClientBlockNumberWaiter;
+
+/**
+ * A background client request - a 'get transactions' or 'get transfers' made for a sync - that
+ * waits for its turn on the network.  See cwmRequestSchedule().
+ */
+typedef struct BRCryptoClientRequestRecord *BRCryptoClientRequest;
+
 /// MARK: - Network
 
 struct BRCryptoNetworkRecord {
@@ -86,6 +120,34 @@ struct BRCryptoNetworkRecord {
         BREthereumNetwork eth;
         BRGenericNetwork gen;
     } u;
+
+    // The ETH LES node pool shared by the wallet managers on this network; NULL until the first
+    // wallet manager in a P2P sync mode provides it.  The network holds a reference while any of
+    // the `lesUsers` wallet managers remain; see cryptoNetworkJoinSharedLES().
+    BREthereumLES les;
+    size_t lesUsers;
+
+    // The 'get block number' client requests, coalesced over all the wallet managers on this
+    // network.  See cwmRequestBlockNumber().
+    struct {
+        BRCryptoClientCallbackState leader;     // The request in flight, if any...
+        time_t leaderTimestamp;                 // ... and when it was made.
+        BRArrayOf(BRCryptoClientBlockNumberWaiter) waiters;
+        uint64_t blockNumber;                   // The most recent result...
+        time_t blockNumberTimestamp;            // ... and when it arrived; 0 if none.
+    } blockNumberRequests;
+
+    // The client requests in flight over all the wallet managers on this network, limited to
+    // `limit` at once.  Background requests wait in `pending` for a free slot and, after a
+    // background request fails, until the backoff expires.  See cwmRequestSchedule().
+    struct {
+        size_t limit;                           // 0 => unlimited
+        BRArrayOf(BRCryptoClientCallbackState) inFlight;
+        BRArrayOf(BRCryptoClientRequest) pending;
+        unsigned int failures;                  // Consecutive background failures...
+        time_t backoffUntil;                    // ... and when background requests may resume.
+    } clientRequests;
+
     BRCryptoRef ref;
 };
 
@@ -136,6 +198,27 @@ cryptoNetworkAsETH (BRCryptoNetwork network);
 private_extern BRGenericNetwork
 cryptoNetworkAsGEN (BRCryptoNetwork network);
 
+/**
+ * Join, as an ETH wallet manager, the users of the LES shared on `network`; return the LES or NULL
+ * if none.  The LES is not taken but remains valid until cryptoNetworkLeaveSharedLES().
+ */
+private_extern BREthereumLES
+cryptoNetworkJoinSharedLES (BRCryptoNetwork network);
+
+/**
+ * Leave the users of the LES shared on `network`.  When the last user leaves, the network releases
+ * its reference, so that the LES is released with the last EWM using it.
+ */
+private_extern void
+cryptoNetworkLeaveSharedLES (BRCryptoNetwork network);
+
+/**
+ * Provide the LES to share on `network`, if none is already shared; the network takes `les`.
+ */
+private_extern void
+cryptoNetworkSetSharedLES (BRCryptoNetwork network,
+                           BREthereumLES les);
+
 private_extern BRCryptoBlockChainType
 cryptoNetworkGetBlockChainType (BRCryptoNetwork network);
 
@@ -23,6 +23,74 @@
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoWallet, cryptoWallet)
 
+/// MARK: - Transfer Index
+
+/**
+ * A Transfer Entry indexes one of the wallet's transfers by the transfer's per-chain identity.
+ * BTC and ETH transfers are identified by their `tid` alone; GEN transfers with the same hash
+ * may still differ (by UIDS) and thus are chained, in the order added, off of the first entry.
+ */
+struct BRCryptoWalletTransferEntryRecord {
+    BRCryptoBlockChainType type;
+    union {
+        BRTransaction *btc;
+        BREthereumTransfer eth;
+        BRGenericHash gen;
+    } u;
+
+    BRCryptoTransfer transfer;
+    size_t index;       // into wallet->transfers
+    uint64_t version;   // the wallet's transfers version when `transfer` was added or last updated
+
+    struct BRCryptoWalletTransferEntryRecord *next;
+};
+
+static size_t
+cryptoWalletTransferEntryHashValue (const void *entryPtr) {
+    BRCryptoWalletTransferEntry entry = (BRCryptoWalletTransferEntry) entryPtr;
+    switch (entry->type) {
+        case BLOCK_CHAIN_TYPE_BTC: return (size_t) (uintptr_t) entry->u.btc;
+        case BLOCK_CHAIN_TYPE_ETH: return (size_t) (uintptr_t) entry->u.eth;
+        case BLOCK_CHAIN_TYPE_GEN: return (entry->u.gen.bytesCount < sizeof (uint32_t)
+                                           ? 0
+                                           : genericHashSetValue (entry->u.gen));
+    }
+}
+
+static int
+cryptoWalletTransferEntryHashEqual (const void *entryPtr1, const void *entryPtr2) {
+    BRCryptoWalletTransferEntry entry1 = (BRCryptoWalletTransferEntry) entryPtr1;
+    BRCryptoWalletTransferEntry entry2 = (BRCryptoWalletTransferEntry) entryPtr2;
+    if (entry1 == entry2) return 1;
+    if (entry1->type != entry2->type) return 0;
+    switch (entry1->type) {
+        case BLOCK_CHAIN_TYPE_BTC: return entry1->u.btc == entry2->u.btc;
+        case BLOCK_CHAIN_TYPE_ETH: return entry1->u.eth == entry2->u.eth;
+        case BLOCK_CHAIN_TYPE_GEN: return genericHashEqual (entry1->u.gen, entry2->u.gen);
+    }
+}
+
+static struct BRCryptoWalletTransferEntryRecord
+cryptoWalletTransferEntryKey (BRCryptoTransfer transfer) {
+    struct BRCryptoWalletTransferEntryRecord key = { transfer->type };
+    switch (transfer->type) {
+        case BLOCK_CHAIN_TYPE_BTC: key.u.btc = transfer->u.btc.tid; break;
+        case BLOCK_CHAIN_TYPE_ETH: key.u.eth = transfer->u.eth.tid; break;
+        case BLOCK_CHAIN_TYPE_GEN: key.u.gen = genTransferGetHash (transfer->u.gen); break;
+    }
+    return key;
+}
+
+static void
+cryptoWalletTransferEntryRelease (void *ignore, void *entryPtr) {
+    BRCryptoWalletTransferEntry entry = (BRCryptoWalletTransferEntry) entryPtr;
+    while (NULL != entry) {
+        BRCryptoWalletTransferEntry next = entry->next;
+        free (entry);
+        entry = next;
+    }
+}
+
 static BRCryptoWallet
 cryptoWalletCreateInternal (BRCryptoBlockChainType type,
                             BRCryptoUnit unit,
@@ -34,6 +102,13 @@ cryptoWalletCreateInternal (BRCryptoBlockChainType type,
     wallet->unit  = cryptoUnitTake (unit);
     wallet->unitForFee = cryptoUnitTake (unitForFee);
     array_new (wallet->transfers, 5);
+    wallet->transfersRemoved = 0;
+    wallet->transfersIndex   = BRSetNew (cryptoWalletTransferEntryHashValue,
+                                         cryptoWalletTransferEntryHashEqual,
+                                         5);
+    wallet->transfersVersion        = 0;
+    wallet->transfersRemovedVersion = 0;
+    wallet->transfersSnapshot       = NULL;
 
     wallet->ref = CRYPTO_REF_ASSIGN (cryptoWalletRelease);
 
@@ -91,9 +166,15 @@ cryptoWalletRelease (BRCryptoWallet wallet) {
     cryptoUnitGive (wallet->unit);
     cryptoUnitGive(wallet->unitForFee);
 
+    if (NULL != wallet->transfersSnapshot)
+        cryptoWalletTransfersGive (wallet->transfersSnapshot);
+
     for (size_t index = 0; index < array_count(wallet->transfers); index++)
-        cryptoTransferGive (wallet->transfers[index]);
+        if (NULL != wallet->transfers[index])
+            cryptoTransferGive (wallet->transfers[index]->transfer);
     array_free (wallet->transfers);
+    BRSetApply (wallet->transfersIndex, NULL, cryptoWalletTransferEntryRelease);
+    BRSetFree  (wallet->transfersIndex);
 
     switch (wallet->type) {
         case BLOCK_CHAIN_TYPE_BTC:
@@ -215,14 +296,51 @@ cryptoWalletGetBalanceMaximum (BRCryptoWallet wallet) {
 }
 
 
+/**
+ * Find the entry for `transfer`, if any, along with the entry preceeding it in the chain.
+ * Must be called with the wallet locked.
+ */
+static BRCryptoWalletTransferEntry
+cryptoWalletFindTransferEntry (BRCryptoWallet wallet,
+                               BRCryptoTransfer transfer,
+                               BRCryptoWalletTransferEntry *previous) {
+    struct BRCryptoWalletTransferEntryRecord key = cryptoWalletTransferEntryKey (transfer);
+
+    BRCryptoWalletTransferEntry prev  = NULL;
+    BRCryptoWalletTransferEntry entry = BRSetGet (wallet->transfersIndex, &key);
+
+    while (NULL != entry && CRYPTO_FALSE == cryptoTransferEqual (transfer, entry->transfer)) {
+        prev  = entry;
+        entry = entry->next;
+    }
+
+    if (NULL != previous) *previous = prev;
+    return entry;
+}
+
+/**
+ * Drop the NULL slots left in `wallet->transfers` by removed transfers, preserving the order
+ * of those remaining.  Must be called with the wallet locked.
+ */
+static void
+cryptoWalletCompactTransfers (BRCryptoWallet wallet) {
+    size_t count = 0;
+    for (size_t index = 0; index < array_count (wallet->transfers); index++) {
+        BRCryptoWalletTransferEntry entry = wallet->transfers[index];
+        if (NULL == entry) continue;
+
+        entry->index = count;
+        wallet->transfers[count++] = entry;
+    }
+    array_set_count (wallet->transfers, count);
+    wallet->transfersRemoved = 0;
+}
+
 extern BRCryptoBoolean
 cryptoWalletHasTransfer (BRCryptoWallet wallet,
                          BRCryptoTransfer transfer) {
-    BRCryptoBoolean r = CRYPTO_FALSE;
     pthread_mutex_lock (&wallet->lock);
-    for (size_t index = 0; index < array_count(wallet->transfers) && CRYPTO_FALSE == r; index++) {
-        r = cryptoTransferEqual (transfer, wallet->transfers[index]);
-    }
+    BRCryptoBoolean r = AS_CRYPTO_BOOLEAN (NULL != cryptoWalletFindTransferEntry (wallet, transfer, NULL));
     pthread_mutex_unlock (&wallet->lock);
     return r;
 }
@@ -230,14 +348,13 @@ cryptoWalletHasTransfer (BRCryptoWallet wallet,
 private_extern BRCryptoTransfer
 cryptoWalletFindTransferAsBTC (BRCryptoWallet wallet,
                                BRTransaction *btc) {
-    BRCryptoTransfer transfer = NULL;
+    struct BRCryptoWalletTransferEntryRecord key = { BLOCK_CHAIN_TYPE_BTC, { .btc = btc } };
+
     pthread_mutex_lock (&wallet->lock);
-    for (size_t index = 0; index < array_count(wallet->transfers); index++) {
-        if (CRYPTO_TRUE == cryptoTransferHasBTC (wallet->transfers[index], btc)) {
-            transfer = cryptoTransferTake (wallet->transfers[index]);
-            break;
-        }
-    }
+    BRCryptoWalletTransferEntry entry = BRSetGet (wallet->transfersIndex, &key);
+    while (NULL != entry && CRYPTO_FALSE == cryptoTransferHasBTC (entry->transfer, btc))
+        entry = entry->next;
+    BRCryptoTransfer transfer = (NULL == entry ? NULL : cryptoTransferTake (entry->transfer));
     pthread_mutex_unlock (&wallet->lock);
     return transfer;
 }
@@ -245,14 +362,13 @@ cryptoWalletFindTransferAsBTC (BRCryptoWallet wallet,
 private_extern BRCryptoTransfer
 cryptoWalletFindTransferAsETH (BRCryptoWallet wallet,
                                BREthereumTransfer eth) {
-    BRCryptoTransfer transfer = NULL;
+    struct BRCryptoWalletTransferEntryRecord key = { BLOCK_CHAIN_TYPE_ETH, { .eth = eth } };
+
     pthread_mutex_lock (&wallet->lock);
-    for (size_t index = 0; index < array_count(wallet->transfers); index++) {
-        if (CRYPTO_TRUE == cryptoTransferHasETH (wallet->transfers[index], eth)) {
-            transfer = cryptoTransferTake (wallet->transfers[index]);
-            break;
-        }
-    }
+    BRCryptoWalletTransferEntry entry = BRSetGet (wallet->transfersIndex, &key);
+    while (NULL != entry && CRYPTO_FALSE == cryptoTransferHasETH (entry->transfer, eth))
+        entry = entry->next;
+    BRCryptoTransfer transfer = (NULL == entry ? NULL : cryptoTransferTake (entry->transfer));
     pthread_mutex_unlock (&wallet->lock);
     return transfer;
 }
@@ -260,14 +376,13 @@ cryptoWalletFindTransferAsETH (BRCryptoWallet wallet,
 private_extern BRCryptoTransfer
 cryptoWalletFindTransferAsGEN (BRCryptoWallet wallet,
                                BRGenericTransfer gen) {
-    BRCryptoTransfer transfer = NULL;
+    struct BRCryptoWalletTransferEntryRecord key = { BLOCK_CHAIN_TYPE_GEN, { .gen = genTransferGetHash (gen) } };
+
     pthread_mutex_lock (&wallet->lock);
-    for (size_t index = 0; index < array_count(wallet->transfers); index++) {
-        if (CRYPTO_TRUE == cryptoTransferHasGEN (wallet->transfers[index], gen)) {
-            transfer = cryptoTransferTake (wallet->transfers[index]);
-            break;
-        }
-    }
+    BRCryptoWalletTransferEntry entry = BRSetGet (wallet->transfersIndex, &key);
+    while (NULL != entry && CRYPTO_FALSE == cryptoTransferHasGEN (entry->transfer, gen))
+        entry = entry->next;
+    BRCryptoTransfer transfer = (NULL == entry ? NULL : cryptoTransferTake (entry->transfer));
     pthread_mutex_unlock (&wallet->lock);
     return transfer;
 }
@@ -276,8 +391,24 @@ extern void
 cryptoWalletAddTransfer (BRCryptoWallet wallet,
                          BRCryptoTransfer transfer) {
     pthread_mutex_lock (&wallet->lock);
-    if (CRYPTO_FALSE == cryptoWalletHasTransfer (wallet, transfer)) {
-        array_add (wallet->transfers, cryptoTransferTake(transfer));
+    if (NULL == cryptoWalletFindTransferEntry (wallet, transfer, NULL)) {
+        BRCryptoWalletTransferEntry entry = malloc (sizeof (struct BRCryptoWalletTransferEntryRecord));
+
+        *entry = cryptoWalletTransferEntryKey (transfer);
+        entry->transfer = cryptoTransferTake (transfer);
+        entry->index    = array_count (wallet->transfers);
+        entry->version  = ++wallet->transfersVersion;
+        entry->next     = NULL;
+
+        array_add (wallet->transfers, entry);
+
+        // Chain `entry` after any others with the same key; otherwise it is the first.
+        BRCryptoWalletTransferEntry last = BRSetGet (wallet->transfersIndex, entry);
+        if (NULL == last) BRSetAdd (wallet->transfersIndex, entry);
+        else {
+            while (NULL != last->next) last = last->next;
+            last->next = entry;
+        }
     }
     pthread_mutex_unlock (&wallet->lock);
 }
@@ -286,34 +417,194 @@ extern void
 cryptoWalletRemTransfer (BRCryptoWallet wallet, BRCryptoTransfer transfer) {
     BRCryptoTransfer walletTransfer = NULL;
     pthread_mutex_lock (&wallet->lock);
-    for (size_t index = 0; index < array_count(wallet->transfers); index++) {
-        if (CRYPTO_TRUE == cryptoTransferEqual (wallet->transfers[index], transfer)) {
-            walletTransfer = wallet->transfers[index];
-            array_rm (wallet->transfers, index);
-            break;
-        }
+    BRCryptoWalletTransferEntry previous;
+    BRCryptoWalletTransferEntry entry = cryptoWalletFindTransferEntry (wallet, transfer, &previous);
+    if (NULL != entry) {
+        walletTransfer = entry->transfer;
+        wallet->transfers[entry->index] = NULL;
+        wallet->transfersRemoved += 1;
+        wallet->transfersRemovedVersion = ++wallet->transfersVersion;
+
+        // Unchain `entry`; if first, then the next one, if any, replaces it in the index.
+        if      (NULL != previous)    previous->next = entry->next;
+        else if (NULL != entry->next) BRSetAdd    (wallet->transfersIndex, entry->next);
+        else                          BRSetRemove (wallet->transfersIndex, entry);
+        free (entry);
+
+        if (2 * wallet->transfersRemoved > array_count (wallet->transfers))
+            cryptoWalletCompactTransfers (wallet);
     }
     pthread_mutex_unlock (&wallet->lock);
 
     // drop reference outside of lock to avoid potential case where release function runs
-    if (NULL != walletTransfer) cryptoTransferGive (transfer);
+    if (NULL != walletTransfer) cryptoTransferGive (walletTransfer);
 }
 
 extern BRCryptoTransfer *
 cryptoWalletGetTransfers (BRCryptoWallet wallet, size_t *count) {
     pthread_mutex_lock (&wallet->lock);
-    *count = array_count (wallet->transfers);
+    *count = array_count (wallet->transfers) - wallet->transfersRemoved;
     BRCryptoTransfer *transfers = NULL;
     if (0 != *count) {
         transfers = calloc (*count, sizeof(BRCryptoTransfer));
-        for (size_t index = 0; index < *count; index++) {
-            transfers[index] = cryptoTransferTake(wallet->transfers[index]);
+        for (size_t index = 0, found = 0; index < array_count (wallet->transfers); index++) {
+            if (NULL != wallet->transfers[index])
+                transfers[found++] = cryptoTransferTake(wallet->transfers[index]->transfer);
         }
     }
     pthread_mutex_unlock (&wallet->lock);
     return transfers;
 }
 
+private_extern void
+cryptoWalletUpdTransfer (BRCryptoWallet wallet,
+                         BRCryptoTransfer transfer) {
+    pthread_mutex_lock (&wallet->lock);
+    BRCryptoWalletTransferEntry entry = cryptoWalletFindTransferEntry (wallet, transfer, NULL);
+    if (NULL != entry) entry->version = ++wallet->transfersVersion;
+    pthread_mutex_unlock (&wallet->lock);
+}
+
+extern uint64_t
+cryptoWalletGetTransfersVersion (BRCryptoWallet wallet) {
+    pthread_mutex_lock (&wallet->lock);
+    uint64_t version = wallet->transfersVersion;
+    pthread_mutex_unlock (&wallet->lock);
+    return version;
+}
+
+extern BRCryptoTransfer *
+cryptoWalletGetTransfersChangedSince (BRCryptoWallet wallet,
+                                      uint64_t version,
+                                      BRCryptoBoolean *hasRemoved,
+                                      size_t *count) {
+    BRArrayOf(BRCryptoTransfer) changed;
+    array_new (changed, 10);
+
+    pthread_mutex_lock (&wallet->lock);
+    for (size_t index = 0; index < array_count (wallet->transfers); index++) {
+        BRCryptoWalletTransferEntry entry = wallet->transfers[index];
+        if (NULL != entry && entry->version > version)
+            array_add (changed, cryptoTransferTake (entry->transfer));
+    }
+    *hasRemoved = AS_CRYPTO_BOOLEAN (wallet->transfersRemovedVersion > version);
+    pthread_mutex_unlock (&wallet->lock);
+
+    *count = array_count (changed);
+    BRCryptoTransfer *transfers = NULL;
+    if (0 != *count) {
+        transfers = calloc (*count, sizeof(BRCryptoTransfer));
+        memcpy (transfers, changed, *count * sizeof(BRCryptoTransfer));
+    }
+    array_free (changed);
+    return transfers;
+}
+
+/// MARK: - Transfers Snapshot
+
+struct BRCryptoWalletTransfersRecord {
+    uint64_t version;
+    BRArrayOf(BRCryptoTransfer) transfers;  // taken; newest first
+    BRCryptoRef ref;
+};
+
+IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoWalletTransfers, cryptoWalletTransfers)
+
+static void
+cryptoWalletTransfersRelease (BRCryptoWalletTransfers snapshot) {
+    array_free_all (snapshot->transfers, cryptoTransferGive);
+
+    memset (snapshot, 0, sizeof(*snapshot));
+    free (snapshot);
+}
+
+static int
+cryptoWalletTransfersCompareNewestFirst (const void *transferPtr1, const void *transferPtr2) {
+    switch (cryptoTransferCompare (*((BRCryptoTransfer *) transferPtr1),
+                                   *((BRCryptoTransfer *) transferPtr2))) {
+        case CRYPTO_COMPARE_LT: return +1;
+        case CRYPTO_COMPARE_EQ: return  0;
+        case CRYPTO_COMPARE_GT: return -1;
+    }
+}
+
+extern BRCryptoWalletTransfers
+cryptoWalletGetTransfersSnapshot (BRCryptoWallet wallet) {
+    BRCryptoWalletTransfers snapshot = NULL;
+
+    pthread_mutex_lock (&wallet->lock);
+    if (NULL != wallet->transfersSnapshot &&
+        wallet->transfersSnapshot->version == wallet->transfersVersion) {
+        snapshot = cryptoWalletTransfersTake (wallet->transfersSnapshot);
+        pthread_mutex_unlock (&wallet->lock);
+        return snapshot;
+    }
+
+    snapshot = calloc (1, sizeof (struct BRCryptoWalletTransfersRecord));
+    snapshot->version = wallet->transfersVersion;
+    snapshot->ref     = CRYPTO_REF_ASSIGN (cryptoWalletTransfersRelease);
+
+    array_new (snapshot->transfers, array_count (wallet->transfers) - wallet->transfersRemoved);
+    for (size_t index = 0; index < array_count (wallet->transfers); index++)
+        if (NULL != wallet->transfers[index])
+            array_add (snapshot->transfers, cryptoTransferTake (wallet->transfers[index]->transfer));
+    pthread_mutex_unlock (&wallet->lock);
+
+    // Sort outside of the wallet lock; `cryptoTransferCompare()` locks each transfer.
+    qsort (snapshot->transfers, array_count (snapshot->transfers), sizeof (BRCryptoTransfer),
+           cryptoWalletTransfersCompareNewestFirst);
+
+    // Cache `snapshot` unless the wallet's transfers changed while sorting.
+    BRCryptoWalletTransfers replaced = NULL;
+    pthread_mutex_lock (&wallet->lock);
+    if (snapshot->version == wallet->transfersVersion &&
+        (NULL == wallet->transfersSnapshot || wallet->transfersSnapshot->version != snapshot->version)) {
+        replaced = wallet->transfersSnapshot;
+        wallet->transfersSnapshot = cryptoWalletTransfersTake (snapshot);
+    }
+    pthread_mutex_unlock (&wallet->lock);
+
+    if (NULL != replaced) cryptoWalletTransfersGive (replaced);
+    return snapshot;
+}
+
+extern uint64_t
+cryptoWalletTransfersGetVersion (BRCryptoWalletTransfers snapshot) {
+    return snapshot->version;
+}
+
+extern size_t
+cryptoWalletTransfersGetCount (BRCryptoWalletTransfers snapshot) {
+    return array_count (snapshot->transfers);
+}
+
+extern BRCryptoTransfer
+cryptoWalletTransfersGetAt (BRCryptoWalletTransfers snapshot,
+                            size_t index) {
+    assert (index < array_count (snapshot->transfers));
+    return snapshot->transfers[index];
+}
+
+extern BRCryptoTransfer *
+cryptoWalletGetTransfersPaged (BRCryptoWallet wallet,
+                               size_t offset,
+                               size_t limit,
+                               size_t *count) {
+    BRCryptoWalletTransfers snapshot = cryptoWalletGetTransfersSnapshot (wallet);
+    size_t snapshotCount = array_count (snapshot->transfers);
+
+    *count = (offset >= snapshotCount ? 0 : (limit < snapshotCount - offset ? limit : snapshotCount - offset));
+    BRCryptoTransfer *transfers = NULL;
+    if (0 != *count) {
+        transfers = calloc (*count, sizeof(BRCryptoTransfer));
+        for (size_t index = 0; index < *count; index++)
+            transfers[index] = cryptoTransferTake (snapshot->transfers[offset + index]);
+    }
+
+    cryptoWalletTransfersGive (snapshot);
+    return transfers;
+}
+
 extern BRCryptoAddress
 cryptoWalletGetAddress (BRCryptoWallet wallet,
                         BRCryptoAddressScheme addressScheme) {
@@ -9,6 +9,8 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <assert.h>
+#include <errno.h>
+#include <sys/time.h>
 #include <arpa/inet.h>      // struct in_addr
 
 #include "BRCryptoBase.h"
@@ -30,6 +32,7 @@
 #include "bitcoin/BRWalletManager.h"
 #include "ethereum/BREthereum.h"
 #include "support/BRFileService.h"
+#include "support/BROSCompat.h"
 
 uint64_t BLOCK_HEIGHT_UNBOUND_VALUE = UINT64_MAX;
 
@@ -45,6 +48,286 @@ cryptoWalletManagerSyncCallbackGEN (BRGenericManagerSyncContext context,
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoWalletManager, cryptoWalletManager)
 
+/// =============================================================================================
+///
+/// MARK: - Batched Listener
+///
+///
+
+#define CWM_LISTENER_BATCHER_THREAD_NAME        "Core Crypto Listener"
+#define CWM_LISTENER_BATCHER_PTHREAD_STACK_SIZE (512 * 1024)
+
+typedef struct {
+    BRCryptoCWMListenerEvent event;
+    int coalesced;  // if set, `event` is replaced by a later one and has been released
+} BRCryptoCWMListenerBatchEntry;
+
+typedef struct {
+    BRCryptoWallet wallet;
+    size_t index;
+} BRCryptoCWMListenerBatchBalance;
+
+struct BRCryptoCWMListenerBatcherRecord {
+    BRCryptoCWMBatchedListener listener;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int quit;
+    int releaseOnQuit;
+
+    /// The pending batch; `deadline` is set when the first event is added.  If `flush` is set,
+    /// the batch is delivered without waiting for the deadline or the `eventsLimit`.
+    BRArrayOf(BRCryptoCWMListenerBatchEntry) entries;
+    struct timespec deadline;
+    int flush;
+
+    /// The index in `entries` of each wallet's latest BALANCE_UPDATED event and of the latest
+    /// SYNC_CONTINUES event, if any.
+    BRArrayOf(BRCryptoCWMListenerBatchBalance) balances;
+    size_t syncContinues;
+};
+
+static void
+cryptoCWMListenerEventRelease (BRCryptoCWMListenerEvent *event) {
+    cryptoWalletManagerGive (event->manager);
+    if (NULL != event->wallet)   cryptoWalletGive   (event->wallet);
+    if (NULL != event->transfer) cryptoTransferGive (event->transfer);
+
+    // Only the coalesced events are released, which are BALANCE_UPDATED and SYNC_CONTINUES
+    if (CRYPTO_CWM_LISTENER_EVENT_WALLET == event->type &&
+        CRYPTO_WALLET_EVENT_BALANCE_UPDATED == event->u.wallet.type)
+        cryptoAmountGive (event->u.wallet.u.balanceUpdated.amount);
+}
+
+static void *
+cryptoCWMListenerBatcherThread (BRCryptoCWMListenerBatcher batcher) {
+    pthread_setname_brd (pthread_self(), CWM_LISTENER_BATCHER_THREAD_NAME);
+
+    pthread_mutex_lock (&batcher->lock);
+    while (1) {
+        size_t count = array_count (batcher->entries);
+
+        if (0 == count) {
+            if (batcher->quit) break;
+            pthread_cond_wait (&batcher->cond, &batcher->lock);
+            continue;
+        }
+
+        // Wait for more events, until the batch is full, flushed or at its deadline.
+        if (count < batcher->listener.eventsLimit && !batcher->quit && !batcher->flush &&
+            ETIMEDOUT != pthread_cond_timedwait (&batcher->cond, &batcher->lock, &batcher->deadline))
+            continue;
+
+        // Deliver the batch, less the coalesced events, outside of the lock.
+        BRArrayOf(BRCryptoCWMListenerBatchEntry) entries = batcher->entries;
+        count = array_count (entries);
+        array_new (batcher->entries, batcher->listener.eventsLimit);
+        array_clear (batcher->balances);
+        batcher->syncContinues = SIZE_MAX;
+        batcher->flush = 0;
+        pthread_mutex_unlock (&batcher->lock);
+
+        BRCryptoCWMListenerEvent *events = calloc (count, sizeof (BRCryptoCWMListenerEvent));
+        size_t eventsCount = 0;
+        for (size_t index = 0; index < count; index++)
+            if (!entries[index].coalesced)
+                events[eventsCount++] = entries[index].event;
+        array_free (entries);
+
+        batcher->listener.eventsCallback (batcher->listener.context, events, eventsCount);
+
+        pthread_mutex_lock (&batcher->lock);
+    }
+    int release = batcher->releaseOnQuit;
+    pthread_mutex_unlock (&batcher->lock);
+
+    // The final manager reference was given while delivering a batch; release here, as the
+    // manager's release could not wait on this thread.
+    if (release) {
+        array_free (batcher->entries);
+        array_free (batcher->balances);
+        pthread_cond_destroy  (&batcher->cond);
+        pthread_mutex_destroy (&batcher->lock);
+        free (batcher);
+    }
+    return NULL;
+}
+
+static BRCryptoCWMListenerBatcher
+cryptoCWMListenerBatcherCreate (BRCryptoCWMBatchedListener listener) {
+    BRCryptoCWMListenerBatcher batcher = calloc (1, sizeof (struct BRCryptoCWMListenerBatcherRecord));
+
+    batcher->listener = listener;
+    if (0 == batcher->listener.eventsLimit) batcher->listener.eventsLimit = 1;
+
+    batcher->quit = 0;
+    batcher->releaseOnQuit = 0;
+    batcher->flush = 0;
+    array_new (batcher->entries,  batcher->listener.eventsLimit);
+    array_new (batcher->balances, 5);
+    batcher->syncContinues = SIZE_MAX;
+
+    pthread_mutex_init (&batcher->lock, NULL);
+    pthread_cond_init  (&batcher->cond, NULL);
+
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+    pthread_attr_setstacksize (&attr, CWM_LISTENER_BATCHER_PTHREAD_STACK_SIZE);
+    pthread_create (&batcher->thread, &attr, (ThreadRoutine) cryptoCWMListenerBatcherThread, batcher);
+    pthread_attr_destroy (&attr);
+
+    return batcher;
+}
+
+static void
+cryptoCWMListenerBatcherRelease (BRCryptoCWMListenerBatcher batcher) {
+    pthread_mutex_lock (&batcher->lock);
+    // Every pending event holds a manager reference; with the manager released, none remain.
+    assert (0 == array_count (batcher->entries));
+
+    int onBatcherThread = pthread_equal (pthread_self(), batcher->thread);
+    batcher->quit = 1;
+    batcher->releaseOnQuit = onBatcherThread;
+    pthread_cond_signal (&batcher->cond);
+    pthread_mutex_unlock (&batcher->lock);
+
+    if (onBatcherThread) {
+        pthread_detach (batcher->thread);
+        return;
+    }
+
+    pthread_join (batcher->thread, NULL);
+
+    array_free (batcher->entries);
+    array_free (batcher->balances);
+    pthread_cond_destroy  (&batcher->cond);
+    pthread_mutex_destroy (&batcher->lock);
+    free (batcher);
+}
+
+/**
+ * Deliver the pending batch, if any, without waiting for its deadline.
+ */
+static void
+cryptoCWMListenerBatcherFlush (BRCryptoCWMListenerBatcher batcher) {
+    pthread_mutex_lock (&batcher->lock);
+    if (0 != array_count (batcher->entries)) {
+        batcher->flush = 1;
+        pthread_cond_signal (&batcher->cond);
+    }
+    pthread_mutex_unlock (&batcher->lock);
+}
+
+/**
+ * Add `event` to the pending batch, coalescing it with an earlier BALANCE_UPDATED, for the same
+ * wallet, or SYNC_CONTINUES event.  The manager's disconnect or deletion flushes the batch.
+ */
+static void
+cryptoCWMListenerBatcherAdd (BRCryptoCWMListenerBatcher batcher,
+                             BRCryptoCWMListenerEvent event) {
+    pthread_mutex_lock (&batcher->lock);
+    size_t index = array_count (batcher->entries);
+
+    if (CRYPTO_CWM_LISTENER_EVENT_WALLET == event.type &&
+        CRYPTO_WALLET_EVENT_BALANCE_UPDATED == event.u.wallet.type) {
+        size_t balance = 0;
+        while (balance < array_count (batcher->balances) &&
+               batcher->balances[balance].wallet != event.wallet)
+            balance++;
+
+        if (balance == array_count (batcher->balances))
+            array_add (batcher->balances, ((BRCryptoCWMListenerBatchBalance) { event.wallet, index }));
+        else {
+            BRCryptoCWMListenerBatchEntry *earlier = &batcher->entries[batcher->balances[balance].index];
+            cryptoCWMListenerEventRelease (&earlier->event);
+            earlier->coalesced = 1;
+            batcher->balances[balance].index = index;
+        }
+    }
+
+    else if (CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER == event.type &&
+             CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES == event.u.manager.type) {
+        if (SIZE_MAX != batcher->syncContinues) {
+            BRCryptoCWMListenerBatchEntry *earlier = &batcher->entries[batcher->syncContinues];
+            cryptoCWMListenerEventRelease (&earlier->event);
+            earlier->coalesced = 1;
+        }
+        batcher->syncContinues = index;
+    }
+
+    else if (CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER == event.type &&
+             ((CRYPTO_WALLET_MANAGER_EVENT_CHANGED == event.u.manager.type &&
+               (CRYPTO_WALLET_MANAGER_STATE_DISCONNECTED == event.u.manager.u.state.newValue.type ||
+                CRYPTO_WALLET_MANAGER_STATE_DELETED      == event.u.manager.u.state.newValue.type)) ||
+              CRYPTO_WALLET_MANAGER_EVENT_DELETED == event.u.manager.type))
+        batcher->flush = 1;
+
+    array_add (batcher->entries, ((BRCryptoCWMListenerBatchEntry) { event, 0 }));
+
+    // The first event sets the deadline; a full or flushed batch is delivered now.
+    if (0 == index) {
+        struct timeval now;
+        gettimeofday (&now, NULL);
+
+        uint64_t nanoseconds = 1000 * (uint64_t) now.tv_usec + 1000000 * batcher->listener.latencyInMilliseconds;
+        batcher->deadline = (struct timespec) {
+            .tv_sec  = now.tv_sec + (time_t) (nanoseconds / 1000000000),
+            .tv_nsec = (long) (nanoseconds % 1000000000)
+        };
+    }
+
+    if (0 == index || batcher->flush || array_count (batcher->entries) >= batcher->listener.eventsLimit)
+        pthread_cond_signal (&batcher->cond);
+    pthread_mutex_unlock (&batcher->lock);
+}
+
+static void
+cryptoCWMListenerBatcherWalletManagerEvent (BRCryptoCWMListenerContext context,
+                                            BRCryptoWalletManager manager,
+                                            BRCryptoWalletManagerEvent event) {
+    cryptoCWMListenerBatcherAdd ((BRCryptoCWMListenerBatcher) context,
+                                 (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER,
+        manager,
+        NULL,
+        NULL,
+        { .manager = event }
+    });
+}
+
+static void
+cryptoCWMListenerBatcherWalletEvent (BRCryptoCWMListenerContext context,
+                                     BRCryptoWalletManager manager,
+                                     BRCryptoWallet wallet,
+                                     BRCryptoWalletEvent event) {
+    cryptoCWMListenerBatcherAdd ((BRCryptoCWMListenerBatcher) context,
+                                 (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET,
+        manager,
+        wallet,
+        NULL,
+        { .wallet = event }
+    });
+}
+
+static void
+cryptoCWMListenerBatcherTransferEvent (BRCryptoCWMListenerContext context,
+                                       BRCryptoWalletManager manager,
+                                       BRCryptoWallet wallet,
+                                       BRCryptoTransfer transfer,
+                                       BRCryptoTransferEvent event) {
+    cryptoCWMListenerBatcherAdd ((BRCryptoCWMListenerBatcher) context,
+                                 (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_TRANSFER,
+        manager,
+        wallet,
+        transfer,
+        { .transfer = event }
+    });
+}
+
 /// =============================================================================================
 ///
 /// MARK: - Wallet Manager
@@ -152,18 +435,21 @@ cryptoWalletManagerWipe (BRCryptoNetwork network,
     }
 }
 
-extern BRCryptoWalletManager
-cryptoWalletManagerCreate (BRCryptoCWMListener listener,
-                           BRCryptoClient client,
-                           BRCryptoAccount account,
-                           BRCryptoNetwork network,
-                           BRCryptoSyncMode mode,
-                           BRCryptoAddressScheme scheme,
-                           const char *path) {
+static BRCryptoWalletManager
+cryptoWalletManagerCreateWithBatcher (BRCryptoCWMListener listener,
+                                      OwnershipGiven BRCryptoCWMListenerBatcher batcher,
+                                      BRCryptoClient client,
+                                      BRCryptoAccount account,
+                                      BRCryptoNetwork network,
+                                      BRCryptoSyncMode mode,
+                                      BRCryptoAddressScheme scheme,
+                                      const char *path) {
 
     // Only create a wallet manager for accounts that are initializedon network.
-    if (CRYPTO_FALSE == cryptoAccountIsInitialized (account, network))
+    if (CRYPTO_FALSE == cryptoAccountIsInitialized (account, network)) {
+        if (NULL != batcher) cryptoCWMListenerBatcherRelease (batcher);
         return NULL;
+    }
 
     // In rare cases a Wallet Manager cannot be created.  If not, we'll perform a 'goto' and, on
     // `1 == error`, perform some cleanup actions.
@@ -179,6 +465,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
                                                                      network,
                                                                      scheme,
                                                                      cwmPath);
+    cwm->batcher = batcher;
 
     // Primary wallet currency and unit.
     BRCryptoCurrency currency = cryptoNetworkGetCurrency (cwm->network);
@@ -214,16 +501,24 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
         case BLOCK_CHAIN_TYPE_ETH: {
             BREthereumClient client = cryptoWalletManagerClientCreateETHClient (cwm);
 
+            // In a P2P sync mode, all the EWMs on `network` share one LES node pool.  If there
+            // is none yet, the EWM creates one.  Left in cryptoWalletManagerRelease().
+            BREthereumLES les = cryptoNetworkJoinSharedLES (network);
+
             // Create EWM - will also create the EWM primary wallet....
             cwm->u.eth = ewmCreate (cryptoNetworkAsETH(network),
                                     cryptoAccountAsETH(account),
                                     (BREthereumTimestamp) cryptoAccountGetTimestamp(account),
                                     mode,
+                                    les,
                                     client,
                                     cwmPath,
                                     cryptoNetworkGetHeight(network),
                                     cryptoNetworkGetConfirmationsUntilFinal (network));
-            if (NULL == cwm->u.eth) { error = 1; break; }
+            if (NULL == cwm->u.eth) { cryptoNetworkLeaveSharedLES (network); error = 1; break; }
+
+            // ... share the EWM's LES, if it created one ...
+            if (NULL == les) cryptoNetworkSetSharedLES (network, ewmGetLES (cwm->u.eth));
 
             // ... get the CWM primary wallet in place...
             cwm->wallet = cryptoWalletCreateAsETH (unit, unit, cwm->u.eth, ewmGetWallet(cwm->u.eth));
@@ -337,12 +632,46 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
     return cwm;
 }
 
+extern BRCryptoWalletManager
+cryptoWalletManagerCreate (BRCryptoCWMListener listener,
+                           BRCryptoClient client,
+                           BRCryptoAccount account,
+                           BRCryptoNetwork network,
+                           BRCryptoSyncMode mode,
+                           BRCryptoAddressScheme scheme,
+                           const char *path) {
+    return cryptoWalletManagerCreateWithBatcher (listener, NULL, client, account, network, mode, scheme, path);
+}
+
+extern BRCryptoWalletManager
+cryptoWalletManagerCreateBatched (BRCryptoCWMBatchedListener listener,
+                                  BRCryptoClient client,
+                                  BRCryptoAccount account,
+                                  BRCryptoNetwork network,
+                                  BRCryptoSyncMode mode,
+                                  BRCryptoAddressScheme scheme,
+                                  const char *path) {
+    BRCryptoCWMListenerBatcher batcher = cryptoCWMListenerBatcherCreate (listener);
+
+    return cryptoWalletManagerCreateWithBatcher ((BRCryptoCWMListener) {
+                                                     batcher,
+                                                     cryptoCWMListenerBatcherWalletManagerEvent,
+                                                     cryptoCWMListenerBatcherWalletEvent,
+                                                     cryptoCWMListenerBatcherTransferEvent
+                                                 },
+                                                 batcher,
+                                                 client, account, network, mode, scheme, path);
+}
+
 static void
 cryptoWalletManagerRelease (BRCryptoWalletManager cwm) {
     // Ensure CWM is stopped...
     cryptoWalletManagerStop (cwm);
 
-    // ... then release memory.
+    // ... then release memory.  The EWM holds its own reference to a shared LES.
+    if (BLOCK_CHAIN_TYPE_ETH == cwm->type && NULL != cwm->u.eth)
+        cryptoNetworkLeaveSharedLES (cwm->network);
+
     cryptoAccountGive (cwm->account);
     cryptoNetworkGive (cwm->network);
     if (NULL != cwm->wallet) cryptoWalletGive (cwm->wallet);
@@ -369,6 +698,8 @@ cryptoWalletManagerRelease (BRCryptoWalletManager cwm) {
 
     free (cwm->path);
 
+    if (NULL != cwm->batcher) cryptoCWMListenerBatcherRelease (cwm->batcher);
+
     pthread_mutex_destroy (&cwm->lock);
 
     memset (cwm, 0, sizeof(*cwm));
@@ -392,6 +723,9 @@ cryptoWalletManagerStop (BRCryptoWalletManager cwm) {
                 genManagerStop (cwm->u.gen);
             break;
     }
+
+    // Deliver any batched events now, rather than at their deadline
+    if (NULL != cwm->batcher) cryptoCWMListenerBatcherFlush (cwm->batcher);
 }
 
 extern BRCryptoNetwork
@@ -826,6 +1160,7 @@ cryptoWalletManagerSetTransferStateGEN (BRCryptoWalletManager cwm,
 
         genTransferSetState (genericTransfer, newGenericState);
         cryptoTransferSetState (transfer, newState);
+        cryptoWalletUpdTransfer (wallet, transfer);
 
         cryptoTransferStateRelease (&oldState);
         cryptoTransferStateRelease (&newState);
@@ -1510,6 +1845,7 @@ cryptoWalletManagerHandleTransferGEN (BRCryptoWalletManager cwm,
     BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
     BRCryptoTransferState newState = cryptoTransferStateCreateGEN (genTransferGetState(transferGeneric), unitForFee);
     cryptoTransferSetState (transfer, newState);
+    cryptoWalletUpdTransfer (wallet, transfer);
 
     if (!transferWasCreated)
         genTransferRelease(transferGeneric);
@@ -12,6 +12,7 @@
 #include <math.h>  // round()
 #include <stdbool.h>
 #include <ctype.h>
+#include <time.h>
 
 #include "BRCryptoBase.h"
 #include "BRCryptoStatusP.h"
@@ -28,6 +29,7 @@
 #include "bitcoin/BRWalletManager.h"
 #include "ethereum/BREthereum.h"
 #include "support/BRBase.h"
+#include "support/BRKey.h"      // BRRand()
 
 typedef enum  {
     CWM_CALLBACK_TYPE_BTC_GET_BLOCK_NUMBER,
@@ -47,6 +49,12 @@ typedef enum  {
 
 } BRCryptoCWMCallbackType;
 
+typedef enum {
+    CWM_REQUEST_PRIORITY_NONE,          // Not scheduled; see cwmGetLogsAsETH()
+    CWM_REQUEST_PRIORITY_USER,          // For the user; never waits
+    CWM_REQUEST_PRIORITY_BACKGROUND,    // For a sync; waits for a slot and any backoff
+} BRCryptoCWMRequestPriority;
+
 struct BRCryptoClientCallbackStateRecord {
     BRCryptoCWMCallbackType type;
     union {
@@ -64,6 +72,12 @@ struct BRCryptoClientCallbackStateRecord {
             BREthereumWallet wid;
             BREthereumTransfer tid;
         } ethWithTransaction;
+        struct {
+            // The items announced for the request, given to the EWM at once on its completion;
+            // see cwmAnnounceGetTransfersComplete()
+            BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) transactions;
+            BRArrayOf(BREthereumEWMClientAnnounceLogBundle) logs;
+        } ethWithTransfers;
 
         struct {
             BRGenericWallet wid;
@@ -74,20 +88,341 @@ struct BRCryptoClientCallbackStateRecord {
         } genWithTransaction;
     } u;
     int rid;
+
+    // Scheduling on the network; see cwmRequestSchedule()
+    BRCryptoCWMRequestPriority priority;
+    BRCryptoClientRequest request;      // A background request, kept for a retry; or NULL
+    time_t issued;                      // When made of the client; 0 if not in flight
 };
 
+static void
+cwmClientRequestRelease (BRCryptoClientRequest request);
+
 static void
 cwmClientCallbackStateRelease (BRCryptoClientCallbackState state) {
     switch (state->type) {
         case CWM_CALLBACK_TYPE_GEN_SUBMIT_TRANSACTION:
             genTransferRelease (state->u.genWithTransaction.tid);
             break;
+        case CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS:
+            array_free (state->u.ethWithTransfers.transactions);
+            array_free (state->u.ethWithTransfers.logs);
+            break;
         default:
             break;
     }
+    if (NULL != state->request) cwmClientRequestRelease (state->request);
     free (state);
 }
 
+/// MARK: - Scheduled Requests
+
+struct BRCryptoClientRequestRecord {
+    BRCryptoWalletManager manager;
+    BRCryptoClientCallbackState callbackState;
+
+    // The arguments of `funcGetTransfers` or `funcGetTransactions`
+    BRCryptoBoolean asTransfers;
+    BRArrayOf(char *) addresses;
+    uint64_t begBlockNumber;
+    uint64_t endBlockNumber;
+
+    unsigned int retries;
+};
+
+static BRCryptoClientRequest
+cwmClientRequestCreate (BRCryptoWalletManager cwm,
+                        BRCryptoClientCallbackState callbackState,
+                        BRCryptoBoolean asTransfers,
+                        OwnershipKept const char **addresses,
+                        size_t addressCount,
+                        uint64_t begBlockNumber,
+                        uint64_t endBlockNumber) {
+    BRCryptoClientRequest request = calloc (1, sizeof (struct BRCryptoClientRequestRecord));
+
+    request->manager = cryptoWalletManagerTake (cwm);
+    request->callbackState = callbackState;
+    request->asTransfers = asTransfers;
+
+    array_new (request->addresses, addressCount);
+    for (size_t index = 0; index < addressCount; index++)
+        array_add (request->addresses, strdup (addresses[index]));
+
+    request->begBlockNumber = begBlockNumber;
+    request->endBlockNumber = endBlockNumber;
+    request->retries = 0;
+
+    return request;
+}
+
+static void
+cwmClientRequestRelease (BRCryptoClientRequest request) {
+    array_free_all (request->addresses, free);
+    cryptoWalletManagerGive (request->manager);
+
+    memset (request, 0, sizeof(*request));
+    free (request);
+}
+
+/**
+ * Return the backoff, in seconds, after `failures` consecutive background failures.  The backoff
+ * doubles with each failure, up to a limit, and then is jittered over its upper half so that the
+ * networks (and the processes) that saw the same outage don't all return at the same moment.
+ */
+static time_t
+cwmRequestBackoff (unsigned int failures) {
+    time_t backoff = CWM_CLIENT_REQUEST_BACKOFF_SECONDS;
+    while (--failures > 0 && backoff < CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS)
+        backoff *= 2;
+    if (backoff > CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS)
+        backoff = CWM_CLIENT_REQUEST_BACKOFF_LIMIT_SECONDS;
+
+    return backoff / 2 + BRRand ((uint32_t) (backoff / 2 + 1));
+}
+
+/**
+ * Mark `callbackState` as in flight on `network`.  Must hold the network's lock.
+ */
+static void
+cwmRequestIssued (BRCryptoNetwork network,
+                  BRCryptoClientCallbackState callbackState,
+                  time_t now) {
+    callbackState->issued = now;
+    array_add (network->clientRequests.inFlight, callbackState);
+}
+
+/**
+ * Make the pending background requests on `network` of the client, in order, while there are
+ * free slots and no backoff.  Requests in flight for too long are presumed lost and give up
+ * their slot.
+ */
+static void
+cwmRequestDispatch (BRCryptoNetwork network) {
+    while (1) {
+        BRCryptoClientRequest request = NULL;
+        time_t now = time (NULL);
+
+        pthread_mutex_lock (&network->lock);
+        for (size_t index = array_count (network->clientRequests.inFlight); index > 0; index--) {
+            BRCryptoClientCallbackState lost = network->clientRequests.inFlight[index - 1];
+            if (now - lost->issued >= CWM_CLIENT_REQUEST_TIMEOUT_SECONDS) {
+                lost->issued = 0;
+                array_rm (network->clientRequests.inFlight, index - 1);
+            }
+        }
+
+        if (array_count (network->clientRequests.pending) > 0 &&
+            (0 == network->clientRequests.limit ||
+             array_count (network->clientRequests.inFlight) < network->clientRequests.limit) &&
+            now >= network->clientRequests.backoffUntil) {
+            request = network->clientRequests.pending[0];
+            array_rm (network->clientRequests.pending, 0);
+            cwmRequestIssued (network, request->callbackState, now);
+        }
+        pthread_mutex_unlock (&network->lock);
+
+        if (NULL == request) break;
+
+        BRCryptoWalletManager cwm = request->manager;
+        if (CRYPTO_TRUE == request->asTransfers)
+            cwm->client.funcGetTransfers (cwm->client.context,
+                                          cryptoWalletManagerTake (cwm),
+                                          request->callbackState,
+                                          (const char **) request->addresses,
+                                          array_count (request->addresses),
+                                          "__native__",
+                                          request->begBlockNumber,
+                                          request->endBlockNumber);
+        else
+            cwm->client.funcGetTransactions (cwm->client.context,
+                                             cryptoWalletManagerTake (cwm),
+                                             request->callbackState,
+                                             (const char **) request->addresses,
+                                             array_count (request->addresses),
+                                             "__native__",
+                                             request->begBlockNumber,
+                                             request->endBlockNumber);
+    }
+}
+
+/**
+ * Schedule a background 'get transfers' or 'get transactions' request, as made for a sync, on
+ * the network of `cwm`.  All the wallet managers on a network share its client, and its backend;
+ * a sync of each after a reconnect would otherwise flood both.  Thus, a background request
+ * waits for one of the network's slots (see cryptoNetworkSetClientRequestLimit()) and, after any
+ * background failure, for the backoff to expire.
+ */
+static void
+cwmRequestSchedule (BRCryptoWalletManager cwm,
+                    OwnershipGiven BRCryptoClientCallbackState callbackState,
+                    BRCryptoBoolean asTransfers,
+                    OwnershipKept const char **addresses,
+                    size_t addressCount,
+                    uint64_t begBlockNumber,
+                    uint64_t endBlockNumber) {
+    BRCryptoNetwork network = cwm->network;
+
+    callbackState->priority = CWM_REQUEST_PRIORITY_BACKGROUND;
+    callbackState->request  = cwmClientRequestCreate (cwm, callbackState, asTransfers,
+                                                      addresses, addressCount,
+                                                      begBlockNumber, endBlockNumber);
+
+    pthread_mutex_lock (&network->lock);
+    array_add (network->clientRequests.pending, callbackState->request);
+    pthread_mutex_unlock (&network->lock);
+
+    cwmRequestDispatch (network);
+}
+
+/**
+ * Mark `callbackState`, with `priority`, as in flight on the network of `cwm`.  The caller makes
+ * the client request immediately - it does not wait - but it occupies a slot until answered.
+ */
+static void
+cwmRequestBegin (BRCryptoWalletManager cwm,
+                 BRCryptoClientCallbackState callbackState,
+                 BRCryptoCWMRequestPriority priority) {
+    BRCryptoNetwork network = cwm->network;
+
+    pthread_mutex_lock (&network->lock);
+    callbackState->priority = priority;
+    cwmRequestIssued (network, callbackState, time (NULL));
+    pthread_mutex_unlock (&network->lock);
+}
+
+/**
+ * Handle the client's answer for `callbackState` on `network`, freeing its slot.  A background
+ * answer updates the backoff: a success clears it; a failure extends it.  A failed background
+ * request that is not out of retries is pended again, to be made after the backoff; in that case
+ * return CRYPTO_TRUE and the caller must not otherwise handle `callbackState`.
+ */
+static BRCryptoBoolean
+cwmRequestComplete (BRCryptoNetwork network,
+                    BRCryptoClientCallbackState callbackState,
+                    BRCryptoBoolean success) {
+    BRCryptoBoolean retry = CRYPTO_FALSE;
+
+    pthread_mutex_lock (&network->lock);
+    if (0 != callbackState->issued) {
+        callbackState->issued = 0;
+        for (size_t index = 0; index < array_count (network->clientRequests.inFlight); index++)
+            if (callbackState == network->clientRequests.inFlight[index]) {
+                array_rm (network->clientRequests.inFlight, index);
+                break;
+            }
+    }
+
+    if (CWM_REQUEST_PRIORITY_BACKGROUND == callbackState->priority) {
+        if (CRYPTO_TRUE == success) {
+            network->clientRequests.failures = 0;
+            network->clientRequests.backoffUntil = 0;
+        }
+        else {
+            network->clientRequests.failures += 1;
+            network->clientRequests.backoffUntil = time (NULL) + cwmRequestBackoff (network->clientRequests.failures);
+
+            BRCryptoClientRequest request = callbackState->request;
+            if (NULL != request && request->retries < CWM_CLIENT_REQUEST_RETRIES) {
+                request->retries += 1;
+                array_insert (network->clientRequests.pending, 0, request);
+                retry = CRYPTO_TRUE;
+            }
+        }
+    }
+    pthread_mutex_unlock (&network->lock);
+
+    cwmRequestDispatch (network);
+    return retry;
+}
+
+
+/// MARK: - Coalesced Requests
+
+static void
+cwmAnnounceGetBlockNumberSuccessInternal (BRCryptoWalletManager cwm,
+                                          OwnershipGiven BRCryptoClientCallbackState callbackState,
+                                          uint64_t blockNumber);
+
+/**
+ * Request the block number for `cwm`.  All the wallet managers on a network poll the client for
+ * the block number, often at nearly the same time.  If the network has a recent result, then we
+ * answer with that; otherwise, if the identical request is in flight, we wait on its result;
+ * otherwise, we make the client request.
+ */
+static void
+cwmRequestBlockNumber (BRCryptoWalletManager cwm,
+                       OwnershipGiven BRCryptoClientCallbackState callbackState) {
+    BRCryptoNetwork network = cwm->network;
+    time_t now = time (NULL);
+
+    int cached = 0, issue = 0;
+    uint64_t blockNumber = 0;
+
+    pthread_mutex_lock (&network->lock);
+    if (0 != network->blockNumberRequests.blockNumberTimestamp &&
+        now - network->blockNumberRequests.blockNumberTimestamp < CWM_CLIENT_BLOCK_NUMBER_CACHE_SECONDS) {
+        blockNumber = network->blockNumberRequests.blockNumber;
+        cached = 1;
+    }
+    else if (NULL != network->blockNumberRequests.leader &&
+             now - network->blockNumberRequests.leaderTimestamp < CWM_CLIENT_REQUEST_TIMEOUT_SECONDS)
+        array_add (network->blockNumberRequests.waiters,
+                   ((BRCryptoClientBlockNumberWaiter) { cryptoWalletManagerTake (cwm), callbackState }));
+    else {
+        // Nothing in flight, or what was is presumed lost.  This request leads; if the lost one
+        // is ever answered, it is answered for its own wallet manager alone.
+        network->blockNumberRequests.leader = callbackState;
+        network->blockNumberRequests.leaderTimestamp = now;
+        issue = 1;
+    }
+    pthread_mutex_unlock (&network->lock);
+
+    if (cached)
+        cwmAnnounceGetBlockNumberSuccessInternal (cwm, callbackState, blockNumber);
+    else if (issue) {
+        // As a background request, but one that never waits: polled by every wallet manager, it
+        // is the network's probe for the end of a backoff.
+        cwmRequestBegin (cwm, callbackState, CWM_REQUEST_PRIORITY_BACKGROUND);
+        cwm->client.funcGetBlockNumber (cwm->client.context,
+                                        cryptoWalletManagerTake (cwm),
+                                        callbackState);
+    }
+
+    // Any pending request whose backoff has expired is made now.
+    cwmRequestDispatch (network);
+}
+
+/**
+ * Handle the client's result for `callbackState`.  On success the network's cached block number
+ * is updated.  If `callbackState` is the request in flight, return the waiters on it; otherwise
+ * return NULL.
+ */
+static BRArrayOf(BRCryptoClientBlockNumberWaiter)
+cwmResolveBlockNumber (BRCryptoNetwork network,
+                       BRCryptoClientCallbackState callbackState,
+                       BRCryptoBoolean success,
+                       uint64_t blockNumber) {
+    BRArrayOf(BRCryptoClientBlockNumberWaiter) waiters = NULL;
+
+    pthread_mutex_lock (&network->lock);
+    if (CRYPTO_TRUE == success) {
+        network->blockNumberRequests.blockNumber = blockNumber;
+        network->blockNumberRequests.blockNumberTimestamp = time (NULL);
+    }
+
+    if (callbackState == network->blockNumberRequests.leader) {
+        network->blockNumberRequests.leader = NULL;
+
+        if (0 != array_count (network->blockNumberRequests.waiters)) {
+            waiters = network->blockNumberRequests.waiters;
+            array_new (network->blockNumberRequests.waiters, array_count (waiters));
+        }
+    }
+    pthread_mutex_unlock (&network->lock);
+
+    return waiters;
+}
+
 /// MARK: - BTC Callbacks
 
 static void
@@ -102,9 +437,7 @@ cwmGetBlockNumberAsBTC (BRWalletManagerClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_BTC_GET_BLOCK_NUMBER;
     callbackState->rid = rid;
 
-    cwm->client.funcGetBlockNumber (cwm->client.context,
-                                    cryptoWalletManagerTake (cwm),
-                                    callbackState);
+    cwmRequestBlockNumber (cwm, callbackState);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -125,14 +458,9 @@ cwmGetTransactionsAsBTC (BRWalletManagerClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_BTC_GET_TRANSACTIONS;
     callbackState->rid = rid;
 
-    cwm->client.funcGetTransactions (cwm->client.context,
-                                     cryptoWalletManagerTake (cwm),
-                                     callbackState,
-                                     addresses,
-                                     addressCount,
-                                     "__native__",
-                                     begBlockNumber,
-                                     endBlockNumber);
+    cwmRequestSchedule (cwm, callbackState, CRYPTO_FALSE,
+                        addresses, addressCount,
+                        begBlockNumber, endBlockNumber);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -157,6 +485,7 @@ cwmSubmitTransactionAsBTC (BRWalletManagerClientContext context,
     UInt256 txHash = UInt256Reverse (transactionHash);
     char *hashAsHex = hexEncodeCreate (NULL, txHash.u8, sizeof(txHash.u8));
 
+    cwmRequestBegin (cwm, callbackState, CWM_REQUEST_PRIORITY_USER);
     cwm->client.funcSubmitTransaction (cwm->client.context,
                                        cryptoWalletManagerTake (cwm),
                                        callbackState,
@@ -424,6 +753,7 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
 
             BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SUBMITTED);
             cryptoTransferSetState (transfer, newState);
+            cryptoWalletUpdTransfer (wallet, transfer);
 
             cwm->listener.transferEventCallback (cwm->listener.context,
                                                  cryptoWalletManagerTake (cwm),
@@ -454,6 +784,7 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
 
             BRCryptoTransferState newState = cryptoTransferStateErroredInit (event.u.submitFailed.error);
             cryptoTransferSetState (transfer, newState);
+            cryptoWalletUpdTransfer (wallet, transfer);
 
             cwm->listener.transferEventCallback (cwm->listener.context,
                                                  cryptoWalletManagerTake (cwm),
@@ -616,6 +947,7 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
 
             BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SIGNED);
             cryptoTransferSetState (transfer, newState);
+            cryptoWalletUpdTransfer (wallet, transfer);
 
             cwm->listener.transferEventCallback (cwm->listener.context,
                                                  cryptoWalletManagerTake (cwm),
@@ -710,6 +1042,8 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -736,6 +1070,8 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1263,6 +1599,8 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1283,6 +1621,8 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1323,6 +1663,8 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1343,6 +1685,8 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1388,6 +1732,8 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
 
                 cryptoTransferSetState (transfer, newState);
 
+                cryptoWalletUpdTransfer (wallet, transfer);
+
                 cwm->listener.transferEventCallback (cwm->listener.context,
                                                      cryptoWalletManagerTake (cwm),
                                                      cryptoWalletTake (wallet),
@@ -1465,6 +1811,7 @@ cwmGetGasEstimateAsETH (BREthereumClientContext context,
 
     char *transactionHash = ethHashAsString (ewmTransferGetOriginatingTransactionHash(ewm, tid));
 
+    cwmRequestBegin (cwm, callbackState, CWM_REQUEST_PRIORITY_USER);
     cwm->client.funcEstimateTransactionFee (cwm->client.context,
                                             cryptoWalletManagerTake (cwm),
                                             callbackState,
@@ -1497,6 +1844,7 @@ cwmSubmitTransactionAsETH (BREthereumClientContext context,
     callbackState->u.ethWithTransaction.tid = tid;
     callbackState->rid = rid;
 
+    cwmRequestBegin (cwm, callbackState, CWM_REQUEST_PRIORITY_USER);
     cwm->client.funcSubmitTransaction (cwm->client.context,
                                        cryptoWalletManagerTake(cwm),
                                        callbackState,
@@ -1530,6 +1878,8 @@ cwmGetTransactionsAsETH (BREthereumClientContext context,
     BRCryptoClientCallbackState callbackState = calloc (1, sizeof(struct BRCryptoClientCallbackStateRecord));
     callbackState->type = CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS;
     callbackState->rid = rid;
+    array_new (callbackState->u.ethWithTransfers.transactions, 10);
+    array_new (callbackState->u.ethWithTransfers.logs, 10);
 
     // ETH addresses are formally case-insensitive.  Other blockchains, such at BTC, are formally
     // case-sensitive.  Therefore the defined `funcGetTransfers` interface cannot force a specific
@@ -1546,12 +1896,9 @@ cwmGetTransactionsAsETH (BREthereumClientContext context,
     char *addresses[NUMBER_OF_ADDRESSES];
     addresses[0] = strcase (address, false);
 
-    cwm->client.funcGetTransfers (cwm->client.context,
-                                  cryptoWalletManagerTake (cwm),
-                                  callbackState,
-                                  (const char **) addresses, NUMBER_OF_ADDRESSES,
-                                  "__native__",
-                                  begBlockNumber, endBlockNumber);
+    cwmRequestSchedule (cwm, callbackState, CRYPTO_TRUE,
+                        (const char **) addresses, NUMBER_OF_ADDRESSES,
+                        begBlockNumber, endBlockNumber);
 
     free (addresses[0]);
 #undef NUMBER_OF_ADDRESSES
@@ -1611,9 +1958,7 @@ cwmGetBlockNumberAsETH (BREthereumClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_ETH_GET_BLOCK_NUMBER;
     callbackState->rid = rid;
     
-    cwm->client.funcGetBlockNumber (cwm->client.context,
-                                    cryptoWalletManagerTake (cwm),
-                                    callbackState);
+    cwmRequestBlockNumber (cwm, callbackState);
     
     cryptoWalletManagerGive (cwm);
 }
@@ -1653,9 +1998,7 @@ cwmGetBlockNumberAsGEN (BRGenericClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_GEN_GET_BLOCK_NUMBER;
     callbackState->rid = rid;
 
-    cwm->client.funcGetBlockNumber (cwm->client.context,
-                                    cryptoWalletManagerTake (cwm),
-                                    callbackState);
+    cwmRequestBlockNumber (cwm, callbackState);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -1675,12 +2018,9 @@ cwmGetTransactionsAsGEN (BRGenericClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_GEN_GET_TRANSACTIONS;
     callbackState->rid = rid;
 
-    cwm->client.funcGetTransactions (cwm->client.context,
-                                     cryptoWalletManagerTake (cwm),
-                                     callbackState,
-                                     &address, 1,
-                                     "__native__",
-                                     begBlockNumber, endBlockNumber);
+    cwmRequestSchedule (cwm, callbackState, CRYPTO_FALSE,
+                        &address, 1,
+                        begBlockNumber, endBlockNumber);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -1698,12 +2038,9 @@ cwmGetTransfersAsGEN (BRGenericClientContext context,
     callbackState->type = CWM_CALLBACK_TYPE_GEN_GET_TRANSFERS;
     callbackState->rid = rid;
 
-    cwm->client.funcGetTransfers (cwm->client.context,
-                                  cryptoWalletManagerTake (cwm),
-                                  callbackState,
-                                  &address, 1,
-                                  "__native__",
-                                  begBlockNumber, endBlockNumber);
+    cwmRequestSchedule (cwm, callbackState, CRYPTO_TRUE,
+                        &address, 1,
+                        begBlockNumber, endBlockNumber);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -1729,6 +2066,7 @@ cwmSubmitTransactionAsGEN (BRGenericClientContext context,
     
     char *hashAsHex = genericHashAsString (hash);
     
+    cwmRequestBegin (cwm, callbackState, CWM_REQUEST_PRIORITY_USER);
     cwm->client.funcSubmitTransaction (cwm->client.context,
                                        cryptoWalletManagerTake (cwm),
                                        callbackState,
@@ -1822,6 +2160,30 @@ cwmAnnounceGetBlockNumberSuccess (OwnershipKept BRCryptoWalletManager cwm,
                                            OwnershipGiven BRCryptoClientCallbackState callbackState,
                                            uint64_t blockNumber) {
     assert (cwm); assert (callbackState);
+
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_TRUE);
+
+    BRArrayOf(BRCryptoClientBlockNumberWaiter) waiters =
+    cwmResolveBlockNumber (cwm->network, callbackState, CRYPTO_TRUE, blockNumber);
+
+    cwmAnnounceGetBlockNumberSuccessInternal (cwm, callbackState, blockNumber);
+
+    // Fan the result out to the wallet managers that waited on this request.
+    if (NULL != waiters) {
+        for (size_t index = 0; index < array_count (waiters); index++) {
+            cwmAnnounceGetBlockNumberSuccessInternal (waiters[index].manager,
+                                                      waiters[index].callbackState,
+                                                      blockNumber);
+            cryptoWalletManagerGive (waiters[index].manager);
+        }
+        array_free (waiters);
+    }
+}
+
+static void
+cwmAnnounceGetBlockNumberSuccessInternal (BRCryptoWalletManager cwm,
+                                          OwnershipGiven BRCryptoClientCallbackState callbackState,
+                                          uint64_t blockNumber) {
     assert (CWM_CALLBACK_TYPE_BTC_GET_BLOCK_NUMBER == callbackState->type ||
             CWM_CALLBACK_TYPE_ETH_GET_BLOCK_NUMBER == callbackState->type ||
             CWM_CALLBACK_TYPE_GEN_GET_BLOCK_NUMBER == callbackState->type);
@@ -1876,7 +2238,23 @@ cwmAnnounceGetBlockNumberFailure (OwnershipKept BRCryptoWalletManager cwm,
     assert (CWM_CALLBACK_TYPE_BTC_GET_BLOCK_NUMBER == callbackState->type ||
             CWM_CALLBACK_TYPE_ETH_GET_BLOCK_NUMBER == callbackState->type ||
             CWM_CALLBACK_TYPE_GEN_GET_BLOCK_NUMBER == callbackState->type);
+
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_FALSE);
+
+    BRArrayOf(BRCryptoClientBlockNumberWaiter) waiters =
+    cwmResolveBlockNumber (cwm->network, callbackState, CRYPTO_FALSE, 0);
+
     cwmClientCallbackStateRelease (callbackState);
+
+    // The wallet managers that waited on this request fail too; they'll ask again on their
+    // next poll.
+    if (NULL != waiters) {
+        for (size_t index = 0; index < array_count (waiters); index++) {
+            cwmClientCallbackStateRelease (waiters[index].callbackState);
+            cryptoWalletManagerGive (waiters[index].manager);
+        }
+        array_free (waiters);
+    }
 }
 
 extern void
@@ -2025,6 +2403,10 @@ cwmAnnounceGetTransactionsComplete (OwnershipKept BRCryptoWalletManager cwm,
     assert (cwm); assert (callbackState);
     assert (CWM_CALLBACK_TYPE_BTC_GET_TRANSACTIONS == callbackState->type ||
             CWM_CALLBACK_TYPE_GEN_GET_TRANSACTIONS == callbackState->type);
+
+    // A failure might be retried, after a backoff, and then is not yet announced.
+    if (CRYPTO_TRUE == cwmRequestComplete (cwm->network, callbackState, success)) return;
+
     cwm = cryptoWalletManagerTake (cwm);
 
     switch (callbackState->type) {
@@ -2178,52 +2560,57 @@ cwmAnnounceGetTransferItem (BRCryptoWalletManager cwm,
 
                 error |= (CRYPTO_TRANSFER_STATE_ERRORED == status);
 
+                // Collect the transaction or log; the EWM gets them all on completion.
                 if (NULL != contract) {
-                    size_t topicsCount = 3;
-                    char *topics[3] = {
-                        (char *) ethEventGetSelector(ethEventERC20Transfer),
-                        ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, from),
-                        ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, to)
+                    BRCoreParseStatus parseStatus = CORE_PARSE_OK;
+                    UInt256 data = uint256CreateParse (amount, 0, &parseStatus);
+                    if (CORE_PARSE_OK != parseStatus) break;
+
+                    char *from32 = ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, from);
+                    char *to32   = ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, to);
+
+                    BREthereumEWMClientAnnounceLogBundle bundle = {
+                        ethHashCreate (hash),
+                        ethAddressCreate (contract),
+                        3,
+                        {
+                            logTopicCreateFromString (ethEventGetSelector (ethEventERC20Transfer)),
+                            logTopicCreateFromString (from32),
+                            logTopicCreateFromString (to32)
+                        },
+                        data,
+                        gasPrice,
+                        gasUsed,
+                        0,      // logIndex
+                        blockNumber,
+                        blockTransactionIndex,
+                        blockTimestamp
                     };
+                    array_add (callbackState->u.ethWithTransfers.logs, bundle);
 
-                    size_t logIndex = 0;
-
-                    ewmAnnounceLog (cwm->u.eth,
-                                    callbackState->rid,
-                                    hash,
-                                    contract,
-                                    topicsCount,
-                                    (const char **) &topics[0],
-                                    amount,
-                                    gasPrice,
-                                    gasUsed,
-                                    logIndex,
-                                    blockNumber,
-                                    blockTransactionIndex,
-                                    blockTimestamp);
-
-                    free (topics[1]);
-                    free (topics[2]);
+                    free (from32);
+                    free (to32);
                 }
                 else {
-                    ewmAnnounceTransaction (cwm->u.eth,
-                                            callbackState->rid,
-                                            hash,
-                                            from,
-                                            to,
-                                            contract,
-                                            value,
-                                            gasLimit,
-                                            gasPrice,
-                                            "",
-                                            nonce,
-                                            gasUsed,
-                                            blockNumber,
-                                            blockHash,
-                                            blockConfirmations,
-                                            blockTransactionIndex,
-                                            blockTimestamp,
-                                            error);
+                    BREthereumEWMClientAnnounceTransactionBundle bundle = {
+                        ethHashCreate (hash),
+                        ethAddressCreate (from),
+                        ethAddressCreate (to),
+                        EMPTY_ADDRESS_INIT,
+                        value,
+                        gasLimit,
+                        gasPrice,
+                        NULL,   // data, as ""
+                        nonce,
+                        gasUsed,
+                        blockNumber,
+                        ethHashCreate (blockHash),
+                        blockConfirmations,
+                        blockTransactionIndex,
+                        blockTimestamp,
+                        AS_ETHEREUM_BOOLEAN (error)
+                    };
+                    array_add (callbackState->u.ethWithTransfers.transactions, bundle);
                 }
                 break;
             }
@@ -2248,6 +2635,15 @@ cwmAnnounceGetTransfersComplete (OwnershipKept BRCryptoWalletManager cwm,
             CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS == callbackState->type ||
             CWM_CALLBACK_TYPE_ETH_GET_LOGS         == callbackState->type);
 
+    // The items of a failed request are dropped; a retry announces them anew.
+    if (CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS == callbackState->type && CRYPTO_TRUE != success) {
+        array_clear (callbackState->u.ethWithTransfers.transactions);
+        array_clear (callbackState->u.ethWithTransfers.logs);
+    }
+
+    // A failure might be retried, after a backoff, and then is not yet announced.
+    if (CRYPTO_TRUE == cwmRequestComplete (cwm->network, callbackState, success)) return;
+
     cwm = cryptoWalletManagerTake (cwm);
 
     switch (callbackState->type) {
@@ -2271,6 +2667,17 @@ cwmAnnounceGetTransfersComplete (OwnershipKept BRCryptoWalletManager cwm,
 
         case CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS: {
             assert (BLOCK_CHAIN_TYPE_ETH == cwm->type);
+
+            // Announce the items in bulk - handled in one EWM event and saved in one batch - and
+            // then the completion, which the EWM handles after them.
+            BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) transactions = callbackState->u.ethWithTransfers.transactions;
+            BRArrayOf(BREthereumEWMClientAnnounceLogBundle)         logs         = callbackState->u.ethWithTransfers.logs;
+
+            if (array_count (transactions) > 0)
+                ewmAnnounceTransactions (cwm->u.eth, callbackState->rid, transactions, array_count (transactions));
+            if (array_count (logs) > 0)
+                ewmAnnounceLogs (cwm->u.eth, callbackState->rid, logs, array_count (logs));
+
             ewmAnnounceTransactionComplete (cwm->u.eth,
                                             callbackState->rid,
                                             AS_ETHEREUM_BOOLEAN (CRYPTO_TRUE == success));
@@ -2333,6 +2740,8 @@ cwmAnnounceSubmitTransferSuccess (OwnershipKept BRCryptoWalletManager cwm,
     assert (CWM_CALLBACK_TYPE_BTC_SUBMIT_TRANSACTION == callbackState->type ||
             CWM_CALLBACK_TYPE_ETH_SUBMIT_TRANSACTION == callbackState->type ||
             CWM_CALLBACK_TYPE_GEN_SUBMIT_TRANSACTION == callbackState->type);
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_TRUE);
+
     cwm = cryptoWalletManagerTake (cwm);
 
     switch (callbackState->type) {
@@ -2377,6 +2786,8 @@ cwmAnnounceSubmitTransferFailure (OwnershipKept BRCryptoWalletManager cwm,
     assert (CWM_CALLBACK_TYPE_BTC_SUBMIT_TRANSACTION == callbackState->type ||
             CWM_CALLBACK_TYPE_ETH_SUBMIT_TRANSACTION == callbackState->type ||
             CWM_CALLBACK_TYPE_GEN_SUBMIT_TRANSACTION == callbackState->type);
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_FALSE);
+
     cwm = cryptoWalletManagerTake (cwm);
 
     // TODO(fix): For BTC/GEN, we pass EIO as the posix error. For ETH, 0 and a made up message.
@@ -2413,6 +2824,8 @@ cwmAnnounceEstimateTransactionFeeSuccess (OwnershipKept BRCryptoWalletManager cw
                                           OwnershipKept const char *strHash,
                                           uint64_t costUnits) {
     assert (cwm); assert (callbackState);
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_TRUE);
+
     cwm = cryptoWalletManagerTake (cwm);
 
     switch (callbackState->type) {
@@ -2461,6 +2874,8 @@ cwmAnnounceEstimateTransactionFeeFailure (OwnershipKept BRCryptoWalletManager cw
                                           OwnershipGiven BRCryptoClientCallbackState callbackState,
                                           OwnershipKept const char *hash) {
     assert (cwm); assert (callbackState);
+    cwmRequestComplete (cwm->network, callbackState, CRYPTO_FALSE);
+
     cwm = cryptoWalletManagerTake (cwm);
 
     switch (callbackState->type) {
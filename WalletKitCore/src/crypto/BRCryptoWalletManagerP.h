@@ -27,6 +27,9 @@
 extern "C" {
 #endif
 
+/// A Batcher collects listener events for delivery to a BRCryptoCWMBatchedListener
+typedef struct BRCryptoCWMListenerBatcherRecord *BRCryptoCWMListenerBatcher;
+
 struct BRCryptoWalletManagerRecord {
     pthread_mutex_t lock;
 
@@ -38,6 +41,7 @@ struct BRCryptoWalletManagerRecord {
     } u;
 
     BRCryptoCWMListener listener;
+    BRCryptoCWMListenerBatcher batcher;     // NULL unless created with a batched listener
     BRCryptoClient client;
     BRCryptoNetwork network;
     BRCryptoAccount account;
@@ -21,11 +21,13 @@
 
 #include "ethereum/BREthereum.h"
 #include "generic/BRGeneric.h"
+#include "support/BRSet.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct BRCryptoWalletTransferEntryRecord *BRCryptoWalletTransferEntry;
 
 struct BRCryptoWalletRecord {
     pthread_mutex_t lock;
@@ -60,7 +62,24 @@ struct BRCryptoWalletRecord {
     //
     // We are going to have the same
     //
-    BRArrayOf (BRCryptoTransfer) transfers;
+    // The transfers, as entries, are held in the order added.  A removed transfer leaves a NULL
+    // slot that is compacted away once enough slots are removed; `transfersRemoved` counts the
+    // NULL slots.
+    //
+    BRArrayOf (BRCryptoWalletTransferEntry) transfers;
+    size_t transfersRemoved;
+
+    /// An index into `transfers`, keyed by each transfer's per-chain identity - the BTC and ETH
+    /// `tid` and the GEN hash.
+    BRSetOf (BRCryptoWalletTransferEntry) transfersIndex;
+
+    /// The version of `transfers`, incremented on every add, update and remove; the version of
+    /// the most recent remove.
+    uint64_t transfersVersion;
+    uint64_t transfersRemovedVersion;
+
+    /// The most recent snapshot; reused if still at `transfersVersion`.
+    BRCryptoWalletTransfers transfersSnapshot;
 
     BRCryptoRef ref;
 };
@@ -70,6 +89,14 @@ struct BRCryptoWalletRecord {
 private_extern BRCryptoBlockChainType
 cryptoWalletGetType (BRCryptoWallet wallet);
 
+/**
+ * Note that `transfer`, held by `wallet`, has changed - such as in its state - so as to update the
+ * wallet's transfers version.  If `wallet` does not hold `transfer` this does nothing.
+ */
+private_extern void
+cryptoWalletUpdTransfer (BRCryptoWallet wallet,
+                         BRCryptoTransfer transfer);
+
 private_extern void
 cryptoWalletSetState (BRCryptoWallet wallet,
                       BRCryptoWalletState state);
@@ -155,15 +155,19 @@ ethAddressGetHash (BREthereumAddress address) {
 
 extern BREthereumAddress
 ethAddressRlpDecode (BRRlpItem item, BRRlpCoder coder) {
+    return ethAddressRlpDecodeView (rlpItemGetView (coder, item));
+}
+
+extern BREthereumAddress
+ethAddressRlpDecodeView (BRRlpView view) {
     BREthereumAddress address = EMPTY_ADDRESS_INIT;
 
-    BRRlpData data = rlpDecodeBytes(coder, item);
+    BRRlpData data = rlpViewDecodeBytes (view);
     if (0 != data.bytesCount) {
         assert (20 == data.bytesCount);
         memcpy (address.bytes, data.bytes, 20);
     }
 
-    rlpDataRelease(data);
     return address;
 }
 
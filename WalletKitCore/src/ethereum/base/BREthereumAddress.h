@@ -92,6 +92,9 @@ extern BREthereumAddress
 ethAddressRlpDecode (BRRlpItem item,
                      BRRlpCoder coder);
 
+extern BREthereumAddress
+ethAddressRlpDecodeView (BRRlpView view);
+
 extern BRRlpItem
 ethAddressRlpEncode(BREthereumAddress address,
                     BRRlpCoder coder);
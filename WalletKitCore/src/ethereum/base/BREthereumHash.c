@@ -51,6 +51,22 @@ ethHashCreateFromData (BRRlpData data) {
     return hash;
 }
 
+extern BREthereumHash
+ethHashCreateFromRlpItem (BRRlpItem item, BRRlpCoder coder) {
+    BREthereumHash hash;
+    UInt256 value = rlpItemGetKeccak256 (coder, item);
+    memcpy (hash.bytes, value.u8, sizeof (hash.bytes));
+    return hash;
+}
+
+extern BREthereumHash
+ethHashCreateFromRlpView (BRRlpView view) {
+    BREthereumHash hash;
+    UInt256 value = rlpViewGetKeccak256 (view);
+    memcpy (hash.bytes, value.u8, sizeof (hash.bytes));
+    return hash;
+}
+
 /**
  * Return the hex-encoded string
  */
@@ -89,13 +105,17 @@ ethHashRlpEncode(BREthereumHash hash, BRRlpCoder coder) {
 
 extern BREthereumHash
 ethHashRlpDecode (BRRlpItem item, BRRlpCoder coder) {
+    return ethHashRlpDecodeView (rlpItemGetView (coder, item));
+}
+
+extern BREthereumHash
+ethHashRlpDecodeView (BRRlpView view) {
     BREthereumHash hash;
 
-    BRRlpData data = rlpDecodeBytes(coder, item);
+    BRRlpData data = rlpViewDecodeBytes (view);
     assert (ETHEREUM_HASH_BYTES == data.bytesCount);
 
     memcpy (hash.bytes, data.bytes, ETHEREUM_HASH_BYTES);
-    rlpDataRelease(data);
 
     return hash;
 }
@@ -73,6 +73,19 @@ ethHashCreateEmpty (void);
 extern BREthereumHash
 ethHashCreateFromData (BRRlpData data);
 
+/**
+ * Create a Hash by computing it from the RLP encoding of `item` (using Keccak256).  The encoding
+ * is streamed into the hash.
+ */
+extern BREthereumHash
+ethHashCreateFromRlpItem (BRRlpItem item, BRRlpCoder coder);
+
+/**
+ * Create a Hash by computing it from the RLP encoding referenced by `view` (using Keccak256).
+ */
+extern BREthereumHash
+ethHashCreateFromRlpView (BRRlpView view);
+
 /**
  * Return the hex-encoded string
  */
@@ -94,6 +107,9 @@ ethHashRlpEncode(BREthereumHash hash, BRRlpCoder coder);
 extern BREthereumHash
 ethHashRlpDecode (BRRlpItem item, BRRlpCoder coder);
 
+extern BREthereumHash
+ethHashRlpDecodeView (BRRlpView view);
+
 extern BRRlpItem
 ethHashEncodeList (BRArrayOf(BREthereumHash) hashes, BRRlpCoder coder);
 
@@ -172,15 +172,33 @@ bcsCreateInitializeLogs (BREthereumBCS bcs,
     BRSetFree (logs);
 }
 
+/**
+ * Check if a LES provision belongs to `bcs` - either made directly, with `bcs` as the context, or
+ * made by the BCS sync, with a sync range as the context.
+ */
+static BREthereumBoolean
+bcsOwnsProvision (BREthereumBCS bcs,
+                  BREthereumLESProvisionContext context,
+                  BREthereumLESProvisionCallback callback) {
+    if ((BREthereumLESProvisionContext) bcs == context)
+        return ETHEREUM_BOOLEAN_TRUE;
+
+    return AS_ETHEREUM_BOOLEAN ((BREthereumLESProvisionCallback) bcsSyncSignalProvision == callback &&
+                                ETHEREUM_BOOLEAN_IS_TRUE (bcsSyncOwnsRange (bcs->sync,
+                                                                            (BREthereumBCSSyncRange) context)));
+}
+
 extern BREthereumBCS
 bcsCreate (BREthereumNetwork network,
            BREthereumAddress address,
            BREthereumBCSListener listener,
            BRCryptoSyncMode mode,
+           BREthereumLES les,
            OwnershipGiven BRSetOf(BREthereumNodeConfig) peers,
            OwnershipGiven BRSetOf(BREthereumBlock) blocks,
            OwnershipGiven BRSetOf(BREthereumTransaction) transactions,
-           OwnershipGiven BRSetOf(BREthereumLog) logs) {
+           OwnershipGiven BRSetOf(BREthereumLog) logs,
+           const char *powPath) {
 
     BREthereumBCS bcs = (BREthereumBCS) calloc (1, sizeof(struct BREthereumBCSStruct));
 
@@ -191,6 +209,7 @@ bcsCreate (BREthereumNetwork network,
     bcs->mode = mode;
     bcs->filterForAddressOnTransactions = bloomFilterCreateAddress(bcs->address);
     bcs->filterForAddressOnLogs = logTopicGetBloomFilterAddress(bcs->address);
+    bcs->filtersForLogs = bloomFilterSetCreate (&bcs->filterForAddressOnLogs, 1);
 
     bcs->listener = listener;
 
@@ -275,18 +294,37 @@ bcsCreate (BREthereumNetwork network,
     BREthereumBoolean handleSync = AS_ETHEREUM_BOOLEAN (CRYPTO_SYNC_MODE_P2P_ONLY == mode ||
                                                         CRYPTO_SYNC_MODE_P2P_WITH_API_SYNC == mode);
 
-    bcs->les = lesCreate (bcs->network,
-                          (BREthereumLESCallbackContext) bcs,
-                          (BREthereumLESCallbackAnnounce) bcsSignalAnnounce,
-                          (BREthereumLESCallbackStatus) bcsSignalStatus,
-                          (BREthereumLESCallbackSaveNodes) bcsSignalNodes,
-                          blockHeaderGetHash(chainHeader),
-                          blockHeaderGetNumber(chainHeader),
-                          totalDifficulty,
-                          blockGetHash (bcs->genesis),
-                          peers,
-                          discoverNodes,
-                          handleSync);
+    // Share `les` only if we handle sync; a shared LES requires nodes that serve headers, etc.
+    BREthereumBoolean lesShared = AS_ETHEREUM_BOOLEAN (NULL != les && ETHEREUM_BOOLEAN_IS_TRUE (handleSync));
+
+    if (ETHEREUM_BOOLEAN_IS_TRUE (lesShared)) {
+        bcs->les = lesTake (les);
+        if (NULL != peers) BRSetFreeAll (peers, (void (*) (void*)) nodeConfigRelease);
+    }
+    else
+        bcs->les = lesCreate (bcs->network,
+                              NULL, NULL, NULL, NULL,
+                              blockHeaderGetHash(chainHeader),
+                              blockHeaderGetNumber(chainHeader),
+                              totalDifficulty,
+                              blockGetHash (bcs->genesis),
+                              peers,
+                              discoverNodes,
+                              handleSync);
+
+    lesAddClient (bcs->les,
+                  (BREthereumLESCallbackContext) bcs,
+                  (BREthereumLESCallbackAnnounce) bcsSignalAnnounce,
+                  (BREthereumLESCallbackStatus) bcsSignalStatus,
+                  (BREthereumLESCallbackSaveNodes) bcsSignalNodes,
+                  (BREthereumLESCallbackOwnsProvision) bcsOwnsProvision);
+
+    // Offer our head to a shared LES; it is kept only if more recent than the LES head.
+    if (ETHEREUM_BOOLEAN_IS_TRUE (lesShared))
+        lesUpdateBlockHead (bcs->les,
+                            blockHeaderGetHash(chainHeader),
+                            blockHeaderGetNumber(chainHeader),
+                            totalDifficulty);
 
     if (chainHeader != blockGetHeader(bcs->chain))
         blockHeaderRelease(chainHeader);
@@ -298,7 +336,11 @@ bcsCreate (BREthereumNetwork network,
                                bcs->les,
                                bcs->handler);
 
-    bcs->pow = proofOfWorkCreate();
+    // Rinkeby is Clique 'proof of authority' - its headers carry no Ethash seal.  For the other
+    // networks start preparing the Ethash cache for our chain head now, in the background.
+    bcs->pow = (ethNetworkRinkeby == network ? NULL : proofOfWorkCreate (powPath));
+    if (NULL != bcs->pow && NULL != bcs->chain)
+        proofOfWorkGenerate (bcs->pow, blockGetHeader (bcs->chain));
 
     return bcs;
 }
@@ -306,7 +348,7 @@ bcsCreate (BREthereumNetwork network,
 extern void
 bcsStart (BREthereumBCS bcs) {
     eventHandlerStart(bcs->handler);
-    lesStart (bcs->les);
+    lesStartClient (bcs->les, bcs);
 }
 
 extern void
@@ -316,7 +358,7 @@ bcsStop (BREthereumBCS bcs) {
     //   a) If we stop LES first, then the BCS thread might add an event to LES
     //   b) If we stop BCS first, then the LES thread might add an event to BCS, as a callback.
     //
-    lesStop (bcs->les);
+    lesStopClient (bcs->les, bcs);
     eventHandlerStop (bcs->handler);
 }
 
@@ -331,9 +373,12 @@ bcsDestroy (BREthereumBCS bcs) {
     if (ETHEREUM_BOOLEAN_IS_TRUE(bcsIsStarted(bcs)))
         bcsStop (bcs);
 
+    // Leave LES, dropping our pending requests, before releasing the sync that made some of them.
+    lesRemClient (bcs->les, bcs);
     lesRelease (bcs->les);
     bcsSyncRelease(bcs->sync);
-    proofOfWorkRelease(bcs->pow);
+    if (NULL != bcs->pow) proofOfWorkRelease(bcs->pow);
+    bloomFilterSetRelease (bcs->filtersForLogs);
 
     // TODO: We'll need to announce things to our `listener`
 
@@ -360,6 +405,13 @@ bcsDestroy (BREthereumBCS bcs) {
     free (bcs);
 }
 
+extern BREthereumLES
+bcsGetLES (BREthereumBCS bcs) {
+    return (CRYPTO_SYNC_MODE_P2P_ONLY == bcs->mode || CRYPTO_SYNC_MODE_P2P_WITH_API_SYNC == bcs->mode
+            ? bcs->les
+            : NULL);
+}
+
 extern void
 bcsClean (BREthereumBCS bcs) {
     if (NULL != bcs->les) lesClean (bcs->les);
@@ -1257,12 +1309,6 @@ bcsBlockHasMatchingTransactions (BREthereumBCS bcs,
     // return ETHEREUM_BOOLEAN_FALSE;
 }
 
-static BREthereumBoolean
-bcsBlockHasMatchingLogs (BREthereumBCS bcs,
-                         BREthereumBlock block) {
-    return blockHeaderMatch (blockGetHeader (block), bcs->filterForAddressOnLogs);
-}
-
 static BREthereumBoolean
 bcsBlockNeedsAccountState (BREthereumBCS bcs,
                            BREthereumBlock block) {
@@ -1283,6 +1329,7 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
                               BREthereumNodeReference node,
                               OwnershipGiven BREthereumBlockHeader header,
                               int isFromSync,
+                              int hasMatchingLogs,
                               BRArrayOf(BREthereumHash) *bodiesHashes,
                               BRArrayOf(BREthereumHash) *receiptsHashes,
                               BRArrayOf(BREthereumHash) *accountsHashes,
@@ -1320,7 +1367,7 @@ bcsHandleBlockHeaderInternal (BREthereumBCS bcs,
     // proof' occassionally so that we can build on the block chain's total difficulty and
     // ultimately our Proof-of-Work validations.
     BREthereumBoolean needBodies   = bcsBlockHasMatchingTransactions(bcs, block);
-    BREthereumBoolean needReceipts = bcsBlockHasMatchingLogs(bcs, block);
+    BREthereumBoolean needReceipts = AS_ETHEREUM_BOOLEAN (hasMatchingLogs);
     BREthereumBoolean needAccount  = bcsBlockNeedsAccountState(bcs, block);
     BREthereumBoolean needProof    = bcsBlockNeedsHeaderProof(bcs, block);
 
@@ -1375,11 +1422,17 @@ bcsHandleBlockHeaders (BREthereumBCS bcs,
     BRArrayOf(BREthereumHash) accountsHashes = NULL;
     BRArrayOf(uint64_t) proofNumbers = NULL;
 
-    for (size_t index = 0; index < array_count(headers); index++)
+    // Match every header's logsBloom in one pass; the headers with matching logs need receipts.
+    size_t headersCount = array_count(headers);
+    uint64_t matchingLogs[BLOOM_FILTER_SET_MATCHES_WORDS(headersCount) + 1];
+    blockHeadersMatch (headers, headersCount, bcs->filtersForLogs, matchingLogs);
+
+    for (size_t index = 0; index < headersCount; index++)
         // Each `headers[index]` has 'OwnershipGiven'
         bcsHandleBlockHeaderInternal (bcs, node,
                                       headers[index],
                                       isFromSync,
+                                      BLOOM_FILTER_SET_MATCHES_TEST (matchingLogs, index),
                                       &bodiesHashes,
                                       &receiptsHashes,
                                       &accountsHashes,
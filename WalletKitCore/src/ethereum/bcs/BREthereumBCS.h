@@ -155,17 +155,22 @@ typedef struct {
  * saved `headers`.  Provide `listener` to anounce BCS 'events'.
  *
  * @parameters
+ * @parameter les - if not NULL, a LES shared with other BCS instances on `network`, as one pool of
+ *     nodes; `peers` are then unused.  Otherwise BCS creates its own LES.  See bcsGetLES().
  * @parameter headers - is this a BRArray; assume so for now.
+ * @parameter powPath - if not NULL, the directory for persisted proof-of-work caches.
  */
 extern BREthereumBCS
 bcsCreate (BREthereumNetwork network,
            BREthereumAddress address,
            BREthereumBCSListener listener,
            BRCryptoSyncMode syncMode,
+           BREthereumLES les,
            BRSetOf(BREthereumNodeConfig) peers,
            BRSetOf(BREthereumBlock) blocks,
            BRSetOf(BREthereumTransaction) transactions,
-           BRSetOf(BREthereumLog) logs);
+           BRSetOf(BREthereumLog) logs,
+           const char *powPath);
 
 extern void
 bcsStart (BREthereumBCS bcs);
@@ -179,6 +184,14 @@ bcsIsStarted (BREthereumBCS bcs);
 extern void
 bcsDestroy (BREthereumBCS bcs);
 
+/**
+ * Return the LES used by `bcs`, to be shared by another BCS on the same network.  The LES is only
+ * shareable if `bcs` handles sync (a P2P_ONLY or P2P_WITH_API_SYNC mode); otherwise, NULL.  The
+ * LES is not taken; use lesTake().
+ */
+extern BREthereumLES
+bcsGetLES (BREthereumBCS bcs);
+
 /**
  * Scavenge BCS memory
  */
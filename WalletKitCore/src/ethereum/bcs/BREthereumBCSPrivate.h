@@ -41,6 +41,19 @@ extern "C" {
 #define SYNC_N_ARY_REQUEST_MINIMUM     (100)
 #define SYNC_N_ARY_REQUEST_MAXIMUM     (LES_GET_HEADERS_MAXIMUM - 1)
 
+/**
+ * Once N_ARY syncs have observed account state changes, further N_ARY ranges are sized by the
+ * observed density (changes per block).  A range of `total` blocks is expected to hold
+ * `density * total` changes, but at least one as it was created for a change.  We'll use about
+ * FACTOR subranges per expected change, but no fewer than ADAPTIVE_MINIMUM.  If more than SEVERAL
+ * changes are expected we'll use enough subranges for each to be a SYNC_LINEAR_SMALL, if possible.
+ * A sparse account history then needs far fewer account states per range; a dense one keeps the
+ * full width.
+ */
+#define SYNC_N_ARY_CHANGES_FACTOR      (4)
+#define SYNC_N_ARY_CHANGES_SEVERAL     (2)
+#define SYNC_N_ARY_ADAPTIVE_MINIMUM    (16)
+
 /**
  * For a 'linear sync' we'll request at most MAXIMUM headers.  The maximum is determined by the
  * maximum in LES GetBlockHeaders.
@@ -52,6 +65,14 @@ extern "C" {
 #define SYNC_LINEAR_LIMIT               (10 * SYNC_LINEAR_REQUEST_MAXIMUM)
 #define SYNC_LINEAR_LIMIT_IF_N_ARY      (100) // 3 * SYNC_LINEAR_REQUEST_MAXIMUM)
 
+/**
+ * Sibling ranges are synced concurrently with at most LIMIT ranges having LES requests outstanding
+ * at once.  Results are reported in block order regardless; a range done before its predecessors
+ * holds its headers.  Dispatch pauses while more than HELD_LIMIT_FACTOR * LIMIT ranges are held.
+ */
+#define SYNC_DISPATCH_LIMIT            (4)
+#define SYNC_HELD_LIMIT_FACTOR         (4)
+
 /**
  * As the sync find results (block headers, at least) we'll report them every PERIOD results.
  */
@@ -95,6 +116,11 @@ struct BREthereumBCSStruct {
      */
     BREthereumBloomFilter filterForAddressOnLogs;
 
+    /**
+     * The filters for logs, prepared for matching a batch of block headers at once.
+     */
+    BREthereumBloomFilterSet filtersForLogs;
+
     /**
      * The listener interested in BCS events
      */
@@ -363,6 +389,41 @@ bcsSyncStart (BREthereumBCSSync sync,
               uint64_t thisBlockNumber,
               uint64_t needBlockNumber);
 
+/**
+ * A Sync Provider answers the sync's requests for block headers and account states - by default
+ * with LES.  Each request must be answered, eventually, by bcsSyncHandleProvision() with `range`.
+ */
+typedef void* BREthereumBCSSyncProviderContext;
+
+typedef void
+(*BREthereumBCSSyncProvideBlockHeaders) (BREthereumBCSSyncProviderContext context,
+                                         BREthereumBCSSyncRange range,
+                                         BREthereumNodeReference node,
+                                         uint64_t start,
+                                         uint32_t limit,
+                                         uint64_t skip);
+
+typedef void
+(*BREthereumBCSSyncProvideAccountStates) (BREthereumBCSSyncProviderContext context,
+                                          BREthereumBCSSyncRange range,
+                                          BREthereumNodeReference node,
+                                          BREthereumAddress address,
+                                          OwnershipGiven BRArrayOf(BREthereumHash) hashes);
+
+typedef struct {
+    BREthereumBCSSyncProviderContext context;
+    BREthereumBCSSyncProvideBlockHeaders provideBlockHeaders;
+    BREthereumBCSSyncProvideAccountStates provideAccountStates;
+} BREthereumBCSSyncProvider;
+
+extern void
+bcsSyncSetProvider (BREthereumBCSSync sync,
+                    BREthereumBCSSyncProvider provider);
+
+extern void
+bcsSyncSetDispatchLimit (BREthereumBCSSync sync,
+                         size_t limit);
+
 extern void
 bcsSyncHandleProvision (BREthereumBCSSyncRange range,
                         BREthereumLES les,
@@ -375,6 +436,14 @@ bcsSyncSignalProvision (BREthereumBCSSyncRange range,
                         BREthereumNodeReference node,
                         BREthereumProvisionResult result);
 
+/**
+ * Check if `range`, a LES provision context, belongs to `sync`.  When a BCS leaves a shared LES,
+ * the LES requests of the BCS's sync are dropped.
+ */
+extern BREthereumBoolean
+bcsSyncOwnsRange (BREthereumBCSSync sync,
+                  BREthereumBCSSyncRange range);
+
 #ifdef __cplusplus
 }
 #endif
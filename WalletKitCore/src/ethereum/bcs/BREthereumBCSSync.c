@@ -9,21 +9,29 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <stdlib.h>
+#include <math.h>
 #include "ethereum/les/BREthereumLES.h"
 #include "BREthereumBCSPrivate.h"
 
 /* Forward Declarations */
 static void
-syncRangeComplete (BREthereumBCSSyncRange child);
-
-static void
-syncRangeDispatch (BREthereumBCSSyncRange range);
+syncRangeContinue (BREthereumBCSSyncRange root);
 
 static void
 computeOptimalStep (uint64_t numberOfBlocks,
+                    uint64_t countMinimum,
+                    uint64_t countMaximum,
                     uint64_t *optimalStep,
                     uint64_t *optimalCount);
 
+static void
+bcsSyncProvideBlockHeaders (BREthereumBCSSyncRange range);
+
+static void
+bcsSyncProvideAccountStates (BREthereumBCSSyncRange range,
+                             BREthereumNodeReference node,
+                             OwnershipGiven BRArrayOf(BREthereumHash) hashes);
+
 /**
  * The BCS Sync Type represents the types of nodes in an N-ary tree.  We sync Ethereum blocks based
  * on a N-ary search for regions of blocks where the account state of the desired address changed.
@@ -64,6 +72,18 @@ typedef enum {
     SYNC_RESULT_ACCOUNT
 } BREthereumBCSSyncResultState;
 
+/**
+ * The Sync Range State identifies where a range is in its dispatch.  A PENDING range has not
+ * been dispatched; a REQUESTED range has a LES request outstanding (for headers or, if N_ARY,
+ * for account states); a DONE range has all of its own results.  Sibling ranges are dispatched
+ * concurrently, so a DONE range may need to wait on its predecessors before it is reported.
+ */
+typedef enum {
+    SYNC_RANGE_PENDING,
+    SYNC_RANGE_REQUESTED,
+    SYNC_RANGE_DONE
+} BREthereumBCSSyncRangeState;
+
 /// MARK: - Sync Range
 
 /**
@@ -136,6 +156,39 @@ struct BREthereumBCSSyncRangeRecord {
 
     /** The children of this node.  If this is NULL, then `this` is a leaf node */
     BRArrayOf(BREthereumBCSSyncRange) children;
+
+    /** The dispatch state of this node */
+    BREthereumBCSSyncRangeState state;
+
+    // The following are only used by the root node.
+
+    /** The maximum number of ranges REQUESTED at once */
+    size_t dispatchLimit;
+
+    /** The number of ranges REQUESTED */
+    size_t requestedCount;
+
+    /**
+     * The number of LINEAR_SMALL ranges DONE but not yet reported; their headers are held until
+     * all preceding ranges are reported.  Bounded by SYNC_HELD_LIMIT_FACTOR * dispatchLimit.
+     */
+    size_t heldCount;
+
+    /** The number of LES requests outstanding, over all ranges */
+    size_t requestsCount;
+
+    /**
+     * The number of account state changes found, over `changesBlocks` blocks, by all completed
+     * N_ARY ranges.  The ratio estimates the change density and sizes subsequent N_ARY ranges.
+     */
+    uint64_t changesCount;
+    uint64_t changesBlocks;
+
+    /**
+     * If TRUE, the sync has completed or been stopped.  The root is released once all of its
+     * outstanding LES requests have been handled.
+     */
+    BREthereumBoolean stopped;
 };
 
 /**
@@ -204,6 +257,16 @@ syncRangeCreateDetailed (BREthereumAddress address,
     range->parent = NULL;
     range->children = NULL;
 
+    range->state = SYNC_RANGE_PENDING;
+
+    range->dispatchLimit  = SYNC_DISPATCH_LIMIT;
+    range->requestedCount = 0;
+    range->heldCount      = 0;
+    range->requestsCount  = 0;
+    range->changesCount   = 0;
+    range->changesBlocks  = 0;
+    range->stopped = ETHEREUM_BOOLEAN_FALSE;
+
     // syncRangeReport(range, "Create  ");
     return range;
 }
@@ -218,7 +281,11 @@ syncRangeRelease (BREthereumBCSSyncRange range) {
         array_free(range->children);
     }
 
-    // result[].header and result[].account should be gone already.
+    // Headers remain if `range` was released (on a stop) while awaiting its predecessors.
+    if (NULL != range->headers) {
+        blockHeadersRelease (range->headers);
+        range->headers = NULL;
+    }
 
     free (range);
 }
@@ -303,10 +370,47 @@ syncRangeCreateAndAddChild (BREthereumBCSSyncRange parent,
                                                         type));
 }
 
+/**
+ * Compute the range of N_ARY subrange counts for a range of `total` blocks given the observed
+ * account state change `density` (changes per block).  With no observations (`density` of zero)
+ * the range is the default [SYNC_N_ARY_REQUEST_MINIMUM, SYNC_N_ARY_REQUEST_MAXIMUM).
+ */
+static void
+syncRangeComputeCountLimits (uint64_t total,
+                             double density,
+                             uint64_t *countMinimum,
+                             uint64_t *countMaximum) {
+    if (density <= 0.0) {
+        *countMinimum = SYNC_N_ARY_REQUEST_MINIMUM;
+        *countMaximum = SYNC_N_ARY_REQUEST_MAXIMUM;
+        return;
+    }
+
+    // The range was created because it holds a change; expect at least one.
+    double expected = density * total;
+    if (expected < 1.0) expected = 1.0;
+
+    double target = ceil (SYNC_N_ARY_CHANGES_FACTOR * expected);
+    if (target < SYNC_N_ARY_ADAPTIVE_MINIMUM)     target = SYNC_N_ARY_ADAPTIVE_MINIMUM;
+
+    // With several changes expected, a subrange too large for a LINEAR_SMALL sync costs another
+    // N_ARY level for each change.  If possible, keep subranges that small.
+    double linear = ceil ((double) total / SYNC_LINEAR_REQUEST_MAXIMUM);
+    if (expected > SYNC_N_ARY_CHANGES_SEVERAL && target < linear) target = linear;
+
+    if (target > SYNC_N_ARY_REQUEST_MAXIMUM - 1)  target = SYNC_N_ARY_REQUEST_MAXIMUM - 1;
+
+    *countMinimum = (uint64_t) target;
+    *countMaximum = (2 * (*countMinimum) < SYNC_N_ARY_REQUEST_MAXIMUM
+                     ? 2 * (*countMinimum)
+                     : SYNC_N_ARY_REQUEST_MAXIMUM);
+}
+
 /**
  * Create a Sync Range based on block numbers for `tail` and `head`.  The range's type will be
  * determined from the total number of needed blocks; given the range, sync parameters (notably
- * `step` and `count` for a 'N_ARY sync') will be optimized.
+ * `step` and `count` for a 'N_ARY sync') will be optimized.  For a 'N_ARY sync' the `count` is
+ * sized by `density`, the observed account state changes per block (or zero if unknown).
  */
 static BREthereumBCSSyncRange
 syncRangeCreate (BREthereumAddress address,
@@ -317,7 +421,8 @@ syncRangeCreate (BREthereumAddress address,
                  BREthereumBCSSyncRangeContext callback,
                  uint64_t tail,
                  uint64_t head,
-                 uint64_t linearLargeLimit) {
+                 uint64_t linearLargeLimit,
+                 double density) {
 
     uint64_t total = head - tail;
 
@@ -330,7 +435,9 @@ syncRangeCreate (BREthereumAddress address,
     if (total <= SYNC_LINEAR_REQUEST_MAXIMUM) type = SYNC_LINEAR_SMALL;
     else if (total <= linearLargeLimit) type = SYNC_LINEAR_LARGE;
     else {
-        computeOptimalStep(total, &step, &count);
+        uint64_t countMinimum, countMaximum;
+        syncRangeComputeCountLimits (total, density, &countMinimum, &countMaximum);
+        computeOptimalStep(total, countMinimum, countMaximum, &step, &count);
         type = (total == step * count
                 ? SYNC_N_ARY         // An exact fit for N_ARY
                 : SYNC_MIXED);       // Not exact, add a LINEAR_SMALL node
@@ -396,38 +503,29 @@ syncRangeCreate (BREthereumAddress address,
 }
 
 /**
- * Dispatch a Sync Range by a) issuing a LES request and/or b) dispatching any children.
+ * Dispatch a Sync Range.  A LINEAR_SMALL or N_ARY range issues a LES request for headers; a
+ * MIXED or LINEAR_LARGE range has nothing to request itself - its children are dispatched as
+ * they are found pending.
  */
 static void
-syncRangeDispatch (BREthereumBCSSyncRange range) {
-    if (NULL == range->parent)
-        eth_log ("BCS", "Sync: Start%s", "");
+syncRangeDispatch (BREthereumBCSSyncRange range,
+                   BREthereumBCSSyncRange root) {
+    assert (SYNC_RANGE_PENDING == range->state);
 
     syncRangeReport(range, "Dispatch");
 
-    if (NULL == range->parent)
-        // Callback to announce sync start
-        range->callback (range->context, range, NULL, range->tail);
-
     switch (range->type) {
         case SYNC_LINEAR_SMALL:
         case SYNC_N_ARY:
-            lesProvideBlockHeaders (range->les, range->node,
-                                    (BREthereumLESProvisionContext) range,
-                                    (BREthereumLESProvisionCallback) bcsSyncSignalProvision,
-                                    range->tail,
-                                    (uint32_t) (range->count + 1),  // both endpoints
-                                    range->step - 1,   // skip
-                                    ETHEREUM_BOOLEAN_FALSE);
+            range->state = SYNC_RANGE_REQUESTED;
+            root->requestedCount += 1;
+            bcsSyncProvideBlockHeaders (range);
             break;
 
         case SYNC_MIXED:
         case SYNC_LINEAR_LARGE:
             assert (NULL != range->children);
-            if (0 == array_count(range->children))
-                syncRangeComplete(range);
-            else
-                syncRangeDispatch(range->children[0]);
+            range->state = SYNC_RANGE_DONE;
             break;
     }
 }
@@ -443,42 +541,94 @@ syncRangeGetRoot (BREthereumBCSSyncRange range) {
 }
 
 /**
- * Complete a Sync Range by a) completing the sync overall if `child` is the root, b) dispatching
- * on any remaining children of parent.
+ * Find the first PENDING range, in block order, at or below `range`.  Return NULL if none.
+ */
+static BREthereumBCSSyncRange
+syncRangeFindPending (BREthereumBCSSyncRange range) {
+    if (SYNC_RANGE_PENDING == range->state) return range;
+
+    if (NULL != range->children)
+        for (size_t index = 0; index < array_count(range->children); index++) {
+            BREthereumBCSSyncRange pending = syncRangeFindPending (range->children[index]);
+            if (NULL != pending) return pending;
+        }
+
+    return NULL;
+}
+
+/**
+ * Report the results of `range`, now that all preceding ranges have been reported.  For a
+ * LINEAR_SMALL range that is the range's headers followed by its (incremental) progress.
  */
 static void
-syncRangeComplete (BREthereumBCSSyncRange child) {
-    BREthereumBCSSyncRange parent = child->parent;
+syncRangeComplete (BREthereumBCSSyncRange range,
+                   BREthereumBCSSyncRange root) {
+    syncRangeReport (range, "Complete");
 
-    syncRangeReport (child, "Complete");
+    if (SYNC_LINEAR_SMALL != range->type) return;
 
-    // If `child` does not have a `parent`, then we are at the top-level and completely complete.
-    if (NULL == parent) {
-        eth_log ("BCS", "Sync: Done%s", "");
-        child->callback (child->context, child, NULL, child->head);
-        return;
-    }
+    // `header` is now owned by `root->context`.
+    for (size_t index = 0; index < array_count(range->headers); index++)
+        root->callback (root->context, range, range->headers[index], 0);
+
+    array_free (range->headers);
+    range->headers = NULL;
+
+    assert (root->heldCount > 0);
+    root->heldCount -= 1;
+
+    // The root's progress is reported by syncRangeContinue()
+    if (range != root)
+        root->callback (root->context, range, NULL, range->head);
+}
 
-    // If this is a LINEAR_SMALL sync, then report (incremental) progress
-    if (SYNC_LINEAR_SMALL == child->type) {
-        BREthereumBCSSyncRange root = syncRangeGetRoot (child);
-        root->callback (root->context, child, NULL, child->head);
+/**
+ * Complete, in block order, every DONE range at or below `range`; each completed child is
+ * removed and released.  Stop at the first range that is not DONE.  Return TRUE if `range` itself
+ * is now complete.
+ */
+static BREthereumBoolean
+syncRangeDrain (BREthereumBCSSyncRange range,
+                BREthereumBCSSyncRange root) {
+    if (SYNC_RANGE_DONE != range->state) return ETHEREUM_BOOLEAN_FALSE;
+
+    while (NULL != range->children && array_count(range->children) > 0) {
+        BREthereumBCSSyncRange child = range->children[0];
+
+        if (ETHEREUM_BOOLEAN_IS_FALSE (syncRangeDrain (child, root)))
+            return ETHEREUM_BOOLEAN_FALSE;
+
+        syncRangeComplete (child, root);
+
+        syncRangeRemChild (child);
+        assert (NULL == child->children || array_count(child->children) == 0);
+        syncRangeRelease (child);
     }
 
-    // Remove the child from parent.
-    syncRangeRemChild(child);
+    return ETHEREUM_BOOLEAN_TRUE;
+}
 
-    // Release child.
-    assert (NULL == child->children || array_count(child->children) == 0);
-    syncRangeRelease(child);
+/**
+ * Continue the sync rooted at `root` by a) reporting, in block order, the completed ranges and
+ * then b) dispatching pending ranges while fewer than `dispatchLimit` are REQUESTED.  If `root`
+ * itself completes, the sync is done - which retires `root`; the caller must not reference `root`
+ * unless it holds an outstanding request.
+ */
+static void
+syncRangeContinue (BREthereumBCSSyncRange root) {
+    BREthereumBCSSyncRange range;
 
-    // If we have children remaining, then dispatch the first one; otherwise ...
-    if (array_count(parent->children) > 0)
-        syncRangeDispatch(parent->children[0]);
+    if (ETHEREUM_BOOLEAN_IS_TRUE (syncRangeDrain (root, root))) {
+        syncRangeComplete (root, root);
+        eth_log ("BCS", "Sync: Done%s", "");
+        root->callback (root->context, root, NULL, root->head);
+        return;
+    }
 
-    // ... parent is complete.
-    else
-        syncRangeComplete (parent);
+    while (root->requestedCount < root->dispatchLimit &&
+           root->heldCount < SYNC_HELD_LIMIT_FACTOR * root->dispatchLimit &&
+           NULL != (range = syncRangeFindPending (root)))
+        syncRangeDispatch (range, root);
 }
 
 /// MARK: - Sync
@@ -502,6 +652,12 @@ struct BREthereumBCSSyncStruct {
     BREthereumBCSSyncReportBlocks callbackBlocks;
     BREthereumBCSSyncReportProgress callbackProgress;
 
+    /** The provider of headers and account states; LES by default */
+    BREthereumBCSSyncProvider provider;
+
+    /** The maximum number of ranges dispatched concurrently */
+    size_t dispatchLimit;
+
     /** The root `range`, if a sync is in progress */
     BREthereumBCSSyncRange root;
 
@@ -509,6 +665,57 @@ struct BREthereumBCSSyncStruct {
     BRArrayOf(BREthereumBCSSyncResult) results;
 };
 
+/**
+ * Retire the root range of `sync` because the sync completed or was stopped.  The root is
+ * released now if no LES requests are outstanding; otherwise bcsSyncHandleProvision() releases
+ * it once the last one is handled.
+ */
+static void
+bcsSyncRetireRoot (BREthereumBCSSync sync) {
+    BREthereumBCSSyncRange root = sync->root;
+    sync->root = NULL;
+
+    root->stopped = ETHEREUM_BOOLEAN_TRUE;
+    if (0 == root->requestsCount)
+        syncRangeRelease (root);
+}
+
+extern BREthereumBoolean
+bcsSyncOwnsRange (BREthereumBCSSync sync,
+                  BREthereumBCSSyncRange range) {
+    // Every range in a sync has the sync's root as its root; the root's context is the sync.
+    return AS_ETHEREUM_BOOLEAN ((BREthereumBCSSync) syncRangeGetRoot(range)->context == sync);
+}
+
+static void
+bcsSyncProvideBlockHeadersLES (BREthereumBCSSync sync,
+                               BREthereumBCSSyncRange range,
+                               BREthereumNodeReference node,
+                               uint64_t start,
+                               uint32_t limit,
+                               uint64_t skip) {
+    lesProvideBlockHeaders (sync->les, node,
+                            (BREthereumLESProvisionContext) range,
+                            (BREthereumLESProvisionCallback) bcsSyncSignalProvision,
+                            start,
+                            limit,
+                            skip,
+                            ETHEREUM_BOOLEAN_FALSE);
+}
+
+static void
+bcsSyncProvideAccountStatesLES (BREthereumBCSSync sync,
+                                BREthereumBCSSyncRange range,
+                                BREthereumNodeReference node,
+                                BREthereumAddress address,
+                                OwnershipGiven BRArrayOf(BREthereumHash) hashes) {
+    lesProvideAccountStates (sync->les, node,
+                             (BREthereumLESProvisionContext) range,
+                             (BREthereumLESProvisionCallback) bcsSyncSignalProvision,
+                             address,
+                             hashes);
+}
+
 /**
  * Create a BCS sync.
  */
@@ -529,6 +736,13 @@ bcsSyncCreate (BREthereumBCSSyncContext context,
     sync->callbackBlocks = callbackBlocks;
     sync->callbackProgress = callbackProgress;
 
+    sync->provider = (BREthereumBCSSyncProvider) {
+        (BREthereumBCSSyncProviderContext) sync,
+        (BREthereumBCSSyncProvideBlockHeaders) bcsSyncProvideBlockHeadersLES,
+        (BREthereumBCSSyncProvideAccountStates) bcsSyncProvideAccountStatesLES
+    };
+    sync->dispatchLimit = SYNC_DISPATCH_LIMIT;
+
     // No sync in progress.
     sync->root = NULL;
 
@@ -542,8 +756,8 @@ bcsSyncCreate (BREthereumBCSSyncContext context,
  */
 extern void
 bcsSyncRelease (BREthereumBCSSync sync) {
-    // TODO: Recursively release `root`; ensure that pending LES callbacks don't crash.
-    if (NULL != sync->root) syncRangeRelease(sync->root);
+    // TODO: Ensure that pending LES callbacks don't crash.
+    if (NULL != sync->root) bcsSyncRetireRoot (sync);
 
     if (NULL != sync->results) {
         for (size_t index = 0; index < array_count(sync->results); index++)
@@ -555,6 +769,26 @@ bcsSyncRelease (BREthereumBCSSync sync) {
     free (sync);
 }
 
+/**
+ * Replace the provider of headers and account states.  The provider must answer each request by
+ * calling bcsSyncHandleProvision() with the request's `range`.  Only allowed when not active.
+ */
+extern void
+bcsSyncSetProvider (BREthereumBCSSync sync,
+                    BREthereumBCSSyncProvider provider) {
+    assert (NULL == sync->root);
+    sync->provider = provider;
+}
+
+/**
+ * Set the maximum number of ranges dispatched concurrently.  Applies to the next sync started.
+ */
+extern void
+bcsSyncSetDispatchLimit (BREthereumBCSSync sync,
+                         size_t limit) {
+    sync->dispatchLimit = (0 == limit ? 1 : limit);
+}
+
 /**
  * Return `true` if active; `false` otherwise
  */
@@ -622,10 +856,43 @@ bcsSyncRangeCallback (BREthereumBCSSync sync,
                                 sync->root->head);
 
     // If we are at the end, and `range` is root, then the sync is complete.
-    if (range == sync->root) {
-        syncRangeRelease(sync->root);
-        sync->root = NULL;
-    }
+    if (range == sync->root)
+        bcsSyncRetireRoot (sync);
+}
+
+/**
+ * Request the headers for `range` from the sync's provider.
+ */
+static void
+bcsSyncProvideBlockHeaders (BREthereumBCSSyncRange range) {
+    BREthereumBCSSyncRange root = syncRangeGetRoot (range);
+    BREthereumBCSSync sync = (BREthereumBCSSync) root->context;
+
+    root->requestsCount += 1;
+    sync->provider.provideBlockHeaders (sync->provider.context,
+                                        range,
+                                        range->node,
+                                        range->tail,
+                                        (uint32_t) (range->count + 1),  // both endpoints
+                                        range->step - 1);               // skip
+}
+
+/**
+ * Request the account states, at `hashes`, for `range` from the sync's provider.
+ */
+static void
+bcsSyncProvideAccountStates (BREthereumBCSSyncRange range,
+                             BREthereumNodeReference node,
+                             OwnershipGiven BRArrayOf(BREthereumHash) hashes) {
+    BREthereumBCSSyncRange root = syncRangeGetRoot (range);
+    BREthereumBCSSync sync = (BREthereumBCSSync) root->context;
+
+    root->requestsCount += 1;
+    sync->provider.provideAccountStates (sync->provider.context,
+                                         range,
+                                         node,
+                                         range->address,
+                                         hashes);
 }
 
 /**
@@ -667,7 +934,8 @@ bcsSyncStart (BREthereumBCSSync sync,
                                       (BREthereumBCSSyncRangeCallback) bcsSyncRangeCallback,
                                       chainBlockNumber /* + 1 */,
                                       needBlockNumber,
-                                      SYNC_LINEAR_LIMIT);
+                                      SYNC_LINEAR_LIMIT,
+                                      0.0);
 
     // ... but if total is too large, then build a MIXED sync with two children.  The first sync
     // will generally be a N_ARY sync, which may itself end with a LINEAR_SMALL sync.  But herein
@@ -698,7 +966,8 @@ bcsSyncStart (BREthereumBCSSync sync,
                                             NULL,
                                             chainBlockNumber,
                                             linearStartBlockNumber,
-                                            SYNC_LINEAR_LIMIT));
+                                            SYNC_LINEAR_LIMIT,
+                                            0.0));
 
         // Add the second child; we've orchastrated this is be a LINEAR sync.
         syncRangeAddChild (sync->root,
@@ -710,11 +979,18 @@ bcsSyncStart (BREthereumBCSSync sync,
                                             NULL,
                                             linearStartBlockNumber,
                                             needBlockNumber,
-                                            SYNC_LINEAR_LIMIT));
+                                            SYNC_LINEAR_LIMIT,
+                                            0.0));
     }
 
+    eth_log ("BCS", "Sync: Start%s", "");
+
+    // Callback to announce sync start
+    sync->root->callback (sync->root->context, sync->root, NULL, sync->root->tail);
+
     // Kick off the new sync.
-    syncRangeDispatch (sync->root);
+    sync->root->dispatchLimit = sync->dispatchLimit;
+    syncRangeContinue (sync->root);
 }
 
 extern void
@@ -734,8 +1010,7 @@ bcsSyncStopInternal (BREthereumBCSSync sync,
                             sync->root->head,
                             sync->root->head);
 
-    syncRangeRelease(sync->root);
-    sync->root = NULL;
+    bcsSyncRetireRoot (sync);
 }
 
 extern void
@@ -748,13 +1023,14 @@ bcsSyncStop (BREthereumBCSSync sync) {
 
 /**
  * Given all block headers then: a) for a N_ARY range, request the account states; or b) for a
- * LINEAR_SMALL range, invoke the callback to report the header results.
+ * LINEAR_SMALL range, hold the headers until all preceding ranges have been reported.
  */
 static void
 bcsSyncHandleBlockHeaders (BREthereumBCSSyncRange range,
                            BREthereumNodeReference node,
                            OwnershipGiven BRArrayOf(BREthereumBlockHeader) headers) {
     assert (1 + range->count == array_count(headers));
+    assert (SYNC_RANGE_REQUESTED == range->state);
     size_t count = array_count(headers);
 
     switch (range->type) {
@@ -775,24 +1051,22 @@ bcsSyncHandleBlockHeaders (BREthereumBCSSyncRange range,
             for (size_t index = 0; index < count; index++)
                 array_add (hashes,  blockHeaderGetHash (headers[index]));
 
-            lesProvideAccountStates (range->les, node,
-                                     (BREthereumLESProvisionContext) range,
-                                     (BREthereumLESProvisionCallback) bcsSyncSignalProvision,
-                                     range->address,
-                                     hashes);
+            bcsSyncProvideAccountStates (range, node, hashes);
             break;
         }
 
         case SYNC_LINEAR_SMALL: {
             BREthereumBCSSyncRange root = syncRangeGetRoot(range);
 
-            // TODO: Don't make `count` callback invocations; make one with `count` headers.
-            for (size_t index = 0; index < count; index++)
-                // `header` is now owned by `root->context`.
-                root->callback (root->context, range, headers[index], 0);
+            // Held and then reported by syncRangeComplete(), in block order.
+            range->headers = headers;
+            range->state = SYNC_RANGE_DONE;
 
-            array_free (headers);
-            syncRangeComplete (range);
+            assert (root->requestedCount > 0);
+            root->requestedCount -= 1;
+            root->heldCount += 1;
+
+            syncRangeContinue (root);
             break;
         }
     }
@@ -800,8 +1074,8 @@ bcsSyncHandleBlockHeaders (BREthereumBCSSyncRange range,
 
 /**
  * Given all the accoun states, compare each pair of consecutive accounts and if different create a
- * new subrange as a child to range.  Once all accounts have been compared then dispatch on the
- * first child (if any exist).
+ * new subrange as a child to range.  Once all accounts have been compared the range is DONE and
+ * its children (if any exist) are dispatched as capacity allows.
  */
 static void
 bcsSyncHandleAccountStates (BREthereumBCSSyncRange range,
@@ -815,6 +1089,21 @@ bcsSyncHandleAccountStates (BREthereumBCSSyncRange range,
     assert (array_count(hashes) == count);
 
     assert (SYNC_N_ARY == range->type);
+    assert (SYNC_RANGE_REQUESTED == range->state);
+
+    BREthereumBCSSyncRange root = syncRangeGetRoot (range);
+
+    // Update the observed density with this range's changes; then size the subranges with it.
+    // A subrange holds at least one change and, with a nonce increase, at least that many.
+    for (size_t index = 1; index < count; index++)
+        if (ETHEREUM_BOOLEAN_IS_FALSE(accountStateEqual(states[index - 1], states[index]))) {
+            uint64_t oldNonce = accountStateGetNonce (states[index - 1]);
+            uint64_t newNonce = accountStateGetNonce (states[index]);
+            root->changesCount += (newNonce > oldNonce ? newNonce - oldNonce : 1);
+        }
+    root->changesBlocks += range->head - range->tail;
+
+    double density = (double) root->changesCount / (double) root->changesBlocks;
 
     for (size_t index = 1; index < count; index++) {
         BREthereumAccountState oldState = states[index - 1];
@@ -840,10 +1129,10 @@ bcsSyncHandleAccountStates (BREthereumBCSSyncRange range,
                                                 NULL,
                                                 oldNumber,
                                                 newNumber,
-                                                SYNC_LINEAR_LIMIT_IF_N_ARY));
+                                                SYNC_LINEAR_LIMIT_IF_N_ARY,
+                                                density));
         }
     }
-    // TODO: Move this to syncRangeComplete?  Switch on type for N_ARY only?
 
     array_free (hashes);
     array_free (states);
@@ -852,30 +1141,35 @@ bcsSyncHandleAccountStates (BREthereumBCSSyncRange range,
     blockHeadersRelease(range->headers);
     range->headers = NULL;
 
-    // If we now have children, dispatch on the first one.  As each one completes, we'll
-    // dispatch on the subsequent ones until this N_ARY range itself completes.
-    if (NULL != range->children && array_count(range->children) > 0)
-        syncRangeDispatch(range->children[0]);
+    // This range is DONE; its children, if any, remain to be dispatched.
+    range->state = SYNC_RANGE_DONE;
+
+    assert (root->requestedCount > 0);
+    root->requestedCount -= 1;
 
-    // Otherwise nothing left, completely complete here and now.
-    else
-        syncRangeComplete(range);
+    syncRangeContinue (root);
 }
 
 /**
  * Compute the optimal `step` and `count` for a N_ARY sync over `numberOfBlocks`.
  *
  * @param numberOfBlocks
+ * @param countMinimum the smallest `count` considered
+ * @param countMaximum one more than the largest `count` considered
  * @param optimalStep
  * @param optimalCount
  */
 static void
 computeOptimalStep (uint64_t numberOfBlocks,
+                    uint64_t countMinimum,
+                    uint64_t countMaximum,
                     uint64_t *optimalStep,
                     uint64_t *optimalCount) {
+    assert (countMinimum < countMaximum);
+
     *optimalCount = 0;
     uint64_t optimalRemainder = UINT64_MAX;
-    for (size_t count = SYNC_N_ARY_REQUEST_MINIMUM; count < SYNC_N_ARY_REQUEST_MAXIMUM; count++) {
+    for (uint64_t count = countMinimum; count < countMaximum; count++) {
         uint64_t remainder = numberOfBlocks % count;
         if (remainder <= optimalRemainder) {
             optimalRemainder = remainder;
@@ -908,7 +1202,9 @@ computeOptimalStep (uint64_t numberOfBlocks,
 
 uint64_t optimalStep;
 uint64_t optimalCount;
-extern void optimal (uint64_t number) { computeOptimalStep (number, &optimalStep, &optimalCount); }
+extern void optimal (uint64_t number) {
+    computeOptimalStep (number, SYNC_N_ARY_REQUEST_MINIMUM, SYNC_N_ARY_REQUEST_MAXIMUM, &optimalStep, &optimalCount);
+}
 
 
 
@@ -919,52 +1215,62 @@ bcsSyncHandleProvision (BREthereumBCSSyncRange range,
                         OwnershipGiven BREthereumProvisionResult result) {
     assert (range->les == les);
 
-    BREthereumProvision *provision = &result.provision;
-    switch (result.status) {
-        case PROVISION_ERROR: {
-            BREthereumBCSSyncRange root = syncRangeGetRoot (range);
-            bcsSyncStopInternal((BREthereumBCSSync) root->context, "provision failed");
-            break;
-        }
-        case PROVISION_SUCCESS: {
-            assert (result.type == provision->type);
-            switch (result.type) {
-                case PROVISION_BLOCK_HEADERS: {
-                    BRArrayOf(BREthereumBlockHeader) headers;
-                    provisionHeadersConsume (&provision->u.headers, &headers);
-                    bcsSyncHandleBlockHeaders (range, node, headers);
-                    break;
-                }
-
-                case PROVISION_BLOCK_PROOFS:
-                    assert (0);
+    // The `root` stays valid while this request is outstanding - so through this function.
+    BREthereumBCSSyncRange root = syncRangeGetRoot (range);
+    assert (root->requestsCount > 0);
+
+    // If the sync completed or was stopped, just account for the request.
+    if (ETHEREUM_BOOLEAN_IS_FALSE (root->stopped)) {
+        BREthereumProvision *provision = &result.provision;
+        switch (result.status) {
+            case PROVISION_ERROR:
+                bcsSyncStopInternal ((BREthereumBCSSync) root->context, "provision failed");
+                break;
+
+            case PROVISION_SUCCESS: {
+                assert (result.type == provision->type);
+                switch (result.type) {
+                    case PROVISION_BLOCK_HEADERS: {
+                        BRArrayOf(BREthereumBlockHeader) headers;
+                        provisionHeadersConsume (&provision->u.headers, &headers);
+                        bcsSyncHandleBlockHeaders (range, node, headers);
+                        break;
+                    }
+
+                    case PROVISION_BLOCK_PROOFS:
+                        assert (0);
                     
-                case PROVISION_BLOCK_BODIES:
-                    assert (0);
-
-                case PROVISION_TRANSACTION_RECEIPTS:
-                    assert (0);
-
-                case PROVISION_ACCOUNTS: {
-                    BRArrayOf(BREthereumHash) hashes;
-                    BRArrayOf(BREthereumAccountState) accounts;
-                    provisionAccountsConsume (&provision->u.accounts, &hashes, &accounts);
-                    bcsSyncHandleAccountStates (range, node,
-                                                provision->u.accounts.address,
-                                                hashes,
-                                                accounts);
-                    break;
+                    case PROVISION_BLOCK_BODIES:
+                        assert (0);
+
+                    case PROVISION_TRANSACTION_RECEIPTS:
+                        assert (0);
+
+                    case PROVISION_ACCOUNTS: {
+                        BRArrayOf(BREthereumHash) hashes;
+                        BRArrayOf(BREthereumAccountState) accounts;
+                        provisionAccountsConsume (&provision->u.accounts, &hashes, &accounts);
+                        bcsSyncHandleAccountStates (range, node,
+                                                    provision->u.accounts.address,
+                                                    hashes,
+                                                    accounts);
+                        break;
+                    }
+
+                    case PROVISION_TRANSACTION_STATUSES:
+                        assert (0);
+
+                    case PROVISION_SUBMIT_TRANSACTION:
+                        assert (0);
                 }
-
-                case PROVISION_TRANSACTION_STATUSES:
-                    assert (0);
-
-                case PROVISION_SUBMIT_TRANSACTION:
-                    assert (0);
+                break;
             }
-            break;
         }
     }
     provisionResultRelease (&result);
+
+    root->requestsCount -= 1;
+    if (ETHEREUM_BOOLEAN_IS_TRUE (root->stopped) && 0 == root->requestsCount)
+        syncRangeRelease (root);
 }
 
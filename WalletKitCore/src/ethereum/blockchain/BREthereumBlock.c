@@ -275,6 +275,11 @@ blockHeaderGetNonce (BREthereumBlockHeader header) {
     return header->nonce;
 }
 
+extern BREthereumBloomFilter
+blockHeaderGetLogsBloom (BREthereumBlockHeader header) {
+    return header->logsBloom;
+}
+
 extern size_t
 blockHeaderHashValue (const void *h)
 {
@@ -315,6 +320,22 @@ blockHeaderMatchAddress (BREthereumBlockHeader header,
      ETHEREUM_BOOLEAN_IS_TRUE (blockHeaderMatch (header, logTopicGetBloomFilterAddress (address))));
 }
 
+extern size_t
+blockHeadersMatch (BREthereumBlockHeader *headers,
+                   size_t headersCount,
+                   BREthereumBloomFilterSet filters,
+                   uint64_t *matches) {
+    size_t matchesCount = 0;
+    memset (matches, 0, BLOOM_FILTER_SET_MATCHES_WORDS(headersCount) * sizeof (uint64_t));
+
+    for (size_t index = 0; index < headersCount; index++)
+        if (ETHEREUM_BOOLEAN_IS_TRUE (bloomFilterSetMatchAny (filters, &headers[index]->logsBloom))) {
+            matches[index / 64] |= ((uint64_t) 1) << (index % 64);
+            matchesCount++;
+        }
+    return matchesCount;
+}
+
 extern uint64_t
 chtRootNumberGetFromNumber (uint64_t number) {
     assert (0 != number);
@@ -545,11 +566,11 @@ blockHeaderRlpEncode (BREthereumBlockHeader header,
     items[ 4] = ethHashRlpEncode(header->transactionsRoot, coder);
     items[ 5] = ethHashRlpEncode(header->receiptsRoot, coder);
     items[ 6] = bloomFilterRlpEncode(header->logsBloom, coder);
-    items[ 7] = rlpEncodeUInt256 (coder, header->difficulty, 0);
-    items[ 8] = rlpEncodeUInt64(coder, header->number, 0);
-    items[ 9] = rlpEncodeUInt64(coder, header->gasLimit, 0);
-    items[10] = rlpEncodeUInt64(coder, header->gasUsed, 0);
-    items[11] = rlpEncodeUInt64(coder, header->timestamp, 0);
+    items[ 7] = rlpEncodeUInt256 (coder, header->difficulty, 1);
+    items[ 8] = rlpEncodeUInt64(coder, header->number, 1);
+    items[ 9] = rlpEncodeUInt64(coder, header->gasLimit, 1);
+    items[10] = rlpEncodeUInt64(coder, header->gasUsed, 1);
+    items[11] = rlpEncodeUInt64(coder, header->timestamp, 1);
     items[12] = rlpEncodeBytes(coder, header->extraData, header->extraDataCount);
 
     if (ETHEREUM_BOOLEAN_IS_TRUE(withNonce)) {
@@ -564,45 +585,50 @@ extern BREthereumBlockHeader
 blockHeaderRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder) {
+    return blockHeaderRlpDecodeView (rlpItemGetView (coder, item), type);
+}
+
+extern BREthereumBlockHeader
+blockHeaderRlpDecodeView (BRRlpView view,
+                          BREthereumRlpType type) {
     BREthereumBlockHeader header = (BREthereumBlockHeader) calloc (1, sizeof(struct BREthereumBlockHeaderRecord));
 
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    BRRlpView items[15];
+    size_t itemsCount = rlpViewDecodeList (view, items, 15);
     assert (13 == itemsCount || 15 == itemsCount);
 
     header->hash = ethHashCreateEmpty();
 
-    header->parentHash = ethHashRlpDecode(items[0], coder);
-    header->ommersHash = ethHashRlpDecode(items[1], coder);
-    header->beneficiary = ethAddressRlpDecode(items[2], coder);
-    header->stateRoot = ethHashRlpDecode(items[3], coder);
-    header->transactionsRoot = ethHashRlpDecode(items[4], coder);
-    header->receiptsRoot = ethHashRlpDecode(items[5], coder);
-    header->logsBloom = bloomFilterRlpDecode(items[6], coder);
-    header->difficulty = rlpDecodeUInt256(coder, items[7], 0);
-    header->number = rlpDecodeUInt64(coder, items[8], 0);
-    header->gasLimit = rlpDecodeUInt64(coder, items[9], 0);
-    header->gasUsed = rlpDecodeUInt64(coder, items[10], 0);
-    header->timestamp = rlpDecodeUInt64(coder, items[11], 0);
-
-    BRRlpData extraData = rlpDecodeBytes(coder, items[12]);
+    header->parentHash = ethHashRlpDecodeView(items[0]);
+    header->ommersHash = ethHashRlpDecodeView(items[1]);
+    header->beneficiary = ethAddressRlpDecodeView(items[2]);
+    header->stateRoot = ethHashRlpDecodeView(items[3]);
+    header->transactionsRoot = ethHashRlpDecodeView(items[4]);
+    header->receiptsRoot = ethHashRlpDecodeView(items[5]);
+    header->logsBloom = bloomFilterRlpDecodeView(items[6]);
+    int failed = 0;
+    header->difficulty = rlpViewDecodeUInt256(items[7], 1, &failed);
+    header->number = rlpViewDecodeUInt64(items[8], 1, &failed);
+    header->gasLimit = rlpViewDecodeUInt64(items[9], 1, &failed);
+    header->gasUsed = rlpViewDecodeUInt64(items[10], 1, &failed);
+    header->timestamp = rlpViewDecodeUInt64(items[11], 1, &failed);
+
+    BRRlpData extraData = rlpViewDecodeBytes(items[12]);
     memset (header->extraData, 0, 32);
     memcpy (header->extraData, extraData.bytes, extraData.bytesCount);
     header->extraDataCount = extraData.bytesCount;
-    rlpDataRelease(extraData);
 
     if (15 == itemsCount) {
-        header->mixHash = ethHashRlpDecode(items[13], coder);
-        header->nonce = rlpDecodeUInt64(coder, items[14], 0);
+        header->mixHash = ethHashRlpDecodeView(items[13]);
+        header->nonce = rlpViewDecodeUInt64(items[14], 0, &failed);
     }
+    assert (!failed);
 
 #if defined (BLOCK_HEADER_LOG_ALLOC_COUNT)
     eth_log ("MEM", "Block Header Create RLP: %d", ++blockHeaderAllocCount);
 #endif
 
-    BRRlpData data = rlpItemGetDataSharedDontRelease(coder, item);
-    header->hash = ethHashCreateFromData(data);
-    // Safe to ignore data release.
+    header->hash = ethHashCreateFromRlpView (view);
 
     return header;
 
@@ -943,14 +969,22 @@ blockTransactionsRlpDecode (BRRlpItem item,
                             BREthereumNetwork network,
                             BREthereumRlpType type,
                             BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    return blockTransactionsRlpDecodeView (rlpItemGetView (coder, item), network, type, coder);
+}
 
+extern BRArrayOf(BREthereumTransaction)
+blockTransactionsRlpDecodeView (BRRlpView view,
+                                BREthereumNetwork network,
+                                BREthereumRlpType type,
+                                BRRlpCoder coder) {
     BRArrayOf(BREthereumTransaction) transactions;
-    array_new(transactions, itemsCount);
+    array_new(transactions, rlpViewGetListCount (view));
 
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumTransaction transaction = transactionRlpDecode(items[i],
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+
+    while (rlpViewCursorNext (&cursor, &item)) {
+        BREthereumTransaction transaction = transactionRlpDecodeView(item,
                                                                      network,
                                                                      type,
                                                                      coder);
@@ -985,14 +1019,21 @@ blockOmmersRlpDecode (BRRlpItem item,
                       BREthereumNetwork network,
                       BREthereumRlpType type,
                       BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    return blockOmmersRlpDecodeView (rlpItemGetView (coder, item), network, type);
+}
 
+extern BRArrayOf(BREthereumBlockHeader)
+blockOmmersRlpDecodeView (BRRlpView view,
+                          BREthereumNetwork network,
+                          BREthereumRlpType type) {
     BRArrayOf (BREthereumBlockHeader) headers;
-    array_new(headers, itemsCount);
+    array_new(headers, rlpViewGetListCount (view));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
 
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumBlockHeader header = blockHeaderRlpDecode(items[i], type, coder);
+    while (rlpViewCursorNext (&cursor, &item)) {
+        BREthereumBlockHeader header = blockHeaderRlpDecodeView(item, type);
         array_add (headers, header);
     }
 
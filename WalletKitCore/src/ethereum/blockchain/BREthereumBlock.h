@@ -94,6 +94,14 @@ blockHeaderRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder);
 
+/**
+ * Decode a header directly from the RLP encoding referenced by `view`; nothing is copied but
+ * for the header's own fields.
+ */
+extern BREthereumBlockHeader
+blockHeaderRlpDecodeView (BRRlpView view,
+                          BREthereumRlpType type);
+
 extern BRRlpItem
 blockHeaderRlpEncode (BREthereumBlockHeader header,
                       BREthereumBoolean withNonce,
@@ -129,6 +137,9 @@ blockHeaderIsCHTRoot (BREthereumBlockHeader header);
 extern uint64_t
 blockHeaderGetNonce (BREthereumBlockHeader header);
 
+extern BREthereumBloomFilter
+blockHeaderGetLogsBloom (BREthereumBlockHeader header);
+
 extern BREthereumBoolean
 blockHeaderMatch (BREthereumBlockHeader header,
                   BREthereumBloomFilter filter);
@@ -137,6 +148,19 @@ extern BREthereumBoolean
 blockHeaderMatchAddress (BREthereumBlockHeader header,
                          BREthereumAddress address);
 
+/**
+ * Match the logsBloom of each of `headers` against `filters`; bit `i` of `matches` is set if
+ * `headers[i]` matches any filter.  The `matches` bitmap must hold
+ * BLOOM_FILTER_SET_MATCHES_WORDS(headersCount) words.
+ *
+ * @returns the number of matching headers
+ */
+extern size_t
+blockHeadersMatch (BREthereumBlockHeader *headers,
+                   size_t headersCount,
+                   BREthereumBloomFilterSet filters,
+                   uint64_t *matches);
+
 // Support BRSet
 extern size_t
 blockHeaderHashValue (const void *h);
@@ -506,6 +530,11 @@ blockOmmersRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder);
 
+extern BRArrayOf(BREthereumBlockHeader)
+blockOmmersRlpDecodeView (BRRlpView view,
+                          BREthereumNetwork network,
+                          BREthereumRlpType type);
+
 /**
  * Return BRArrayOf(BREthereumTransaction) w/ array owned by caller
  */
@@ -515,6 +544,12 @@ blockTransactionsRlpDecode (BRRlpItem item,
                             BREthereumRlpType type,
                             BRRlpCoder coder);
 
+extern BRArrayOf(BREthereumTransaction)
+blockTransactionsRlpDecodeView (BRRlpView view,
+                                BREthereumNetwork network,
+                                BREthereumRlpType type,
+                                BRRlpCoder coder);
+
 /// MARK: - Genesis Blocks
 
 /**
@@ -569,16 +604,30 @@ blockFree (BREthereumBlock block);
 
 /// MARK: - Proof of Work
 
+/**
+ * Create an Ethash 'light' verifier.  The per-epoch caches are held in a small LRU shared by all
+ * verifiers in the process; if `path` is not NULL, it names an existing directory where caches
+ * are persisted and from which they are memory-mapped on later use.  Verifiers may be used
+ * concurrently; no lock is held while a cache is built or a header is hashed.
+ */
 extern BREthereumProofOfWork
-proofOfWorkCreate (void);
+proofOfWorkCreate (const char *path);
 
 extern void
 proofOfWorkRelease (BREthereumProofOfWork pow);
 
+/**
+ * Prepare, in the background, the cache needed to verify `header`.
+ */
 extern void
 proofOfWorkGenerate (BREthereumProofOfWork pow,
                      BREthereumBlockHeader header);
 
+/**
+ * Compute the Ethash `n` (the 'result', to be compared against the header's difficulty) and
+ * `m` (the mix hash, to be compared against the header's mixHash) for `header`.  A header with
+ * zero difficulty has no POW; `n` is zero and `m` is EMPTY_HASH_INIT.
+ */
 extern void
 proofOfWorkCompute (BREthereumProofOfWork pow,
                     BREthereumBlockHeader header,
@@ -9,6 +9,7 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include "BREthereumBloomFilter.h"
 
@@ -89,9 +90,150 @@ bloomFilterEqual (const BREthereumBloomFilter filter1, const BREthereumBloomFilt
             : ETHEREUM_BOOLEAN_FALSE);
 }
 
+#define ETHEREUM_BLOOM_FILTER_LANES     (ETHEREUM_BLOOM_FILTER_BYTES / sizeof (uint64_t))
+
+static inline uint64_t
+bloomFilterGetLane (const BREthereumBloomFilter *filter, size_t lane) {
+    uint64_t value;
+    memcpy (&value, &filter->bytes[lane * sizeof (uint64_t)], sizeof (uint64_t));
+    return value;
+}
+
 extern BREthereumBoolean
 bloomFilterMatch (const BREthereumBloomFilter filter, const BREthereumBloomFilter other) {
-    return bloomFilterEqual(filter, bloomFilterOr(filter, other));
+    // `other` is contained in `filter` if `filter & other == other`, lane by lane.
+    uint64_t missing = 0;
+    for (size_t lane = 0; lane < ETHEREUM_BLOOM_FILTER_LANES; lane++) {
+        uint64_t otherLane = bloomFilterGetLane (&other, lane);
+        missing |= (bloomFilterGetLane (&filter, lane) & otherLane) ^ otherLane;
+    }
+    return AS_ETHEREUM_BOOLEAN (0 == missing);
+}
+
+//
+// Bloom Filter Set
+//
+typedef struct {
+    uint32_t lane;
+    uint64_t mask;
+} BREthereumBloomFilterSetLane;
+
+struct BREthereumBloomFilterSetRecord {
+    size_t filtersCount;
+
+    /// The lanes of filter `j` are `lanes[offsets[j]]` up to `lanes[offsets[j+1]]`
+    size_t *offsets;
+    BREthereumBloomFilterSetLane *lanes;
+};
+
+extern BREthereumBloomFilterSet
+bloomFilterSetCreate (const BREthereumBloomFilter *filters,
+                      size_t filtersCount) {
+    BREthereumBloomFilterSet set = calloc (1, sizeof (struct BREthereumBloomFilterSetRecord));
+
+    size_t lanesCount = 0;
+    for (size_t index = 0; index < filtersCount; index++)
+        for (size_t lane = 0; lane < ETHEREUM_BLOOM_FILTER_LANES; lane++)
+            if (0 != bloomFilterGetLane (&filters[index], lane)) lanesCount++;
+
+    set->filtersCount = filtersCount;
+    set->offsets = malloc ((filtersCount + 1) * sizeof (size_t));
+    set->lanes   = malloc ((0 == lanesCount ? 1 : lanesCount) * sizeof (BREthereumBloomFilterSetLane));
+
+    lanesCount = 0;
+    for (size_t index = 0; index < filtersCount; index++) {
+        set->offsets[index] = lanesCount;
+        for (size_t lane = 0; lane < ETHEREUM_BLOOM_FILTER_LANES; lane++) {
+            uint64_t mask = bloomFilterGetLane (&filters[index], lane);
+            if (0 != mask)
+                set->lanes[lanesCount++] = (BREthereumBloomFilterSetLane) { (uint32_t) lane, mask };
+        }
+    }
+    set->offsets[filtersCount] = lanesCount;
+
+    return set;
+}
+
+extern void
+bloomFilterSetRelease (BREthereumBloomFilterSet set) {
+    free (set->lanes);
+    free (set->offsets);
+    free (set);
+}
+
+extern size_t
+bloomFilterSetGetCount (BREthereumBloomFilterSet set) {
+    return set->filtersCount;
+}
+
+/// Check filter `index`, with `bloomLanes` being the bloom already split into lanes.
+static inline int
+bloomFilterSetMatchFilter (BREthereumBloomFilterSet set,
+                           size_t index,
+                           const uint64_t *bloomLanes) {
+    uint64_t missing = 0;
+    for (size_t offset = set->offsets[index]; offset < set->offsets[index + 1]; offset++) {
+        const BREthereumBloomFilterSetLane *lane = &set->lanes[offset];
+        missing |= (bloomLanes[lane->lane] & lane->mask) ^ lane->mask;
+    }
+    return 0 == missing;
+}
+
+static inline void
+bloomFilterSetLoadLanes (const BREthereumBloomFilter *bloom, uint64_t *bloomLanes) {
+    memcpy (bloomLanes, bloom->bytes, ETHEREUM_BLOOM_FILTER_BYTES);
+}
+
+static inline int
+bloomFilterSetMatchAnyLanes (BREthereumBloomFilterSet set, const uint64_t *bloomLanes) {
+    for (size_t index = 0; index < set->filtersCount; index++)
+        if (bloomFilterSetMatchFilter (set, index, bloomLanes)) return 1;
+    return 0;
+}
+
+extern BREthereumBoolean
+bloomFilterSetMatchAny (BREthereumBloomFilterSet set,
+                        const BREthereumBloomFilter *bloom) {
+    uint64_t bloomLanes[ETHEREUM_BLOOM_FILTER_LANES];
+    bloomFilterSetLoadLanes (bloom, bloomLanes);
+    return AS_ETHEREUM_BOOLEAN (bloomFilterSetMatchAnyLanes (set, bloomLanes));
+}
+
+extern size_t
+bloomFilterSetMatch (BREthereumBloomFilterSet set,
+                     const BREthereumBloomFilter *blooms,
+                     size_t bloomsCount,
+                     uint64_t *matches) {
+    size_t matchesCount = 0;
+    memset (matches, 0, BLOOM_FILTER_SET_MATCHES_WORDS(bloomsCount) * sizeof (uint64_t));
+
+    uint64_t bloomLanes[ETHEREUM_BLOOM_FILTER_LANES];
+    for (size_t index = 0; index < bloomsCount; index++) {
+        bloomFilterSetLoadLanes (&blooms[index], bloomLanes);
+        if (bloomFilterSetMatchAnyLanes (set, bloomLanes)) {
+            matches[index / 64] |= ((uint64_t) 1) << (index % 64);
+            matchesCount++;
+        }
+    }
+    return matchesCount;
+}
+
+extern size_t
+bloomFilterSetMatchEach (BREthereumBloomFilterSet set,
+                         const BREthereumBloomFilter *bloom,
+                         uint64_t *matches) {
+    size_t matchesCount = 0;
+    memset (matches, 0, BLOOM_FILTER_SET_MATCHES_WORDS(set->filtersCount) * sizeof (uint64_t));
+
+    uint64_t bloomLanes[ETHEREUM_BLOOM_FILTER_LANES];
+    bloomFilterSetLoadLanes (bloom, bloomLanes);
+
+    for (size_t index = 0; index < set->filtersCount; index++)
+        if (bloomFilterSetMatchFilter (set, index, bloomLanes)) {
+            matches[index / 64] |= ((uint64_t) 1) << (index % 64);
+            matchesCount++;
+        }
+    return matchesCount;
 }
 
 //
@@ -104,14 +246,18 @@ bloomFilterRlpEncode(BREthereumBloomFilter filter, BRRlpCoder coder) {
 
 extern BREthereumBloomFilter
 bloomFilterRlpDecode (BRRlpItem item, BRRlpCoder coder) {
+    return bloomFilterRlpDecodeView (rlpItemGetView (coder, item));
+}
+
+extern BREthereumBloomFilter
+bloomFilterRlpDecodeView (BRRlpView view) {
     BREthereumBloomFilter filter;
 
-    BRRlpData data = rlpDecodeBytes(coder, item);
+    BRRlpData data = rlpViewDecodeBytes (view);
     assert (256 == data.bytesCount);
 
     memcpy (filter.bytes, data.bytes, 256);
-    rlpDataRelease(data);
-    
+
     return filter;
 }
 
@@ -99,12 +99,76 @@ bloomFilterEqual (const BREthereumBloomFilter filter1, const BREthereumBloomFilt
 extern BREthereumBoolean
 bloomFilterMatch (const BREthereumBloomFilter filter, const BREthereumBloomFilter other);
 
+/// MARK: - Bloom Filter Set
+
+/**
+ * A BloomFilterSet holds many filters - typically one per address or topic of interest - prepared
+ * for matching against many blooms at once, such as the logsBloom of every header in a LES reply.
+ * Each filter is reduced to its non-zero 64-bit lanes; an address or topic filter sets at most
+ * three bits and thus has at most three lanes, so a match costs three AND/compares rather than a
+ * pass over all ETHEREUM_BLOOM_FILTER_BYTES.
+ */
+typedef struct BREthereumBloomFilterSetRecord *BREthereumBloomFilterSet;
+
+/**
+ * The number of uint64_t words in a bitmap holding `count` match bits.
+ */
+#define BLOOM_FILTER_SET_MATCHES_WORDS(count)     (((count) + 63) / 64)
+
+#define BLOOM_FILTER_SET_MATCHES_TEST(matches, index)     \
+    (0 != ((matches)[(index) / 64] & (((uint64_t) 1) << ((index) % 64))))
+
+extern BREthereumBloomFilterSet
+bloomFilterSetCreate (const BREthereumBloomFilter *filters,
+                      size_t filtersCount);
+
+extern void
+bloomFilterSetRelease (BREthereumBloomFilterSet set);
+
+extern size_t
+bloomFilterSetGetCount (BREthereumBloomFilterSet set);
+
+/**
+ * Check if any filter in `set` is contained in `bloom`; as bloomFilterMatch() over every filter.
+ */
+extern BREthereumBoolean
+bloomFilterSetMatchAny (BREthereumBloomFilterSet set,
+                        const BREthereumBloomFilter *bloom);
+
+/**
+ * Match each of `blooms` against `set`; bit `i` of `matches` is set if `blooms[i]` contains any
+ * filter in `set`.  The `matches` bitmap must hold BLOOM_FILTER_SET_MATCHES_WORDS(bloomsCount)
+ * words.
+ *
+ * @returns the number of matching blooms
+ */
+extern size_t
+bloomFilterSetMatch (BREthereumBloomFilterSet set,
+                     const BREthereumBloomFilter *blooms,
+                     size_t bloomsCount,
+                     uint64_t *matches);
+
+/**
+ * Match `bloom` against each filter in `set`; bit `j` of `matches` is set if `bloom` contains
+ * filter `j`.  Use this to find which of many tracked addresses a header is interesting to.  The
+ * `matches` bitmap must hold BLOOM_FILTER_SET_MATCHES_WORDS(bloomFilterSetGetCount(set)) words.
+ *
+ * @returns the number of matching filters
+ */
+extern size_t
+bloomFilterSetMatchEach (BREthereumBloomFilterSet set,
+                         const BREthereumBloomFilter *bloom,
+                         uint64_t *matches);
+
 extern BRRlpItem
 bloomFilterRlpEncode(BREthereumBloomFilter filter, BRRlpCoder coder);
 
 extern BREthereumBloomFilter
 bloomFilterRlpDecode (BRRlpItem item, BRRlpCoder coder);
 
+extern BREthereumBloomFilter
+bloomFilterRlpDecodeView (BRRlpView view);
+
 /**
  * Return a hex-encode string representation of `filter`.
  */
@@ -108,15 +108,13 @@ logTopicAsAddress (BREthereumLogTopic topic) {
 // Support
 //
 static BREthereumLogTopic
-logTopicRlpDecode (BRRlpItem item,
-                       BRRlpCoder coder) {
+logTopicRlpDecodeView (BRRlpView view) {
     BREthereumLogTopic topic;
 
-    BRRlpData data = rlpDecodeBytes(coder, item);
+    BRRlpData data = rlpViewDecodeBytes(view);
     assert (32 == data.bytesCount);
 
     memcpy (topic.bytes, data.bytes, 32);
-    rlpDataRelease(data);
 
     return topic;
 }
@@ -428,16 +426,15 @@ logTopicsRlpEncode (BREthereumLog log,
 }
 
 static BREthereumLogTopic *
-logTopicsRlpDecode (BRRlpItem item,
-                    BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
-
+logTopicsRlpDecodeView (BRRlpView view) {
     BREthereumLogTopic *topics;
-    array_new(topics, itemsCount);
+    array_new(topics, rlpViewGetListCount (view));
 
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumLogTopic topic = logTopicRlpDecode(items[i], coder);
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+
+    while (rlpViewCursorNext (&cursor, &item)) {
+        BREthereumLogTopic topic = logTopicRlpDecodeView(item);
         array_add(topics, topic);
     }
 
@@ -448,29 +445,40 @@ extern BREthereumLog
 logRlpDecode (BRRlpItem item,
               BREthereumRlpType type,
               BRRlpCoder coder) {
+    return logRlpDecodeView (rlpItemGetView (coder, item), type, coder);
+}
+
+extern BREthereumLog
+logRlpDecodeView (BRRlpView view,
+                  BREthereumRlpType type,
+                  BRRlpCoder coder) {
     BREthereumLog log = (BREthereumLog) calloc (1, sizeof (struct BREthereumLogRecord));
 
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    BRRlpView items[6];
+    size_t itemsCount = rlpViewDecodeList (view, items, 6);
     assert ((3 == itemsCount && RLP_TYPE_NETWORK == type) ||
             (6 == itemsCount && RLP_TYPE_ARCHIVE == type));
 
-    log->address = ethAddressRlpDecode(items[0], coder);
-    log->topics = logTopicsRlpDecode (items[1], coder);
+    log->address = ethAddressRlpDecodeView(items[0]);
+    log->topics = logTopicsRlpDecodeView (items[1]);
 
-    log->data = rlpItemGetData (coder, items[2]); //  rlpDecodeBytes(coder, items[2]);
+    log->data = rlpDataCopy (rlpViewGetData (items[2])); //  rlpDecodeBytes(coder, items[2]);
 
     // 
     log->identifier.transactionReceiptIndex = LOG_TRANSACTION_RECEIPT_INDEX_UNKNOWN;
 
     if (RLP_TYPE_ARCHIVE == type) {
-        BREthereumHash hash = ethHashRlpDecode(items[3], coder);
+        BREthereumHash hash = ethHashRlpDecodeView(items[3]);
 
-        uint64_t transactionReceiptIndex = rlpDecodeUInt64(coder, items[4], 0);
-        assert (transactionReceiptIndex <= (uint64_t) SIZE_MAX);
+        int failed = 0;
+        uint64_t transactionReceiptIndex = rlpViewDecodeUInt64(items[4], 0, &failed);
+        assert (!failed && transactionReceiptIndex <= (uint64_t) SIZE_MAX);
 
         logInitializeIdentifier (log, hash, (size_t) transactionReceiptIndex);
-        log->status = transactionStatusRLPDecode(items[5], NULL, coder);
+
+        BRRlpItem statusItem = rlpViewGetItem (coder, items[5]);
+        log->status = transactionStatusRLPDecode(statusItem, NULL, coder);
+        rlpItemRelease (coder, statusItem);
     }
     return log;
 }
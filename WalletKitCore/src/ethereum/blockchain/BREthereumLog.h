@@ -163,6 +163,15 @@ extern BREthereumLog
 logRlpDecode (BRRlpItem item,
               BREthereumRlpType type,
               BRRlpCoder coder);
+
+/**
+ * Decode a log directly from the RLP encoding referenced by `view`.  The `coder` is only needed
+ * for a RLP_TYPE_ARCHIVE status.
+ */
+extern BREthereumLog
+logRlpDecodeView (BRRlpView view,
+                  BREthereumRlpType type,
+                  BRRlpCoder coder);
 /**
  * [QUASI-INTERNAL - used by BREthereumBlock]
  */
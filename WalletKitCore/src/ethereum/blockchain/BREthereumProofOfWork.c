@@ -9,12 +9,31 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <stdlib.h>
-#include <stdarg.h>
-#include "support/BRArray.h"
-#include "support/BRSet.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "support/BRCrypto.h"
+#include "support/BRInt.h"
 #include "ethereum/rlp/BRRlp.h"
 #include "BREthereumBlock.h"
 
+//
+// Ethash - see https://github.com/ethereum/wiki/wiki/Ethash
+//
+// We implement 'light' verification: for each epoch we generate the 'cache' (16MB growing by
+// 128KB per epoch) and then, when verifying a header, compute the needed 'full dataset' items
+// on demand from the cache.  Verifying a header touches POW_ACCESSES * 2 dataset items, each
+// derived from POW_PARENTS cache nodes.
+//
+// Word arithmetic assumes a little-endian host, as does the rest of Core.
+//
 #define POW_WORD_BYTES            (4)
 #define POW_DATA_SET_INIT         (1 << 30)
 #define POW_DATA_SET_GROWTH       (1 << 23)
@@ -27,141 +46,619 @@
 #define POW_CACHE_ROUNDS          (3)
 #define POW_ACCESSES              (64)
 
+#define POW_HASH_WORDS            (POW_HASH_BYTES / POW_WORD_BYTES)
+#define POW_MIX_WORDS             (POW_MIX_BYTES  / POW_WORD_BYTES)
+#define POW_MIX_NODES             (POW_MIX_BYTES  / POW_HASH_BYTES)
+
+#define POW_FNV_PRIME             (0x01000193)
+
+/// The number of epoch caches held, process-wide; the current epoch, the next one and one straggler.
+#define POW_CACHE_COUNT           (3)
+
+/// Start building the next epoch's cache once a header is within this many blocks of it.
+#define POW_CACHE_PREFETCH_BLOCKS (2000)
+
+/// The persisted cache file: a header followed by the cache nodes, page aligned.
+#define POW_CACHE_FILE_MAGIC      "ETHASH01"
+#define POW_CACHE_FILE_HEADER     (4096)
+#define POW_CACHE_FILE_FORMAT     "%s/ethash-%" PRIu64 ".cache"
+
+#define POW_PTHREAD_STACK_SIZE    (64 * 1024)
+
+typedef void* (*ThreadRoutine) (void*);
+
+typedef union {
+    uint8_t  bytes[POW_HASH_BYTES];
+    uint32_t words[POW_HASH_WORDS];
+} BREthereumProofOfWorkNode;
+
+typedef enum {
+    POW_CACHE_EMPTY,
+    POW_CACHE_BUILDING,
+    POW_CACHE_READY
+} BREthereumProofOfWorkCacheState;
+
+typedef struct {
+    BREthereumProofOfWorkCacheState state;
+    uint64_t epoch;
+    uint64_t lastUsed;
+
+    /// The number of hashimoto computations reading `nodes`; a pinned cache is never evicted.
+    size_t pins;
+
+    /// The cache nodes; owned via `base`, which is either malloc'd or mmap'd
+    BREthereumProofOfWorkNode *nodes;
+    size_t nodesCount;
+
+    void  *base;
+    size_t baseSize;
+    int    mapped;
+} BREthereumProofOfWorkCache;
+
+//
+// Epoch Caches
+//
+// A cache depends only on its epoch, so one LRU is shared by every verifier in the process (one
+// per BCS, and so one per network and account) rather than each holding, and building, its own.
+// The caches are freed once the last verifier is released.
+//
+static struct {
+    BREthereumProofOfWorkCache caches[POW_CACHE_COUNT];
+    uint64_t tick;
+    size_t users;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+} powCaches = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER
+};
+
 //
 // Proof Of Work
 //
 struct BREthereumProofOfWorkStruct {
-    int foo;
+    /// If non-NULL, the directory holding persisted epoch caches
+    char *path;
+
+    /// Scratch coder for the header's 'seal' hash; used with `lock` held.
+    BRRlpCoder coder;
+
+    /// A single background builder, used for prefetching upcoming epochs.
+    pthread_t thread;
+    int threadStarted;
+    int threadRunning;
+    uint64_t threadEpoch;
+
+    /// Protects `coder` and the builder's state; never held while building or hashing.
+    pthread_mutex_t lock;
 };
 
 extern BREthereumProofOfWork
-proofOfWorkCreate (void) {
+proofOfWorkCreate (const char *path) {
     BREthereumProofOfWork pow = calloc (1, sizeof (struct BREthereumProofOfWorkStruct));
 
-    pow->foo = 0;
+    pow->path  = (NULL == path ? NULL : strdup (path));
+    pow->coder = rlpCoderCreate();
+
+    pow->threadStarted = 0;
+    pow->threadRunning = 0;
+
+    pthread_mutex_init (&pow->lock, NULL);
+
+    pthread_mutex_lock (&powCaches.lock);
+    powCaches.users += 1;
+    pthread_mutex_unlock (&powCaches.lock);
 
     return pow;
 }
 
+static void
+powCacheFree (BREthereumProofOfWorkCache *cache) {
+    if (NULL != cache->base) {
+        if (cache->mapped) munmap (cache->base, cache->baseSize);
+        else free (cache->base);
+    }
+    memset (cache, 0, sizeof (BREthereumProofOfWorkCache));
+    cache->state = POW_CACHE_EMPTY;
+}
+
 extern void
 proofOfWorkRelease (BREthereumProofOfWork pow) {
+    pthread_mutex_lock (&pow->lock);
+    int threadStarted = pow->threadStarted;
+    pow->threadStarted = 0;
+    pthread_mutex_unlock (&pow->lock);
+
+    // Wait out any background build; it is bounded and not cancellable.
+    if (threadStarted) pthread_join (pow->thread, NULL);
+
+    // The last verifier out frees the caches; none can be pinned or building without a verifier.
+    pthread_mutex_lock (&powCaches.lock);
+    if (0 == --powCaches.users)
+        for (size_t index = 0; index < POW_CACHE_COUNT; index++) {
+            assert (0 == powCaches.caches[index].pins && POW_CACHE_BUILDING != powCaches.caches[index].state);
+            powCacheFree (&powCaches.caches[index]);
+        }
+    pthread_mutex_unlock (&powCaches.lock);
+
+    rlpCoderRelease (pow->coder);
+    if (NULL != pow->path) free (pow->path);
+
+    pthread_mutex_destroy (&pow->lock);
+
     free (pow);
 }
 
-#if defined (INCLUDE_UNUSED_FUNCTIONS)
+/// MARK: - Ethash Parameters
+
 static uint64_t
-powEpoch (BREthereumBlockHeader header) {
-    return blockHeaderGetNonce(header) / POW_EPOCH;
+powEpoch (uint64_t number) {
+    return number / POW_EPOCH;
+}
+
+static int
+powIsPrime (uint64_t x) {
+    if (x < 2) return 0;
+    if (x < 4) return 1;
+    if (0 == x % 2) return 0;
+    for (uint64_t d = 3; d * d <= x; d += 2)
+        if (0 == x % d) return 0;
+    return 1;
 }
 
 static uint64_t
-powPrime (uint64_t x, uint64_t y) {
-    return (0 == x % y
-            ? x
-            : powPrime (x - 2 * y, y));
+powSizeForEpoch (uint64_t epoch, uint64_t init, uint64_t growth, uint64_t unit) {
+    uint64_t size = init + growth * epoch - unit;
+    while (!powIsPrime (size / unit))
+        size -= 2 * unit;
+    return size;
 }
 
 static uint64_t
-powDatasetSize (BREthereumBlockHeader header) {
-    return powPrime (POW_DATA_SET_INIT + POW_DATA_SET_GROWTH * powEpoch(header) - POW_MIX_BYTES,
-                     POW_MIX_BYTES);
+powCacheSize (uint64_t epoch) {
+    return powSizeForEpoch (epoch, POW_CACHE_INIT, POW_CACHE_GROWTH, POW_HASH_BYTES);
 }
 
 static uint64_t
-powCacheSize (BREthereumBlockHeader header) {
-    return powPrime (POW_CACHE_INIT + POW_CACHE_GROWTH * powEpoch(header) - POW_HASH_BYTES,
-                     POW_HASH_BYTES);
+powDatasetSize (uint64_t epoch) {
+    return powSizeForEpoch (epoch, POW_DATA_SET_INIT, POW_DATA_SET_GROWTH, POW_MIX_BYTES);
+}
+
+static void
+powSeedHash (uint64_t epoch, uint8_t seed[32]) {
+    memset (seed, 0, 32);
+    for (uint64_t index = 0; index < epoch; index++)
+        BRKeccak256 (seed, seed, 32);
+}
+
+static inline uint32_t
+powFNV (uint32_t x, uint32_t y) {
+    return x * POW_FNV_PRIME ^ y;
+}
+
+/// MARK: - Cache
+
+///
+/// Fill `nodes` with the cache for `epoch`.  The cache is a sequential Keccak-512 chain followed
+/// by POW_CACHE_ROUNDS of 'RandMemoHash'; every step depends on the previous one.
+///
+static void
+powCacheMake (BREthereumProofOfWorkNode *nodes, size_t nodesCount, uint64_t epoch) {
+    uint8_t seed[32];
+    powSeedHash (epoch, seed);
+
+    BRKeccak512 (nodes[0].bytes, seed, sizeof (seed));
+    for (size_t index = 1; index < nodesCount; index++)
+        BRKeccak512 (nodes[index].bytes, nodes[index - 1].bytes, POW_HASH_BYTES);
+
+    for (size_t round = 0; round < POW_CACHE_ROUNDS; round++)
+        for (size_t index = 0; index < nodesCount; index++) {
+            const BREthereumProofOfWorkNode *prev  = &nodes[(index - 1 + nodesCount) % nodesCount];
+            const BREthereumProofOfWorkNode *other = &nodes[nodes[index].words[0] % nodesCount];
+
+            BREthereumProofOfWorkNode data;
+            for (size_t word = 0; word < POW_HASH_WORDS; word++)
+                data.words[word] = prev->words[word] ^ other->words[word];
+
+            BRKeccak512 (nodes[index].bytes, data.bytes, POW_HASH_BYTES);
+        }
+}
+
+static char *
+powCacheFilename (BREthereumProofOfWork pow, uint64_t epoch) {
+    size_t filenameLength = strlen (pow->path) + 32;
+    char  *filename = malloc (filenameLength);
+    snprintf (filename, filenameLength, POW_CACHE_FILE_FORMAT, pow->path, epoch);
+    return filename;
+}
+
+static void
+powCacheFileHeaderFill (uint8_t *header, uint64_t epoch, uint64_t nodesCount) {
+    memcpy (header, POW_CACHE_FILE_MAGIC, 8);
+    UInt64SetLE (&header[ 8], epoch);
+    UInt64SetLE (&header[16], nodesCount);
 }
 
-static BREthereumHash
-powSeedHashInternal (uint64_t number) {
-    BREthereumHash bytes;
+///
+/// Map a previously persisted cache for `epoch`; return 1 on success.
+///
+static int
+powCacheLoad (BREthereumProofOfWork pow, BREthereumProofOfWorkCache *cache, uint64_t epoch, size_t nodesCount) {
+    if (NULL == pow->path) return 0;
 
-    if (0 == number)
-        memset (bytes.bytes, 0, 32);
-    else
-        bytes = powSeedHashInternal(number - POW_EPOCH);
+    char *filename = powCacheFilename (pow, epoch);
+    int fd = open (filename, O_RDONLY);
+    free (filename);
+    if (-1 == fd) return 0;
 
-    return hashCreateFromData ((BRRlpData) { 32, bytes.bytes });
+    size_t baseSize = POW_CACHE_FILE_HEADER + nodesCount * POW_HASH_BYTES;
+
+    struct stat fileStat;
+    if (0 != fstat (fd, &fileStat) || baseSize != (size_t) fileStat.st_size) { close (fd); return 0; }
+
+    void *base = mmap (NULL, baseSize, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if (MAP_FAILED == base) return 0;
+
+    uint8_t header[24];
+    powCacheFileHeaderFill (header, epoch, nodesCount);
+    if (0 != memcmp (base, header, sizeof (header))) { munmap (base, baseSize); return 0; }
+
+    cache->base     = base;
+    cache->baseSize = baseSize;
+    cache->mapped   = 1;
+    cache->nodes    = (BREthereumProofOfWorkNode *) ((uint8_t *) base + POW_CACHE_FILE_HEADER);
+    cache->nodesCount = nodesCount;
+    return 1;
 }
 
-static BREthereumHash
-powSeedHash (BREthereumBlockHeader header) {
-    return powSeedHashInternal(blockHeaderGetNumber(header));
+///
+/// Build the cache for `epoch` directly into a file-backed mapping, so that it is persisted as a
+/// side effect; fall back to heap memory if the file can't be created.  The file is written
+/// under a temporary name and only renamed once complete.
+///
+static void
+powCacheBuild (BREthereumProofOfWork pow, BREthereumProofOfWorkCache *cache, uint64_t epoch, size_t nodesCount) {
+    size_t baseSize = POW_CACHE_FILE_HEADER + nodesCount * POW_HASH_BYTES;
+
+    if (NULL != pow->path) {
+        char *filename = powCacheFilename (pow, epoch);
+
+        size_t filenameTempLength = strlen (filename) + 5;
+        char  *filenameTemp = malloc (filenameTempLength);
+        snprintf (filenameTemp, filenameTempLength, "%s.tmp", filename);
+
+        int fd = open (filenameTemp, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        void *base = MAP_FAILED;
+
+        if (-1 != fd && 0 == ftruncate (fd, (off_t) baseSize))
+            base = mmap (NULL, baseSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (-1 != fd) close (fd);
+
+        if (MAP_FAILED != base) {
+            powCacheMake ((BREthereumProofOfWorkNode *) ((uint8_t *) base + POW_CACHE_FILE_HEADER),
+                          nodesCount, epoch);
+            powCacheFileHeaderFill (base, epoch, nodesCount);
+
+            if (0 == msync (base, baseSize, MS_SYNC) && 0 == rename (filenameTemp, filename)) {
+                // Drop the file that fell out of the LRU long ago; we only ever move forward.
+                if (epoch >= POW_CACHE_COUNT) {
+                    char *filenameStale = powCacheFilename (pow, epoch - POW_CACHE_COUNT);
+                    unlink (filenameStale);
+                    free (filenameStale);
+                }
+            }
+            else unlink (filenameTemp);
+
+            cache->base     = base;
+            cache->baseSize = baseSize;
+            cache->mapped   = 1;
+        }
+        else if (-1 != fd) unlink (filenameTemp);
+
+        free (filenameTemp);
+        free (filename);
+    }
+
+    if (NULL == cache->base) {
+        cache->base     = malloc (baseSize);
+        cache->baseSize = baseSize;
+        cache->mapped   = 0;
+        powCacheMake ((BREthereumProofOfWorkNode *) ((uint8_t *) cache->base + POW_CACHE_FILE_HEADER),
+                      nodesCount, epoch);
+    }
+
+    cache->nodes      = (BREthereumProofOfWorkNode *) ((uint8_t *) cache->base + POW_CACHE_FILE_HEADER);
+    cache->nodesCount = nodesCount;
 }
 
-static BREthereumData
-powLittleRMH (BREthereumData x, uint64_t i, uint64_t n) {
-    return x;
+/// Find the READY or BUILDING cache for `epoch`; must hold `powCaches.lock`.
+static BREthereumProofOfWorkCache *
+powCacheLookup (uint64_t epoch) {
+    for (size_t index = 0; index < POW_CACHE_COUNT; index++)
+        if (POW_CACHE_EMPTY != powCaches.caches[index].state && epoch == powCaches.caches[index].epoch)
+            return &powCaches.caches[index];
+    return NULL;
 }
 
-static BREthereumData
-powBigRMH (BREthereumData x, uint64_t n) {
-    for (uint64_t i = 0; i < n; i++)
-        powLittleRMH(x, i, n);
-    return x;
+///
+/// Reserve a cache for `epoch`, marking it BUILDING, by taking an EMPTY slot or evicting the
+/// least-recently used unpinned READY one.  Returns NULL if every slot is being built or read;
+/// must hold `powCaches.lock`.
+///
+static BREthereumProofOfWorkCache *
+powCacheReserve (uint64_t epoch) {
+    BREthereumProofOfWorkCache *victim = NULL;
+
+    for (size_t index = 0; index < POW_CACHE_COUNT; index++) {
+        BREthereumProofOfWorkCache *cache = &powCaches.caches[index];
+        if (POW_CACHE_EMPTY == cache->state) { victim = cache; break; }
+        if (POW_CACHE_READY == cache->state && 0 == cache->pins &&
+            (NULL == victim || cache->lastUsed < victim->lastUsed))
+            victim = cache;
+    }
+
+    if (NULL != victim) {
+        powCacheFree (victim);
+        victim->state = POW_CACHE_BUILDING;
+        victim->epoch = epoch;
+    }
+    return victim;
+}
+
+///
+/// Fill a reserved `cache`, from `pow`'s persisted file if possible.  Must be called with no lock
+/// held; the cache is published as READY under `powCaches.lock`.
+///
+static void
+powCacheFill (BREthereumProofOfWork pow, BREthereumProofOfWorkCache *cache) {
+    pthread_mutex_lock (&powCaches.lock);
+    uint64_t epoch = cache->epoch;
+    pthread_mutex_unlock (&powCaches.lock);
+
+    size_t nodesCount = (size_t) (powCacheSize (epoch) / POW_HASH_BYTES);
+
+    BREthereumProofOfWorkCache filled = { POW_CACHE_BUILDING, epoch };
+    if (!powCacheLoad (pow, &filled, epoch, nodesCount))
+        powCacheBuild (pow, &filled, epoch, nodesCount);
+
+    pthread_mutex_lock (&powCaches.lock);
+    filled.state    = POW_CACHE_READY;
+    filled.lastUsed = powCaches.tick;
+    *cache = filled;
+    pthread_cond_broadcast (&powCaches.cond);
+    pthread_mutex_unlock (&powCaches.lock);
 }
 
-static BREthereumData
-powCacheRounds (BREthereumData x, uint64_t y, uint64_t n) {
-    return (0 == y
-            ? x
-            : (1 == y
-               ? powBigRMH (x, n)
-               : powCacheRounds (powBigRMH (x, n), y - 1, n)));
+static void *
+powCacheFillThread (BREthereumProofOfWork pow) {
+    // `threadEpoch` is fixed for the life of this thread.
+    pthread_mutex_lock (&powCaches.lock);
+    BREthereumProofOfWorkCache *cache = powCacheLookup (pow->threadEpoch);
+    pthread_mutex_unlock (&powCaches.lock);
+
+    // Only this thread moves `cache` out of BUILDING, so it can't be evicted underneath us.
+    assert (NULL != cache && POW_CACHE_BUILDING == cache->state);
+    powCacheFill (pow, cache);
+
+    pthread_mutex_lock (&pow->lock);
+    pow->threadRunning = 0;
+    pthread_mutex_unlock (&pow->lock);
+    return NULL;
 }
 
+///
+/// Start building the cache for `epoch` in the background, unless it already exists or `pow`'s
+/// background builder is busy.  Must hold `pow->lock`.
+///
 static void
-powBigFNV (BREthereumData x,
-           BREthereumData y) {
+powCachePrefetch (BREthereumProofOfWork pow, uint64_t epoch) {
+    if (pow->threadRunning) return;
+
+    // A finished builder still needs to be joined before it can be reused.
+    if (pow->threadStarted) {
+        pthread_join (pow->thread, NULL);
+        pow->threadStarted = 0;
+    }
+
+    pthread_mutex_lock (&powCaches.lock);
+    int reserved = (NULL == powCacheLookup (epoch) && NULL != powCacheReserve (epoch));
+    pthread_mutex_unlock (&powCaches.lock);
+    if (!reserved) return;
+
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+    pthread_attr_setstacksize (&attr, POW_PTHREAD_STACK_SIZE);
+
+    pow->threadEpoch   = epoch;
+    pow->threadRunning = 1;
+    pow->threadStarted = 1;
+    if (0 != pthread_create (&pow->thread, &attr, (ThreadRoutine) powCacheFillThread, pow)) {
+        pow->threadRunning = 0;
+        pow->threadStarted = 0;
+
+        pthread_mutex_lock (&powCaches.lock);
+        powCacheFree (powCacheLookup (epoch));
+        pthread_cond_broadcast (&powCaches.cond);
+        pthread_mutex_unlock (&powCaches.lock);
+    }
+    pthread_attr_destroy (&attr);
 }
 
-static BREthereumData
-powMix (BREthereumData m,
-        BREthereumData c,
-        uint64_t i,
-        uint64_t p) {
-    return (0 == p
-            ? m
-            : m);
+///
+/// Return the READY cache for `epoch`, pinned, building it on this thread or waiting on another
+/// builder as needed.  Must be called with no lock held; no lock is held while building.  The
+/// caller must `powCacheUnpin()` the cache when done reading it.
+///
+static BREthereumProofOfWorkCache *
+powCacheAcquire (BREthereumProofOfWork pow, uint64_t epoch) {
+    pthread_mutex_lock (&powCaches.lock);
+    while (1) {
+        BREthereumProofOfWorkCache *cache = powCacheLookup (epoch);
+
+        if (NULL != cache && POW_CACHE_READY == cache->state) {
+            cache->lastUsed = ++powCaches.tick;
+            cache->pins    += 1;
+            pthread_mutex_unlock (&powCaches.lock);
+            return cache;
+        }
+
+        if (NULL == cache && NULL != (cache = powCacheReserve (epoch))) {
+            pthread_mutex_unlock (&powCaches.lock);
+            powCacheFill (pow, cache);
+            pthread_mutex_lock (&powCaches.lock);
+            continue;
+        }
+
+        // Either `epoch` is being built elsewhere or every slot is busy; wait for a change.
+        pthread_cond_wait (&powCaches.cond, &powCaches.lock);
+    }
 }
 
-static BREthereumData
-powParents (BREthereumData c,
-            uint64_t i,
-            uint64_t p,
-            BREthereumData m) {
-    return (p < POW_PARENTS - 1
-            ? powParents(c, i, p + 1, powMix (m, c, i, p + 1))
-            : powMix (m, c, i, p + 1));
+static void
+powCacheUnpin (BREthereumProofOfWorkCache *cache) {
+    pthread_mutex_lock (&powCaches.lock);
+    assert (cache->pins > 0);
+    if (0 == --cache->pins)
+        pthread_cond_broadcast (&powCaches.cond);
+    pthread_mutex_unlock (&powCaches.lock);
 }
 
-static BREthereumData
-powDatasetItem (BREthereumData c,
-                uint64_t i) {
-    return powParents(c, i, -i, (BREthereumData) { 0, NULL });
+/// MARK: - Hashimoto
+
+///
+/// Compute the POW_MIX_NODES consecutive dataset items starting at `index`.  Each item walks
+/// POW_PARENTS cache nodes, each chosen from the previous step's mix, so a single item is a chain
+/// of dependent cache misses; walking the items in lockstep overlaps their misses.
+///
+static void
+powDatasetItems (const BREthereumProofOfWorkCache *cache,
+                 uint32_t index,
+                 BREthereumProofOfWorkNode items[POW_MIX_NODES]) {
+    const BREthereumProofOfWorkNode *nodes = cache->nodes;
+    uint32_t nodesCount = (uint32_t) cache->nodesCount;
+
+    for (uint32_t item = 0; item < POW_MIX_NODES; item++) {
+        items[item] = nodes[(index + item) % nodesCount];
+        items[item].words[0] ^= index + item;
+        BRKeccak512 (items[item].bytes, items[item].bytes, POW_HASH_BYTES);
+    }
+
+    for (uint32_t parent = 0; parent < POW_PARENTS; parent++)
+        for (uint32_t item = 0; item < POW_MIX_NODES; item++) {
+            BREthereumProofOfWorkNode *mix = &items[item];
+            const BREthereumProofOfWorkNode *node =
+            &nodes[powFNV ((index + item) ^ parent, mix->words[parent % POW_HASH_WORDS]) % nodesCount];
+
+            for (size_t word = 0; word < POW_HASH_WORDS; word++)
+                mix->words[word] = powFNV (mix->words[word], node->words[word]);
+        }
+
+    for (uint32_t item = 0; item < POW_MIX_NODES; item++)
+        BRKeccak512 (items[item].bytes, items[item].bytes, POW_HASH_BYTES);
 }
-// On and On and On....
-#endif
+
+static void
+powHashimotoLight (const BREthereumProofOfWorkCache *cache,
+                   uint64_t datasetSize,
+                   const uint8_t headerHash[32],
+                   uint64_t nonce,
+                   uint8_t mixDigest[32],
+                   uint8_t result[32]) {
+    uint32_t pages = (uint32_t) (datasetSize / POW_MIX_BYTES);
+
+    // s = keccak512 (headerHash ++ littleEndian(nonce))
+    uint8_t seed[32 + 8];
+    memcpy (seed, headerHash, 32);
+    UInt64SetLE (&seed[32], nonce);
+
+    BREthereumProofOfWorkNode s;
+    BRKeccak512 (s.bytes, seed, sizeof (seed));
+
+    uint32_t mix[POW_MIX_WORDS];
+    for (size_t node = 0; node < POW_MIX_NODES; node++)
+        memcpy (&mix[node * POW_HASH_WORDS], s.words, POW_HASH_BYTES);
+
+    for (uint32_t access = 0; access < POW_ACCESSES; access++) {
+        uint32_t page = powFNV (access ^ s.words[0], mix[access % POW_MIX_WORDS]) % pages;
+
+        BREthereumProofOfWorkNode items[POW_MIX_NODES];
+        powDatasetItems (cache, page * POW_MIX_NODES, items);
+
+        for (uint32_t node = 0; node < POW_MIX_NODES; node++)
+            for (size_t word = 0; word < POW_HASH_WORDS; word++)
+                mix[node * POW_HASH_WORDS + word] = powFNV (mix[node * POW_HASH_WORDS + word], items[node].words[word]);
+    }
+
+    // Compress the mix to 8 words
+    uint32_t cmix[POW_MIX_WORDS / 4];
+    for (size_t word = 0; word < POW_MIX_WORDS; word += 4)
+        cmix[word / 4] = powFNV (powFNV (powFNV (mix[word], mix[word + 1]), mix[word + 2]), mix[word + 3]);
+    memcpy (mixDigest, cmix, 32);
+
+    // result = keccak256 (s ++ cmix)
+    uint8_t final[POW_HASH_BYTES + 32];
+    memcpy (final, s.bytes, POW_HASH_BYTES);
+    memcpy (&final[POW_HASH_BYTES], cmix, 32);
+    BRKeccak256 (result, final, sizeof (final));
+}
+
+/// MARK: - Generate/Compute
 
 extern void
-proofOfWorkGenerate(BREthereumProofOfWork pow,
-                       BREthereumBlockHeader header) {
-    //
+proofOfWorkGenerate (BREthereumProofOfWork pow,
+                     BREthereumBlockHeader header) {
+    // No POW, no cache needed
+    if (uint256EQL (UINT256_ZERO, blockHeaderGetDifficulty (header))) return;
+
+    pthread_mutex_lock (&pow->lock);
+    powCachePrefetch (pow, powEpoch (blockHeaderGetNumber (header)));
+    pthread_mutex_unlock (&pow->lock);
 }
 
 extern void
 proofOfWorkCompute (BREthereumProofOfWork pow,
-                       BREthereumBlockHeader header,
-                       UInt256 *n,
-                       BREthereumHash *m) {
+                    BREthereumBlockHeader header,
+                    UInt256 *n,
+                    BREthereumHash *m) {
     assert (NULL != n && NULL != m);
 
-    // On and on and on
+    // A zero difficulty header carries no POW (a post-merge header); report 'no POW'
+    if (uint256EQL (UINT256_ZERO, blockHeaderGetDifficulty (header))) {
+        *n = UINT256_ZERO;
+        *m = EMPTY_HASH_INIT;
+        return;
+    }
+
+    uint64_t number = blockHeaderGetNumber (header);
+    uint64_t epoch  = powEpoch (number);
+
+    // The 'seal' hash: the header without its mixHash and nonce.
+    pthread_mutex_lock (&pow->lock);
+    BRRlpItem item = blockHeaderRlpEncode (header, ETHEREUM_BOOLEAN_FALSE, RLP_TYPE_NETWORK, pow->coder);
+    BREthereumHash headerHash = ethHashCreateFromData (rlpItemGetDataSharedDontRelease (pow->coder, item));
+    rlpItemRelease (pow->coder, item);
+    pthread_mutex_unlock (&pow->lock);
+
+    // Build or wait for the cache, then hash, with no lock held; the pin keeps the cache alive.
+    BREthereumProofOfWorkCache *cache = powCacheAcquire (pow, epoch);
+
+    uint8_t result[32];
+    powHashimotoLight (cache, powDatasetSize (epoch), headerHash.bytes,
+                       blockHeaderGetNonce (header), m->bytes, result);
+
+    powCacheUnpin (cache);
 
-    // TODO: Actually compute something.
+    // Getting close to the next epoch; have its cache ready before we get there.
+    if (number % POW_EPOCH >= POW_EPOCH - POW_CACHE_PREFETCH_BLOCKS) {
+        pthread_mutex_lock (&pow->lock);
+        powCachePrefetch (pow, epoch + 1);
+        pthread_mutex_unlock (&pow->lock);
+    }
 
-    // For now, return values that allow subsequent use to succeed
-    *n = UINT256_ZERO;
-    *m = blockHeaderGetMixHash (header);
+    // `result` is a big-endian number
+    for (size_t index = 0; index < 32; index++)
+        n->u8[index] = result[31 - index];
 }
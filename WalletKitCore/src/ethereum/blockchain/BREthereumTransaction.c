@@ -324,14 +324,13 @@ transactionExtractAddress(BREthereumTransaction transaction,
     int success = 1;
 
     BRRlpItem item = transactionRlpEncode (transaction, network, RLP_TYPE_TRANSACTION_UNSIGNED, coder);
-    BRRlpData data = rlpItemGetData(coder, item);
+    BRRlpData data = rlpItemGetDataSharedDontRelease(coder, item);
 
     BREthereumAddress address = ethSignatureExtractAddress(transaction->signature,
                                    data.bytes,
                                    data.bytesCount,
                                    &success);
     
-    rlpDataRelease(data);
     rlpItemRelease(coder, item);
     return address;
 }
@@ -401,10 +400,8 @@ transactionRlpEncode(BREthereumTransaction transaction,
     
     BRRlpItem result = rlpEncodeListItems(coder, items, itemsCount);
 
-    if (RLP_TYPE_TRANSACTION_SIGNED == type) {
-        BRRlpData data = rlpItemGetDataSharedDontRelease(coder, result);
-        transaction->hash = ethHashCreateFromData(data);
-    }
+    if (RLP_TYPE_TRANSACTION_SIGNED == type)
+        transaction->hash = ethHashCreateFromRlpItem (result, coder);
 
     return result;
 }
@@ -417,11 +414,19 @@ transactionRlpDecode (BRRlpItem item,
                       BREthereumNetwork network,
                       BREthereumRlpType type,
                       BRRlpCoder coder) {
+    return transactionRlpDecodeView (rlpItemGetView (coder, item), network, type, coder);
+}
+
+extern BREthereumTransaction
+transactionRlpDecodeView (BRRlpView view,
+                          BREthereumNetwork network,
+                          BREthereumRlpType type,
+                          BRRlpCoder coder) {
     
     BREthereumTransaction transaction = calloc (1, sizeof(struct BREthereumTransactionRecord));
     
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    BRRlpView items[12];
+    size_t itemsCount = rlpViewDecodeList (view, items, 12);
     assert (( 9 == itemsCount && (RLP_TYPE_TRANSACTION_SIGNED == type || RLP_TYPE_TRANSACTION_UNSIGNED == type)) ||
             (12 == itemsCount && RLP_TYPE_ARCHIVE == type));
     
@@ -433,17 +438,19 @@ transactionRlpDecode (BRRlpItem item,
     //    items[4] = amountRlpEncode(transaction->amount, coder);
     //    items[5] = transactionEncodeDataForHolding(transaction, transaction->amount, coder);
     
-    transaction->nonce = rlpDecodeUInt64(coder, items[0], 1);
-    transaction->gasPrice = ethGasPriceRlpDecode(items[1], coder);
-    transaction->gasLimit = ethGasRlpDecode(items[2], coder);
+    int failed = 0;
+    transaction->nonce = rlpViewDecodeUInt64(items[0], 1, &failed);
+    transaction->gasPrice = ethGasPriceCreate(ethEtherCreate(rlpViewDecodeUInt256(items[1], 1, &failed)));
+    transaction->gasLimit = ethGasCreate(rlpViewDecodeUInt64(items[2], 1, &failed));
     
-    transaction->targetAddress = ethAddressRlpDecode(items[3], coder);
-    transaction->amount = ethEtherRlpDecode(items[4], coder);
-    transaction->data = rlpDecodeHexString (coder, items[5], "0x");
+    transaction->targetAddress = ethAddressRlpDecodeView(items[3]);
+    transaction->amount = ethEtherCreate(rlpViewDecodeUInt256(items[4], 1, &failed));
+    transaction->data = rlpViewDecodeHexString (items[5], "0x");
     
     transaction->chainId = ethNetworkGetChainId(network);
     
-    uint64_t eipChainId = rlpDecodeUInt64(coder, items[6], 1);
+    uint64_t eipChainId = rlpViewDecodeUInt64(items[6], 1, &failed);
+    assert (!failed);
     
     // By default, ensure `transacdtionIsSigned()` returns FALSE.
     ethSignatureClear (&transaction->signature, SIGNATURE_TYPE_RECOVERABLE_VRS_EIP);
@@ -459,12 +466,12 @@ transactionRlpDecode (BRRlpItem item,
                                             ? eipChainId - 8 - 2 * transaction->chainId
                                             : eipChainId);
         
-        BRRlpData rData = rlpDecodeBytesSharedDontRelease (coder, items[7]);
+        BRRlpData rData = rlpViewDecodeBytes (items[7]);
         assert (32 >= rData.bytesCount);
         memcpy (&transaction->signature.sig.vrs.r[32 - rData.bytesCount],
                 rData.bytes, rData.bytesCount);
         
-        BRRlpData sData = rlpDecodeBytesSharedDontRelease (coder, items[8]);
+        BRRlpData sData = rlpViewDecodeBytes (items[8]);
         assert (32 >= sData.bytesCount);
         memcpy (&transaction->signature.sig.vrs.s[32 - sData.bytesCount],
                 sData.bytes, sData.bytesCount);
@@ -472,17 +479,20 @@ transactionRlpDecode (BRRlpItem item,
     }
     
     switch (type) {
-        case RLP_TYPE_ARCHIVE:
+        case RLP_TYPE_ARCHIVE: {
             // Extract the archive-specific data
-            transaction->sourceAddress = ethAddressRlpDecode(items[9], coder);
-            transaction->hash = ethHashRlpDecode(items[10], coder);
-            transaction->status = transactionStatusRLPDecode(items[11], NULL, coder);
+            transaction->sourceAddress = ethAddressRlpDecodeView(items[9]);
+            transaction->hash = ethHashRlpDecodeView(items[10]);
+
+            BRRlpItem statusItem = rlpViewGetItem (coder, items[11]);
+            transaction->status = transactionStatusRLPDecode(statusItem, NULL, coder);
+            rlpItemRelease (coder, statusItem);
             break;
+        }
 
         case RLP_TYPE_TRANSACTION_SIGNED: {
             // With a SIGNED RLP encoding, we can extract the source address and compute the hash.
-            BRRlpData result = rlpItemGetDataSharedDontRelease(coder, item);
-            transaction->hash = ethHashCreateFromData(result);
+            transaction->hash = ethHashCreateFromRlpView (view);
 
             // :fingers-crossed:
             transaction->sourceAddress = transactionExtractAddress (transaction, network, coder);
@@ -502,7 +512,7 @@ extern BRRlpData
 transactionGetRlpData (BREthereumTransaction transaction,
                        BREthereumNetwork network,
                        BREthereumRlpType type) {
-    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
     BRRlpItem item   = transactionRlpEncode (transaction, network, type, coder);
     BRRlpData data   = rlpItemGetData (coder, item);
 
@@ -519,7 +529,7 @@ transactionGetRlpHexEncoded (BREthereumTransaction transaction,
                              const char *prefix) {
     if (NULL == prefix) prefix = "";
 
-    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
     BRRlpItem item = transactionRlpEncode (transaction, network, type, coder);
     BRRlpData data = rlpItemGetDataSharedDontRelease(coder, item);
 
@@ -169,6 +169,16 @@ transactionRlpDecode (BRRlpItem item,
                       BREthereumRlpType type,
                       BRRlpCoder coder);
 
+/**
+ * Decode a transaction directly from the RLP encoding referenced by `view`.  The `coder` is only
+ * needed to recover the source address of a signed transaction (and for an archived status).
+ */
+extern BREthereumTransaction
+transactionRlpDecodeView (BRRlpView view,
+                          BREthereumNetwork network,
+                          BREthereumRlpType type,
+                          BRRlpCoder coder);
+
 /**
  * RLP encode transaction for the provided network with the specified type.  Different networks
  * have different RLP encodings - notably the network's chainId is part of the encoding.
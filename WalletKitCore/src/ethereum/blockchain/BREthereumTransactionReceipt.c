@@ -104,16 +104,15 @@ transactionReceiptLogsRlpEncode (BREthereumTransactionReceipt log,
 }
 
 static BREthereumLog *
-transactionReceiptLogsRlpDecode (BRRlpItem item,
-                                 BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
-
+transactionReceiptLogsRlpDecodeView (BRRlpView view) {
     BREthereumLog *logs;
-    array_new(logs, itemsCount);
+    array_new(logs, rlpViewGetListCount (view));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
 
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumLog log = logRlpDecode(items[i], RLP_TYPE_NETWORK, coder);
+    while (rlpViewCursorNext (&cursor, &item)) {
+        BREthereumLog log = logRlpDecodeView(item, RLP_TYPE_NETWORK, NULL);
         array_add(logs, log);
     }
 
@@ -126,17 +125,24 @@ transactionReceiptLogsRlpDecode (BRRlpItem item,
 extern BREthereumTransactionReceipt
 transactionReceiptRlpDecode (BRRlpItem item,
                              BRRlpCoder coder) {
+    return transactionReceiptRlpDecodeView (rlpItemGetView (coder, item));
+}
+
+extern BREthereumTransactionReceipt
+transactionReceiptRlpDecodeView (BRRlpView view) {
     BREthereumTransactionReceipt receipt = calloc (1, sizeof(struct BREthereumTransactionReceiptRecord));
     memset (receipt, 0, sizeof(struct BREthereumTransactionReceiptRecord));
     
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
+    BRRlpView items[4];
+    size_t itemsCount = rlpViewDecodeList (view, items, 4);
     assert (4 == itemsCount);
     
-    receipt->stateRoot = rlpDecodeBytes(coder, items[0]);
-    receipt->gasUsed = rlpDecodeUInt64(coder, items[1], 0);
-    receipt->bloomFilter = bloomFilterRlpDecode(items[2], coder);
-    receipt->logs = transactionReceiptLogsRlpDecode(items[3], coder);
+    receipt->stateRoot = rlpDataCopy (rlpViewDecodeBytes(items[0]));
+    int failed = 0;
+    receipt->gasUsed = rlpViewDecodeUInt64(items[1], 0, &failed);
+    assert (!failed);
+    receipt->bloomFilter = bloomFilterRlpDecodeView(items[2]);
+    receipt->logs = transactionReceiptLogsRlpDecodeView(items[3]);
     
     return receipt;
 }
@@ -160,13 +166,19 @@ transactionReceiptRlpEncode(BREthereumTransactionReceipt receipt,
 extern BRArrayOf (BREthereumTransactionReceipt)
 transactionReceiptDecodeList (BRRlpItem item,
                               BRRlpCoder coder) {
-    size_t itemCount;
-    const BRRlpItem *items = rlpDecodeList (coder, item, &itemCount);
+    return transactionReceiptDecodeListView (rlpItemGetView (coder, item));
+}
 
+extern BRArrayOf (BREthereumTransactionReceipt)
+transactionReceiptDecodeListView (BRRlpView view) {
     BRArrayOf (BREthereumTransactionReceipt) receipts;
-    array_new (receipts, itemCount);
-    for (size_t index = 0; index < itemCount; index++)
-        array_add (receipts, transactionReceiptRlpDecode (items[index], coder));
+    array_new (receipts, rlpViewGetListCount (view));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+
+    while (rlpViewCursorNext (&cursor, &item))
+        array_add (receipts, transactionReceiptRlpDecodeView (item));
     return receipts;
 }
 
@@ -53,6 +53,9 @@ transactionReceiptMatchAddress (BREthereumTransactionReceipt receipt,
 extern BREthereumTransactionReceipt
 transactionReceiptRlpDecode (BRRlpItem item,
                              BRRlpCoder coder);
+
+extern BREthereumTransactionReceipt
+transactionReceiptRlpDecodeView (BRRlpView view);
     
 extern BRRlpItem
 transactionReceiptRlpEncode(BREthereumTransactionReceipt receipt,
@@ -62,6 +65,9 @@ extern BRArrayOf (BREthereumTransactionReceipt)
 transactionReceiptDecodeList (BRRlpItem item,
                               BRRlpCoder coder);
 
+extern BRArrayOf (BREthereumTransactionReceipt)
+transactionReceiptDecodeListView (BRRlpView view);
+
 extern void
 transactionReceiptRelease (BREthereumTransactionReceipt receipt);
 
@@ -12,6 +12,7 @@
 #define BR_Ethereum_Client_H
 
 #include <stdbool.h>
+#include "ethereum/blockchain/BREthereumLog.h"
 #include "BREthereumBase.h"
 #include "BRCryptoSync.h"
 
@@ -182,6 +183,43 @@ extern "C" {
                                     int id,
                                     BREthereumBoolean success);
 
+    /**
+     * A transaction, as announced by `ewmAnnounceTransaction()`, with its fields decoded.  The
+     * `data` is as provided to `ewmAnnounceTransaction()`.
+     */
+    typedef struct {
+        BREthereumHash hash;
+        BREthereumAddress from;
+        BREthereumAddress to;
+        BREthereumAddress contract;
+        UInt256 amount;
+        uint64_t gasLimit;
+        UInt256 gasPrice;
+        char *data;
+        uint64_t nonce;
+        uint64_t gasUsed;
+        uint64_t blockNumber;
+        BREthereumHash blockHash;
+        uint64_t blockConfirmations;
+        uint64_t blockTransactionIndex;
+        uint64_t blockTimestamp;
+        BREthereumBoolean isError;
+    } BREthereumEWMClientAnnounceTransactionBundle;
+
+    /**
+     * Announce `bundlesCount` transactions at once, such as a page of results from the BRD
+     * endpoint.  This is equivalent to an `ewmAnnounceTransaction()` for each bundle except that
+     * the transactions are handled in one EWM event, their changes are saved in one
+     * persistence batch and each affected wallet's balance is updated, and announced, once.
+     *
+     * The `bundles`, including their `data`, are copied.
+     */
+    extern BREthereumStatus
+    ewmAnnounceTransactions (BREthereumEWM ewm,
+                             int id,
+                             OwnershipKept const BREthereumEWMClientAnnounceTransactionBundle *bundles,
+                             size_t bundlesCount);
+
     /// MARK: - Get Logs
 
     typedef void
@@ -214,6 +252,37 @@ extern "C" {
                             int id,
                             BREthereumBoolean success);
 
+    /// An Ethereum log has at most four topics (LOG0 through LOG4)
+    #define EWM_CLIENT_ANNOUNCE_LOG_TOPICS_LIMIT        (4)
+
+    /**
+     * A log, as announced by `ewmAnnounceLog()`, with its fields decoded.  The `data` is the
+     * log's data as a number; for an ERC20 transfer, the amount.
+     */
+    typedef struct {
+        BREthereumHash hash;
+        BREthereumAddress contract;
+        int topicCount;
+        BREthereumLogTopic topics[EWM_CLIENT_ANNOUNCE_LOG_TOPICS_LIMIT];
+        UInt256 data;
+        UInt256 gasPrice;
+        uint64_t gasUsed;
+        uint64_t logIndex;
+        uint64_t blockNumber;
+        uint64_t blockTransactionIndex;
+        uint64_t blockTimestamp;
+    } BREthereumEWMClientAnnounceLogBundle;
+
+    /**
+     * Announce `bundlesCount` logs at once.  See `ewmAnnounceTransactions()`.  The `bundles` are
+     * copied.
+     */
+    extern BREthereumStatus
+    ewmAnnounceLogs (BREthereumEWM ewm,
+                     int id,
+                     OwnershipKept const BREthereumEWMClientAnnounceLogBundle *bundles,
+                     size_t bundlesCount);
+
     /// MARK: - Get Tokens
 
     typedef void
@@ -241,6 +241,7 @@ ewmCreate (BREthereumNetwork network,
            BREthereumAccount account,
            BREthereumTimestamp accountTimestamp,
            BRCryptoSyncMode mode,
+           BREthereumLES les,
            BREthereumClient client,
            const char *storagePath,
            uint64_t blockHeight,
@@ -253,6 +254,7 @@ ewmCreate (BREthereumNetwork network,
     ewm->account = account;
     ewm->accountTimestamp = accountTimestamp;
     ewm->bcs = NULL;
+    ewm->les = (NULL == les ? NULL : lesTake (les));
     ewm->blockHeight = blockHeight;
     ewm->confirmationsUntilFinal = confirmationsUntilFinal;
     ewm->requestId = 0;
@@ -296,6 +298,7 @@ ewmCreate (BREthereumNetwork network,
                                                       ewmFileServiceSpecificationsCount,
                                                       ewmFileServiceSpecifications);
     if (NULL == ewm->fs) return ewmCreateErrorHandler(ewm, 1, "create");
+    ewm->storagePath = strdup (storagePath);
 
     // Load all the persistent entities
     BRSetOf(BREthereumTransaction) transactions;
@@ -386,10 +389,12 @@ ewmCreate (BREthereumNetwork network,
                                   ethAccountGetPrimaryAddress (account),
                                   listener,
                                   mode,
+                                  NULL,
                                   nodes,
                                   NULL,
                                   NULL,
-                                  NULL);
+                                  NULL,
+                                  ewm->storagePath);
 
             // Announce all the provided transactions...
             FOR_SET (BREthereumTransaction, transaction, transactions)
@@ -484,10 +489,12 @@ ewmCreate (BREthereumNetwork network,
                                   ethAccountGetPrimaryAddress (account),
                                   listener,
                                   mode,
+                                  ewm->les,
                                   nodes,
                                   blocks,
                                   transactions,
-                                  logs);
+                                  logs,
+                                  ewm->storagePath);
             break;
         }
     }
@@ -512,6 +519,7 @@ ewmCreateWithPaperKey (BREthereumNetwork network,
                       ethAccountCreate (paperKey),
                       accountTimestamp,
                       mode,
+                      NULL,
                       client,
                       storagePath,
                       blockHeight,
@@ -531,6 +539,7 @@ ewmCreateWithPublicKey (BREthereumNetwork network,
                       ethAccountCreateWithPublicKey(publicKey),
                       accountTimestamp,
                       mode,
+                      NULL,
                       client,
                       storagePath,
                       blockHeight,
@@ -549,6 +558,7 @@ ewmDestroy (BREthereumEWM ewm) {
     //
 
     bcsDestroy(ewm->bcs);
+    if (NULL != ewm->les) lesRelease (ewm->les);
 
     walletsRelease (ewm->wallets);
     ewm->wallets = NULL;
@@ -557,6 +567,7 @@ ewmDestroy (BREthereumEWM ewm) {
     ewm->tokens = NULL;
 
     fileServiceRelease (ewm->fs);
+    free (ewm->storagePath);
     eventHandlerDestroy(ewm->handler);
     rlpCoderRelease(ewm->coder);
 
@@ -999,6 +1010,14 @@ ewmGetMode (BREthereumEWM ewm) {
     return mode;
 }
 
+extern BREthereumLES
+ewmGetLES (BREthereumEWM ewm) {
+    pthread_mutex_lock (&ewm->lock);
+    BREthereumLES les = bcsGetLES (ewm->bcs);
+    pthread_mutex_unlock (&ewm->lock);
+    return les;
+}
+
 extern void
 ewmUpdateMode (BREthereumEWM ewm,
                BRCryptoSyncMode mode) {
@@ -1068,7 +1087,9 @@ ewmUpdateMode (BREthereumEWM ewm,
                                       NULL,
                                       NULL,
                                       NULL,
-                                      NULL);
+                                      NULL,
+                                      NULL,
+                                      ewm->storagePath);
                 break;
 
             case CRYPTO_SYNC_MODE_P2P_WITH_API_SYNC:
@@ -1080,10 +1101,12 @@ ewmUpdateMode (BREthereumEWM ewm,
                                       primaryAddress,
                                       listener,
                                       newMode,
+                                      ewm->les,
                                       nodes,
                                       blocks,
                                       transactions,
-                                      logs);
+                                      logs,
+                                      ewm->storagePath);
 
                 BRSetFreeAll (states, (void (*) (void*)) walletStateRelease);
                 break;
@@ -1870,10 +1893,13 @@ ewmHandleLogFeeBasis (BREthereumEWM ewm,
         }
 }
 
-extern void
-ewmHandleTransaction (BREthereumEWM ewm,
-                      BREthereumBCSCallbackTransactionType type,
-                      OwnershipGiven BREthereumTransaction transaction) {
+/**
+ * Handle `transaction` but without updating the wallet's balance.  Returns the wallet.
+ */
+static BREthereumWallet
+ewmHandleTransactionWithoutBalance (BREthereumEWM ewm,
+                                    BREthereumBCSCallbackTransactionType type,
+                                    OwnershipGiven BREthereumTransaction transaction) {
     BREthereumHash hash = transactionGetHash(transaction);
 
     // Find the wallet
@@ -1926,7 +1952,7 @@ ewmHandleTransaction (BREthereumEWM ewm,
                                                                     transactionGetHash(transaction))))
             transactionSetStatus (original, transactionGetStatus(transaction));
 
-        transferSetBasisForTransaction (transfer, transaction); // transaction ownership given
+        walletSetTransferBasisForTransaction (wallet, transfer, transaction); // transaction ownership given
     }
 
     if (needStatusEvent) {
@@ -1939,21 +1965,90 @@ ewmHandleTransaction (BREthereumEWM ewm,
         ewmReportTransferStatusAsEvent(ewm, wallet, transfer);
     }
 
-    // We've added a transfer and should update the wallet's balance.  Ethereum is 'account based';
-    // but in API modes we don't have the account information - so we'll update the balance
-    // explicitly.  In P2P mode, we get the 'account'.
-    //
-    if (CRYPTO_SYNC_MODE_API_ONLY          == ewm->mode ||
-        CRYPTO_SYNC_MODE_API_WITH_P2P_SEND == ewm->mode)
-        walletUpdateBalance(wallet);
-
     ewmHandleTransactionOriginatingLog (ewm, type, transaction);
+    return wallet;
+}
+
+/**
+ * Check if the wallets' balances are computed from their transfers.  Ethereum is 'account based';
+ * but in API modes we don't have the account information - so we'll update the balance
+ * explicitly.  In P2P mode, we get the 'account'.
+ */
+static int
+ewmNeedWalletBalanceFromTransfers (BREthereumEWM ewm) {
+    return (CRYPTO_SYNC_MODE_API_ONLY          == ewm->mode ||
+            CRYPTO_SYNC_MODE_API_WITH_P2P_SEND == ewm->mode);
+}
+
+/**
+ * Update the balance of each of `wallets` from its transfers, once, and announce those balances
+ * that changed.
+ */
+static void
+ewmUpdateWalletBalancesFromTransfers (BREthereumEWM ewm,
+                                      BRArrayOf(BREthereumWallet) wallets) {
+    for (size_t index = 0; index < array_count (wallets); index++) {
+        BREthereumWallet wallet  = wallets[index];
+        BREthereumAmount balance = walletGetBalance (wallet);
+
+        walletUpdateBalance (wallet);
+
+        int amountTypeMismatch;
+        if (ETHEREUM_COMPARISON_EQ != ethAmountCompare (balance, walletGetBalance (wallet), &amountTypeMismatch))
+            ewmSignalWalletEvent (ewm,
+                                  wallet,
+                                  (BREthereumWalletEvent) {
+                                      WALLET_EVENT_BALANCE_UPDATED,
+                                      SUCCESS
+                                  });
+    }
+}
+
+static void
+ewmAddWalletOnce (BRArrayOf(BREthereumWallet) wallets,
+                  BREthereumWallet wallet) {
+    for (size_t index = 0; index < array_count (wallets); index++)
+        if (wallet == wallets[index]) return;
+    array_add (wallets, wallet);
 }
 
 extern void
-ewmHandleLog (BREthereumEWM ewm,
-              BREthereumBCSCallbackLogType type,
-              OwnershipGiven BREthereumLog log) {
+ewmHandleTransaction (BREthereumEWM ewm,
+                      BREthereumBCSCallbackTransactionType type,
+                      OwnershipGiven BREthereumTransaction transaction) {
+    BREthereumWallet wallet = ewmHandleTransactionWithoutBalance (ewm, type, transaction);
+
+    // We've added a transfer and should update the wallet's balance.
+    if (ewmNeedWalletBalanceFromTransfers (ewm))
+        walletUpdateBalance(wallet);
+}
+
+extern void
+ewmHandleTransactions (BREthereumEWM ewm,
+                       BREthereumBCSCallbackTransactionType type,
+                       OwnershipGiven BRArrayOf(BREthereumTransaction) transactions) {
+    BRArrayOf(BREthereumWallet) wallets;
+    array_new (wallets, 1);
+
+    for (size_t index = 0; index < array_count (transactions); index++)
+        ewmAddWalletOnce (wallets, ewmHandleTransactionWithoutBalance (ewm, type, transactions[index]));
+    array_free (transactions);
+
+    // Computing a balance iterates over all of a wallet's transfers; do it once, not per transfer
+    if (ewmNeedWalletBalanceFromTransfers (ewm))
+        ewmUpdateWalletBalancesFromTransfers (ewm, wallets);
+
+    array_free (wallets);
+}
+
+/**
+ * Handle `log` but without updating the wallet's balance.  Returns the wallet, or NULL if `log`
+ * is not an ERC20 transfer of a known token.
+ */
+static BREthereumWallet
+ewmHandleLogWithoutBalance (BREthereumEWM ewm,
+                            BREthereumBCSCallbackLogType type,
+                            OwnershipGiven BREthereumLog log) {
     BREthereumHash logHash = logGetHash(log);
 
     BREthereumHash transactionHash;
@@ -1964,10 +2059,10 @@ ewmHandleLog (BREthereumEWM ewm,
     assert (ETHEREUM_BOOLEAN_IS_TRUE (extractedIdentifier));
     
     BREthereumToken token = ewmLookupToken (ewm, logGetAddress(log));
-    if (NULL == token) { logRelease(log); return;}
+    if (NULL == token) { logRelease(log); return NULL; }
 
     // TODO: Confirm LogTopic[0] is 'transfer'
-    if (3 != logGetTopicsCount(log)) { logRelease(log); return; }
+    if (3 != logGetTopicsCount(log)) { logRelease(log); return NULL; }
 
     BREthereumWallet wallet = ewmGetWalletHoldingToken (ewm, token);
     assert (NULL != wallet);
@@ -2003,7 +2098,7 @@ ewmHandleLog (BREthereumEWM ewm,
                                                                   logGetStatus (log));
 
         // Log becomes the new basis for transfer
-        transferSetBasisForLog (transfer, log);  // log ownership given
+        walletSetTransferBasisForLog (wallet, transfer, log);  // log ownership given
     }
 
     if (needStatusEvent) {
@@ -2021,15 +2116,48 @@ ewmHandleLog (BREthereumEWM ewm,
         ewmReportTransferStatusAsEvent (ewm, wallet, transfer);
     }
 
-    // We've added a transfer and should update the wallet's balance.  Ethereum is 'account based';
-    // but in API modes we don't have the account information - so we'll update the balance
-    // explicitly.  In P2P mode, we get the 'account'.
-    //
-    if (CRYPTO_SYNC_MODE_API_ONLY          == ewm->mode ||
-        CRYPTO_SYNC_MODE_API_WITH_P2P_SEND == ewm->mode)
+    return wallet;
+}
+
+extern void
+ewmHandleLog (BREthereumEWM ewm,
+              BREthereumBCSCallbackLogType type,
+              OwnershipGiven BREthereumLog log) {
+    BREthereumWallet wallet = ewmHandleLogWithoutBalance (ewm, type, log);
+
+    // We've added a transfer and should update the wallet's balance.
+    if (NULL != wallet && ewmNeedWalletBalanceFromTransfers (ewm))
         walletUpdateBalance(wallet);
 }
 
+extern void
+ewmHandleLogs (BREthereumEWM ewm,
+               BREthereumBCSCallbackLogType type,
+               OwnershipGiven BRArrayOf(BREthereumLog) logs) {
+    BRArrayOf(BREthereumWallet) wallets;
+    array_new (wallets, 1);
+
+    for (size_t index = 0; index < array_count (logs); index++) {
+        BREthereumWallet wallet = ewmHandleLogWithoutBalance (ewm, type, logs[index]);
+        if (NULL != wallet) ewmAddWalletOnce (wallets, wallet);
+    }
+    array_free (logs);
+
+    if (ewmNeedWalletBalanceFromTransfers (ewm))
+        ewmUpdateWalletBalancesFromTransfers (ewm, wallets);
+
+    array_free (wallets);
+}
+
+extern void
+ewmHandleSaveBatch (BREthereumEWM ewm,
+                    BREthereumBoolean begin) {
+    if (ETHEREUM_BOOLEAN_IS_TRUE (begin))
+        fileServiceBeginBatch (ewm->fs);
+    else
+        fileServiceEndBatch (ewm->fs);
+}
+
 extern void
 ewmHandleSaveBlocks (BREthereumEWM ewm,
                      OwnershipGiven BRArrayOf(BREthereumBlock) blocks) {
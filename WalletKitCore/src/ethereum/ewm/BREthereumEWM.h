@@ -13,6 +13,7 @@
 
 #include "ethereum/blockchain/BREthereumNetwork.h"
 #include "ethereum/contract/BREthereumContract.h"
+#include "ethereum/les/BREthereumLES.h"
 #include "BREthereumBase.h"
 #include "BREthereumAmount.h"
 #include "BREthereumClient.h"
@@ -23,11 +24,17 @@ extern "C" {
 
 /// MARK: - Ethereum Wallet Manager
 
+/**
+ * Create an EWM.  If `les` is not NULL, then in a mode that handles sync (P2P_ONLY or
+ * P2P_WITH_API_SYNC) EWM shares `les`, as one pool of nodes, with other EWMs on `network`.  See
+ * ewmGetLES().
+ */
 extern BREthereumEWM
 ewmCreate (BREthereumNetwork network,
            BREthereumAccount account,
            BREthereumTimestamp accountTimestamp,
            BRCryptoSyncMode mode,
+           BREthereumLES les,
            BREthereumClient client,
            const char *storagePath,
            uint64_t blockHeight,
@@ -128,6 +135,13 @@ extern void
 ewmUpdateMode (BREthereumEWM ewm,
                BRCryptoSyncMode mode);
 
+/**
+ * Return the LES of `ewm`, for sharing with another EWM on the same network, or NULL if the
+ * current mode does not handle sync.  The LES is not taken.
+ */
+extern BREthereumLES
+ewmGetLES (BREthereumEWM ewm);
+
 extern uint64_t
 ewmGetBlockHeight (BREthereumEWM ewm);
 
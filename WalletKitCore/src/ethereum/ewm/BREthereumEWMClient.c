@@ -376,6 +376,39 @@ ewmHandleAnnounceNonce (BREthereumEWM ewm,
 // Get Transactions
 //
 
+static BREthereumTransaction
+ewmClientAnnounceTransactionBundleCreateTransaction (const BREthereumEWMClientAnnounceTransactionBundle *bundle) {
+    //
+    // This 'announce' call is coming from the guaranteed BRD endpoint; thus we don't need to
+    // worry about the validity of the transaction - it is surely confirmed.  Is that true
+    // if newly submitted?
+
+    // TODO: Confirm we are not repeatedly creating transactions
+    BREthereumTransaction transaction = transactionCreate (bundle->from,
+                                                           bundle->to,
+                                                           ethEtherCreate(bundle->amount),
+                                                           ethGasPriceCreate(ethEtherCreate(bundle->gasPrice)),
+                                                           ethGasCreate(bundle->gasLimit),
+                                                           bundle->data,
+                                                           bundle->nonce);
+
+    // We set the transaction's hash based on the value providedin the bundle.  However,
+    // and importantly, if we attempted to compute the hash - as we normally do for a
+    // signed transaction - the computed hash would be utterly wrong.  The transaction
+    // just created does not have: network nor signature.
+    //
+    // TODO: Confirm that BRPersistData does not overwrite the transaction's hash
+    transactionSetHash (transaction, bundle->hash);
+
+    BREthereumTransactionStatus status = transactionStatusCreateIncluded (bundle->blockHash,
+                                                                          bundle->blockNumber,
+                                                                          bundle->blockTransactionIndex,
+                                                                          bundle->blockTimestamp,
+                                                                          ethGasCreate(bundle->gasUsed));
+    transactionSetStatus (transaction, status);
+
+    return transaction;
+}
 
 extern void
 ewmHandleAnnounceTransaction (BREthereumEWM ewm,
@@ -384,34 +417,7 @@ ewmHandleAnnounceTransaction (BREthereumEWM ewm,
     switch (ewm->mode) {
         case CRYPTO_SYNC_MODE_API_ONLY:
         case CRYPTO_SYNC_MODE_API_WITH_P2P_SEND: {
-            //
-            // This 'announce' call is coming from the guaranteed BRD endpoint; thus we don't need to
-            // worry about the validity of the transaction - it is surely confirmed.  Is that true
-            // if newly submitted?
-
-            // TODO: Confirm we are not repeatedly creating transactions
-            BREthereumTransaction transaction = transactionCreate (bundle->from,
-                                                                   bundle->to,
-                                                                   ethEtherCreate(bundle->amount),
-                                                                   ethGasPriceCreate(ethEtherCreate(bundle->gasPrice)),
-                                                                   ethGasCreate(bundle->gasLimit),
-                                                                   bundle->data,
-                                                                   bundle->nonce);
-
-            // We set the transaction's hash based on the value providedin the bundle.  However,
-            // and importantly, if we attempted to compute the hash - as we normally do for a
-            // signed transaction - the computed hash would be utterly wrong.  The transaction
-            // just created does not have: network nor signature.
-            //
-            // TODO: Confirm that BRPersistData does not overwrite the transaction's hash
-            transactionSetHash (transaction, bundle->hash);
-
-            BREthereumTransactionStatus status = transactionStatusCreateIncluded (bundle->blockHash,
-                                                                                  bundle->blockNumber,
-                                                                                  bundle->blockTransactionIndex,
-                                                                                  bundle->blockTimestamp,
-                                                                                  ethGasCreate(bundle->gasUsed));
-            transactionSetStatus (transaction, status);
+            BREthereumTransaction transaction = ewmClientAnnounceTransactionBundleCreateTransaction (bundle);
 
             // If we had a `bcs` we might think about `bcsSignalTransaction(ewm->bcs, transaction);`
             ewmSignalTransaction(ewm, BCS_CALLBACK_TRANSACTION_UPDATED, transaction);
@@ -480,6 +486,56 @@ ewmAnnounceTransaction(BREthereumEWM ewm,
     return SUCCESS;
 }
 
+extern void
+ewmHandleAnnounceTransactions (BREthereumEWM ewm,
+                               BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles,
+                               int id) {
+    size_t count = array_count (bundles);
+
+    switch (ewm->mode) {
+        case CRYPTO_SYNC_MODE_API_ONLY:
+        case CRYPTO_SYNC_MODE_API_WITH_P2P_SEND: {
+            BRArrayOf(BREthereumTransaction) transactions;
+            array_new (transactions, count);
+            for (size_t index = 0; index < count; index++)
+                array_add (transactions, ewmClientAnnounceTransactionBundleCreateTransaction (&bundles[index]));
+
+            // Handle all the transactions now, rather than signalling each.  The transfer and
+            // wallet events that result are signalled between the save batch's begin and end.
+            ewmSignalSaveBatch (ewm, ETHEREUM_BOOLEAN_TRUE);
+            ewmHandleTransactions (ewm, BCS_CALLBACK_TRANSACTION_UPDATED, transactions);
+            ewmSignalSaveBatch (ewm, ETHEREUM_BOOLEAN_FALSE);
+            break;
+        }
+
+        case CRYPTO_SYNC_MODE_P2P_WITH_API_SYNC:
+        case CRYPTO_SYNC_MODE_P2P_ONLY:
+            for (size_t index = 0; index < count; index++)
+                bcsSendTransactionRequest(ewm->bcs,
+                                          bundles[index].hash,
+                                          bundles[index].blockNumber,
+                                          bundles[index].blockTransactionIndex);
+            break;
+    }
+    ewmClientAnnounceTransactionBundlesRelease (bundles);
+}
+
+extern BREthereumStatus
+ewmAnnounceTransactions (BREthereumEWM ewm,
+                         int id,
+                         OwnershipKept const BREthereumEWMClientAnnounceTransactionBundle *bundles,
+                         size_t bundlesCount) {
+    BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) copies;
+    array_new (copies, bundlesCount);
+    array_add_array (copies, bundles, bundlesCount);
+
+    for (size_t index = 0; index < bundlesCount; index++)
+        copies[index].data = strdup (NULL == bundles[index].data ? "" : bundles[index].data);
+
+    ewmSignalAnnounceTransactions (ewm, copies, id);
+    return SUCCESS;
+}
+
 extern void
 ewmAnnounceTransactionComplete (BREthereumEWM ewm,
                                 int id,
@@ -491,6 +547,40 @@ ewmAnnounceTransactionComplete (BREthereumEWM ewm,
 //
 // Get Logs
 //
+static BREthereumLog
+ewmClientAnnounceLogBundleCreateLog (BREthereumEWM ewm,
+                                     const BREthereumEWMClientAnnounceLogBundle *bundle) {
+    // This 'announce' call is coming from the guaranteed BRD endpoint; thus we don't need to
+    // worry about the validity of the transaction - it is surely confirmed.
+
+    // In general, log->data is arbitrary data.  In the case of an ERC20 token, log->data
+    // is a numeric value - for the transfer amount.  When parsing in logRlpDecode(),
+    // log->data is assigned with rlpDecodeBytes(coder, items[2]); we'll need the same
+    // thing, somehow
+
+    BRRlpItem  item  = rlpEncodeUInt256 (ewm->coder, bundle->data, 1);
+
+    BREthereumLog log = logCreate(bundle->contract,
+                                  bundle->topicCount,
+                                  (BREthereumLogTopic *) bundle->topics,
+                                  rlpItemGetDataSharedDontRelease(ewm->coder, item));
+    rlpItemRelease (ewm->coder, item);
+
+    // Given {hash,logIndex}, initialize the log's identifier
+    assert (bundle->logIndex <= (uint64_t) SIZE_MAX);
+    logInitializeIdentifier(log, bundle->hash, (size_t) bundle->logIndex);
+
+    BREthereumTransactionStatus status =
+    transactionStatusCreateIncluded (ethHashCreateEmpty(),
+                                     bundle->blockNumber,
+                                     bundle->blockTransactionIndex,
+                                     bundle->blockTimestamp,
+                                     ethGasCreate(bundle->gasUsed));
+    logSetStatus(log, status);
+
+    return log;
+}
+
 extern void
 ewmHandleAnnounceLog (BREthereumEWM ewm,
                       BREthereumEWMClientAnnounceLogBundle *bundle,
@@ -498,41 +588,7 @@ ewmHandleAnnounceLog (BREthereumEWM ewm,
     switch (ewm->mode) {
         case CRYPTO_SYNC_MODE_API_ONLY:
         case CRYPTO_SYNC_MODE_API_WITH_P2P_SEND: {
-            // This 'announce' call is coming from the guaranteed BRD endpoint; thus we don't need to
-            // worry about the validity of the transaction - it is surely confirmed.
-
-            BREthereumLogTopic topics [bundle->topicCount];
-            for (size_t index = 0; index < bundle->topicCount; index++)
-                topics[index] = logTopicCreateFromString(bundle->arrayTopics[index]);
-
-            // In general, log->data is arbitrary data.  In the case of an ERC20 token, log->data
-            // is a numeric value - for the transfer amount.  When parsing in logRlpDecode(),
-            // log->data is assigned with rlpDecodeBytes(coder, items[2]); we'll need the same
-            // thing, somehow
-
-            BRCoreParseStatus parseStatus = CORE_PARSE_OK;
-            UInt256 value = uint256CreateParse(bundle->data, 0, &parseStatus);
-            assert (CORE_PARSE_OK == parseStatus);
-
-            BRRlpItem  item  = rlpEncodeUInt256 (ewm->coder, value, 1);
-
-            BREthereumLog log = logCreate(bundle->contract,
-                                          bundle->topicCount,
-                                          topics,
-                                          rlpItemGetDataSharedDontRelease(ewm->coder, item));
-            rlpItemRelease (ewm->coder, item);
-
-            // Given {hash,logIndex}, initialize the log's identifier
-            assert (bundle->logIndex <= (uint64_t) SIZE_MAX);
-            logInitializeIdentifier(log, bundle->hash, (size_t) bundle->logIndex);
-
-            BREthereumTransactionStatus status =
-            transactionStatusCreateIncluded (ethHashCreateEmpty(),
-                                             bundle->blockNumber,
-                                             bundle->blockTransactionIndex,
-                                             bundle->blockTimestamp,
-                                             ethGasCreate(bundle->gasUsed));
-            logSetStatus(log, status);
+            BREthereumLog log = ewmClientAnnounceLogBundleCreateLog (ewm, bundle);
 
             // If we had a `bcs` we might think about `bcsSignalLog(ewm->bcs, log);`
             ewmSignalLog(ewm, BCS_CALLBACK_LOG_UPDATED, log);
@@ -578,15 +634,20 @@ ewmAnnounceLog (BREthereumEWM ewm,
                 uint64_t blockTransactionIndex,
                 uint64_t blockTimestamp) {
 
+    if (topicsCount > EWM_CLIENT_ANNOUNCE_LOG_TOPICS_LIMIT) return ERROR_FAILED;
+
+    BRCoreParseStatus parseStatus = CORE_PARSE_OK;
+    UInt256 data = uint256CreateParse (strData, 0, &parseStatus);
+    if (CORE_PARSE_OK != parseStatus) return ERROR_NUMERIC_PARSE;
+
     BREthereumEWMClientAnnounceLogBundle *bundle = malloc(sizeof (BREthereumEWMClientAnnounceLogBundle));
 
     bundle->hash = ethHashCreate(hash);
     bundle->contract = ethAddressCreate(contract);
-    bundle->topicCount = topicsCount;
-    bundle->arrayTopics = calloc (topicsCount, sizeof (char *));
+    bundle->topicCount = (int) topicsCount;
     for (int i = 0; i < topicsCount; i++)
-        bundle->arrayTopics[i] = strdup (arrayTopics[i]);
-    bundle->data = strdup (strData);
+        bundle->topics[i] = logTopicCreateFromString (arrayTopics[i]);
+    bundle->data = data;
     bundle->gasPrice = gasPrice;
     bundle->gasUsed = gasUsed;
     bundle->logIndex = logIndex;
@@ -598,6 +659,57 @@ ewmAnnounceLog (BREthereumEWM ewm,
     return SUCCESS;
 }
 
+extern void
+ewmHandleAnnounceLogs (BREthereumEWM ewm,
+                       BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles,
+                       int id) {
+    size_t count = array_count (bundles);
+
+    switch (ewm->mode) {
+        case CRYPTO_SYNC_MODE_API_ONLY:
+        case CRYPTO_SYNC_MODE_API_WITH_P2P_SEND: {
+            BRArrayOf(BREthereumLog) logs;
+            array_new (logs, count);
+            for (size_t index = 0; index < count; index++)
+                array_add (logs, ewmClientAnnounceLogBundleCreateLog (ewm, &bundles[index]));
+
+            // See ewmHandleAnnounceTransactions()
+            ewmSignalSaveBatch (ewm, ETHEREUM_BOOLEAN_TRUE);
+            ewmHandleLogs (ewm, BCS_CALLBACK_LOG_UPDATED, logs);
+            ewmSignalSaveBatch (ewm, ETHEREUM_BOOLEAN_FALSE);
+            break;
+        }
+
+        case CRYPTO_SYNC_MODE_P2P_WITH_API_SYNC:
+        case CRYPTO_SYNC_MODE_P2P_ONLY:
+            for (size_t index = 0; index < count; index++)
+                bcsSendLogRequest(ewm->bcs,
+                                  bundles[index].hash,
+                                  bundles[index].blockNumber,
+                                  bundles[index].blockTransactionIndex);
+            break;
+    }
+    ewmClientAnnounceLogBundlesRelease (bundles);
+}
+
+extern BREthereumStatus
+ewmAnnounceLogs (BREthereumEWM ewm,
+                 int id,
+                 OwnershipKept const BREthereumEWMClientAnnounceLogBundle *bundles,
+                 size_t bundlesCount) {
+    for (size_t index = 0; index < bundlesCount; index++)
+        if (bundles[index].topicCount < 0 ||
+            bundles[index].topicCount > EWM_CLIENT_ANNOUNCE_LOG_TOPICS_LIMIT)
+            return ERROR_FAILED;
+
+    BRArrayOf(BREthereumEWMClientAnnounceLogBundle) copies;
+    array_new (copies, bundlesCount);
+    array_add_array (copies, bundles, bundlesCount);
+
+    ewmSignalAnnounceLogs (ewm, copies, id);
+    return SUCCESS;
+}
+
 extern void
 ewmAnnounceLogComplete (BREthereumEWM ewm,
                         int id,
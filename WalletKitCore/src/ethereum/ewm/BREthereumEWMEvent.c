@@ -268,6 +268,35 @@ ewmSignalLog (BREthereumEWM ewm,
     eventHandlerSignalEvent(ewm->handler, (BREvent*) &event);
 }
 
+// ==============================================================================================
+//
+// Handle SaveBatch
+//
+typedef struct {
+    BREvent base;
+    BREthereumEWM ewm;
+    BREthereumBoolean begin;
+} BREthereumHandleSaveBatchEvent;
+
+static void
+ewmHandleSaveBatchEventDispatcher(BREventHandler ignore,
+                                  BREthereumHandleSaveBatchEvent *event) {
+    ewmHandleSaveBatch(event->ewm, event->begin);
+}
+
+BREventType handleSaveBatchEventType = {
+    "EWM: Handle SaveBatch Event",
+    sizeof (BREthereumHandleSaveBatchEvent),
+    (BREventDispatcher) ewmHandleSaveBatchEventDispatcher
+};
+
+extern void
+ewmSignalSaveBatch (BREthereumEWM ewm,
+                    BREthereumBoolean begin) {
+    BREthereumHandleSaveBatchEvent event = { { NULL, &handleSaveBatchEventType }, ewm, begin };
+    eventHandlerSignalEvent(ewm->handler, (BREvent*) &event);
+}
+
 // ==============================================================================================
 //
 // Handle SaveBlocks
@@ -871,6 +900,43 @@ ewmSignalAnnounceTransaction(BREthereumEWM ewm,
     eventHandlerSignalEvent (ewm->handler, (BREvent*) &message);
 }
 
+//
+// Announce Transactions
+//
+typedef struct {
+    struct BREventRecord base;
+    BREthereumEWM ewm;
+    BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles;
+    int rid;
+} BREthereumEWMClientAnnounceTransactionsEvent;
+
+static void
+ewmSignalAnnounceTransactionsDispatcher (BREventHandler ignore,
+                                         BREthereumEWMClientAnnounceTransactionsEvent *event) {
+    ewmHandleAnnounceTransactions(event->ewm, event->bundles, event->rid);
+}
+
+static void
+ewmSignalAnnounceTransactionsDestroyer (BREthereumEWMClientAnnounceTransactionsEvent *event) {
+    ewmClientAnnounceTransactionBundlesRelease(event->bundles);
+}
+
+static BREventType ewmClientAnnounceTransactionsEventType = {
+    "EWM: Client Announce Transactions Event",
+    sizeof (BREthereumEWMClientAnnounceTransactionsEvent),
+    (BREventDispatcher) ewmSignalAnnounceTransactionsDispatcher,
+    (BREventDestroyer) ewmSignalAnnounceTransactionsDestroyer
+};
+
+extern void
+ewmSignalAnnounceTransactions (BREthereumEWM ewm,
+                               BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles,
+                               int rid) {
+    BREthereumEWMClientAnnounceTransactionsEvent message =
+    { { NULL, &ewmClientAnnounceTransactionsEventType}, ewm, bundles, rid};
+    eventHandlerSignalEvent (ewm->handler, (BREvent*) &message);
+}
+
 //
 // Announce Log
 //
@@ -908,6 +974,43 @@ ewmSignalAnnounceLog (BREthereumEWM ewm,
     eventHandlerSignalEvent (ewm->handler, (BREvent*) &message);
 }
 
+//
+// Announce Logs
+//
+typedef struct {
+    struct BREventRecord base;
+    BREthereumEWM ewm;
+    BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles;
+    int rid;
+} BREthereumEWMClientAnnounceLogsEvent;
+
+static void
+ewmSignalAnnounceLogsDispatcher (BREventHandler ignore,
+                                 BREthereumEWMClientAnnounceLogsEvent *event) {
+    ewmHandleAnnounceLogs(event->ewm, event->bundles, event->rid);
+}
+
+static void
+ewmSignalAnnounceLogsDestroyer (BREthereumEWMClientAnnounceLogsEvent *event) {
+    ewmClientAnnounceLogBundlesRelease(event->bundles);
+}
+
+static BREventType ewmClientAnnounceLogsEventType = {
+    "EWM: Client Announce Logs Event",
+    sizeof (BREthereumEWMClientAnnounceLogsEvent),
+    (BREventDispatcher) ewmSignalAnnounceLogsDispatcher,
+    (BREventDestroyer) ewmSignalAnnounceLogsDestroyer
+};
+
+extern void
+ewmSignalAnnounceLogs (BREthereumEWM ewm,
+                       BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles,
+                       int rid) {
+    BREthereumEWMClientAnnounceLogsEvent message =
+    { { NULL, &ewmClientAnnounceLogsEventType}, ewm, bundles, rid};
+    eventHandlerSignalEvent (ewm->handler, (BREvent*) &message);
+}
+
 //
 // Announce {Transaction, Log} Complete
 //
@@ -1021,6 +1124,7 @@ const BREventType *ewmEventTypes[] = {
     &handleGasEstimateEventType,
     &handleTransactionEventType,
     &handleLogEventType,
+    &handleSaveBatchEventType,
     &handleSaveBlocksEventType,
     &handleSaveNodesEventType,
     &handleSyncEventType,
@@ -1039,7 +1143,9 @@ const BREventType *ewmEventTypes[] = {
     &ewmClientAnnounceGasPriceEventType,
     &ewmClientAnnounceSubmitTransferEventType,
     &ewmClientAnnounceTransactionEventType,
+    &ewmClientAnnounceTransactionsEventType,
     &ewmClientAnnounceLogEventType,
+    &ewmClientAnnounceLogsEventType,
     &ewmClientAnnounceCompleteEventType,
     &ewmClientAnnounceTokenEventType,
     &ewmClientAnnounceTokenCompleteEventType,
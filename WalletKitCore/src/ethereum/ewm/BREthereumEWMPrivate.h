@@ -103,6 +103,12 @@ struct BREthereumEWMRecord {
      */
     BREthereumBCS bcs;
 
+    /**
+     * A LES shared with other EWMs on `network`, or NULL.  Used whenever BCS is created in a
+     * mode that handles sync.
+     */
+    BREthereumLES les;
+
     /**
      * The BlockHeight is the largest block number seen or computed.  [Note: the blockHeight may
      * be computed from a Log event as (log block number + log confirmations).  This is the block
@@ -143,6 +149,11 @@ struct BREthereumEWMRecord {
      */
     BRFileService fs;
 
+    /**
+     * The storage path; also where BCS persists its proof-of-work caches
+     */
+    char *storagePath;
+
     /**
      * If we are syncing with BRD, instead of as P2P with BCS, then we'll keep a record to
      * ensure we've successfully completed the getTransactions() and getLogs() callbacks to
@@ -257,6 +268,17 @@ ewmSignalTransaction (BREthereumEWM ewm,
                       BREthereumBCSCallbackTransactionType type,
                       OwnershipGiven BREthereumTransaction transaction);
 
+//
+// Handle Transactions
+//
+// Handle each of `transactions` as ewmHandleTransaction() does but, in the BRD modes, update each
+// affected wallet's balance once, at the end, announcing a changed balance.
+//
+extern void
+ewmHandleTransactions (BREthereumEWM ewm,
+                       BREthereumBCSCallbackTransactionType type,
+                       OwnershipGiven BRArrayOf(BREthereumTransaction) transactions);
+
 //
 // Signal/Handle Log (BCS Callback)
 //
@@ -272,6 +294,11 @@ ewmSignalLog (BREthereumEWM ewm,
               BREthereumBCSCallbackLogType type,
               OwnershipGiven BREthereumLog log);
 
+extern void
+ewmHandleLogs (BREthereumEWM ewm,
+               BREthereumBCSCallbackLogType type,
+               OwnershipGiven BRArrayOf(BREthereumLog) logs);
+
 //
 // Signal/Handle Save Blocks (BCS Callback)
 //
@@ -315,6 +342,20 @@ ewmHandleSaveWallet (BREthereumEWM ewm,
                      BREthereumWallet wallet,
                      BREthereumClientChangeType type);
 
+//
+// Signal/Handle Save Batch
+//
+// Begin or end a persistence batch.  These are signalled, rather than handled directly, so that
+// they are ordered with the transfer and wallet events, whose handlers do the saving.
+//
+extern void
+ewmHandleSaveBatch (BREthereumEWM ewm,
+                    BREthereumBoolean begin);
+
+extern void
+ewmSignalSaveBatch (BREthereumEWM ewm,
+                    BREthereumBoolean begin);
+
 //
 // Signal/Handle Sync (BCS Callback)
 //
@@ -412,31 +453,19 @@ ewmHandleAnnounceSubmitTransfer (BREthereumEWM ewm,
 
 /// MARK: - Transactions
 
-typedef struct {
-    BREthereumHash hash;
-    BREthereumAddress from;
-    BREthereumAddress to;
-    BREthereumAddress contract;
-    UInt256 amount;
-    uint64_t gasLimit;
-    UInt256 gasPrice;
-    char *data;
-    uint64_t nonce;
-    uint64_t gasUsed;
-    uint64_t blockNumber;
-    BREthereumHash blockHash;
-    uint64_t blockConfirmations;
-    uint64_t blockTransactionIndex;
-    uint64_t blockTimestamp;
-    BREthereumBoolean isError;
-} BREthereumEWMClientAnnounceTransactionBundle;
-
 static inline void
 ewmClientAnnounceTransactionBundleRelease (BREthereumEWMClientAnnounceTransactionBundle *bundle) {
     free (bundle->data);
     free (bundle);
 }
 
+static inline void
+ewmClientAnnounceTransactionBundlesRelease (BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles) {
+    for (size_t index = 0; index < array_count (bundles); index++)
+        free (bundles[index].data);
+    array_free (bundles);
+}
+
 extern void
 ewmHandleAnnounceTransaction(BREthereumEWM ewm,
                                    BREthereumEWMClientAnnounceTransactionBundle *bundle,
@@ -447,31 +476,28 @@ ewmSignalAnnounceTransaction(BREthereumEWM ewm,
                                    BREthereumEWMClientAnnounceTransactionBundle *bundle,
                                    int id);
 
-/// MARK: - Logs
+extern void
+ewmHandleAnnounceTransactions (BREthereumEWM ewm,
+                               OwnershipGiven BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles,
+                               int id);
 
-typedef struct {
-    BREthereumHash hash;
-    BREthereumAddress contract;
-    int topicCount;
-    char **arrayTopics;
-    char *data;
-    UInt256 gasPrice;
-    uint64_t gasUsed;
-    uint64_t logIndex;
-    uint64_t blockNumber;
-    uint64_t blockTransactionIndex;
-    uint64_t blockTimestamp;
-} BREthereumEWMClientAnnounceLogBundle;
+extern void
+ewmSignalAnnounceTransactions (BREthereumEWM ewm,
+                               OwnershipGiven BRArrayOf(BREthereumEWMClientAnnounceTransactionBundle) bundles,
+                               int id);
+
+/// MARK: - Logs
 
 static inline void
 ewmClientAnnounceLogBundleRelease (BREthereumEWMClientAnnounceLogBundle *bundle) {
-    for (int i = 0; i < bundle->topicCount; i++)
-        free (bundle->arrayTopics[i]);
-    free (bundle->arrayTopics);
-    free (bundle->data);
     free (bundle);
 }
 
+static inline void
+ewmClientAnnounceLogBundlesRelease (BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles) {
+    array_free (bundles);
+}
+
 extern void
 ewmSignalAnnounceLog (BREthereumEWM ewm,
                             BREthereumEWMClientAnnounceLogBundle *bundle,
@@ -482,6 +508,16 @@ ewmHandleAnnounceLog (BREthereumEWM ewm,
                             BREthereumEWMClientAnnounceLogBundle *bundle,
                             int id);
 
+extern void
+ewmSignalAnnounceLogs (BREthereumEWM ewm,
+                       OwnershipGiven BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles,
+                       int id);
+
+extern void
+ewmHandleAnnounceLogs (BREthereumEWM ewm,
+                       OwnershipGiven BRArrayOf(BREthereumEWMClientAnnounceLogBundle) bundles,
+                       int id);
+
 /// MARK: - Account Complete
 
 extern void
@@ -424,7 +424,7 @@ transferSign (BREthereumTransfer transfer,
                              ethAccountGetThenIncrementAddressNonce(account, address));
     
     // RLP Encode the UNSIGNED transfer
-    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
     BRRlpItem item = transactionRlpEncode (transfer->originatingTransaction,
                                            network,
                                            RLP_TYPE_TRANSACTION_UNSIGNED,
@@ -449,7 +449,7 @@ transferSign (BREthereumTransfer transfer,
                                  RLP_TYPE_TRANSACTION_SIGNED,
                                  coder);
     transactionSetHash (transfer->originatingTransaction,
-                        ethHashCreateFromData (rlpItemGetDataSharedDontRelease (coder, item)));
+                        ethHashCreateFromRlpItem (item, coder));
 
     rlpItemRelease(coder, item);
     rlpCoderRelease(coder);
@@ -467,7 +467,7 @@ transferSignWithKey (BREthereumTransfer transfer,
                              ethAccountGetThenIncrementAddressNonce(account, address));
     
     // RLP Encode the UNSIGNED transfer
-    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
     BRRlpItem item = transactionRlpEncode (transfer->originatingTransaction,
                                            network,
                                            RLP_TYPE_TRANSACTION_UNSIGNED,
@@ -493,7 +493,7 @@ transferSignWithKey (BREthereumTransfer transfer,
                                  RLP_TYPE_TRANSACTION_SIGNED,
                                  coder);
     transactionSetHash (transfer->originatingTransaction,
-                        ethHashCreateFromData (rlpItemGetDataSharedDontRelease (coder, item)));
+                        ethHashCreateFromRlpItem (item, coder));
 
     rlpItemRelease(coder, item);
     rlpCoderRelease(coder);
@@ -35,6 +35,43 @@ static int // -1 if not found
 walletLookupTransferIndex (BREthereumWallet wallet,
                            BREthereumTransfer transfer);
 
+static void
+walletUpdateTransferSorted (BREthereumWallet wallet,
+                            BREthereumTransfer transfer);
+
+//
+// Transfer Keys
+//
+
+/**
+ * The keys by which a wallet finds a transfer, other than its index.  A transfer is found by its
+ * identifier (the hash of its transaction or log basis), by the hash of its originating
+ * transaction and by its {source address, nonce}.  An EMPTY hash or an unassigned nonce is not
+ * a key and is not indexed.
+ */
+typedef enum {
+    WALLET_TRANSFER_INDEX_IDENTIFIER,
+    WALLET_TRANSFER_INDEX_ORIGINATING_HASH,
+    WALLET_TRANSFER_INDEX_NONCE
+} BREthereumWalletTransferIndex;
+
+#define NUMBER_OF_WALLET_TRANSFER_INDICES   (1 + WALLET_TRANSFER_INDEX_NONCE)
+
+/**
+ * A transfer with its keys as of when the transfer was indexed.  Removing a transfer from the
+ * indices uses these keys, not the transfer's current ones.  Transfers sharing a key (rarely,
+ * such as a replaced and a replacing transfer sharing a nonce) are chained through `next` from
+ * the one held in the index's set.
+ */
+typedef struct BREthereumWalletTransferKeysRecord {
+    BREthereumTransfer transfer;
+    BREthereumHash identifier;
+    BREthereumHash originatingHash;
+    BREthereumAddress sourceAddress;
+    uint64_t nonce;
+    struct BREthereumWalletTransferKeysRecord *next[NUMBER_OF_WALLET_TRANSFER_INDICES];
+} *BREthereumWalletTransferKeys;
+
 //
 // Wallet
 //
@@ -88,8 +125,8 @@ struct BREthereumWalletRecord {
     
     /*
      * Transfers - these are sorted from oldest [index 0] to newest.  As transfers are added
-     * we'll maintain the ordering using an 'insertion sort' - while starting at the end and
-     * working backwards.
+     * we'll maintain the ordering using an 'insertion sort' - with a binary search for the
+     * insertion point.
      *
      * We are often faced with looking up a transfer based on a hash.  For example, BCS found
      * a transaction for our address and we need to find the corresponding transfer.  Or, instead
@@ -106,19 +143,183 @@ struct BREthereumWalletRecord {
      *
      * FOR NOW, WE'LL ASSUME: ONE HASH <==> ONE TRANSFER (transaction or log)
      *
-     * Given a hash, to find a corresponding transfers we'll iterate through `transfers` and
-     * compare: a) the hash for the originating transaction, if it exists, b) the hash for the
-     * basis, if it exists.  If the basis is a log, we'll extranct the transaction hash and compare
-     * that.
-     *
-     * We might consider:
-     *   BRSetOf (BRArrayOf ({hash, transfer}) transfersByHashPairs;
-     * which would speed lookup of a transfer.
+     * Given a hash, to find a corresponding transfer we'll look in `transfersByIndex` for: a) the
+     * hash for the basis, if it exists, as the transfer's identifier, b) the hash for the
+     * originating transaction, if it exists.  The sorted insertion uses a binary search; only
+     * the shift of later transfers remains linear.
      *
+     * All changes to a transfer's keys or ordering - setting its basis or signing it - go
+     * through the wallet so that `transfersByIndex` and the ordering remain consistent.
      */
     BRArrayOf (BREthereumTransfer) transfers;
+
+    /**
+     * The keys for each transfer in `transfers`, found by transfer.
+     */
+    BRSetOf (BREthereumWalletTransferKeys) transferKeys;
+
+    /**
+     * The transfer keys for each BREthereumWalletTransferIndex, found by that index's key.
+     */
+    BRSetOf (BREthereumWalletTransferKeys) transfersByIndex[NUMBER_OF_WALLET_TRANSFER_INDICES];
 };
 
+static size_t
+walletTransferKeysHashValue (const void *k) {
+    return (size_t) ((BREthereumWalletTransferKeys) k)->transfer;
+}
+
+static int
+walletTransferKeysHashEqual (const void *k1, const void *k2) {
+    return k1 == k2 || ((BREthereumWalletTransferKeys) k1)->transfer == ((BREthereumWalletTransferKeys) k2)->transfer;
+}
+
+static size_t
+walletTransferKeysIdentifierValue (const void *k) {
+    return (size_t) ethHashSetValue (&((BREthereumWalletTransferKeys) k)->identifier);
+}
+
+static int
+walletTransferKeysIdentifierEqual (const void *k1, const void *k2) {
+    return k1 == k2 || ethHashSetEqual (&((BREthereumWalletTransferKeys) k1)->identifier,
+                                        &((BREthereumWalletTransferKeys) k2)->identifier);
+}
+
+static size_t
+walletTransferKeysOriginatingHashValue (const void *k) {
+    return (size_t) ethHashSetValue (&((BREthereumWalletTransferKeys) k)->originatingHash);
+}
+
+static int
+walletTransferKeysOriginatingHashEqual (const void *k1, const void *k2) {
+    return k1 == k2 || ethHashSetEqual (&((BREthereumWalletTransferKeys) k1)->originatingHash,
+                                        &((BREthereumWalletTransferKeys) k2)->originatingHash);
+}
+
+static size_t
+walletTransferKeysNonceValue (const void *k) {
+    BREthereumWalletTransferKeys keys = (BREthereumWalletTransferKeys) k;
+    return ((size_t) ethAddressHashValue (keys->sourceAddress)) ^ (size_t) keys->nonce;
+}
+
+static int
+walletTransferKeysNonceEqual (const void *k1, const void *k2) {
+    BREthereumWalletTransferKeys keys1 = (BREthereumWalletTransferKeys) k1;
+    BREthereumWalletTransferKeys keys2 = (BREthereumWalletTransferKeys) k2;
+    return k1 == k2 || (keys1->nonce == keys2->nonce &&
+                        ethAddressHashEqual (keys1->sourceAddress, keys2->sourceAddress));
+}
+
+static int
+walletTransferKeysHasIndex (BREthereumWalletTransferKeys keys,
+                            BREthereumWalletTransferIndex index) {
+    switch (index) {
+        case WALLET_TRANSFER_INDEX_IDENTIFIER:
+            return ETHEREUM_BOOLEAN_IS_FALSE (ethHashEqual (keys->identifier, EMPTY_HASH_INIT));
+        case WALLET_TRANSFER_INDEX_ORIGINATING_HASH:
+            return ETHEREUM_BOOLEAN_IS_FALSE (ethHashEqual (keys->originatingHash, EMPTY_HASH_INIT));
+        case WALLET_TRANSFER_INDEX_NONCE:
+            return TRANSACTION_NONCE_IS_NOT_ASSIGNED != keys->nonce;
+    }
+}
+
+static BREthereumWalletTransferKeys
+walletTransferKeysCreate (BREthereumTransfer transfer) {
+    BREthereumWalletTransferKeys keys = calloc (1, sizeof (struct BREthereumWalletTransferKeysRecord));
+
+    BREthereumTransaction originatingTransaction = transferGetOriginatingTransaction (transfer);
+
+    keys->transfer        = transfer;
+    keys->identifier      = transferGetIdentifier (transfer);
+    keys->originatingHash = (NULL != originatingTransaction
+                             ? transactionGetHash (originatingTransaction)
+                             : EMPTY_HASH_INIT);
+    keys->sourceAddress   = transferGetSourceAddress (transfer);
+    keys->nonce           = transferGetNonce (transfer);
+
+    return keys;
+}
+
+/**
+ * Add `transfer` to the wallet's indices, with its current keys.
+ */
+static void
+walletIndexTransfer (BREthereumWallet wallet,
+                     BREthereumTransfer transfer) {
+    BREthereumWalletTransferKeys keys = walletTransferKeysCreate (transfer);
+    BRSetAdd (wallet->transferKeys, keys);
+
+    for (BREthereumWalletTransferIndex index = 0; index < NUMBER_OF_WALLET_TRANSFER_INDICES; index++) {
+        if (!walletTransferKeysHasIndex (keys, index)) continue;
+
+        BREthereumWalletTransferKeys head = BRSetGet (wallet->transfersByIndex[index], keys);
+        if (NULL == head)
+            BRSetAdd (wallet->transfersByIndex[index], keys);
+        else {
+            keys->next[index] = head->next[index];
+            head->next[index] = keys;
+        }
+    }
+}
+
+/**
+ * Remove `transfer` from the wallet's indices, using the keys it was indexed with.
+ */
+static void
+walletUnindexTransfer (BREthereumWallet wallet,
+                       BREthereumTransfer transfer) {
+    struct BREthereumWalletTransferKeysRecord probe = { transfer };
+    BREthereumWalletTransferKeys keys = BRSetRemove (wallet->transferKeys, &probe);
+    if (NULL == keys) return;
+
+    for (BREthereumWalletTransferIndex index = 0; index < NUMBER_OF_WALLET_TRANSFER_INDICES; index++) {
+        if (!walletTransferKeysHasIndex (keys, index)) continue;
+
+        BREthereumWalletTransferKeys head = BRSetGet (wallet->transfersByIndex[index], keys);
+        assert (NULL != head);
+
+        if (head == keys) {
+            BRSetRemove (wallet->transfersByIndex[index], keys);
+            if (NULL != keys->next[index])
+                BRSetAdd (wallet->transfersByIndex[index], keys->next[index]);
+        }
+        else {
+            BREthereumWalletTransferKeys prev = head;
+            while (NULL != prev->next[index] && keys != prev->next[index])
+                prev = prev->next[index];
+            assert (NULL != prev->next[index]);
+            prev->next[index] = keys->next[index];
+        }
+    }
+
+    free (keys);
+}
+
+/**
+ * Find the transfer indexed in `index` by the key in `probe`.  If more than one transfer has the
+ * key, then the one first in `transfers` is returned.
+ */
+static BREthereumTransfer
+walletLookupTransfer (BREthereumWallet wallet,
+                      BREthereumWalletTransferIndex index,
+                      BREthereumWalletTransferKeys probe) {
+    BREthereumWalletTransferKeys keys = BRSetGet (wallet->transfersByIndex[index], probe);
+    if (NULL == keys) return NULL;
+
+    BREthereumTransfer transfer = keys->transfer;
+    if (NULL != keys->next[index]) {
+        int transferIndex = walletLookupTransferIndex (wallet, transfer);
+        for (keys = keys->next[index]; NULL != keys; keys = keys->next[index]) {
+            int keysIndex = walletLookupTransferIndex (wallet, keys->transfer);
+            if (keysIndex < transferIndex) {
+                transfer      = keys->transfer;
+                transferIndex = keysIndex;
+            }
+        }
+    }
+    return transfer;
+}
+
 //
 // Wallet Creation
 //
@@ -153,6 +354,23 @@ walletCreateDetailed (BREthereumAccount account,
     : ethTokenGetGasPrice (optionalToken);
     
     array_new(wallet->transfers, DEFAULT_TRANSFER_CAPACITY);
+
+    wallet->transferKeys = BRSetNew (walletTransferKeysHashValue,
+                                     walletTransferKeysHashEqual,
+                                     DEFAULT_TRANSFER_CAPACITY);
+    wallet->transfersByIndex[WALLET_TRANSFER_INDEX_IDENTIFIER] =
+    BRSetNew (walletTransferKeysIdentifierValue,
+              walletTransferKeysIdentifierEqual,
+              DEFAULT_TRANSFER_CAPACITY);
+    wallet->transfersByIndex[WALLET_TRANSFER_INDEX_ORIGINATING_HASH] =
+    BRSetNew (walletTransferKeysOriginatingHashValue,
+              walletTransferKeysOriginatingHashEqual,
+              DEFAULT_TRANSFER_CAPACITY);
+    wallet->transfersByIndex[WALLET_TRANSFER_INDEX_NONCE] =
+    BRSetNew (walletTransferKeysNonceValue,
+              walletTransferKeysNonceEqual,
+              DEFAULT_TRANSFER_CAPACITY);
+
     return wallet;
 }
 
@@ -184,6 +402,12 @@ walletRelease (BREthereumWallet wallet) {
     for (size_t index = 0; index < array_count(wallet->transfers); index++)
         transferRelease (wallet->transfers[index]);
     array_free(wallet->transfers);
+
+    // The keys are shared by the indices; free them once.
+    for (BREthereumWalletTransferIndex index = 0; index < NUMBER_OF_WALLET_TRANSFER_INDICES; index++)
+        BRSetFree (wallet->transfersByIndex[index]);
+    BRSetFreeAll (wallet->transferKeys, free);
+
     free (wallet);
 }
 
@@ -285,6 +509,7 @@ private_extern void
 walletHandleTransfer(BREthereumWallet wallet,
                      BREthereumTransfer transfer) {
     walletInsertTransferSorted (wallet, transfer);
+    walletIndexTransfer (wallet, transfer);
 }
 
 private_extern void
@@ -292,13 +517,39 @@ walletUnhandleTransfer (BREthereumWallet wallet,
                         BREthereumTransfer transfer) {
     int index = walletLookupTransferIndex (wallet, transfer);
     assert (-1 != index);
+    walletUnindexTransfer (wallet, transfer);
     array_rm(wallet->transfers, (size_t) index);
 }
 
 private_extern int
 walletHasTransfer (BREthereumWallet wallet,
                    BREthereumTransfer transfer) {
-    return -1 != walletLookupTransferIndex (wallet, transfer);
+    struct BREthereumWalletTransferKeysRecord probe = { transfer };
+    return BRSetContains (wallet->transferKeys, &probe);
+}
+
+private_extern void
+walletSetTransferBasisForTransaction (BREthereumWallet wallet,
+                                      BREthereumTransfer transfer,
+                                      OwnershipGiven BREthereumTransaction transaction) {
+    assert (walletHasTransfer (wallet, transfer));
+
+    walletUnindexTransfer (wallet, transfer);
+    transferSetBasisForTransaction (transfer, transaction);
+    walletUpdateTransferSorted (wallet, transfer);
+    walletIndexTransfer (wallet, transfer);
+}
+
+private_extern void
+walletSetTransferBasisForLog (BREthereumWallet wallet,
+                              BREthereumTransfer transfer,
+                              OwnershipGiven BREthereumLog log) {
+    assert (walletHasTransfer (wallet, transfer));
+
+    walletUnindexTransfer (wallet, transfer);
+    transferSetBasisForLog (transfer, log);
+    walletUpdateTransferSorted (wallet, transfer);
+    walletIndexTransfer (wallet, transfer);
 }
 
 //
@@ -316,11 +567,17 @@ extern void
 walletSignTransfer (BREthereumWallet wallet,
                     BREthereumTransfer transfer,
                     const char *paperKey) {
+    // Signing assigns the nonce and the originating hash; reindex if `transfer` is held.
+    int hasTransfer = walletHasTransfer (wallet, transfer);
+    if (hasTransfer) walletUnindexTransfer (wallet, transfer);
+
     transferSign (transfer,
                   wallet->network,
                   wallet->account,
                   wallet->address,
                   paperKey);
+
+    if (hasTransfer) walletIndexTransfer (wallet, transfer);
 }
 
 /**
@@ -334,11 +591,16 @@ extern void
 walletSignTransferWithPrivateKey (BREthereumWallet wallet,
                                   BREthereumTransfer transfer,
                                   BRKey privateKey) {
+    int hasTransfer = walletHasTransfer (wallet, transfer);
+    if (hasTransfer) walletUnindexTransfer (wallet, transfer);
+
     transferSignWithKey (transfer,
                          wallet->network,
                          wallet->account,
                          wallet->address,
                          privateKey);
+
+    if (hasTransfer) walletIndexTransfer (wallet, transfer);
 }
 
 //
@@ -490,34 +752,32 @@ walletGetTransferByIdentifier (BREthereumWallet wallet,
                                BREthereumHash hash) {
     if (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (hash, EMPTY_HASH_INIT))) return NULL;
 
-    for (int i = 0; i < array_count(wallet->transfers); i++) {
-        BREthereumHash identifier = transferGetIdentifier (wallet->transfers[i]);
-        if (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (hash, identifier)))
-            return wallet->transfers[i];
-    }
-    return NULL;
+    struct BREthereumWalletTransferKeysRecord probe = { NULL };
+    probe.identifier = hash;
+    return walletLookupTransfer (wallet, WALLET_TRANSFER_INDEX_IDENTIFIER, &probe);
 }
 
 extern BREthereumTransfer
 walletGetTransferByOriginatingHash (BREthereumWallet wallet,
                                     BREthereumHash hash) {
-    for (int i = 0; i < array_count(wallet->transfers); i++) {
-        BREthereumTransaction transaction = transferGetOriginatingTransaction (wallet->transfers[i]);
-        if (NULL != transaction && ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (hash, transactionGetHash (transaction))))
-            return wallet->transfers[i];
-    }
-    return NULL;
+    // An unsigned originating transaction has an EMPTY hash; it is not indexed.
+    if (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (hash, EMPTY_HASH_INIT))) return NULL;
+
+    struct BREthereumWalletTransferKeysRecord probe = { NULL };
+    probe.originatingHash = hash;
+    return walletLookupTransfer (wallet, WALLET_TRANSFER_INDEX_ORIGINATING_HASH, &probe);
 }
 
 extern BREthereumTransfer
 walletGetTransferByNonce(BREthereumWallet wallet,
                          BREthereumAddress sourceAddress,
                          uint64_t nonce) {
-    for (int i = 0; i < array_count(wallet->transfers); i++)
-        if (nonce == transferGetNonce (wallet->transfers[i])
-            && ETHEREUM_BOOLEAN_IS_TRUE(ethAddressEqual(sourceAddress, transferGetSourceAddress(wallet->transfers[i]))))
-            return wallet->transfers [i];
-    return NULL;
+    if (TRANSACTION_NONCE_IS_NOT_ASSIGNED == nonce) return NULL;
+
+    struct BREthereumWalletTransferKeysRecord probe = { NULL };
+    probe.sourceAddress = sourceAddress;
+    probe.nonce = nonce;
+    return walletLookupTransfer (wallet, WALLET_TRANSFER_INDEX_NONCE, &probe);
 }
 
 extern BREthereumTransfer
@@ -531,7 +791,25 @@ walletGetTransferByIndex(BREthereumWallet wallet,
 static int // -1 if not found
 walletLookupTransferIndex (BREthereumWallet wallet,
                            BREthereumTransfer transfer) {
-    for (int i = 0; i < array_count(wallet->transfers); i++)
+    size_t count = array_count(wallet->transfers);
+
+    // Binary search for the first transfer not-less-than `transfer`, then check those that
+    // compare equal to it.
+    size_t lower = 0, upper = count;
+    while (lower < upper) {
+        size_t middle = lower + (upper - lower) / 2;
+        if (ETHEREUM_COMPARISON_LT == transferCompare (wallet->transfers[middle], transfer))
+            lower = middle + 1;
+        else
+            upper = middle;
+    }
+
+    for (size_t i = lower; i < count && ETHEREUM_COMPARISON_EQ == transferCompare (wallet->transfers[i], transfer); i++)
+        if (transfer == wallet->transfers[i])
+            return (int) i;
+
+    // Not where the ordering says; the transfer's basis may have changed in place.
+    for (int i = 0; i < count; i++)
         if (transfer == wallet->transfers[i])
             return i;
     return -1;
@@ -540,18 +818,19 @@ walletLookupTransferIndex (BREthereumWallet wallet,
 static void
 walletInsertTransferSorted (BREthereumWallet wallet,
                             BREthereumTransfer transfer) {
-    size_t index = array_count(wallet->transfers);
-    for (; index > 0; index--)
-        // quit if transfer is not-less-than the next in wallet
-        if (ETHEREUM_COMPARISON_LT != transferCompare (transfer, wallet->transfers[index - 1]))
-            break;
-    array_insert(wallet->transfers, index, transfer);
-}
-
-#pragma clang diagnostic push
-#pragma GCC diagnostic push
-#pragma clang diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-function"
+    // Binary search for the first transfer greater-than `transfer`; inserting there keeps
+    // transfers that compare equal in the order they were added.
+    size_t lower = 0, upper = array_count(wallet->transfers);
+    while (lower < upper) {
+        size_t middle = lower + (upper - lower) / 2;
+        if (ETHEREUM_COMPARISON_LT == transferCompare (transfer, wallet->transfers[middle]))
+            upper = middle;
+        else
+            lower = middle + 1;
+    }
+    array_insert(wallet->transfers, lower, transfer);
+}
+
 static void
 walletUpdateTransferSorted (BREthereumWallet wallet,
                             BREthereumTransfer transfer) {
@@ -561,8 +840,6 @@ walletUpdateTransferSorted (BREthereumWallet wallet,
     array_rm(wallet->transfers, (size_t) index);
     walletInsertTransferSorted(wallet, transfer);
 }
-#pragma clang diagnostic pop
-#pragma GCC diagnostic pop
 
 extern unsigned long
 walletGetTransferCount (BREthereumWallet wallet) {
@@ -278,6 +278,20 @@ private_extern int
 walletHasTransfer (BREthereumWallet wallet,
                    BREthereumTransfer transaction);
 
+/**
+ * Set the basis of `transfer`, held by `wallet`.  Use these, rather than the transfer functions,
+ * so that the wallet's transfer ordering and lookups follow the new basis.
+ */
+private_extern void
+walletSetTransferBasisForTransaction (BREthereumWallet wallet,
+                                      BREthereumTransfer transfer,
+                                      OwnershipGiven BREthereumTransaction transaction);
+
+private_extern void
+walletSetTransferBasisForLog (BREthereumWallet wallet,
+                              BREthereumTransfer transfer,
+                              OwnershipGiven BREthereumLog log);
+
 /// MARK: - Persisted Wallet State;
 
 typedef struct BREthereumWalletStateRecord *BREthereumWalletState;
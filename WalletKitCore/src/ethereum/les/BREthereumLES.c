@@ -13,6 +13,8 @@
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/time.h>
 #include <arpa/inet.h>
 #include <resolv.h>
 #include <netdb.h>
@@ -27,6 +29,14 @@
 #include "BREthereumMessage.h"
 #include "BREthereumNode.h"
 
+// On Linux (including Android) the active node sockets are held in an epoll set and the thread
+// is woken with an eventfd; elsewhere we pselect() with a self-pipe as the wakeup descriptor.
+#if defined (__linux__)
+#   define LES_POLL_EPOLL
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#endif
+
 #if !defined(LES_BOOTSTRAP_LCL_ONLY)
 #   if defined (LES_BOOTSTRAP_BRD_ONLY)
 static int bootstrapBRDOnly = 1;
@@ -65,12 +75,24 @@ static ssize_t
 lesFindRequestForProvision (BREthereumLES les,
                             BREthereumProvision *provision);
 
+static ssize_t
+lesFindRequestForIdentifier (BREthereumLES les,
+                             BREthereumProvisionIdentifier identifier);
+
 static void
 lesDeactivateNode (BREthereumLES les,
                    BREthereumNodeEndpointRoute route,
                    BREthereumNode node,
                    const char *explain);
 
+static void
+lesRemoveRequest (BREthereumLES les,
+                  size_t index,
+                  BREthereumBoolean release);
+
+static BRArrayOf(BREthereumNodeConfig)
+lesCreateNodeConfigs (BREthereumLES les);
+
 static void *
 lesThread (BREthereumLES les);
 
@@ -90,6 +112,22 @@ static inline int minimum (int a, int b) { return a < b ? a : b; }
 
 #define LES_PREFERRED_NODE_INDEX     0
 
+// The thread waits this long for node activity before handling 'idle' work - node discovery and
+// connecting to available nodes.  Requests do not wait on this; they wakeup the thread.
+#define LES_THREAD_IDLE_TIMEOUT_IN_MILLISECONDS    (250)
+
+#define LES_POLL_EVENTS_COUNT   (2 * LES_NODE_INITIAL_SIZE)
+
+// Scheduling of requests that any node can handle; see lesScheduleRequest().  Until a node has
+// completed a provision, we assume the default latency (seconds per message) and throughput
+// (items per second).  An assigned request is 'slow' once it takes SLOW_FACTOR times longer
+// than expected, but never before SLOW_MINIMUM seconds.
+#define LES_SCHEDULE_NODE_PROVISIONS_LIMIT      (4)
+#define LES_SCHEDULE_DEFAULT_LATENCY            (0.5)
+#define LES_SCHEDULE_DEFAULT_THROUGHPUT         (200.0)
+#define LES_SCHEDULE_SLOW_FACTOR                (3.0)
+#define LES_SCHEDULE_SLOW_MINIMUM_IN_SECONDS    (2.0)
+
 // Iterate over LES nodes...
 #define FOR_SET(type,var,set) \
   for (type var = BRSetIterate(set, NULL); \
@@ -224,6 +262,57 @@ nodeGetPreferredState (BREthereumNodeState state) {
 }
 
 
+/**
+ * A LES Split is a provision that was split into parts, with each part handled as its own
+ * request, by whichever node is expected to complete it first.  Once every part completes, the
+ * parts are merged into `provision` and `callback` is invoked as if one node provided everything.
+ */
+typedef struct {
+    BREthereumLESProvisionContext context;
+    BREthereumLESProvisionCallback callback;
+
+    /** The provision as requested; holds the merged results once all parts complete */
+    BREthereumProvision provision;
+
+    /** The parts, by index.  A completed part holds its results and owns its memory; until then
+     * the part is a copy of the provision held in the part's request. */
+    BRArrayOf(BREthereumProvision) parts;
+    BREthereumBoolean *partsComplete;
+    size_t partsRemaining;
+
+    /** The node that provided the most recent part */
+    BREthereumNode node;
+
+    /** The count of requests for the split's parts (including re-issued duplicates) */
+    size_t requestsCount;
+
+    /** If TRUE, `provision` was passed on to `callback` - as a success or as a failure */
+    BREthereumBoolean given;
+} BREthereumLESSplitRecord, *BREthereumLESSplit;
+
+static void
+splitRelease (BREthereumLESSplit split) {
+    if (NULL != split->parts) {
+        for (size_t index = 0; index < array_count (split->parts); index++)
+            if (ETHEREUM_BOOLEAN_IS_TRUE (split->partsComplete[index]))
+                provisionRelease (&split->parts[index], ETHEREUM_BOOLEAN_TRUE);
+        array_free (split->parts);
+    }
+
+    if (ETHEREUM_BOOLEAN_IS_FALSE (split->given))
+        provisionRelease (&split->provision, ETHEREUM_BOOLEAN_TRUE);
+
+    free (split->partsComplete);
+    free (split);
+}
+
+static void
+splitUnreference (BREthereumLESSplit split) {
+    assert (split->requestsCount > 0);
+    if (0 == --split->requestsCount)
+        splitRelease (split);
+}
+
 /**
  * A LES Request is a LES Message with associated callbacks.  We'll send the message (once we have
  * connected to a LES node) and then wait for a response with the corresponding `requestId`.  Once
@@ -252,6 +341,25 @@ typedef struct {
      */
     BREthereumNode node;
 
+    /**
+     * If TRUE, the request was made with NODE_REFERENCE_{ANY,NIL}; any node can handle it.  Such
+     * a request is scheduled on the node expected to complete it first, may be split across
+     * nodes and may be re-issued to another node if it is slow.  See lesScheduleRequest().
+     */
+    BREthereumBoolean anyNode;
+
+    /** The time, in seconds, after which an assigned `anyNode` request is considered slow */
+    double deadline;
+
+    /** The identifier of the request that duplicates this one, as re-issued to another node
+     * because one of them was slow; otherwise PROVISION_IDENTIFIER_UNDEFINED.  The first of the
+     * two to complete wins; the other is dropped. */
+    BREthereumProvisionIdentifier twin;
+
+    /** If this request is a part of a split provision, the split and the part's index */
+    BREthereumLESSplit split;
+    size_t splitIndex;
+
 } BREthereumLESRequest;
 
 static void
@@ -261,6 +369,9 @@ requestRelease (BREthereumLESRequest *request) {
     // Don't release a provision if it is 'owned' by a `node` - the node will release it.
     if (NULL == request->node)
         provisionRelease(&request->provision, ETHEREUM_BOOLEAN_TRUE);
+
+    if (NULL != request->split)
+        splitUnreference (request->split);
 }
 
 static void
@@ -272,6 +383,21 @@ requestsRelease (OwnershipGiven BRArrayOf(BREthereumLESRequest) requests) {
     }
 }
 
+/**
+ * A LES Client is one user of the LES nodes - typically a BCS.  Every client is invoked on each
+ * node 'Announce' and 'Status' and when saving nodes.  See lesAddClient().
+ */
+typedef struct {
+    BREthereumLESCallbackContext context;
+    BREthereumLESCallbackAnnounce callbackAnnounce;
+    BREthereumLESCallbackStatus callbackStatus;
+    BREthereumLESCallbackSaveNodes callbackSaveNodes;
+    BREthereumLESCallbackOwnsProvision callbackOwnsProvision;
+
+    /** If TRUE, the client is started.  LES runs as long as any client is started */
+    BREthereumBoolean started;
+} BREthereumLESClient;
+
 /// MARK: - LES
 
 /**
@@ -295,6 +421,19 @@ requestsRelease (OwnershipGiven BRArrayOf(BREthereumLESRequest) requests) {
  * node with each type having protocol specific data structures, the lesProvideXYZ interface has
  * an abstraction of the node specfic data.
  */
+#if defined (LES_POLL_EPOLL)
+/**
+ * A socket, for a node's route, registered in the LES epoll set.  We only modify the epoll set
+ * when a node's interest - recv and/or send - changes; not on every pass of the LES thread.
+ */
+typedef struct {
+    BREthereumNode node;
+    BREthereumNodeEndpointRoute route;
+    int socket;
+    uint32_t events;
+} BREthereumLESPollRegistration;
+#endif
+
 struct BREthereumLESRecord {
 
     /** Some private key */
@@ -308,11 +447,15 @@ struct BREthereumLESRecord {
 
     BREthereumBoolean discoverNodes;
     
-    /** Callbacks */
-    BREthereumLESCallbackContext callbackContext;
-    BREthereumLESCallbackAnnounce callbackAnnounce;
-    BREthereumLESCallbackStatus callbackStatus;
-    BREthereumLESCallbackSaveNodes callbackSaveNodes;
+    /** Clients - all sharing the nodes below */
+    BRArrayOf(BREthereumLESClient) clients;
+
+    /** Serializes the starting, stopping and removing of clients.  Held without `lock` when
+     * starting and stopping the LES thread, which itself needs `lock` */
+    pthread_mutex_t clientsLock;
+
+    /** The count of references; see lesTake() */
+    unsigned int ref;
 
     /** Our Local Endpoint. */
     BREthereumNodeEndpoint localEndpoint;
@@ -354,14 +497,266 @@ struct BREthereumLESRecord {
     pthread_t thread;
     pthread_mutex_t lock;
 
-    /** replace with pipe() message */
+    /** Wakeup descriptors as { read, write }.  Written whenever the thread has work that does not
+     * arrive on a node socket - a new request, or any of the 'time is now' flags below.  With an
+     * eventfd both are the same descriptor; otherwise they are the ends of a pipe. */
+    int wakeupDescriptors[2];
+
+#if defined (LES_POLL_EPOLL)
+    /** The epoll set holding the wakeup descriptor and the sockets of active nodes */
+    int pollDescriptor;
+
+    /** The active node sockets currently in `pollDescriptor` and their registered events */
+    BRArrayOf(BREthereumLESPollRegistration) pollRegistrations;
+#endif
+
     int theTimeToQuitIsNow;
     int theTimeToCleanIsNow;
     int theTimeToUpdateBlockHeadIsNow;
 
     int isPendingDNSSeeds;
+
+    /** The thread querying the DNS seeds, if started.  It uses `les`; joined on release. */
+    pthread_t seedThread;
 };
 
+/// MARK: - Wakeup and Poll
+
+static void
+lesWakeupCreate (BREthereumLES les) {
+#if defined (LES_POLL_EPOLL)
+    int descriptor = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+    assert (-1 != descriptor);
+
+    les->wakeupDescriptors[0] = descriptor;
+    les->wakeupDescriptors[1] = descriptor;
+
+    les->pollDescriptor = epoll_create1 (EPOLL_CLOEXEC);
+    assert (-1 != les->pollDescriptor);
+
+    struct epoll_event event = { EPOLLIN, { .fd = descriptor } };
+    epoll_ctl (les->pollDescriptor, EPOLL_CTL_ADD, descriptor, &event);
+
+    array_new (les->pollRegistrations, LES_NODE_INITIAL_SIZE);
+#else
+    int result = pipe (les->wakeupDescriptors);
+    assert (0 == result); (void) result;
+
+    for (size_t index = 0; index < 2; index++) {
+        fcntl (les->wakeupDescriptors[index], F_SETFL, fcntl (les->wakeupDescriptors[index], F_GETFL) | O_NONBLOCK);
+        fcntl (les->wakeupDescriptors[index], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+}
+
+static void
+lesWakeupRelease (BREthereumLES les) {
+#if defined (LES_POLL_EPOLL)
+    array_free (les->pollRegistrations);
+    close (les->pollDescriptor);
+    close (les->wakeupDescriptors[0]);
+#else
+    close (les->wakeupDescriptors[0]);
+    close (les->wakeupDescriptors[1]);
+#endif
+}
+
+/**
+ * Wakeup the LES thread if it is waiting on node sockets.  Safe to call from any thread, with or
+ * without `les->lock`.  A wakeup that is already pending is not repeated; a full pipe or a
+ * saturated eventfd (EAGAIN) is thus fine.
+ */
+static void
+lesWakeupSignal (BREthereumLES les) {
+#if defined (LES_POLL_EPOLL)
+    uint64_t value = 1;
+#else
+    uint8_t  value = 1;
+#endif
+    ssize_t result = write (les->wakeupDescriptors[1], &value, sizeof (value));
+    (void) result;
+}
+
+static void
+lesWakeupDrain (BREthereumLES les) {
+    uint64_t values[8];
+    while (read (les->wakeupDescriptors[0], values, sizeof (values)) > 0)
+        ;
+}
+
+#if defined (LES_POLL_EPOLL)
+static ssize_t
+lesPollRegistrationFind (BREthereumLES les,
+                         BREthereumNode node,
+                         BREthereumNodeEndpointRoute route) {
+    for (size_t index = 0; index < array_count (les->pollRegistrations); index++)
+        if (node  == les->pollRegistrations[index].node &&
+            route == les->pollRegistrations[index].route)
+            return (ssize_t) index;
+    return -1;
+}
+
+static uint32_t
+lesPollRegistrationEvents (BREthereumLES les,
+                           int socket) {
+    for (size_t index = 0; index < array_count (les->pollRegistrations); index++)
+        if (socket == les->pollRegistrations[index].socket)
+            return les->pollRegistrations[index].events;
+    return 0;
+}
+
+static void
+lesPollRegistrationRemove (BREthereumLES les,
+                           size_t index) {
+    int socket = les->pollRegistrations[index].socket;
+    array_rm (les->pollRegistrations, index);
+
+    // The kernel drops a socket from the epoll set when the socket is closed; a node's socket
+    // is often closed (on a disconnect) before we get here and the number may already be reused
+    // by another registered node.  Only remove `socket` if no other registration holds it.
+    if (0 == lesPollRegistrationEvents (les, socket))
+        epoll_ctl (les->pollDescriptor, EPOLL_CTL_DEL, socket, NULL);
+}
+
+static void
+lesPollRemove (BREthereumLES les,
+               BREthereumNode node,
+               BREthereumNodeEndpointRoute route) {
+    ssize_t index = lesPollRegistrationFind (les, node, route);
+    if (-1 != index) lesPollRegistrationRemove (les, (size_t) index);
+}
+
+/**
+ * Bring the epoll set up to date with the interest of every active node.  Typically nothing has
+ * changed; otherwise a node connected, disconnected or changed between recv and send.
+ */
+static void
+lesPollUpdate (BREthereumLES les) {
+    FOR_EACH_ROUTE (route) {
+        BRArrayOf(BREthereumNode) nodes = les->activeNodesByRoute[route];
+        for (size_t index = 0; index < array_count(nodes); index++) {
+            BREthereumNode node = nodes[index];
+
+            int needRecv, needSend;
+            int socket = nodeGetDescriptorInterest (node, route, &needRecv, &needSend);
+            uint32_t events = (needRecv ? EPOLLIN : 0) | (needSend ? EPOLLOUT : 0);
+
+            ssize_t ri = lesPollRegistrationFind (les, node, route);
+
+            // Nothing of interest; ensure the node is not in the epoll set
+            if (-1 == socket || 0 == events) {
+                if (-1 != ri) lesPollRegistrationRemove (les, (size_t) ri);
+                continue;
+            }
+
+            // A new socket for the node; drop the old one.
+            if (-1 != ri && socket != les->pollRegistrations[ri].socket) {
+                lesPollRegistrationRemove (les, (size_t) ri);
+                ri = -1;
+            }
+
+            if (-1 != ri && events == les->pollRegistrations[ri].events) continue;
+
+            struct epoll_event event = { events, { .fd = socket } };
+            if (-1 == ri) {
+                if (-1 == epoll_ctl (les->pollDescriptor, EPOLL_CTL_ADD, socket, &event) && EEXIST == errno)
+                    epoll_ctl (les->pollDescriptor, EPOLL_CTL_MOD, socket, &event);
+                array_add (les->pollRegistrations, ((BREthereumLESPollRegistration) { node, route, socket, events }));
+            }
+            else {
+                if (-1 == epoll_ctl (les->pollDescriptor, EPOLL_CTL_MOD, socket, &event) && ENOENT == errno)
+                    epoll_ctl (les->pollDescriptor, EPOLL_CTL_ADD, socket, &event);
+                les->pollRegistrations[ri].events = events;
+            }
+        }
+    }
+}
+#endif // defined (LES_POLL_EPOLL)
+
+/**
+ * Wait, for at most `timeout`, until an active node's socket is ready or until the thread is
+ * woken up.  Fill `recv` and `send` with the ready sockets - as consumed by `nodeProcess()` -
+ * and return their count, 0 on timeout or -1 on error (with errno).  If the thread was woken up,
+ * `woken` is set to 1; the return value still only counts node sockets.
+ *
+ * Must be called with `les->lock` held; the lock is released while waiting.
+ */
+static int
+lesPollWait (BREthereumLES les,
+             fd_set *recv,
+             fd_set *send,
+             int timeoutInMilliseconds,
+             int *woken) {
+    int count = 0;
+    *woken = 0;
+
+    FD_ZERO (recv);
+    FD_ZERO (send);
+
+#if defined (LES_POLL_EPOLL)
+    lesPollUpdate (les);
+
+    struct epoll_event events[LES_POLL_EVENTS_COUNT];
+
+    pthread_mutex_unlock (&les->lock);
+    int eventsCount = epoll_wait (les->pollDescriptor, events, LES_POLL_EVENTS_COUNT, timeoutInMilliseconds);
+    int error = errno;
+    pthread_mutex_lock (&les->lock);
+
+    if (-1 == eventsCount) { errno = error; return -1; }
+
+    for (int index = 0; index < eventsCount; index++) {
+        int socket = events[index].data.fd;
+
+        if (socket == les->wakeupDescriptors[0]) {
+            lesWakeupDrain (les);
+            *woken = 1;
+            continue;
+        }
+
+        // Like select(), report an error or hangup as ready for whatever the node waits on
+        uint32_t interest = lesPollRegistrationEvents (les, socket);
+        uint32_t ready    = events[index].events;
+        if (ready & (EPOLLERR | EPOLLHUP)) ready |= interest;
+
+        if ((ready & interest & EPOLLIN))  FD_SET (socket, recv);
+        if ((ready & interest & EPOLLOUT)) FD_SET (socket, send);
+        count++;
+    }
+#else
+    int maximumDescriptor = les->wakeupDescriptors[0];
+    FD_SET (les->wakeupDescriptors[0], recv);
+
+    FOR_EACH_ROUTE(route) {
+        BRArrayOf(BREthereumNode) nodes = les->activeNodesByRoute[route];
+        for (size_t index = 0; index < array_count(nodes); index++)
+            maximumDescriptor = maximum (maximumDescriptor,
+                                         nodeUpdateDescriptors (nodes[index], route, recv, send));
+    }
+
+    struct timespec timeout = {
+        timeoutInMilliseconds / 1000,
+        (timeoutInMilliseconds % 1000) * 1000000
+    };
+
+    pthread_mutex_unlock (&les->lock);
+    count = pselect (1 + maximumDescriptor, recv, send, NULL, &timeout, NULL);
+    int error = errno;
+    pthread_mutex_lock (&les->lock);
+
+    if (-1 == count) { errno = error; return -1; }
+
+    if (FD_ISSET (les->wakeupDescriptors[0], recv)) {
+        FD_CLR (les->wakeupDescriptors[0], recv);
+        lesWakeupDrain (les);
+        *woken = 1;
+        count--;
+    }
+#endif
+
+    return count;
+}
+
 static void
 lesInsertNodeAsAvailable (BREthereumLES les,
                           BREthereumNode node) {
@@ -542,11 +937,19 @@ lesCreate (BREthereumNetwork network,
 
     les->discoverNodes = discoverNodes;
 
-    // Save callbacks.
-    les->callbackContext = callbackContext;
-    les->callbackAnnounce = callbackAnnounce;
-    les->callbackStatus = callbackStatus;
-    les->callbackSaveNodes = callbackSaveNodes;
+    // Save callbacks, as the first client.
+    array_new (les->clients, 1);
+    if (NULL != callbackContext)
+        array_add (les->clients, ((BREthereumLESClient) {
+            callbackContext,
+            callbackAnnounce,
+            callbackStatus,
+            callbackSaveNodes,
+            NULL,
+            ETHEREUM_BOOLEAN_FALSE
+        }));
+
+    les->ref = 1;
 
     les->head.hash = headHash;
     les->head.number = headNumber;
@@ -612,10 +1015,14 @@ lesCreate (BREthereumNetwork network,
         pthread_mutexattr_init(&attr);
         pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE); // overkill, but needed still
         pthread_mutex_init(&les->lock, &attr);
+        pthread_mutex_init(&les->clientsLock, &attr);
         pthread_mutexattr_destroy(&attr);
     }
     les->thread = LES_PTHREAD_NULL;
 
+    // Descriptors used to wakeup lesThread() when it is waiting on node sockets.
+    lesWakeupCreate (les);
+
     // Initialize requests
     les->requestsIdentifier = 0;
     array_new (les->requests, LES_REQUESTS_INITIAL_SIZE);
@@ -636,6 +1043,7 @@ lesCreate (BREthereumNetwork network,
     les->theTimeToUpdateBlockHeadIsNow = 0;
 
     les->isPendingDNSSeeds = 1;
+    les->seedThread = LES_PTHREAD_NULL;
 
 #if !defined(LES_BOOTSTRAP_LCL_ONLY)
     // Identify a set of initial nodes; first, use all the endpoints provided (based on `configs`)
@@ -676,17 +1084,40 @@ lesStop (BREthereumLES les) {
     pthread_mutex_lock (&les->lock);
     if (LES_PTHREAD_NULL != les->thread) {
         les->theTimeToQuitIsNow = 1;
+        lesWakeupSignal (les);
         // TODO: Unlock here - to avoid a deadlock on lock() after pselect()
         pthread_mutex_unlock (&les->lock);
         pthread_join (les->thread, NULL);
+        pthread_mutex_lock (&les->lock);
         les->thread = LES_PTHREAD_NULL;
     }
     pthread_mutex_unlock (&les->lock);
 }
 
+extern BREthereumLES
+lesTake (BREthereumLES les) {
+    pthread_mutex_lock (&les->lock);
+    les->ref += 1;
+    pthread_mutex_unlock (&les->lock);
+    return les;
+}
+
 extern void
 lesRelease(BREthereumLES les) {
+    pthread_mutex_lock (&les->lock);
+    assert (les->ref > 0);
+    unsigned int ref = --les->ref;
+    pthread_mutex_unlock (&les->lock);
+    if (0 != ref) return;
+
     lesStop (les);
+
+    // The seed query thread adds nodes, under `lock`; wait for it.
+    if (LES_PTHREAD_NULL != les->seedThread) {
+        pthread_join (les->seedThread, NULL);
+        les->seedThread = LES_PTHREAD_NULL;
+    }
+
     pthread_mutex_lock (&les->lock);
 
     // Release `availableNodes` - nodes themselves later
@@ -703,14 +1134,19 @@ lesRelease(BREthereumLES les) {
 
     requestsRelease(les->requests);
 
+    array_free (les->clients);
+
     rlpCoderRelease(les->coder);
 
+    lesWakeupRelease (les);
+
     // requests, requestsToSend
 
     // TODO: NodeEnpdoint Release (to release 'hello' and 'status' messages
 
     pthread_mutex_unlock (&les->lock);
     pthread_mutex_destroy (&les->lock);
+    pthread_mutex_destroy (&les->clientsLock);
     free (les);
 }
 
@@ -718,6 +1154,7 @@ extern void
 lesClean (BREthereumLES les) {
     if (0 == pthread_mutex_trylock (&les->lock)) {
         les->theTimeToCleanIsNow = 1;
+        lesWakeupSignal (les);
         pthread_mutex_unlock (&les->lock);
     }
 }
@@ -728,11 +1165,136 @@ lesUpdateBlockHead (BREthereumLES les,
                     uint64_t headNumber,
                     UInt256 headTotalDifficulty) {
     pthread_mutex_lock (&les->lock);
+
+    // With multiple clients, the head might be from a lagging client; don't regress.
+    if (array_count (les->clients) > 1 && headNumber < les->head.number) {
+        pthread_mutex_unlock (&les->lock);
+        return;
+    }
+
     les->head.hash = headHash;
     les->head.number = headNumber;
     les->head.totalDifficulty = headTotalDifficulty;
     les->theTimeToUpdateBlockHeadIsNow = 1;
+    lesWakeupSignal (les);
+    pthread_mutex_unlock (&les->lock);
+}
+
+/// MARK: - Clients
+
+static ssize_t
+lesFindClient (BREthereumLES les,
+               BREthereumLESCallbackContext context) {
+    for (ssize_t index = 0; index < array_count (les->clients); index++)
+        if (context == les->clients[index].context)
+            return index;
+    return -1;
+}
+
+static size_t
+lesCountStartedClients (BREthereumLES les) {
+    size_t count = 0;
+    for (size_t index = 0; index < array_count (les->clients); index++)
+        if (ETHEREUM_BOOLEAN_IS_TRUE (les->clients[index].started))
+            count += 1;
+    return count;
+}
+
+extern void
+lesAddClient (BREthereumLES les,
+              BREthereumLESCallbackContext context,
+              BREthereumLESCallbackAnnounce callbackAnnounce,
+              BREthereumLESCallbackStatus callbackStatus,
+              BREthereumLESCallbackSaveNodes callbackSaveNodes,
+              BREthereumLESCallbackOwnsProvision callbackOwnsProvision) {
+    pthread_mutex_lock (&les->lock);
+    assert (-1 == lesFindClient (les, context));
+    array_add (les->clients, ((BREthereumLESClient) {
+        context,
+        callbackAnnounce,
+        callbackStatus,
+        callbackSaveNodes,
+        callbackOwnsProvision,
+        ETHEREUM_BOOLEAN_FALSE
+    }));
+    pthread_mutex_unlock (&les->lock);
+}
+
+extern void
+lesRemClient (BREthereumLES les,
+              BREthereumLESCallbackContext context) {
+    pthread_mutex_lock (&les->clientsLock);
+    lesStopClient (les, context);
+
+    pthread_mutex_lock (&les->lock);
+    ssize_t clientIndex = lesFindClient (les, context);
+    if (-1 != clientIndex) {
+        BREthereumLESClient client = les->clients[clientIndex];
+        array_rm (les->clients, clientIndex);
+
+        // Drop the client's requests, in reverse as `requests` will have `array_rm()` called.  A
+        // request being handled by a node will have its provision released once the node is done.
+        for (size_t index = array_count (les->requests); index > 0; index--) {
+            BREthereumLESRequest *request = &les->requests[index - 1];
+            BREthereumBoolean owned = (NULL == client.callbackOwnsProvision
+                                       ? AS_ETHEREUM_BOOLEAN (client.context == request->context)
+                                       : client.callbackOwnsProvision (client.context,
+                                                                       request->context,
+                                                                       request->callback));
+            if (ETHEREUM_BOOLEAN_IS_TRUE (owned))
+                lesRemoveRequest (les, index - 1, ETHEREUM_BOOLEAN_TRUE);
+        }
+    }
     pthread_mutex_unlock (&les->lock);
+    pthread_mutex_unlock (&les->clientsLock);
+}
+
+extern void
+lesStartClient (BREthereumLES les,
+                BREthereumLESCallbackContext context) {
+    pthread_mutex_lock (&les->clientsLock);
+
+    pthread_mutex_lock (&les->lock);
+    ssize_t index = lesFindClient (les, context);
+    if (-1 != index) les->clients[index].started = ETHEREUM_BOOLEAN_TRUE;
+    pthread_mutex_unlock (&les->lock);
+
+    if (-1 != index) lesStart (les);
+    pthread_mutex_unlock (&les->clientsLock);
+}
+
+extern void
+lesStopClient (BREthereumLES les,
+               BREthereumLESCallbackContext context) {
+    pthread_mutex_lock (&les->clientsLock);
+
+    pthread_mutex_lock (&les->lock);
+    ssize_t index = lesFindClient (les, context);
+    int stopLES = 0;
+    if (-1 != index && ETHEREUM_BOOLEAN_IS_TRUE (les->clients[index].started)) {
+
+        // If other clients are started, LES keeps running; save nodes for this client alone.
+        // Otherwise stopping LES saves nodes for this, the one started client; it is marked as
+        // stopped only once LES has stopped.
+        if (1 != lesCountStartedClients (les)) {
+            les->clients[index].started = ETHEREUM_BOOLEAN_FALSE;
+            les->clients[index].callbackSaveNodes (les->clients[index].context,
+                                                   lesCreateNodeConfigs (les));
+        }
+        else stopLES = 1;
+    }
+    pthread_mutex_unlock (&les->lock);
+
+    // The LES thread needs `lock` to stop; don't hold it.
+    if (stopLES) {
+        lesStop (les);
+
+        pthread_mutex_lock (&les->lock);
+        index = lesFindClient (les, context);
+        if (-1 != index) les->clients[index].started = ETHEREUM_BOOLEAN_FALSE;
+        pthread_mutex_unlock (&les->lock);
+    }
+    pthread_mutex_unlock (&les->clientsLock);
 }
 
 static BREthereumNode
@@ -825,10 +1387,11 @@ lesHandleStatus (BREthereumLES les,
                  BREthereumNode node,
                  BREthereumHash headHash,
                  uint64_t headNumber) {
-    les->callbackStatus (les->callbackContext,
-                         (BREthereumNodeReference) node,
-                         headHash,
-                         headNumber);
+    for (size_t index = 0; index < array_count (les->clients); index++)
+        les->clients[index].callbackStatus (les->clients[index].context,
+                                            (BREthereumNodeReference) node,
+                                            headHash,
+                                            headNumber);
 }
 
 /**
@@ -851,14 +1414,76 @@ lesHandleAnnounce (BREthereumLES les,
                    uint64_t headNumber,
                    UInt256 headTotalDifficulty,
                    uint64_t reorgDepth) {
-    les->callbackAnnounce (les->callbackContext,
-                           (BREthereumNodeReference) node,
-                           headHash,
-                           headNumber,
-                           headTotalDifficulty,
-                           reorgDepth);
+    for (size_t index = 0; index < array_count (les->clients); index++)
+        les->clients[index].callbackAnnounce (les->clients[index].context,
+                                              (BREthereumNodeReference) node,
+                                              headHash,
+                                              headNumber,
+                                              headTotalDifficulty,
+                                              reorgDepth);
 }
 
+/**
+ * Remove the request at `index`.  If `release` then release the request's provision, unless a
+ * node is handling it; otherwise the provision was passed on.
+ */
+static void
+lesRemoveRequest (BREthereumLES les,
+                  size_t index,
+                  BREthereumBoolean release) {
+    BREthereumLESRequest *request = &les->requests[index];
+
+    if (ETHEREUM_BOOLEAN_IS_TRUE (release))
+        requestRelease (request);
+    else if (NULL != request->split)
+        splitUnreference (request->split);
+
+    array_rm (les->requests, index);
+}
+
+/**
+ * Handle a successful result for a part of a split provision.  Once all the parts are complete,
+ * merge them and invoke the split's callback.
+ */
+static void
+lesHandleProvisionPart (BREthereumLES les,
+                        BREthereumNode node,
+                        size_t index,
+                        OwnershipGiven BREthereumProvisionResult result) {
+    BREthereumLESSplit split = les->requests[index].split;
+    size_t part = les->requests[index].splitIndex;
+
+    // If the split has failed, nobody is waiting on this part.
+    if (ETHEREUM_BOOLEAN_IS_TRUE (split->given))
+        provisionRelease (&result.provision, ETHEREUM_BOOLEAN_TRUE);
+
+    else {
+        // The split now owns the part, along with its results.
+        split->parts[part] = result.provision;
+        split->partsComplete[part] = ETHEREUM_BOOLEAN_TRUE;
+        split->partsRemaining -= 1;
+        split->node = node;
+
+        if (0 == split->partsRemaining) {
+            provisionMerge (&split->provision, split->parts);
+            split->parts = NULL;
+            split->given = ETHEREUM_BOOLEAN_TRUE;
+
+            split->callback (split->context,
+                             les,
+                             split->node,
+                             (BREthereumProvisionResult) {
+                                 split->provision.identifier,
+                                 split->provision.type,
+                                 PROVISION_SUCCESS,
+                                 split->provision,
+                                 { .success = {}}
+                             });
+        }
+    }
+
+    lesRemoveRequest (les, index, ETHEREUM_BOOLEAN_FALSE);
+}
 
 /**
  * Handle a Node's Provision result by invoking the result's callback.  On success, the result
@@ -876,51 +1501,71 @@ lesHandleProvision (BREthereumLES les,
                     OwnershipGiven BREthereumProvisionResult result) {
     // Find the request, invoke the callback on result.
     // TODO: On an error, should the provision be submitted to another node?
-    for (size_t index = 0; index < array_count (les->requests); index++) {
-        BREthereumLESRequest *request = &les->requests[index];
-        // Find the request; there must be one...
-        if (result.identifier == request->provision.identifier)
-            switch (result.status) {
-                case PROVISION_SUCCESS:
-                    // On success, invoke `request->callback`
+    ssize_t index = lesFindRequestForIdentifier (les, result.identifier);
+
+    switch (result.status) {
+        case PROVISION_SUCCESS: {
+            // If there is no request, then it was dropped while `node` was handling it - as the
+            // slower of a request and its twin or as a part of a failed split.  Nobody is waiting
+            // on the result.
+            if (-1 == index) {
+                provisionRelease (&result.provision, ETHEREUM_BOOLEAN_TRUE);
+                return;
+            }
 
-                    // We've passed ownership of the provision, in result.  We can simply
-                    // remove the request (which releases the result but we passed a copy,
-                    // w/ provision and w/ provision references (to hashes, etc)).
+            // The request's twin, if any, lost.
+            BREthereumProvisionIdentifier twin = les->requests[index].twin;
 
-                    request->callback (request->context,
-                                       les,
-                                       node,
-                                       result);
+            if (NULL != les->requests[index].split)
+                lesHandleProvisionPart (les, node, index, result);
 
+            else {
+                // On success, invoke `request->callback`
 
-                    array_rm (les->requests, index);
-                    return;
+                // We've passed ownership of the provision, in result.  We can simply
+                // remove the request (which releases the result but we passed a copy,
+                // w/ provision and w/ provision references (to hashes, etc)).
+                BREthereumLESRequest *request = &les->requests[index];
 
-                case PROVISION_ERROR: {
-                    // The node failed to handle the provision.  We'll deactivate the node
-                    // which will reschedule the provision with another node.
-                    //
-                    // We've taken ownership of the provision, we retain the provision as it will
-                    // be reassigned to another node.
-                    //
-                    // Note that the provision might be filled with some data
-                    provisionReleaseResults (&request->provision);
+                request->callback (request->context,
+                                   les,
+                                   node,
+                                   result);
 
-                    // Provide an explanation.
-                    char explanation[256];
-                    sprintf (explanation, "Provision Error: %s, Type: %s",
-                             provisionErrorGetReasonName(result.u.error.reason),
-                             provisionGetTypeName(result.type));
-
-                    lesDeactivateNode (les, NODE_ROUTE_TCP, node, explanation);
-                    return;
-                }
+                array_rm (les->requests, index);
             }
-    }
 
-    // We totally missed the request for result
-    assert (0);
+            // Drop the twin; if `node` is handling it, the node will release the provision.
+            ssize_t twinIndex = (PROVISION_IDENTIFIER_UNDEFINED == twin
+                                 ? -1
+                                 : lesFindRequestForIdentifier (les, twin));
+            if (-1 != twinIndex)
+                lesRemoveRequest (les, twinIndex, ETHEREUM_BOOLEAN_TRUE);
+            return;
+        }
+
+        case PROVISION_ERROR: {
+            // The node failed to handle the provision.  We'll deactivate the node
+            // which will reschedule the provision with another node.
+            //
+            // We've taken ownership of the provision, we retain the provision as it will
+            // be reassigned to another node.  If the request was dropped, deactivating the
+            // node will release the provision.
+            //
+            // Note that the provision might be filled with some data
+            if (-1 != index)
+                provisionReleaseResults (&les->requests[index].provision);
+
+            // Provide an explanation.
+            char explanation[256];
+            sprintf (explanation, "Provision Error: %s, Type: %s",
+                     provisionErrorGetReasonName(result.u.error.reason),
+                     provisionGetTypeName(result.type));
+
+            lesDeactivateNode (les, NODE_ROUTE_TCP, node, explanation);
+            return;
+        }
+    }
 }
 
 /**
@@ -957,6 +1602,275 @@ lesHandleNeighbor (BREthereumLES les,
     nodeSetDiscovered(node, ETHEREUM_BOOLEAN_TRUE);
 }
 
+/// MARK: - LES Schedule
+
+static double
+lesScheduleGetTime (void) {
+    struct timeval now;
+    gettimeofday (&now, NULL);
+    return (double) now.tv_sec + 1e-6 * (double) now.tv_usec;
+}
+
+/**
+ * Estimate the time, in seconds, for a node with `load` to complete `provision` - once the node's
+ * pending provisions have been handled.
+ */
+static double
+lesScheduleExpectedTime (BREthereumNodeLoad load,
+                         BREthereumProvision *provision) {
+    double latency    = (0.0 != load.latency    ? load.latency    : LES_SCHEDULE_DEFAULT_LATENCY);
+    double throughput = (0.0 != load.throughput ? load.throughput : LES_SCHEDULE_DEFAULT_THROUGHPUT);
+
+    size_t count = provisionGetCount (provision);
+    size_t limit = messageLESSpecs [provisionGetMessageLESIdentifier (provision->type)].limit;
+    size_t messagesCount = (0 == limit || 0 == count ? 1 : (count + limit - 1) / limit);
+
+    double messagesTime = latency * messagesCount;
+    double itemsTime    = count / throughput;
+
+    return latency * load.provisionsCount + (messagesTime > itemsTime ? messagesTime : itemsTime);
+}
+
+/**
+ * Check if `node` can take on `provision` now: the node is connected, has fewer than
+ * `provisionsLimit` pending provisions and has the credits for `provision`.  An idle node always
+ * has the credits - its buffer recharges while the first messages are answered.
+ */
+static BREthereumBoolean
+lesScheduleNodeIsEligible (BREthereumNode node,
+                           BREthereumNodeLoad load,
+                           BREthereumProvision *provision,
+                           size_t provisionsLimit) {
+    return AS_ETHEREUM_BOOLEAN (nodeHasState (node, NODE_ROUTE_TCP, NODE_CONNECTED) &&
+                                load.provisionsCount < provisionsLimit &&
+                                (0 == load.provisionsCount ||
+                                 load.credits >= nodeGetProvisionCost (node, provision)));
+}
+
+/**
+ * Select the eligible node, other than `exclude`, expected to complete `provision` first.  Fills
+ * `expected` with that node's expected time.  Returns NULL if no node is eligible.
+ */
+static BREthereumNode
+lesScheduleSelectNode (BREthereumLES les,
+                       BREthereumProvision *provision,
+                       BREthereumNode exclude,
+                       size_t provisionsLimit,
+                       double *expected) {
+    BREthereumNode selected = NULL;
+    BRArrayOf(BREthereumNode) nodes = les->activeNodesByRoute[NODE_ROUTE_TCP];
+
+    for (size_t index = 0; index < array_count (nodes); index++) {
+        BREthereumNode node = nodes[index];
+        BREthereumNodeLoad load = nodeGetLoad (node);
+
+        if (node == exclude ||
+            ETHEREUM_BOOLEAN_IS_FALSE (lesScheduleNodeIsEligible (node, load, provision, provisionsLimit)))
+            continue;
+
+        double time = lesScheduleExpectedTime (load, provision);
+        if (NULL == selected || time < *expected) {
+            selected  = node;
+            *expected = time;
+        }
+    }
+    return selected;
+}
+
+/**
+ * Assign the request at `index` to `node`, which is expected to take `expected` seconds.
+ */
+static void
+lesScheduleAssign (BREthereumLES les,
+                   size_t index,
+                   BREthereumNode node,
+                   double expected,
+                   double now) {
+    BREthereumLESRequest *request = &les->requests[index];
+
+    double slow = LES_SCHEDULE_SLOW_FACTOR * expected;
+    request->node     = node;
+    request->deadline = now + (slow > LES_SCHEDULE_SLOW_MINIMUM_IN_SECONDS ? slow : LES_SCHEDULE_SLOW_MINIMUM_IN_SECONDS);
+
+    // See the lesThread() comments on sharing the provision memory w/ `node`.
+    nodeHandleProvision (node, request->provision);
+}
+
+/**
+ * Split the provision of the request at `index` across the eligible nodes if the provision needs
+ * several messages and several nodes can help.  Every part requests at least one message's worth
+ * of items; the other items are shared in proportion to each node's throughput.  The request at
+ * `index` becomes the first part; the other parts are appended to `les->requests`.  All parts are
+ * assigned.
+ *
+ * @return TRUE if split; otherwise FALSE with the request unchanged.
+ */
+static BREthereumBoolean
+lesScheduleSplit (BREthereumLES les,
+                  size_t index,
+                  double now) {
+    BREthereumLESRequest request = les->requests[index];
+
+    if (NULL != request.split ||
+        PROVISION_IDENTIFIER_UNDEFINED != request.twin ||
+        ETHEREUM_BOOLEAN_IS_FALSE (provisionIsSplittable (&request.provision)))
+        return ETHEREUM_BOOLEAN_FALSE;
+
+    size_t count = provisionGetCount (&request.provision);
+    size_t limit = messageLESSpecs [provisionGetMessageLESIdentifier (request.provision.type)].limit;
+    if (0 == limit || count < 2 * limit) return ETHEREUM_BOOLEAN_FALSE;
+
+    // Find the eligible nodes, at most one for each message.
+    BRArrayOf(BREthereumNode) activeNodes = les->activeNodesByRoute[NODE_ROUTE_TCP];
+    size_t nodesLimit = count / limit;
+
+    size_t nodesCount = 0;
+    BREthereumNode nodes [array_count (activeNodes)];
+    double weights [array_count (activeNodes)];
+    double weightsTotal = 0.0;
+
+    for (size_t ni = 0; ni < array_count (activeNodes) && nodesCount < nodesLimit; ni++) {
+        BREthereumNodeLoad load = nodeGetLoad (activeNodes[ni]);
+        if (ETHEREUM_BOOLEAN_IS_TRUE (lesScheduleNodeIsEligible (activeNodes[ni], load, &request.provision,
+                                                                 LES_SCHEDULE_NODE_PROVISIONS_LIMIT))) {
+            nodes   [nodesCount] = activeNodes[ni];
+            weights [nodesCount] = (0.0 != load.throughput ? load.throughput : LES_SCHEDULE_DEFAULT_THROUGHPUT);
+            weightsTotal += weights[nodesCount];
+            nodesCount += 1;
+        }
+    }
+    if (nodesCount < 2) return ETHEREUM_BOOLEAN_FALSE;
+
+    // Size the parts; the last part takes whatever remains after rounding down.
+    size_t sizes [nodesCount];
+    size_t shared = count - nodesCount * limit;
+    size_t sharedAssigned = 0;
+
+    for (size_t pi = 0; pi < nodesCount; pi++) {
+        size_t extra = (pi + 1 == nodesCount
+                        ? shared - sharedAssigned
+                        : (size_t) (shared * (weights[pi] / weightsTotal)));
+        sizes[pi] = limit + extra;
+        sharedAssigned += extra;
+    }
+
+    BREthereumLESSplit split = calloc (1, sizeof (BREthereumLESSplitRecord));
+    split->context  = request.context;
+    split->callback = request.callback;
+    split->provision = request.provision;
+    split->parts = provisionSplit (&request.provision, nodesCount, sizes);
+    split->partsComplete = calloc (nodesCount, sizeof (BREthereumBoolean));
+    for (size_t pi = 0; pi < nodesCount; pi++)
+        split->partsComplete[pi] = ETHEREUM_BOOLEAN_FALSE;
+    split->partsRemaining = nodesCount;
+    split->node = NULL;
+    split->requestsCount  = nodesCount;
+    split->given = ETHEREUM_BOOLEAN_FALSE;
+
+    eth_log (LES_LOG_TOPIC, "Schd: %s (%zu) split into %zu parts",
+             provisionGetTypeName (request.provision.type),
+             count,
+             nodesCount);
+
+    for (size_t pi = 0; pi < nodesCount; pi++) {
+        split->parts[pi].identifier = les->requestsIdentifier++;
+
+        BREthereumLESRequest part = request;
+        part.provision  = split->parts[pi];
+        part.node       = NULL;
+        part.split      = split;
+        part.splitIndex = pi;
+
+        size_t partIndex = index;
+        if (0 == pi) les->requests[index] = part;
+        else {
+            partIndex = array_count (les->requests);
+            array_add (les->requests, part);
+        }
+
+        lesScheduleAssign (les, partIndex, nodes[pi],
+                           lesScheduleExpectedTime (nodeGetLoad (nodes[pi]), &part.provision),
+                           now);
+    }
+
+    return ETHEREUM_BOOLEAN_TRUE;
+}
+
+/**
+ * Schedule the request at `index`, which any node can handle, on the node expected to complete it
+ * first - possibly splitting it across several nodes.  If no node is eligible now, the request
+ * remains pending.
+ *
+ * @return FALSE if the request must fail, because there are no active nodes or because the
+ * request is a part of a split that has already failed; otherwise TRUE.
+ */
+static BREthereumBoolean
+lesScheduleRequest (BREthereumLES les,
+                    size_t index) {
+    BREthereumLESSplit split = les->requests[index].split;
+
+    if ((NULL != split && ETHEREUM_BOOLEAN_IS_TRUE (split->given)) ||
+        0 == array_count (les->activeNodesByRoute[NODE_ROUTE_TCP]))
+        return ETHEREUM_BOOLEAN_FALSE;
+
+    double now = lesScheduleGetTime ();
+
+    if (ETHEREUM_BOOLEAN_IS_FALSE (lesScheduleSplit (les, index, now))) {
+        double expected;
+        BREthereumNode node = lesScheduleSelectNode (les, &les->requests[index].provision, NULL,
+                                                     LES_SCHEDULE_NODE_PROVISIONS_LIMIT,
+                                                     &expected);
+        if (NULL != node)
+            lesScheduleAssign (les, index, node, expected, now);
+    }
+
+    return ETHEREUM_BOOLEAN_TRUE;
+}
+
+/**
+ * Re-issue slow requests, which any node can handle, to an idle node.  The re-issued request is a
+ * twin of the slow request; the first of the two to complete wins and the other is dropped.
+ */
+static void
+lesScheduleReissue (BREthereumLES les) {
+    double now = lesScheduleGetTime ();
+
+    // Twins are appended; there is no need to look at them.
+    size_t requestsCount = array_count (les->requests);
+
+    for (size_t index = 0; index < requestsCount; index++) {
+        BREthereumLESRequest *request = &les->requests[index];
+
+        if (ETHEREUM_BOOLEAN_IS_FALSE (request->anyNode) ||
+            NULL == request->node ||
+            PROVISION_IDENTIFIER_UNDEFINED != request->twin ||
+            now < request->deadline)
+            continue;
+
+        double expected;
+        BREthereumNode node = lesScheduleSelectNode (les, &request->provision, request->node, 1, &expected);
+        if (NULL == node) continue;
+
+        BREthereumLESRequest twin = *request;
+        twin.provision = provisionCopy (&request->provision, ETHEREUM_BOOLEAN_FALSE);
+        twin.provision.identifier = les->requestsIdentifier++;
+        twin.node = NULL;
+        twin.twin = request->provision.identifier;
+        if (NULL != twin.split) twin.split->requestsCount += 1;
+
+        request->twin = twin.provision.identifier;
+
+        eth_log (LES_LOG_TOPIC, "Schd: %s (%zu) reissued, slow %s",
+                 provisionGetTypeName (twin.provision.type),
+                 provisionGetCount (&twin.provision),
+                 nodeEndpointGetHostname (nodeGetRemoteEndpoint (request->node)));
+
+        // Note: `request` is invalid once `twin` is added.
+        array_add (les->requests, twin);
+        lesScheduleAssign (les, array_count (les->requests) - 1, node, expected, now);
+    }
+}
+
 /// MARK: - LES (Main) Thread
 
 static void
@@ -989,15 +1903,22 @@ lesDeactivateNodeAtIndex (BREthereumLES les,
     array_rm (nodes, index);
     lesLogNodeActivate(les, node, route, explain, "<=|=>");
 
+#if defined (LES_POLL_EPOLL)
+    lesPollRemove (les, node, route);
+#endif
+
     // Reassign provisions back as requests if this is a TCP route
     if (NODE_ROUTE_TCP == route) {
         BRArrayOf(BREthereumProvision) provisions = nodeUnhandleProvisions(node);
         for (size_t pi = 0; pi < array_count(provisions); pi++) {
             ssize_t requestIndex = lesFindRequestForProvision (les, &provisions[pi]);
-            assert (-1 != requestIndex);
 
-            // This reestablishes the provision as needing to be assigned.
-            les->requests[requestIndex].node = NULL;
+            // This reestablishes the provision as needing to be assigned.  If there is no
+            // request, it was dropped while the node was handling it; release the provision.
+            if (-1 != requestIndex)
+                les->requests[requestIndex].node = NULL;
+            else
+                provisionRelease (&provisions[pi], ETHEREUM_BOOLEAN_TRUE);
         }
         array_free(provisions);
     }
@@ -1066,11 +1987,13 @@ static void
 lesSeedQueryAllThreaded (BREthereumLES les) {
     pthread_t thread;
 
+    // Joinable, not detached; lesRelease() joins the thread before `les` is freed.
     pthread_attr_t attr;
     pthread_attr_init (&attr);
-    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
     pthread_attr_setstacksize (&attr, 1024 * 1024);
-    pthread_create (&thread, &attr, (ThreadRoutine) lesSeedQueryAll, les);
+    if (0 == pthread_create (&thread, &attr, (ThreadRoutine) lesSeedQueryAll, les))
+        les->seedThread = thread;
     pthread_attr_destroy(&attr);
 }
 #endif
@@ -1138,16 +2061,29 @@ lesThreadBootstrapSeeds (BREthereumLES les) {
     }
 }
 
+/**
+ * Create configs based on the current nodes - in particular each node's state.  When we load
+ * these configs (see lesCreate()) many of the node states will be remapped to 'NODE_AVAILABLE'
+ */
+static BRArrayOf(BREthereumNodeConfig)
+lesCreateNodeConfigs (BREthereumLES les) {
+    BRArrayOf(BREthereumNodeConfig) configs;
+    array_new (configs, BRSetCount(les->nodes));
+    FOR_NODES (les, node)
+        array_add (configs, nodeConfigCreate(node));
+    return configs;
+}
+
 static void *
 lesThread (BREthereumLES les) {
     pthread_setname_brd (les->thread, LES_THREAD_NAME);
 
-    // TODO: Don't timeout pselect(); get some 'wakeup descriptor'
-    struct timespec timeout = { 0, 250000000 }; // .250 seconds
-
-    //
+    // The node sockets ready to read and to write, as filled by lesPollWait().
     fd_set readDescriptors, writeDesciptors;
-    int maximumDescriptor = -1;
+
+    // When we last handled 'idle' work; see below.
+    struct timeval idleTime;
+    gettimeofday (&idleTime, NULL);
 
     // See CORE-260: the process of finding seeds, using DNS TXT fields, can take a while.
     // So, we moved it out of lesCreate() here, in lesThread().
@@ -1209,6 +2145,13 @@ lesThread (BREthereumLES les) {
             if (NULL == les->requests[index].node) {
                 BREthereumNodeReference nodeRef = les->requests[index].nodeReference;
 
+                // A request that any node can handle is scheduled over all the connected nodes.
+                if (ETHEREUM_BOOLEAN_IS_TRUE (les->requests[index].anyNode)) {
+                    if (ETHEREUM_BOOLEAN_IS_FALSE (lesScheduleRequest (les, index)))
+                        requestsToFail[requestsToFailCount++] = index;
+                    continue;
+                }
+
                 // We require all arbitary references to have been resolved when the
                 // provision was added as a request.  An `arbitary` reference is something like
                 // NODE_REFERENCE_{ANY,ALL} where the request did not specify a specific node
@@ -1278,45 +2221,81 @@ lesThread (BREthereumLES les) {
         for (size_t index = 0; index < requestsToFailCount; index++) {
             size_t requestIndex = requestsToFail[index];
             BREthereumLESRequest *request = &les->requests[requestIndex];
+            BREthereumLESSplit split = request->split;
 
-            request->callback (request->context,
-                               les,
-                               request->nodeReference,
-                               (BREthereumProvisionResult) {
-                                   request->provision.identifier,
-                                   request->provision.type,
-                                   PROVISION_ERROR,
-                                   request->provision,
-                                   { .error = { PROVISION_ERROR_NODE_INACTIVE }}
-                               });
+            ssize_t twinIndex = (PROVISION_IDENTIFIER_UNDEFINED == request->twin
+                                 ? -1
+                                 : lesFindRequestForIdentifier (les, request->twin));
+
+            // If the request has a twin, then the twin alone fails.
+            if (-1 != twinIndex) {
+                les->requests[twinIndex].twin = PROVISION_IDENTIFIER_UNDEFINED;
+                requestRelease (request);
+            }
+
+            // If the request is a part, then the split fails - but only once.
+            else if (NULL != split) {
+                if (ETHEREUM_BOOLEAN_IS_FALSE (split->given)) {
+                    split->given = ETHEREUM_BOOLEAN_TRUE;
+                    split->callback (split->context,
+                                     les,
+                                     request->nodeReference,
+                                     (BREthereumProvisionResult) {
+                                         split->provision.identifier,
+                                         split->provision.type,
+                                         PROVISION_ERROR,
+                                         split->provision,
+                                         { .error = { PROVISION_ERROR_NODE_INACTIVE }}
+                                     });
+                }
+                // The callback may have added requests; `request` might be invalid.
+                requestRelease (&les->requests[requestIndex]);
+            }
+
+            else
+                request->callback (request->context,
+                                   les,
+                                   request->nodeReference,
+                                   (BREthereumProvisionResult) {
+                                       request->provision.identifier,
+                                       request->provision.type,
+                                       PROVISION_ERROR,
+                                       request->provision,
+                                       { .error = { PROVISION_ERROR_NODE_INACTIVE }}
+                                   });
         }
 
         // ... and then remove them in reverse order.
         for (ssize_t index = requestsToFailCount - 1; index >= 0; index--)
             array_rm (les->requests, requestsToFail[index]);
 
+        // Re-issue any slow requests to idle nodes.
+        lesScheduleReissue (les);
+
         //
-        // Update the read (and write) descriptors to include nodes that are 'active' on any route.
+        // Wait on the sockets of nodes that are 'active' on any route.  A new request, or any
+        // of the 'time is now' flags, wakes us up immediately.  Note: lesPollWait() releases
+        // `les->lock` while waiting.
         //
-        maximumDescriptor = -1;
-        FD_ZERO (&readDescriptors);
-        FD_ZERO (&writeDesciptors);
+        int woken;
+        int selectCount = lesPollWait (les, &readDescriptors, &writeDesciptors,
+                                       LES_THREAD_IDLE_TIMEOUT_IN_MILLISECONDS,
+                                       &woken);
+        if (les->theTimeToQuitIsNow) continue;
 
-        FOR_EACH_ROUTE(route) {
-            BRArrayOf(BREthereumNode) nodes = les->activeNodesByRoute[route];
-            for (size_t index = 0; index < array_count(nodes); index++)
-                maximumDescriptor = maximum (maximumDescriptor,
-                                             nodeUpdateDescriptors (nodes[index],
-                                                                    route,
-                                                                    &readDescriptors,
-                                                                    &writeDesciptors));
+        // We are 'idle' on a timeout.  If we were only woken up then no node is ready and we'll
+        // just loop to handle the new requests - unless it is past time for the 'idle' work; a
+        // steady stream of requests must not stop us from discovering and connecting to nodes.
+        int isIdle = 0;
+        if (0 == selectCount) {
+            struct timeval idleNow;
+            gettimeofday (&idleNow, NULL);
+            long idleMilliseconds = (1000 * (idleNow.tv_sec  - idleTime.tv_sec) +
+                                     (idleNow.tv_usec - idleTime.tv_usec) / 1000);
+            isIdle = !woken || idleMilliseconds >= LES_THREAD_IDLE_TIMEOUT_IN_MILLISECONDS;
+            if (isIdle) idleTime = idleNow;
         }
 
-        pthread_mutex_unlock (&les->lock);
-        int selectCount = pselect (1 + maximumDescriptor, &readDescriptors, &writeDesciptors, NULL, &timeout, NULL);
-        pthread_mutex_lock (&les->lock);
-        if (les->theTimeToQuitIsNow) continue;
-
         // We've been asked to 'clean' - which means 'reclaim memory if possible'.  We'll ask
         // all nodes to clean up; but, only the active ones will have much to do.
         if (les->theTimeToCleanIsNow) {
@@ -1395,7 +2374,7 @@ lesThread (BREthereumLES les) {
         //
         // or we have a timeout ... nothing to receive; nothing to send
         //
-        else if (selectCount == 0) {
+        else if (isIdle) {
 
             // If we don't have enough availableNodes, try to discover some
             if (ETHEREUM_BOOLEAN_IS_TRUE(les->discoverNodes) &&
@@ -1481,9 +2460,9 @@ lesThread (BREthereumLES les) {
         }
 
         //
-        // or we have an pselect() error.
+        // or we have a lesPollWait() error.
         //
-        else lesHandleSelectError (les, errno);
+        else if (selectCount < 0) lesHandleSelectError (les, errno);
 
         // double check that everything has been handled.
         assert (0 == array_count(nodesToRemove));
@@ -1498,14 +2477,13 @@ lesThread (BREthereumLES les) {
              array_count (les->activeNodesByRoute[NODE_ROUTE_UDP]),
              array_count (les->activeNodesByRoute[NODE_ROUTE_TCP]));
 
-    // Callback on Node Config.  Create the set of configs based on the current node -in
-    // particular the node's state.  When we load these configs (see lesCreate()) many of the
-    // node states will be remapped to 'NODE_AVAILABLE'
-    BRArrayOf(BREthereumNodeConfig) configs;
-    array_new (configs, BRSetCount(les->nodes));
-    FOR_NODES (les, node)
-        array_add (configs, nodeConfigCreate(node));
-    les->callbackSaveNodes (les->callbackContext, configs);
+    // Callback on Node Config, for every started client - those stopped earlier saved nodes when
+    // they stopped.  If no client is started, LES was started with lesStart(); use every client.
+    size_t startedClients = lesCountStartedClients (les);
+    for (size_t index = 0; index < array_count (les->clients); index++)
+        if (0 == startedClients || ETHEREUM_BOOLEAN_IS_TRUE (les->clients[index].started))
+            les->clients[index].callbackSaveNodes (les->clients[index].context,
+                                                   lesCreateNodeConfigs (les));
 
     // Disconnect all active nodes
     FOR_EACH_ROUTE(route) {
@@ -1560,11 +2538,15 @@ lesThread (BREthereumLES les) {
 static void
 lesAddRequestSpecifically (BREthereumLES les,
                            BREthereumNodeReference node,
+                           BREthereumBoolean anyNode,
                            BREthereumLESProvisionContext context,
                            BREthereumLESProvisionCallback callback,
                            OwnershipGiven BREthereumProvision provision) {
     provision.identifier = les->requestsIdentifier++;
-    BREthereumLESRequest request = { context, callback, provision, node, NULL };
+    BREthereumLESRequest request = {
+        context, callback, provision, node, NULL,
+        anyNode, 0.0, PROVISION_IDENTIFIER_UNDEFINED, NULL, 0
+    };
     array_add (les->requests, request);
 }
 
@@ -1585,23 +2567,29 @@ lesAddRequest (BREthereumLES les,
                OwnershipGiven BREthereumProvision provision) {
     assert (PROVISION_IDENTIFIER_UNDEFINED == provision.identifier);
 
+    BREthereumBoolean anyNode = AS_ETHEREUM_BOOLEAN (NODE_REFERENCE_NIL == node ||
+                                                     NODE_REFERENCE_ANY == node);
+
     if (NODE_REFERENCE_NIL == node) node = NODE_REFERENCE_0;
     if (NODE_REFERENCE_ANY == node) node = NODE_REFERENCE_0;
 
     pthread_mutex_lock (&les->lock);
     if (NODE_REFERENCE_ALL != node)
-        lesAddRequestSpecifically (les, node, context, callback, provision);
+        lesAddRequestSpecifically (les, node, anyNode, context, callback, provision);
     else {
         // We'll make NODE_REFERENCE_MAX - NODE_REFERENCE_MIN specific requests.  Since we have at
         // most LES_ACTIVE_NODE_COUNT active nodes, we might not get (MAX - MIN) actual requests
         // but only as many as the number of active nodes.  See ACTIVE_NODE above (which might
         // discard node reference over the active nodes).
         for (BREthereumNodeReference ns = NODE_REFERENCE_MIN; ns <= NODE_REFERENCE_MAX; ns++)
-            lesAddRequestSpecifically (les, ns, context, callback,
+            lesAddRequestSpecifically (les, ns, ETHEREUM_BOOLEAN_FALSE, context, callback,
                                        provisionCopy (&provision, ETHEREUM_BOOLEAN_FALSE));
         // Handle `OwnershipGiven`
         provisionRelease (&provision, ETHEREUM_BOOLEAN_TRUE);
     }
+
+    // Have lesThread() assign the request to a node now; don't wait on the node sockets.
+    lesWakeupSignal (les);
     pthread_mutex_unlock (&les->lock);
 }
 
@@ -1614,6 +2602,15 @@ lesFindRequestForProvision (BREthereumLES les,
     return -1;
 }
 
+static ssize_t
+lesFindRequestForIdentifier (BREthereumLES les,
+                             BREthereumProvisionIdentifier identifier) {
+    for (ssize_t index = 0; index < array_count (les->requests); index++)
+        if (identifier == les->requests[index].provision.identifier)
+            return index;
+    return -1;
+}
+
 static BRArrayOf(BREthereumHash)
 lesCreateHashArray (BREthereumLES les,
                     BREthereumHash hash) {
@@ -192,11 +192,21 @@ lesCreate (BREthereumNetwork network,
            BREthereumBoolean discoverNodes,
            BREthereumBoolean handleSync);
 
+/*!
+ * @function lesTake
+ *
+ * @abstract
+ * Take a reference to `les`.  A LES may be shared, such as by all the BCS instances on one
+ * network, with each holding a reference.
+ */
+extern BREthereumLES
+lesTake (BREthereumLES les);
+
 /*!
  * @function lesRelease
  *
  * @abstract
- * Releases the les context
+ * Releases a reference to the les context; on the last reference, stop and release the context
  */
 extern void
 lesRelease(BREthereumLES les);
@@ -210,6 +220,10 @@ lesStop (BREthereumLES les);
 extern void
 lesClean (BREthereumLES les);
 
+/**
+ * Update the block head that LES announces to nodes.  If LES has more than one client, then the
+ * head only advances - the clients' chains may lag one another.
+ */
 extern void
 lesUpdateBlockHead (BREthereumLES les,
                     BREthereumHash headHash,
@@ -237,6 +251,58 @@ typedef void
                                    BREthereumNodeReference node,
                                    BREthereumProvisionResult result);
 
+/// MARK: LES Clients
+
+/**
+ * The callback to identify a client's provisions.  Return TRUE if a provision requested with
+ * `provisionContext` and `provisionCallback` was requested by the client with `context`.
+ */
+typedef BREthereumBoolean
+(*BREthereumLESCallbackOwnsProvision) (BREthereumLESCallbackContext context,
+                                       BREthereumLESProvisionContext provisionContext,
+                                       BREthereumLESProvisionCallback provisionCallback);
+
+/**
+ * Add a client to `les`.  A LES has one pool of nodes but any number of clients; every client is
+ * invoked on each node 'Announce' and 'Status' and on saving nodes.  If `lesCreate()` was passed
+ * a non-NULL `callbackContext` then that is the first client.
+ *
+ * If `ownsProvision` is NULL, then the client's provisions are those with a `provisionContext`
+ * of `context`.
+ */
+extern void
+lesAddClient (BREthereumLES les,
+              BREthereumLESCallbackContext context,
+              BREthereumLESCallbackAnnounce callbackAnnounce,
+              BREthereumLESCallbackStatus callbackStatus,
+              BREthereumLESCallbackSaveNodes callbackSaveNodes,
+              BREthereumLESCallbackOwnsProvision callbackOwnsProvision);
+
+/**
+ * Remove the client with `context` from `les`.  The client is stopped, if needed, and all of the
+ * client's pending provisions are dropped - their callbacks will not be invoked.
+ */
+extern void
+lesRemClient (BREthereumLES les,
+              BREthereumLESCallbackContext context);
+
+/**
+ * Start the client with `context`.  LES runs as long as any client is started; thus this starts
+ * LES if it is not already running.
+ */
+extern void
+lesStartClient (BREthereumLES les,
+                BREthereumLESCallbackContext context);
+
+/**
+ * Stop the client with `context`.  If this was the last started client, LES is stopped; otherwise
+ * LES keeps running.  Either way only this client is asked to save the current nodes - a client
+ * stopped earlier is not asked again when LES stops.
+ */
+extern void
+lesStopClient (BREthereumLES les,
+               BREthereumLESCallbackContext context);
+
 /*!
  * @function lesProvideBlockHeaders
  *
@@ -362,7 +362,12 @@ void frameCoderRelease(BREthereumLESFrameCoder fcoder) {
     free(fcoder);
 }
 
-void frameCoderEncrypt(BREthereumLESFrameCoder fCoder, uint8_t* payload, size_t payloadSize, uint8_t** rlpBytes, size_t * rlpBytesSize) {
+size_t frameCoderGetFrameSize(size_t payloadSize) {
+    size_t payloadPadding = (16 - (payloadSize % 16)) % 16;
+    return 32 + payloadSize + payloadPadding + 16; // header_cipher + headerMac + payload + padding + frameMac
+}
+
+void frameCoderEncryptFrame(BREthereumLESFrameCoder fCoder, uint8_t* oBytes, size_t payloadSize) {
 
     uint8_t headerPlain[HEADER_LEN] = {(uint8_t)((payloadSize >> 16) & 0xff), (uint8_t)((payloadSize >> 8) & 0xff), (uint8_t)(payloadSize & 0xff), 0xc2, 0x80, 0x80, 0};
     
@@ -388,28 +393,21 @@ void frameCoderEncrypt(BREthereumLESFrameCoder fCoder, uint8_t* payload, size_t
     uint8_t headerMac[16];
     memcpy(headerMac, egressDigest, 16);
 
-    //Allocate the oBytes and oBytesSize
     size_t payloadPadding = (16 - (payloadSize % 16)) % 16;
-    size_t oBytesSize = 32 + payloadSize + payloadPadding + 16; // header_cipher + headerMac + payload + padding + frameMac
-    
-    uint8_t * oBytes = (uint8_t*)malloc(oBytesSize);
 
     memcpy(oBytes, headerCipher, HEADER_LEN);
     memcpy(&oBytes[HEADER_LEN], headerMac, HEADER_LEN);
     
+    // The payload is already in place; pad it and then encrypt it in place.
     uint8_t * frameCipher = &oBytes[32];
-    
-    // TODO: Need AES-CTRL encryption to frameCipher
-    uint8_t frameData[payloadPadding + payloadSize];
     size_t frameDataSize = payloadPadding + payloadSize;
-    memcpy(frameData, payload, payloadSize);
-    
+
     if(payloadPadding){
-        memset(&frameData[payloadSize], 0, payloadPadding);
+        memset(&frameCipher[payloadSize], 0, payloadPadding);
     }
     
     fCoder->aesEncryptCipherLen += frameDataSize;
-    BRAESCTR_OFFSET(frameCipher, frameDataSize, fCoder->aesEncryptKey, 32, fCoder->ivEnc.u8, frameData, fCoder->aesEncryptCipherLen);
+    BRAESCTR_OFFSET(frameCipher, frameDataSize, fCoder->aesEncryptKey, 32, fCoder->ivEnc.u8, frameCipher, fCoder->aesEncryptCipherLen);
     
     keccak_update(fCoder->egressMac, frameCipher, payloadSize + payloadPadding);
     
@@ -427,7 +425,17 @@ void frameCoderEncrypt(BREthereumLESFrameCoder fCoder, uint8_t* payload, size_t
     keccak_digest(fCoder->egressMac, egressDigest);
 
     memcpy(&oBytes[32 + payloadSize + payloadPadding],egressDigest, 16);
-    
+}
+
+void frameCoderEncrypt(BREthereumLESFrameCoder fCoder, uint8_t* payload, size_t payloadSize, uint8_t** rlpBytes, size_t * rlpBytesSize) {
+
+    //Allocate the oBytes and oBytesSize
+    size_t oBytesSize = frameCoderGetFrameSize(payloadSize);
+    uint8_t * oBytes = (uint8_t*)malloc(oBytesSize);
+
+    memcpy(&oBytes[32], payload, payloadSize);
+    frameCoderEncryptFrame(fCoder, oBytes, payloadSize);
+
     *rlpBytes = oBytes;
     *rlpBytesSize = oBytesSize;
     
@@ -75,6 +75,21 @@ extern void frameCoderRelease(BREthereumLESFrameCoder coder);
  */
  extern void frameCoderEncrypt(BREthereumLESFrameCoder fCoder, uint8_t* payload, size_t payloadSize, uint8_t** rlpBytes, size_t * rlpBytesSize);
 
+/**
+ * The size in bytes of an encrypted packet for a payload of `payloadSize` bytes
+ * @param payloadSize - the size in bytes of the payload
+ */
+ extern size_t frameCoderGetFrameSize(size_t payloadSize);
+
+/**
+ * Encrypts a single packet, in place, that will be passed on the ethereum network
+ * @param fCoder - the frame coder context
+ * @param frame - frameCoderGetFrameSize() bytes holding the payload at offset 32; on return
+ *                holds the encrypted packet
+ * @param payloadSize - the size in bytes of the payload
+ */
+ extern void frameCoderEncryptFrame(BREthereumLESFrameCoder fCoder, uint8_t* frame, size_t payloadSize);
+
 /**
  * Authenticates and decrypts the header from a packet
  * @param fCoder - the frame coder context
@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/time.h>
 #include <pthread.h>
 #include <arpa/inet.h>
 #include <errno.h>
@@ -68,6 +69,9 @@ nodeSend (BREthereumNode node,
 #define DEFAULT_NODE_TIMEOUT_IN_SECONDS       (10)
 #define DEFAULT_NODE_TIMEOUT_IN_SECONDS_RECV  (60)      // 1 minute
 
+// The weight of a new sample in the smoothed node latency and throughput.
+#define NODE_PERFORMANCE_WEIGHT     (0.25)
+
 //
 // Frame Coder Stuff
 //
@@ -311,6 +315,12 @@ typedef struct {
     /** Time of creation */
     long timestamp;
 
+    /** Time, in seconds, that the first message was sent */
+    double sendTime;
+
+    /** The estimated credits used by messages sent but not yet answered */
+    uint64_t creditsPending;
+
     BREthereumProvisionStatus status;
 
     /** The messages needed to complete the provision.  These may be LES (for GETH) or PIP (for
@@ -336,8 +346,18 @@ provisionerMessageOfInterest (BREthereumNodeProvisioner *provisioner,
             messageIdentifier < (provisioner->messageIdentifier + provisioner->messagesCount));
 }
 
+static double
+nodeGetTime (void) {
+    struct timeval now;
+    gettimeofday (&now, NULL);
+    return (double) now.tv_sec + 1e-6 * (double) now.tv_usec;
+}
+
 static BREthereumNodeStatus
 provisionerMessageSend (BREthereumNodeProvisioner *provisioner) {
+    if (provisioner->messagesRemainingCount == provisioner->messagesCount)
+        provisioner->sendTime = nodeGetTime();
+
     BREthereumMessage message = provisioner->messages [provisioner->messagesCount -
                                                        provisioner->messagesRemainingCount];
     BREthereumNodeStatus status = nodeSend (provisioner->node, NODE_ROUTE_TCP, message);
@@ -488,6 +508,23 @@ struct BREthereumNodeRecord {
     /** Credit remaining (if not zero) */
     uint64_t credits;
 
+    /** Flow control, from the remote status: the buffer limit (BL), as the maximum credits, and
+     * the recharge rate (MRR), as credits per millisecond.  If `creditsLimit` is zero, then the
+     * remote did not announce flow control. */
+    uint64_t creditsLimit;
+    uint64_t creditsRecharge;
+
+    /** Time, in seconds, that `credits` was reported */
+    double creditsTime;
+
+    /** Smoothed time, in seconds, for each message of a provision, from send to recv.  Zero
+     * until some provision completes. */
+    double latency;
+
+    /** Smoothed count of provisioned items (headers, bodies, etc) per second.  Zero until some
+     * provision completes. */
+    double throughput;
+
     /** Callbacks */
     BREthereumNodeContext callbackContext;
     BREthereumNodeCallbackStatus callbackStatus;
@@ -685,6 +722,13 @@ nodeCreate (BREthereumNodePriority priority,
 
     // No credits, yet.
     node->credits = 0;
+    node->creditsLimit = 0;
+    node->creditsRecharge = 0;
+    node->creditsTime = 0.0;
+
+    // No performance measures, yet.
+    node->latency = 0.0;
+    node->throughput = 0.0;
 
     node->sendDataBuffer = (BRRlpData) { DEFAULT_SEND_DATA_BUFFER_SIZE, malloc (DEFAULT_SEND_DATA_BUFFER_SIZE) };
     node->recvDataBuffer = (BRRlpData) { DEFAULT_RECV_DATA_BUFFER_SIZE, malloc (DEFAULT_RECV_DATA_BUFFER_SIZE) };
@@ -898,15 +942,49 @@ nodeUnhandleProvisions (BREthereumNode node) {
     return provisions;
 }
 
+static uint64_t
+nodeEstimateCredits (BREthereumNode node,
+                     BREthereumMessage message);
+
+/**
+ * Update the node's smoothed latency and throughput with a completed provision.
+ */
+static void
+nodeUpdatePerformance (BREthereumNode node,
+                       double elapsed,
+                       size_t messagesCount,
+                       size_t itemsCount) {
+    if (elapsed <= 0.0 || 0 == messagesCount) return;
+
+    double latency    = elapsed / messagesCount;
+    double throughput = itemsCount / elapsed;
+
+    node->latency    = (0.0 == node->latency    ? latency    : (1.0 - NODE_PERFORMANCE_WEIGHT) * node->latency    + NODE_PERFORMANCE_WEIGHT * latency);
+    node->throughput = (0.0 == node->throughput ? throughput : (1.0 - NODE_PERFORMANCE_WEIGHT) * node->throughput + NODE_PERFORMANCE_WEIGHT * throughput);
+}
+
 static void
 nodeHandleProvisionerMessage (BREthereumNode node,
                               BREthereumNodeProvisioner *provisioner,
                               OwnershipGiven BREthereumMessage message) {
+    // This message answers one of the outstanding messages; it no longer holds credits.
+    size_t outstanding = ((provisioner->messagesCount - provisioner->messagesRemainingCount) -
+                          provisioner->messagesReceivedCount);
+    if (outstanding > 0)
+        provisioner->creditsPending -= provisioner->creditsPending / outstanding;
+
     // Let the provisioner handle the message, gathering results as warranted.
     provisionerHandleMessage (provisioner, message); // `message` is OwnershipGiven
 
     // If all messages have been received...
     if (!provisionerRecvMessagesPending(provisioner)) {
+        // ... update our performance measures,
+        if (PROVISION_SUCCESS == provisioner->status)
+            nodeUpdatePerformance (node,
+                                   nodeGetTime() - provisioner->sendTime,
+                                   provisioner->messagesCount,
+                                   provisionGetCount (&provisioner->provision));
+
         // ... callback the result,
         BREthereumProvisionResult result = {
             provisioner->provision.identifier,
@@ -1236,6 +1314,15 @@ nodeDefineRemoteStatus (BREthereumNode node,
             assert (MESSAGE_LES == message.identifier);
             assert (LES_MESSAGE_STATUS == message.u.les.identifier);
             status = message.u.les.u.status.p2p;
+
+            // The remote's message costs replace our defaults.
+            for (size_t index = 0; index < NUMBER_OF_LES_MESSAGE_IDENTIFIERS; index++) {
+                BREthereumLESMessageStatusMRC cost = message.u.les.u.status.costs[index];
+                if (index == cost.msgCode && (0 != cost.baseCost || 0 != cost.reqCost)) {
+                    node->specs[index].baseCost = cost.baseCost;
+                    node->specs[index].reqCost  = cost.reqCost;
+                }
+            }
             break;
 
         case NODE_TYPE_PARITY:
@@ -1245,6 +1332,13 @@ nodeDefineRemoteStatus (BREthereumNode node,
             break;
     }
 
+    // Flow control.  The remote's buffer starts full.
+    BREthereumP2PMessageStatusValue value;
+    node->creditsLimit    = (messageP2PStatusExtractValue (&status, P2P_MESSAGE_STATUS_FLOW_CONTROL_BL,  &value) ? value.u.integer : 0);
+    node->creditsRecharge = (messageP2PStatusExtractValue (&status, P2P_MESSAGE_STATUS_FLOW_CONTROL_MRR, &value) ? value.u.integer : 0);
+    node->credits     = node->creditsLimit;
+    node->creditsTime = nodeGetTime();
+
     nodeEndpointSetStatus (node->remote, messageP2PStatusCopy (&status));
 }
 
@@ -1371,7 +1465,13 @@ nodeProcess (BREthereumNode node,
                         // Look for the pending message in some provisioner
                         for (size_t index = 0; index < array_count (node->provisioners); index++)
                             if (provisionerSendMessagesPending (&node->provisioners[index])) {
-                                BREthereumNodeStatus status = provisionerMessageSend(&node->provisioners[index]);
+                                BREthereumNodeProvisioner *provisioner = &node->provisioners[index];
+
+                                // The message will hold credits until answered.
+                                provisioner->creditsPending += nodeEstimateCredits (node, provisioner->messages [provisioner->messagesCount -
+                                                                                                               provisioner->messagesRemainingCount]);
+
+                                BREthereumNodeStatus status = provisionerMessageSend(provisioner);
                                 switch (status) {
                                     case NODE_STATUS_SUCCESS:
                                         break;
@@ -1824,12 +1924,15 @@ nodeProcess (BREthereumNode node,
 }
 
 extern int
-nodeUpdateDescriptors (BREthereumNode node,
-                       BREthereumNodeEndpointRoute route,
-                       fd_set *recv,   // read
-                       fd_set *send) {  // write
+nodeGetDescriptorInterest (BREthereumNode node,
+                           BREthereumNodeEndpointRoute route,
+                           int *recv,
+                           int *send) {
     int socket = nodeEndpointGetSocket(node->remote, route);
 
+    *recv = 0;
+    *send = 0;
+
     // Do nothing - if there is no socket.
     if (-1 == socket) return -1;
 
@@ -1839,13 +1942,12 @@ nodeUpdateDescriptors (BREthereumNode node,
             break;
 
         case NODE_CONNECTED:
-            if (NULL != recv)
-                FD_SET (socket, recv);
+            *recv = 1;
 
             // If we have any provisioner with a pending message, we are willing to send
             for (size_t index = 0; index < array_count (node->provisioners); index++)
                 if (provisionerSendMessagesPending (&node->provisioners[index])) {
-                    if (NULL != send) FD_SET (socket, send);
+                    *send = 1;
                     break;
                 }
 
@@ -1863,7 +1965,7 @@ nodeUpdateDescriptors (BREthereumNode node,
                 case NODE_CONNECT_PING:
                 case NODE_CONNECT_PING_ACK_DISCOVER:
                 case NODE_CONNECT_DISCOVER:
-                    if (NULL != send) FD_SET (socket, send);
+                    *send = 1;
                     break;
 
                 case NODE_CONNECT_AUTH_ACK:
@@ -1874,7 +1976,7 @@ nodeUpdateDescriptors (BREthereumNode node,
                 case NODE_CONNECT_PING_ACK_DISCOVER_ACK:
                 case NODE_CONNECT_DISCOVER_ACK:
                 case NODE_CONNECT_DISCOVER_ACK_TOO:
-                    if (NULL != recv) FD_SET (socket, recv);
+                    *recv = 1;
                     break;
             }
             break;
@@ -1884,6 +1986,22 @@ nodeUpdateDescriptors (BREthereumNode node,
     return socket;
 }
 
+extern int
+nodeUpdateDescriptors (BREthereumNode node,
+                       BREthereumNodeEndpointRoute route,
+                       fd_set *recv,   // read
+                       fd_set *send) {  // write
+    int needRecv, needSend;
+    int socket = nodeGetDescriptorInterest (node, route, &needRecv, &needSend);
+
+    if (-1 == socket) return -1;
+
+    if (needRecv && NULL != recv) FD_SET (socket, recv);
+    if (needSend && NULL != send) FD_SET (socket, send);
+
+    return socket;
+}
+
 /// MARK: - LES Node Support
 
 /**
@@ -2024,20 +2142,26 @@ nodeSend (BREthereumNode node,
                 rlpItemShow (node->coder.rlp, item, "SEND");
 #endif
             
-            // Extract the `items` bytes w/o the RLP length prefix.  We *know* the `item` is an
-            // RLP encoding of a list; thus we use `rlpDecodeList`.
-            BRRlpData data = rlpDecodeListSharedDontRelease(node->coder.rlp, item);
+            // The frame payload is the `items` bytes w/o the RLP length prefix.  We *know* the
+            // `item` is an RLP encoding of a list.  Write the encoding directly into the frame,
+            // such that the length prefix precedes the payload's offset, and then encrypt the
+            // frame in place.
+            size_t prefixCount;
+            size_t payloadCount = rlpItemGetDataBytesCount (node->coder.rlp, item, &prefixCount) - prefixCount;
+            size_t frameCount   = frameCoderGetFrameSize (payloadCount);
 
-            // Encrypt the length-less data
-            BRRlpData encryptedData;
             pthread_mutex_lock (&node->lock);
-            frameCoderEncrypt(node->frameCoder,
-                              data.bytes, data.bytesCount,
-                              &encryptedData.bytes, &encryptedData.bytesCount);
+            if (frameCount > node->sendDataBuffer.bytesCount) {
+                node->sendDataBuffer.bytesCount = frameCount;
+                node->sendDataBuffer.bytes = realloc (node->sendDataBuffer.bytes, frameCount);
+            }
+            uint8_t *frame = node->sendDataBuffer.bytes;
 
-            error = nodeEndpointSendData (node->remote, route, encryptedData.bytes, encryptedData.bytesCount);
+            rlpItemFillData (node->coder.rlp, item, &frame[32 - prefixCount]);
+            frameCoderEncryptFrame (node->frameCoder, frame, payloadCount);
+
+            error = nodeEndpointSendData (node->remote, route, frame, frameCount);
             pthread_mutex_unlock (&node->lock);
-            rlpDataRelease(encryptedData);
             break;
         }
     }
@@ -2152,8 +2276,7 @@ nodeRecv (BREthereumNode node,
 
             // Identifier is at byte[0]
             BRRlpData identifierData = { 1, &bytes[0] };
-            BRRlpItem identifierItem = rlpDataGetItem (node->coder.rlp, identifierData);
-            uint8_t value = (uint8_t) rlpDecodeUInt64 (node->coder.rlp, identifierItem, 1);
+            uint8_t value = (uint8_t) rlpViewDecodeUInt64 (rlpViewCreate (identifierData), 1, NULL);
 
             BREthereumMessageIdentifier type;
             BREthereumANYMessageIdentifier subtype;
@@ -2180,11 +2303,12 @@ nodeRecv (BREthereumNode node,
             // If this is a LES response message, then it has credit information.
             if (!rlpCoderHasFailed(node->coder.rlp) &&
                 MESSAGE_LES == message.identifier &&
-                messageLESHasUse (&message.u.les, LES_MESSAGE_USE_RESPONSE))
+                messageLESHasUse (&message.u.les, LES_MESSAGE_USE_RESPONSE)) {
                 node->credits = messageLESGetCredits (&message.u.les);
+                node->creditsTime = nodeGetTime();
+            }
             
             rlpItemRelease (node->coder.rlp, item);
-            rlpItemRelease (node->coder.rlp, identifierItem);
 
             break;
         }
@@ -2216,10 +2340,6 @@ nodeRecv (BREthereumNode node,
 }
 
 
-#pragma clang diagnostic push
-#pragma GCC diagnostic push
-#pragma clang diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-function"
 static uint64_t
 nodeEstimateCredits (BREthereumNode node,
                      BREthereumMessage message) {
@@ -2234,12 +2354,50 @@ nodeEstimateCredits (BREthereumNode node,
     }
 }
 
+/**
+ * Estimate the credits available now: the last reported credits, recharged since then up to the
+ * buffer limit, less the credits held by messages sent but not yet answered.
+ */
 static uint64_t
 nodeGetCredits (BREthereumNode node) {
-    return node->credits;
+    if (0 == node->creditsLimit) return UINT64_MAX;
+
+    double recharged = 1000.0 * (nodeGetTime() - node->creditsTime) * (double) node->creditsRecharge;
+    uint64_t credits = (recharged >= (double) node->creditsLimit
+                        ? node->creditsLimit
+                        : node->credits + (uint64_t) recharged);
+    if (credits > node->creditsLimit) credits = node->creditsLimit;
+
+    uint64_t pending = 0;
+    for (size_t index = 0; index < array_count (node->provisioners); index++)
+        pending += node->provisioners[index].creditsPending;
+
+    return (pending >= credits ? 0 : credits - pending);
+}
+
+extern BREthereumNodeLoad
+nodeGetLoad (BREthereumNode node) {
+    return (BREthereumNodeLoad) {
+        array_count (node->provisioners),
+        node->latency,
+        node->throughput,
+        nodeGetCredits (node)
+    };
+}
+
+extern uint64_t
+nodeGetProvisionCost (BREthereumNode node,
+                      BREthereumProvision *provision) {
+    if (NODE_TYPE_GETH != node->type) return 0;
+
+    BREthereumLESMessageIdentifier identifier = provisionGetMessageLESIdentifier (provision->type);
+    BREthereumLESMessageSpec spec = node->specs[identifier];
+
+    size_t count = provisionGetCount (provision);
+    size_t messagesCount = (0 == spec.limit ? 1 : (count + spec.limit - 1) / spec.limit);
+
+    return messagesCount * spec.baseCost + count * spec.reqCost;
 }
-#pragma clang diagnostic pop
-#pragma GCC diagnostic pop
 
 /// MARK: - Discovered
 
@@ -247,6 +247,18 @@ nodeDisconnect (BREthereumNode node,
                 BREthereumNodeState stateToAnnounce,
                 BREthereumBoolean returnToAvailable);
 
+/**
+ * Return the socket for `node` on `route`, or -1 if there is none, and fill `recv` and `send`
+ * with 1 if the node, in its current state, is waiting to read or to write on that socket.  This
+ * is the interest that `nodeUpdateDescriptors()` adds to a pair of fd_sets; it allows a caller to
+ * maintain a persistent poll set and only update it when the interest changes.
+ */
+extern int
+nodeGetDescriptorInterest (BREthereumNode node,
+                           BREthereumNodeEndpointRoute route,
+                           int *recv,
+                           int *send);
+
 extern int
 nodeUpdateDescriptors (BREthereumNode node,
                        BREthereumNodeEndpointRoute route,
@@ -260,6 +272,33 @@ nodeProcess (BREthereumNode node,
              fd_set *recv,   // read
              fd_set *send);  // write
 
+/**
+ * A Node's load and measured performance, as used by LES to schedule provisions across nodes.
+ */
+typedef struct {
+    /** The count of provisions handled but not yet complete */
+    size_t provisionsCount;
+
+    /** Smoothed seconds per provision message, send to recv; zero if not yet measured */
+    double latency;
+
+    /** Smoothed provisioned items per second; zero if not yet measured */
+    double throughput;
+
+    /** Estimated credits available to send messages; UINT64_MAX without flow control */
+    uint64_t credits;
+} BREthereumNodeLoad;
+
+extern BREthereumNodeLoad
+nodeGetLoad (BREthereumNode node);
+
+/**
+ * Estimate the credits that `node` charges for `provision`, based on the remote's cost table.
+ */
+extern uint64_t
+nodeGetProvisionCost (BREthereumNode node,
+                      BREthereumProvision *provision);
+
 extern BREthereumBoolean
 nodeCanHandleProvision (BREthereumNode node,
                         BREthereumProvision provision);
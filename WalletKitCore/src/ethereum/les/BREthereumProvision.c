@@ -332,7 +332,7 @@ provisionHandleMessageLES (BREthereumProvision *provisionMulti,
             if (0 == array_count(messageHeaders))
                 status = PROVISION_ERROR;
             else {
-                BRRlpCoder coder = rlpCoderCreate();
+                BRRlpCoder coder = rlpCoderCreateThreadConfined();
 
                 size_t offset = messageContentLimit * (identifier - messageIdBase);
                 for (size_t index = 0; index < array_count(messageHeaders); index++) {
@@ -442,7 +442,7 @@ provisionHandleMessageLES (BREthereumProvision *provisionMulti,
                 // coder has network and perhaps other context - although that is not needed here.
                 //
                 // We could add a coder to the BREthereumProvisionAccounts... yes, probably should.
-                BRRlpCoder coder = rlpCoderCreate();
+                BRRlpCoder coder = rlpCoderCreateThreadConfined();
 
                 size_t offset = messageContentLimit * (identifier - messageIdBase);
                 for (size_t index = 0; index < array_count(messagePaths); index++) {
@@ -797,7 +797,7 @@ provisionHandleMessagePIP (BREthereumProvision *provisionMulti,
             if (0 == array_count(outputs))
                 status = PROVISION_ERROR;
             else {
-                BRRlpCoder coder = rlpCoderCreate();
+                BRRlpCoder coder = rlpCoderCreateThreadConfined();
 
                 size_t offset = messageContentLimit * (identifier - messageIdBase);
                 for (size_t index = 0; index < array_count(outputs); index++) {
@@ -1258,6 +1258,158 @@ provisionMatches (BREthereumProvision *provision1,
                                 );
 }
 
+extern size_t
+provisionGetCount (BREthereumProvision *provision) {
+    switch (provision->type) {
+        case PROVISION_BLOCK_HEADERS:        return provision->u.headers.limit;
+        case PROVISION_BLOCK_PROOFS:         return array_count (provision->u.proofs.numbers);
+        case PROVISION_BLOCK_BODIES:         return array_count (provision->u.bodies.hashes);
+        case PROVISION_TRANSACTION_RECEIPTS: return array_count (provision->u.receipts.hashes);
+        case PROVISION_ACCOUNTS:             return array_count (provision->u.accounts.hashes);
+        case PROVISION_TRANSACTION_STATUSES: return array_count (provision->u.statuses.hashes);
+        case PROVISION_SUBMIT_TRANSACTION:   return 1;
+    }
+}
+
+extern BREthereumBoolean
+provisionIsSplittable (BREthereumProvision *provision) {
+    switch (provision->type) {
+        case PROVISION_BLOCK_HEADERS:
+            // A reverse request might run past the genesis block; we'd need to know where.
+            return AS_ETHEREUM_BOOLEAN (ETHEREUM_BOOLEAN_IS_FALSE (provision->u.headers.reverse));
+
+        case PROVISION_BLOCK_BODIES:
+        case PROVISION_TRANSACTION_RECEIPTS:
+            return ETHEREUM_BOOLEAN_TRUE;
+
+        default:
+            return ETHEREUM_BOOLEAN_FALSE;
+    }
+}
+
+static BRArrayOf(BREthereumHash)
+provisionHashesSlice (BRArrayOf(BREthereumHash) hashes,
+                      size_t offset,
+                      size_t count) {
+    BRArrayOf(BREthereumHash) slice;
+    array_new (slice, count);
+    array_add_array (slice, &hashes[offset], count);
+    return slice;
+}
+
+extern BRArrayOf(BREthereumProvision)
+provisionSplit (BREthereumProvision *provision,
+                size_t partsCount,
+                const size_t *partsSizes) {
+    assert (ETHEREUM_BOOLEAN_IS_TRUE (provisionIsSplittable (provision)));
+
+    BRArrayOf(BREthereumProvision) parts;
+    array_new (parts, partsCount);
+
+    size_t offset = 0;
+    for (size_t index = 0; index < partsCount; index++) {
+        size_t size = partsSizes[index];
+        BREthereumProvision part = { PROVISION_IDENTIFIER_UNDEFINED, provision->type };
+
+        switch (provision->type) {
+            case PROVISION_BLOCK_HEADERS:
+                part.u.headers = (BREthereumProvisionHeaders) {
+                    provision->u.headers.start + offset * (1 + provision->u.headers.skip),
+                    provision->u.headers.skip,
+                    (uint32_t) size,
+                    provision->u.headers.reverse,
+                    NULL
+                };
+                break;
+
+            case PROVISION_BLOCK_BODIES:
+                part.u.bodies = (BREthereumProvisionBodies) {
+                    provisionHashesSlice (provision->u.bodies.hashes, offset, size),
+                    NULL
+                };
+                break;
+
+            case PROVISION_TRANSACTION_RECEIPTS:
+                part.u.receipts = (BREthereumProvisionReceipts) {
+                    provisionHashesSlice (provision->u.receipts.hashes, offset, size),
+                    NULL
+                };
+                break;
+
+            default:
+                assert (0);
+        }
+
+        array_add (parts, part);
+        offset += size;
+    }
+    assert (offset == provisionGetCount (provision));
+
+    return parts;
+}
+
+extern void
+provisionMerge (BREthereumProvision *provision,
+                OwnershipGiven BRArrayOf(BREthereumProvision) parts) {
+    size_t count = provisionGetCount (provision);
+
+    switch (provision->type) {
+        case PROVISION_BLOCK_HEADERS: {
+            BRArrayOf(BREthereumBlockHeader) headers;
+            array_new (headers, count);
+
+            int contiguous = 1;
+            for (size_t index = 0; index < array_count (parts); index++) {
+                BRArrayOf(BREthereumBlockHeader) partHeaders = parts[index].u.headers.headers;
+                size_t partCount = (NULL == partHeaders ? 0 : array_count (partHeaders));
+
+                if (contiguous && partCount > 0) {
+                    array_add_array (headers, partHeaders, partCount);
+                    array_clear (partHeaders);
+                }
+
+                // A short part ends the headers; one node may be behind another and taking
+                // the later parts would leave a gap.
+                if (partCount < parts[index].u.headers.limit) contiguous = 0;
+            }
+            provision->u.headers.headers = headers;
+            break;
+        }
+
+        case PROVISION_BLOCK_BODIES: {
+            BRArrayOf(BREthereumBlockBodyPair) pairs;
+            array_new (pairs, count);
+            for (size_t index = 0; index < array_count (parts); index++)
+                if (NULL != parts[index].u.bodies.pairs) {
+                    array_add_array (pairs, parts[index].u.bodies.pairs, array_count (parts[index].u.bodies.pairs));
+                    array_clear (parts[index].u.bodies.pairs);
+                }
+            provision->u.bodies.pairs = pairs;
+            break;
+        }
+
+        case PROVISION_TRANSACTION_RECEIPTS: {
+            BRArrayOf(BRArrayOf(BREthereumTransactionReceipt)) receipts;
+            array_new (receipts, count);
+            for (size_t index = 0; index < array_count (parts); index++)
+                if (NULL != parts[index].u.receipts.receipts) {
+                    array_add_array (receipts, parts[index].u.receipts.receipts, array_count (parts[index].u.receipts.receipts));
+                    array_clear (parts[index].u.receipts.receipts);
+                }
+            provision->u.receipts.receipts = receipts;
+            break;
+        }
+
+        default:
+            assert (0);
+    }
+
+    // The parts' results are now empty (or dropped); release everything else.
+    for (size_t index = 0; index < array_count (parts); index++)
+        provisionRelease (&parts[index], ETHEREUM_BOOLEAN_TRUE);
+    array_free (parts);
+}
+
 extern void
 provisionResultRelease (BREthereumProvisionResult *result) {
     provisionRelease (&result->provision, ETHEREUM_BOOLEAN_TRUE);
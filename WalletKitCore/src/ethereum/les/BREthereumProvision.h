@@ -221,6 +221,40 @@ extern BREthereumBoolean
 provisionMatches (BREthereumProvision *provision1,
                   BREthereumProvision *provision2);
 
+/**
+ * Return the number of items requested by `provision` - the headers limit or the count of hashes
+ * or numbers.  A transaction submission has one item.
+ */
+extern size_t
+provisionGetCount (BREthereumProvision *provision);
+
+/**
+ * Check if a provision can be split into parts that are handled independently, by different
+ * nodes, and then merged.  Only forward BLOCK_HEADERS, BLOCK_BODIES and TRANSACTION_RECEIPTS
+ * provisions can be split.
+ */
+extern BREthereumBoolean
+provisionIsSplittable (BREthereumProvision *provision);
+
+/**
+ * Split `provision` into `partsCount` parts where the part at `index` requests the next
+ * `partsSizes[index]` items.  The sizes must sum to `provisionGetCount (provision)`.  The parts
+ * own their request data (nothing is shared with `provision`) and have an undefined identifier.
+ */
+extern BRArrayOf(BREthereumProvision)
+provisionSplit (BREthereumProvision *provision,
+                size_t partsCount,
+                const size_t *partsSizes);
+
+/**
+ * Merge the results of `parts`, as created by `provisionSplit()` and then handled, into the
+ * results of `provision`.  If a BLOCK_HEADERS part has fewer headers than it requested, then
+ * later parts are dropped - the merged headers are always contiguous, as if from one node.
+ */
+extern void
+provisionMerge (BREthereumProvision *provision,
+                OwnershipGiven BRArrayOf(BREthereumProvision) parts);
+
 /**
  * Provision Result
  */
@@ -54,6 +54,19 @@ messageLESGetIdentifierName (BREthereumLESMessageIdentifier identifer) {
     return messageLESSpecs[identifer].name;
 }
 
+// Decode the `reqId` and `bv` that lead every LES response, from `items[0]` and `items[1]`.  A
+// value that is not a number, or too large, fails `coder`.
+static void
+messageLESDecodeReqIdAndBV (BRRlpView *items,
+                            BREthereumMessageCoder coder,
+                            uint64_t *reqId,
+                            uint64_t *bv) {
+    int failed = 0;
+    *reqId = rlpViewDecodeUInt64 (items[0], 1, &failed);
+    *bv    = rlpViewDecodeUInt64 (items[1], 1, &failed);
+    if (failed) rlpCoderSetFailed (coder.rlp);
+}
+
 /// MARK: - LES Status
 
 extern void
@@ -251,20 +264,21 @@ messageLESBlockHeadersConsume (BREthereumLESMessageBlockHeaders *message,
 extern BREthereumLESMessageBlockHeaders
 messageLESBlockHeadersDecode (BRRlpItem item,
                               BREthereumMessageCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    // Decode from a view of `item`; no sub-items are created
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
-
-    size_t headerItemsCount = 0;
-    const BRRlpItem *headerItems = rlpDecodeList (coder.rlp, items[2], &headerItemsCount);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     BRArrayOf(BREthereumBlockHeader) headers;
-    array_new (headers, headerItemsCount);
-    for (size_t index = 0; index < headerItemsCount; index++)
-        array_add (headers, blockHeaderRlpDecode (headerItems[index], RLP_TYPE_NETWORK, coder.rlp));
+    array_new (headers, rlpViewGetListCount (items[2]));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (items[2]);
+    BRRlpView headerItem;
+    while (rlpViewCursorNext (&cursor, &headerItem))
+        array_add (headers, blockHeaderRlpDecodeView (headerItem, RLP_TYPE_NETWORK));
 
     return (BREthereumLESMessageBlockHeaders) {
         reqId,
@@ -293,26 +307,26 @@ messageLESBlockBodiesConsume (BREthereumLESMessageBlockBodies *message,
 static BREthereumLESMessageBlockBodies
 messageLESBlockBodiesDecode (BRRlpItem item,
                              BREthereumMessageCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
-
-    size_t pairItemsCount = 0;
-    const BRRlpItem *pairItems = rlpDecodeList (coder.rlp, items[2], &pairItemsCount);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     BRArrayOf(BREthereumBlockBodyPair) pairs;
-    array_new(pairs, pairItemsCount);
-    for (size_t index = 0; index < pairItemsCount; index++) {
-        size_t bodyItemsCount;
-        const BRRlpItem *bodyItems = rlpDecodeList (coder.rlp, pairItems[index], &bodyItemsCount);
+    array_new(pairs, rlpViewGetListCount (items[2]));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (items[2]);
+    BRRlpView pairItem;
+    while (rlpViewCursorNext (&cursor, &pairItem)) {
+        BRRlpView bodyItems[2];
+        size_t bodyItemsCount = rlpViewDecodeList (pairItem, bodyItems, 2);
         assert (2 == bodyItemsCount);
 
         BREthereumBlockBodyPair pair = {
-            blockTransactionsRlpDecode (bodyItems[0], coder.network, RLP_TYPE_NETWORK, coder.rlp),
-            blockOmmersRlpDecode (bodyItems[1], coder.network, RLP_TYPE_NETWORK, coder.rlp)
+            blockTransactionsRlpDecodeView (bodyItems[0], coder.network, RLP_TYPE_NETWORK, coder.rlp),
+            blockOmmersRlpDecodeView (bodyItems[1], coder.network, RLP_TYPE_NETWORK)
         };
         array_add(pairs, pair);
     }
@@ -343,21 +357,21 @@ messageLESReceiptsConsume (BREthereumLESMessageReceipts *receipts,
 static BREthereumLESMessageReceipts
 messageLESReceiptsDecode (BRRlpItem item,
                           BREthereumMessageCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
-
-    size_t arrayItemsCount = 0;
-    const BRRlpItem *arrayItems = rlpDecodeList (coder.rlp, items[2], &arrayItemsCount);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     BRArrayOf(BREthereumLESMessageReceiptsArray) arrays;
-    array_new(arrays, arrayItemsCount);
-    for (size_t index = 0; index < arrayItemsCount; index++) {
+    array_new(arrays, rlpViewGetListCount (items[2]));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (items[2]);
+    BRRlpView arrayItem;
+    while (rlpViewCursorNext (&cursor, &arrayItem)) {
         BREthereumLESMessageReceiptsArray array = {
-            transactionReceiptDecodeList (arrayItems[index], coder.rlp)
+            transactionReceiptDecodeListView (arrayItem)
         };
         array_add (arrays, array);
     }
@@ -411,20 +425,20 @@ static BREthereumLESMessageProofs
 messageLESProofsDecode (BRRlpItem item,
                         BREthereumMessageCoder coder) {
     // rlpShowItem (coder.rlp, item, "LES Proofs");
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
-
-    size_t pathsCount = 0;
-    const BRRlpItem *pathsItems = rlpDecodeList (coder.rlp, items[2], &pathsCount);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     BRArrayOf(BREthereumMPTNodePath) paths;
-    array_new (paths, pathsCount);
-    for (size_t index = 0; index < pathsCount; index++)
-        array_add (paths, mptNodePathDecode (pathsItems[index], coder.rlp));
+    array_new (paths, rlpViewGetListCount (items[2]));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (items[2]);
+    BRRlpView pathItem;
+    while (rlpViewCursorNext (&cursor, &pathItem))
+        array_add (paths, mptNodePathDecodeView (pathItem, coder.rlp));
 
     return (BREthereumLESMessageProofs) {
         reqId,
@@ -484,23 +498,24 @@ messageLESGetHeaderProofsEncode (BREthereumLESMessageGetHeaderProofs message, BR
 /// MARK: LES HeaderProofs
 
 static void
-headerProofsDecode (BRRlpItem item,
+headerProofsDecode (BRRlpView view,
                     BREthereumMessageCoder coder,
                     BRArrayOf(BREthereumBlockHeader) *headers,
                     BRArrayOf(BREthereumMPTNodePath) *paths) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList (coder.rlp, item, &itemsCount);
+    size_t itemsCount = rlpViewGetListCount (view);
 
     array_new (*headers, itemsCount);
     array_new (*paths,   itemsCount);
 
-    for (size_t index = 0; index < itemsCount; index++) {
-        size_t headerItemsCount = 0;
-        const BRRlpItem *headerItems = rlpDecodeList (coder.rlp, items[index], &headerItemsCount);
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+    while (rlpViewCursorNext (&cursor, &item)) {
+        BRRlpView headerItems[2];
+        size_t headerItemsCount = rlpViewDecodeList (item, headerItems, 2);
         assert (2 == headerItemsCount);
 
-        BREthereumBlockHeader header = blockHeaderRlpDecode (headerItems[0], RLP_TYPE_NETWORK, coder.rlp);
-        BREthereumMPTNodePath path   = mptNodePathDecode (headerItems[1], coder.rlp);
+        BREthereumBlockHeader header = blockHeaderRlpDecodeView (headerItems[0], RLP_TYPE_NETWORK);
+        BREthereumMPTNodePath path   = mptNodePathDecodeView (headerItems[1], coder.rlp);
 
         array_add (*headers, header);
         array_add (*paths,   path);
@@ -510,12 +525,12 @@ headerProofsDecode (BRRlpItem item,
 static BREthereumLESMessageHeaderProofs
 messageLESHeaderProofsDecode (BRRlpItem item,
                               BREthereumMessageCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     BRArrayOf(BREthereumBlockHeader) headers;
     BRArrayOf(BREthereumMPTNodePath) paths;
@@ -553,18 +568,18 @@ static BREthereumLESMessageProofsV2
 messageLESProofsV2Decode (BRRlpItem item,
                           BREthereumMessageCoder coder) {
     // rlpShowItem (coder.rlp, item, "LES ProofsV2");
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder.rlp, item, &itemsCount);
+    BRRlpView items[3];
+    size_t itemsCount = rlpViewDecodeList (rlpItemGetView (coder.rlp, item), items, 3);
     assert (3 == itemsCount);
 
-    uint64_t reqId = rlpDecodeUInt64 (coder.rlp, items[0], 1);
-    uint64_t bv    = rlpDecodeUInt64 (coder.rlp, items[1], 1);
+    uint64_t reqId, bv;
+    messageLESDecodeReqIdAndBV (items, coder, &reqId, &bv);
 
     // TODO: See GetProofs - should be an array of PATHS
     return (BREthereumLESMessageProofsV2) {
         reqId,
         bv,
-        mptNodePathDecode (items[2], coder.rlp)
+        mptNodePathDecodeView (items[2], coder.rlp)
     };
 }
 
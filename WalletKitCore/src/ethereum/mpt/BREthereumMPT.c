@@ -119,18 +119,18 @@ mptNodeConsume (BREthereumMPTNode node, uint8_t *key) {
 #define NIBBLE_GET(x, upper) (0x0f & ((x) >> ((upper) ? 4 : 0)))
 
 static BREthereumMPTNode
-mptNodeDecode (BRRlpItem item,
-               BRRlpCoder coder) {
+mptNodeDecodeView (BRRlpView view,
+                   BRRlpCoder coder) {
     BREthereumMPTNode node = NULL;
 
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList (coder, item, &itemsCount);
+    BRRlpView items[17];
+    size_t itemsCount = rlpViewDecodeList (view, items, 17);
     if (17 != itemsCount && 2 != itemsCount) { rlpCoderSetFailed (coder); return NULL; }
 
     switch (itemsCount) {
         case 2: {
             // Decode, skipping to the bytes (w/o the RLP length prefix)
-            BRRlpData pathData = rlpDecodeBytesSharedDontRelease(coder, items[0]);
+            BRRlpData pathData = rlpViewDecodeBytes (items[0]);
             assert (0 != pathData.bytesCount);
 
             // Extract the nodeType nibble; determine `type` and `padded`
@@ -171,12 +171,12 @@ mptNodeDecode (BRRlpItem item,
             switch (type) {
                 case MPT_NODE_LEAF:
                     node->u.leaf.path = path;
-                    node->u.leaf.value = rlpDecodeBytes (coder, items[1]);
+                    node->u.leaf.value = rlpDataCopy (rlpViewDecodeBytes (items[1]));
                     break;
 
                 case MPT_NODE_EXTENSION:
                     node->u.extension.path = path;
-                    node->u.extension.key = ethHashRlpDecode (items[1], coder);
+                    node->u.extension.key = ethHashRlpDecodeView (items[1]);
                     break;
 
                 case MPT_NODE_BRANCH:
@@ -188,13 +188,12 @@ mptNodeDecode (BRRlpItem item,
         case 17: {
             node = mptNodeCreate(MPT_NODE_BRANCH);
             for (size_t index = 0; index < 16; index++) {
-                BRRlpData data = rlpItemGetDataSharedDontRelease (coder, items[index]);
                 // Either a hash (0x<32 bytes>) or empty (0x)
-                node->u.branch.keys[index] = (0 == data.bytesCount || 1 == data.bytesCount
+                node->u.branch.keys[index] = (0 == items[index].bytesCount || 1 == items[index].bytesCount
                                               ? EMPTY_HASH_INIT
-                                              : ethHashRlpDecode(items[index], coder));
+                                              : ethHashRlpDecodeView(items[index]));
             }
-            node->u.branch.value = rlpItemGetData (coder, items[16]);
+            node->u.branch.value = rlpDataCopy (rlpViewGetData (items[16]));
             break;
         }
     }
@@ -235,13 +234,20 @@ mptNodePathsRelease (BRArrayOf(BREthereumMPTNodePath) paths) {
 extern BREthereumMPTNodePath
 mptNodePathDecode (BRRlpItem item,
                    BRRlpCoder coder) {
-    size_t itemsCount;
-    const BRRlpItem *items = rlpDecodeList (coder, item, &itemsCount);
+    return mptNodePathDecodeView (rlpItemGetView (coder, item), coder);
+}
 
+extern BREthereumMPTNodePath
+mptNodePathDecodeView (BRRlpView view,
+                       BRRlpCoder coder) {
     BRArrayOf (BREthereumMPTNode) nodes;
-    array_new (nodes, itemsCount);
-    for (size_t index = 0; index < itemsCount; index++)
-        array_add (nodes, mptNodeDecode (items[index], coder));
+    array_new (nodes, rlpViewGetListCount (view));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+
+    while (rlpViewCursorNext (&cursor, &item))
+        array_add (nodes, mptNodeDecodeView (item, coder));
 
     return mptNodePathCreate(nodes);
 }
@@ -249,21 +255,22 @@ mptNodePathDecode (BRRlpItem item,
 extern BREthereumMPTNodePath
 mptNodePathDecodeFromBytes (BRRlpItem item,
                             BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    BRRlpItem *items = (BRRlpItem *) rlpDecodeList(coder, item, &itemsCount);
+    BRRlpView view = rlpItemGetView (coder, item);
 
     BRArrayOf (BREthereumMPTNode) nodes;
-    array_new (nodes, itemsCount);
-    for (size_t index = 0; index < itemsCount; index++) {
-        // items[index] holds bytes as the RLP encoding of MPT nodes.  We'll decode the bytes
-        // and then RLP encode the bytes (but this time as RLP items.... got it??).
-        BRRlpData data = rlpDecodeBytesSharedDontRelease (coder, items[index]);
-        BRRlpItem item = rlpDataGetItem(coder, data);
-        array_add (nodes, mptNodeDecode (item, coder));
+    array_new (nodes, rlpViewGetListCount (view));
+
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView bytesView;
+
+    while (rlpViewCursorNext (&cursor, &bytesView)) {
+        // bytesView holds bytes as the RLP encoding of MPT nodes.  We'll view the bytes
+        // themselves as RLP (but this time as a RLP list.... got it??).
+        BRRlpView nodeView = rlpViewCreate (rlpViewDecodeBytes (bytesView));
+        array_add (nodes, mptNodeDecodeView (nodeView, coder));
 #if defined (MPT_SHOW_PROOF_NODES)
-        rlpShowItem (coder, item, "MPTN");
+        rlpDataShow (rlpViewGetData (nodeView), "MPTN");
 #endif
-        rlpItemRelease (coder, item);
     }
 
     // TODO: If any above item is decoded improperly, then `nodes` will have NULL values.
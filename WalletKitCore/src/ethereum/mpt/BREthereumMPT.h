@@ -69,6 +69,10 @@ extern BREthereumMPTNodePath
 mptNodePathDecode (BRRlpItem item,
                    BRRlpCoder coder);
 
+extern BREthereumMPTNodePath
+mptNodePathDecodeView (BRRlpView view,
+                       BRRlpCoder coder);
+
 /**
  * Decode a MPT from an RLP item that is a RLP list of bytes.  This is unlike the above which
  * is an RLP List of RLP List of ...
@@ -13,7 +13,9 @@
 #include <memory.h>
 #include <assert.h>
 #include <pthread.h>
+#include "support/BRCrypto.h"
 #include "ethereum/util/BRUtil.h"
+#include "ethereum/util/BRKeccak.h"
 #include "BRRlpCoder.h"
 
 static int
@@ -22,7 +24,8 @@ rlpDecodeStringEmptyCheck (BRRlpCoder coder, BRRlpItem item);
 static void
 encodeLengthIntoBytes (uint64_t length, uint8_t baseline, uint8_t *bytes9, uint8_t *bytes9Count);
 
-#define CODER_DEFAULT_ITEMS     (2000)
+static void
+rlpItemFillSubItems (BRRlpCoder coder, BRRlpItem item);
 
 /**
  * An RLP Encoding is comprised of two types: an ITEM and a LIST (of ITEM).
@@ -33,34 +36,83 @@ typedef enum {
     CODER_LIST,
 } BRRlpItemType;
 
-#define ITEM_DEFAULT_BYTES_COUNT  1024
-#define ITEM_DEFAULT_ITEMS_COUNT    15
+#define RLP_PREFIX_BYTES  (0x80)
+#define RLP_PREFIX_LIST   (0xc0)
+#define RLP_PREFIX_LENGTH_LIMIT  (55)
 
+/**
+ * An RLP item is compact - the encoded bytes and, for a list, the sub-items are held by
+ * reference.  The referenced memory comes from the coder's arena (see below) or, when large,
+ * from malloc().  A sub-item decoded by rlpDataGetItem() shares the bytes of its enclosing list
+ * item rather than holding a copy.  The sub-items of a decoded list are only created when first
+ * needed, by rlpDecodeList(); a decoder walking the list with a BRRlpView never creates them.
+ *
+ * A list created by rlpEncodeList*() is only sized - `bytesCount` and `prefixCount` are known
+ * but `bytes` is NULL.  The encoding is written, in one pass over the list and its sub-items,
+ * when first needed - see _rlpItemEnsureBytesInternal() - or directly into a caller's buffer, or
+ * streamed into a hash, without ever being held by the item.
+ */
 struct  BRRlpItemRecord {
     BRRlpItemType type;
 
+    // If set, `bytes` or `items` were malloc'd and are freed when the item is released.
+    uint8_t bytesAllocated;
+    uint8_t itemsAllocated;
+
+    // If CODER_LIST, the count of `bytes` holding the RLP length prefix.
+    uint8_t prefixCount;
+
+    // If set, a CODER_LIST with `bytes` whose `items` have not yet been created.
+    uint8_t itemsPending;
+
     // The encoding
     size_t bytesCount;
     uint8_t *bytes;
-    uint8_t  bytesArray [ITEM_DEFAULT_BYTES_COUNT];
 
     // If CODER_LIST, then reference the component items.
     size_t itemsCount;
     BRRlpItem *items;
-    BRRlpItem  itemsArray [ITEM_DEFAULT_ITEMS_COUNT];
 
-    // double linked-list of free/busy items.
-    BRRlpItem next, prev;
+    // singly linked-list of free items.
+    BRRlpItem next;
 };
 
 static void
 itemReleaseMemory (BRRlpItem item) {
-    if (item->bytesArray != item->bytes && NULL != item->bytes) free (item->bytes);
-    if (item->itemsArray != item->items && NULL != item->items) free (item->items);
+    if (item->bytesAllocated) free (item->bytes);
+    if (item->itemsAllocated) free (item->items);
 
     memset (item, 0, sizeof (struct BRRlpItemRecord));
 }
 
+/**
+ * Items are allocated from slabs of CODER_SLAB_ITEMS_COUNT items; once allocated an item is
+ * only ever returned to the coder's `free` list.  Slabs are freed by rlpCoderReclaim(), if no
+ * item is busy, and by rlpCoderRelease().
+ */
+#define CODER_SLAB_ITEMS_COUNT      (256)
+
+typedef struct BRRlpItemSlabRecord {
+    struct BRRlpItemSlabRecord *next;
+    struct BRRlpItemRecord items[CODER_SLAB_ITEMS_COUNT];
+} *BRRlpItemSlab;
+
+/**
+ * The bytes and sub-item arrays of items are bump allocated from arena chunks.  Arena memory
+ * is never returned piecemeal; instead the entire arena is reset once no item is busy.  An
+ * allocation larger than CODER_ARENA_LARGE_LIMIT bypasses the arena - it would waste too much
+ * of a chunk - and is malloc'd (and freed on item release).
+ */
+#define CODER_ARENA_CHUNK_SIZE      (16 * 1024)
+#define CODER_ARENA_LARGE_LIMIT     (CODER_ARENA_CHUNK_SIZE / 4)
+#define CODER_ARENA_ALIGNMENT       (sizeof (void*))
+
+typedef struct BRRlpArenaChunkRecord {
+    struct BRRlpArenaChunkRecord *next;
+    size_t used;
+    uint8_t bytes[CODER_ARENA_CHUNK_SIZE];
+} *BRRlpArenaChunk;
+
 /**
  *
  */
@@ -77,33 +129,52 @@ struct BRRlpCoderRecord {
     BRRlpItem free;
 
     /**
-     * A doubly-linked list of busy RLP items.  Fact is, we don't need to keep this list - you
-     * acquire an item and you best be sure to release it and if you don't you've leaked memory.
+     * The slabs holding every RLP item and the number of items used in the first slab.
+     */
+    BRRlpItemSlab slabs;
+    size_t slabUsed;
+
+    /**
+     * The arena chunks in use, the first one being the current bump chunk, and those chunks
+     * kept, after an arena reset, for reuse.
+     */
+    BRRlpArenaChunk chunks;
+    BRRlpArenaChunk chunksSpare;
+
+    /**
+     * The count of busy RLP items.  Fact is, we don't need to keep this count - you acquire an
+     * item and you best be sure to release it and if you don't you've leaked memory.
      *
-     * Well, in order to ensure that memory is not leaked, we keep a `busy` list and then on
-     * `rlpCoderRelease()` we assert that there a no busy items - ensuring all are released.
+     * Well, in order to ensure that memory is not leaked, we keep a `busy` count and then on
+     * `rlpCoderRelease()` we assert that there a no busy items - ensuring all are released.  When
+     * the count drops to zero all arena memory is unreferenced and the arena is reset.
      *
-     * This busy list caused a problem (see bugfix/CORE-152).  It was singly linked and thus to
-     * remove an item we were forced to traverse the list to find the just-prior item and then
-     * set prev->next = item->next.  When we had an RLP item with ~300,000 sub-items the
-     * traversal was computationally unmanageable.  Thus we changed to a doubly-linked list.  Fact
-     * is we probaby don't need `busy`.
+     * This was once a list of busy items (see bugfix/CORE-152 for how that went).
      */
-    BRRlpItem busy;
+    size_t busy;
 
     /**
      * It is not likely that this lock is actually needed, base on current `BRRlpCoder` use - coders
-     * are only used in one thread.  However, that use my not be generally true - so lock/unlock.
+     * are only used in one thread.  However, that use my not be generally true - so lock/unlock,
+     * unless the coder was created as thread confined.
      */
     pthread_mutex_t lock;
+    int confined;
+    pthread_t owner;
 };
 
-extern BRRlpCoder
-rlpCoderCreate (void) {
+static BRRlpCoder
+rlpCoderCreateInternal (int confined) {
     BRRlpCoder coder = malloc (sizeof (struct BRRlpCoderRecord));
     coder->failed = 0;
     coder->free = NULL;
-    coder->busy = NULL;
+    coder->slabs = NULL;
+    coder->slabUsed = CODER_SLAB_ITEMS_COUNT;
+    coder->chunks = NULL;
+    coder->chunksSpare = NULL;
+    coder->busy = 0;
+    coder->confined = confined;
+    coder->owner = pthread_self();
 
     {
         pthread_mutexattr_t attr;
@@ -112,157 +183,303 @@ rlpCoderCreate (void) {
         pthread_mutex_init (&coder->lock, &attr);
         pthread_mutexattr_destroy(&attr);
     }
-#if 0
-    for (size_t index = 0; index < CODER_DEFAULT_ITEMS; index++) {
-        BRRlpItem item = calloc (1, sizeof (struct BRRlpItemRecord));
-        item->next = coder->free;
-        coder->free = item;
-    }
-#endif
     return coder;
 }
 
+extern BRRlpCoder
+rlpCoderCreate (void) {
+    return rlpCoderCreateInternal (0);
+}
+
+extern BRRlpCoder
+rlpCoderCreateThreadConfined (void) {
+    return rlpCoderCreateInternal (1);
+}
+
+static void
+rlpCoderLock (BRRlpCoder coder) {
+    if (!coder->confined) pthread_mutex_lock (&coder->lock);
+    else assert (pthread_equal (coder->owner, pthread_self()));
+}
+
+static void
+rlpCoderUnlock (BRRlpCoder coder) {
+    if (!coder->confined) pthread_mutex_unlock (&coder->lock);
+}
+
+static void
+_rlpCoderArenaChunksFree (BRRlpArenaChunk chunk) {
+    while (NULL != chunk) {
+        BRRlpArenaChunk next = chunk->next;
+        free (chunk);
+        chunk = next;
+    }
+}
+
+/**
+ * Reset the arena - every chunk becomes spare.  Only allowed when no item is busy.
+ */
+static void
+_rlpCoderArenaReset (BRRlpCoder coder) {
+    assert (0 == coder->busy);
+    while (NULL != coder->chunks) {
+        BRRlpArenaChunk chunk = coder->chunks;
+        coder->chunks = chunk->next;
+
+        chunk->used = 0;
+        chunk->next = coder->chunksSpare;
+        coder->chunksSpare = chunk;
+    }
+}
+
+/**
+ * Allocate `size` bytes from the arena, or malloc() them if `size` is large.  Sets `allocated`
+ * if malloc'd.
+ */
+static void *
+_rlpCoderArenaAlloc (BRRlpCoder coder, size_t size, uint8_t *allocated) {
+    if (size > CODER_ARENA_LARGE_LIMIT) {
+        *allocated = 1;
+        return malloc (size);
+    }
+    *allocated = 0;
+
+    size = (size + CODER_ARENA_ALIGNMENT - 1) & ~(CODER_ARENA_ALIGNMENT - 1);
+
+    BRRlpArenaChunk chunk = coder->chunks;
+    if (NULL == chunk || chunk->used + size > CODER_ARENA_CHUNK_SIZE) {
+        if (NULL != coder->chunksSpare) {
+            chunk = coder->chunksSpare;
+            coder->chunksSpare = chunk->next;
+        }
+        else chunk = malloc (sizeof (struct BRRlpArenaChunkRecord));
+
+        chunk->used = 0;
+        chunk->next = coder->chunks;
+        coder->chunks = chunk;
+    }
+
+    void *memory = &chunk->bytes[chunk->used];
+    chunk->used += size;
+    return memory;
+}
+
 static void
 _rlpCoderReclaimInternal (BRRlpCoder coder) {
-    BRRlpItem item = coder->free;
-    while (item != NULL) {
-        BRRlpItem next = item->next;   // save 'next' before release...
-        itemReleaseMemory (item);
-        free (item);
-        item = next;
+    // Spare chunks are unused, always.
+    _rlpCoderArenaChunksFree (coder->chunksSpare);
+    coder->chunksSpare = NULL;
+
+    // With no busy items, every item is in `free` and the arena is unreferenced.
+    if (0 == coder->busy) {
+        _rlpCoderArenaChunksFree (coder->chunks);
+        coder->chunks = NULL;
+
+        while (NULL != coder->slabs) {
+            BRRlpItemSlab slab = coder->slabs;
+            coder->slabs = slab->next;
+            free (slab);
+        }
+        coder->slabUsed = CODER_SLAB_ITEMS_COUNT;
+        coder->free = NULL;
     }
-    coder->free = NULL;
 }
 
 extern void
 rlpCoderReclaim (BRRlpCoder coder) {
-    pthread_mutex_lock(&coder->lock);
+    rlpCoderLock (coder);
     _rlpCoderReclaimInternal (coder);
-    pthread_mutex_unlock(&coder->lock);
+    rlpCoderUnlock (coder);
 }
 
 extern void
 rlpCoderRelease (BRRlpCoder coder) {
-    pthread_mutex_lock(&coder->lock);
+    rlpCoderLock (coder);
 
     // Every single Item must be returned!
-    assert (NULL == coder->busy);
+    assert (0 == coder->busy);
     _rlpCoderReclaimInternal (coder);
 
-    pthread_mutex_unlock(&coder->lock);
+    rlpCoderUnlock (coder);
     pthread_mutex_destroy(&coder->lock);
     free (coder);
 }
 
+extern void
+rlpCoderGetStats (BRRlpCoder coder, size_t *itemsCount, size_t *bytesCount) {
+    rlpCoderLock (coder);
+
+    size_t items = 0;
+    for (BRRlpItemSlab slab = coder->slabs; NULL != slab; slab = slab->next)
+        items += CODER_SLAB_ITEMS_COUNT;
+
+    size_t chunks = 0;
+    for (BRRlpArenaChunk chunk = coder->chunks; NULL != chunk; chunk = chunk->next)
+        chunks += 1;
+    for (BRRlpArenaChunk chunk = coder->chunksSpare; NULL != chunk; chunk = chunk->next)
+        chunks += 1;
+
+    if (NULL != itemsCount) *itemsCount = items;
+    if (NULL != bytesCount) *bytesCount = (items  * sizeof (struct BRRlpItemRecord) +
+                                           chunks * sizeof (struct BRRlpArenaChunkRecord));
+    rlpCoderUnlock (coder);
+}
+
 static BRRlpItem
-_rlpCoderAcquireItemInternal (BRRlpCoder coder) {
+_rlpCoderAcquireItemInternal (BRRlpCoder coder, BRRlpItemType type) {
     BRRlpItem item = NULL;
 
-    // Get `item` from `coder->free` or `calloc`
+    // Get `item` from `coder->free` or from a slab
     if (NULL != coder->free) {
         item = coder->free;
         coder->free = item->next;
         item->next = NULL;
     }
-    else item = calloc (1, sizeof (struct BRRlpItemRecord));
+    else {
+        if (CODER_SLAB_ITEMS_COUNT == coder->slabUsed) {
+            BRRlpItemSlab slab = calloc (1, sizeof (struct BRRlpItemSlabRecord));
+            slab->next = coder->slabs;
+            coder->slabs = slab;
+            coder->slabUsed = 0;
+        }
+        item = &coder->slabs->items[coder->slabUsed++];
+    }
 
-    assert (NULL == item->next       && NULL == item->prev &&
+    assert (NULL == item->next       && NULL == item->bytes &&
             0    == item->bytesCount && 0    == item->itemsCount);
 
-    // Doubly-link `item` to `busy`
-    if (NULL != coder->busy) coder->busy->prev = item;
-    item->next = coder->busy;
+    item->type = type;
+    coder->busy += 1;
 
-    // Update `coder` to show `item` as busy.
-    coder->busy = item;
+    return item;
+}
 
+/**
+ * Acquire an item of `type` holding `bytesCount` bytes.  If `bytes` is not NULL the item will
+ * share `bytes`; otherwise the item's bytes are allocated (but not filled).
+ */
+static BRRlpItem
+_rlpCoderAcquireItemWithBytesInternal (BRRlpCoder coder, BRRlpItemType type,
+                                       uint8_t *bytes, size_t bytesCount) {
+    BRRlpItem item = _rlpCoderAcquireItemInternal (coder, type);
+    item->bytesCount = bytesCount;
+    item->bytes = (NULL != bytes
+                   ? bytes
+                   : _rlpCoderArenaAlloc (coder, bytesCount, &item->bytesAllocated));
     return item;
 }
 
 static BRRlpItem
-rlpCoderAcquireItem (BRRlpCoder coder) {
-    pthread_mutex_lock(&coder->lock);
-    BRRlpItem item = _rlpCoderAcquireItemInternal (coder);
-    pthread_mutex_unlock(&coder->lock);
+rlpCoderAcquireItemWithBytes (BRRlpCoder coder, BRRlpItemType type, size_t bytesCount) {
+    rlpCoderLock (coder);
+    BRRlpItem item = _rlpCoderAcquireItemWithBytesInternal (coder, type, NULL, bytesCount);
+    rlpCoderUnlock (coder);
     return item;
 }
 
 static void
-_rlpCoderReturnItemInternal (BRRlpCoder coder, BRRlpItem prev, BRRlpItem item, BRRlpItem next) {
-    assert (NULL == item->next       && NULL == item->prev &&
-            0    == item->bytesCount && 0    == item->itemsCount);
-
-    // If `item` is a the head of our `busy` list, then just move `busy`
-    if (item == coder->busy)
-        coder->busy = next;
+_rlpCoderReleaseItemInternal (BRRlpCoder coder, BRRlpItem item) {
+    for (size_t index = 0; index < item->itemsCount; index++)
+        _rlpCoderReleaseItemInternal (coder, item->items[index]);
 
-    // If `item` is not at the head of our `busy` list, then splice out `item` by
-    // linking as `prev` <==> `next`
-    else {
-        if (NULL != prev) prev->next = next;
-        if (NULL != next) next->prev = prev;
-    }
+    itemReleaseMemory(item);
 
     // The `item` is no longer busy.  Singlely link to `free`.
-    item->prev = NULL;
     item->next = coder->free;
-
-    // Update `coder` to show `item` as free.
     coder->free = item;
+
+    assert (coder->busy > 0);
+    coder->busy -= 1;
 }
 
 static void
-_rlpCoderReleaseItemInternal (BRRlpCoder coder, BRRlpItem item) {
-    for (size_t index = 0; index < item->itemsCount; index++)
-        _rlpCoderReleaseItemInternal (coder, item->items[index]);
+rlpCoderReleaseItem (BRRlpCoder coder, BRRlpItem item) {
+    rlpCoderLock (coder);
+    _rlpCoderReleaseItemInternal (coder, item);
+    if (0 == coder->busy) _rlpCoderArenaReset (coder);
+    rlpCoderUnlock (coder);
+}
 
-    // Surely get these before itemReleaseMemory() blows them away.
-    BRRlpItem prev = item->prev;
-    BRRlpItem next = item->next;
+/**
+ * Write the encoding of `item` into `bytes`, returning the number of bytes written.  If `adopt`
+ * then every list item without bytes takes its bytes from `bytes` as written.
+ */
+static size_t
+_rlpItemWriteInternal (BRRlpItem item, uint8_t *bytes, int adopt) {
+    if (NULL != item->bytes) {
+        memcpy (bytes, item->bytes, item->bytesCount);
+        return item->bytesCount;
+    }
+    assert (CODER_LIST == item->type);
 
-    itemReleaseMemory(item);
-    _rlpCoderReturnItemInternal (coder, prev, item, next);
+    uint8_t bytes9Count, bytes9[9];
+    encodeLengthIntoBytes (item->bytesCount - item->prefixCount, RLP_PREFIX_LIST, bytes9, &bytes9Count);
+    assert (bytes9Count == item->prefixCount);
+    memcpy (bytes, bytes9, bytes9Count);
+
+    size_t bytesIndex = bytes9Count;
+    for (size_t index = 0; index < item->itemsCount; index++)
+        bytesIndex += _rlpItemWriteInternal (item->items[index], &bytes[bytesIndex], adopt);
+    assert (bytesIndex == item->bytesCount);
+
+    if (adopt) item->bytes = bytes;
+    return bytesIndex;
 }
 
+/**
+ * Stream the encoding of `item` into `keccak`.
+ */
 static void
-rlpCoderReleaseItem (BRRlpCoder coder, BRRlpItem item) {
-    pthread_mutex_lock(&coder->lock);
-    _rlpCoderReleaseItemInternal (coder, item);
-    pthread_mutex_unlock(&coder->lock);
-}
+_rlpItemKeccakInternal (BRRlpItem item, BRKeccak keccak) {
+    if (NULL != item->bytes) {
+        keccak_update (keccak, item->bytes, item->bytesCount);
+        return;
+    }
 
-static int
-itemIsValid (BRRlpCoder coder, BRRlpItem item) {
-    return 1;
+    uint8_t bytes9Count, bytes9[9];
+    encodeLengthIntoBytes (item->bytesCount - item->prefixCount, RLP_PREFIX_LIST, bytes9, &bytes9Count);
+    keccak_update (keccak, bytes9, bytes9Count);
+
+    for (size_t index = 0; index < item->itemsCount; index++)
+        _rlpItemKeccakInternal (item->items[index], keccak);
 }
 
-static BRRlpItem
-itemCreateEmpty (BRRlpCoder coder, BRRlpItemType type) {
-    BRRlpItem item = rlpCoderAcquireItem(coder); // calloc (1, sizeof (struct BRRlpItemRecord));
-    item->type = type;
-    return item;
+/**
+ * Ensure that `item` has its bytes, writing them into the arena if needed.  All sub-items then
+ * share those bytes.
+ */
+static void
+_rlpItemEnsureBytesInternal (BRRlpCoder coder, BRRlpItem item) {
+    if (NULL == item->bytes)
+        _rlpItemWriteInternal (item,
+                               _rlpCoderArenaAlloc (coder, item->bytesCount, &item->bytesAllocated),
+                               1);
 }
 
 static uint8_t *
-itemEnsureBytes (BRRlpCoder coder, BRRlpItem item, size_t bytesCount) {
-    assert (NULL == item->bytes);
-    item->bytesCount = bytesCount;
-    item->bytes = (item->bytesCount > ITEM_DEFAULT_BYTES_COUNT
-                   ? malloc (item->bytesCount)
-                   : item->bytesArray);
+rlpItemEnsureBytes (BRRlpCoder coder, BRRlpItem item) {
+    if (NULL == item->bytes) {
+        rlpCoderLock (coder);
+        _rlpItemEnsureBytesInternal (coder, item);
+        rlpCoderUnlock (coder);
+    }
     return item->bytes;
 }
 
-static BRRlpItem
-itemFillList (BRRlpCoder coder, BRRlpItem item, BRRlpItem *items, size_t itemsCount) {
+static int
+itemIsValid (BRRlpCoder coder, BRRlpItem item) {
+    return 1;
+}
+
+static void
+_itemFillListInternal (BRRlpCoder coder, BRRlpItem item, BRRlpItem *items, size_t itemsCount) {
     item->type = CODER_LIST;
     item->itemsCount = itemsCount;
-    item->items = (item->itemsCount > ITEM_DEFAULT_ITEMS_COUNT
-                   ? calloc (item->itemsCount, sizeof (BRRlpItem))
-                   : item->itemsArray);
-    for (int i = 0; i < itemsCount; i++)
-        item->items[i] = items[i];
-    return item;
+    item->items = (0 == itemsCount
+                   ? NULL
+                   : _rlpCoderArenaAlloc (coder, itemsCount * sizeof (BRRlpItem), &item->itemsAllocated));
+    if (0 != itemsCount)
+        memcpy (item->items, items, itemsCount * sizeof (BRRlpItem));
 }
 
 extern void
@@ -346,10 +563,6 @@ convertFromBigEndian (uint8_t *target, size_t targetCount, uint8_t *bytes, size_
     swapBytesIfLittleEndian(target, value, targetCount);
 }
 
-#define RLP_PREFIX_BYTES  (0x80)
-#define RLP_PREFIX_LIST   (0xc0)
-#define RLP_PREFIX_LENGTH_LIMIT  (55)
-
 static void
 encodeLengthIntoBytes (uint64_t length, uint8_t baseline,
                        uint8_t *bytes9, uint8_t *bytes9Count) {
@@ -458,12 +671,12 @@ rlpDataDecodeUInt64 (BRRlpData data) {
 
 static BRRlpItem
 coderEncodeBytes(BRRlpCoder coder, uint8_t *bytes, size_t bytesCount) {
-    BRRlpItem item = itemCreateEmpty(coder, CODER_ITEM);
+    BRRlpItem item;
 
     // Encode a single byte directly
     if (1 == bytesCount && bytes[0] < RLP_PREFIX_BYTES) {
-        uint8_t *encodedBytes = itemEnsureBytes(coder, item, 1);
-        encodedBytes[0] = bytes[0];
+        item = rlpCoderAcquireItemWithBytes (coder, CODER_ITEM, 1);
+        item->bytes[0] = bytes[0];
     }
     
     // otherwise, encode the length and then the bytes themselves
@@ -471,9 +684,9 @@ coderEncodeBytes(BRRlpCoder coder, uint8_t *bytes, size_t bytesCount) {
         uint8_t bytes9Count, bytes9[9];
         encodeLengthIntoBytes(bytesCount, RLP_PREFIX_BYTES, bytes9, &bytes9Count);
 
-        uint8_t *encodedBytes = itemEnsureBytes(coder, item, bytes9Count + bytesCount);
-        memcpy(encodedBytes, bytes9, bytes9Count);
-        memcpy(&encodedBytes[bytes9Count], bytes, bytesCount);
+        item = rlpCoderAcquireItemWithBytes (coder, CODER_ITEM, bytes9Count + bytesCount);
+        memcpy(item->bytes, bytes9, bytes9Count);
+        memcpy(&item->bytes[bytes9Count], bytes, bytesCount);
     }
     return item;
 }
@@ -541,10 +754,7 @@ coderEncodeList (BRRlpCoder coder, BRRlpItem *items, size_t itemsCount) {
         assert (itemIsValid(coder, items[i]));
     }
 
-    // Acquire an item
-    BRRlpItem item = rlpCoderAcquireItem(coder);
-
-    // Eventually fill these by concatentating bytes from each of `items`
+    // The encoding is the concatenated bytes from each of `items`, eventually...
     size_t bytesCount = 0;
 
     // Determine the number of concatenated bytes...
@@ -555,20 +765,15 @@ coderEncodeList (BRRlpCoder coder, BRRlpItem *items, size_t itemsCount) {
     uint8_t bytes9Count, bytes9[9];
     encodeLengthIntoBytes (bytesCount, RLP_PREFIX_LIST, bytes9, &bytes9Count);
 
-    // ... now allocate the memory needed as length-encoding-prefix + bytes
-    uint8_t *bytes = itemEnsureBytes (coder, item, bytes9Count + bytesCount);
+    // ... now acquire an item, sized as length-encoding-prefix + bytes, with the sub-items.  The
+    // bytes themselves are written when needed.
+    rlpCoderLock (coder);
+    BRRlpItem item = _rlpCoderAcquireItemInternal (coder, CODER_LIST);
+    item->bytesCount  = bytes9Count + bytesCount;
+    item->prefixCount = bytes9Count;
+    _itemFillListInternal (coder, item, items, itemsCount);
+    rlpCoderUnlock (coder);
 
-    // ... now fill in the length encoding
-    memcpy (bytes, bytes9, bytes9Count);
-
-    // ... and concatenate the bytes from items
-    for (size_t bytesIndex = bytes9Count, i = 0; i < itemsCount; i++) {
-        BRRlpItem itemContext = items[i];
-        memcpy (&bytes[bytesIndex], itemContext->bytes, itemContext->bytesCount);
-        bytesIndex += itemContext->bytesCount;
-    }
-
-    itemFillList(coder, item, items, itemsCount);
     return item;
 }
 
@@ -665,6 +870,7 @@ rlpDecodeBytes (BRRlpCoder coder, BRRlpItem item) {
 static BRRlpData
 rlpDecodeBytesSharedDontReleaseBaseline (BRRlpCoder coder, BRRlpItem item, uint8_t baseline) {
     assert (itemIsValid (coder, item));
+    rlpItemEnsureBytes (coder, item);
 
     uint8_t offset = 0;
     size_t length = decodeLength(item->bytes, baseline, &offset);
@@ -828,6 +1034,7 @@ rlpDecodeList (BRRlpCoder coder, BRRlpItem item, size_t *itemsCount) {
             *itemsCount = 0;
             return NULL;
         case CODER_LIST:
+            rlpItemFillSubItems (coder, item);
             *itemsCount = item->itemsCount;
             return item->items;
     }
@@ -861,7 +1068,7 @@ rlpDataExtract (BRRlpCoder coder, BRRlpItem item, uint8_t **bytes, size_t *bytes
     
     *bytesCount = item->bytesCount;
     *bytes = malloc (*bytesCount);
-    memcpy (*bytes, item->bytes, item->bytesCount);
+    rlpItemFillData (coder, item, *bytes);
 }
 
 extern BRRlpData
@@ -874,10 +1081,51 @@ rlpItemGetData (BRRlpCoder coder, BRRlpItem item) {
 extern BRRlpData
 rlpItemGetDataSharedDontRelease (BRRlpCoder coder, BRRlpItem item) {
     assert (itemIsValid(coder, item));
-    BRRlpData result = { item->bytesCount, item->bytes };
+    BRRlpData result = { item->bytesCount, rlpItemEnsureBytes (coder, item) };
     return result;
 }
 
+extern size_t
+rlpItemGetDataBytesCount (BRRlpCoder coder, BRRlpItem item, size_t *prefixCount) {
+    assert (itemIsValid(coder, item));
+    if (NULL != prefixCount) {
+        uint8_t offset = 0;
+        switch (item->type) {
+            case CODER_ITEM:
+                decodeLength (item->bytes, RLP_PREFIX_BYTES, &offset);
+                break;
+            case CODER_LIST:
+                if (NULL == item->bytes) offset = item->prefixCount;
+                else decodeLength (item->bytes, RLP_PREFIX_LIST, &offset);
+                break;
+        }
+        *prefixCount = offset;
+    }
+    return item->bytesCount;
+}
+
+extern void
+rlpItemFillData (BRRlpCoder coder, BRRlpItem item, uint8_t *bytes) {
+    assert (itemIsValid(coder, item));
+    _rlpItemWriteInternal (item, bytes, 0);
+}
+
+extern UInt256
+rlpItemGetKeccak256 (BRRlpCoder coder, BRRlpItem item) {
+    assert (itemIsValid(coder, item));
+    UInt256 hash;
+
+    if (NULL != item->bytes)
+        BRKeccak256 (hash.u8, item->bytes, item->bytesCount);
+    else {
+        BRKeccak keccak = keccak_create256();
+        _rlpItemKeccakInternal (item, keccak);
+        keccak_final (keccak, hash.u8);
+        keccak_release (keccak);
+    }
+    return hash;
+}
+
 /**
  * Return `data` with `bytes` and bytesCount derived from the bytes[0] and associated length.
  */
@@ -900,76 +1148,308 @@ rlpGetItem_FillData (BRRlpCoder coder, uint8_t *bytes) {
 
 #define DEFAULT_ITEM_INCREMENT 20
 
+/**
+ * Acquire an item sharing `bytes`, as the RLP encoding of `bytesCount`.  If the encoding is a
+ * RLP list, then the item's sub-items are pending.
+ */
+static BRRlpItem
+_rlpCoderAcquireItemDecodedInternal (BRRlpCoder coder, uint8_t *bytes, size_t bytesCount) {
+    int isList = bytes[0] >= RLP_PREFIX_LIST;
+
+    BRRlpItem item = _rlpCoderAcquireItemWithBytesInternal (coder,
+                                                            (isList ? CODER_LIST : CODER_ITEM),
+                                                            bytes, bytesCount);
+    item->itemsPending = isList;
+    return item;
+}
+
+/**
+ * If `item` has pending sub-items, then fill in `item` with its sub-items.  The sub-items share
+ * the bytes of `item`; any sub-item that is itself a list has its own sub-items pending.
+ */
+static void
+_rlpItemFillSubItemsInternal (BRRlpCoder coder, BRRlpItem item) {
+    if (!item->itemsPending) return;
+    item->itemsPending = 0;
+
+    // We'll consume `bytes` with sub-items.
+    // We can have an arbitrary number of sub-times.  Assume we have DEFAULT_ITEM_INCREMENT
+    // but be willing to increase the number if needed.
+    BRRlpItem itemsArray[DEFAULT_ITEM_INCREMENT];
+    size_t itemsIndex = 0;
+    size_t itemsCount = DEFAULT_ITEM_INCREMENT;
+
+    // We'll use this to accumulate subitems.
+    BRRlpItem *items = itemsArray;
+
+    // The upper limit on bytes to consume.
+    uint8_t *bytesLimit = item->bytes + item->bytesCount;
+    uint8_t *bytes = item->bytes;
+
+    // Start of `bytes` encodes a list with a number of bytes.  We'll start extracting
+    // sub-items after the list's length.
+    uint8_t bytesOffset = 0;
+    size_t bytesCount = decodeLength(item->bytes, RLP_PREFIX_LIST, &bytesOffset);
+    assert (item->bytesCount == bytesCount + bytesOffset);
+
+    // Start of the first sub-item
+    bytes += bytesOffset;
+
+    while (bytes < bytesLimit) {
+        // Get the `data` for this sub-item
+        BRRlpData d = rlpGetItem_FillData(coder, bytes);
+        items[itemsIndex++] = _rlpCoderAcquireItemDecodedInternal (coder, d.bytes, d.bytesCount);
+
+        // Move to the next sub-item
+        bytes += d.bytesCount;
+
+        // Extend `items` is we've used the allocated number.
+        if (itemsIndex == itemsCount) {
+            itemsCount += DEFAULT_ITEM_INCREMENT;
+            if (items == itemsArray) {
+                // Move 'off' the stack allocated array.
+                items = malloc(itemsCount * sizeof(BRRlpItem));
+                memcpy (items, itemsArray, itemsIndex * sizeof(BRRlpItem));
+            }
+            else
+                items = realloc(items, itemsCount * sizeof (BRRlpItem));
+        }
+    }
+    _itemFillListInternal (coder, item, items, itemsIndex);
+
+    if (items != itemsArray) free(items);
+}
+
+static void
+rlpItemFillSubItems (BRRlpCoder coder, BRRlpItem item) {
+    if (item->itemsPending) {
+        rlpCoderLock (coder);
+        _rlpItemFillSubItemsInternal (coder, item);
+        rlpCoderUnlock (coder);
+    }
+}
+
 /**
  * Convet the bytes in `data` into an `item`.  If `data` represents a RLP list, then `item` will
- * represent a list.
+ * represent a list.  The bytes in `data` are copied once; all sub-items reference that copy.
  */
 extern BRRlpItem
 rlpDataGetItem (BRRlpCoder coder, BRRlpData data) {
     assert (0 != data.bytesCount);
 
-    BRRlpItem result = rlpCoderAcquireItem (coder);
-    uint8_t *encodedBytes = itemEnsureBytes (coder, result, data.bytesCount);
-    memcpy (encodedBytes, data.bytes, data.bytesCount);
+    rlpCoderLock (coder);
+    uint8_t bytesAllocated;
+    uint8_t *bytes = _rlpCoderArenaAlloc (coder, data.bytesCount, &bytesAllocated);
+    memcpy (bytes, data.bytes, data.bytesCount);
 
-    uint8_t prefix = data.bytes[0];
+    BRRlpItem result = _rlpCoderAcquireItemDecodedInternal (coder, bytes, data.bytesCount);
+    result->bytesAllocated = bytesAllocated;
+    rlpCoderUnlock (coder);
 
-    // If not a list, then we are done; just return an `item` with `data`
-    if (prefix < RLP_PREFIX_LIST) {
-        return result;
-    }
+    return result;
+}
+
+//
+// View
+//
+
+/**
+ * Fill `view` with the RLP encoding starting at `bytes`.  The encoding must not extend beyond
+ * `bytesLimit`.  Return 0, with `view` unchanged, if the encoding is malformed or too long.
+ */
+static int
+rlpViewFill (const uint8_t *bytes, const uint8_t *bytesLimit, BRRlpView *view) {
+    if (NULL == bytes || bytes >= bytesLimit) return 0;
+
+    size_t bytesCount = (size_t) (bytesLimit - bytes);
+    uint8_t prefix = bytes[0];
+
+    size_t prefixCount, payloadCount;
 
-    // If a list, then we'll consume `data` with sub-items.
+    // A single byte is its own encoding
+    if (prefix < RLP_PREFIX_BYTES) {
+        prefixCount  = 0;
+        payloadCount = 1;
+    }
     else {
-        // We can have an arbitrary number of sub-times.  Assume we have DEFAULT_ITEM_INCREMENT
-        // but be willing to increase the number if needed.
-        BRRlpItem itemsArray[DEFAULT_ITEM_INCREMENT];
-        size_t itemsIndex = 0;
-        size_t itemsCount = DEFAULT_ITEM_INCREMENT;
-
-        // We'll use this to accumulate subitems.
-        BRRlpItem *items = itemsArray;
-
-        // The upper limit on bytes to consume.
-        uint8_t *bytesLimit = data.bytes + data.bytesCount;
-        uint8_t *bytes = data.bytes;
-
-        // Start of `data` encodes a list with a number of bytes.  We'll start extracting
-        // sub-items after the list's length.
-        uint8_t bytesOffset = 0;
-        size_t bytesCount = decodeLength(data.bytes, RLP_PREFIX_LIST, &bytesOffset);
-        assert (data.bytesCount == bytesCount + bytesOffset);
-
-        // Start of the first sub-item
-        bytes += bytesOffset;
-        
-        while (bytes < bytesLimit) {
-            // Get the `data` for this sub-item and then recurse
-            BRRlpData d = rlpGetItem_FillData(coder, bytes);
-            items[itemsIndex++] = rlpDataGetItem (coder, d);
-
-            // Move to the next sub-item
-            bytes += d.bytesCount;
-
-            // Extend `items` is we've used the allocated number.
-            if (itemsIndex == itemsCount) {
-                itemsCount += DEFAULT_ITEM_INCREMENT;
-                if (items == itemsArray) {
-                    // Move 'off' the stack allocated array.
-                    items = malloc(itemsCount * sizeof(BRRlpItem));
-                    memcpy (items, itemsArray, itemsIndex * sizeof(BRRlpItem));
-                }
-                else
-                    items = realloc(items, itemsCount * sizeof (BRRlpItem));
-            }
+        uint8_t baseline = (prefix < RLP_PREFIX_LIST ? RLP_PREFIX_BYTES : RLP_PREFIX_LIST);
+
+        // A short length is encoded in the prefix itself...
+        if ((prefix - baseline) <= RLP_PREFIX_LENGTH_LIMIT) {
+            prefixCount  = 1;
+            payloadCount = prefix - baseline;
         }
-        itemFillList(coder, result, items, itemsIndex);
 
-        if (items != itemsArray) free(items);
+        // ... otherwise the prefix encodes the number of big-endian bytes that encode the length
+        else {
+            size_t lengthBytesCount = (prefix - baseline) - RLP_PREFIX_LENGTH_LIMIT;
+            if (bytesCount < 1 + lengthBytesCount) return 0;
+
+            uint64_t length = 0;
+            for (size_t index = 1; index <= lengthBytesCount; index++)
+                length = (length << 8) | bytes[index];
+
+            // Checked here, before any narrowing to size_t
+            if (length > bytesCount) return 0;
+
+            prefixCount  = 1 + lengthBytesCount;
+            payloadCount = (size_t) length;
+        }
+    }
+
+    if (payloadCount > bytesCount - prefixCount) return 0;
+
+    view->bytesCount  = prefixCount + payloadCount;
+    view->bytes       = bytes;
+    view->prefixCount = (uint8_t) prefixCount;
+    return 1;
+}
+
+extern BRRlpView
+rlpViewCreate (BRRlpData data) {
+    BRRlpView view = { 0, NULL, 0 };
+    if (NULL != data.bytes) rlpViewFill (data.bytes, data.bytes + data.bytesCount, &view);
+    return view;
+}
+
+extern int
+rlpViewIsValid (BRRlpView view) {
+    return NULL != view.bytes;
+}
+
+extern int
+rlpViewIsList (BRRlpView view) {
+    return NULL != view.bytes && view.bytes[0] >= RLP_PREFIX_LIST;
+}
+
+extern BRRlpData
+rlpViewGetData (BRRlpView view) {
+    return (BRRlpData) { view.bytesCount, (uint8_t *) view.bytes };
+}
+
+extern BRRlpData
+rlpViewDecodeBytes (BRRlpView view) {
+    return (NULL == view.bytes
+            ? (BRRlpData) { 0, NULL }
+            : (BRRlpData) { view.bytesCount - view.prefixCount, (uint8_t *) &view.bytes[view.prefixCount] });
+}
+
+static int
+rlpViewIsEmptyString (BRRlpView view) {
+    return (NULL != view.bytes
+            && 1 == view.bytesCount
+            && RLP_PREFIX_BYTES == view.bytes[0]);
+}
+
+static void
+rlpViewDecodeNumber (BRRlpView view, int zeroAsEmptyString, int *failed,
+                     uint8_t *target, size_t targetCount) {
+    // `target` is zero; an empty string leaves it so
+    if (1 == zeroAsEmptyString && rlpViewIsEmptyString (view)) return;
+
+    BRRlpData data = rlpViewDecodeBytes (view);
+    if (!rlpViewIsValid (view) || rlpViewIsList (view) || data.bytesCount > targetCount) {
+        if (NULL != failed) *failed = 1;
+        return;
     }
+
+    convertFromBigEndian (target, targetCount, data.bytes, data.bytesCount);
+}
+
+extern uint64_t
+rlpViewDecodeUInt64 (BRRlpView view, int zeroAsEmptyString, int *failed) {
+    uint64_t value = 0;
+    rlpViewDecodeNumber (view, zeroAsEmptyString, failed, (uint8_t *) &value, sizeof (uint64_t));
+    return value;
+}
+
+extern UInt256
+rlpViewDecodeUInt256 (BRRlpView view, int zeroAsEmptyString, int *failed) {
+    UInt256 value = UINT256_ZERO;
+    rlpViewDecodeNumber (view, zeroAsEmptyString, failed, (uint8_t *) &value, sizeof (UInt256));
+    return value;
+}
+
+extern char *
+rlpViewDecodeHexString (BRRlpView view, const char *prefix) {
+    BRRlpData data = rlpViewDecodeBytes (view);
+    if (NULL == prefix) prefix = "";
+
+    char *result = malloc (strlen(prefix) + 2 * data.bytesCount + 1);
+    strcpy (result, prefix);
+    hexEncode(&result[strlen(prefix)], 2 * data.bytesCount + 1, data.bytes, data.bytesCount);
+
     return result;
 }
 
+extern UInt256
+rlpViewGetKeccak256 (BRRlpView view) {
+    UInt256 hash;
+    BRKeccak256 (hash.u8, view.bytes, view.bytesCount);
+    return hash;
+}
+
+extern BRRlpViewCursor
+rlpViewGetCursor (BRRlpView view) {
+    BRRlpViewCursor cursor = { NULL, NULL, 0 };
+
+    if (rlpViewIsList (view)) {
+        cursor.bytes      = &view.bytes[view.prefixCount];
+        cursor.bytesLimit = &view.bytes[view.bytesCount];
+    }
+    else cursor.failed = 1;
+
+    return cursor;
+}
+
+extern int
+rlpViewCursorNext (BRRlpViewCursor *cursor, BRRlpView *view) {
+    if (cursor->failed || cursor->bytes == cursor->bytesLimit) return 0;
+
+    if (!rlpViewFill (cursor->bytes, cursor->bytesLimit, view)) {
+        cursor->failed = 1;
+        return 0;
+    }
+
+    cursor->bytes += view->bytesCount;
+    return 1;
+}
+
+extern size_t
+rlpViewGetListCount (BRRlpView view) {
+    return rlpViewDecodeList (view, NULL, 0);
+}
+
+extern size_t
+rlpViewDecodeList (BRRlpView view, BRRlpView *views, size_t viewsCount) {
+    BRRlpViewCursor cursor = rlpViewGetCursor (view);
+    BRRlpView item;
+    size_t count = 0;
+
+    while (rlpViewCursorNext (&cursor, &item)) {
+        if (count < viewsCount) views[count] = item;
+        count += 1;
+    }
+
+    return cursor.failed ? 0 : count;
+}
+
+extern BRRlpView
+rlpItemGetView (BRRlpCoder coder, BRRlpItem item) {
+    assert (itemIsValid(coder, item));
+    uint8_t *bytes = rlpItemEnsureBytes (coder, item);
+
+    BRRlpView view = { 0, NULL, 0 };
+    rlpViewFill (bytes, bytes + item->bytesCount, &view);
+    return view;
+}
+
+extern BRRlpItem
+rlpViewGetItem (BRRlpCoder coder, BRRlpView view) {
+    assert (rlpViewIsValid (view));
+    return rlpDataGetItem (coder, rlpViewGetData (view));
+}
+
 //
 // Show
 //
@@ -984,6 +1464,7 @@ rlpItemShowInternal (BRRlpCoder coder, BRRlpItem context, const char *topic, int
 
     switch (context->type) {
         case CODER_LIST:
+            rlpItemFillSubItems (coder, context);
             if (0 == context->itemsCount)
                 eth_log(topic, "%sL  0: []", spaces);
             else {
@@ -1027,10 +1508,11 @@ rlpItemShow (BRRlpCoder coder, BRRlpItem item, const char *topic) {
 
 extern void
 rlpDataShow (BRRlpData data, const char *topic) {
-    BRRlpCoder coder = rlpCoderCreate();
+    BRRlpCoder coder = rlpCoderCreateThreadConfined();
     BRRlpItem item = rlpDataGetItem(coder, data);
     rlpItemShow (coder, item, topic);
     rlpItemRelease(coder, item);
+    rlpCoderRelease(coder);
 }
 
 /*
@@ -27,16 +27,31 @@ typedef struct BRRlpCoderRecord *BRRlpCoder;
 extern BRRlpCoder
 rlpCoderCreate (void);
 
+/**
+ * Create a coder that is only ever used by the calling thread.  Such a coder skips locking on
+ * every item acquire and release.
+ */
+extern BRRlpCoder
+rlpCoderCreateThreadConfined (void);
+
 extern void
 rlpCoderRelease (BRRlpCoder coder);
 
 /**
  * Reclaim coder memory. A coder can hold memory to avoid repeated free/malloc calls.  If
- * desired one can reclaim coder memory that is unused.
+ * desired one can reclaim coder memory that is unused.  If no item is outstanding, then all
+ * item and arena memory is returned wholesale.
  */
 extern void
 rlpCoderReclaim (BRRlpCoder coder);
 
+/**
+ * Fill `itemsCount` with the number of items allocated by `coder` and `bytesCount` with the
+ * memory held for those items and their bytes (excluding large, individually malloc'd bytes).
+ */
+extern void
+rlpCoderGetStats (BRRlpCoder coder, size_t *itemsCount, size_t *bytesCount);
+
 extern void
 rlpCoderSetFailed (BRRlpCoder coder);
 
@@ -70,7 +85,8 @@ rlpItemRelease (BRRlpCoder coder, BRRlpItem item);
 
 /**
  * Convet the bytes in `data` into an `item`.  If `data` represents a RLP list, then `item` will
- * represent a list (thus `data` is 'walked' to identify subitems, including sublists).
+ * represent a list (thus `data` is 'walked' to identify subitems, including sublists, but only
+ * when rlpDecodeList() first needs them).
  */
 extern BRRlpItem
 rlpDataGetItem (BRRlpCoder coder, BRRlpData data);
@@ -90,6 +106,28 @@ rlpItemGetData (BRRlpCoder coder, BRRlpItem item);
 extern BRRlpData
 rlpItemGetDataSharedDontRelease (BRRlpCoder coder, BRRlpItem item);
 
+/**
+ * Return the number of bytes in the RLP encoding of `item`.  If `prefixCount` is not NULL, fill
+ * it with the number of those bytes encoding the length - for a list, the remaining bytes are the
+ * encodings of the sub-items.
+ */
+extern size_t
+rlpItemGetDataBytesCount (BRRlpCoder coder, BRRlpItem item, size_t *prefixCount);
+
+/**
+ * Write the RLP encoding of `item` into `bytes`, which must hold rlpItemGetDataBytesCount()
+ * bytes.  The encoding is written in a single pass, without intermediate copies.
+ */
+extern void
+rlpItemFillData (BRRlpCoder coder, BRRlpItem item, uint8_t *bytes);
+
+/**
+ * Return the Keccak-256 hash of the RLP encoding of `item`.  The encoding is streamed into the
+ * hash; it is not otherwise written.
+ */
+extern UInt256
+rlpItemGetKeccak256 (BRRlpCoder coder, BRRlpItem item);
+
 /**
  * Extract the `bytes` and `bytesCount` for `item`.  The returns `bytes` will be the complete
  * RLP encoding for `item` which includes the RLP encoding of length.  Contrast this with
@@ -191,6 +229,116 @@ rlpEncodeListItems (BRRlpCoder coder, BRRlpItem *items, size_t itemsCount);
 extern const BRRlpItem *
 rlpDecodeList (BRRlpCoder coder, BRRlpItem item, size_t *itemsCount);
     
+//
+// View
+//
+
+/**
+ * A read-only view of a single RLP encoding - `bytes` references the complete encoding, including
+ * the RLP length prefix of `prefixCount` bytes, within a buffer owned by someone else.  A view
+ * neither copies nor allocates; it is valid only as long as the referenced buffer.  A view with
+ * NULL `bytes` is invalid; invalid views result from malformed or truncated encodings and, when
+ * decoded, produce empty data and zero values.
+ */
+typedef struct {
+    size_t bytesCount;
+    const uint8_t *bytes;
+    uint8_t prefixCount;
+} BRRlpView;
+
+/**
+ * Create a view of the RLP encoding at the start of `data`.  The view is invalid if the encoding
+ * is malformed or extends beyond `data`.
+ */
+extern BRRlpView
+rlpViewCreate (BRRlpData data);
+
+extern int
+rlpViewIsValid (BRRlpView view);
+
+extern int
+rlpViewIsList (BRRlpView view);
+
+/**
+ * Return the complete RLP encoding of `view`.  You DO NOT own this data.
+ */
+extern BRRlpData
+rlpViewGetData (BRRlpView view);
+
+/**
+ * Return the `view` bytes w/o the RLP encoding of length.  You DO NOT own this data.
+ */
+extern BRRlpData
+rlpViewDecodeBytes (BRRlpView view);
+
+/**
+ * Return the number of `view`.  As for rlpDecodeUInt64(), an empty string is zero - with
+ * `zeroAsEmptyString` that is how zero is encoded.  If `view` is invalid, is a list or holds more
+ * bytes than the number, then zero is returned and, if `failed` is not NULL, `*failed` is set;
+ * `*failed` is never cleared, so one flag can collect the failures of several decodes.
+ */
+extern uint64_t
+rlpViewDecodeUInt64 (BRRlpView view, int zeroAsEmptyString, int *failed);
+
+extern UInt256
+rlpViewDecodeUInt256 (BRRlpView view, int zeroAsEmptyString, int *failed);
+
+/**
+ * Return the `view` bytes, hex-encoded, following `prefix`.  You own the returned string.
+ */
+extern char *
+rlpViewDecodeHexString (BRRlpView view, const char *prefix);
+
+extern UInt256
+rlpViewGetKeccak256 (BRRlpView view);
+
+/**
+ * A cursor over the sub-items of a RLP list view.  Each sub-item is only identified, by its
+ * offset and length, as the cursor reaches it.
+ */
+typedef struct {
+    const uint8_t *bytes;
+    const uint8_t *bytesLimit;
+    int failed;
+} BRRlpViewCursor;
+
+/**
+ * Return a cursor at the first sub-item of `view`.  If `view` is not a valid list, then the
+ * cursor has `failed`.
+ */
+extern BRRlpViewCursor
+rlpViewGetCursor (BRRlpView view);
+
+/**
+ * Advance `cursor`, filling `view` with the next sub-item.  Return 0 when no sub-items remain or,
+ * with the cursor's `failed` set, if the next sub-item is malformed.
+ */
+extern int
+rlpViewCursorNext (BRRlpViewCursor *cursor, BRRlpView *view);
+
+extern size_t
+rlpViewGetListCount (BRRlpView view);
+
+/**
+ * Fill `views`, up to `viewsCount`, with the sub-items of the list `view` and return the number
+ * of sub-items - which may exceed `viewsCount`.  If `view` is not a list or is malformed, then
+ * zero is returned.
+ */
+extern size_t
+rlpViewDecodeList (BRRlpView view, BRRlpView *views, size_t viewsCount);
+
+/**
+ * Return a view of `item`.  The view is valid until `item` is released.
+ */
+extern BRRlpView
+rlpItemGetView (BRRlpCoder coder, BRRlpItem item);
+
+/**
+ * Return an item, as a copy, of `view`.  You own the item and must call rlpItemRelease().
+ */
+extern BRRlpItem
+rlpViewGetItem (BRRlpCoder coder, BRRlpView view);
+
 //
 // Show
 //
@@ -26,6 +26,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // endian swapping
 #if __BIG_ENDIAN__ || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
@@ -202,6 +207,58 @@ void BRSHA256_2(void *md32, const void *data, size_t dataLen)
     BRSHA256(md32, t, sizeof(t));
 }
 
+void BRSHA256Init(BRSHA256Context *ctx)
+{
+    static const uint32_t buf[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                    0x1f83d9ab, 0x5be0cd19 }; // initial buffer values
+
+    assert(ctx != NULL);
+    memcpy(ctx->buf, buf, sizeof(buf));
+    ctx->len = 0;
+}
+
+void BRSHA256Update(BRSHA256Context *ctx, const void *data, size_t dataLen)
+{
+    size_t i = 0, n, used;
+
+    assert(ctx != NULL);
+    assert(data != NULL || dataLen == 0);
+    used = (size_t)(ctx->len % 64);
+    ctx->len += dataLen;
+
+    if (used > 0) { // fill the partial block left by the previous update
+        n = (64 - used < dataLen) ? 64 - used : dataLen;
+        memcpy((uint8_t *)ctx->x + used, data, n);
+        i = n;
+        if (used + n < 64) return;
+        _BRSHA256Compress(ctx->buf, ctx->x);
+    }
+
+    for (; i + 64 <= dataLen; i += 64) { // process data in 64 byte blocks
+        memcpy(ctx->x, (const uint8_t *)data + i, 64);
+        _BRSHA256Compress(ctx->buf, ctx->x);
+    }
+
+    if (i < dataLen) memcpy(ctx->x, (const uint8_t *)data + i, dataLen - i);
+}
+
+void BRSHA256Final(BRSHA256Context *ctx, void *md32)
+{
+    size_t i, used;
+
+    assert(ctx != NULL);
+    assert(md32 != NULL);
+    used = (size_t)(ctx->len % 64);
+    memset((uint8_t *)ctx->x + used, 0, 64 - used); // clear remainder of x
+    ((uint8_t *)ctx->x)[used] = 0x80; // append padding
+    if (used >= 56) _BRSHA256Compress(ctx->buf, ctx->x), memset(ctx->x, 0, 64); // length goes to next block
+    ctx->x[14] = be32((uint32_t)(ctx->len >> 29)), ctx->x[15] = be32((uint32_t)(ctx->len << 3)); // length in bits
+    _BRSHA256Compress(ctx->buf, ctx->x); // finalize
+    for (i = 0; i < 8; i++) ctx->buf[i] = be32(ctx->buf[i]); // endian swap
+    memcpy(md32, ctx->buf, 32); // write to md
+    mem_clean(ctx, sizeof(*ctx));
+}
+
 // bitwise right rotation
 #define ror64(a, b) (((a) >> (b)) | ((a) << (64 - (b))))
 
@@ -498,6 +555,30 @@ void BRKeccak256(void *md32, const void *data, size_t dataLen)
     mem_clean(buf, sizeof(buf));
 }
 
+void BRKeccak512(void *md64, const void *data, size_t dataLen)
+{
+    size_t i;
+    uint64_t x[9], buf[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    
+    assert(md64 != NULL);
+    assert(data != NULL || dataLen == 0);
+    
+    for (i = 0; i <= dataLen; i += 72) { // process data in 72 byte blocks
+        memcpy(x, (const uint8_t *)data + i, (i + 72 < dataLen) ? 72 : dataLen - i);
+        if (i + 72 > dataLen) break;
+        _BRSHA3Compress(buf, x, 72);
+    }
+    
+    memset((uint8_t *)x + (dataLen - i), 0, 72 - (dataLen - i)); // clear remainder of x
+    ((uint8_t *)x)[dataLen - i] |= 0x01; // append padding
+    ((uint8_t *)x)[71] |= 0x80;
+    _BRSHA3Compress(buf, x, 72); // finalize
+    for (i = 0; i < 8; i++) buf[i] = le64(buf[i]); // endian swap
+    memcpy(md64, buf, 64); // write to md
+    mem_clean(x, sizeof(x));
+    mem_clean(buf, sizeof(buf));
+}
+
 // basic md5 functions
 #define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
 #define G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
@@ -1098,6 +1179,110 @@ void BRAESCTR_OFFSET(void *out, size_t outLen, const void *key, size_t keyLen, v
 
 
 
+// precompute the sha512 states after compressing the hmac (key xor ipad) and (key xor opad) blocks, which are the
+// same for every hmac computed with key
+static void _BRHMACSHA512States(uint64_t istate[8], uint64_t ostate[8], const void *key, size_t keyLen)
+{
+    static const uint64_t iv[] = { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                                   0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 };
+    uint64_t k[16] = { 0 }, x[16];
+    size_t i;
+    
+    if (keyLen > sizeof(k)) BRSHA512(k, key, keyLen);
+    else if (keyLen > 0) memcpy(k, key, keyLen);
+    
+    for (i = 0; i < 16; i++) x[i] = k[i] ^ 0x3636363636363636;
+    memcpy(istate, iv, sizeof(iv));
+    _BRSHA512Compress(istate, x);
+    for (i = 0; i < 16; i++) x[i] = k[i] ^ 0x5c5c5c5c5c5c5c5c;
+    memcpy(ostate, iv, sizeof(iv));
+    _BRSHA512Compress(ostate, x);
+    mem_clean(k, sizeof(k));
+    mem_clean(x, sizeof(x));
+}
+
+// precompute the sha256 states after compressing the hmac (key xor ipad) and (key xor opad) blocks
+static void _BRHMACSHA256States(uint32_t istate[8], uint32_t ostate[8], const void *key, size_t keyLen)
+{
+    static const uint32_t iv[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint32_t k[16] = { 0 }, x[16];
+    size_t i;
+    
+    if (keyLen > sizeof(k)) BRSHA256(k, key, keyLen);
+    else if (keyLen > 0) memcpy(k, key, keyLen);
+    
+    for (i = 0; i < 16; i++) x[i] = k[i] ^ 0x36363636;
+    memcpy(istate, iv, sizeof(iv));
+    _BRSHA256Compress(istate, x);
+    for (i = 0; i < 16; i++) x[i] = k[i] ^ 0x5c5c5c5c;
+    memcpy(ostate, iv, sizeof(iv));
+    _BRSHA256Compress(ostate, x);
+    mem_clean(k, sizeof(k));
+    mem_clean(x, sizeof(x));
+}
+
+// Urounds = hmac_sha512(pw, Urounds-1) for rounds 2 through rounds, starting from the precomputed key states, with
+// a message that always fits a single padded block: two compressions per round instead of four
+static void _BRPBKDF2SHA512Rounds(void *T64, const void *U64, const uint64_t istate[8], const uint64_t ostate[8],
+                                  unsigned rounds)
+{
+    uint64_t x[16] = { 0 }, r[8], U[8], T[8];
+    unsigned i, j;
+    
+    memcpy(U, U64, sizeof(U));
+    memcpy(T, T64, sizeof(T));
+    
+    x[8] = be64(0x8000000000000000); // append padding
+    x[15] = be64((uint64_t)(128 + 64)*8); // append length in bits, (key xor pad) block plus a 64 byte message
+    
+    for (i = 1; i < rounds; i++) {
+        memcpy(x, U, 64);
+        memcpy(r, istate, sizeof(r));
+        _BRSHA512Compress(r, x); // hash((key xor ipad) || Urounds-1)
+        for (j = 0; j < 8; j++) x[j] = be64(r[j]);
+        memcpy(r, ostate, sizeof(r));
+        _BRSHA512Compress(r, x); // hash((key xor opad) || hash((key xor ipad) || Urounds-1))
+        for (j = 0; j < 8; j++) U[j] = be64(r[j]), T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
+    }
+    
+    memcpy(T64, T, sizeof(T));
+    mem_clean(x, sizeof(x));
+    mem_clean(r, sizeof(r));
+    mem_clean(U, sizeof(U));
+    mem_clean(T, sizeof(T));
+}
+
+// Urounds = hmac_sha256(pw, Urounds-1) for rounds 2 through rounds, starting from the precomputed key states
+static void _BRPBKDF2SHA256Rounds(void *T32, const void *U32, const uint32_t istate[8], const uint32_t ostate[8],
+                                  unsigned rounds)
+{
+    uint32_t x[16] = { 0 }, r[8], U[8], T[8];
+    unsigned i, j;
+    
+    memcpy(U, U32, sizeof(U));
+    memcpy(T, T32, sizeof(T));
+    
+    x[8] = be32(0x80000000); // append padding
+    x[15] = be32((uint32_t)(64 + 32)*8); // append length in bits, (key xor pad) block plus a 32 byte message
+    
+    for (i = 1; i < rounds; i++) {
+        memcpy(x, U, 32);
+        memcpy(r, istate, sizeof(r));
+        _BRSHA256Compress(r, x); // hash((key xor ipad) || Urounds-1)
+        for (j = 0; j < 8; j++) x[j] = be32(r[j]);
+        memcpy(r, ostate, sizeof(r));
+        _BRSHA256Compress(r, x); // hash((key xor opad) || hash((key xor ipad) || Urounds-1))
+        for (j = 0; j < 8; j++) U[j] = be32(r[j]), T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
+    }
+    
+    memcpy(T32, T, sizeof(T));
+    mem_clean(x, sizeof(x));
+    mem_clean(r, sizeof(r));
+    mem_clean(U, sizeof(U));
+    mem_clean(T, sizeof(T));
+}
+
 // dk = T1 || T2 || ... || Tdklen/hlen
 // Ti = U1 xor U2 xor ... xor Urounds
 // U1 = hmac_hash(pw, salt || be32(i))
@@ -1109,6 +1294,9 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
 {
     uint8_t s[saltLen + sizeof(uint32_t)];
     uint32_t i, j, U[hashLen/sizeof(uint32_t)], T[hashLen/sizeof(uint32_t)];
+    uint64_t istate64[8], ostate64[8];
+    uint32_t istate32[8], ostate32[8];
+    int sha512 = (hash == BRSHA512 && hashLen == 512/8), sha256 = (hash == BRSHA256 && hashLen == 256/8);
     
     assert(dk != NULL || dkLen == 0);
     assert(hash != NULL);
@@ -1118,6 +1306,8 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
     assert(rounds > 0);
     
     memcpy(s, salt, saltLen);
+    if (sha512 && rounds > 1) _BRHMACSHA512States(istate64, ostate64, pw, pwLen);
+    if (sha256 && rounds > 1) _BRHMACSHA256States(istate32, ostate32, pw, pwLen);
     
     for (i = 0; i < (dkLen + hashLen - 1)/hashLen; i++) {
         j = be32(i + 1);
@@ -1125,9 +1315,13 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
         BRHMAC(U, hash, hashLen, pw, pwLen, s, sizeof(s)); // U1 = hmac_hash(pw, salt || be32(i))
         memcpy(T, U, sizeof(U));
         
-        for (unsigned r = 1; r < rounds; r++) {
-            BRHMAC(U, hash, hashLen, pw, pwLen, U, sizeof(U)); // Urounds = hmac_hash(pw, Urounds-1)
-            for (j = 0; j < hashLen/sizeof(uint32_t); j++) T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
+        if (sha512) _BRPBKDF2SHA512Rounds(T, U, istate64, ostate64, rounds);
+        else if (sha256) _BRPBKDF2SHA256Rounds(T, U, istate32, ostate32, rounds);
+        else {
+            for (unsigned r = 1; r < rounds; r++) {
+                BRHMAC(U, hash, hashLen, pw, pwLen, U, sizeof(U)); // Urounds = hmac_hash(pw, Urounds-1)
+                for (j = 0; j < hashLen/sizeof(uint32_t); j++) T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
+            }
         }
         
         // dk = T1 || T2 || ... || Tdklen/hlen
@@ -1137,8 +1331,67 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
     mem_clean(s, sizeof(s));
     mem_clean(U, sizeof(U));
     mem_clean(T, sizeof(T));
+    mem_clean(istate64, sizeof(istate64));
+    mem_clean(ostate64, sizeof(ostate64));
+    mem_clean(istate32, sizeof(istate32));
+    mem_clean(ostate32, sizeof(ostate32));
 }
 
+#if defined(__SSE2__)
+
+// salsa20/8 stream cipher: http://cr.yp.to/snuffle.html
+// the sse2 core works on blocks kept in diagonal order, (x0, x5, x10, x15), (x4, x9, x14, x3), (x8, x13, x2, x7),
+// (x12, x1, x6, x11), so that each quarter round step is one vector operation - see _salsa_order()
+#define rol32x4(a, b) _mm_xor_si128(_mm_slli_epi32((a), (b)), _mm_srli_epi32((a), 32 - (b)))
+
+static inline void _salsa20_8(__m128i b[4])
+{
+    __m128i x0 = b[0], x1 = b[1], x2 = b[2], x3 = b[3], t;
+    
+    for (unsigned i = 0; i < 8; i += 2) {
+        // operate on columns
+        t = _mm_add_epi32(x0, x3), x1 = _mm_xor_si128(x1, rol32x4(t, 7));
+        t = _mm_add_epi32(x1, x0), x2 = _mm_xor_si128(x2, rol32x4(t, 9));
+        t = _mm_add_epi32(x2, x1), x3 = _mm_xor_si128(x3, rol32x4(t, 13));
+        t = _mm_add_epi32(x3, x2), x0 = _mm_xor_si128(x0, rol32x4(t, 18));
+        x1 = _mm_shuffle_epi32(x1, 0x93), x2 = _mm_shuffle_epi32(x2, 0x4e), x3 = _mm_shuffle_epi32(x3, 0x39);
+        
+        // operate on rows
+        t = _mm_add_epi32(x0, x1), x3 = _mm_xor_si128(x3, rol32x4(t, 7));
+        t = _mm_add_epi32(x3, x0), x2 = _mm_xor_si128(x2, rol32x4(t, 9));
+        t = _mm_add_epi32(x2, x3), x1 = _mm_xor_si128(x1, rol32x4(t, 13));
+        t = _mm_add_epi32(x1, x2), x0 = _mm_xor_si128(x0, rol32x4(t, 18));
+        x1 = _mm_shuffle_epi32(x1, 0x39), x2 = _mm_shuffle_epi32(x2, 0x4e), x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+    
+    b[0] = _mm_add_epi32(b[0], x0), b[1] = _mm_add_epi32(b[1], x1);
+    b[2] = _mm_add_epi32(b[2], x2), b[3] = _mm_add_epi32(b[3], x3);
+}
+
+// the running block stays in registers rather than going through the b scratch buffer
+static void _blockmix_salsa8(uint64_t *dest, const uint64_t *src, uint64_t *b, unsigned r)
+{
+    const __m128i *s = (const __m128i *)src;
+    __m128i *d = (__m128i *)dest, x[4];
+    unsigned i, j;
+    
+    (void)b;
+    for (j = 0; j < 4; j++) x[j] = _mm_loadu_si128(&s[(2*r - 1)*4 + j]);
+    
+    for (i = 0; i < 2*r; i++) {
+        for (j = 0; j < 4; j++) x[j] = _mm_xor_si128(x[j], _mm_loadu_si128(&s[i*4 + j]));
+        _salsa20_8(x);
+        // even blocks go to the first half of dest, odd blocks to the second half
+        for (j = 0; j < 4; j++) _mm_storeu_si128(&d[(i/2 + (i & 1)*r)*4 + j], x[j]);
+    }
+}
+
+// index of word i of a salsa20/8 block sequence when stored in diagonal order
+static const uint8_t _salsa_diagonal[16] = { 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11 };
+#define _salsa_order(i) (((i) & ~15u) | _salsa_diagonal[(i) & 15])
+
+#else // ! __SSE2__
+
 // salsa20/8 stream cipher: http://cr.yp.to/snuffle.html
 static void _salsa20_8(uint32_t b[16])
 {
@@ -1177,14 +1430,75 @@ static void _blockmix_salsa8(uint64_t *dest, const uint64_t *src, uint64_t *b, u
     }
 }
 
+#define _salsa_order(i) (i)
+
+#endif // ! __SSE2__
+
+// scrypt ROMix of the 128*r byte lane b, using v as 128*r*n bytes of scratch memory
+static void _BRScryptROMix(uint32_t *b, uint64_t *v, unsigned n, unsigned r)
+{
+    uint64_t x[16*r], y[16*r], z[8], m;
+    
+    // word 0 of each block keeps its place in diagonal order, so the integerify below is unchanged
+    for (unsigned j = 0; j < 32*r; j++) ((uint32_t *)x)[j] = le32(b[_salsa_order(j)]);
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        memcpy(&v[j*(16*r)], x, 128*r);
+        _blockmix_salsa8(y, x, z, r);
+        memcpy(&v[(j + 1)*(16*r)], y, 128*r);
+        _blockmix_salsa8(x, y, z, r);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        m = le64(x[(2*r - 1)*8]) & (n - 1);
+        for (unsigned k = 0; k < 16*r; k++) x[k] ^= v[m*(16*r) + k];
+        _blockmix_salsa8(y, x, z, r);
+        m = le64(y[(2*r - 1)*8]) & (n - 1);
+        for (unsigned k = 0; k < 16*r; k++) y[k] ^= v[m*(16*r) + k];
+        _blockmix_salsa8(x, y, z, r);
+    }
+    
+    for (unsigned j = 0; j < 32*r; j++) b[_salsa_order(j)] = le32(((uint32_t *)x)[j]);
+    mem_clean(x, sizeof(x));
+    mem_clean(y, sizeof(y));
+    mem_clean(z, sizeof(z));
+}
+
+typedef struct {
+    uint32_t *b;
+    unsigned n, r, p, lane, laneStep;
+} BRScryptLanes;
+
+// ROMix every laneStep'th lane of b, starting at lane, with one scratch buffer
+static void *_BRScryptLanesThread(void *info)
+{
+    BRScryptLanes *lanes = info;
+    uint64_t *v = malloc(128*lanes->r*lanes->n);
+    
+    assert(v != NULL);
+    
+    for (unsigned i = lanes->lane; i < lanes->p; i += lanes->laneStep) {
+        _BRScryptROMix(&lanes->b[i*32*lanes->r], v, lanes->n, lanes->r);
+    }
+    
+    mem_clean(v, 128*lanes->r*lanes->n);
+    free(v);
+    return NULL;
+}
+
 // scrypt key derivation: http://www.tarsnap.com/scrypt.html
 void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
               unsigned n, unsigned r, unsigned p)
 {
-    uint64_t x[16*r], y[16*r], z[8], *v = malloc(128*r*n), m;
+    BRScryptParallel(dk, dkLen, pw, pwLen, salt, saltLen, n, r, p, 1);
+}
+
+// scrypt key derivation with the p lanes spread over up to threadCount threads
+void BRScryptParallel(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                      unsigned n, unsigned r, unsigned p, unsigned threadCount)
+{
     uint32_t b[32*r*p];
     
-    assert(v != NULL);
     assert(dk != NULL || dkLen == 0);
     assert(pw != NULL || pwLen == 0);
     assert(salt != NULL || saltLen == 0);
@@ -1192,35 +1506,38 @@ void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *
     assert(r > 0);
     assert(p > 0);
     
+    if (threadCount > p) threadCount = p;
+    if (threadCount < 1) threadCount = 1;
+    
+    BRScryptLanes lanes[threadCount];
+    pthread_t threads[threadCount];
+    int started[threadCount];
+    pthread_attr_t attr;
+    
     BRPBKDF2(b, sizeof(b), BRSHA256, 256/8, pw, pwLen, salt, saltLen, 1);
     
-    for (int i = 0; i < p; i++) {
-        for (unsigned j = 0; j < 32*r; j++) ((uint32_t *)x)[j] = le32(b[i*32*r + j]);
-        
-        for (unsigned j = 0; j < n; j += 2) {
-            memcpy(&v[j*(16*r)], x, 128*r);
-            _blockmix_salsa8(y, x, z, r);
-            memcpy(&v[(j + 1)*(16*r)], y, 128*r);
-            _blockmix_salsa8(x, y, z, r);
-        }
-        
-        for (unsigned j = 0; j < n; j += 2) {
-            m = le64(x[(2*r - 1)*8]) & (n - 1);
-            for (unsigned k = 0; k < 16*r; k++) x[k] ^= v[m*(16*r) + k];
-            _blockmix_salsa8(y, x, z, r);
-            m = le64(y[(2*r - 1)*8]) & (n - 1);
-            for (unsigned k = 0; k < 16*r; k++) y[k] ^= v[m*(16*r) + k];
-            _blockmix_salsa8(x, y, z, r);
+    for (unsigned i = 0; i < threadCount; i++) {
+        lanes[i] = (BRScryptLanes) { b, n, r, p, i, threadCount };
+        started[i] = 0;
+    }
+    
+    if (threadCount > 1 && pthread_attr_init(&attr) == 0) {
+        if (pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE) == 0) {
+            for (unsigned i = 1; i < threadCount; i++) {
+                started[i] = (pthread_create(&threads[i], &attr, _BRScryptLanesThread, &lanes[i]) == 0);
+            }
         }
         
-        for (unsigned j = 0; j < 32*r; j++) b[i*32*r + j] = le32(((uint32_t *)x)[j]);
+        pthread_attr_destroy(&attr);
+    }
+    
+    _BRScryptLanesThread(&lanes[0]);
+    
+    for (unsigned i = 1; i < threadCount; i++) { // lanes without a thread run here
+        if (started[i]) pthread_join(threads[i], NULL);
+        else _BRScryptLanesThread(&lanes[i]);
     }
     
     BRPBKDF2(dk, dkLen, BRSHA256, 256/8, pw, pwLen, b, sizeof(b), 1);
     mem_clean(b, sizeof(b));
-    mem_clean(x, sizeof(x));
-    mem_clean(y, sizeof(y));
-    mem_clean(z, sizeof(z));
-    mem_clean(v, 128*r*n);
-    free(v);
 }
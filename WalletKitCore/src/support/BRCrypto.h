@@ -44,6 +44,19 @@ void BRSHA224(void *md28, const void *data, size_t dataLen);
 // double-sha-256 = sha-256(sha-256(x))
 void BRSHA256_2(void *md32, const void *data, size_t dataLen);
 
+// incremental sha-256, for hashing data that is not contiguous in memory
+typedef struct {
+    uint32_t buf[8];
+    uint32_t x[16];
+    uint64_t len;
+} BRSHA256Context;
+
+void BRSHA256Init(BRSHA256Context *ctx);
+void BRSHA256Update(BRSHA256Context *ctx, const void *data, size_t dataLen);
+
+// writes the digest to md32 and clears ctx
+void BRSHA256Final(BRSHA256Context *ctx, void *md32);
+
 void BRSHA384(void *md48, const void *data, size_t dataLen);
 
 void BRSHA512(void *md64, const void *data, size_t dataLen);
@@ -60,6 +73,9 @@ void BRSHA3_256(void *md32, const void *data, size_t dataLen);
 // keccak-256: https://keccak.team/files/Keccak-submission-3.pdf
 void BRKeccak256(void *md32, const void *data, size_t dataLen);
 
+// keccak-512: https://keccak.team/files/Keccak-submission-3.pdf
+void BRKeccak512(void *md64, const void *data, size_t dataLen);
+
 // md5 - for non-cryptographic use only
 void BRMD5(void *md16, const void *data, size_t dataLen);
 
@@ -108,6 +124,11 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
 void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
               unsigned n, unsigned r, unsigned p);
 
+// scrypt key derivation with the p parallel lanes spread over up to threadCount threads, including the calling thread
+// each thread uses 128*r*n bytes of scratch memory
+void BRScryptParallel(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
+                      unsigned n, unsigned r, unsigned p, unsigned threadCount);
+
 // zeros out memory in a way that can't be optimized out by the compiler
 inline static void mem_clean(void *ptr, size_t len)
 {
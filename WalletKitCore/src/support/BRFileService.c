@@ -192,6 +192,12 @@ struct BRFileServiceRecord {
     sqlite3_stmt *sdbDeleteAllTypeStmt;
     sqlite3_stmt *sdbDeleteAllStmt;
     bool  sdbClosed;
+
+    // The nesting depth of fileService{Begin,End}Batch(); when non-zero a DB transaction is open.
+    size_t sdbBatchDepth;
+
+    // The depth of a batch rolled back by a failed replace; its ends each report the failure.
+    size_t sdbBatchFailedDepth;
 #endif
 
     BRArrayOf(BRFileServiceEntityType) entityTypes;
@@ -378,6 +384,12 @@ _fileServiceCloseInternal (BRFileService fs) {
 #if !defined(NEUTER_FILE_SERVICE)
     if (fs->sdbClosed) return;
 
+    // Commit, rather than lose, anything saved in an unfinished batch.
+    if (fs->sdbBatchDepth > 0) {
+        sqlite3_exec (fs->sdb, "COMMIT", NULL, NULL, NULL);
+        fs->sdbBatchDepth = 0;
+    }
+
     fs->sdbClosed = true;
     _fileServiceFinalizeStmt (fs, &fs->sdbInsertStmt);
     _fileServiceFinalizeStmt (fs, &fs->sdbSelectStmt);
@@ -874,6 +886,15 @@ fileServiceClearAll (BRFileService fs) {
 
 static int
 fileServiceReplaceFailed (BRFileService fs, int needUnlock) {
+#if !defined(NEUTER_FILE_SERVICE)
+    // Undo the partial replace.  Within a batch that undoes the whole batch; the DB transaction
+    // is gone, so the batch is over and its end reports the failure.
+    sqlite3_exec (fs->sdb, "ROLLBACK", NULL, NULL, NULL);
+    if (fs->sdbBatchDepth > 0) {
+        fs->sdbBatchFailedDepth = fs->sdbBatchDepth;
+        fs->sdbBatchDepth = 0;
+    }
+#endif
     if (needUnlock) pthread_mutex_unlock (&fs->lock);
     return 0;
 }
@@ -894,9 +915,14 @@ fileServiceReplace (BRFileService fs,
     if (fs->sdbClosed)
         return fileServiceFailedImpl (fs, 1, NULL, NULL, "closed");
 
-    status = sqlite3_exec (fs->sdb, "BEGIN", NULL, NULL, NULL);
-    if (SQLITE_OK != status)
-        return fileServiceFailedSDB (fs, 1, status);
+    // Within a batch, the DB transaction is already open; it is committed when the batch ends.
+    int needTransaction = (0 == fs->sdbBatchDepth);
+
+    if (needTransaction) {
+        status = sqlite3_exec (fs->sdb, "BEGIN", NULL, NULL, NULL);
+        if (SQLITE_OK != status)
+            return fileServiceFailedSDB (fs, 1, status);
+    }
 
     if (0 == fileServiceClearForType (fs, entityType, 0))
         return fileServiceReplaceFailed (fs, 1);
@@ -905,9 +931,61 @@ fileServiceReplace (BRFileService fs,
         if (0 == _fileServiceSave (fs, type, entities[index], 0))
             return fileServiceReplaceFailed (fs, 1);
 
-    status = sqlite3_exec (fs->sdb, "COMMIT", NULL, NULL, NULL);
-    if (SQLITE_OK != status)
-        return fileServiceFailedSDB (fs, 1, status);
+    if (needTransaction) {
+        status = sqlite3_exec (fs->sdb, "COMMIT", NULL, NULL, NULL);
+        if (SQLITE_OK != status)
+            return fileServiceFailedSDB (fs, 1, status);
+    }
+
+    pthread_mutex_unlock (&fs->lock);
+#endif // !defined(NEUTER_FILE_SERVICE)
+
+    return 1;
+}
+
+/// MARK: - Batch
+
+extern int
+fileServiceBeginBatch (BRFileService fs) {
+#if !defined(NEUTER_FILE_SERVICE)
+    pthread_mutex_lock (&fs->lock);
+    if (fs->sdbClosed)
+        return fileServiceFailedImpl (fs, 1, NULL, NULL, "closed");
+
+    if (0 == fs->sdbBatchDepth) {
+        sqlite3_status_code status = sqlite3_exec (fs->sdb, "BEGIN", NULL, NULL, NULL);
+        if (SQLITE_OK != status)
+            return fileServiceFailedSDB (fs, 1, status);
+    }
+    fs->sdbBatchDepth += 1;
+
+    pthread_mutex_unlock (&fs->lock);
+#endif // !defined(NEUTER_FILE_SERVICE)
+
+    return 1;
+}
+
+extern int
+fileServiceEndBatch (BRFileService fs) {
+#if !defined(NEUTER_FILE_SERVICE)
+    pthread_mutex_lock (&fs->lock);
+    if (fs->sdbClosed)
+        return fileServiceFailedImpl (fs, 1, NULL, NULL, "closed");
+
+    if (0 == fs->sdbBatchDepth) {
+        if (0 == fs->sdbBatchFailedDepth)
+            return fileServiceFailedImpl (fs, 1, NULL, NULL, "missed batch");
+
+        fs->sdbBatchFailedDepth -= 1;
+        return fileServiceFailedImpl (fs, 1, NULL, NULL, "batch rolled back");
+    }
+
+    fs->sdbBatchDepth -= 1;
+    if (0 == fs->sdbBatchDepth) {
+        sqlite3_status_code status = sqlite3_exec (fs->sdb, "COMMIT", NULL, NULL, NULL);
+        if (SQLITE_OK != status)
+            return fileServiceFailedSDB (fs, 1, status);
+    }
 
     pthread_mutex_unlock (&fs->lock);
 #endif // !defined(NEUTER_FILE_SERVICE)
@@ -144,6 +144,23 @@ fileServiceReplace (BRFileService fs,
                     const void **entities,
                     size_t entitiesCount);
 
+/**
+ * Begin a batch of saves, removes and replaces.  Until the matching `fileServiceEndBatch()` the
+ * changes are made in one DB transaction, rather than one each, and are committed together.
+ * Batches nest; only the outermost commits.  Closing `fs` commits an unfinished batch.
+ *
+ * A failed `fileServiceReplace()` within a batch rolls back the whole batch; later changes are
+ * made outside of any batch and each `fileServiceEndBatch()` of the failed batch reports the
+ * failure.
+ *
+ * @return true (1) if success, false (0) otherwise;
+ */
+extern int
+fileServiceBeginBatch (BRFileService fs);
+
+extern int
+fileServiceEndBatch (BRFileService fs);
+
 extern int
 fileServiceClear (BRFileService fs,
                   const char *type);